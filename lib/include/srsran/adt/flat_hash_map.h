@@ -0,0 +1,267 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_FLAT_HASH_MAP_H
+#define SRSRAN_FLAT_HASH_MAP_H
+
+#include "srsran/support/srsran_assert.h"
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Hash map with integer keys, that stores its elements in a single contiguous array of slots (open addressing).
+ * Collisions are resolved with linear probing, and erasures shift back the following elements of the probe sequence,
+ * so that no tombstones are left behind. Keys are spread with a multiplicative (Fibonacci) hash, which behaves well
+ * for the sequential and random identifiers used by the stack (e.g. IMSIs, S1AP/GTP IDs, TMSIs).
+ * Compared to std::map, lookups don't chase pointers and insertions don't allocate once the capacity is reserved.
+ * Note: Insertions and erasures invalidate iterators and references to elements.
+ * @tparam K unsigned or signed integer key
+ * @tparam T mapped type, must be default constructible and movable
+ */
+template <typename K, typename T>
+class flat_hash_map
+{
+  static_assert(std::is_integral<K>::value, "Map key must be an integer");
+
+  using obj_t = std::pair<K, T>;
+
+  struct slot_t {
+    bool  present = false;
+    obj_t obj;
+  };
+
+public:
+  using key_type    = K;
+  using mapped_type = T;
+  using value_type  = std::pair<K, T>;
+
+  template <typename Slot, typename Obj>
+  class iter_impl
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Obj;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type*;
+    using reference         = value_type&;
+
+    iter_impl() = default;
+    iter_impl(Slot* ptr_, Slot* end_) : ptr(ptr_), end(end_)
+    {
+      while (ptr != end and not ptr->present) {
+        ++ptr;
+      }
+    }
+    /// Conversion from iterator to const_iterator
+    template <typename OtherSlot,
+              typename OtherObj,
+              typename std::enable_if<std::is_convertible<OtherSlot*, Slot*>::value, int>::type = 0>
+    iter_impl(const iter_impl<OtherSlot, OtherObj>& other) : ptr(other.ptr), end(other.end)
+    {}
+
+    iter_impl& operator++()
+    {
+      while (++ptr != end and not ptr->present) {
+      }
+      return *this;
+    }
+    iter_impl operator++(int)
+    {
+      iter_impl tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    reference operator*() const { return ptr->obj; }
+    pointer   operator->() const { return &ptr->obj; }
+
+    bool operator==(const iter_impl& other) const { return ptr == other.ptr; }
+    bool operator!=(const iter_impl& other) const { return ptr != other.ptr; }
+
+  private:
+    friend class flat_hash_map<K, T>;
+    template <typename OtherSlot, typename OtherObj>
+    friend class iter_impl;
+
+    Slot* ptr = nullptr;
+    Slot* end = nullptr;
+  };
+  using iterator       = iter_impl<slot_t, obj_t>;
+  using const_iterator = iter_impl<const slot_t, const obj_t>;
+
+  explicit flat_hash_map(size_t initial_capacity = 16) { rehash(initial_capacity); }
+
+  iterator       begin() { return iterator(slots.data(), slots.data() + slots.size()); }
+  iterator       end() { return iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+  const_iterator begin() const { return const_iterator(slots.data(), slots.data() + slots.size()); }
+  const_iterator end() const { return const_iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+
+  bool   empty() const { return nof_elems == 0; }
+  size_t size() const { return nof_elems; }
+  size_t capacity() const { return slots.size(); }
+
+  /// Reserves space for N elements, so that inserting up to N elements doesn't reallocate
+  void reserve(size_t N)
+  {
+    if (N * max_load_den > slots.size() * max_load_num) {
+      rehash(N * max_load_den / max_load_num + 1);
+    }
+  }
+
+  void clear()
+  {
+    for (slot_t& s : slots) {
+      if (s.present) {
+        s.present = false;
+        s.obj     = obj_t{};
+      }
+    }
+    nof_elems = 0;
+  }
+
+  iterator find(K key)
+  {
+    size_t idx = find_idx(key);
+    return idx == npos ? end() : make_iter(idx);
+  }
+  const_iterator find(K key) const
+  {
+    size_t idx = find_idx(key);
+    return idx == npos ? end() : const_iterator(slots.data() + idx, slots.data() + slots.size());
+  }
+  size_t count(K key) const { return find_idx(key) == npos ? 0 : 1; }
+  bool   contains(K key) const { return find_idx(key) != npos; }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(K key, Args&&... args)
+  {
+    size_t idx = find_idx(key);
+    if (idx != npos) {
+      return std::make_pair(make_iter(idx), false);
+    }
+    reserve(nof_elems + 1);
+    idx                = free_idx(key);
+    slots[idx].present = true;
+    slots[idx].obj     = obj_t(key, T(std::forward<Args>(args)...));
+    nof_elems++;
+    return std::make_pair(make_iter(idx), true);
+  }
+  std::pair<iterator, bool> insert(const value_type& value) { return emplace(value.first, value.second); }
+  std::pair<iterator, bool> insert(value_type&& value) { return emplace(value.first, std::move(value.second)); }
+
+  T& operator[](K key) { return emplace(key).first->second; }
+
+  size_t erase(K key)
+  {
+    size_t idx = find_idx(key);
+    if (idx == npos) {
+      return 0;
+    }
+    erase_idx(idx);
+    return 1;
+  }
+  void erase(iterator it)
+  {
+    srsran_assert(it.ptr != nullptr and it.ptr->present, "Erasing invalid iterator");
+    erase_idx(it.ptr - slots.data());
+  }
+
+private:
+  static const size_t   npos         = static_cast<size_t>(-1);
+  static const uint32_t max_load_num = 1; ///< The table grows once it is more than half full
+  static const uint32_t max_load_den = 2;
+
+  size_t hash_idx(K key) const
+  {
+    return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9e3779b97f4a7c15ULL) >> (64U - log2_cap));
+  }
+
+  size_t find_idx(K key) const
+  {
+    for (size_t idx = hash_idx(key);; idx = (idx + 1) & mask) {
+      if (not slots[idx].present) {
+        return npos;
+      }
+      if (slots[idx].obj.first == key) {
+        return idx;
+      }
+    }
+  }
+
+  size_t free_idx(K key) const
+  {
+    size_t idx = hash_idx(key);
+    while (slots[idx].present) {
+      idx = (idx + 1) & mask;
+    }
+    return idx;
+  }
+
+  iterator make_iter(size_t idx) { return iterator(slots.data() + idx, slots.data() + slots.size()); }
+
+  void erase_idx(size_t hole)
+  {
+    // Shift back the elements that follow in the same cluster, and would not be reachable through the hole otherwise
+    for (size_t idx = (hole + 1) & mask; slots[idx].present; idx = (idx + 1) & mask) {
+      size_t home = hash_idx(slots[idx].obj.first);
+      if (((idx - home) & mask) >= ((idx - hole) & mask)) {
+        slots[hole].obj = std::move(slots[idx].obj);
+        hole            = idx;
+      }
+    }
+    slots[hole].present = false;
+    slots[hole].obj     = obj_t{};
+    nof_elems--;
+  }
+
+  void rehash(size_t min_capacity)
+  {
+    log2_cap = 1;
+    while ((size_t(1) << log2_cap) < min_capacity) {
+      log2_cap++;
+    }
+    mask = (size_t(1) << log2_cap) - 1;
+
+    std::vector<slot_t> old_slots(size_t(1) << log2_cap);
+    slots.swap(old_slots);
+    for (slot_t& s : old_slots) {
+      if (s.present) {
+        size_t idx         = free_idx(s.obj.first);
+        slots[idx].present = true;
+        slots[idx].obj     = std::move(s.obj);
+      }
+    }
+  }
+
+  std::vector<slot_t> slots;
+  size_t              nof_elems = 0;
+  uint32_t            log2_cap  = 0;
+  size_t              mask      = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_FLAT_HASH_MAP_H
@@ -0,0 +1,146 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_MPMC_QUEUE_H
+#define SRSRAN_MPMC_QUEUE_H
+
+#include "srsran/adt/detail/type_storage.h"
+#include <array>
+#include <atomic>
+
+namespace srsran {
+
+/**
+ * Bounded lock-free queue with multiple producers and multiple consumers. Features:
+ * - Non-blocking push/pop API via try_push(...) and try_pop(...) methods. No mutex is ever taken, so producers are
+ *   never blocked by a slow consumer, they just fail to push when the queue is full
+ * - Each slot has its own sequence number, producers and consumers only contend on the head/tail counters
+ * - Capacity is defined at compile time and must be a power of two
+ * @tparam T value type stored by the queue
+ * @tparam N capacity of the queue
+ */
+template <typename T, size_t N>
+class static_mpmc_queue
+{
+  static_assert(N > 0 and (N & (N - 1)) == 0, "The capacity of the queue must be a power of two");
+
+  const static size_t cache_line_size = 64;
+
+  struct slot_t {
+    std::atomic<size_t>     seq;
+    detail::type_storage<T> storage;
+  };
+
+public:
+  using value_type = T;
+
+  static_mpmc_queue()
+  {
+    for (size_t i = 0; i < N; ++i) {
+      slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+  static_mpmc_queue(const static_mpmc_queue&) = delete;
+  static_mpmc_queue& operator=(const static_mpmc_queue&) = delete;
+  ~static_mpmc_queue()
+  {
+    T tmp;
+    while (try_pop(tmp)) {
+    }
+  }
+
+  bool try_push(T&& t) { return emplace(std::move(t)); }
+  bool try_push(const T& t) { return emplace(t); }
+
+  bool try_pop(T& obj)
+  {
+    size_t  pos = tail.load(std::memory_order_relaxed);
+    slot_t* slot;
+    while (true) {
+      slot          = &slots[pos & (N - 1)];
+      size_t   seq  = slot->seq.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (diff == 0) {
+        if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // Queue is empty
+        return false;
+      } else {
+        pos = tail.load(std::memory_order_relaxed);
+      }
+    }
+    obj = std::move(slot->storage.get());
+    slot->storage.destroy();
+    slot->seq.store(pos + N, std::memory_order_release);
+    return true;
+  }
+
+  /// Approximate number of elements, only meaningful when no other thread is pushing or popping
+  size_t size() const
+  {
+    size_t h = head.load(std::memory_order_relaxed);
+    size_t t = tail.load(std::memory_order_relaxed);
+    return h >= t ? h - t : 0;
+  }
+  bool   empty() const { return size() == 0; }
+  size_t max_size() const { return N; }
+
+private:
+  template <typename U>
+  bool emplace(U&& u)
+  {
+    size_t  pos = head.load(std::memory_order_relaxed);
+    slot_t* slot;
+    while (true) {
+      slot          = &slots[pos & (N - 1)];
+      size_t   seq  = slot->seq.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+      if (diff == 0) {
+        if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // Queue is full
+        return false;
+      } else {
+        pos = head.load(std::memory_order_relaxed);
+      }
+    }
+    slot->storage.emplace(std::forward<U>(u));
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Padding keeps the producer and consumer counters in different cache lines, without requiring over-aligned
+  // allocations of the objects that own the queue
+  uint8_t               pad0[cache_line_size];
+  std::atomic<size_t>   head{0};
+  uint8_t               pad1[cache_line_size - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t>   tail{0};
+  uint8_t               pad2[cache_line_size - sizeof(std::atomic<size_t>)];
+  std::array<slot_t, N> slots;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_MPMC_QUEUE_H
@@ -0,0 +1,137 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RCU_PTR_H
+#define SRSRAN_RCU_PTR_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace srsran {
+
+/**
+ * Read-copy-update pointer. Features:
+ * - Readers access the current version of the object through a read_guard, without taking any lock. The version a
+ *   reader observed stays alive until its guard is destroyed
+ * - Writers copy the current version, modify the copy and publish it. publish(...) blocks until every reader that could
+ *   have observed the previous version has released it, and then destroys it
+ * - Grace periods are detected with two reader counters, selected by the parity of an epoch that every writer flips, so
+ *   new readers never delay a writer indefinitely
+ * - Writers must be serialized externally
+ * @tparam T type of the protected object
+ */
+template <typename T>
+class rcu_ptr
+{
+  const static size_t cache_line_size = 64;
+
+  struct reader_counter_t {
+    std::atomic<uint32_t> count{0};
+    uint8_t               pad[cache_line_size - sizeof(std::atomic<uint32_t>)];
+  };
+
+public:
+  class read_guard
+  {
+  public:
+    read_guard(read_guard&& other) noexcept : parent(other.parent), idx(other.idx), ptr(other.ptr)
+    {
+      other.parent = nullptr;
+    }
+    read_guard(const read_guard&) = delete;
+    read_guard& operator=(const read_guard&) = delete;
+    read_guard& operator=(read_guard&&) = delete;
+    ~read_guard()
+    {
+      if (parent != nullptr) {
+        parent->readers[idx].count.fetch_sub(1, std::memory_order_release);
+      }
+    }
+
+    const T* get() const { return ptr; }
+    const T& operator*() const { return *ptr; }
+    const T* operator->() const { return ptr; }
+    explicit operator bool() const { return ptr != nullptr; }
+
+  private:
+    friend class rcu_ptr;
+
+    explicit read_guard(const rcu_ptr* parent_) : parent(parent_)
+    {
+      // Registering before loading the pointer guarantees that either the writer waits for this reader, or this reader
+      // observes the version published by the writer
+      idx = parent->epoch.load(std::memory_order_seq_cst) & 1U;
+      parent->readers[idx].count.fetch_add(1, std::memory_order_seq_cst);
+      ptr = parent->current.load(std::memory_order_seq_cst);
+    }
+
+    const rcu_ptr* parent;
+    uint32_t       idx;
+    const T*       ptr;
+  };
+
+  rcu_ptr() = default;
+  explicit rcu_ptr(std::unique_ptr<T> obj) : current(obj.release()) {}
+  rcu_ptr(const rcu_ptr&) = delete;
+  rcu_ptr& operator=(const rcu_ptr&) = delete;
+  ~rcu_ptr() { delete current.load(std::memory_order_acquire); }
+
+  read_guard read() const { return read_guard(this); }
+
+  /// Current version, only safe to call from the (serialized) writer side
+  const T* get_unsafe() const { return current.load(std::memory_order_acquire); }
+
+  /// Replaces the current version, blocking until no reader holds the previous one
+  void publish(std::unique_ptr<T> obj)
+  {
+    T* old = current.exchange(obj.release(), std::memory_order_seq_cst);
+    synchronize();
+    delete old;
+  }
+
+private:
+  void synchronize() const
+  {
+    uint32_t e = epoch.load(std::memory_order_seq_cst);
+
+    // Readers that registered before the previous flip must leave before their counter is reused
+    wait_readers((e + 1) & 1U);
+    epoch.store(e + 1, std::memory_order_seq_cst);
+    wait_readers(e & 1U);
+  }
+
+  void wait_readers(uint32_t idx) const
+  {
+    while (readers[idx].count.load(std::memory_order_seq_cst) != 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  std::atomic<T*>                         current{nullptr};
+  mutable std::atomic<uint32_t>           epoch{0};
+  mutable std::array<reader_counter_t, 2> readers;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_RCU_PTR_H
@@ -185,6 +185,103 @@ public:
   SRSASN_CODE align_bytes_zero();
 };
 
+/*********************
+   arena allocation
+*********************/
+
+namespace detail {
+struct arena_chunk;
+} // namespace detail
+
+/**
+ * Bump allocator for the dynamic containers of decoded messages (dyn_array, dyn_seq_of, unbounded octet strings and
+ * ext_array). While an arena_scope is active in a thread, the containers allocate their storage from the arena
+ * instead of the heap, and freeing it is just a counter decrement. Memory is taken from the heap in chunks, and a
+ * chunk is reused once every block allocated from it has been freed, so that decoding one PDU after another with the
+ * same arena doesn't touch the heap at all.
+ *
+ * Blocks may outlive the arena and may be freed from any thread, as each chunk is reference counted, but the arena
+ * itself must only be used by one thread. Items held by copy_ptr are always allocated from the heap.
+ */
+class arena
+{
+public:
+  static const uint32_t default_chunk_size = 8192;
+  static const uint32_t alignment          = 16;
+
+  explicit arena(uint32_t chunk_size_ = default_chunk_size) : chunk_size(chunk_size_) {}
+  ~arena();
+  arena(const arena&) = delete;
+  arena& operator=(const arena&) = delete;
+
+  /// Allocates a block of n_bytes aligned to "alignment" bytes, which is released with detail::deallocate()
+  void* allocate(size_t n_bytes);
+
+  /// Number of chunks that were allocated from the heap since the arena was created
+  uint32_t nof_chunk_allocs() const { return nof_chunks; }
+
+private:
+  detail::arena_chunk* cur = nullptr;
+  uint32_t             chunk_size;
+  uint32_t             nof_chunks = 0;
+};
+
+/// Makes the containers allocate from the given arena in the calling thread, until the scope ends
+class arena_scope
+{
+public:
+  explicit arena_scope(arena& a);
+  ~arena_scope();
+  arena_scope(const arena_scope&) = delete;
+  arena_scope& operator=(const arena_scope&) = delete;
+
+private:
+  arena* prev;
+};
+
+/// Number of container allocations done by the calling thread
+struct alloc_stats_t {
+  uint64_t nof_heap_allocs  = 0;
+  uint64_t nof_arena_allocs = 0;
+};
+const alloc_stats_t& get_alloc_stats();
+
+namespace detail {
+
+/// Allocates n_bytes from the active arena of the calling thread, or from the heap if there is none
+void* allocate(size_t n_bytes);
+void  deallocate(void* ptr);
+
+template <class T>
+T* new_array(uint32_t nof_items)
+{
+  static_assert(alignof(T) <= arena::alignment, "Type alignment not supported by the ASN.1 allocator");
+  T* ptr = static_cast<T*>(allocate(nof_items * sizeof(T)));
+  for (uint32_t i = 0; i < nof_items; ++i) {
+    new (&ptr[i]) T;
+  }
+  return ptr;
+}
+
+template <class T>
+void delete_array(T* ptr, uint32_t nof_items)
+{
+  for (uint32_t i = 0; i < nof_items; ++i) {
+    ptr[i].~T();
+  }
+  deallocate(ptr);
+}
+
+} // namespace detail
+
+/// Unpacks a message with its containers allocated from the given arena
+template <class Msg>
+SRSASN_CODE unpack_in_arena(Msg& msg, cbit_ref& bref, arena& a)
+{
+  arena_scope scope(a);
+  return msg.unpack(bref);
+}
+
 /*********************
   function helpers
 *********************/
@@ -197,14 +294,14 @@ public:
   using const_iterator = const T*;
 
   dyn_array() = default;
-  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = new T[size_]; }
+  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = detail::new_array<T>(size_); }
   dyn_array(const dyn_array<T>& other) : dyn_array(&other[0], other.size_) {}
   dyn_array(const T* ptr, uint32_t nof_items)
   {
     size_ = nof_items;
     cap_  = nof_items;
     if (ptr != NULL) {
-      data_ = new T[cap_];
+      data_ = detail::new_array<T>(cap_);
       std::copy(ptr, ptr + size_, data_);
     } else {
       data_ = NULL;
@@ -213,7 +310,7 @@ public:
   ~dyn_array()
   {
     if (data_ != NULL) {
-      delete[] data_;
+      detail::delete_array(data_, cap_);
     }
   }
   uint32_t      size() const { return size_; }
@@ -239,10 +336,11 @@ public:
       return;
     }
 
-    T* old_data = data_;
-    cap_        = new_size > new_cap ? new_size : new_cap;
+    T*       old_data = data_;
+    uint32_t old_cap  = cap_;
+    cap_              = new_size > new_cap ? new_size : new_cap;
     if (cap_ > 0) {
-      data_ = new T[cap_];
+      data_ = detail::new_array<T>(cap_);
       if (old_data != NULL) {
         srsran_assert(cap_ > size_, "Old size larger than new capacity in dyn_array\n");
         std::copy(&old_data[0], &old_data[size_], data_);
@@ -252,7 +350,7 @@ public:
     }
     size_ = new_size;
     if (old_data != NULL) {
-      delete[] old_data;
+      detail::delete_array(old_data, old_cap);
     }
   }
   iterator erase(iterator it)
@@ -367,7 +465,7 @@ public:
   ~ext_array()
   {
     if (not is_in_small_buffer()) {
-      delete[] head;
+      detail::delete_array(head, small_buffer.cap_);
     }
   }
   ext_array<T, Nthres>& operator=(const ext_array<T, Nthres>& other)
@@ -407,11 +505,11 @@ public:
     }
     T*       old_data = head;
     uint32_t newcap   = new_size + 5;
-    head              = new T[newcap];
-    std::copy(&small_buffer.data[0], &small_buffer.data[size_], head);
+    head              = detail::new_array<T>(newcap);
+    std::copy(&old_data[0], &old_data[size_], head);
     size_ = new_size;
     if (old_data != &small_buffer.data[0]) {
-      delete[] old_data;
+      detail::delete_array(old_data, small_buffer.cap_);
     }
     small_buffer.cap_ = newcap;
   }
@@ -1884,6 +1982,67 @@ public:
   }
 };
 
+/**
+ * Index of the protocol IEs of an S1AP or NGAP PDU, built without decoding the IE values.
+ *
+ * Both protocols share the same PDU layout: a choice between initiating, successful and unsuccessful outcome messages,
+ * each made of the procedure code, its criticality and the message as an open type, which is in turn a sequence of
+ * protocol IEs whose values are open types as well. The index records the position of every IE value in the PDU, so
+ * that routing and forwarding decisions can be made by decoding only the IEs they need, and the whole PDU is decoded
+ * with unpack_pdu() only if the message is actually processed. The PDU buffer must outlive the index.
+ */
+class ap_pdu_index
+{
+public:
+  enum class pdu_type_t { init_msg, successful_outcome, unsuccessful_outcome };
+
+  struct ie_t {
+    uint32_t id;
+    crit_e   crit;
+    uint32_t offset; ///< Offset of the IE value in the PDU, in bytes
+    uint32_t len;    ///< Length of the IE value, in bytes
+  };
+
+  static const uint32_t max_nof_ies = 64;
+
+  /// Builds the index of a PDU, fails if the PDU is malformed or has more than max_nof_ies IEs
+  SRSASN_CODE unpack(const uint8_t* pdu_, uint32_t pdu_len_);
+
+  pdu_type_t                              pdu_type() const { return type; }
+  uint8_t                                 proc_code() const { return code; }
+  crit_e                                  proc_crit() const { return crit; }
+  const bounded_array<ie_t, max_nof_ies>& ies() const { return ie_list; }
+  const ie_t*                             find_ie(uint32_t id) const;
+
+  /// Decodes the value of the IE with the given id, which must be of type T
+  template <class T>
+  SRSASN_CODE unpack_ie(uint32_t id, T& value) const
+  {
+    const ie_t* ie = find_ie(id);
+    if (ie == nullptr) {
+      return SRSASN_ERROR_DECODE_FAIL;
+    }
+    cbit_ref bref(pdu + ie->offset, ie->len);
+    return value.unpack(bref);
+  }
+
+  /// Decodes the whole PDU
+  template <class Pdu>
+  SRSASN_CODE unpack_pdu(Pdu& pdu_obj) const
+  {
+    cbit_ref bref(pdu, pdu_len);
+    return pdu_obj.unpack(bref);
+  }
+
+private:
+  const uint8_t*                   pdu     = nullptr;
+  uint32_t                         pdu_len = 0;
+  pdu_type_t                       type    = pdu_type_t::init_msg;
+  uint8_t                          code    = 0;
+  crit_e                           crit;
+  bounded_array<ie_t, max_nof_ies> ie_list;
+};
+
 } // namespace asn1
 
 #endif // SRSASN_COMMON_UTILS_H
@@ -48,7 +48,7 @@ inline void log_args(int argc, char* argv[], const std::string& service)
 
 inline void check_scaling_governor(const std::string& device_name)
 {
-  if (device_name == "zmq") {
+  if (device_name == "zmq" || device_name == "shm") {
     return;
   }
   int nof_cpus = std::thread::hardware_concurrency();
@@ -22,14 +22,18 @@
 #ifndef SRSRAN_MAC_PCAP_BASE_H
 #define SRSRAN_MAC_PCAP_BASE_H
 
-#include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/mpmc_queue.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/pcap.h"
+#include "srsran/common/pcap_filter.h"
 #include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <stdint.h>
+#include <sys/time.h>
 #include <thread>
 
 namespace srsran {
@@ -49,6 +53,9 @@ public:
 
   void set_ue_id(uint16_t ue_id);
 
+  /// Sets the capture filter, PDUs that don't match it are discarded before being copied
+  void set_filter(const pcap_filter_cfg_t& cfg) { filter.set(cfg); }
+
   // EUTRA
   void
   write_ul_crnti(uint8_t* pdu, uint32_t pdu_len_bytes, uint16_t crnti, uint32_t reTX, uint32_t tti, uint8_t cc_idx);
@@ -103,19 +110,38 @@ protected:
     MAC_Context_Info_t    context;
     mac_nr_context_info_t context_nr;
     unique_byte_buffer_t  pdu;
+    struct timeval        ts;       ///< Capture time, taken when the PDU is queued
+    uint32_t              orig_len; ///< Payload length before snap length truncation
   } pcap_pdu_t;
 
   virtual void write_pdu(pcap_pdu_t& pdu) = 0;
+  /// Called by the writer thread when the queue is idle, to push out buffered PDUs
+  virtual void flush() {}
   void         run_thread() final;
 
-  std::mutex                              mutex;
-  srslog::basic_logger&                   logger;
-  std::atomic<bool>                       running = {false};
-  static_blocking_queue<pcap_pdu_t, 1024> queue;
-  uint16_t                                ue_id                = 0;
-  int                                     emergency_handler_id = -1;
+  /// Wakes up the writer thread, e.g. after clearing running to stop it
+  void wake_writer();
+
+  /// Interval at which buffered PDUs are flushed
+  const static uint32_t flush_period_ms = 100;
+
+  std::mutex                          mutex;
+  srslog::basic_logger&               logger;
+  std::atomic<bool>                   running = {false};
+  static_mpmc_queue<pcap_pdu_t, 4096> queue; ///< Lock-free, so PHY/MAC workers never wait for the writer thread
+  std::mutex                          wakeup_mutex;
+  std::condition_variable             wakeup_cvar;
+  std::atomic<bool>                   writer_sleeping      = {false}; ///< Producers only notify while it is set
+  uint16_t                            ue_id                = 0;
+  int                                 emergency_handler_id = -1;
+  pcap_filter                         filter;
 
 private:
+  /// Pops a PDU, waiting until one is queued, the writer is stopped or the given time point
+  bool pop_wait_until(pcap_pdu_t& pdu, std::chrono::steady_clock::time_point until);
+  /// Pushes a PDU without blocking, returns false if the queue is full
+  bool queue_pdu(pcap_pdu_t&& pdu);
+
   void pack_and_queue(uint8_t* payload,
                       uint32_t payload_len,
                       uint16_t ue_id,
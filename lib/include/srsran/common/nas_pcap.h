@@ -24,6 +24,7 @@
 
 #include "srsran/common/common.h"
 #include "srsran/common/pcap.h"
+#include "srsran/common/pcap_filter.h"
 #include <string>
 
 namespace srsran {
@@ -37,6 +38,7 @@ public:
   uint32_t open(std::string filename_, uint32_t ue_id = 0, srsran_rat_t rat_type = srsran_rat_t::lte);
   void     close();
   void     write_nas(uint8_t* pdu, uint32_t pdu_len_bytes);
+  void     set_filter(const pcap_filter_cfg_t& cfg) { filter.set(cfg); }
 
 private:
   bool        enable_write = false;
@@ -44,6 +46,7 @@ private:
   FILE*       pcap_file            = nullptr;
   uint32_t    ue_id                = 0;
   int         emergency_handler_id = -1;
+  pcap_filter filter;
   void        pack_and_write(uint8_t* pdu, uint32_t pdu_len_bytes);
 };
 
@@ -23,6 +23,7 @@
 #define SRSRAN_NGAP_PCAP_H
 
 #include "srsran/common/pcap.h"
+#include "srsran/common/pcap_filter.h"
 #include <string>
 
 namespace srsran {
@@ -41,12 +42,14 @@ public:
   void open(const char* filename_);
   void close();
   void write_ngap(uint8_t* pdu, uint32_t pdu_len_bytes);
+  void set_filter(const pcap_filter_cfg_t& cfg) { filter.set(cfg); }
 
 private:
   bool        enable_write = false;
   std::string filename;
   FILE*       pcap_file            = nullptr;
   int         emergency_handler_id = -1;
+  pcap_filter filter;
 };
 
 } // namespace srsran
@@ -0,0 +1,123 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PCAP_FILTER_H
+#define SRSRAN_PCAP_FILTER_H
+
+#include <array>
+#include <atomic>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/// Capture filter configuration, an empty configuration captures every PDU
+struct pcap_filter_cfg_t {
+  std::vector<uint16_t> rntis;            ///< RNTIs to capture, all if empty
+  std::vector<uint32_t> lcids;            ///< LCIDs to capture, all if empty
+  uint32_t              sample_ratio = 1; ///< Capture one in every N PDUs that pass the RNTI/LCID filters
+  uint32_t              max_len      = 0; ///< Truncate PDUs to their first N bytes, 0 captures full PDUs
+};
+
+/**
+ * @brief Parses a filter from a list of "key=value" tokens.
+ *
+ * Supported keys are rnti, lcid (comma separated lists, hexadecimal values prefixed with 0x), sample and snaplen.
+ * The single token "off" clears the filter.
+ * @return true if all tokens were parsed successfully
+ */
+bool parse_pcap_filter(const std::vector<std::string>& tokens, pcap_filter_cfg_t& cfg);
+
+std::string to_string(const pcap_filter_cfg_t& cfg);
+
+/**
+ * @brief Capture filter shared by the PCAP writers.
+ *
+ * The filter is evaluated by the threads that generate the PDUs before the PDU is copied, so that PDUs that are
+ * filtered out cost a couple of relaxed atomic loads. It can be reconfigured at any time from another thread (e.g. the
+ * command console), PDUs captured while the filter is being updated may be matched against a mix of the old and the
+ * new configuration.
+ */
+class pcap_filter
+{
+public:
+  pcap_filter();
+
+  void set(const pcap_filter_cfg_t& cfg);
+  void clear() { set(pcap_filter_cfg_t{}); }
+
+  /// Checks the RNTI and sampling filters, for layers that know the RNTI of the PDU (e.g. MAC)
+  bool match_rnti(uint16_t rnti)
+  {
+    if (rnti_enabled.load(std::memory_order_relaxed) and
+        (rnti_mask[rnti / 64].load(std::memory_order_relaxed) & (1UL << (rnti % 64))) == 0) {
+      return false;
+    }
+    return sample();
+  }
+
+  /// Checks the LCID and sampling filters, for layers that know the logical channel of the PDU (e.g. RLC)
+  bool match_lcid(uint32_t lcid) { return lcid_allowed(lcid) and sample(); }
+
+  /// Whether an LCID filter is set, layers that multiplex several logical channels in a PDU (e.g. MAC) only look for
+  /// the LCIDs of a PDU in that case
+  bool has_lcid_filter() const { return lcid_enabled.load(std::memory_order_relaxed); }
+
+  /// Checks the LCID filter alone, so that it can be evaluated for every LCID of a PDU before match_rnti()
+  bool lcid_allowed(uint32_t lcid) const
+  {
+    return not lcid_enabled.load(std::memory_order_relaxed) or
+           (lcid < max_lcid and (lcid_mask.load(std::memory_order_relaxed) & (1UL << lcid)) != 0);
+  }
+
+  /// Checks the sampling filter only, for layers that don't carry an RNTI nor an LCID (e.g. NAS, S1AP, NGAP)
+  bool match() { return sample(); }
+
+  /// Returns the number of bytes of a PDU of the given length that shall be captured
+  uint32_t snap_len(uint32_t len) const
+  {
+    uint32_t max = max_len.load(std::memory_order_relaxed);
+    return (max > 0 and len > max) ? max : len;
+  }
+
+private:
+  static const uint32_t max_lcid = 64;
+  static const uint32_t nof_rnti = 1U << 16U;
+
+  bool sample()
+  {
+    uint32_t ratio = sample_ratio.load(std::memory_order_relaxed);
+    return ratio <= 1 or sample_count.fetch_add(1, std::memory_order_relaxed) % ratio == 0;
+  }
+
+  std::atomic<bool>                                rnti_enabled{false};
+  std::atomic<bool>                                lcid_enabled{false};
+  std::array<std::atomic<uint64_t>, nof_rnti / 64> rnti_mask;
+  std::atomic<uint64_t>                            lcid_mask{0};
+  std::atomic<uint32_t>                            sample_ratio{1};
+  std::atomic<uint32_t>                            sample_count{0};
+  std::atomic<uint32_t>                            max_len{0};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PCAP_FILTER_H
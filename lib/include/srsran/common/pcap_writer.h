@@ -0,0 +1,114 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PCAP_WRITER_H
+#define SRSRAN_PCAP_WRITER_H
+
+#include "srsran/srslog/srslog.h"
+#include <array>
+#include <stdint.h>
+#include <string>
+#include <sys/time.h>
+
+namespace srsran {
+
+/**
+ * @brief Batched PCAP/PCAPNG file writer.
+ *
+ * Records are serialized into a page aligned buffer which is handed to the kernel with a single write(2) call once it
+ * fills up or when flush() is called, instead of issuing several stdio calls per record. In PCAPNG format, every
+ * interface (e.g. carrier) gets its own Interface Description Block, which is emitted the first time the interface is
+ * used in a file. Optionally, the output is rotated once the file exceeds a size limit, keeping the most recent files
+ * as <filename>.1 ... <filename>.<max_files - 1>.
+ *
+ * The writer is not thread-safe, it is meant to be owned by a single writer thread.
+ */
+class pcap_writer
+{
+public:
+  enum class format_t { pcap, pcapng };
+
+  struct args_t {
+    format_t format        = format_t::pcap;
+    uint64_t max_file_size = 0;       ///< Size in bytes after which the file is rotated, 0 disables rotation
+    uint32_t max_files     = 4;       ///< Number of files kept when rotating, including the one being written
+    uint32_t batch_size    = 1 << 20; ///< Size in bytes of the write buffer
+  };
+
+  /// Maximum number of interfaces (i.e. IDBs) per PCAPNG file
+  static const uint32_t max_interfaces = 32;
+
+  explicit pcap_writer(srslog::basic_logger& logger_);
+  ~pcap_writer();
+  pcap_writer(const pcap_writer&) = delete;
+  pcap_writer& operator=(const pcap_writer&) = delete;
+
+  int  open(const std::string& filename_, uint32_t dlt_, const args_t& args_);
+  int  open(const std::string& filename_, uint32_t dlt_) { return open(filename_, dlt_, args_t{}); }
+  void close();
+  bool is_open() const { return fd >= 0; }
+
+  /**
+   * @brief Appends a record made of a header (e.g. UDP and context) and a payload to the write buffer
+   * @param if_id Interface the record was captured on, only used in PCAPNG format
+   * @param ts Capture timestamp
+   * @param orig_payload_len Payload length before snap length truncation, 0 if the payload was not truncated
+   * @return SRSRAN_SUCCESS or SRSRAN_ERROR if the record could not be written
+   */
+  int write(uint32_t              if_id,
+            const struct timeval& ts,
+            const uint8_t*        hdr,
+            uint32_t              hdr_len,
+            const uint8_t*        payload,
+            uint32_t              payload_len,
+            uint32_t              orig_payload_len = 0);
+
+  /// Hands the buffered records to the kernel
+  int flush();
+
+  const std::string& get_filename() const { return filename; }
+
+private:
+  int  open_file();
+  int  rotate();
+  int  write_file_header();
+  int  write_interface_block(uint32_t if_id);
+  int  write_raw(const void* data, uint32_t len);
+  void append(const void* data, uint32_t len);
+
+  srslog::basic_logger& logger;
+  std::string           filename;
+  uint32_t              dlt  = 0;
+  args_t                args = {};
+  int                   fd   = -1;
+
+  uint8_t* buffer      = nullptr;
+  uint32_t buffer_len  = 0;
+  uint64_t file_size   = 0; ///< Bytes written to the current file, including the ones still buffered
+  uint32_t nof_records = 0; ///< Number of records written to the current file
+  uint32_t nof_if      = 0; ///< Number of IDBs written to the current file
+
+  std::array<int32_t, max_interfaces> if_idx = {}; ///< IDB index of every interface, -1 if not written yet
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PCAP_WRITER_H
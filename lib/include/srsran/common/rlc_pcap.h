@@ -23,6 +23,7 @@
 #define RLCPCAP_H
 
 #include "srsran/common/pcap.h"
+#include "srsran/common/pcap_filter.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 #include <stdint.h>
 
@@ -37,25 +38,27 @@ public:
   void close();
 
   void set_ue_id(uint16_t ue_id);
+  void set_filter(const pcap_filter_cfg_t& cfg) { filter.set(cfg); }
 
   void write_dl_ccch(uint8_t* pdu, uint32_t pdu_len_bytes);
   void write_ul_ccch(uint8_t* pdu, uint32_t pdu_len_bytes);
 
 private:
-  bool     enable_write = false;
-  FILE*    pcap_file    = nullptr;
-  uint32_t ue_id        = 0;
-  uint8_t  mode         = 0;
-  uint8_t  sn_length    = 0;
-  void     pack_and_write(uint8_t* pdu,
-                          uint32_t pdu_len_bytes,
-                          uint8_t  mode,
-                          uint8_t  direction,
-                          uint8_t  priority,
-                          uint8_t  seqnumberlength,
-                          uint16_t ueid,
-                          uint16_t channel_type,
-                          uint16_t channel_id);
+  bool        enable_write = false;
+  FILE*       pcap_file    = nullptr;
+  uint32_t    ue_id        = 0;
+  uint8_t     mode         = 0;
+  uint8_t     sn_length    = 0;
+  pcap_filter filter;
+  void        pack_and_write(uint8_t* pdu,
+                             uint32_t pdu_len_bytes,
+                             uint8_t  mode,
+                             uint8_t  direction,
+                             uint8_t  priority,
+                             uint8_t  seqnumberlength,
+                             uint16_t ueid,
+                             uint16_t channel_type,
+                             uint16_t channel_id);
 };
 
 } // namespace srsran
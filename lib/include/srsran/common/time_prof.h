@@ -162,6 +162,28 @@ public:
 };
 using sliding_window_stats_ms = sliding_window_stats<std::chrono::milliseconds>;
 
+/// Histogram of durations relative to a deadline (e.g. the duration of a slot). The deadline is split in nof_bins
+/// equally sized bins, with an extra bin counting the measurements that missed the deadline.
+struct deadline_histogram_stats {
+  deadline_histogram_stats(const char*              name_,
+                           const char*              logname,
+                           std::chrono::nanoseconds deadline_,
+                           size_t                   nof_bins      = 10,
+                           size_t                   print_period_ = 1000);
+  void operator()(std::chrono::nanoseconds duration);
+
+  uint64_t nof_samples() const { return count; }
+  uint64_t nof_misses() const { return bins.back(); }
+
+  srslog::basic_logger&    logger;
+  std::string              name;
+  std::chrono::nanoseconds deadline;
+  std::vector<uint64_t>    bins; ///< The last bin counts the deadline misses
+  uint64_t                 count        = 0;
+  long                     max_val      = 0;
+  size_t                   print_period = 0;
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_TIME_PROF_H
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_ENB_COMMAND_INTERFACE_H
 #define SRSRAN_ENB_COMMAND_INTERFACE_H
 
+#include "srsran/common/pcap_filter.h"
 #include <cstdint>
 
 namespace srsenb {
@@ -41,6 +42,12 @@ public:
   virtual void cmd_cell_gain(uint32_t cell_id, float gain) = 0;
 
   virtual void toggle_padding() = 0;
+
+  /**
+   * Sets the capture filter of every PCAP writer of the eNB/gNB.
+   * @param cfg Filter configuration, an empty configuration captures every PDU
+   */
+  virtual void cmd_pcap_filter(const srsran::pcap_filter_cfg_t& cfg) = 0;
 };
 } // namespace srsenb
 
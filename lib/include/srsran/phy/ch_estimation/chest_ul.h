@@ -59,6 +59,7 @@ typedef struct SRSRAN_API {
   float    snr_db;
   float    cfo_hz;
   float    ta_us;
+  bool     ce_dmrs_only; ///< ce only holds the PUSCH estimates of the DMRS symbol of every slot
 } srsran_chest_ul_res_t;
 
 typedef struct {
@@ -84,6 +85,8 @@ typedef struct {
   uint32_t smooth_filter_len;
   float    smooth_filter[SRSRAN_CHEST_MAX_SMOOTH_FIL_LEN];
 
+  bool pusch_ce_dmrs_only;
+
   srsran_interp_linsrsran_vec_t srsran_interp_linvec;
 
   srsran_cedron_freq_est_t srsran_cedron_freq_est;
@@ -105,6 +108,18 @@ SRSRAN_API void srsran_chest_ul_pregen(srsran_chest_ul_t*                 q,
                                        srsran_refsignal_dmrs_pusch_cfg_t* cfg,
                                        srsran_refsignal_srs_cfg_t*        srs_cfg);
 
+/**
+ * @brief Selects whether the PUSCH estimates are written to all the symbols of the grant or only to the DMRS symbols.
+ *
+ * The PUSCH estimates are the same for all the symbols of a slot, so the decoder can equalize every symbol with the
+ * estimates of the DMRS symbol of its slot, avoiding to write and read back the estimates of every resource element.
+ * Keep it disabled when the whole estimates grid is needed (e.g. plots). Disabled by default.
+ *
+ * @param q Uplink channel estimation instance
+ * @param enable True for writing only the estimates of the DMRS symbols
+ */
+SRSRAN_API void srsran_chest_ul_set_pusch_ce_dmrs_only(srsran_chest_ul_t* q, bool enable);
+
 SRSRAN_API int srsran_chest_ul_estimate_pusch(srsran_chest_ul_t*     q,
                                               srsran_ul_sf_cfg_t*    sf,
                                               srsran_pusch_cfg_t*    cfg,
@@ -29,8 +29,12 @@
 #include "rlf.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace srsran {
 
@@ -39,7 +43,8 @@ class channel
 public:
   struct args_t {
     // General
-    bool enable = false;
+    bool     enable      = false;
+    uint32_t nof_threads = 1; // Number of threads applying the channel, each thread processes a subset of the antennas
 
     // AWGN options
     bool  awgn_enable            = false;
@@ -76,18 +81,37 @@ public:
   void run(cf_t* in[SRSRAN_MAX_CHANNELS], cf_t* out[SRSRAN_MAX_CHANNELS], uint32_t len, const srsran_timestamp_t& t);
 
 private:
+  void run_channel(uint32_t i, cf_t* in, cf_t* out, uint32_t len, const srsran_timestamp_t& t);
+  void run_worker(uint32_t worker_idx, uint32_t nof_threads);
+
   srslog::basic_logger&    logger;
-  float                    hst_init_phase              = 0.0f;
-  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS] = {};
-  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]  = {};
-  srsran_channel_awgn_t*   awgn                        = nullptr;
-  srsran_channel_hst_t*    hst                         = nullptr;
-  srsran_channel_rlf_t*    rlf                         = nullptr;
-  cf_t*                    buffer_in                   = nullptr;
-  cf_t*                    buffer_out                  = nullptr;
-  uint32_t                 nof_channels                = 0;
-  uint32_t                 current_srate               = 0;
-  args_t                   args                        = {};
+  float                    hst_init_phase                  = 0.0f;
+  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS]     = {};
+  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]      = {};
+  srsran_channel_awgn_t*   awgn[SRSRAN_MAX_CHANNELS]       = {};
+  srsran_channel_hst_t*    hst[SRSRAN_MAX_CHANNELS]        = {};
+  srsran_channel_rlf_t*    rlf                             = nullptr;
+  cf_t*                    buffer_in[SRSRAN_MAX_CHANNELS]  = {};
+  cf_t*                    buffer_out[SRSRAN_MAX_CHANNELS] = {};
+  uint32_t                 nof_channels                    = 0;
+  uint32_t                 current_srate                   = 0;
+  args_t                   args                            = {};
+
+  // Worker threads, the calling thread processes the channels of worker 0
+  struct job_t {
+    cf_t**                    in   = nullptr;
+    cf_t**                    out  = nullptr;
+    uint32_t                  len  = 0;
+    const srsran_timestamp_t* t    = nullptr;
+    uint64_t                  id   = 0;
+    uint32_t                  busy = 0;
+  };
+  std::vector<std::thread> workers;
+  std::mutex               job_mutex;
+  std::condition_variable  job_cvar;
+  std::condition_variable  done_cvar;
+  job_t                    job     = {};
+  bool                     running = true;
 };
 
 typedef std::unique_ptr<channel> channel_ptr;
@@ -30,6 +30,8 @@
 
 #define SRSRAN_CHANNEL_FADING_MAXTAPS 9
 #define SRSRAN_CHANNEL_FADING_NTERMS 16
+#define SRSRAN_CHANNEL_FADING_FIR_HALF_LEN 16 // Half length of the windowed sinc that interpolates each tap
+#define SRSRAN_CHANNEL_FADING_FIR_MAX_LEN 64  // Longest FIR filtered in time domain, longer ones are filtered by FFT
 
 typedef enum {
   srsran_channel_fading_model_none = 0,
@@ -52,7 +54,15 @@ typedef struct {
   float coeff_alpha[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS]; // Angle of arrival
   float coeff_a[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Random phase
   float coeff_b[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Random phase
-  cf_t* h_tap[SRSRAN_CHANNEL_FADING_MAXTAPS]; // Static tap signal in frequency domain
+  cf_t* h_tap[SRSRAN_CHANNEL_FADING_MAXTAPS]; // Static tap signal in frequency domain, FFT shifted
+
+  // Time domain FIR, used for short tap profiles
+  bool     use_fir;    // Filter in time domain instead of by FFT
+  uint32_t fir_len;    // Number of FIR coefficients, 0 if the FIR can not be used
+  uint32_t fir_offset; // Delay of the first FIR coefficient in samples
+  cf_t*    fir_tap[SRSRAN_CHANNEL_FADING_MAXTAPS]; // Static tap impulse response, length fir_len
+  cf_t*    fir_coeff;                              // Channel impulse response, length fir_len
+  cf_t*    fir_state;                              // Input history followed by the current segment
 
   // Utils
   srsran_dft_plan_t fft;             // DFT to frequency domain
@@ -74,6 +84,15 @@ SRSRAN_API int srsran_channel_fading_init(srsran_channel_fading_t* q, double sra
 
 SRSRAN_API void srsran_channel_fading_free(srsran_channel_fading_t* q);
 
+/**
+ * @brief Selects time domain (FIR) or frequency domain (FFT) filtering. The FIR is selected on initialisation if the
+ * channel impulse response is short enough, this is only meant for testing and benchmarking. It resets the filter state.
+ * @param q Fading channel object
+ * @param enable Set to true for time domain filtering
+ * @return SRSRAN_SUCCESS if the filtering was selected, SRSRAN_ERROR if the FIR is not available for this channel
+ */
+SRSRAN_API int srsran_channel_fading_set_fir(srsran_channel_fading_t* q, bool enable);
+
 SRSRAN_API double srsran_channel_fading_execute(srsran_channel_fading_t* q,
                                                 const cf_t*              in,
                                                 cf_t*                    out,
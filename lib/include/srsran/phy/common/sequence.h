@@ -53,6 +53,13 @@ srsran_sequence_state_apply_c(srsran_sequence_state_t* s, const int8_t* in, int8
 SRSRAN_API
 void srsran_sequence_state_apply_bit(srsran_sequence_state_t* s, const uint8_t* in, uint8_t* out, uint32_t length);
 
+/**
+ * Applies the sequence to packed bits and advances the state. The sequence can be applied in several calls as long as
+ * the length of all but the last one is a multiple of 24 bits.
+ */
+SRSRAN_API void
+srsran_sequence_state_apply_packed(srsran_sequence_state_t* s, const uint8_t* in, uint8_t* out, uint32_t length);
+
 SRSRAN_API void srsran_sequence_state_advance(srsran_sequence_state_t* s, uint32_t length);
 
 typedef struct SRSRAN_API {
@@ -102,6 +109,9 @@ SRSRAN_API void srsran_sequence_pdsch_apply_pack(const uint8_t* in,
                                                  uint32_t       cell_id,
                                                  uint32_t       len);
 
+SRSRAN_API void
+srsran_sequence_pdsch_state_init(srsran_sequence_state_t* s, uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id);
+
 SRSRAN_API void srsran_sequence_pdsch_apply_f(const float* in,
                                               float*       out,
                                               uint16_t     rnti,
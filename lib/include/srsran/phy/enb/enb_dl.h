@@ -119,6 +119,13 @@ SRSRAN_API int srsran_enb_dl_put_pdcch_ul(srsran_enb_dl_t* q, srsran_dci_cfg_t*
 SRSRAN_API int
 srsran_enb_dl_put_pdsch(srsran_enb_dl_t* q, srsran_pdsch_cfg_t* pdsch, uint8_t* data[SRSRAN_MAX_CODEWORDS]);
 
+/* Encodes the PDSCH of all the grants of the subframe at once, see srsran_pdsch_encode_batch() */
+SRSRAN_API int srsran_enb_dl_put_pdsch_batch(srsran_enb_dl_t*         q,
+                                             srsran_pdsch_cfg_t*      pdsch[],
+                                             uint8_t*                 data[][SRSRAN_MAX_CODEWORDS],
+                                             uint32_t                 nof_pdsch,
+                                             srsran_pdsch_enc_time_t* time);
+
 SRSRAN_API int srsran_enb_dl_put_pmch(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data);
 
 SRSRAN_API void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q);
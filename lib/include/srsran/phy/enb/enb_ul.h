@@ -61,6 +61,13 @@ typedef struct SRSRAN_API {
   srsran_pusch_t    pusch;
   srsran_pucch_t    pucch;
 
+  // PUCCH format 1, 1a and 1b resources of all the UEs decoded jointly
+  srsran_pucch_cfg_t* pucch_cand_cfg;
+  srsran_pucch_res_t* pucch_cand_res;
+  uint32_t*           pucch_cand_ue;  ///< UE the resource belongs to
+  uint32_t*           pucch_cand_idx; ///< Index of the resource among the possible resources of the UE
+  uint32_t            pucch_cand_max;
+
 } srsran_enb_ul_t;
 
 /* This function shall be called just after the initial synchronization */
@@ -80,6 +87,29 @@ SRSRAN_API int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
                                        srsran_pucch_cfg_t* cfg,
                                        srsran_pucch_res_t* res);
 
+/**
+ * @brief Decodes the PUCCH of several UEs in the same subframe.
+ *
+ * The UEs that transmit PUCCH format 1, 1a or 1b are received jointly with srsran_pucch_decode_format1_joint(), which
+ * processes each PUCCH PRB once for all of them. All the possible resources of a UE (i.e. scheduling request and
+ * channel selection hypotheses) are decoded and resolved as srsran_enb_ul_get_pucch() does. The rest of UEs are decoded
+ * one by one with srsran_enb_ul_get_pucch().
+ *
+ * @param q eNb uplink object
+ * @param ul_sf Uplink subframe configuration
+ * @param cfg Array of nof_ue PUCCH configurations, modified in the same way srsran_enb_ul_get_pucch() does
+ * @param res Array of nof_ue PUCCH results
+ * @param ret Array of nof_ue return codes, the value srsran_enb_ul_get_pucch() would return for each UE
+ * @param nof_ue Number of UEs
+ * @return SRSRAN_SUCCESS, or SRSRAN_ERROR if the resources could not be allocated
+ */
+SRSRAN_API int srsran_enb_ul_get_pucch_multi(srsran_enb_ul_t*    q,
+                                             srsran_ul_sf_cfg_t* ul_sf,
+                                             srsran_pucch_cfg_t* cfg,
+                                             srsran_pucch_res_t* res,
+                                             int*                ret,
+                                             uint32_t            nof_ue);
+
 SRSRAN_API int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                                        srsran_ul_sf_cfg_t* ul_sf,
                                        srsran_pusch_cfg_t* cfg,
@@ -34,6 +34,9 @@
 #include "srsran/config.h"
 #include <stdbool.h>
 
+/// Maximum number of frames decoded at once by the batch decoder
+#define SRSRAN_VITERBI_MAX_BATCH 32
+
 typedef enum { SRSRAN_VITERBI_27 = 0, SRSRAN_VITERBI_29, SRSRAN_VITERBI_37, SRSRAN_VITERBI_39 } srsran_viterbi_type_t;
 
 typedef struct SRSRAN_API {
@@ -47,11 +50,14 @@ typedef struct SRSRAN_API {
   int (*decode)(void*, uint8_t*, uint8_t*, uint32_t);
   int (*decode_s)(void*, uint16_t*, uint8_t*, uint32_t);
   int (*decode_f)(void*, float*, uint8_t*, uint32_t);
+  int (*decode_s_batch)(void*, uint16_t**, uint8_t**, uint32_t, uint32_t);
   void (*free)(void*);
+  void*     ptr_batch;
   uint8_t*  tmp;
   uint16_t* tmp_s;
   uint8_t*  symbols_uc;
   uint16_t* symbols_us;
+  uint16_t* symbols_us_batch;
 } srsran_viterbi_t;
 
 SRSRAN_API int srsran_viterbi_init(srsran_viterbi_t*     q,
@@ -74,6 +80,35 @@ SRSRAN_API int srsran_viterbi_decode_us(srsran_viterbi_t* q, uint16_t* symbols,
 
 SRSRAN_API int srsran_viterbi_decode_uc(srsran_viterbi_t* q, uint8_t* symbols, uint8_t* data, uint32_t frame_length);
 
+/**
+ * @brief Decodes a list of frames of the same length.
+ *
+ * When the decoder was initialized with batch support (AVX512), up to SRSRAN_VITERBI_MAX_BATCH frames are decoded in
+ * parallel and the result is the same as decoding every frame with srsran_viterbi_decode_f(). Otherwise, the frames are
+ * decoded one after the other.
+ *
+ * @param[in] q Viterbi decoder
+ * @param[in] symbols Real-valued symbols of every frame
+ * @param[out] data Decoded bits of every frame
+ * @param[in] nof_frames Number of frames
+ * @param[in] frame_length Number of bits of every frame
+ * @return SRSRAN_SUCCESS if all the frames were decoded, SRSRAN_ERROR otherwise
+ */
+SRSRAN_API int srsran_viterbi_decode_f_batch(srsran_viterbi_t* q,
+                                             float**           symbols,
+                                             uint8_t**         data,
+                                             uint32_t          nof_frames,
+                                             uint32_t          frame_length);
+
+/**
+ * @brief Same as srsran_viterbi_decode_f_batch() with 16-bit quantized symbols, see srsran_viterbi_decode_us().
+ */
+SRSRAN_API int srsran_viterbi_decode_us_batch(srsran_viterbi_t* q,
+                                              uint16_t**        symbols,
+                                              uint8_t**         data,
+                                              uint32_t          nof_frames,
+                                              uint32_t          frame_length);
+
 SRSRAN_API int srsran_viterbi_init_sse(srsran_viterbi_t*     q,
                                        srsran_viterbi_type_t type,
                                        int                   poly[3],
@@ -92,4 +127,10 @@ SRSRAN_API int srsran_viterbi_init_avx2(srsran_viterbi_t*     q,
                                         uint32_t              max_frame_length,
                                         bool                  tail_bitting);
 
+SRSRAN_API int srsran_viterbi_init_avx512(srsran_viterbi_t*     q,
+                                          srsran_viterbi_type_t type,
+                                          int                   poly[3],
+                                          uint32_t              max_frame_length,
+                                          bool                  tail_bitting);
+
 #endif // SRSRAN_VITERBI_H
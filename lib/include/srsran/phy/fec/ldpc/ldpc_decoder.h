@@ -55,11 +55,12 @@ typedef enum {
  * \brief Describes the LDPC decoder configuration arguments.
  */
 typedef struct {
-  srsran_ldpc_decoder_type_t type;         /*!< \brief Type of LDPC decoder. */
-  srsran_basegraph_t         bg;           /*!< \brief The desired base graph (BG1 or BG2). */
-  uint16_t                   ls;           /*!< \brief The desired lifting size. */
-  float                      scaling_fctr; /*!< \brief Scaling factor of the normalized min-sum algorithm.*/
-  uint32_t                   max_nof_iter; /*!< \brief Maximum number of iterations, set to 0 for default value. */
+  srsran_ldpc_decoder_type_t type;                   /*!< \brief Type of LDPC decoder. */
+  srsran_basegraph_t         bg;                     /*!< \brief The desired base graph (BG1 or BG2). */
+  uint16_t                   ls;                     /*!< \brief The desired lifting size. */
+  float                      scaling_fctr;           /*!< \brief Scaling factor of the normalized min-sum algorithm.*/
+  uint32_t                   max_nof_iter;           /*!< \brief Maximum number of iterations, set to 0 for default. */
+  bool                       disable_syndrome_check; /*!< \brief Disables the parity-check early stop (no CRC case). */
 } srsran_ldpc_decoder_args_t;
 
 /*!
@@ -82,6 +83,10 @@ typedef struct SRSRAN_API {
 
   float scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum algorithm. */
 
+  bool     syndrome_check; /*!< \brief Early stop when all parity checks are satisfied (no CRC case). */
+  uint8_t* hard_bits;      /*!< \brief Hard decisions of the codeword, used by the syndrome check. */
+  uint8_t* syndrome;       /*!< \brief Syndrome of the current layer, used by the syndrome check. */
+
   void (*free)(void*); /*!< \brief Pointer to a "destructor". */
 
   int (*decode_f)(void*,
@@ -125,6 +130,7 @@ SRSRAN_API void srsran_ldpc_decoder_free(srsran_ldpc_decoder_t* q);
  * \param[out] message The message (uncoded bits) resulting from the decoding
  *    operation.
  * \param[in] cdwd_rm_length The number of bits forming the codeword (after rate matching).
+ * \return -1 if an error occurred, the number of used iterations otherwise.
  */
 SRSRAN_API int
 srsran_ldpc_decoder_decode_f(srsran_ldpc_decoder_t* q, const float* llrs, uint8_t* message, uint32_t cdwd_rm_length);
@@ -140,6 +146,7 @@ srsran_ldpc_decoder_decode_f(srsran_ldpc_decoder_t* q, const float* llrs, uint8_
  * \param[out] message The message (uncoded bits) resulting from the decoding
  *    operation.
  * \param[in] cdwd_rm_length The number of bits forming the codeword (after rate matching).
+ * \return -1 if an error occurred, the number of used iterations otherwise.
  */
 SRSRAN_API int
 srsran_ldpc_decoder_decode_s(srsran_ldpc_decoder_t* q, const int16_t* llrs, uint8_t* message, uint32_t cdwd_rm_length);
@@ -155,6 +162,7 @@ srsran_ldpc_decoder_decode_s(srsran_ldpc_decoder_t* q, const int16_t* llrs, uint
  * \param[out] message The message (uncoded bits) resulting from the decoding
  *    operation.
  * \param[in] cdwd_rm_length The number of bits forming the codeword (after rate matching).
+ * \return -1 if an error occurred, the number of used iterations otherwise.
  */
 SRSRAN_API int
 srsran_ldpc_decoder_decode_c(srsran_ldpc_decoder_t* q, const int8_t* llrs, uint8_t* message, uint32_t cdwd_rm_length);
@@ -38,6 +38,9 @@
 #include "srsran/phy/fec/turbo/tc_interl.h"
 #define SRSRAN_TCOD_MAX_LEN_CB_BYTES (6144 / 8)
 
+/* Maximum number of code blocks encoded at once by srsran_tcod_encode_lut_batch() */
+#define SRSRAN_TCOD_MAX_BATCH 8
+
 #ifndef SRSRAN_TX_NULL
 #define SRSRAN_TX_NULL 100
 #endif
@@ -45,6 +48,7 @@
 typedef struct SRSRAN_API {
   uint32_t max_long_cb;
   uint8_t* temp;
+  uint8_t* temp_batch;
 } srsran_tcod_t;
 
 /* This structure is used as an output for the LUT version of the encoder.
@@ -66,6 +70,23 @@ SRSRAN_API int srsran_tcod_encode_lut(srsran_tcod_t* h,
                                       uint32_t       cblen_idx,
                                       bool           last_cb);
 
+/**
+ * Encodes several code blocks of the same size at once with the LUT encoder. The code blocks shall already contain
+ * their CRC, the same output as srsran_tcod_encode_lut() is produced for every one of them.
+ *
+ * @param h Turbo coder object
+ * @param input Code blocks, packed, with an extra byte where the systematic tail bits are written
+ * @param parity Output parity bits, packed as in srsran_tcod_encode_lut()
+ * @param cblen_idx Code block size index, common to all the code blocks
+ * @param nof_cb Number of code blocks, up to SRSRAN_TCOD_MAX_BATCH
+ * @return The number of encoded bits of every code block, -1 on error
+ */
+SRSRAN_API int srsran_tcod_encode_lut_batch(srsran_tcod_t* h,
+                                            uint8_t*       input[SRSRAN_TCOD_MAX_BATCH],
+                                            uint8_t*       parity[SRSRAN_TCOD_MAX_BATCH],
+                                            uint32_t       cblen_idx,
+                                            uint32_t       nof_cb);
+
 SRSRAN_API void srsran_tcod_gentable();
 
 #endif // SRSRAN_TURBOCODER_H
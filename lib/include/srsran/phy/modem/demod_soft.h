@@ -23,7 +23,7 @@
  *  File:         demod_soft.h
  *
  *  Description:  Soft demodulator.
- *                Supports BPSK, QPSK, 16QAM and 64QAM.
+ *                Supports BPSK, QPSK, 16QAM, 64QAM and 256QAM.
  *
  *  Reference:    3GPP TS 36.211 version 10.0.0 Release 10 Sec. 7.1
  *****************************************************************************/
@@ -42,4 +42,33 @@ SRSRAN_API int srsran_demod_soft_demodulate_s(srsran_mod_t modulation, const cf_
 
 SRSRAN_API int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols, int8_t* llr, int nsymbols);
 
+/**
+ * @brief Equalizes (ZF, or MMSE if noise_estimate > 0) the received symbols of a single antenna port and demodulates
+ * them into 8 bit LLR.
+ *
+ * It is equivalent to srsran_predecoding_single() followed by srsran_demod_soft_demodulate_b(), but the symbols are
+ * processed in small blocks so that the equalized symbols never leave the L1 cache and no intermediate buffer of the
+ * size of the grant is required. The inputs shall have the same alignment as required by srsran_predecoding_single().
+ *
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_demod_soft_equalize_demodulate_b(srsran_mod_t modulation,
+                                                       cf_t*        y,
+                                                       cf_t*        h,
+                                                       float        scaling,
+                                                       float        noise_estimate,
+                                                       int8_t*      llr,
+                                                       int          nsymbols);
+
+/**
+ * @brief Same as srsran_demod_soft_equalize_demodulate_b() with 16 bit LLR
+ */
+SRSRAN_API int srsran_demod_soft_equalize_demodulate_s(srsran_mod_t modulation,
+                                                       cf_t*        y,
+                                                       cf_t*        h,
+                                                       float        scaling,
+                                                       float        noise_estimate,
+                                                       short*       llr,
+                                                       int          nsymbols);
+
 #endif // SRSRAN_DEMOD_SOFT_H
@@ -65,6 +65,7 @@ typedef struct SRSRAN_API {
   cf_t*    d;
   uint8_t* e;
   float    rm_f[3 * (SRSRAN_DCI_MAX_BITS + 16)];
+  float*   rm_f_batch;
   float*   llr;
 
   /* tx & rx objects */
@@ -104,6 +105,22 @@ SRSRAN_API int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
 SRSRAN_API int
 srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg);
 
+/**
+ * @brief Same as calling srsran_pdcch_decode_msg() for every message of a list. The messages of the same size are
+ * Viterbi decoded together, see srsran_viterbi_decode_f_batch()
+ * @param q PDCCH object
+ * @param sf Subframe configuration
+ * @param dci_cfg DCI configuration
+ * @param msg Messages to decode, with their location and format set
+ * @param nof_msg Number of messages
+ * @return SRSRAN_SUCCESS if all the messages were processed, an error code otherwise
+ */
+SRSRAN_API int srsran_pdcch_decode_msg_batch(srsran_pdcch_t*     q,
+                                             srsran_dl_sf_cfg_t* sf,
+                                             srsran_dci_cfg_t*   dci_cfg,
+                                             srsran_dci_msg_t*   msg,
+                                             uint32_t            nof_msg);
+
 /**
  * @brief Computes decoded DCI correlation. It encodes the given DCI message and compares it with the received LLRs
  * @param q PDCCH object
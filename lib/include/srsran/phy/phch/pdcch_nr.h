@@ -50,14 +50,38 @@ typedef struct {
   bool measure_time;
 } srsran_pdcch_nr_args_t;
 
+/**
+ * @brief NR PDCCH decoder result
+ */
+typedef struct SRSRAN_API {
+  float evm;
+  bool  crc;
+} srsran_pdcch_nr_res_t;
+
+/**
+ * @brief DCI candidate queued for decoding along with other candidates of the same size and aggregation level
+ */
+typedef struct SRSRAN_API {
+  srsran_dci_msg_nr_t*   dci_msg;   // DCI message to decode
+  srsran_pdcch_nr_res_t* res;       // Where the decoding result is written
+  uint32_t               K;         // Payload size including CRC
+  uint32_t               E;         // Number of Rate-Matched bits
+  int8_t*                d;         // De-rate-matched soft bits, decoder input
+  uint8_t*               allocated; // Decoder output
+} srsran_pdcch_nr_cand_t;
+
 /**
  * @brief PDCCH Attributes and objects required to encode/decode NR PDCCH
  */
 typedef struct SRSRAN_API {
   bool                   is_tx;
   srsran_polar_code_t    code;
+  uint32_t               code_E; // Rate-matched length the polar code was computed for, 0 if none
   srsran_polar_encoder_t encoder;
   srsran_polar_decoder_t decoder;
+  srsran_polar_decoder_t decoder_batch;                            // Decodes the queued candidates of equal K and E
+  srsran_pdcch_nr_cand_t batch[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR]; // Candidates queued for decoding
+  uint32_t               batch_count;                              // Number of queued candidates
   srsran_polar_rm_t      rm;
   srsran_carrier_nr_t    carrier;
   srsran_coreset_t       coreset;
@@ -67,6 +91,10 @@ typedef struct SRSRAN_API {
   uint8_t*               f;         // bits at the Rate matching output
   uint8_t*               allocated; // Allocated polar bit buffer, encoder input, decoder output
   cf_t*                  symbols;
+  int8_t*                llr;          // Soft bits of the last demodulated location, before descrambling
+  uint32_t               llr_count;    // Number of soft bits of the last demodulated location
+  srsran_dci_location_t  llr_location; // Last demodulated location
+  float                  llr_evm;      // EVM of the last demodulated location
   srsran_modem_table_t   modem_table;
   srsran_evm_buffer_t*   evm_buffer;
   bool                   meas_time_en;
@@ -76,14 +104,6 @@ typedef struct SRSRAN_API {
   uint32_t               E;
 } srsran_pdcch_nr_t;
 
-/**
- * @brief NR PDCCH decoder result
- */
-typedef struct SRSRAN_API {
-  float evm;
-  bool  crc;
-} srsran_pdcch_nr_res_t;
-
 /**
  * @brief Function for generating NR PDCCH candidate locations n_cce for a given CORESET, search space, aggregation
  * level and slot.
@@ -154,6 +174,64 @@ SRSRAN_API int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
                                       srsran_dci_msg_nr_t*    dci_msg,
                                       srsran_pdcch_nr_res_t*  res);
 
+/**
+ * @brief Demodulates the PDCCH resource elements of a candidate location into soft bits
+ *
+ * The soft bits do not depend on the DCI size nor on the RNTI, so a blind search can demodulate every candidate
+ * location once and decode it for every DCI size and RNTI with srsran_pdcch_nr_decode_demodulated().
+ *
+ * @param[in,out] q provides PDCCH decoder object, the CORESET of the location shall be set
+ * @param[in] slot_symbols provides slot resource grid
+ * @param[in] ce provides channel estimated resource elements of the location
+ * @param[in] location provides the candidate location
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_pdcch_nr_demodulate(srsran_pdcch_nr_t*           q,
+                                          cf_t*                        slot_symbols,
+                                          srsran_dmrs_pdcch_ce_t*      ce,
+                                          const srsran_dci_location_t* location);
+
+/**
+ * @brief Decodes a DCI from the soft bits of the last location demodulated with srsran_pdcch_nr_demodulate()
+ *
+ * @param[in,out] q provides PDCCH decoder object
+ * @param[in,out] dci_msg Provides with the DCI message location, RNTI, RNTI type and so on. Also, the message data
+ * buffer
+ * @param[out] res Provides the PDCCH result information
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int
+srsran_pdcch_nr_decode_demodulated(srsran_pdcch_nr_t* q, srsran_dci_msg_nr_t* dci_msg, srsran_pdcch_nr_res_t* res);
+
+/**
+ * @brief Queues the decoding of a DCI from the soft bits of the last location demodulated with
+ * srsran_pdcch_nr_demodulate()
+ *
+ * The soft bits are descrambled and de-rate-matched right away, so another location can be demodulated before the
+ * queued candidates are decoded by srsran_pdcch_nr_decode_batch_run(). The DCI message and the result shall remain
+ * valid until then. The queue is run automatically when it is full.
+ *
+ * @param[in,out] q provides PDCCH decoder object
+ * @param[in,out] dci_msg Provides with the DCI message location, RNTI, RNTI type and so on. Also, the message data
+ * buffer
+ * @param[out] res Provides the PDCCH result information
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int
+srsran_pdcch_nr_decode_batch_add(srsran_pdcch_nr_t* q, srsran_dci_msg_nr_t* dci_msg, srsran_pdcch_nr_res_t* res);
+
+/**
+ * @brief Decodes all the DCI queued with srsran_pdcch_nr_decode_batch_add()
+ *
+ * The queued candidates with the same payload size and aggregation level are polar decoded at once with
+ * srsran_polar_decoder_decode_c_batch(). The results are the same as decoding every candidate with
+ * srsran_pdcch_nr_decode_demodulated().
+ *
+ * @param[in,out] q provides PDCCH decoder object
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_pdcch_nr_decode_batch_run(srsran_pdcch_nr_t* q);
+
 /**
  * @brief Stringifies NR PDCCH decoding information from the latest encoded/decoded transmission
  *
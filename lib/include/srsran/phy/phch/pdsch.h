@@ -78,6 +78,16 @@ typedef struct SRSRAN_API {
 
 } srsran_pdsch_t;
 
+/* Maximum number of PDSCH that srsran_pdsch_encode_batch() processes at once, larger batches are split */
+#define SRSRAN_PDSCH_MAX_BATCH 32
+
+/* Time spent in every stage of srsran_pdsch_encode_batch(), in microseconds */
+typedef struct SRSRAN_API {
+  uint32_t coding_us;
+  uint32_t modulation_us;
+  uint32_t mapping_us;
+} srsran_pdsch_enc_time_t;
+
 typedef struct {
   uint8_t* payload;
   bool     crc;
@@ -103,6 +113,31 @@ SRSRAN_API int srsran_pdsch_encode(srsran_pdsch_t*     q,
                                    uint8_t*            data[SRSRAN_MAX_CODEWORDS],
                                    cf_t*               sf_symbols[SRSRAN_MAX_PORTS]);
 
+/**
+ * Encodes several PDSCH of the same subframe, e.g. the grants of all the UEs, with the same output as calling
+ * srsran_pdsch_encode() for each of them in order. Every stage (channel coding, scrambling and modulation, and
+ * mapping) runs over all the PDSCH before the next one, so that the code blocks of different UEs are turbo encoded
+ * together.
+ *
+ * @param q PDSCH object
+ * @param sf Subframe configuration
+ * @param cfg Configuration of every PDSCH
+ * @param data Transport blocks of every PDSCH
+ * @param nof_pdsch Number of PDSCH
+ * @param sf_symbols Resource grid of every port
+ * @param time Optional output, time spent in every stage
+ * @return SRSRAN_SUCCESS, or an error code. The configuration of every PDSCH is checked before encoding any of them
+ * (NULL configuration or softbuffer, no transport block, too many RE): if one of these checks fails, the resource grid
+ * is left untouched. Errors found while encoding, e.g. in the channel coding, may leave the grid partially written
+ */
+SRSRAN_API int srsran_pdsch_encode_batch(srsran_pdsch_t*          q,
+                                         srsran_dl_sf_cfg_t*      sf,
+                                         srsran_pdsch_cfg_t*      cfg[],
+                                         uint8_t*                 data[][SRSRAN_MAX_CODEWORDS],
+                                         uint32_t                 nof_pdsch,
+                                         cf_t*                    sf_symbols[SRSRAN_MAX_PORTS],
+                                         srsran_pdsch_enc_time_t* time);
+
 SRSRAN_API int srsran_pdsch_decode(srsran_pdsch_t*        q,
                                    srsran_dl_sf_cfg_t*    sf,
                                    srsran_pdsch_cfg_t*    cfg,
@@ -46,6 +46,7 @@ typedef struct SRSRAN_API {
   srsran_sch_nr_args_t sch;
   bool                 measure_evm;
   bool                 measure_time;
+  bool                 fused_equalizer; ///< Fuses equalizer and demodulator for a single layer, d is not written
   uint32_t             max_prb;
   uint32_t             max_layers;
 } srsran_pdsch_nr_args_t;
@@ -66,6 +67,7 @@ typedef struct SRSRAN_API {
   srsran_evm_buffer_t* evm_buffer;
   bool                 meas_time_en;
   uint32_t             meas_time_us;
+  bool                 fused_eq_en;
   srsran_re_pattern_t  dmrs_re_pattern;
   uint32_t             nof_rvd_re;
 } srsran_pdsch_nr_t;
@@ -78,6 +78,7 @@ typedef struct SRSRAN_API {
   cf_t* z_tmp;
   cf_t* ce;
 
+  cf_t cs_dft[SRSRAN_NRE][SRSRAN_NRE]; ///< Cyclic shift correlation bank, only initialised in the eNb
 } srsran_pucch_t;
 
 typedef struct SRSRAN_API {
@@ -119,6 +120,33 @@ SRSRAN_API int srsran_pucch_decode(srsran_pucch_t*        q,
                                    cf_t*                  sf_symbols,
                                    srsran_pucch_res_t*    data);
 
+/**
+ * @brief Decodes several PUCCH format 1, 1a and 1b resources at once.
+ *
+ * All the resources that share the same PRBs are received jointly. The PRBs are extracted once, every SC-FDMA symbol is
+ * despread with the base sequence and transformed into the cyclic shift domain with a 12-point DFT. Each resource then
+ * picks its own cyclic shift and orthogonal cover from this correlation bank, and the noise is estimated once per PRB
+ * from the cyclic shifts that none of the resources use. The interference from the other resources in the PRB is not
+ * accounted as noise, so the correlation does not degrade as more UEs are multiplexed.
+ *
+ * The format and n_pucch of every configuration shall be set prior to this call. The scheduling request and channel
+ * selection hypotheses are not resolved, a resource shall be provided for each of them.
+ *
+ * @param q PUCCH object, initialised for the eNb
+ * @param sf Uplink subframe configuration
+ * @param cfg Array of nof_cfg PUCCH configurations
+ * @param nof_cfg Number of configurations
+ * @param sf_symbols Received resource grid
+ * @param res Array of nof_cfg results
+ * @return SRSRAN_SUCCESS if all the resources were decoded, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_pucch_decode_format1_joint(srsran_pucch_t*     q,
+                                                 srsran_ul_sf_cfg_t* sf,
+                                                 srsran_pucch_cfg_t* cfg,
+                                                 uint32_t            nof_cfg,
+                                                 cf_t*               sf_symbols,
+                                                 srsran_pucch_res_t* res);
+
 /* Other utilities. These functions do not modify the state and run in real-time */
 SRSRAN_API float srsran_pucch_alpha_format1(const uint32_t n_cs_cell[SRSRAN_NSLOTS_X_FRAME][SRSRAN_CP_NORM_NSYMB],
                                             const srsran_pucch_cfg_t* cfg,
@@ -59,6 +59,8 @@ typedef struct SRSRAN_API {
   /* buffers */
   uint8_t*         cb_in;
   uint8_t*         parity_bits;
+  uint8_t*         cb_in_batch;
+  uint8_t*         parity_bits_batch;
   void*            e;
   uint8_t*         temp_g_bits;
   uint32_t*        ul_interleaver;
@@ -73,6 +75,14 @@ typedef struct SRSRAN_API {
 
 } srsran_sch_t;
 
+/* Transport block encoded by srsran_dlsch_encode_batch() */
+typedef struct SRSRAN_API {
+  srsran_pdsch_cfg_t* cfg;
+  uint32_t            tb_idx;
+  uint8_t*            data;
+  uint8_t*            e_bits;
+} srsran_dlsch_batch_tb_t;
+
 SRSRAN_API int srsran_sch_init(srsran_sch_t* q);
 
 SRSRAN_API void srsran_sch_free(srsran_sch_t* q);
@@ -90,6 +100,18 @@ SRSRAN_API int srsran_dlsch_encode2(srsran_sch_t*       q,
                                     int                 codeword_idx,
                                     uint32_t            nof_layers);
 
+/**
+ * Encodes several transport blocks, possibly from different PDSCH, with the same output as calling
+ * srsran_dlsch_encode2() for each of them. The code blocks of the same size are turbo encoded together, regardless of
+ * the transport block they belong to.
+ *
+ * @param[in] q Initialized
+ * @param[in] tb Transport blocks, each with its PDSCH configuration, codeword index, data and output buffer
+ * @param[in] nof_tb Number of transport blocks
+ * @return Error code
+ */
+SRSRAN_API int srsran_dlsch_encode_batch(srsran_sch_t* q, srsran_dlsch_batch_tb_t* tb, uint32_t nof_tb);
+
 SRSRAN_API int srsran_dlsch_decode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, int16_t* e_bits, uint8_t* data);
 
 SRSRAN_API int srsran_dlsch_decode2(srsran_sch_t*       q,
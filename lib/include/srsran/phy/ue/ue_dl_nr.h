@@ -54,6 +54,14 @@ typedef struct SRSRAN_API {
   uint32_t                    nof_bits;
 } srsran_ue_dl_nr_pdcch_info_t;
 
+/// PDCCH location (CORESET and CCEs) shared by all the blind search candidates that map onto it
+typedef struct SRSRAN_API {
+  uint32_t                    coreset_id;
+  srsran_dci_location_t       location;
+  srsran_dmrs_pdcch_measure_t measure;
+  bool                        pruned; ///< Discarded by its DMRS measurement, none of its candidates is decoded
+} srsran_ue_dl_nr_pdcch_location_t;
+
 typedef struct SRSRAN_API {
   uint32_t max_prb;
   uint32_t nof_rx_antennas;
@@ -78,6 +86,13 @@ typedef struct SRSRAN_API {
   srsran_ue_dl_nr_pdcch_info_t pdcch_info[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
   uint32_t                     pdcch_info_count;
 
+  /// Blind search candidates from all SS in search order, and the locations they map onto
+  srsran_dci_msg_nr_t              pdcch_cand[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
+  uint32_t                         pdcch_cand_loc[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
+  uint32_t                         pdcch_cand_count;
+  srsran_ue_dl_nr_pdcch_location_t pdcch_loc[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
+  uint32_t                         pdcch_loc_count;
+
   /// DCI packing/unpacking object
   srsran_dci_nr_t dci;
 
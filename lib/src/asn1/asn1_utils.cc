@@ -20,6 +20,7 @@
  */
 
 #include "srsran/asn1/asn1_utils.h"
+#include <atomic>
 
 namespace asn1 {
 
@@ -144,34 +145,96 @@ int bit_ref_impl<Ptr>::distance_bytes_end() const
   return ((int)(max_ptr - ptr)) - ((offset) ? 1 : 0);
 }
 
+namespace {
+
+inline uint64_t to_be64(uint64_t val)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  return __builtin_bswap64(val);
+#else
+  return val;
+#endif
+}
+
+/// Writes the n_bytes most significant bytes of val in network byte order. Only the n_bytes bytes are written, using
+/// the widest stores that fit, since the next call will read back the last one
+inline void store_be(uint8_t* ptr, uint64_t val, uint32_t n_bytes)
+{
+  uint64_t       be    = to_be64(val);
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&be);
+  switch (n_bytes) {
+    case 8:
+      memcpy(ptr, bytes, 8);
+      break;
+    case 5:
+    case 6:
+    case 7:
+      memcpy(ptr + 4, bytes + 4, n_bytes - 4);
+      memcpy(ptr, bytes, 4);
+      break;
+    case 4:
+      memcpy(ptr, bytes, 4);
+      break;
+    case 3:
+      ptr[2] = bytes[2];
+      memcpy(ptr, bytes, 2);
+      break;
+    default:
+      memcpy(ptr, bytes, n_bytes);
+      break;
+  }
+}
+
+/// Reads n_bytes bytes in network byte order into the most significant bytes of the returned word. The remaining
+/// bytes of the word may hold the bytes that follow, if they are within the buffer
+inline uint64_t load_be(const uint8_t* ptr, const uint8_t* max_ptr, uint32_t n_bytes)
+{
+  if (ptr + 8 <= max_ptr) {
+    uint64_t word;
+    memcpy(&word, ptr, 8);
+    return to_be64(word);
+  }
+  uint64_t word = 0;
+  for (uint32_t i = 0; i < n_bytes; ++i) {
+    word |= (uint64_t)ptr[i] << (56u - 8u * i);
+  }
+  return word;
+}
+
+} // namespace
+
 SRSASN_CODE bit_ref::pack(uint64_t val, uint32_t n_bits)
 {
   if (n_bits >= 64) {
     log_error("This method only supports packing up to 64 bits");
     return SRSASN_ERROR_ENCODE_FAIL;
   }
-  uint64_t mask;
-  while (n_bits > 0) {
-    if (ptr >= max_ptr) {
-      log_error("pack: Buffer size limit was achieved");
-      return SRSASN_ERROR_ENCODE_FAIL;
-    }
-    mask             = ((1ul << n_bits) - 1ul);
-    val              = val & mask;
-    uint8_t keepmask = ((uint8_t)-1) - (uint8_t)((1u << (8u - offset)) - 1u);
-    if ((uint32_t)(8 - offset) > n_bits) {
-      auto bit = static_cast<uint8_t>(val << (8u - offset - n_bits));
-      *ptr     = ((*ptr) & keepmask) + bit;
-      offset += n_bits;
-      n_bits = 0;
-    } else {
-      auto bit = static_cast<uint8_t>(val >> (n_bits - 8u + offset));
-      *ptr     = (*ptr & keepmask) + bit;
-      n_bits -= (8 - offset);
-      offset = 0;
-      ptr++;
-    }
+  if (n_bits == 0) {
+    return SRSASN_SUCCESS;
   }
+  uint32_t end_bit = offset + n_bits;
+  uint32_t n_bytes = (end_bit + 7) / 8;
+  if (ptr + n_bytes > max_ptr) {
+    log_error("pack: Buffer size limit was achieved");
+    return SRSASN_ERROR_ENCODE_FAIL;
+  }
+  if (end_bit > 64) {
+    // The bits of the current byte and the value do not fit in a single 64-bit word
+    HANDLE_CODE(pack(val >> 32u, n_bits - 32));
+    return pack(val & 0xffffffffu, 32);
+  }
+  val &= (1ul << n_bits) - 1ul;
+  if (end_bit <= 8) {
+    // The value fits in the current byte
+    *ptr = (uint8_t)((*ptr & (0xff00u >> offset)) | (val << (8u - end_bit)));
+  } else {
+    // Keep the bits already written in the current byte, the unused bits of the last byte are zeroed
+    uint64_t word = (uint64_t)(*ptr & (uint8_t)(0xff00u >> offset)) << 56u;
+    word |= val << (64u - end_bit);
+    store_be(ptr, word, n_bytes);
+  }
+  ptr += end_bit / 8;
+  offset = end_bit % 8;
   return SRSASN_SUCCESS;
 }
 
@@ -183,24 +246,26 @@ SRSASN_CODE unpack_bits(T& val, Ptr& ptr, uint8_t& offset, const uint8_t* max_pt
     return SRSASN_ERROR_DECODE_FAIL;
   }
   val = 0;
-  while (n_bits > 0) {
-    if (ptr >= max_ptr) {
-      log_error("unpack_bits: Buffer size limit was achieved");
-      return SRSASN_ERROR_DECODE_FAIL;
-    }
-    if ((uint32_t)(8 - offset) > n_bits) {
-      uint8_t mask = (uint8_t)(1u << (8u - offset)) - (uint8_t)(1u << (8u - offset - n_bits));
-      val += ((uint32_t)((*ptr) & mask)) >> (8u - offset - n_bits);
-      offset += n_bits;
-      n_bits = 0;
-    } else {
-      auto mask = static_cast<uint8_t>((1u << (8u - offset)) - 1u);
-      val += static_cast<T>((*ptr) & mask) << (n_bits - 8 + offset);
-      n_bits -= 8 - offset;
-      offset = 0;
-      ptr++;
-    }
+  if (n_bits == 0) {
+    return SRSASN_SUCCESS;
   }
+  uint32_t end_bit = offset + n_bits;
+  if (ptr + (end_bit + 7) / 8 > max_ptr) {
+    log_error("unpack_bits: Buffer size limit was achieved");
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  if (end_bit > 64) {
+    // The bits of the current byte and the value do not fit in a single 64-bit word
+    uint64_t msb = 0, lsb = 0;
+    HANDLE_CODE(unpack_bits(msb, ptr, offset, max_ptr, n_bits - 32));
+    HANDLE_CODE(unpack_bits(lsb, ptr, offset, max_ptr, 32));
+    val = static_cast<T>((msb << 32u) | lsb);
+    return SRSASN_SUCCESS;
+  }
+  uint64_t word = load_be(ptr, max_ptr, (end_bit + 7) / 8) << offset;
+  val           = static_cast<T>(word >> (64u - n_bits));
+  ptr += end_bit / 8;
+  offset = end_bit % 8;
   return SRSASN_SUCCESS;
 }
 
@@ -260,7 +325,14 @@ SRSASN_CODE bit_ref_impl<Ptr>::unpack_bytes(uint8_t* buf, uint32_t n_bytes)
       log_error("unpack_bytes (unaligned): Buffer size limit was achieved");
       return SRSASN_ERROR_DECODE_FAIL;
     }
-    for (uint32_t i = 0; i < n_bytes; ++i) {
+    // Unpack 7 bytes at a time, so that the bits of the current byte still fit in the 64-bit word
+    uint32_t i = 0;
+    for (; i + 7 <= n_bytes; i += 7) {
+      uint64_t val;
+      HANDLE_CODE(unpack_bits(val, ptr, offset, max_ptr, 56));
+      store_be(buf + i, val << 8u, 7);
+    }
+    for (; i < n_bytes; ++i) {
       HANDLE_CODE(unpack(buf[i], 8));
     }
   }
@@ -323,7 +395,12 @@ SRSASN_CODE bit_ref::pack_bytes(const uint8_t* buf, uint32_t n_bytes)
     memcpy(ptr, buf, n_bytes);
     ptr += n_bytes;
   } else {
-    for (uint32_t i = 0; i < n_bytes; ++i) {
+    // Pack 7 bytes at a time, so that the bits of the current byte still fit in the 64-bit word
+    uint32_t i = 0;
+    for (; i + 7 <= n_bytes; i += 7) {
+      pack(load_be(buf + i, buf + n_bytes, 7) >> 8u, 56);
+    }
+    for (; i < n_bytes; ++i) {
       pack(buf[i], 8);
     }
   }
@@ -345,6 +422,107 @@ SRSASN_CODE bit_ref::align_bytes_zero()
   return SRSASN_SUCCESS;
 }
 
+/*********************
+   arena allocation
+*********************/
+
+// Every block is preceded by a header pointing to the chunk it was allocated from, or null for heap blocks
+static const size_t block_header_size = arena::alignment;
+
+struct detail::arena_chunk {
+  std::atomic<uint32_t> refs; ///< One per live block, plus one while the chunk is used by its arena
+  uint32_t              size;
+  uint32_t              used = 0;
+
+  explicit arena_chunk(uint32_t size_) : refs(1), size(size_) {}
+  uint8_t* data() { return reinterpret_cast<uint8_t*>(this) + header_size(); }
+  void     release()
+  {
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      this->~arena_chunk();
+      ::operator delete(this);
+    }
+  }
+  static size_t header_size()
+  {
+    return (sizeof(arena_chunk) + arena::alignment - 1) / arena::alignment * arena::alignment;
+  }
+};
+
+namespace {
+
+thread_local arena*        active_arena = nullptr;
+thread_local alloc_stats_t alloc_stats;
+
+} // namespace
+
+arena::~arena()
+{
+  if (cur != nullptr) {
+    cur->release();
+  }
+}
+
+void* arena::allocate(size_t n_bytes)
+{
+  size_t block_size = block_header_size + (n_bytes + alignment - 1) / alignment * alignment;
+  if (cur != nullptr and cur->refs.load(std::memory_order_acquire) == 1) {
+    // All the blocks of the current chunk were freed
+    cur->used = 0;
+  }
+  if (cur == nullptr or cur->used + block_size > cur->size) {
+    if (cur != nullptr) {
+      cur->release();
+    }
+    uint32_t size = std::max(chunk_size, (uint32_t)block_size);
+    cur           = new (::operator new(detail::arena_chunk::header_size() + size)) detail::arena_chunk(size);
+    nof_chunks++;
+  }
+  uint8_t* block = cur->data() + cur->used;
+  cur->used += block_size;
+  cur->refs.fetch_add(1, std::memory_order_relaxed);
+  *reinterpret_cast<detail::arena_chunk**>(block) = cur;
+  return block + block_header_size;
+}
+
+arena_scope::arena_scope(arena& a) : prev(active_arena)
+{
+  active_arena = &a;
+}
+
+arena_scope::~arena_scope()
+{
+  active_arena = prev;
+}
+
+const alloc_stats_t& get_alloc_stats()
+{
+  return alloc_stats;
+}
+
+void* detail::allocate(size_t n_bytes)
+{
+  if (active_arena != nullptr) {
+    alloc_stats.nof_arena_allocs++;
+    return active_arena->allocate(n_bytes);
+  }
+  alloc_stats.nof_heap_allocs++;
+  uint8_t* block                                  = static_cast<uint8_t*>(::operator new(block_header_size + n_bytes));
+  *reinterpret_cast<detail::arena_chunk**>(block) = nullptr;
+  return block + block_header_size;
+}
+
+void detail::deallocate(void* ptr)
+{
+  uint8_t*             block = static_cast<uint8_t*>(ptr) - block_header_size;
+  detail::arena_chunk* chunk = *reinterpret_cast<detail::arena_chunk**>(block);
+  if (chunk == nullptr) {
+    ::operator delete(block);
+  } else {
+    chunk->release();
+  }
+}
+
 /*********************
      ext packing
 *********************/
@@ -1467,6 +1645,71 @@ varlength_field_unpack_guard::~varlength_field_unpack_guard()
   bref_tracker->unpack(pad, len * 8 - bref_tracker->distance(bref0));
 }
 
+/*********************
+    AP PDU Index
+*********************/
+
+const uint32_t ap_pdu_index::max_nof_ies;
+
+SRSASN_CODE ap_pdu_index::unpack(const uint8_t* pdu_, uint32_t pdu_len_)
+{
+  pdu     = pdu_;
+  pdu_len = pdu_len_;
+  ie_list.clear();
+
+  cbit_ref bref(pdu, pdu_len);
+  bool     ext;
+  uint32_t choice_idx;
+  HANDLE_CODE(bref.unpack(ext, 1));
+  HANDLE_CODE(bref.unpack(choice_idx, 2));
+  if (ext or choice_idx > 2) {
+    log_error("Invalid PDU type %d", choice_idx);
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  type = (pdu_type_t)choice_idx;
+  uint16_t proc_code_;
+  HANDLE_CODE(unpack_integer(proc_code_, bref, (uint16_t)0u, (uint16_t)255u, false, true));
+  code = (uint8_t)proc_code_;
+  HANDLE_CODE(crit.unpack(bref));
+
+  // Message open type, followed by the extension bit and the list of protocol IEs
+  uint32_t msg_len;
+  HANDLE_CODE(unpack_length(msg_len, bref, true));
+  if (msg_len > (uint32_t)bref.distance_bytes_end()) {
+    log_error("Message length %d exceeds the PDU length", msg_len);
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  uint32_t nof_ies;
+  HANDLE_CODE(bref.unpack(ext, 1));
+  HANDLE_CODE(unpack_length(nof_ies, bref, 0u, 65535u, true));
+  if (nof_ies > max_nof_ies) {
+    log_error("Number of IEs %d exceeds the index capacity (%d)", nof_ies, max_nof_ies);
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+
+  for (; nof_ies > 0; --nof_ies) {
+    ie_t ie;
+    HANDLE_CODE(unpack_integer(ie.id, bref, 0u, 65535u, false, true));
+    HANDLE_CODE(ie.crit.unpack(bref));
+    HANDLE_CODE(unpack_length(ie.len, bref, true));
+    // The aligned length leaves the bit reference at the start of the IE value
+    ie.offset = bref.distance_bytes();
+    HANDLE_CODE(bref.advance_bits(ie.len * 8));
+    ie_list.push_back(ie);
+  }
+  return SRSASN_SUCCESS;
+}
+
+const ap_pdu_index::ie_t* ap_pdu_index::find_ie(uint32_t id) const
+{
+  for (const ie_t& ie : ie_list) {
+    if (ie.id == id) {
+      return &ie;
+    }
+  }
+  return nullptr;
+}
+
 /*******************
     JsonWriter
 *******************/
@@ -24,25 +24,24 @@
 #include "srsran/common/threads.h"
 
 namespace srsran {
-mac_pcap::mac_pcap() : mac_pcap_base() {}
+mac_pcap::mac_pcap() : mac_pcap_base(), writer(logger) {}
 
 mac_pcap::~mac_pcap()
 {
   close();
 }
 
-uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_)
+uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_, const pcap_writer::args_t& args)
 {
   std::lock_guard<std::mutex> lock(mutex);
-  if (pcap_file != nullptr) {
+  if (writer.is_open()) {
     logger.error("PCAP writer for %s already running. Close first.", filename_.c_str());
     return SRSRAN_ERROR;
   }
 
   // set UDP DLT
-  dlt       = UDP_DLT;
-  pcap_file = DLT_PCAP_Open(dlt, filename_.c_str());
-  if (pcap_file == nullptr) {
+  dlt = UDP_DLT;
+  if (writer.open(filename_, dlt, args) < SRSRAN_SUCCESS) {
     logger.error("Couldn't open %s to write PCAP", filename_.c_str());
     return SRSRAN_ERROR;
   }
@@ -61,14 +60,13 @@ uint32_t mac_pcap::close()
 {
   {
     std::lock_guard<std::mutex> lock(mutex);
-    if (running == false || pcap_file == nullptr) {
+    if (running == false || not writer.is_open()) {
       return SRSRAN_ERROR;
     }
 
     // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+    running = false;
+    wake_writer();
   }
 
   wait_thread_finish();
@@ -77,8 +75,7 @@ uint32_t mac_pcap::close()
   {
     std::lock_guard<std::mutex> lock(mutex);
     srsran::console("Saving MAC PCAP (DLT=%d) to %s\n", dlt, filename.c_str());
-    DLT_PCAP_Close(pcap_file);
-    pcap_file = nullptr;
+    writer.close();
   }
 
   return SRSRAN_SUCCESS;
@@ -87,17 +84,28 @@ uint32_t mac_pcap::close()
 void mac_pcap::write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu)
 {
   if (pdu.pdu != nullptr) {
+    uint8_t hdr[2 * PCAP_CONTEXT_HEADER_MAX];
     switch (pdu.rat) {
-      case srsran_rat_t::lte:
-        LTE_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context, pdu.pdu->msg, pdu.pdu->N_bytes);
+      case srsran_rat_t::lte: {
+        // Each carrier is written as a different interface in PCAPNG files
+        int hdr_len = LTE_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(&pdu.context, pdu.orig_len, hdr, sizeof(hdr));
+        writer.write(pdu.context.cc_idx, pdu.ts, hdr, hdr_len, pdu.pdu->msg, pdu.pdu->N_bytes, pdu.orig_len);
         break;
-      case srsran_rat_t::nr:
-        NR_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context_nr, pdu.pdu->msg, pdu.pdu->N_bytes);
+      }
+      case srsran_rat_t::nr: {
+        int hdr_len = NR_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(&pdu.context_nr, pdu.orig_len, hdr, sizeof(hdr));
+        writer.write(0, pdu.ts, hdr, hdr_len, pdu.pdu->msg, pdu.pdu->N_bytes, pdu.orig_len);
         break;
+      }
       default:
         logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
     }
   }
 }
 
+void mac_pcap::flush()
+{
+  writer.flush();
+}
+
 } // namespace srsran
\ No newline at end of file
@@ -23,7 +23,9 @@
 #include "srsran/config.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/support/emergency_handlers.h"
+#include <chrono>
 #include <stdint.h>
+#include <sys/time.h>
 
 namespace srsran {
 
@@ -45,10 +47,115 @@ mac_pcap_base::~mac_pcap_base()
   }
 }
 
+/**
+ * Checks whether any MAC SDU of an EUTRA DL-SCH/UL-SCH PDU belongs to a logical channel that passes the LCID filter.
+ * All subheaders precede the payload (TS 36.321 Section 6.1.2), so only the header is read.
+ */
+static bool match_lcid_eutra(const pcap_filter& filter, const uint8_t* payload, uint32_t payload_len, bool ul)
+{
+  const uint32_t max_sdu_lcid = 0b10001; // Higher values are MAC CEs and padding
+
+  bool     more = true;
+  uint32_t i    = 0;
+  while (more and i < payload_len) {
+    more          = (payload[i] & 0x20U) != 0;
+    uint32_t lcid = payload[i] & 0x1fU;
+    i++;
+    if (lcid <= max_sdu_lcid and filter.lcid_allowed(lcid)) {
+      return true;
+    }
+    // Besides the SDUs, only the variable size DC PHR (0b11000) and Extended PHR (0b11001) UL-SCH CEs have an L field
+    bool has_l = lcid <= max_sdu_lcid or (ul and (lcid == 0b11000 or lcid == 0b11001));
+    // All but the last subheader carry the L field, with 7 or 15 bits as indicated by the F bit
+    if (has_l and more and i < payload_len) {
+      i += (payload[i] & 0x80U) ? 2 : 1;
+    }
+  }
+  return false;
+}
+
+/// Returns the size of the fixed-size NR MAC CEs (TS 38.321 Tables 6.2.1-1 and 6.2.1-2), -1 for the others
+static int get_nr_ce_size(uint32_t lcid, bool ul)
+{
+  if (ul) {
+    switch (lcid) {
+      case 0b110100: // CCCH of 48 bits
+        return 6;
+      case 0b000000: // CCCH of 64 bits
+        return 8;
+      case 0b111001: // Single entry PHR
+      case 0b111010: // C-RNTI
+        return 2;
+      case 0b111011: // Short truncated BSR
+      case 0b111101: // Short BSR
+        return 1;
+      default:
+        return -1;
+    }
+  }
+  switch (lcid) {
+    case 0b111100: // DRX command
+      return 0;
+    case 0b111101: // Timing advance command
+      return 1;
+    case 0b111110: // UE contention resolution identity
+      return 6;
+    default:
+      return -1;
+  }
+}
+
+/**
+ * Checks whether any MAC SDU of an NR DL-SCH/UL-SCH PDU belongs to a logical channel that passes the LCID filter. Each
+ * subheader directly precedes its payload (TS 38.321 Section 6.1.2), so the subPDUs are walked until the padding or a
+ * CE of unknown size is found.
+ */
+static bool match_lcid_nr(const pcap_filter& filter, const uint8_t* payload, uint32_t payload_len, bool ul)
+{
+  const uint32_t max_sdu_lcid = 32;
+  const uint32_t ul_ccch48    = 0b110100;
+  const uint32_t ul_ccch64    = 0b000000;
+  const uint32_t ul_long_tbsr = 0b111100;
+  const uint32_t ul_long_bsr  = 0b111110;
+
+  uint32_t i = 0;
+  while (i < payload_len) {
+    bool     f_bit = (payload[i] & 0x40U) != 0;
+    uint32_t lcid  = payload[i] & 0x3fU;
+    i++;
+
+    // The UL CCCH carries no L field, both sizes are channel 0
+    bool ul_ccch = ul and (lcid == ul_ccch48 or lcid == ul_ccch64);
+    if ((lcid <= max_sdu_lcid or ul_ccch) and filter.lcid_allowed(ul_ccch ? 0 : lcid)) {
+      return true;
+    }
+
+    uint32_t len = 0;
+    if (not ul_ccch and (lcid <= max_sdu_lcid or (ul and (lcid == ul_long_tbsr or lcid == ul_long_bsr)))) {
+      if (i + (f_bit ? 2 : 1) > payload_len) {
+        return false;
+      }
+      len = payload[i++];
+      if (f_bit) {
+        len = len << 8U | payload[i++];
+      }
+    } else {
+      int ce_size = get_nr_ce_size(lcid, ul);
+      if (ce_size < 0) {
+        return false;
+      }
+      len = (uint32_t)ce_size;
+    }
+    i += len;
+  }
+  return false;
+}
+
 void mac_pcap_base::enable(bool enable_)
 {
   std::lock_guard<std::mutex> lock(mutex);
   running = enable_;
+  wake_writer();
 }
 
 void mac_pcap_base::set_ue_id(uint16_t ue_id_)
@@ -59,21 +166,74 @@ void mac_pcap_base::set_ue_id(uint16_t ue_id_)
 
 void mac_pcap_base::run_thread()
 {
-  // blocking write until stopped
+  auto next_flush = std::chrono::steady_clock::now() + std::chrono::milliseconds(flush_period_ms);
+
+  // Drain the queue in batches, sleeping in between until a PDU is queued or it is time to flush
   while (running) {
-    pcap_pdu_t pdu = queue.pop_blocking();
-    {
+    pcap_pdu_t pdu = {};
+    if (pop_wait_until(pdu, next_flush)) {
+      std::lock_guard<std::mutex> lock(mutex);
+      do {
+        write_pdu(pdu);
+      } while (queue.try_pop(pdu));
+      continue;
+    }
+
+    // Write out what is buffered from time to time
+    auto now = std::chrono::steady_clock::now();
+    if (now >= next_flush) {
       std::lock_guard<std::mutex> lock(mutex);
-      write_pdu(pdu);
+      flush();
+      next_flush = now + std::chrono::milliseconds(flush_period_ms);
     }
   }
 
   // write remainder of queue
-  pcap_pdu_t pdu = {};
+  std::lock_guard<std::mutex> lock(mutex);
+  pcap_pdu_t                  pdu = {};
   while (queue.try_pop(pdu)) {
-    std::lock_guard<std::mutex> lock(mutex);
     write_pdu(pdu);
   }
+  flush();
+}
+
+bool mac_pcap_base::pop_wait_until(pcap_pdu_t& pdu, std::chrono::steady_clock::time_point until)
+{
+  if (queue.try_pop(pdu)) {
+    return true;
+  }
+
+  std::unique_lock<std::mutex> lock(wakeup_mutex);
+  writer_sleeping.store(true, std::memory_order_relaxed);
+  // Pairs with the fence in queue_pdu(), either the producer sees the writer asleep or the writer sees the PDU
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  bool ret = queue.try_pop(pdu);
+  if (not ret and running) {
+    wakeup_cvar.wait_until(lock, until);
+    ret = queue.try_pop(pdu);
+  }
+  writer_sleeping.store(false, std::memory_order_relaxed);
+  return ret;
+}
+
+bool mac_pcap_base::queue_pdu(pcap_pdu_t&& pdu)
+{
+  if (not queue.try_push(std::move(pdu))) {
+    return false;
+  }
+
+  // Producers only take the mutex when the writer thread has to be woken up
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (writer_sleeping.load(std::memory_order_relaxed)) {
+    wake_writer();
+  }
+  return true;
+}
+
+void mac_pcap_base::wake_writer()
+{
+  std::lock_guard<std::mutex> lock(wakeup_mutex);
+  wakeup_cvar.notify_one();
 }
 
 // Function called from PHY worker context, locking not needed as PDU queue is thread-safe
@@ -88,8 +248,14 @@ void mac_pcap_base::pack_and_queue(uint8_t* payload,
                                    uint8_t  direction,
                                    uint8_t  rnti_type)
 {
-  if (running && payload != nullptr) {
+  // With an LCID filter, only UL-SCH/DL-SCH PDUs carrying one of the logical channels are captured
+  if (running && payload != nullptr &&
+      (not filter.has_lcid_filter() or
+       (rnti_type == C_RNTI and match_lcid_eutra(filter, payload, payload_len, direction == DIRECTION_UPLINK))) &&
+      filter.match_rnti(crnti)) {
     pcap_pdu_t pdu             = {};
+    pdu.orig_len               = payload_len;
+    payload_len                = filter.snap_len(payload_len);
     pdu.rat                    = srsran::srsran_rat_t::lte;
     pdu.context.radioType      = FDD_RADIO;
     pdu.context.direction      = direction;
@@ -101,6 +267,7 @@ void mac_pcap_base::pack_and_queue(uint8_t* payload,
     pdu.context.cc_idx         = cc_idx;
     pdu.context.sysFrameNumber = (uint16_t)(tti / 10);
     pdu.context.subFrameNumber = (uint16_t)(tti % 10);
+    gettimeofday(&pdu.ts, nullptr);
 
     // try to allocate PDU buffer
     pdu.pdu = srsran::make_byte_buffer();
@@ -108,7 +275,7 @@ void mac_pcap_base::pack_and_queue(uint8_t* payload,
       // copy payload into PDU buffer
       memcpy(pdu.pdu->msg, payload, payload_len);
       pdu.pdu->N_bytes = payload_len;
-      if (not queue.try_push(std::move(pdu))) {
+      if (not queue_pdu(std::move(pdu))) {
         logger.warning("Dropping PDU (%d B) in PCAP. Write queue full.", payload_len);
       }
     } else {
@@ -127,8 +294,13 @@ void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
                                       uint8_t  direction,
                                       uint8_t  rnti_type)
 {
-  if (running && payload != nullptr) {
+  if (running && payload != nullptr &&
+      (not filter.has_lcid_filter() or
+       (rnti_type == C_RNTI and match_lcid_nr(filter, payload, payload_len, direction == DIRECTION_UPLINK))) &&
+      filter.match_rnti(crnti)) {
     pcap_pdu_t pdu                     = {};
+    pdu.orig_len                       = payload_len;
+    payload_len                        = filter.snap_len(payload_len);
     pdu.rat                            = srsran_rat_t::nr;
     pdu.context_nr.radioType           = FDD_RADIO;
     pdu.context_nr.direction           = direction;
@@ -138,6 +310,7 @@ void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
     pdu.context_nr.harqid              = harqid;
     pdu.context_nr.system_frame_number = tti / 10;
     pdu.context_nr.sub_frame_number    = tti % 10;
+    gettimeofday(&pdu.ts, nullptr);
 
     // try to allocate PDU buffer
     pdu.pdu = srsran::make_byte_buffer();
@@ -145,7 +318,7 @@ void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
       // copy payload into PDU buffer
       memcpy(pdu.pdu->msg, payload, payload_len);
       pdu.pdu->N_bytes = payload_len;
-      if (not queue.try_push(std::move(pdu))) {
+      if (not queue_pdu(std::move(pdu))) {
         logger.warning("Dropping PDU (%d B) in NR PCAP. Write queue full.", payload_len);
       }
     } else {
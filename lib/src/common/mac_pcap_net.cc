@@ -80,9 +80,8 @@ uint32_t mac_pcap_net::close()
     }
 
     // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+    running = false;
+    wake_writer();
   }
 
   wait_thread_finish();
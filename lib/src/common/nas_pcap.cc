@@ -75,10 +75,10 @@ void nas_pcap::close()
 
 void nas_pcap::write_nas(uint8_t* pdu, uint32_t pdu_len_bytes)
 {
-  if (enable_write) {
+  if (enable_write && filter.match()) {
     NAS_Context_Info_t context;
     if (pdu) {
-      LTE_PCAP_NAS_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      LTE_PCAP_NAS_WritePDU(pcap_file, &context, pdu, filter.snap_len(pdu_len_bytes), pdu_len_bytes);
     }
   }
 }
@@ -66,10 +66,10 @@ void ngap_pcap::close()
 
 void ngap_pcap::write_ngap(uint8_t* pdu, uint32_t pdu_len_bytes)
 {
-  if (enable_write) {
+  if (enable_write && filter.match()) {
     NGAP_Context_Info_t context;
     if (pdu) {
-      LTE_PCAP_NGAP_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      LTE_PCAP_NGAP_WritePDU(pcap_file, &context, pdu, filter.snap_len(pdu_len_bytes), pdu_len_bytes);
     }
   }
 }
@@ -146,23 +146,22 @@ inline int LTE_PCAP_MAC_WritePDU(FILE* fd, MAC_Context_Info_t* context, const un
   return 1;
 }
 
-/* Write an individual PDU (PCAP packet header + mac-context + mac-pdu) */
-inline int
-LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned char* PDU, unsigned int length)
+/* Packs dummy UDP header, start string and MAC context to a buffer, the PDU of pdu_len bytes follows it */
+int LTE_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(MAC_Context_Info_t* context,
+                                           unsigned int        pdu_len,
+                                           uint8_t*            buffer,
+                                           unsigned int        length)
 {
-  pcaprec_hdr_t  packet_header;
-  uint8_t        context_header[PCAP_CONTEXT_HEADER_MAX] = {};
-  int            offset                                  = 0;
   struct udphdr* udp_header;
-  // uint16_t       tmp16;
+  int            offset = 0;
 
-  /* Can't write if file wasn't successfully opened */
-  if (fd == NULL) {
-    printf("Error: Can't write to empty file handle\n");
-    return 0;
+  if (buffer == NULL || length < PCAP_CONTEXT_HEADER_MAX) {
+    printf("Error: Writing buffer null or length to small \n");
+    return -1;
   }
+
   // Add dummy UDP header, start with src and dest port
-  udp_header       = (struct udphdr*)context_header;
+  udp_header       = (struct udphdr*)buffer;
   udp_header->dest = htons(0xdead);
   offset += 2;
   udp_header->source = htons(0xbeef);
@@ -175,11 +174,30 @@ LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned
   offset += 2;
 
   // Start magic string
-  memcpy(&context_header[offset], MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING));
+  memcpy(&buffer[offset], MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING));
   offset += strlen(MAC_LTE_START_STRING);
 
-  offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(context, &context_header[offset], PCAP_CONTEXT_HEADER_MAX);
-  udp_header->len = htons(length + offset);
+  offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(context, &buffer[offset], PCAP_CONTEXT_HEADER_MAX);
+  udp_header->len = htons(pdu_len + offset);
+
+  return offset;
+}
+
+/* Write an individual PDU (PCAP packet header + mac-context + mac-pdu) */
+inline int
+LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned char* PDU, unsigned int length)
+{
+  pcaprec_hdr_t packet_header;
+  uint8_t       context_header[2 * PCAP_CONTEXT_HEADER_MAX] = {};
+  int           offset                                      = 0;
+
+  /* Can't write if file wasn't successfully opened */
+  if (fd == NULL) {
+    printf("Error: Can't write to empty file handle\n");
+    return 0;
+  }
+
+  offset = LTE_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(context, length, context_header, sizeof(context_header));
 
   /****************************************************************/
   /* PCAP Header                                                  */
@@ -200,7 +218,11 @@ LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned
 }
 
 /* Write an individual PDU (PCAP packet header + nas-context + nas-pdu) */
-int LTE_PCAP_NAS_WritePDU(FILE* fd, NAS_Context_Info_t* context, const unsigned char* PDU, unsigned int length)
+int LTE_PCAP_NAS_WritePDU(FILE*                fd,
+                          NAS_Context_Info_t*  context,
+                          const unsigned char* PDU,
+                          unsigned int         length,
+                          unsigned int         orig_length)
 {
   pcaprec_hdr_t packet_header;
 
@@ -217,7 +239,7 @@ int LTE_PCAP_NAS_WritePDU(FILE* fd, NAS_Context_Info_t* context, const unsigned
   packet_header.ts_sec   = t.tv_sec;
   packet_header.ts_usec  = t.tv_usec;
   packet_header.incl_len = length;
-  packet_header.orig_len = length;
+  packet_header.orig_len = orig_length;
 
   /***************************************************************/
   /* Now write everything to the file                            */
@@ -232,7 +254,11 @@ int LTE_PCAP_NAS_WritePDU(FILE* fd, NAS_Context_Info_t* context, const unsigned
  **************************************************************************/
 
 /* Write an individual RLC PDU (PCAP packet header + UDP header + rlc-context + rlc-pdu) */
-int LTE_PCAP_RLC_WritePDU(FILE* fd, RLC_Context_Info_t* context, const unsigned char* PDU, unsigned int length)
+int LTE_PCAP_RLC_WritePDU(FILE*                fd,
+                          RLC_Context_Info_t*  context,
+                          const unsigned char* PDU,
+                          unsigned int         length,
+                          unsigned int         orig_length)
 {
   pcaprec_hdr_t packet_header;
   char          context_header[PCAP_CONTEXT_HEADER_MAX] = {};
@@ -253,7 +279,7 @@ int LTE_PCAP_RLC_WritePDU(FILE* fd, RLC_Context_Info_t* context, const unsigned
   context_header[offset++] = 0xbe;
   context_header[offset++] = 0xef;
   // length
-  tmp16 = length + 30;
+  tmp16 = orig_length + 30;
   if (context->rlcMode == RLC_UM_MODE) {
     tmp16 += 2; // RLC UM requires two bytes more for SN length (see below
   }
@@ -307,7 +333,7 @@ int LTE_PCAP_RLC_WritePDU(FILE* fd, RLC_Context_Info_t* context, const unsigned
   packet_header.ts_sec   = t.tv_sec;
   packet_header.ts_usec  = t.tv_usec;
   packet_header.incl_len = offset + length;
-  packet_header.orig_len = offset + length;
+  packet_header.orig_len = offset + orig_length;
 
   // Write everything to file
   fwrite(&packet_header, sizeof(pcaprec_hdr_t), 1, fd);
@@ -318,7 +344,11 @@ int LTE_PCAP_RLC_WritePDU(FILE* fd, RLC_Context_Info_t* context, const unsigned
 }
 
 /* Write an individual PDU (PCAP packet header + s1ap-context + s1ap-pdu) */
-int LTE_PCAP_S1AP_WritePDU(FILE* fd, S1AP_Context_Info_t* context, const unsigned char* PDU, unsigned int length)
+int LTE_PCAP_S1AP_WritePDU(FILE*                fd,
+                           S1AP_Context_Info_t* context,
+                           const unsigned char* PDU,
+                           unsigned int         length,
+                           unsigned int         orig_length)
 {
   pcaprec_hdr_t packet_header;
 
@@ -335,7 +365,7 @@ int LTE_PCAP_S1AP_WritePDU(FILE* fd, S1AP_Context_Info_t* context, const unsigne
   packet_header.ts_sec   = t.tv_sec;
   packet_header.ts_usec  = t.tv_usec;
   packet_header.incl_len = length;
-  packet_header.orig_len = length;
+  packet_header.orig_len = orig_length;
 
   /***************************************************************/
   /* Now write everything to the file                            */
@@ -346,7 +376,11 @@ int LTE_PCAP_S1AP_WritePDU(FILE* fd, S1AP_Context_Info_t* context, const unsigne
 }
 
 /* Write an individual PDU (PCAP packet header + ngap-context + ngap-pdu) */
-int LTE_PCAP_NGAP_WritePDU(FILE* fd, NGAP_Context_Info_t* context, const unsigned char* PDU, unsigned int length)
+int LTE_PCAP_NGAP_WritePDU(FILE*                fd,
+                           NGAP_Context_Info_t* context,
+                           const unsigned char* PDU,
+                           unsigned int         length,
+                           unsigned int         orig_length)
 {
   pcaprec_hdr_t packet_header;
 
@@ -363,7 +397,7 @@ int LTE_PCAP_NGAP_WritePDU(FILE* fd, NGAP_Context_Info_t* context, const unsigne
   packet_header.ts_sec   = t.tv_sec;
   packet_header.ts_usec  = t.tv_usec;
   packet_header.incl_len = length;
-  packet_header.orig_len = length;
+  packet_header.orig_len = orig_length;
 
   /***************************************************************/
   /* Now write everything to the file                            */
@@ -425,21 +459,22 @@ inline int NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(mac_nr_context_info_t* context, ui
   return offset;
 }
 
-/* Write an individual NR MAC PDU (PCAP packet header + UDP header + nr-mac-context + mac-pdu) */
-int NR_PCAP_MAC_UDP_WritePDU(FILE* fd, mac_nr_context_info_t* context, const unsigned char* PDU, unsigned int length)
+/* Packs dummy UDP header, start string and NR MAC context to a buffer, the PDU of pdu_len bytes follows it */
+int NR_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(mac_nr_context_info_t* context,
+                                          unsigned int           pdu_len,
+                                          uint8_t*               buffer,
+                                          unsigned int           length)
 {
-  uint8_t        context_header[PCAP_CONTEXT_HEADER_MAX] = {};
   struct udphdr* udp_header;
   int            offset = 0;
 
-  /* Can't write if file wasn't successfully opened */
-  if (fd == NULL) {
-    printf("Error: Can't write to empty file handle\n");
+  if (buffer == NULL || length < PCAP_CONTEXT_HEADER_MAX) {
+    printf("Error: Writing buffer null or length to small \n");
     return -1;
   }
 
   // Add dummy UDP header, start with src and dest port
-  udp_header       = (struct udphdr*)context_header;
+  udp_header       = (struct udphdr*)buffer;
   udp_header->dest = htons(0xdead);
   offset += 2;
   udp_header->source = htons(0xbeef);
@@ -452,17 +487,34 @@ int NR_PCAP_MAC_UDP_WritePDU(FILE* fd, mac_nr_context_info_t* context, const uns
   offset += 2;
 
   // Start magic string
-  memcpy(&context_header[offset], MAC_NR_START_STRING, strlen(MAC_NR_START_STRING));
+  memcpy(&buffer[offset], MAC_NR_START_STRING, strlen(MAC_NR_START_STRING));
   offset += strlen(MAC_NR_START_STRING);
 
-  offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(context, &context_header[offset], PCAP_CONTEXT_HEADER_MAX);
+  offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(context, &buffer[offset], PCAP_CONTEXT_HEADER_MAX);
 
-  udp_header->len = htons(offset + length);
+  udp_header->len = htons(offset + pdu_len);
 
   if (offset != 31) {
     printf("ERROR Does not match offset %d != 31\n", offset);
   }
 
+  return offset;
+}
+
+/* Write an individual NR MAC PDU (PCAP packet header + UDP header + nr-mac-context + mac-pdu) */
+int NR_PCAP_MAC_UDP_WritePDU(FILE* fd, mac_nr_context_info_t* context, const unsigned char* PDU, unsigned int length)
+{
+  uint8_t context_header[2 * PCAP_CONTEXT_HEADER_MAX] = {};
+  int     offset                                      = 0;
+
+  /* Can't write if file wasn't successfully opened */
+  if (fd == NULL) {
+    printf("Error: Can't write to empty file handle\n");
+    return -1;
+  }
+
+  offset = NR_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(context, length, context_header, sizeof(context_header));
+
   /****************************************************************/
   /* PCAP Header                                                  */
   struct timeval t;
@@ -0,0 +1,156 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pcap_filter.h"
+#include "srsran/common/string_helpers.h"
+#include <algorithm>
+#include <sstream>
+#include <stdlib.h>
+
+namespace srsran {
+
+/// Parses an unsigned value in decimal or hexadecimal (0x prefix) format
+static bool parse_uint(const std::string& str, uint32_t max, uint32_t& value)
+{
+  if (str.empty()) {
+    return false;
+  }
+  char*         end = nullptr;
+  unsigned long v   = strtoul(str.c_str(), &end, 0);
+  if (*end != '\0' or v > max) {
+    return false;
+  }
+  value = (uint32_t)v;
+  return true;
+}
+
+template <typename T>
+static bool parse_uint_list(const std::string& str, uint32_t max, std::vector<T>& list)
+{
+  list.clear();
+  for (const std::string& item : split_string(str, ',')) {
+    uint32_t value;
+    if (not parse_uint(item, max, value)) {
+      return false;
+    }
+    list.push_back((T)value);
+  }
+  return not list.empty();
+}
+
+bool parse_pcap_filter(const std::vector<std::string>& tokens, pcap_filter_cfg_t& cfg)
+{
+  cfg = {};
+  if (tokens.size() == 1 and tokens[0] == "off") {
+    return true;
+  }
+
+  for (const std::string& token : tokens) {
+    size_t sep = token.find('=');
+    if (sep == std::string::npos) {
+      return false;
+    }
+    std::string key   = token.substr(0, sep);
+    std::string value = token.substr(sep + 1);
+
+    bool ret;
+    if (key == "rnti") {
+      ret = parse_uint_list(value, UINT16_MAX, cfg.rntis);
+    } else if (key == "lcid") {
+      ret = parse_uint_list(value, 63, cfg.lcids);
+    } else if (key == "sample") {
+      ret = parse_uint(value, UINT32_MAX, cfg.sample_ratio) and cfg.sample_ratio > 0;
+    } else if (key == "snaplen") {
+      ret = parse_uint(value, UINT32_MAX, cfg.max_len);
+    } else {
+      ret = false;
+    }
+    if (not ret) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string to_string(const pcap_filter_cfg_t& cfg)
+{
+  std::stringstream ss;
+  ss << "rnti=";
+  if (cfg.rntis.empty()) {
+    ss << "all";
+  }
+  for (uint32_t i = 0; i < cfg.rntis.size(); i++) {
+    ss << (i > 0 ? "," : "") << "0x" << std::hex << cfg.rntis[i] << std::dec;
+  }
+  ss << " lcid=";
+  if (cfg.lcids.empty()) {
+    ss << "all";
+  }
+  for (uint32_t i = 0; i < cfg.lcids.size(); i++) {
+    ss << (i > 0 ? "," : "") << cfg.lcids[i];
+  }
+  ss << " sample=1/" << cfg.sample_ratio;
+  ss << " snaplen=";
+  if (cfg.max_len == 0) {
+    ss << "full";
+  } else {
+    ss << cfg.max_len;
+  }
+  return ss.str();
+}
+
+pcap_filter::pcap_filter()
+{
+  for (auto& word : rnti_mask) {
+    word.store(0, std::memory_order_relaxed);
+  }
+}
+
+void pcap_filter::set(const pcap_filter_cfg_t& cfg)
+{
+  // Disable the filters while the masks are rewritten, so that the new RNTIs are not dropped in the meantime
+  rnti_enabled.store(false, std::memory_order_relaxed);
+  lcid_enabled.store(false, std::memory_order_relaxed);
+
+  for (auto& word : rnti_mask) {
+    word.store(0, std::memory_order_relaxed);
+  }
+  for (uint16_t rnti : cfg.rntis) {
+    rnti_mask[rnti / 64].fetch_or(1UL << (rnti % 64), std::memory_order_relaxed);
+  }
+
+  uint64_t mask = 0;
+  for (uint32_t lcid : cfg.lcids) {
+    if (lcid < max_lcid) {
+      mask |= 1UL << lcid;
+    }
+  }
+  lcid_mask.store(mask, std::memory_order_relaxed);
+
+  sample_ratio.store(std::max(cfg.sample_ratio, 1U), std::memory_order_relaxed);
+  sample_count.store(0, std::memory_order_relaxed);
+  max_len.store(cfg.max_len, std::memory_order_relaxed);
+
+  rnti_enabled.store(not cfg.rntis.empty(), std::memory_order_release);
+  lcid_enabled.store(not cfg.lcids.empty(), std::memory_order_release);
+}
+
+} // namespace srsran
@@ -0,0 +1,332 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pcap_writer.h"
+#include "srsran/common/pcap.h"
+#include "srsran/config.h"
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define PCAP_WRITER_ALIGNMENT 4096
+#define PCAP_WRITER_MIN_BATCH_SIZE (64 * 1024)
+#define PCAP_SNAPLEN 65535
+
+// PCAPNG block types and options, see draft-ietf-opsawg-pcapng
+#define PCAPNG_SHB_TYPE 0x0A0D0D0A
+#define PCAPNG_IDB_TYPE 0x00000001
+#define PCAPNG_EPB_TYPE 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+#define PCAPNG_OPT_ENDOFOPT 0
+#define PCAPNG_OPT_IF_NAME 2
+
+namespace srsran {
+
+namespace {
+
+struct pcapng_shb_t {
+  uint32_t block_type;
+  uint32_t block_len;
+  uint32_t byte_order_magic;
+  uint16_t version_major;
+  uint16_t version_minor;
+  int64_t  section_len;
+  uint32_t block_len_trailer;
+} __attribute__((packed));
+
+struct pcapng_epb_hdr_t {
+  uint32_t block_type;
+  uint32_t block_len;
+  uint32_t if_id;
+  uint32_t ts_high;
+  uint32_t ts_low;
+  uint32_t captured_len;
+  uint32_t orig_len;
+} __attribute__((packed));
+
+uint32_t pad4(uint32_t len)
+{
+  return (len + 3U) & ~3U;
+}
+
+} // namespace
+
+pcap_writer::pcap_writer(srslog::basic_logger& logger_) : logger(logger_)
+{
+  if_idx.fill(-1);
+}
+
+pcap_writer::~pcap_writer()
+{
+  close();
+}
+
+int pcap_writer::open(const std::string& filename_, uint32_t dlt_, const args_t& args_)
+{
+  if (is_open()) {
+    logger.error("PCAP file %s already open. Close first.", filename.c_str());
+    return SRSRAN_ERROR;
+  }
+
+  filename = filename_;
+  dlt      = dlt_;
+  args     = args_;
+
+  // The buffer must be able to hold the largest record
+  args.batch_size = std::max(args.batch_size, (uint32_t)PCAP_WRITER_MIN_BATCH_SIZE);
+  args.batch_size = (args.batch_size + PCAP_WRITER_ALIGNMENT - 1) & ~(PCAP_WRITER_ALIGNMENT - 1);
+  args.max_files  = std::max(args.max_files, 1U);
+
+  void* ptr = nullptr;
+  if (posix_memalign(&ptr, PCAP_WRITER_ALIGNMENT, args.batch_size) != 0) {
+    logger.error("Couldn't allocate %d B for the PCAP write buffer", args.batch_size);
+    return SRSRAN_ERROR;
+  }
+  buffer     = (uint8_t*)ptr;
+  buffer_len = 0;
+
+  if (open_file() < SRSRAN_SUCCESS) {
+    free(buffer);
+    buffer = nullptr;
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void pcap_writer::close()
+{
+  if (not is_open()) {
+    return;
+  }
+  flush();
+  ::close(fd);
+  fd = -1;
+  free(buffer);
+  buffer = nullptr;
+}
+
+int pcap_writer::open_file()
+{
+  fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    logger.error("Couldn't open %s to write PCAP: %s", filename.c_str(), strerror(errno));
+    return SRSRAN_ERROR;
+  }
+
+  file_size   = 0;
+  nof_records = 0;
+  nof_if      = 0;
+  if_idx.fill(-1);
+
+  return write_file_header();
+}
+
+int pcap_writer::rotate()
+{
+  if (flush() < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  ::close(fd);
+  fd = -1;
+
+  // Shift the previous files by one, the oldest one is dropped
+  if (args.max_files > 1) {
+    for (uint32_t i = args.max_files - 1; i > 0; i--) {
+      std::string from = (i == 1) ? filename : filename + "." + std::to_string(i - 1);
+      std::string to   = filename + "." + std::to_string(i);
+      if (::rename(from.c_str(), to.c_str()) != 0 && errno != ENOENT) {
+        logger.warning("Couldn't rename %s to %s: %s", from.c_str(), to.c_str(), strerror(errno));
+      }
+    }
+  }
+
+  logger.info("Rotating PCAP file %s", filename.c_str());
+  return open_file();
+}
+
+int pcap_writer::write_file_header()
+{
+  if (args.format == format_t::pcap) {
+    pcap_hdr_t hdr    = {};
+    hdr.magic_number  = 0xa1b2c3d4;
+    hdr.version_major = 2;
+    hdr.version_minor = 4;
+    hdr.snaplen       = PCAP_SNAPLEN;
+    hdr.network       = dlt;
+    append(&hdr, sizeof(hdr));
+    return SRSRAN_SUCCESS;
+  }
+
+  pcapng_shb_t shb      = {};
+  shb.block_type        = PCAPNG_SHB_TYPE;
+  shb.block_len         = sizeof(pcapng_shb_t);
+  shb.byte_order_magic  = PCAPNG_BYTE_ORDER_MAGIC;
+  shb.version_major     = 1;
+  shb.version_minor     = 0;
+  shb.section_len       = -1;
+  shb.block_len_trailer = sizeof(pcapng_shb_t);
+  append(&shb, sizeof(shb));
+  return SRSRAN_SUCCESS;
+}
+
+int pcap_writer::write_interface_block(uint32_t if_id)
+{
+  char     name[16];
+  uint32_t name_len = (uint32_t)snprintf(name, sizeof(name), "cell%d", if_id);
+
+  // Block header, link type, snaplen, if_name option, end of options and block trailer
+  uint32_t block_len = 8 + 8 + 4 + pad4(name_len) + 4 + 4;
+  uint32_t words[4]  = {PCAPNG_IDB_TYPE, block_len, dlt & 0xffffU, PCAP_SNAPLEN};
+  append(words, sizeof(words));
+
+  uint16_t opt[2] = {PCAPNG_OPT_IF_NAME, (uint16_t)name_len};
+  append(opt, sizeof(opt));
+  uint8_t name_padded[16] = {};
+  memcpy(name_padded, name, name_len);
+  append(name_padded, pad4(name_len));
+
+  uint32_t trailer[2] = {PCAPNG_OPT_ENDOFOPT, block_len};
+  append(trailer, sizeof(trailer));
+
+  if_idx[if_id] = nof_if++;
+  return SRSRAN_SUCCESS;
+}
+
+int pcap_writer::write(uint32_t              if_id,
+                       const struct timeval& ts,
+                       const uint8_t*        hdr,
+                       uint32_t              hdr_len,
+                       const uint8_t*        payload,
+                       uint32_t              payload_len,
+                       uint32_t              orig_payload_len)
+{
+  if (not is_open()) {
+    return SRSRAN_ERROR;
+  }
+
+  bool     ng       = args.format == format_t::pcapng;
+  uint32_t pkt_len  = hdr_len + payload_len;
+  uint32_t orig_len = hdr_len + std::max(payload_len, orig_payload_len);
+  if (ng && if_id >= max_interfaces) {
+    logger.error("Invalid PCAP interface %d", if_id);
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t rec_len = ng ? (uint32_t)sizeof(pcapng_epb_hdr_t) + pad4(pkt_len) + 4 : sizeof(pcaprec_hdr_t) + pkt_len;
+
+  // The batch is never smaller than the snaplen, so this only happens with malformed records
+  if (rec_len > args.batch_size) {
+    logger.warning("Dropping PCAP record of %d B, larger than the batch size", rec_len);
+    return SRSRAN_ERROR;
+  }
+
+  // IDBs are emitted on demand, so take them into account before deciding whether to rotate
+  uint32_t idb_len = (ng && if_idx[if_id] < 0) ? 64 : 0;
+  if (args.max_file_size > 0 && nof_records > 0 && file_size + rec_len + idb_len > args.max_file_size) {
+    if (rotate() < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  if (ng && if_idx[if_id] < 0) {
+    write_interface_block(if_id);
+  }
+
+  if (rec_len > args.batch_size - buffer_len) {
+    if (flush() < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  if (ng) {
+    uint64_t         ts_us = (uint64_t)ts.tv_sec * 1000000UL + (uint64_t)ts.tv_usec;
+    pcapng_epb_hdr_t epb   = {};
+    epb.block_type         = PCAPNG_EPB_TYPE;
+    epb.block_len          = rec_len;
+    epb.if_id              = (uint32_t)if_idx[if_id];
+    epb.ts_high            = (uint32_t)(ts_us >> 32U);
+    epb.ts_low             = (uint32_t)ts_us;
+    epb.captured_len       = pkt_len;
+    epb.orig_len           = orig_len;
+    append(&epb, sizeof(epb));
+  } else {
+    pcaprec_hdr_t rec = {(uint32_t)ts.tv_sec, (uint32_t)ts.tv_usec, pkt_len, orig_len};
+    append(&rec, sizeof(rec));
+  }
+
+  append(hdr, hdr_len);
+  append(payload, payload_len);
+
+  if (ng) {
+    uint8_t zeros[4] = {};
+    append(zeros, pad4(pkt_len) - pkt_len);
+    append(&rec_len, sizeof(rec_len));
+  }
+  nof_records++;
+
+  return SRSRAN_SUCCESS;
+}
+
+int pcap_writer::flush()
+{
+  if (not is_open() || buffer_len == 0) {
+    return SRSRAN_SUCCESS;
+  }
+  int ret    = write_raw(buffer, buffer_len);
+  buffer_len = 0;
+  return ret;
+}
+
+int pcap_writer::write_raw(const void* data, uint32_t len)
+{
+  const uint8_t* ptr = (const uint8_t*)data;
+  while (len > 0) {
+    ssize_t n = ::write(fd, ptr, len);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      logger.error("Error writing to PCAP file %s: %s", filename.c_str(), strerror(errno));
+      return SRSRAN_ERROR;
+    }
+    ptr += n;
+    len -= (uint32_t)n;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+void pcap_writer::append(const void* data, uint32_t len)
+{
+  // Only file headers and IDBs can overflow a batch, as records are checked beforehand
+  if (len > args.batch_size - buffer_len) {
+    flush();
+  }
+  memcpy(buffer + buffer_len, data, len);
+  buffer_len += len;
+  file_size += len;
+}
+
+} // namespace srsran
@@ -72,7 +72,7 @@ void rlc_pcap::pack_and_write(uint8_t* pdu,
                               uint16_t channel_type,
                               uint16_t channel_id)
 {
-  if (enable_write) {
+  if (enable_write && filter.match_lcid(channel_id)) {
     RLC_Context_Info_t context;
     context.rlcMode              = mode_;
     context.direction            = direction;
@@ -83,7 +83,7 @@ void rlc_pcap::pack_and_write(uint8_t* pdu,
     context.channelId            = channel_id;
     context.pduLength            = pdu_len_bytes;
     if (pdu) {
-      LTE_PCAP_RLC_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      LTE_PCAP_RLC_WritePDU(pcap_file, &context, pdu, filter.snap_len(pdu_len_bytes), pdu_len_bytes);
     }
   }
 }
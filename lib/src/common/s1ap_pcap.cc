@@ -66,10 +66,10 @@ void s1ap_pcap::close()
 
 void s1ap_pcap::write_s1ap(uint8_t* pdu, uint32_t pdu_len_bytes)
 {
-  if (enable_write) {
+  if (enable_write && filter.match()) {
     S1AP_Context_Info_t context;
     if (pdu) {
-      LTE_PCAP_S1AP_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      LTE_PCAP_S1AP_WritePDU(pcap_file, &context, pdu, filter.snap_len(pdu_len_bytes), pdu_len_bytes);
     }
   }
 }
@@ -20,6 +20,7 @@
  */
 
 #include "srsran/common/time_prof.h"
+#include "srsran/srslog/bundled/fmt/format.h"
 #include <algorithm>
 #include <inttypes.h>
 #include <numeric>
@@ -113,5 +114,43 @@ void sliding_window_stats<TUnit>::operator()(nanoseconds duration)
   }
 }
 
+deadline_histogram_stats::deadline_histogram_stats(const char* name_,
+                                                   const char* logname,
+                                                   nanoseconds deadline_,
+                                                   size_t      nof_bins,
+                                                   size_t      print_period_) :
+  logger(srslog::fetch_basic_logger(logname)),
+  name(name_),
+  deadline(deadline_),
+  bins(std::max<size_t>(nof_bins, 1) + 1, 0),
+  print_period(print_period_)
+{}
+
+void deadline_histogram_stats::operator()(nanoseconds duration)
+{
+  size_t nof_bins = bins.size() - 1;
+  size_t bin      = nof_bins;
+  if (duration < deadline) {
+    bin = static_cast<size_t>(duration.count() * static_cast<long>(nof_bins) / deadline.count());
+  }
+  bins[bin]++;
+  count++;
+  max_val = std::max<long>(max_val, duration.count());
+
+  if (print_period > 0 and count % print_period == 0 and logger.info.enabled()) {
+    fmt::memory_buffer fmtbuf;
+    for (size_t i = 0; i < nof_bins; ++i) {
+      fmt::format_to(fmtbuf, "{}{}", i == 0 ? "" : " ", bins[i]);
+    }
+    logger.info("%s: deadline=%" PRId64 " usec, max=%ld usec, histogram=[%s], misses=%" PRIu64 "/%" PRIu64,
+                name.c_str(),
+                static_cast<int64_t>(deadline.count() / 1000),
+                max_val / 1000,
+                fmt::to_string(fmtbuf).c_str(),
+                nof_misses(),
+                count);
+  }
+}
+
 template class srsran::sliding_window_stats<std::chrono::microseconds>;
 template class srsran::sliding_window_stats<std::chrono::milliseconds>;
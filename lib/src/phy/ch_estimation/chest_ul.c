@@ -203,6 +203,11 @@ void srsran_chest_ul_pregen(srsran_chest_ul_t*                 q,
   }
 }
 
+void srsran_chest_ul_set_pusch_ce_dmrs_only(srsran_chest_ul_t* q, bool enable)
+{
+  q->pusch_ce_dmrs_only = enable;
+}
+
 /* Uses the difference between the averaged and non-averaged pilot estimates */
 static float estimate_noise_pilots(srsran_chest_ul_t* q, cf_t* ce, uint32_t nslots, uint32_t nrefs, uint32_t n_prb[2])
 {
@@ -291,7 +296,7 @@ average_pilots(srsran_chest_ul_t* q, cf_t* input, cf_t* ce, uint32_t nslots, uin
  * @param nrefs_sym number of reference resource elements per symbols (depends on configuration)
  * @param stride sub-carrier distance between reference signal resource elements (1 for DMRS, 2 for SRS)
  * @param meas_ta_en enables or disables the Time Alignment error measurement
- * @param write_estimates Write channel estimation in res, (true for DMRS and false for SRS)
+ * @param write_estimates Write channel estimation of every symbol in res, (false for SRS and DMRS-only PUSCH estimates)
  * @param n_prb Resource block start for the grant, set to zero for Sounding Reference Signals
  * @param res UL channel estimation result
  */
@@ -425,9 +430,23 @@ int srsran_chest_ul_estimate_pusch(srsran_chest_ul_t*     q,
                            q->pilot_estimates,
                            nrefs_sf);
 
+#ifdef DO_LINEAR_INTERPOLATION
+  // The estimates change within the slot, they must be written for every symbol
+  res->ce_dmrs_only = false;
+#else
+  res->ce_dmrs_only = q->pusch_ce_dmrs_only;
+#endif
+
   // Estimate
-  chest_ul_estimate(
-      q, SRSRAN_NOF_SLOTS_PER_SF, nrefs_sym, 1, cfg->meas_ta_en, cfg->use_cedron_alg, true, cfg->grant.n_prb, res);
+  chest_ul_estimate(q,
+                    SRSRAN_NOF_SLOTS_PER_SF,
+                    nrefs_sym,
+                    1,
+                    cfg->meas_ta_en,
+                    cfg->use_cedron_alg,
+                    !res->ce_dmrs_only,
+                    cfg->grant.n_prb,
+                    res);
 
   return 0;
 }
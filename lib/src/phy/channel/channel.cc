@@ -43,15 +43,15 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
   // Copy args
   args = channel_args;
 
-  // Allocate internal buffers
-  buffer_in  = srsran_vec_cf_malloc(buffer_size);
-  buffer_out = srsran_vec_cf_malloc(buffer_size);
-  if (!buffer_out || !buffer_in) {
-    ret = SRSRAN_ERROR;
-  }
-
   nof_channels = _nof_channels;
   for (uint32_t i = 0; i < nof_channels; i++) {
+    // Allocate internal buffers
+    buffer_in[i]  = srsran_vec_cf_malloc(buffer_size);
+    buffer_out[i] = srsran_vec_cf_malloc(buffer_size);
+    if (!buffer_out[i] || !buffer_in[i]) {
+      ret = SRSRAN_ERROR;
+    }
+
     // Create fading channel
     if (channel_args.fading_enable && !channel_args.fading_model.empty() && channel_args.fading_model != "none" &&
         ret == SRSRAN_SUCCESS) {
@@ -73,19 +73,19 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
     } else {
       delay[i] = nullptr;
     }
-  }
 
-  // Create AWGN channnel
-  if (channel_args.awgn_enable && ret == SRSRAN_SUCCESS) {
-    awgn = (srsran_channel_awgn_t*)calloc(sizeof(srsran_channel_awgn_t), 1);
-    ret  = srsran_channel_awgn_init(awgn, 1234);
-    srsran_channel_awgn_set_n0(awgn, args.awgn_signal_power_dBfs - args.awgn_snr_dB);
-  }
+    // Create AWGN channnel, each channel has its own noise generator so they can run in parallel
+    if (channel_args.awgn_enable && ret == SRSRAN_SUCCESS) {
+      awgn[i] = (srsran_channel_awgn_t*)calloc(sizeof(srsran_channel_awgn_t), 1);
+      ret     = srsran_channel_awgn_init(awgn[i], 1234 + i);
+      srsran_channel_awgn_set_n0(awgn[i], args.awgn_signal_power_dBfs - args.awgn_snr_dB);
+    }
 
-  // Create high speed train
-  if (channel_args.hst_enable && ret == SRSRAN_SUCCESS) {
-    hst = (srsran_channel_hst_t*)calloc(sizeof(srsran_channel_hst_t), 1);
-    srsran_channel_hst_init(hst, channel_args.hst_fd_hz, channel_args.hst_period_s, channel_args.hst_init_time_s);
+    // Create high speed train
+    if (channel_args.hst_enable && ret == SRSRAN_SUCCESS) {
+      hst[i] = (srsran_channel_hst_t*)calloc(sizeof(srsran_channel_hst_t), 1);
+      srsran_channel_hst_init(hst[i], channel_args.hst_fd_hz, channel_args.hst_period_s, channel_args.hst_init_time_s);
+    }
   }
 
   // Create Radio Link Failure simulator
@@ -96,27 +96,26 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
 
   if (ret != SRSRAN_SUCCESS) {
     fprintf(stderr, "Error: Creating channel\n\n");
+    return;
+  }
+
+  // Launch worker threads, the calling thread takes part in the processing
+  uint32_t nof_threads = SRSRAN_MIN(SRSRAN_MAX(channel_args.nof_threads, 1), SRSRAN_MAX(nof_channels, 1));
+  for (uint32_t w = 1; w < nof_threads; w++) {
+    workers.emplace_back(&channel::run_worker, this, w, nof_threads);
   }
 }
 
 channel::~channel()
 {
-  if (buffer_in) {
-    free(buffer_in);
+  // Stop worker threads
+  {
+    std::lock_guard<std::mutex> lock(job_mutex);
+    running = false;
   }
-
-  if (buffer_out) {
-    free(buffer_out);
-  }
-
-  if (awgn) {
-    srsran_channel_awgn_free(awgn);
-    free(awgn);
-  }
-
-  if (hst) {
-    srsran_channel_hst_free(hst);
-    free(hst);
+  job_cvar.notify_all();
+  for (std::thread& w : workers) {
+    w.join();
   }
 
   if (rlf) {
@@ -125,6 +124,24 @@ channel::~channel()
   }
 
   for (uint32_t i = 0; i < nof_channels; i++) {
+    if (buffer_in[i]) {
+      free(buffer_in[i]);
+    }
+
+    if (buffer_out[i]) {
+      free(buffer_out[i]);
+    }
+
+    if (awgn[i]) {
+      srsran_channel_awgn_free(awgn[i]);
+      free(awgn[i]);
+    }
+
+    if (hst[i]) {
+      srsran_channel_hst_free(hst[i]);
+      free(hst[i]);
+    }
+
     if (fading[i]) {
       srsran_channel_fading_free(fading[i]);
       free(fading[i]);
@@ -147,66 +164,120 @@ static inline cf_t local_cexpf(float phase)
 }
 }
 
-void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
-                  cf_t*                     out[SRSRAN_MAX_CHANNELS],
-                  uint32_t                  len,
-                  const srsran_timestamp_t& t)
+void channel::run_channel(uint32_t i, cf_t* in, cf_t* out, uint32_t len, const srsran_timestamp_t& t)
 {
-  // Early return if pointers are not enabled
+  // Skip if any buffer is null
   if (in == nullptr || out == nullptr) {
     return;
   }
 
-  // For each channel
-  for (uint32_t i = 0; i < nof_channels; i++) {
-    // Skip iteration if any buffer is null
-    if (in[i] == nullptr || out[i] == nullptr) {
-      continue;
+  // If sampling rate is not set, copy input and skip rest of channel
+  if (current_srate == 0) {
+    if (in != out) {
+      srsran_vec_cf_copy(out, in, len);
     }
+    return;
+  }
 
-    // If sampling rate is not set, copy input and skip rest of channel
-    if (current_srate == 0) {
-      if (in[i] != out[i]) {
-        srsran_vec_cf_copy(out[i], in[i], len);
-      }
-      continue;
-    }
+  // Copy input buffer
+  srsran_vec_cf_copy(buffer_in[i], in, len);
 
-    // Copy input buffer
-    srsran_vec_cf_copy(buffer_in, in[i], len);
+  if (hst[i]) {
+    srsran_channel_hst_execute(hst[i], buffer_in[i], buffer_out[i], len, &t);
+    srsran_vec_sc_prod_ccc(buffer_out[i], local_cexpf(hst_init_phase), buffer_in[i], len);
+  }
 
-    if (hst) {
-      srsran_channel_hst_execute(hst, buffer_in, buffer_out, len, &t);
-      srsran_vec_sc_prod_ccc(buffer_out, local_cexpf(hst_init_phase), buffer_in, len);
-    }
+  if (awgn[i]) {
+    srsran_channel_awgn_run_c(awgn[i], buffer_in[i], buffer_out[i], len);
+    srsran_vec_cf_copy(buffer_in[i], buffer_out[i], len);
+  }
+
+  if (fading[i]) {
+    srsran_channel_fading_execute(fading[i], buffer_in[i], buffer_out[i], len, t.full_secs + t.frac_secs);
+    srsran_vec_cf_copy(buffer_in[i], buffer_out[i], len);
+  }
+
+  if (delay[i]) {
+    srsran_channel_delay_execute(delay[i], buffer_in[i], buffer_out[i], len, &t);
+    srsran_vec_cf_copy(buffer_in[i], buffer_out[i], len);
+  }
+
+  if (rlf) {
+    srsran_channel_rlf_execute(rlf, buffer_in[i], buffer_out[i], len, &t);
+    srsran_vec_cf_copy(buffer_in[i], buffer_out[i], len);
+  }
 
-    if (awgn) {
-      srsran_channel_awgn_run_c(awgn, buffer_in, buffer_out, len);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  // Copy output buffer
+  srsran_vec_cf_copy(out, buffer_in[i], len);
+}
+
+void channel::run_worker(uint32_t worker_idx, uint32_t nof_threads)
+{
+  uint64_t last_id = 0;
+
+  std::unique_lock<std::mutex> lock(job_mutex);
+  while (true) {
+    job_cvar.wait(lock, [this, last_id]() { return not running or job.id != last_id; });
+    if (not running) {
+      return;
     }
+    last_id = job.id;
+    job_t j = job;
+    lock.unlock();
 
-    if (fading[i]) {
-      srsran_channel_fading_execute(fading[i], buffer_in, buffer_out, len, t.full_secs + t.frac_secs);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+    // Process the channels assigned to this worker
+    for (uint32_t i = worker_idx; i < nof_channels; i += nof_threads) {
+      run_channel(i, j.in[i], j.out[i], j.len, *j.t);
     }
 
-    if (delay[i]) {
-      srsran_channel_delay_execute(delay[i], buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+    lock.lock();
+    job.busy--;
+    if (job.busy == 0) {
+      done_cvar.notify_one();
     }
+  }
+}
 
-    if (rlf) {
-      srsran_channel_rlf_execute(rlf, buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
+                  cf_t*                     out[SRSRAN_MAX_CHANNELS],
+                  uint32_t                  len,
+                  const srsran_timestamp_t& t)
+{
+  // Early return if pointers are not enabled
+  if (in == nullptr || out == nullptr) {
+    return;
+  }
+
+  uint32_t nof_threads = (uint32_t)workers.size() + 1;
+
+  // Hand the job over to the workers
+  if (nof_threads > 1) {
+    {
+      std::lock_guard<std::mutex> lock(job_mutex);
+      job.in   = in;
+      job.out  = out;
+      job.len  = len;
+      job.t    = &t;
+      job.busy = nof_threads - 1;
+      job.id++;
     }
+    job_cvar.notify_all();
+  }
+
+  // For each channel of the calling thread
+  for (uint32_t i = 0; i < nof_channels; i += nof_threads) {
+    run_channel(i, in[i], out[i], len, t);
+  }
 
-    // Copy output buffer
-    srsran_vec_cf_copy(out[i], buffer_in, len);
+  // Wait for the workers to finish
+  if (nof_threads > 1) {
+    std::unique_lock<std::mutex> lock(job_mutex);
+    done_cvar.wait(lock, [this]() { return job.busy == 0; });
   }
 
-  if (hst) {
+  if (hst[0]) {
     // Increment phase to keep it coherent between frames
-    hst_init_phase += (2 * M_PI * len * hst->fs_hz / hst->srate_hz);
+    hst_init_phase += (2 * M_PI * len * hst[0]->fs_hz / hst[0]->srate_hz);
 
     // Positive Remainder
     while (hst_init_phase > 2 * M_PI) {
@@ -225,8 +296,8 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
   if (delay[0]) {
     str << "delay=" << delay[0]->delay_us << "us; ";
   }
-  if (hst) {
-    str << "hst=" << hst->fs_hz << "Hz; ";
+  if (hst[0]) {
+    str << "hst=" << hst[0]->fs_hz << "Hz; ";
   }
   logger.debug("%s", str.str().c_str());
 }
@@ -244,10 +315,10 @@ void channel::set_srate(uint32_t srate)
       if (delay[i]) {
         srsran_channel_delay_update_srate(delay[i], srate);
       }
-    }
 
-    if (hst) {
-      srsran_channel_hst_update_srate(hst, srate);
+      if (hst[i]) {
+        srsran_channel_hst_update_srate(hst[i], srate);
+      }
     }
 
     // Update sampling rate
@@ -257,7 +328,9 @@ void channel::set_srate(uint32_t srate)
 
 void channel::set_signal_power_dBfs(float power_dBfs)
 {
-  if (awgn != nullptr) {
-    srsran_channel_awgn_set_n0(awgn, power_dBfs - args.awgn_snr_dB);
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    if (awgn[i] != nullptr) {
+      srsran_channel_awgn_set_n0(awgn[i], power_dBfs - args.awgn_snr_dB);
+    }
   }
 }
@@ -21,6 +21,7 @@
 
 #include "srsran/phy/channel/fading.h"
 #include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include <math.h>
 #include <stdio.h>
@@ -90,6 +91,7 @@ static inline __m128 _sine(const float* table, __m128 arg)
   __m128  argmod   = _mm_sub_ps(arg, _mm_mul_ps(turns, _mm_set1_ps(2.0f * (float)M_PI)));
   __m128  indexps  = _mm_mul_ps(argmod, _mm_set1_ps(1024.0f / (2.0f * (float)M_PI)));
   __m128i indexi32 = _mm_abs_epi32(_mm_cvtps_epi32(indexps));
+  indexi32         = _mm_and_si128(indexi32, _mm_set1_epi32(1023)); // Rounding may give 1024, out of the table
   _mm_store_si128((__m128i*)idx, indexi32);
 
   for (int i = 0; i < 4; i++) {
@@ -160,29 +162,89 @@ static inline void generate_tap(float delay_ns, float power_db, float srate, cf_
   cf_t  a0        = amplitude / N;
 
   srsran_vec_gen_sine(a0, -O, buf, N);
+
+  // Shift FFT once, so the taps can be added up without shifting
+  for (uint32_t i = 0; i < N / 2; i++) {
+    cf_t tmp       = buf[i];
+    buf[i]         = buf[i + N / 2];
+    buf[i + N / 2] = tmp;
+  }
 }
 
-static inline void generate_taps(srsran_channel_fading_t* q, float time)
+static inline void
+generate_fir_tap(float delay_ns, float power_db, float srate, cf_t* buf, uint32_t len, uint32_t path_delay)
 {
-  // Generate taps
-  for (int i = 0; i < nof_taps[q->model]; i++) {
-    // Compute phase for the doppler dispersion
-    cf_t a = get_doppler_dispersion(q, time, q->doppler, q->coeff_alpha[i], q->coeff_a[i], q->coeff_b[i]);
-
-    if (i) {
-      // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(q->h_tap[i], a, q->temp, q->N);
-
-      // Add to frequency response, shifts FFT at same time
-      srsran_vec_sum_ccc(q->h_freq, &q->temp[q->N / 2], q->h_freq, q->N / 2);
-      srsran_vec_sum_ccc(&q->h_freq[q->N / 2], q->temp, &q->h_freq[q->N / 2], q->N / 2);
-    } else {
-      // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][q->N / 2], a, q->h_freq, q->N / 2);
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][0], a, &q->h_freq[q->N / 2], q->N / 2);
+  const float M         = (float)SRSRAN_CHANNEL_FADING_FIR_HALF_LEN;
+  float       amplitude = srsran_convert_dB_to_power(power_db);
+  float       delay     = delay_ns * 1e-9f * srate;
+  float       sum       = 0.0f;
+
+  // Blackman windowed sinc centered at the fractional tap delay
+  for (uint32_t i = 0; i < len; i++) {
+    float t = (float)i - delay - M;
+    float h = 0.0f;
+    if (fabsf(t) < M) {
+      float w = 0.42f + 0.5f * cosf((float)M_PI * t / M) + 0.08f * cosf(2.0f * (float)M_PI * t / M);
+      float s = (fabsf(t) < 1e-6f) ? 1.0f : sinf((float)M_PI * t) / ((float)M_PI * t);
+      h       = w * s;
+    }
+    buf[i] = h;
+    sum += h;
+  }
+
+  // Normalise DC gain, apply tap power and the same phase as the FFT shifted frequency response
+  float arg = -(float)M_PI * fmodf(delay + (float)path_delay, 2.0f);
+  cf_t  a0;
+  __real__ a0 = amplitude * cosf(arg) / sum;
+  __imag__ a0 = amplitude * sinf(arg) / sum;
+  srsran_vec_sc_prod_ccc(buf, a0, buf, len);
+}
+
+static inline void sum_taps(const cf_t* a, cf_t* const* taps, uint32_t ntaps, cf_t* out, uint32_t len)
+{
+  uint32_t k = 0;
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t _a[SRSRAN_CHANNEL_FADING_MAXTAPS];
+  for (uint32_t i = 0; i < ntaps; i++) {
+    _a[i] = srsran_simd_cf_set1(a[i]);
+  }
+
+  for (; k + SRSRAN_SIMD_CF_SIZE - 1 < len; k += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t acc = srsran_simd_cf_prod(_a[0], srsran_simd_cfi_loadu(&taps[0][k]));
+    for (uint32_t i = 1; i < ntaps; i++) {
+      acc = srsran_simd_cf_add(acc, srsran_simd_cf_prod(_a[i], srsran_simd_cfi_loadu(&taps[i][k])));
+    }
+    srsran_simd_cfi_storeu(&out[k], acc);
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; k < len; k++) {
+    cf_t acc = 0;
+    for (uint32_t i = 0; i < ntaps; i++) {
+      acc += a[i] * taps[i][k];
     }
+    out[k] = acc;
+  }
+}
+
+static inline void generate_taps(srsran_channel_fading_t* q, float time)
+{
+  uint32_t ntaps = nof_taps[q->model];
+  cf_t     a[SRSRAN_CHANNEL_FADING_MAXTAPS];
+
+  // Compute phase for the doppler dispersion
+  for (uint32_t i = 0; i < ntaps; i++) {
+    a[i] = get_doppler_dispersion(q, time, q->doppler, q->coeff_alpha[i], q->coeff_a[i], q->coeff_b[i]);
+  }
+
+  if (q->use_fir) {
+    // Add up tap impulse responses
+    sum_taps(a, q->fir_tap, ntaps, q->fir_coeff, q->fir_len);
+  } else {
+    // Add up tap frequency responses in a single pass, taps are already FFT shifted
+    sum_taps(a, q->h_tap, ntaps, q->h_freq, q->N);
+    // at this stage, q->h_freq should contain the frequency response
   }
-  // at this stage, q->h_freq should contain the frequency response
 }
 
 static inline void filter_segment(srsran_channel_fading_t* q, const cf_t* input, cf_t* output, uint32_t nsamples)
@@ -211,6 +273,39 @@ static inline void filter_segment(srsran_channel_fading_t* q, const cf_t* input,
   srsran_vec_cf_copy(q->state, &q->temp[nsamples], q->state_len);
 }
 
+static inline void filter_segment_fir(srsran_channel_fading_t* q, const cf_t* input, cf_t* output, uint32_t nsamples)
+{
+  // The history holds the last fir_offset + fir_len - 1 input samples, followed by the new ones
+  uint32_t hist_len = q->fir_offset + q->fir_len - 1;
+
+  // Append input to the history
+  srsran_vec_cf_copy(&q->fir_state[hist_len], input, nsamples);
+
+  // y[n] = sum_j h[j] * x[n - fir_offset - j], where x[n - fir_offset - j] is at fir_len - 1 + n - j
+  uint32_t n = 0;
+#if SRSRAN_SIMD_CF_SIZE
+  for (; n + SRSRAN_SIMD_CF_SIZE - 1 < nsamples; n += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t acc = srsran_simd_cf_zero();
+    for (uint32_t j = 0; j < q->fir_len; j++) {
+      simd_cf_t x = srsran_simd_cfi_loadu(&q->fir_state[q->fir_len - 1 + n - j]);
+      acc         = srsran_simd_cf_add(acc, srsran_simd_cf_prod(srsran_simd_cf_set1(q->fir_coeff[j]), x));
+    }
+    srsran_simd_cfi_storeu(&output[n], acc);
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; n < nsamples; n++) {
+    cf_t acc = 0;
+    for (uint32_t j = 0; j < q->fir_len; j++) {
+      acc += q->fir_coeff[j] * q->fir_state[q->fir_len - 1 + n - j];
+    }
+    output[n] = acc;
+  }
+
+  // Keep the last samples for the next segment
+  memmove(q->fir_state, &q->fir_state[nsamples], sizeof(cf_t) * hist_len);
+}
+
 int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const char* model, uint32_t seed)
 {
   int ret = SRSRAN_ERROR;
@@ -225,6 +320,13 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
     // Fill srate
     q->srate = (float)srate;
 
+    // Reset optional buffers, so they can be safely freed
+    q->fir_coeff = NULL;
+    q->fir_state = NULL;
+    for (uint32_t i = 0; i < SRSRAN_CHANNEL_FADING_MAXTAPS; i++) {
+      q->fir_tap[i] = NULL;
+    }
+
     // Populate internal parameters
     uint32_t fft_min_pow =
         (uint32_t)round(log2(excess_tap_delay_ns[q->model][nof_taps[q->model] - 1] * 1e-9 * srate)) + 3;
@@ -232,6 +334,17 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
     q->path_delay = q->N / 4;
     q->state_len  = 0;
 
+    // Use time domain filtering if the impulse response is short enough
+    uint32_t max_delay = (uint32_t)ceil(excess_tap_delay_ns[q->model][nof_taps[q->model] - 1] * 1e-9 * srate);
+    q->fir_len         = max_delay + 2 * SRSRAN_CHANNEL_FADING_FIR_HALF_LEN + 1;
+    q->fir_offset      = 0;
+    if (q->fir_len > SRSRAN_CHANNEL_FADING_FIR_MAX_LEN || q->path_delay < SRSRAN_CHANNEL_FADING_FIR_HALF_LEN) {
+      q->fir_len = 0;
+    } else {
+      q->fir_offset = q->path_delay - SRSRAN_CHANNEL_FADING_FIR_HALF_LEN;
+    }
+    q->use_fir = q->fir_len > 0;
+
     // Initialise random number
     srsran_random_t* random = srsran_random_init(seed);
 
@@ -250,6 +363,22 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
       // Generate tap frequency response
       generate_tap(
           excess_tap_delay_ns[q->model][i], relative_power_db[q->model][i], q->srate, q->h_tap[i], q->N, q->path_delay);
+
+      // Generate tap impulse response
+      if (q->fir_len > 0) {
+        q->fir_tap[i] = srsran_vec_cf_malloc(q->fir_len);
+        if (!q->fir_tap[i]) {
+          fprintf(stderr, "Error: allocating fir_tap\n");
+          srsran_random_free(random);
+          goto clean_exit;
+        }
+        generate_fir_tap(excess_tap_delay_ns[q->model][i],
+                         relative_power_db[q->model][i],
+                         q->srate,
+                         q->fir_tap[i],
+                         q->fir_len,
+                         q->path_delay);
+      }
     }
 
     // Generate sine Table
@@ -297,6 +426,18 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
       goto clean_exit;
     }
     srsran_vec_cf_zero(q->state, q->N);
+
+    if (q->fir_len > 0) {
+      uint32_t fir_buffer_len = q->fir_offset + q->fir_len - 1 + q->N / 2;
+
+      q->fir_coeff = srsran_vec_cf_malloc(q->fir_len);
+      q->fir_state = srsran_vec_cf_malloc(fir_buffer_len);
+      if (!q->fir_coeff || !q->fir_state) {
+        fprintf(stderr, "Error: allocating FIR buffers\n");
+        goto clean_exit;
+      }
+      srsran_vec_cf_zero(q->fir_state, fir_buffer_len);
+    }
   }
 
   ret = SRSRAN_SUCCESS;
@@ -327,6 +468,17 @@ void srsran_channel_fading_free(srsran_channel_fading_t* q)
       if (q->h_tap[i]) {
         free(q->h_tap[i]);
       }
+      if (q->fir_tap[i]) {
+        free(q->fir_tap[i]);
+      }
+    }
+
+    if (q->fir_coeff) {
+      free(q->fir_coeff);
+    }
+
+    if (q->fir_state) {
+      free(q->fir_state);
     }
 
     if (q->state) {
@@ -335,6 +487,24 @@ void srsran_channel_fading_free(srsran_channel_fading_t* q)
   }
 }
 
+int srsran_channel_fading_set_fir(srsran_channel_fading_t* q, bool enable)
+{
+  if (q == NULL || (enable && q->fir_len == 0)) {
+    return SRSRAN_ERROR;
+  }
+
+  // Reset filter states
+  q->state_len = 0;
+  if (q->fir_len > 0) {
+    uint32_t fir_buffer_len = q->fir_offset + q->fir_len - 1 + q->N / 2;
+    srsran_vec_cf_zero(q->fir_state, fir_buffer_len);
+  }
+
+  q->use_fir = enable;
+
+  return SRSRAN_SUCCESS;
+}
+
 double srsran_channel_fading_execute(srsran_channel_fading_t* q,
                                      const cf_t*              in,
                                      cf_t*                    out,
@@ -352,7 +522,11 @@ double srsran_channel_fading_execute(srsran_channel_fading_t* q,
       uint32_t n = SRSRAN_MIN(q->N / 2, nsamples - counter);
 
       // Execute
-      filter_segment(q, &in[counter], &out[counter], n);
+      if (q->use_fir) {
+        filter_segment_fir(q, &in[counter], &out[counter], n);
+      } else {
+        filter_segment(q, &in[counter], &out[counter], n);
+      }
 
       // Increment time
       init_time += n / q->srate;
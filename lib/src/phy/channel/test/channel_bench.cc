@@ -0,0 +1,173 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/channel/channel.h"
+#include "srsran/phy/utils/vector.h"
+#include <chrono>
+#include <getopt.h>
+#include <sstream>
+
+static std::string models                      = "epa5,eva70,etu300";
+static uint32_t    nof_channels                = 4;
+static uint32_t    nof_threads                 = 4;
+static uint32_t    duration_ms                 = 100;
+static uint32_t    srate                       = (uint32_t)23.04e6;
+static bool        awgn_enable                 = true;
+static float       awgn_snr_dB                 = 20.0f;
+static uint32_t    sf_len                      = 0;
+static cf_t*       input[SRSRAN_MAX_CHANNELS]  = {};
+static cf_t*       output[SRSRAN_MAX_CHANNELS] = {};
+static cf_t*       serial[SRSRAN_MAX_CHANNELS] = {};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [mcjtsn]\n", prog);
+  printf("\t-m Comma separated channel models [Default %s]\n", models.c_str());
+  printf("\t-c Number of channels (antennas) [Default %d]\n", nof_channels);
+  printf("\t-j Number of threads [Default %d]\n", nof_threads);
+  printf("\t-t Simulation time in ms [Default %d]\n", duration_ms);
+  printf("\t-s Sampling rate in Hz [Default %d]\n", srate);
+  printf("\t-n Disable AWGN [Default %s]\n", awgn_enable ? "enabled" : "disabled");
+}
+
+static int parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "mcjtsn")) != -1) {
+    switch (opt) {
+      case 'm':
+        models = argv[optind];
+        break;
+      case 'c':
+        nof_channels = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 'j':
+        nof_threads = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 't':
+        duration_ms = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 's':
+        srate = (uint32_t)strtof(argv[optind], nullptr);
+        break;
+      case 'n':
+        awgn_enable = false;
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+
+  if (nof_channels == 0 || nof_channels > SRSRAN_MAX_CHANNELS) {
+    printf("Invalid number of channels %d\n", nof_channels);
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Runs the channel emulator for the given model and number of threads, returns the throughput in MSps per channel
+static double run_model(const std::string& model, uint32_t threads, cf_t* out[SRSRAN_MAX_CHANNELS])
+{
+  srsran::channel::args_t args = {};
+  args.enable                  = true;
+  args.nof_threads             = threads;
+  args.fading_enable           = true;
+  args.fading_model            = model;
+  args.awgn_enable             = awgn_enable;
+  args.awgn_snr_dB             = awgn_snr_dB;
+
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("CHANNEL", false);
+  logger.set_level(srslog::basic_levels::warning);
+
+  srsran::channel channel(args, nof_channels, logger);
+  channel.set_srate(srate);
+
+  std::chrono::nanoseconds elapsed = {};
+  for (uint32_t i = 0; i < duration_ms; i++) {
+    srsran_timestamp_t ts = {};
+    srsran_timestamp_init(&ts, 0, (double)i / 1000.0);
+
+    auto start = std::chrono::steady_clock::now();
+    channel.run(input, out, sf_len, ts);
+    elapsed += std::chrono::steady_clock::now() - start;
+  }
+
+  return (double)duration_ms * sf_len / (double)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // The same subframe is fed in every millisecond, the fading makes every output different
+  sf_len = srate / 1000;
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    input[i]  = srsran_vec_cf_malloc(sf_len);
+    output[i] = srsran_vec_cf_malloc(sf_len);
+    serial[i] = srsran_vec_cf_malloc(sf_len);
+    TESTASSERT(input[i] != nullptr && output[i] != nullptr && serial[i] != nullptr);
+    for (uint32_t j = 0; j < sf_len; j++) {
+      input[i][j] = srsran_convert_dB_to_amplitude(-3.0f) * ((float)((i + j) % 7) - 3.0f) / 3.0f;
+    }
+  }
+
+  printf("-- Channel emulator benchmark. srate=%.2fMHz; channels=%d; threads=%d; duration=%dms\n",
+         (double)srate / 1e6,
+         nof_channels,
+         nof_threads,
+         duration_ms);
+
+  std::stringstream ss(models);
+  std::string       model;
+  while (std::getline(ss, model, ',')) {
+    double serial_msps   = run_model(model, 1, serial);
+    double parallel_msps = run_model(model, nof_threads, output);
+
+    // The channels are deterministic, the result shall not depend on the number of threads
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      TESTASSERT(memcmp(serial[i], output[i], sizeof(cf_t) * sf_len) == 0);
+    }
+
+    printf("%-8s serial: %7.1f MSps; %d threads: %7.1f MSps; speed-up: %.2f\n",
+           model.c_str(),
+           serial_msps * nof_channels,
+           nof_threads,
+           parallel_msps * nof_channels,
+           parallel_msps / serial_msps);
+  }
+
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    free(input[i]);
+    free(output[i]);
+    free(serial[i]);
+  }
+
+  srslog::flush();
+
+  return SRSRAN_SUCCESS;
+}
@@ -43,16 +43,20 @@ static uint32_t duration_ms     = 1000;
 static char*    model           = default_model;
 static uint32_t srate           = (uint32_t)30.72e6;
 static uint32_t random_seed     = 0x12345678; // Default seed, deterministic channel
+static bool     force_fft       = false;
 
 #define INPUT_TYPE 0 /* 0: Dirac Delta; Otherwise: Random*/
+#define FIR_FFT_MAX_ERROR_DB (-30.0f) /* Maximum FIR output error power relative to the FFT output power */
+#define FIR_FFT_OCCUPIED_BW (0.6f)     /* Occupied fraction of the band for the FIR and FFT comparison */
 
 static void usage(char* prog)
 {
-  printf("Usage: %s [mts]\n", prog);
+  printf("Usage: %s [mtsrf]\n", prog);
   printf("\t-m Channel model: epa5, eva70, etu300 [Default %s]\n", model);
   printf("\t-t Simulation time in ms: [Default %d]\n", duration_ms);
   printf("\t-s Sampling rate in Hz: [Default %d]\n", srate);
   printf("\t-r Random generator seed: [Default %d]\n", random_seed);
+  printf("\t-f Force frequency domain filtering: [Default %s]\n", force_fft ? "enabled" : "disabled");
 #ifdef ENABLE_GUI
   printf("\t-g Enable GUI: [Default %s]\n", enable_gui ? "enabled" : "disabled");
 #endif /* ENABLE_GUI */
@@ -61,7 +65,7 @@ static void usage(char* prog)
 static int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "mtsrg")) != -1) {
+  while ((opt = getopt(argc, argv, "mtsrfg")) != -1) {
     switch (opt) {
       case 'm':
         model = argv[optind];
@@ -75,6 +79,9 @@ static int parse_args(int argc, char** argv)
       case 'r':
         random_seed = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'f':
+        force_fft = true;
+        break;
       case 'g':
 #ifdef ENABLE_GUI
         enable_gui = (enable_gui) ? false : true;
@@ -88,6 +95,80 @@ static int parse_args(int argc, char** argv)
   return SRSRAN_SUCCESS;
 }
 
+/* Runs the same channel model and seed through time (FIR) and frequency (FFT) domain filtering and checks that both
+ * outputs match for a band limited input. The FIR taps are truncated, so only the occupied band is expected to match */
+static int test_fir_fft(srsran_dft_plan_t* ifft)
+{
+  int                     ret         = SRSRAN_ERROR;
+  uint32_t                sf_len      = srate / 1000;
+  uint32_t                nof_re      = (uint32_t)(FIR_FFT_OCCUPIED_BW * sf_len / 2.0f);
+  srsran_channel_fading_t fir_channel = {};
+  srsran_channel_fading_t fft_channel = {};
+  cf_t*                   input       = srsran_vec_cf_malloc(sf_len);
+  cf_t*                   fir_output  = srsran_vec_cf_malloc(sf_len);
+  cf_t*                   fft_output  = srsran_vec_cf_malloc(sf_len);
+  double                  error_pwr   = 0.0;
+  double                  signal_pwr  = 0.0;
+
+  if (!input || !fir_output || !fft_output) {
+    fprintf(stderr, "Error: allocating FIR and FFT comparison buffers\n");
+    goto clean_exit;
+  }
+
+  if (srsran_channel_fading_init(&fir_channel, srate, model, random_seed) ||
+      srsran_channel_fading_init(&fft_channel, srate, model, random_seed)) {
+    fprintf(stderr, "Error: initialising fading channel. model=%s, srate=%d\n", model, srate);
+    goto clean_exit;
+  }
+
+  if (srsran_channel_fading_set_fir(&fir_channel, true) || srsran_channel_fading_set_fir(&fft_channel, false)) {
+    // The FIR is not available for this model and sampling rate, nothing to compare
+    ret = SRSRAN_SUCCESS;
+    goto clean_exit;
+  }
+
+  // Random phase subcarriers around DC, the rest of the band is empty
+  srsran_vec_cf_zero(input, sf_len);
+  for (uint32_t i = 0; i < nof_re; i++) {
+    input[i]              = cexpf(_Complex_I * 2.0f * (float)M_PI * ((float)rand() / (float)RAND_MAX));
+    input[sf_len - 1 - i] = cexpf(_Complex_I * 2.0f * (float)M_PI * ((float)rand() / (float)RAND_MAX));
+  }
+  srsran_dft_run_c(ifft, input, input);
+  srsran_vec_sc_prod_cfc(input, 1.0f / sqrtf((float)sf_len), input, sf_len);
+
+  for (uint32_t i = 0; i < duration_ms; i++) {
+    srsran_channel_fading_execute(&fir_channel, input, fir_output, sf_len, (double)i / 1000.0);
+    srsran_channel_fading_execute(&fft_channel, input, fft_output, sf_len, (double)i / 1000.0);
+
+    signal_pwr += srsran_vec_avg_power_cf(fft_output, sf_len);
+    srsran_vec_sub_ccc(fir_output, fft_output, fir_output, sf_len);
+    error_pwr += srsran_vec_avg_power_cf(fir_output, sf_len);
+  }
+
+  float error_db = srsran_convert_power_to_dB((float)(error_pwr / signal_pwr));
+  printf("-- FIR and FFT filtering relative error %.1f dB\n", error_db);
+  if (!(error_db <= FIR_FFT_MAX_ERROR_DB)) {
+    fprintf(stderr, "Error: FIR and FFT filtering outputs differ by %.1f dB\n", error_db);
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_channel_fading_free(&fir_channel);
+  srsran_channel_fading_free(&fft_channel);
+  if (input) {
+    free(input);
+  }
+  if (fir_output) {
+    free(fir_output);
+  }
+  if (fft_output) {
+    free(fft_output);
+  }
+  return ret;
+}
+
 int main(int argc, char** argv)
 {
   int            ret           = SRSRAN_ERROR;
@@ -158,12 +239,21 @@ int main(int argc, char** argv)
   }
 #endif /* ENABLE_GUI */
 
+  // Compare the time and frequency domain filtering of the channel
+  if (test_fir_fft(&ifft) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
   // Initialise channel
   if (srsran_channel_fading_init(&channel_fading, srate, model, 0x12345678)) {
     fprintf(stderr, "Error: initialising fading channel. model=%s, srate=%d\n", model, srate);
     goto clean_exit;
   }
 
+  if (force_fft) {
+    srsran_channel_fading_set_fir(&channel_fading, false);
+  }
+
   // Allocate buffers
   input_buffer = srsran_vec_cf_malloc(srate / 1000);
   if (!input_buffer) {
@@ -187,10 +277,11 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  printf("-- Starting Fading channel simulator. srate=%.2fMHz; model=%s; duration=%dms\n",
+  printf("-- Starting Fading channel simulator. srate=%.2fMHz; model=%s; duration=%dms; filter=%s\n",
          (double)srate / 1e6,
          model,
-         duration_ms);
+         duration_ms,
+         channel_fading.use_fir ? "fir" : "fft");
 
   for (int i = 0; i < duration_ms; i++) {
     gettimeofday(&t[1], NULL);
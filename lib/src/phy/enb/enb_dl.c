@@ -438,6 +438,15 @@ int srsran_enb_dl_put_pdsch(srsran_enb_dl_t* q, srsran_pdsch_cfg_t* pdsch, uint8
   return srsran_pdsch_encode(&q->pdsch, &q->dl_sf, pdsch, data, q->sf_symbols);
 }
 
+int srsran_enb_dl_put_pdsch_batch(srsran_enb_dl_t*         q,
+                                  srsran_pdsch_cfg_t*      pdsch[],
+                                  uint8_t*                 data[][SRSRAN_MAX_CODEWORDS],
+                                  uint32_t                 nof_pdsch,
+                                  srsran_pdsch_enc_time_t* time)
+{
+  return srsran_pdsch_encode_batch(&q->pdsch, &q->dl_sf, pdsch, data, nof_pdsch, q->sf_symbols, time);
+}
+
 int srsran_enb_dl_put_pmch(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data)
 {
   return srsran_pmch_encode(&q->pmch, &q->dl_sf, pmch_cfg, data, q->sf_symbols);
@@ -63,6 +63,9 @@ int srsran_enb_ul_init(srsran_enb_ul_t* q, cf_t* in_buffer, uint32_t max_prb)
       goto clean_exit;
     }
 
+    // The PUSCH is equalized with the estimates of the DMRS symbols, no need to fill the whole estimates grid
+    srsran_chest_ul_set_pusch_ce_dmrs_only(&q->chest, true);
+
     ret = SRSRAN_SUCCESS;
 
   } else {
@@ -90,6 +93,18 @@ void srsran_enb_ul_free(srsran_enb_ul_t* q)
     if (q->chest_res.ce) {
       free(q->chest_res.ce);
     }
+    if (q->pucch_cand_cfg) {
+      free(q->pucch_cand_cfg);
+    }
+    if (q->pucch_cand_res) {
+      free(q->pucch_cand_res);
+    }
+    if (q->pucch_cand_ue) {
+      free(q->pucch_cand_ue);
+    }
+    if (q->pucch_cand_idx) {
+      free(q->pucch_cand_idx);
+    }
     bzero(q, sizeof(srsran_enb_ul_t));
   }
 }
@@ -272,6 +287,162 @@ int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
   return SRSRAN_SUCCESS;
 }
 
+// Every UE may need a resource for each channel selection hypothesis, with and without scheduling request
+#define ENB_UL_PUCCH_MAX_CAND_UE (2 * SRSRAN_PUCCH_CS_MAX_ACK)
+
+static int pucch_cand_alloc(srsran_enb_ul_t* q, uint32_t nof_cand)
+{
+  if (nof_cand <= q->pucch_cand_max) {
+    return SRSRAN_SUCCESS;
+  }
+
+  free(q->pucch_cand_cfg);
+  free(q->pucch_cand_res);
+  free(q->pucch_cand_ue);
+  free(q->pucch_cand_idx);
+  q->pucch_cand_cfg = srsran_vec_malloc(sizeof(srsran_pucch_cfg_t) * nof_cand);
+  q->pucch_cand_res = srsran_vec_malloc(sizeof(srsran_pucch_res_t) * nof_cand);
+  q->pucch_cand_ue  = srsran_vec_u32_malloc(nof_cand);
+  q->pucch_cand_idx = srsran_vec_u32_malloc(nof_cand);
+  if (!q->pucch_cand_cfg || !q->pucch_cand_res || !q->pucch_cand_ue || !q->pucch_cand_idx) {
+    q->pucch_cand_max = 0;
+    return SRSRAN_ERROR;
+  }
+  q->pucch_cand_max = nof_cand;
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Appends all the possible resources of a UE, returns false if any of them is not format 1, 1a or 1b */
+static bool pucch_cand_add(srsran_enb_ul_t* q, srsran_pucch_cfg_t* cfg, uint32_t ue_idx, uint32_t* nof_cand)
+{
+  uint32_t nof_hyp = (cfg->uci_cfg.is_scheduling_request_tti && srsran_uci_cfg_total_ack(&cfg->uci_cfg)) ? 2 : 1;
+  uint32_t first   = *nof_cand;
+
+  // The Cedron frequency estimator is only available in the channel estimator
+  if (cfg->meas_ta_en && cfg->use_cedron_alg) {
+    return false;
+  }
+
+  for (uint32_t h = 0; h < nof_hyp; h++) {
+    srsran_pucch_cfg_t hyp = *cfg;
+    if (h > 0) {
+      hyp.uci_cfg.is_scheduling_request_tti = false;
+    }
+
+    hyp.format = srsran_pucch_proc_select_format(&q->cell, &hyp, &hyp.uci_cfg, NULL);
+    if (hyp.format > SRSRAN_PUCCH_FORMAT_1B) {
+      *nof_cand = first;
+      return false;
+    }
+
+    uint32_t n_pucch_i[SRSRAN_PUCCH_MAX_ALLOC] = {};
+    int      nof_resources = srsran_pucch_proc_get_resources(&q->cell, &hyp, &hyp.uci_cfg, NULL, n_pucch_i);
+    if (nof_resources < 1 || nof_resources > SRSRAN_PUCCH_CS_MAX_ACK) {
+      *nof_cand = first;
+      return false;
+    }
+
+    for (uint32_t i = 0; i < (uint32_t)nof_resources; i++) {
+      q->pucch_cand_cfg[*nof_cand]         = hyp;
+      q->pucch_cand_cfg[*nof_cand].n_pucch = n_pucch_i[i];
+      q->pucch_cand_ue[*nof_cand]          = ue_idx;
+      q->pucch_cand_idx[*nof_cand]         = i;
+      (*nof_cand)++;
+    }
+  }
+
+  return true;
+}
+
+int srsran_enb_ul_get_pucch_multi(srsran_enb_ul_t*    q,
+                                  srsran_ul_sf_cfg_t* ul_sf,
+                                  srsran_pucch_cfg_t* cfg,
+                                  srsran_pucch_res_t* res,
+                                  int*                ret,
+                                  uint32_t            nof_ue)
+{
+  if (q == NULL || ul_sf == NULL || (nof_ue > 0 && (cfg == NULL || res == NULL || ret == NULL))) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (pucch_cand_alloc(q, nof_ue * ENB_UL_PUCCH_MAX_CAND_UE) < SRSRAN_SUCCESS) {
+    ERROR("Error allocating PUCCH resources");
+    return SRSRAN_ERROR;
+  }
+
+  // Gather the resources that can be received jointly, the rest of UEs are decoded on their own
+  uint32_t nof_cand = 0;
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    if (!srsran_pucch_cfg_isvalid(&cfg[i], q->cell.nof_prb)) {
+      ERROR("Invalid PUCCH configuration");
+      ret[i] = SRSRAN_ERROR_INVALID_INPUTS;
+      continue;
+    }
+
+    // Drop CQI if there is collision with ACK
+    if (!cfg[i].simul_cqi_ack && srsran_uci_cfg_total_ack(&cfg[i].uci_cfg) > 0 && cfg[i].uci_cfg.cqi.data_enable) {
+      cfg[i].uci_cfg.cqi.data_enable = false;
+    }
+
+    if (!pucch_cand_add(q, &cfg[i], i, &nof_cand)) {
+      ret[i] = srsran_enb_ul_get_pucch(q, ul_sf, &cfg[i], &res[i]);
+    }
+  }
+
+  if (nof_cand == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  int joint_ret =
+      srsran_pucch_decode_format1_joint(&q->pucch, ul_sf, q->pucch_cand_cfg, nof_cand, q->sf_symbols, q->pucch_cand_res);
+  if (joint_ret < SRSRAN_SUCCESS) {
+    ERROR("Error decoding PUCCH");
+  }
+
+  // Select the best resource of every UE and resolve the scheduling request, as srsran_enb_ul_get_pucch() does
+  for (uint32_t k = 0; k < nof_cand;) {
+    uint32_t           i       = q->pucch_cand_ue[k];
+    bool               sr      = cfg[i].uci_cfg.is_scheduling_request_tti;
+    uint32_t           nof_hyp = 1;
+    srsran_pucch_res_t best[2] = {};
+
+    for (; k < nof_cand && q->pucch_cand_ue[k] == i; k++) {
+      srsran_pucch_cfg_t* c = &q->pucch_cand_cfg[k];
+      srsran_pucch_res_t* r = &q->pucch_cand_res[k];
+      uint32_t            j = q->pucch_cand_idx[k];
+      uint32_t            h = (sr && !c->uci_cfg.is_scheduling_request_tti) ? 1 : 0;
+      nof_hyp               = h + 1;
+
+      if (srsran_uci_cfg_total_ack(&c->uci_cfg) > 0 && c->format == SRSRAN_PUCCH_FORMAT_1B &&
+          c->ack_nack_feedback_mode == SRSRAN_PUCCH_ACK_NACK_FEEDBACK_MODE_CS &&
+          !c->uci_cfg.is_scheduling_request_tti && r->uci_data.ack.valid) {
+        uint8_t b[2] = {r->uci_data.ack.ack_value[0], r->uci_data.ack.ack_value[1]};
+        srsran_pucch_cs_get_ack(c, &c->uci_cfg, j, b, &r->uci_data);
+      }
+
+      if (j == 0 || r->correlation > best[h].correlation) {
+        best[h] = *r;
+      }
+
+      // The configuration is left with the last resource, like srsran_enb_ul_get_pucch()
+      cfg[i] = *c;
+    }
+
+    res[i] = best[0];
+    if (nof_hyp > 1) {
+      if (best[1].detected && (!best[0].detected || best[1].correlation > best[0].correlation)) {
+        res[i] = best[1];
+      } else {
+        cfg[i].uci_cfg.is_scheduling_request_tti = true;
+      }
+    }
+    ret[i] = joint_ret < SRSRAN_SUCCESS ? SRSRAN_ERROR : SRSRAN_SUCCESS;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                             srsran_ul_sf_cfg_t* ul_sf,
                             srsran_pusch_cfg_t* cfg,
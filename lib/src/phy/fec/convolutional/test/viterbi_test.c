@@ -36,6 +36,7 @@ static int      frame_length = 1000, nof_frames = 256;
 static float    ebno_db     = 100.0;
 static uint32_t seed        = 0;
 static bool     tail_biting = false;
+static uint32_t batch_size  = SRSRAN_VITERBI_MAX_BATCH;
 
 #define SNR_POINTS 10
 #define SNR_MIN 0.0
@@ -43,18 +44,19 @@ static bool     tail_biting = false;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [nlest]\n", prog);
+  printf("Usage: %s [nlestb]\n", prog);
   printf("\t-n nof_frames [Default %d]\n", nof_frames);
   printf("\t-l frame_length [Default %d]\n", frame_length);
   printf("\t-e ebno in dB [Default scan]\n");
   printf("\t-s seed [Default 0=time]\n");
   printf("\t-t tail_bitting [Default %s]\n", tail_biting ? "yes" : "no");
+  printf("\t-b batch_size [Default %d]\n", batch_size);
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nlste")) != -1) {
+  while ((opt = getopt(argc, argv, "nlsteb")) != -1) {
     switch (opt) {
       case 'n':
         nof_frames = (int)strtol(argv[optind], NULL, 10);
@@ -71,6 +73,9 @@ void parse_args(int argc, char** argv)
       case 't':
         tail_biting = true;
         break;
+      case 'b':
+        batch_size = (uint32_t)strtoul(argv[optind], NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -97,6 +102,46 @@ void parse_args(int argc, char** argv)
     }                                                                                                                  \
   } while (0)
 
+// Decodes the stored frames one by one and in a batch, checks that both give the same bits and accumulates the errors
+// of the batch decoder and the time taken by both
+static int viterbi_test_batch(srsran_viterbi_t* dec,
+                              float**           llr_batch,
+                              uint8_t**         data_batch,
+                              uint8_t*          data_tx,
+                              uint8_t*          data_rx,
+                              uint32_t          nof_batch,
+                              int*              errors_batch,
+                              uint64_t*         t_single_us,
+                              uint64_t*         t_batch_us)
+{
+  struct timeval t[3]     = {};
+  int            mismatch = 0;
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_batch; i++) {
+    srsran_viterbi_decode_f(dec, llr_batch[i], data_rx, frame_length);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  *t_single_us += t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+  gettimeofday(&t[1], NULL);
+  if (srsran_viterbi_decode_f_batch(dec, llr_batch, data_batch, nof_batch, frame_length) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  *t_batch_us += t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+  for (uint32_t i = 0; i < nof_batch; i++) {
+    srsran_viterbi_decode_f(dec, llr_batch[i], data_rx, frame_length);
+    mismatch += srsran_bit_diff(data_rx, data_batch[i], frame_length);
+    *errors_batch += srsran_bit_diff(data_tx, data_batch[i], frame_length);
+  }
+
+  return mismatch;
+}
+
 //#define TEST_SSE
 
 int main(int argc, char** argv)
@@ -109,20 +154,32 @@ int main(int argc, char** argv)
   uint8_t * data_tx, *data_rx, *symbols;
   float     var[SNR_POINTS], varunc[SNR_POINTS];
   int       snr_points;
-  int       errors_s   = 0;
-  int       errors_us  = 0;
-  int       errors_c   = 0;
-  int       errors_f   = 0;
-  int       errors_sse = 0;
+  int       errors_s     = 0;
+  int       errors_us    = 0;
+  int       errors_c     = 0;
+  int       errors_f     = 0;
+  int       errors_sse   = 0;
+  int       errors_batch = 0;
+  int       mismatch     = 0;
+  uint32_t  nof_batch    = 0;
+  uint64_t  t_single_us  = 0;
+  uint64_t  t_batch_us   = 0;
 #ifdef TEST_SSE
   srsran_viterbi_t dec_sse;
 #endif
   srsran_viterbi_t   dec;
   srsran_convcoder_t cod;
   int                coded_length;
+  float*             llr_batch[SRSRAN_VITERBI_MAX_BATCH * 4]  = {};
+  uint8_t*           data_batch[SRSRAN_VITERBI_MAX_BATCH * 4] = {};
 
   parse_args(argc, argv);
 
+  if (batch_size == 0 || batch_size > SRSRAN_VITERBI_MAX_BATCH * 4) {
+    ERROR("Invalid batch size %d", batch_size);
+    exit(-1);
+  }
+
   if (!seed) {
     seed = time(NULL);
   }
@@ -186,6 +243,15 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  for (uint32_t i = 0; i < batch_size; i++) {
+    llr_batch[i]  = srsran_vec_f_malloc(coded_length);
+    data_batch[i] = srsran_vec_u8_malloc(frame_length);
+    if (!llr_batch[i] || !data_batch[i]) {
+      perror("malloc");
+      exit(-1);
+    }
+  }
+
   float ebno_inc, esno_db;
   ebno_inc = (SNR_MAX - SNR_MIN) / SNR_POINTS;
   if (ebno_db == 100.0) {
@@ -208,7 +274,8 @@ int main(int argc, char** argv)
     errors_s   = 0;
     errors_c   = 0;
     errors_f   = 0;
-    errors_sse = 0;
+    errors_sse   = 0;
+    errors_batch = 0;
     while (frame_cnt < nof_frames) {
       /* generate data_tx */
       srsran_random_t random_gen = srsran_random_init(0);
@@ -245,6 +312,19 @@ int main(int argc, char** argv)
       VITERBI_TEST(srsran_viterbi_decode_uc, dec_sse, llr_c, errors_sse);
 #endif
       frame_cnt++;
+
+      // Decode the stored frames together once the batch is full
+      srsran_vec_f_copy(llr_batch[nof_batch++], llr, coded_length);
+      if (nof_batch == batch_size || frame_cnt == nof_frames) {
+        int ret = viterbi_test_batch(
+            &dec, llr_batch, data_batch, data_tx, data_rx, nof_batch, &errors_batch, &t_single_us, &t_batch_us);
+        if (ret < SRSRAN_SUCCESS) {
+          ERROR("Error decoding batch");
+          exit(-1);
+        }
+        mismatch += ret;
+        nof_batch = 0;
+      }
       printf("     Eb/No: %3.2f %10d/%d   ", SNR_MIN + i * ebno_inc, frame_cnt, nof_frames);
       if (errors_s >= 0)
         printf(" int16 BER: %.2e  ", (float)errors_s / (frame_cnt * frame_length));
@@ -270,11 +350,18 @@ int main(int argc, char** argv)
         printf("uint8  BER    :    %g\t%u errors\n", (float)errors_c / (frame_cnt * frame_length), errors_c);
       if (errors_f >= 0)
         printf("float  BER    :    %g\t%u errors\n", (float)errors_f / (frame_cnt * frame_length), errors_f);
+      printf("batch  BER    :    %g\t%u errors\n", (float)errors_batch / (frame_cnt * frame_length), errors_batch);
 #ifdef TEST_SSE
       printf("sse    BER    :    %g\t%u errors\n", (float)errors_sse / (frame_cnt * frame_length), errors_sse);
 #endif
     }
   }
+  printf("Single decoder: %.1f Mbps; Batch decoder (%d frames): %.1f Mbps; Mismatched bits: %d\n",
+         t_single_us ? (double)snr_points * nof_frames * frame_length / t_single_us : 0.0,
+         batch_size,
+         t_batch_us ? (double)snr_points * nof_frames * frame_length / t_batch_us : 0.0,
+         mismatch);
+
   srsran_viterbi_free(&dec);
 #ifdef TEST_SSE
   srsran_viterbi_free(&dec_sse);
@@ -287,6 +374,10 @@ int main(int argc, char** argv)
   free(llr_s);
   free(llr_us);
   free(data_rx);
+  for (uint32_t i = 0; i < batch_size; i++) {
+    free(llr_batch[i]);
+    free(data_batch[i]);
+  }
 
   if (snr_points == 1) {
     int expected_e = get_expected_errors(nof_frames, seed, frame_length, tail_biting, ebno_db);
@@ -302,11 +393,13 @@ int main(int argc, char** argv)
       passed &= (bool)(errors_c <= expected_e);
       passed &= (bool)(errors_f <= expected_e);
       passed &= (bool)(errors_sse <= expected_e);
+      passed &= (bool)(errors_batch <= expected_e);
+      passed &= (bool)(mismatch == 0);
       exit(!passed);
     }
   } else {
     printf("\n");
     printf("Done\n");
-    exit(0);
+    exit(mismatch != 0);
   }
 }
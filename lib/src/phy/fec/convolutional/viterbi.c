@@ -469,6 +469,80 @@ int init37_avx2_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool
   }
 }
 
+#ifdef LV_HAVE_AVX512
+int decode37_avx512_batch(void* o, uint16_t** symbols, uint8_t** data, uint32_t nof_frames, uint32_t frame_length)
+{
+  srsran_viterbi_t* q = o;
+
+  uint32_t best_state[SRSRAN_VITERBI_MAX_BATCH] = {};
+
+  if (frame_length > q->framebits) {
+    fprintf(stderr, "Initialized decoder for max frame length %d bits\n", q->framebits);
+    return -1;
+  }
+
+  /* Initialize Viterbi decoder. The AVX2 decoder clears the start state bias, do the same to give the same output */
+  init_viterbi37_avx512(q->ptr_batch, -1);
+
+  /* Decode blocks, the symbols of tail-biting frames are read cyclically instead of being replicated */
+  if (q->tail_biting) {
+    if (update_viterbi37_blk_avx512(
+            q->ptr_batch, symbols, nof_frames, frame_length, TB_ITER * frame_length, best_state) < 0 ||
+        chainback_viterbi37_avx512(q->ptr_batch,
+                                   data,
+                                   nof_frames,
+                                   TB_ITER * frame_length,
+                                   ((int)(TB_ITER / 2)) * frame_length,
+                                   frame_length,
+                                   best_state) < 0) {
+      return -1;
+    }
+  } else {
+    uint32_t nbits = frame_length + q->K - 1;
+    if (update_viterbi37_blk_avx512(q->ptr_batch, symbols, nof_frames, nbits, nbits, NULL) < 0 ||
+        chainback_viterbi37_avx512(q->ptr_batch, data, nof_frames, frame_length, 0, frame_length, best_state) < 0) {
+      return -1;
+    }
+  }
+
+  return q->framebits;
+}
+
+void free37_avx512(void* o)
+{
+  srsran_viterbi_t* q = o;
+  if (q->symbols_us_batch) {
+    free(q->symbols_us_batch);
+  }
+  delete_viterbi37_avx512(q->ptr_batch);
+  free37_avx2_16bit(o);
+}
+
+int init37_avx512(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool tail_biting)
+{
+  // Single frames are decoded by the 16-bit AVX2 decoder, which gives the same output as the batch decoder
+  if (init37_avx2_16bit(q, poly, framebits, tail_biting)) {
+    return -1;
+  }
+  q->decode_s_batch   = decode37_avx512_batch;
+  q->free             = free37_avx512;
+  q->symbols_us_batch = srsran_vec_u16_malloc(SRSRAN_VITERBI_MAX_BATCH * 3 * (q->framebits + q->K - 1));
+  if (!q->symbols_us_batch) {
+    perror("malloc");
+    free37_avx512(q);
+    return -1;
+  }
+
+  if ((q->ptr_batch = create_viterbi37_avx512(poly, TB_ITER * framebits)) == NULL) {
+    ERROR("create_viterbi37_avx512 failed");
+    free37_avx512(q);
+    return -1;
+  } else {
+    return 0;
+  }
+}
+#endif
+
 #endif
 
 void srsran_viterbi_set_gain_quant(srsran_viterbi_t* q, float gain_quant)
@@ -494,7 +568,11 @@ int srsran_viterbi_init(srsran_viterbi_t*     q,
 
 #ifdef LV_HAVE_AVX2
 #ifdef VITERBI_16
+#ifdef LV_HAVE_AVX512
+      return init37_avx512(q, poly, max_frame_length, tail_bitting);
+#else
       return init37_avx2_16bit(q, poly, max_frame_length, tail_bitting);
+#endif
 #else
       return init37_avx2(q, poly, max_frame_length, tail_bitting);
 #endif
@@ -536,6 +614,18 @@ int srsran_viterbi_init_avx2(srsran_viterbi_t*     q,
 }
 #endif
 
+#ifdef LV_HAVE_AVX512
+int srsran_viterbi_init_avx512(srsran_viterbi_t*     q,
+                               srsran_viterbi_type_t type,
+                               int                   poly[3],
+                               uint32_t              max_frame_length,
+                               bool                  tail_bitting)
+{
+  bzero(q, sizeof(srsran_viterbi_t));
+  return init37_avx512(q, poly, max_frame_length, tail_bitting);
+}
+#endif
+
 void srsran_viterbi_free(srsran_viterbi_t* q)
 {
   if (q->free) {
@@ -544,6 +634,18 @@ void srsran_viterbi_free(srsran_viterbi_t* q)
   bzero(q, sizeof(srsran_viterbi_t));
 }
 
+#ifdef VITERBI_16
+static void viterbi_quant_f_us(srsran_viterbi_t* q, float* symbols, uint16_t* symbols_us, uint32_t len)
+{
+  float    max   = 1e-9;
+  uint32_t max_i = srsran_vec_max_abs_fi(symbols, len);
+  if (max_i < len && isnormal(symbols[max_i])) {
+    max = fabsf(symbols[max_i]);
+  }
+  srsran_vec_quant_fus(symbols, symbols_us, q->gain_quant / max, 32767.5, 65535, len);
+}
+#endif
+
 /* symbols are real-valued */
 int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data, uint32_t frame_length)
 {
@@ -625,3 +727,74 @@ int srsran_viterbi_decode_uc(srsran_viterbi_t* q, uint8_t* symbols, uint8_t* dat
 
   return ret;
 }
+
+int srsran_viterbi_decode_us_batch(srsran_viterbi_t* q,
+                                   uint16_t**        symbols,
+                                   uint8_t**         data,
+                                   uint32_t          nof_frames,
+                                   uint32_t          frame_length)
+{
+  if (q == NULL || symbols == NULL || data == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < nof_frames; i += SRSRAN_VITERBI_MAX_BATCH) {
+    uint32_t n = SRSRAN_MIN(SRSRAN_VITERBI_MAX_BATCH, nof_frames - i);
+    if (q->decode_s_batch) {
+      if (q->decode_s_batch(q, &symbols[i], &data[i], n, frame_length) < 0) {
+        return SRSRAN_ERROR;
+      }
+    } else {
+      for (uint32_t j = i; j < i + n; j++) {
+        if (srsran_viterbi_decode_us(q, symbols[j], data[j], frame_length) < 0) {
+          return SRSRAN_ERROR;
+        }
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_viterbi_decode_f_batch(srsran_viterbi_t* q,
+                                  float**           symbols,
+                                  uint8_t**         data,
+                                  uint32_t          nof_frames,
+                                  uint32_t          frame_length)
+{
+  if (q == NULL || symbols == NULL || data == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+#ifdef VITERBI_16
+  if (q->decode_s_batch && !q->decode_f) {
+    if (frame_length > q->framebits) {
+      ERROR("Initialized decoder for max frame length %d bits", q->framebits);
+      return SRSRAN_ERROR;
+    }
+    uint32_t len    = q->tail_biting ? 3 * frame_length : 3 * (frame_length + q->K - 1);
+    uint32_t stride = 3 * (q->framebits + q->K - 1);
+
+    uint16_t* symbols_us[SRSRAN_VITERBI_MAX_BATCH];
+    for (uint32_t i = 0; i < nof_frames; i += SRSRAN_VITERBI_MAX_BATCH) {
+      uint32_t n = SRSRAN_MIN(SRSRAN_VITERBI_MAX_BATCH, nof_frames - i);
+      for (uint32_t j = 0; j < n; j++) {
+        symbols_us[j] = &q->symbols_us_batch[j * stride];
+        viterbi_quant_f_us(q, symbols[i + j], symbols_us[j], len);
+      }
+      if (q->decode_s_batch(q, symbols_us, &data[i], n, frame_length) < 0) {
+        return SRSRAN_ERROR;
+      }
+    }
+    return SRSRAN_SUCCESS;
+  }
+#endif
+
+  for (uint32_t i = 0; i < nof_frames; i++) {
+    if (srsran_viterbi_decode_f(q, symbols[i], data[i], frame_length) < 0) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
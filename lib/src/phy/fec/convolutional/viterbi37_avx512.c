@@ -0,0 +1,278 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file viterbi37_avx512.c
+ * \brief Definition of the r=1/3 K=7 Viterbi decoder that decodes several frames of the same length at once, using
+ * AVX512 instructions.
+ *
+ * Every 16-bit lane of a 512-bit register holds the path metric of one frame, so that the 64 states are updated for
+ * up to 32 frames with the same instructions. Branch and path metrics are computed exactly as in the 16-bit AVX2
+ * decoder, hence both decoders give the same output for the same quantized symbols. Since the comparisons use
+ * modulo arithmetic, the path metrics are never normalized.
+ *
+ */
+
+#include "parity.h"
+#include "viterbi37.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LV_HAVE_AVX512
+
+#include <immintrin.h>
+
+#define NOF_STATES 64
+#define NOF_LANES 32
+
+/* State info for instance of batch Viterbi decoder */
+struct v37_avx512 {
+  __m512i   metrics1[NOF_STATES];   /* path metric buffer 1 */
+  __m512i   metrics2[NOF_STATES];   /* path metric buffer 2 */
+  __m512i*  old_metrics;            /* Pointers to path metrics, swapped on every bit */
+  __m512i*  new_metrics;
+  __m512i*  syms;                   /* Interleaved symbols, three vectors per bit */
+  uint32_t* decisions;              /* One decision word per bit and state, one bit per frame */
+  uint8_t   branch[NOF_STATES / 2]; /* Expected output bits of every butterfly */
+  uint32_t  len;                    /* Maximum number of bits */
+  uint32_t  nof_bits;               /* Number of bits processed since the last init */
+};
+
+/* Create a new instance of a batch Viterbi decoder */
+void* create_viterbi37_avx512(int polys[3], uint32_t len)
+{
+  void* p;
+
+  if (posix_memalign(&p, sizeof(__m512i), sizeof(struct v37_avx512))) {
+    return NULL;
+  }
+  struct v37_avx512* vp = (struct v37_avx512*)p;
+  memset(vp, 0, sizeof(struct v37_avx512));
+
+  for (int state = 0; state < NOF_STATES / 2; state++) {
+    for (int i = 0; i < 3; i++) {
+      vp->branch[state] |= (uint8_t)(((polys[i] < 0) ^ parity((2 * state) & polys[i])) << i);
+    }
+  }
+
+  /* The decisions of the last 6 bits are read by the chainback but never written */
+  vp->len = len + 6;
+  if (posix_memalign(&p, sizeof(__m512i), vp->len * NOF_STATES * sizeof(uint32_t))) {
+    free(vp);
+    return NULL;
+  }
+  vp->decisions = (uint32_t*)p;
+
+  if (posix_memalign(&p, sizeof(__m512i), 3 * vp->len * sizeof(__m512i))) {
+    free(vp->decisions);
+    free(vp);
+    return NULL;
+  }
+  vp->syms = (__m512i*)p;
+
+  return vp;
+}
+
+/* Initialize Viterbi decoder for start of new frames */
+int init_viterbi37_avx512(void* p, int starting_state)
+{
+  struct v37_avx512* vp = p;
+
+  if (p == NULL) {
+    return -1;
+  }
+
+  for (uint32_t i = 0; i < NOF_STATES; i++) {
+    vp->metrics1[i] = _mm512_set1_epi16(63);
+  }
+  if (starting_state != -1) {
+    vp->metrics1[starting_state & 63] = _mm512_setzero_si512(); /* Bias known start state */
+  }
+  vp->old_metrics = vp->metrics1;
+  vp->new_metrics = vp->metrics2;
+  vp->nof_bits    = 0;
+
+  return 0;
+}
+
+/* Decode nbits bits of nof_frames frames. The symbols of every frame are read cyclically, with a period of frame_bits
+ * bits, which allows decoding tail-biting codes without replicating the input */
+int update_viterbi37_blk_avx512(void*      p,
+                                uint16_t** syms,
+                                uint32_t   nof_frames,
+                                uint32_t   frame_bits,
+                                uint32_t   nbits,
+                                uint32_t*  best_state)
+{
+  struct v37_avx512* vp = p;
+
+  if (p == NULL || nof_frames == 0 || nof_frames > NOF_LANES || frame_bits == 0 ||
+      vp->nof_bits + nbits + 6 > vp->len || frame_bits > vp->len) {
+    return -1;
+  }
+
+  /* Interleave the symbols, so that the same symbol of all the frames lies in a single vector */
+  uint16_t* s = (uint16_t*)vp->syms;
+  memset(s, 0, 3 * frame_bits * sizeof(__m512i));
+  for (uint32_t i = 0; i < nof_frames; i++) {
+    for (uint32_t j = 0; j < 3 * frame_bits; j++) {
+      s[j * NOF_LANES + i] = syms[i][j];
+    }
+  }
+
+  /* All the decisions are written below except the ones of the 6 bits after the last one */
+  uint32_t* d = &vp->decisions[vp->nof_bits * NOF_STATES];
+  memset(d + nbits * NOF_STATES, 0, 6 * NOF_STATES * sizeof(uint32_t));
+
+  const __m512i ones    = _mm512_set1_epi16(-1);
+  const __m512i max_bm  = _mm512_set1_epi16(8191);
+  const __m512i zero    = _mm512_setzero_si512();
+  uint32_t      sym_bit = 0;
+  __m512i       metric[8], m_metric[8];
+
+  /* Local copies, as the vector stores could otherwise alias them */
+  __m512i* old_metrics = vp->old_metrics;
+  __m512i* new_metrics = vp->new_metrics;
+  uint8_t  branch[NOF_STATES / 2];
+  memcpy(branch, vp->branch, sizeof(branch));
+
+  for (uint32_t n = 0; n < nbits; n++) {
+    __m512i sym0v = vp->syms[3 * sym_bit];
+    __m512i sym1v = vp->syms[3 * sym_bit + 1];
+    __m512i sym2v = vp->syms[3 * sym_bit + 2];
+    if (++sym_bit == frame_bits) {
+      sym_bit = 0;
+    }
+
+    /* Form the branch metrics of the 8 possible outputs */
+    __m512i nsym2v = _mm512_xor_si512(sym2v, ones);
+    for (uint32_t b = 0; b < 4; b++) {
+      __m512i m01 = _mm512_avg_epu16((b & 1) ? _mm512_xor_si512(sym0v, ones) : sym0v,
+                                     (b & 2) ? _mm512_xor_si512(sym1v, ones) : sym1v);
+      metric[b]     = _mm512_srli_epi16(_mm512_avg_epu16(sym2v, m01), 3);
+      metric[b + 4] = _mm512_srli_epi16(_mm512_avg_epu16(nsym2v, m01), 3);
+    }
+    for (uint32_t b = 0; b < 8; b++) {
+      m_metric[b] = _mm512_sub_epi16(max_bm, metric[b]);
+    }
+
+    for (uint32_t i = 0; i < NOF_STATES / 2; i++) {
+      __m512i bm  = metric[branch[i]];
+      __m512i mbm = m_metric[branch[i]];
+
+      /* Add branch metrics to path metrics */
+      __m512i m0 = _mm512_add_epi16(old_metrics[i], bm);
+      __m512i m1 = _mm512_add_epi16(old_metrics[i + 32], mbm);
+      __m512i m2 = _mm512_add_epi16(old_metrics[i], mbm);
+      __m512i m3 = _mm512_add_epi16(old_metrics[i + 32], bm);
+
+      /* Compare and select, using modulo arithmetic */
+      __mmask32 decision0 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(m0, m1), zero);
+      __mmask32 decision1 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(m2, m3), zero);
+
+      new_metrics[2 * i]     = _mm512_mask_blend_epi16(decision0, m0, m1);
+      new_metrics[2 * i + 1] = _mm512_mask_blend_epi16(decision1, m2, m3);
+      d[2 * i]               = (uint32_t)decision0;
+      d[2 * i + 1]           = (uint32_t)decision1;
+    }
+    d += NOF_STATES;
+
+    /* Swap pointers to old and new metrics */
+    __m512i* tmp = old_metrics;
+    old_metrics  = new_metrics;
+    new_metrics  = tmp;
+  }
+  vp->old_metrics = old_metrics;
+  vp->new_metrics = new_metrics;
+  vp->nof_bits += nbits;
+
+  if (best_state) {
+    /* The metrics are not normalized, so they are compared relative to the metric of state 0 */
+    __m512i min_metric = _mm512_set1_epi16(INT16_MAX);
+    __m512i min_state  = zero;
+    for (uint32_t i = 0; i < NOF_STATES; i++) {
+      __m512i   diff = _mm512_sub_epi16(old_metrics[i], old_metrics[0]);
+      __mmask32 mask = _mm512_cmple_epi16_mask(diff, min_metric);
+      min_metric     = _mm512_mask_blend_epi16(mask, min_metric, diff);
+      min_state      = _mm512_mask_blend_epi16(mask, min_state, _mm512_set1_epi16((int16_t)i));
+    }
+
+    uint16_t states[NOF_LANES];
+    _mm512_storeu_si512(states, min_state);
+    for (uint32_t i = 0; i < nof_frames; i++) {
+      best_state[i] = states[i];
+    }
+  }
+
+  return 0;
+}
+
+/* Viterbi chainback, only the bits [offset, offset + len) of every frame are written in data */
+int chainback_viterbi37_avx512(void*           p,
+                               uint8_t**       data,
+                               uint32_t        nof_frames,
+                               uint32_t        nbits,
+                               uint32_t        offset,
+                               uint32_t        len,
+                               const uint32_t* endstate)
+{
+  struct v37_avx512* vp = p;
+
+  if (p == NULL || nof_frames > NOF_LANES || nbits > vp->nof_bits || offset + len > nbits) {
+    return -1;
+  }
+
+  /* Look past tail, the decisions after the last processed bit are zero */
+  const uint32_t* d = &vp->decisions[6 * NOF_STATES];
+
+  /* The frames are traced back together, so that the loads of different frames can overlap */
+  uint32_t state[NOF_LANES];
+  for (uint32_t i = 0; i < nof_frames; i++) {
+    state[i] = endstate[i] % NOF_STATES;
+  }
+  for (uint32_t n = nbits; n-- > offset;) {
+    const uint32_t* dn = &d[n * NOF_STATES];
+    for (uint32_t i = 0; i < nof_frames; i++) {
+      uint32_t k = (dn[state[i]] >> i) & 1U;
+      state[i]   = (state[i] >> 1U) | (k << 5U);
+      if (n < offset + len) {
+        data[i][n - offset] = (uint8_t)k;
+      }
+    }
+  }
+
+  return 0;
+}
+
+/* Delete instance of a batch Viterbi decoder */
+void delete_viterbi37_avx512(void* p)
+{
+  struct v37_avx512* vp = p;
+
+  if (vp != NULL) {
+    free(vp->syms);
+    free(vp->decisions);
+    free(vp);
+  }
+}
+
+#endif // LV_HAVE_AVX512
@@ -41,6 +41,42 @@
 
 #define LDPC_DECODER_DEFAULT_MAX_NOF_ITER 10 /*!< \brief Default maximum number of iterations of the BP algorithm. */
 
+/*!
+ * Checks whether the hard decisions stored in q->hard_bits satisfy the first n_layers (lifted) parity checks.
+ * Each check node accumulates the circularly shifted hard bits of its variable nodes with vector XOR operations.
+ * \param[in] q        A pointer to the LDPC decoder.
+ * \param[in] n_layers The number of layers (check nodes in the base graph) to verify.
+ * \return True if all the parity checks are satisfied, false otherwise.
+ */
+static bool check_syndrome(srsran_ldpc_decoder_t* q, uint8_t n_layers)
+{
+  uint16_t ls = q->ls;
+
+  for (uint8_t i_layer = 0; i_layer < n_layers; i_layer++) {
+    const uint16_t* this_pcm          = q->pcm + i_layer * q->bgN;
+    const int8_t*   these_var_indices = q->var_indices[i_layer];
+
+    srsran_vec_u8_zero(q->syndrome, ls);
+
+    for (int i = 0; (i < MAX_CNCT) && (these_var_indices[i] != -1); i++) {
+      uint16_t       shift = this_pcm[these_var_indices[i]];
+      const uint8_t* bits  = q->hard_bits + these_var_indices[i] * ls;
+
+      // Check node j is connected to bit (j + shift) mod ls of the variable node
+      srsran_vec_xor_bbb(q->syndrome, bits + shift, q->syndrome, ls - shift);
+      srsran_vec_xor_bbb(q->syndrome + ls - shift, bits, q->syndrome + ls - shift, shift);
+    }
+
+    for (uint16_t j = 0; j < ls; j++) {
+      if (q->syndrome[j] != 0) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 #define LDPC_DECODER_TEMPLATE(LLR_TYPE, SUFFIX)                                                                        \
   static int decode_##SUFFIX(                                                                                          \
       void* o, const LLR_TYPE* llrs, uint8_t* message, uint32_t cdwd_rm_length, srsran_crc_t* crc)                     \
@@ -90,6 +126,14 @@
         if (srsran_crc_match(crc, message, q->liftK - crc->order)) {                                                   \
           return i_iteration + 1;                                                                                      \
         }                                                                                                              \
+      } else if (q->syndrome_check) {                                                                                  \
+        /* Without CRC, stop as soon as the hard decisions form a valid codeword */                                    \
+        extract_ldpc_message_##SUFFIX(q->ptr, q->hard_bits, (q->bgK + n_layers) * q->ls);                              \
+                                                                                                                       \
+        if (check_syndrome(q, n_layers)) {                                                                             \
+          srsran_vec_u8_copy(message, q->hard_bits, q->liftK);                                                         \
+          return i_iteration + 1;                                                                                      \
+        }                                                                                                              \
       }                                                                                                                \
     }                                                                                                                  \
                                                                                                                        \
@@ -153,6 +197,14 @@
         if (srsran_crc_match(crc, message, q->liftK - crc->order)) {                                                   \
           return i_iteration + 1;                                                                                      \
         }                                                                                                              \
+      } else if (q->syndrome_check) {                                                                                  \
+        /* Without CRC, stop as soon as the hard decisions form a valid codeword */                                    \
+        extract_ldpc_message_##SUFFIX(q->ptr, q->hard_bits, (q->bgK + n_layers) * q->ls);                              \
+                                                                                                                       \
+        if (check_syndrome(q, n_layers)) {                                                                             \
+          srsran_vec_u8_copy(message, q->hard_bits, q->liftK);                                                         \
+          return i_iteration + 1;                                                                                      \
+        }                                                                                                              \
       }                                                                                                                \
     }                                                                                                                  \
                                                                                                                        \
@@ -537,6 +589,48 @@ static int init_c_avx512long_flood(srsran_ldpc_decoder_t* q)
 
 #endif // LV_HAVE_AVX512
 
+/*! Initializes the decoder registers and functions of the given decoder type. */
+static int init_type(srsran_ldpc_decoder_t* q, srsran_ldpc_decoder_type_t type)
+{
+  switch (type) {
+    case SRSRAN_LDPC_DECODER_F:
+      return init_f(q);
+    case SRSRAN_LDPC_DECODER_S:
+      return init_s(q);
+    case SRSRAN_LDPC_DECODER_C:
+      return init_c(q);
+    case SRSRAN_LDPC_DECODER_C_FLOOD:
+      return init_c_flood(q);
+#ifdef LV_HAVE_AVX2
+    case SRSRAN_LDPC_DECODER_C_AVX2:
+      if (q->ls <= SRSRAN_AVX2_B_SIZE) {
+        return init_c_avx2(q);
+      } else {
+        return init_c_avx2long(q);
+      }
+    case SRSRAN_LDPC_DECODER_C_AVX2_FLOOD:
+      if (q->ls <= SRSRAN_AVX2_B_SIZE) {
+        return init_c_avx2_flood(q);
+      } else {
+        return init_c_avx2long_flood(q);
+      }
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_AVX512
+    case SRSRAN_LDPC_DECODER_C_AVX512:
+      if (q->ls <= SRSRAN_AVX512_B_SIZE) {
+        return init_c_avx512(q);
+      } else {
+        return init_c_avx512long(q);
+      }
+    case SRSRAN_LDPC_DECODER_C_AVX512_FLOOD:
+      return init_c_avx512long_flood(q);
+#endif // LV_HAVE_AVX2
+    default:
+      ERROR("Unknown decoder.");
+      return -1;
+  }
+}
+
 int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder_args_t* args)
 {
   if (q == NULL || args == NULL) {
@@ -606,44 +700,27 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
   }
   q->scaling_fctr = scaling_fctr;
 
-  switch (type) {
-    case SRSRAN_LDPC_DECODER_F:
-      return init_f(q);
-    case SRSRAN_LDPC_DECODER_S:
-      return init_s(q);
-    case SRSRAN_LDPC_DECODER_C:
-      return init_c(q);
-    case SRSRAN_LDPC_DECODER_C_FLOOD:
-      return init_c_flood(q);
-#ifdef LV_HAVE_AVX2
-    case SRSRAN_LDPC_DECODER_C_AVX2:
-      if (ls <= SRSRAN_AVX2_B_SIZE) {
-        return init_c_avx2(q);
-      } else {
-        return init_c_avx2long(q);
-      }
-    case SRSRAN_LDPC_DECODER_C_AVX2_FLOOD:
-      if (ls <= SRSRAN_AVX2_B_SIZE) {
-        return init_c_avx2_flood(q);
-      } else {
-        return init_c_avx2long_flood(q);
-      }
-#endif // LV_HAVE_AVX2
-#ifdef LV_HAVE_AVX512
-    case SRSRAN_LDPC_DECODER_C_AVX512:
-      if (ls <= SRSRAN_AVX512_B_SIZE) {
-        return init_c_avx512(q);
-      } else {
-        return init_c_avx512long(q);
-      }
-    case SRSRAN_LDPC_DECODER_C_AVX512_FLOOD:
-      return init_c_avx512long_flood(q);
-#endif // LV_HAVE_AVX2
+  q->syndrome_check = !args->disable_syndrome_check;
+  q->hard_bits      = srsran_vec_u8_malloc(q->liftN);
+  q->syndrome       = srsran_vec_u8_malloc(q->ls);
+  if (!q->hard_bits || !q->syndrome) {
+    perror("malloc");
+    free(q->syndrome);
+    free(q->hard_bits);
+    free(q->var_indices);
+    free(q->pcm);
+    return -1;
+  }
 
-    default:
-      ERROR("Unknown decoder.");
-      return -1;
+  if (init_type(q, type) < 0) {
+    free(q->syndrome);
+    free(q->hard_bits);
+    q->syndrome  = NULL;
+    q->hard_bits = NULL;
+    return -1;
   }
+
+  return 0;
 }
 
 void srsran_ldpc_decoder_free(srsran_ldpc_decoder_t* q)
@@ -651,6 +728,12 @@ void srsran_ldpc_decoder_free(srsran_ldpc_decoder_t* q)
   if (q->free) {
     q->free(q);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
+  if (q->syndrome) {
+    free(q->syndrome);
+  }
   bzero(q, sizeof(srsran_ldpc_decoder_t));
 }
 
@@ -25,7 +25,8 @@
  *
  * It decodes a batch of example codewords and compares the resulting messages
  * with the expected ones. Reference messages and codewords are provided in
- * files **examplesBG1.dat** and **examplesBG2.dat**.
+ * files **examplesBG1.dat** and **examplesBG2.dat**. The batch is decoded twice,
+ * with and without the syndrome-based early stop, to compare the throughput.
  *
  * Synopsis: **ldpc_dec_test [options]**
  *
@@ -162,6 +163,14 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  // create an LDPC decoder that always runs the maximum number of iterations
+  decoder_args.disable_syndrome_check = true;
+  srsran_ldpc_decoder_t decoder_fixed;
+  if (srsran_ldpc_decoder_init(&decoder_fixed, &decoder_args) != 0) {
+    perror("decoder init");
+    exit(-1);
+  }
+
   printf("Test LDPC decoder:\n");
   printf("  Base Graph      -> BG%d\n", decoder.bg + 1);
   printf("  Lifting Size    -> %d\n", decoder.ls);
@@ -200,16 +209,39 @@ int main(int argc, char** argv)
     symbols[i] = codewords[i] == 1 ? -50 : 50;
   }
 
-  printf("\nDecoding test messages...\n");
+  printf("\nDecoding test messages (fixed iterations)...\n");
   struct timeval t[3];
   gettimeofday(&t[1], NULL);
   for (j = 0; j < NOF_MESSAGES; j++) {
-    printf("  codeword %d\n", j);
-    srsran_ldpc_decoder_decode_f(&decoder, symbols + j * finalN, messages_sim + j * finalK, finalN);
+    srsran_ldpc_decoder_decode_f(&decoder_fixed, symbols + j * finalN, messages_sim + j * finalK, finalN);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double elapsed_time_fixed = t[0].tv_sec + 1e-6 * t[0].tv_usec;
+  printf("Elapsed time: %e s\n", elapsed_time_fixed);
+
+  printf("\nVerifing results...\n");
+  for (i = 0; i < NOF_MESSAGES * finalK; i++) {
+    if ((1U & messages_sim[i]) != (1U & messages_true[i])) {
+      perror("wrong!!");
+      exit(-1);
+    }
+  }
+
+  printf("\nDecoding test messages (early stop)...\n");
+  int nof_iter[NOF_MESSAGES];
+  int nof_iter_sum = 0;
+  gettimeofday(&t[1], NULL);
+  for (j = 0; j < NOF_MESSAGES; j++) {
+    nof_iter[j] = srsran_ldpc_decoder_decode_f(&decoder, symbols + j * finalN, messages_sim + j * finalK, finalN);
   }
   gettimeofday(&t[2], NULL);
   get_time_interval(t);
   double elapsed_time = t[0].tv_sec + 1e-6 * t[0].tv_usec;
+  for (j = 0; j < NOF_MESSAGES; j++) {
+    printf("  codeword %d: %d iterations\n", j, nof_iter[j]);
+    nof_iter_sum += nof_iter[j];
+  }
   printf("Elapsed time: %e s\n", elapsed_time);
 
   printf("\nVerifing results...\n");
@@ -220,7 +252,15 @@ int main(int argc, char** argv)
     }
   }
 
-  printf("Estimated throughput:\n  %e word/s\n  %e bit/s (information)\n  %e bit/s (encoded)\n",
+  printf("Estimated throughput (fixed %d iterations):\n  %e word/s\n  %e bit/s (information)\n  %e bit/s (encoded)\n",
+         decoder_fixed.max_nof_iter,
+         NOF_MESSAGES / elapsed_time_fixed,
+         NOF_MESSAGES * finalK / elapsed_time_fixed,
+         NOF_MESSAGES * finalN / elapsed_time_fixed);
+
+  printf("Estimated throughput (early stop, %.1f iterations on average):\n  %e word/s\n  %e bit/s "
+         "(information)\n  %e bit/s (encoded)\n",
+         (float)nof_iter_sum / NOF_MESSAGES,
          NOF_MESSAGES / elapsed_time,
          NOF_MESSAGES * finalK / elapsed_time,
          NOF_MESSAGES * finalN / elapsed_time);
@@ -231,5 +271,6 @@ int main(int argc, char** argv)
   free(codewords);
   free(messages_sim);
   free(messages_true);
+  srsran_ldpc_decoder_free(&decoder_fixed);
   srsran_ldpc_decoder_free(&decoder);
 }
@@ -39,10 +39,12 @@
 
 #include "polar_decoder_ssc_c.h"
 #include "polar_decoder_ssc_c_avx2.h"
+#include "polar_decoder_ssc_c_batch.h"
 #include "polar_decoder_ssc_f.h"
 #include "polar_decoder_ssc_s.h"
 #include "srsran/phy/fec/polar/polar_decoder.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
 
 /*! SSC Polar decoder with float LLR inputs. */
 static int decode_ssc_f(void*           o,
@@ -114,6 +116,31 @@ static int decode_ssc_c_avx2(void*           o,
 }
 #endif // LV_HAVE_AVX2
 
+/*! SSC Polar decoder of a batch of codewords with int8_t LLR inputs. */
+static int decode_ssc_c_batch(void*                o,
+                              const int8_t* const* symbols,
+                              uint8_t* const*      data,
+                              const uint32_t       nof_codewords,
+                              const uint8_t        n,
+                              const uint16_t*      frozen_set,
+                              const uint16_t       frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  return polar_decoder_ssc_c_batch(q->ptr, symbols, data, nof_codewords, n, frozen_set, frozen_set_size);
+}
+
+/*! Batch SSC Polar decoder used to decode a single codeword. */
+static int decode_ssc_c_batch_single(void*           o,
+                                     const int8_t*   symbols,
+                                     uint8_t*        data,
+                                     const uint8_t   n,
+                                     const uint16_t* frozen_set,
+                                     const uint16_t  frozen_set_size)
+{
+  return decode_ssc_c_batch(o, &symbols, &data, 1, n, frozen_set, frozen_set_size);
+}
+
 /*! Destructor of a (float) SSC polar decoder. */
 static void free_ssc_f(void* o)
 {
@@ -144,6 +171,13 @@ static void free_ssc_c_avx2(void* o)
 }
 #endif
 
+/*! Destructor of a (int8_t, batch) SSC polar decoder. */
+static void free_ssc_c_batch(void* o)
+{
+  srsran_polar_decoder_t* q = o;
+  delete_polar_decoder_ssc_c_batch(q->ptr);
+}
+
 /*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with float LLR inputs. */
 static int init_ssc_f(srsran_polar_decoder_t* q)
 {
@@ -203,8 +237,25 @@ static int init_ssc_c_avx2(srsran_polar_decoder_t* q)
 }
 #endif
 
+/*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with uint8_t LLR inputs on a batch of
+ * codewords. */
+static int init_ssc_c_batch(srsran_polar_decoder_t* q)
+{
+  q->decode_c       = decode_ssc_c_batch_single;
+  q->decode_c_batch = decode_ssc_c_batch;
+  q->free           = free_ssc_c_batch;
+
+  if ((q->ptr = create_polar_decoder_ssc_c_batch(q->nMax)) == NULL) {
+    ERROR("create_polar_decoder_ssc_c_batch failed");
+    free_ssc_c_batch(q);
+    return -1;
+  }
+  return 0;
+}
+
 int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_type_t type, const uint8_t nMax)
 {
+  memset(q, 0, sizeof(srsran_polar_decoder_t));
   q->nMax = nMax;
   switch (type) {
     case SRSRAN_POLAR_DECODER_SSC_F:
@@ -217,6 +268,8 @@ int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_ty
     case SRSRAN_POLAR_DECODER_SSC_C_AVX2:
       return init_ssc_c_avx2(q);
 #endif
+    case SRSRAN_POLAR_DECODER_SSC_C_BATCH:
+      return init_ssc_c_batch(q);
     default:
       ERROR("Decoder not implemented");
       return -1;
@@ -273,3 +326,35 @@ int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
 
   return -1;
 }
+
+int srsran_polar_decoder_decode_c_batch(srsran_polar_decoder_t* q,
+                                        const int8_t* const*    llr,
+                                        uint8_t* const*         data_decoded,
+                                        const uint32_t          nof_codewords,
+                                        const uint8_t           n,
+                                        const uint16_t*         frozen_set,
+                                        const uint16_t          frozen_set_size)
+{
+  if (q->nMax < n || q->decode_c == NULL) {
+    return -1;
+  }
+
+  // Decoders without batch support decode one codeword at a time
+  if (q->decode_c_batch == NULL) {
+    for (uint32_t i = 0; i < nof_codewords; i++) {
+      if (q->decode_c(q, llr[i], data_decoded[i], n, frozen_set, frozen_set_size) < 0) {
+        return -1;
+      }
+    }
+    return 0;
+  }
+
+  for (uint32_t i = 0; i < nof_codewords; i += SRSRAN_POLAR_DECODER_MAX_BATCH) {
+    uint32_t count = SRSRAN_MIN(nof_codewords - i, SRSRAN_POLAR_DECODER_MAX_BATCH);
+    if (q->decode_c_batch(q, llr + i, data_decoded + i, count, n, frozen_set, frozen_set_size) < 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,339 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_ssc_c_batch.c
+ * \brief Definition of the SSC polar decoder inner functions decoding a batch of codewords with 8-bit
+ * integer-valued LLRs, one codeword per SIMD lane.
+ *
+ * All the codewords of a batch share the code size and the frozen set, so they share the decoding tree as well. The
+ * LLRs are stored with the codeword index as the fastest varying dimension (i.e. a row of
+ * SRSRAN_POLAR_DECODER_MAX_BATCH bytes per codeword bit), so that every function-f, function-g, hard decision and
+ * partial-sum XOR of the SSC algorithm processes all the codewords at once. Rows are contiguous, so nodes with two or
+ * more bits are processed with AVX-512 instructions when available, and AVX2 instructions otherwise.
+ *
+ * Estimated bits are stored as 0 or -1 (all bits set) so that they can be used directly as a sign mask.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#include "polar_decoder_ssc_c_batch.h"
+#include "../utils_avx2.h"
+#include "../utils_avx512.h"
+#include "srsran/phy/fec/polar/polar_decoder.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+#if defined(LV_HAVE_AVX2) || defined(LV_HAVE_AVX512)
+#include <immintrin.h>
+#endif
+
+/*!
+ * Number of bytes of a row, one per codeword.
+ */
+#define ROW_SIZE SRSRAN_POLAR_DECODER_MAX_BATCH
+
+/*!
+ * \brief Describes a batch SSC polar decoder (8-bit version).
+ */
+struct pSSC_c_batch {
+  uint8_t   nMax;          /*!< \brief Maximum \f$log_2\f$ of the code size. */
+  int8_t**  llr;           /*!< \brief Pointers to the LLRs of every stage, \f$2^s\f$ rows for stage \f$s\f$. */
+  uint8_t*  est_bit;       /*!< \brief Estimated bits (partial sums), one row per codeword bit. */
+  uint8_t*  message;       /*!< \brief Decoded message, one row per codeword bit. */
+  uint8_t** node_type;     /*!< \brief Node type at every stage of the decoding tree. */
+  void*     tmp_node_type; /*!< \brief Pointer to a Tmp_node_type. */
+};
+
+/*!
+ * Computes \f$ z = sign(x) \times sign(y) \times \min(abs(x), abs(y)) \f$ elementwise.
+ */
+static void batch_function_f(const int8_t* x, const int8_t* y, int8_t* z, uint32_t len)
+{
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX512
+  for (; i + SRSRAN_AVX512_B_SIZE <= len; i += SRSRAN_AVX512_B_SIZE) {
+    __m512i   m_x    = _mm512_loadu_si512((__m512i*)&x[i]);
+    __m512i   m_y    = _mm512_loadu_si512((__m512i*)&y[i]);
+    __mmask64 m_neg  = _mm512_movepi8_mask(_mm512_xor_si512(m_x, m_y));
+    __m512i   m_min  = _mm512_min_epi8(_mm512_abs_epi8(m_x), _mm512_abs_epi8(m_y));
+    __m512i   m_zero = _mm512_setzero_si512();
+    _mm512_storeu_si512((__m512i*)&z[i], _mm512_mask_sub_epi8(m_min, m_neg, m_zero, m_min));
+  }
+#endif // LV_HAVE_AVX512
+#ifdef LV_HAVE_AVX2
+  for (; i + SRSRAN_AVX2_B_SIZE <= len; i += SRSRAN_AVX2_B_SIZE) {
+    __m256i m_x    = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m256i m_y    = _mm256_loadu_si256((__m256i*)&y[i]);
+    __m256i m_sign = _mm256_or_si256(_mm256_xor_si256(m_x, m_y), _mm256_set1_epi8(1));
+    __m256i m_min  = _mm256_min_epi8(_mm256_abs_epi8(m_x), _mm256_abs_epi8(m_y));
+    _mm256_storeu_si256((__m256i*)&z[i], _mm256_sign_epi8(m_min, m_sign));
+  }
+#endif // LV_HAVE_AVX2
+  for (; i < len; i++) {
+    int8_t abs_x = (int8_t)abs(x[i]);
+    int8_t abs_y = (int8_t)abs(y[i]);
+    int8_t min   = abs_x < abs_y ? abs_x : abs_y;
+    z[i]         = ((x[i] ^ y[i]) < 0) ? (int8_t)-min : min;
+  }
+}
+
+/*!
+ * Returns \f$ z = y - x \f$ where \f$ b \f$ is set and \f$ z = y + x \f$ otherwise, saturated to \f$ \pm 127 \f$.
+ */
+static void batch_function_g(const uint8_t* b, const int8_t* x, const int8_t* y, int8_t* z, uint32_t len)
+{
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX512
+  for (; i + SRSRAN_AVX512_B_SIZE <= len; i += SRSRAN_AVX512_B_SIZE) {
+    __m512i   m_x  = _mm512_loadu_si512((__m512i*)&x[i]);
+    __m512i   m_y  = _mm512_loadu_si512((__m512i*)&y[i]);
+    __mmask64 m_b  = _mm512_movepi8_mask(_mm512_loadu_si512((__m512i*)&b[i]));
+    __m512i   m_sx = _mm512_mask_sub_epi8(m_x, m_b, _mm512_setzero_si512(), m_x);
+    __m512i   m_z  = _mm512_adds_epi8(m_sx, m_y);
+    _mm512_storeu_si512((__m512i*)&z[i], _mm512_max_epi8(m_z, _mm512_set1_epi8(-127)));
+  }
+#endif // LV_HAVE_AVX512
+#ifdef LV_HAVE_AVX2
+  for (; i + SRSRAN_AVX2_B_SIZE <= len; i += SRSRAN_AVX2_B_SIZE) {
+    __m256i m_x = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m256i m_y = _mm256_loadu_si256((__m256i*)&y[i]);
+    __m256i m_b = _mm256_or_si256(_mm256_loadu_si256((__m256i*)&b[i]), _mm256_set1_epi8(1));
+    __m256i m_z = _mm256_adds_epi8(_mm256_sign_epi8(m_x, m_b), m_y);
+    _mm256_storeu_si256((__m256i*)&z[i], _mm256_max_epi8(m_z, _mm256_set1_epi8(-127)));
+  }
+#endif // LV_HAVE_AVX2
+  for (; i < len; i++) {
+    int tmp = b[i] ? (int)y[i] - (int)x[i] : (int)y[i] + (int)x[i];
+    tmp     = tmp > 127 ? 127 : tmp;
+    tmp     = tmp < -127 ? -127 : tmp;
+    z[i]    = (int8_t)tmp;
+  }
+}
+
+/*!
+ * Sets \f$ z \f$ to -1 (all bits set) if \f$ x < 0 \f$ and to 0 otherwise.
+ */
+static void batch_hard_bit(const int8_t* x, uint8_t* z, uint32_t len)
+{
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX512
+  for (; i + SRSRAN_AVX512_B_SIZE <= len; i += SRSRAN_AVX512_B_SIZE) {
+    __m512i m_x = _mm512_loadu_si512((__m512i*)&x[i]);
+    _mm512_storeu_si512((__m512i*)&z[i], _mm512_movm_epi8(_mm512_movepi8_mask(m_x)));
+  }
+#endif // LV_HAVE_AVX512
+#ifdef LV_HAVE_AVX2
+  for (; i + SRSRAN_AVX2_B_SIZE <= len; i += SRSRAN_AVX2_B_SIZE) {
+    __m256i m_x = _mm256_loadu_si256((__m256i*)&x[i]);
+    _mm256_storeu_si256((__m256i*)&z[i], _mm256_cmpgt_epi8(_mm256_setzero_si256(), m_x));
+  }
+#endif // LV_HAVE_AVX2
+  for (; i < len; i++) {
+    z[i] = (x[i] < 0) ? 0xff : 0;
+  }
+}
+
+/*!
+ * Computes \f$ z = x \oplus y \f$ elementwise.
+ */
+static void batch_xor(const uint8_t* x, const uint8_t* y, uint8_t* z, uint32_t len)
+{
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX512
+  for (; i + SRSRAN_AVX512_B_SIZE <= len; i += SRSRAN_AVX512_B_SIZE) {
+    __m512i m_x = _mm512_loadu_si512((__m512i*)&x[i]);
+    __m512i m_y = _mm512_loadu_si512((__m512i*)&y[i]);
+    _mm512_storeu_si512((__m512i*)&z[i], _mm512_xor_si512(m_x, m_y));
+  }
+#endif // LV_HAVE_AVX512
+#ifdef LV_HAVE_AVX2
+  for (; i + SRSRAN_AVX2_B_SIZE <= len; i += SRSRAN_AVX2_B_SIZE) {
+    __m256i m_x = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m256i m_y = _mm256_loadu_si256((__m256i*)&y[i]);
+    _mm256_storeu_si256((__m256i*)&z[i], _mm256_xor_si256(m_x, m_y));
+  }
+#endif // LV_HAVE_AVX2
+  for (; i < len; i++) {
+    z[i] = x[i] ^ y[i];
+  }
+}
+
+/*!
+ * Polar encodes, in place, the \f$2^s\f$ rows of a ::RATE_1 node at stage \f$ s \f$. Since the polar transform is
+ * its own inverse, this turns the hard decisions on the codeword bits into the message bits.
+ */
+static void batch_encode(uint8_t* rows, uint8_t stage)
+{
+  uint32_t size = 1U << stage;
+  for (uint32_t half = 1; half < size; half *= 2) {
+    for (uint32_t j = 0; j < size; j += 2 * half) {
+      batch_xor(rows + j * ROW_SIZE, rows + (j + half) * ROW_SIZE, rows + j * ROW_SIZE, half * ROW_SIZE);
+    }
+  }
+}
+
+/*!
+ * Decodes the node at stage \f$ s \f$ that starts at the codeword bit \a bit_pos. The node input LLRs are in
+ * \a p->llr[s].
+ */
+static void batch_node(struct pSSC_c_batch* pp, uint8_t stage, uint16_t bit_pos)
+{
+  uint32_t size    = 1U << stage;
+  int8_t*  llr     = pp->llr[stage];
+  uint8_t* est_bit = pp->est_bit + bit_pos * ROW_SIZE;
+  uint8_t* message = pp->message + bit_pos * ROW_SIZE;
+
+  switch (pp->node_type[stage][bit_pos >> stage]) {
+    case RATE_0:
+      memset(est_bit, 0, size * ROW_SIZE);
+      memset(message, 0, size * ROW_SIZE);
+      break;
+    case RATE_1:
+      batch_hard_bit(llr, est_bit, size * ROW_SIZE);
+      memcpy(message, est_bit, size * ROW_SIZE);
+      batch_encode(message, stage);
+      break;
+    case RATE_R: {
+      uint32_t half_len = (size / 2) * ROW_SIZE;
+
+      // Left child
+      batch_function_f(llr, llr + half_len, pp->llr[stage - 1], half_len);
+      batch_node(pp, stage - 1, bit_pos);
+
+      // Right child
+      batch_function_g(est_bit, llr, llr + half_len, pp->llr[stage - 1], half_len);
+      batch_node(pp, stage - 1, bit_pos + size / 2);
+
+      // Partial sums
+      batch_xor(est_bit, est_bit + half_len, est_bit, half_len);
+    } break;
+    default:
+      ERROR("Wrong node type %d", pp->node_type[stage][bit_pos >> stage]);
+      break;
+  }
+}
+
+void delete_polar_decoder_ssc_c_batch(void* p)
+{
+  struct pSSC_c_batch* pp = p;
+
+  if (pp == NULL) {
+    return;
+  }
+  if (pp->llr) {
+    free(pp->llr[0]);
+    free(pp->llr);
+  }
+  if (pp->node_type) {
+    free(pp->node_type[0]);
+    free(pp->node_type);
+  }
+  free(pp->est_bit);
+  free(pp->message);
+  if (pp->tmp_node_type) {
+    delete_tmp_node_type(pp->tmp_node_type);
+  }
+  free(pp);
+}
+
+void* create_polar_decoder_ssc_c_batch(const uint8_t nMax)
+{
+  struct pSSC_c_batch* pp = SRSRAN_MEM_ALLOC(struct pSSC_c_batch, 1);
+  if (pp == NULL) {
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pp, struct pSSC_c_batch, 1);
+  pp->nMax = nMax;
+
+  uint32_t code_size = 1U << nMax;
+
+  // Stage s LLRs start at row 2^s and take 2^s rows, as in the single codeword decoders
+  pp->llr       = SRSRAN_MEM_ALLOC(int8_t*, nMax + 1);
+  pp->node_type = SRSRAN_MEM_ALLOC(uint8_t*, nMax + 1);
+  if (pp->llr == NULL || pp->node_type == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+  pp->llr[0]        = srsran_vec_i8_malloc(2 * code_size * ROW_SIZE);
+  pp->node_type[0]  = srsran_vec_u8_malloc(2 * code_size);
+  pp->est_bit       = srsran_vec_u8_malloc(code_size * ROW_SIZE);
+  pp->message       = srsran_vec_u8_malloc(code_size * ROW_SIZE);
+  pp->tmp_node_type = create_tmp_node_type(nMax);
+  if (pp->llr[0] == NULL || pp->node_type[0] == NULL || pp->est_bit == NULL || pp->message == NULL ||
+      pp->tmp_node_type == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+
+  for (uint8_t s = 1; s < nMax + 1; s++) {
+    pp->llr[s]       = pp->llr[0] + (1U << s) * ROW_SIZE;
+    pp->node_type[s] = pp->node_type[s - 1] + (1U << (nMax - s + 1));
+  }
+
+  return pp;
+}
+
+int polar_decoder_ssc_c_batch(void*                p,
+                              const int8_t* const* llr,
+                              uint8_t* const*      data_decoded,
+                              const uint32_t       nof_codewords,
+                              const uint8_t        code_size_log,
+                              const uint16_t*      frozen_set,
+                              const uint16_t       frozen_set_size)
+{
+  struct pSSC_c_batch* pp = p;
+
+  if (pp == NULL || llr == NULL || data_decoded == NULL || nof_codewords > ROW_SIZE || code_size_log > pp->nMax ||
+      code_size_log == 0) {
+    return -1;
+  }
+
+  uint32_t code_size = 1U << code_size_log;
+
+  // Interleave the codewords, unused lanes are decoded from null LLRs
+  int8_t* llr_in = pp->llr[code_size_log];
+  if (nof_codewords < ROW_SIZE) {
+    srsran_vec_i8_zero(llr_in, code_size * ROW_SIZE);
+  }
+  for (uint32_t cw = 0; cw < nof_codewords; cw++) {
+    const int8_t* llr_cw = llr[cw];
+    for (uint32_t i = 0; i < code_size; i++) {
+      llr_in[i * ROW_SIZE + cw] = llr_cw[i];
+    }
+  }
+
+  // computes the node types for the decoding tree
+  compute_node_type(pp->tmp_node_type, pp->node_type, frozen_set, code_size_log, frozen_set_size);
+
+  batch_node(pp, code_size_log, 0);
+
+  // De-interleave the decoded messages
+  for (uint32_t cw = 0; cw < nof_codewords; cw++) {
+    uint8_t* data_cw = data_decoded[cw];
+    for (uint32_t i = 0; i < code_size; i++) {
+      data_cw[i] = pp->message[i * ROW_SIZE + cw] & 1U;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_ssc_c_batch.h
+ * \brief Declaration of the SSC polar decoder inner functions decoding a batch of codewords with 8-bit
+ * integer-valued LLRs, one codeword per SIMD lane.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#ifndef POLAR_DECODER_SSC_C_BATCH_H
+#define POLAR_DECODER_SSC_C_BATCH_H
+
+#include "polar_decoder_ssc_all.h"
+
+/*!
+ * Creates a batch SSC polar decoder structure of type pSSC_c_batch, and allocates memory for the decoding buffers.
+ *
+ * \param[in] nMax \f$log_2\f$ of the number of bits in the codeword.
+ * \return A pointer to a pSSC_c_batch structure if the function executes correctly, NULL otherwise.
+ */
+void* create_polar_decoder_ssc_c_batch(uint8_t nMax);
+
+/*!
+ * The (8-bit, batch) polar decoder SSC "destructor": it frees all the resources allocated to the decoder.
+ *
+ * \param[in, out] p A pointer to the dismantled decoder.
+ */
+void delete_polar_decoder_ssc_c_batch(void* p);
+
+/*!
+ * Decodes up to SRSRAN_POLAR_DECODER_MAX_BATCH codewords that share the same code size and frozen set. The
+ * codewords are interleaved so that every SIMD lane holds the LLRs of one codeword, and the decoding tree is traversed
+ * once for all of them.
+ *
+ * \param[in] p A pointer to the desired decoder.
+ * \param[in] llr LLRs of every codeword.
+ * \param[out] data_decoded Decoded message of every codeword.
+ * \param[in] nof_codewords Number of codewords in the batch.
+ * \param[in] code_size_log \f$log_2\f$ of the number of bits in the codeword.
+ * \param[in] frozen_set The position of the frozen bits in the codeword.
+ * \param[in] frozen_set_size Number of frozen bits.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int polar_decoder_ssc_c_batch(void*                p,
+                              const int8_t* const* llr,
+                              uint8_t* const*      data_decoded,
+                              const uint32_t       nof_codewords,
+                              const uint8_t        code_size_log,
+                              const uint16_t*      frozen_set,
+                              const uint16_t       frozen_set_size);
+
+#endif // POLAR_DECODER_SSC_C_BATCH_H
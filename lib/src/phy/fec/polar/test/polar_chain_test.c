@@ -44,6 +44,8 @@
  *  - <b>-s \<number\></b>  SNR [dB, Default 3.00 dB] -- Use 100 for scan, and 101 for noiseless.
  *  - <b>-o \<number\></b>  Print output results [Default 0] -- Use 0 for detailed, Use 1 for 1 line, Use 2 for vector
  * form.
+ *  - <b>-b \<number\></b>  Number of codewords in a batch [Default 10] -- The batch decoder decodes up to 32 codewords
+ * at once, use 32 to benchmark it fully loaded.
  *
  * Example 1: BCH - ./polar_chain_test -n9 -k56 -e864 -i0 -s101 -o1
  *
@@ -55,6 +57,8 @@
  *
  * Example 5: UCI - shortening 26 last bits - ./polar_chain_test -n10 -k18 -e38 -i1 -s101 -o1
  *
+ * Example 6: DCI - batch decoder benchmark - ./polar_chain_test -n9 -k40 -e432 -i0 -s3 -o1 -b32
+ *
  *
  */
 
@@ -103,12 +107,14 @@ static uint8_t  bil          = 0;   /*!< \brief If bil = 0 channel interleaver d
 static double   snr_db       = 3;   /*!< \brief SNR in dB (101 for no noise, 100 for scan). */
 static int      print_output = 0;   /*!< \brief print output form (0 for detailed, 1 for one line, 2 for vector). */
 
+static uint32_t batch_size = BATCH_SIZE; /*!< \brief Number of codewords in a batch. */
+
 /*!
  * \brief Prints test help when a wrong parameter is passed as input.
  */
 void usage(char* prog)
 {
-  printf("Usage: %s [-nX] [-kX] [-eX] [-iX] [-sX] [-oX]\n", prog);
+  printf("Usage: %s [-nX] [-kX] [-eX] [-iX] [-sX] [-oX] [-bX]\n", prog);
   printf("\t-n nMax [Default %d]\n", nMax);
   printf("\t-k Message size [Default %d]\n", K);
   printf("\t-e Rate matching size [Default %d]\n", E);
@@ -116,6 +122,7 @@ void usage(char* prog)
   printf("\t-s SNR [dB, Default %.2f dB] -- Use 100 for scan, and 101 for noiseless\n", snr_db);
   printf("\t-o Print output results [Default %d] -- Use 0 for detailed, Use 1 for 1 line, Use 2 for vector form\n",
          print_output);
+  printf("\t-b Number of codewords in a batch [Default %d]\n", batch_size);
 }
 
 /*!
@@ -124,7 +131,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt = 0;
-  while ((opt = getopt(argc, argv, "n:k:e:i:s:o:")) != -1) {
+  while ((opt = getopt(argc, argv, "n:k:e:i:s:o:b:")) != -1) {
     //  printf("opt : %d\n", opt);
     switch (opt) {
       case 'e':
@@ -145,6 +152,9 @@ void parse_args(int argc, char** argv)
       case 'o':
         print_output = (int)strtol(optarg, NULL, 10);
         break;
+      case 'b':
+        batch_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -157,11 +167,12 @@ void parse_args(int argc, char** argv)
  */
 int main(int argc, char** argv)
 {
-  uint8_t* data_tx        = NULL;
-  uint8_t* data_rx        = NULL;
-  uint8_t* data_rx_s      = NULL;
-  uint8_t* data_rx_c      = NULL;
-  uint8_t* data_rx_c_avx2 = NULL;
+  uint8_t* data_tx         = NULL;
+  uint8_t* data_rx         = NULL;
+  uint8_t* data_rx_s       = NULL;
+  uint8_t* data_rx_c       = NULL;
+  uint8_t* data_rx_c_avx2  = NULL;
+  uint8_t* data_rx_c_batch = NULL;
 
   uint8_t* input_enc       = NULL; // input encoder
   uint8_t* output_enc      = NULL; // output encoder
@@ -179,10 +190,14 @@ int main(int argc, char** argv)
   int8_t*  llr_c      = NULL; // input decoder
   int8_t*  llr_c_avx2 = NULL; // input decoder
 
-  uint8_t* output_dec        = NULL; // output decoder
-  uint8_t* output_dec_s      = NULL; // output decoder
-  uint8_t* output_dec_c      = NULL; // output decoder
-  uint8_t* output_dec_c_avx2 = NULL; // output decoder
+  uint8_t* output_dec         = NULL; // output decoder
+  uint8_t* output_dec_s       = NULL; // output decoder
+  uint8_t* output_dec_c       = NULL; // output decoder
+  uint8_t* output_dec_c_avx2  = NULL; // output decoder
+  uint8_t* output_dec_c_batch = NULL; // output decoder
+
+  const int8_t** llr_c_batch_ptr        = NULL; // input of every codeword of the batch decoder
+  uint8_t**      output_dec_c_batch_ptr = NULL; // output of every codeword of the batch decoder
 
   double var[SNR_POINTS + 1];
 
@@ -199,11 +214,13 @@ int main(int argc, char** argv)
 #ifdef LV_HAVE_AVX2
   int errors_symb_c_avx2 = 0;
 #endif
+  int errors_symb_c_batch = 0;
 
   int n_error_words[SNR_POINTS + 1];
   int n_error_words_s[SNR_POINTS + 1];
   int n_error_words_c[SNR_POINTS + 1];
   int n_error_words_c_avx2[SNR_POINTS + 1];
+  int n_error_words_c_batch[SNR_POINTS + 1];
 
   int last_i_batch[SNR_POINTS + 1];
 
@@ -212,6 +229,7 @@ int main(int argc, char** argv)
   double         elapsed_time_dec_s[SNR_POINTS + 1];
   double         elapsed_time_dec_c[SNR_POINTS + 1];
   double         elapsed_time_dec_c_avx2[SNR_POINTS + 1];
+  double         elapsed_time_dec_c_batch[SNR_POINTS + 1];
 
   double elapsed_time_enc[SNR_POINTS + 1];
   double elapsed_time_enc_avx2[SNR_POINTS + 1];
@@ -229,7 +247,8 @@ int main(int argc, char** argv)
   srsran_polar_encoder_t enc;
   srsran_polar_decoder_t dec;
   srsran_polar_decoder_t dec_s; // 16-bit
-  srsran_polar_decoder_t dec_c; // 8-bit
+  srsran_polar_decoder_t dec_c;       // 8-bit
+  srsran_polar_decoder_t dec_c_batch; // 8-bit, batch
   srsran_polar_rm_t      rm_tx;
   srsran_polar_rm_t      rm_rx_f;
   srsran_polar_rm_t      rm_rx_s;
@@ -269,6 +288,9 @@ int main(int argc, char** argv)
   // initialize a POLAR decoder (8 bit)
   srsran_polar_decoder_init(&dec_c, SRSRAN_POLAR_DECODER_SSC_C, nMax);
 
+  // initialize a POLAR decoder (8 bit, batch)
+  srsran_polar_decoder_init(&dec_c_batch, SRSRAN_POLAR_DECODER_SSC_C_BATCH, nMax);
+
 #ifdef LV_HAVE_AVX2
 
   // initialize encoder  avx2
@@ -283,36 +305,42 @@ int main(int argc, char** argv)
   srsran_random_t random_gen = srsran_random_init(0);
 #endif
 
-  data_tx        = srsran_vec_u8_malloc(K * BATCH_SIZE);
-  data_rx        = srsran_vec_u8_malloc(K * BATCH_SIZE);
-  data_rx_s      = srsran_vec_u8_malloc(K * BATCH_SIZE);
-  data_rx_c      = srsran_vec_u8_malloc(K * BATCH_SIZE);
-  data_rx_c_avx2 = srsran_vec_u8_malloc(K * BATCH_SIZE);
+  data_tx         = srsran_vec_u8_malloc(K * batch_size);
+  data_rx         = srsran_vec_u8_malloc(K * batch_size);
+  data_rx_s       = srsran_vec_u8_malloc(K * batch_size);
+  data_rx_c       = srsran_vec_u8_malloc(K * batch_size);
+  data_rx_c_avx2  = srsran_vec_u8_malloc(K * batch_size);
+  data_rx_c_batch = srsran_vec_u8_malloc(K * batch_size);
 
-  input_enc       = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
-  output_enc      = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
-  output_enc_avx2 = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
+  input_enc       = srsran_vec_u8_malloc(NMAX * batch_size);
+  output_enc      = srsran_vec_u8_malloc(NMAX * batch_size);
+  output_enc_avx2 = srsran_vec_u8_malloc(NMAX * batch_size);
 
-  rm_codeword = srsran_vec_u8_malloc(E * BATCH_SIZE);
+  rm_codeword = srsran_vec_u8_malloc(E * batch_size);
 
-  rm_llr        = srsran_vec_f_malloc(E * BATCH_SIZE);
-  rm_llr_s      = srsran_vec_i16_malloc(E * BATCH_SIZE);
-  rm_llr_c      = srsran_vec_i8_malloc(E * BATCH_SIZE);
-  rm_llr_c_avx2 = srsran_vec_i8_malloc(E * BATCH_SIZE);
+  rm_llr        = srsran_vec_f_malloc(E * batch_size);
+  rm_llr_s      = srsran_vec_i16_malloc(E * batch_size);
+  rm_llr_c      = srsran_vec_i8_malloc(E * batch_size);
+  rm_llr_c_avx2 = srsran_vec_i8_malloc(E * batch_size);
 
-  llr        = srsran_vec_f_malloc(NMAX * BATCH_SIZE);
-  llr_s      = srsran_vec_i16_malloc(NMAX * BATCH_SIZE);
-  llr_c      = srsran_vec_i8_malloc(NMAX * BATCH_SIZE);
-  llr_c_avx2 = srsran_vec_i8_malloc(NMAX * BATCH_SIZE);
+  llr        = srsran_vec_f_malloc(NMAX * batch_size);
+  llr_s      = srsran_vec_i16_malloc(NMAX * batch_size);
+  llr_c      = srsran_vec_i8_malloc(NMAX * batch_size);
+  llr_c_avx2 = srsran_vec_i8_malloc(NMAX * batch_size);
 
-  output_dec        = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
-  output_dec_s      = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
-  output_dec_c      = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
-  output_dec_c_avx2 = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
+  output_dec         = srsran_vec_u8_malloc(NMAX * batch_size);
+  output_dec_s       = srsran_vec_u8_malloc(NMAX * batch_size);
+  output_dec_c       = srsran_vec_u8_malloc(NMAX * batch_size);
+  output_dec_c_avx2  = srsran_vec_u8_malloc(NMAX * batch_size);
+  output_dec_c_batch = srsran_vec_u8_malloc(NMAX * batch_size);
+
+  llr_c_batch_ptr        = SRSRAN_MEM_ALLOC(const int8_t*, batch_size);
+  output_dec_c_batch_ptr = SRSRAN_MEM_ALLOC(uint8_t*, batch_size);
 
   if (!data_tx || !data_rx || !data_rx_s || !data_rx_c || !data_rx_c_avx2 || !input_enc || !output_enc ||
       !output_enc_avx2 || !rm_codeword || !rm_llr || !rm_llr_s || !rm_llr_c || !rm_llr_c_avx2 || !llr || !llr_s ||
-      !llr_c || !llr_c_avx2 || !output_dec || !output_dec_s || !output_dec_c || !output_dec_c_avx2) {
+      !llr_c || !llr_c_avx2 || !output_dec || !output_dec_s || !output_dec_c || !output_dec_c_avx2 || !data_rx_c_batch ||
+      !output_dec_c_batch || !llr_c_batch_ptr || !output_dec_c_batch_ptr) {
     perror("malloc");
     exit(-1);
   }
@@ -353,17 +381,19 @@ int main(int argc, char** argv)
       printf("\n  Signal-to-Noise Ratio -> %.1f dB\n", snr_db_vec[i_snr]);
     }
 
-    elapsed_time_enc[i_snr]        = 0;
-    elapsed_time_enc_avx2[i_snr]   = 0;
-    elapsed_time_dec[i_snr]        = 0;
-    elapsed_time_dec_s[i_snr]      = 0;
-    elapsed_time_dec_c[i_snr]      = 0;
-    elapsed_time_dec_c_avx2[i_snr] = 0;
+    elapsed_time_enc[i_snr]         = 0;
+    elapsed_time_enc_avx2[i_snr]    = 0;
+    elapsed_time_dec[i_snr]         = 0;
+    elapsed_time_dec_s[i_snr]       = 0;
+    elapsed_time_dec_c[i_snr]       = 0;
+    elapsed_time_dec_c_avx2[i_snr]  = 0;
+    elapsed_time_dec_c_batch[i_snr] = 0;
 
-    n_error_words[i_snr]        = 0;
-    n_error_words_s[i_snr]      = 0;
-    n_error_words_c[i_snr]      = 0;
-    n_error_words_c_avx2[i_snr] = 0;
+    n_error_words[i_snr]         = 0;
+    n_error_words_s[i_snr]       = 0;
+    n_error_words_c[i_snr]       = 0;
+    n_error_words_c_avx2[i_snr]  = 0;
+    n_error_words_c_batch[i_snr] = 0;
 
     int i_batch = 0;
     printf("\nBatch:\n  ");
@@ -390,14 +420,14 @@ int main(int argc, char** argv)
 
 // generate data_tx
 #ifdef DATA_ALL_ONES
-      for (i = 0; i < BATCH_SIZE; i++) {
+      for (i = 0; i < batch_size; i++) {
         for (j = 0; j < K; j++) {
           data_tx[i * K + j] = 1;
         }
       }
 
 #else
-      for (int i = 0; i < BATCH_SIZE; i++) {
+      for (int i = 0; i < batch_size; i++) {
         for (j = 0; j < K; j++) {
           data_tx[i * K + j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
         }
@@ -423,14 +453,14 @@ int main(int argc, char** argv)
                (double)(K + code.nPC) / code.N);
       }
       // subchannel_allocation block
-      for (int i = 0; i < BATCH_SIZE; i++) {
+      for (int i = 0; i < batch_size; i++) {
         srsran_polar_chanalloc_tx(
             data_tx + i * K, input_enc + i * code.N, code.N, code.K, code.nPC, code.K_set, code.PC_set);
       }
 
       // encoding pipeline
       gettimeofday(&t[1], NULL);
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_encoder_encode(&enc, input_enc + j * code.N, output_enc + j * code.N, code.n);
       }
       gettimeofday(&t[2], NULL);
@@ -439,14 +469,14 @@ int main(int argc, char** argv)
       elapsed_time_enc[i_snr] += t[0].tv_sec + 1e-6 * t[0].tv_usec;
 
       // rate matcher
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_rm_tx(&rm_tx, output_enc + j * code.N, rm_codeword + j * E, code.n, E, K, bil);
       }
 
 #ifdef LV_HAVE_AVX2
       // encoding  avx2
       gettimeofday(&t[1], NULL);
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_encoder_encode(&enc_avx2, input_enc + j * code.N, output_enc_avx2 + j * code.N, code.n);
       }
       gettimeofday(&t[2], NULL);
@@ -455,7 +485,7 @@ int main(int argc, char** argv)
       elapsed_time_enc_avx2[i_snr] += t[0].tv_sec + 1e-6 * t[0].tv_usec;
 
       // check errors with respect the output of the pipeline encoder
-      for (int i = 0; i < BATCH_SIZE; i++) {
+      for (int i = 0; i < batch_size; i++) {
         if (srsran_bit_diff(output_enc + i * code.N, output_enc_avx2 + i * code.N, code.N) != 0) {
           printf("ERROR: Wrong avx2 encoder output. SNR= %f, Batch: %d\n", snr_db_vec[i_snr], i);
           exit(-1);
@@ -463,29 +493,29 @@ int main(int argc, char** argv)
       }
 #endif // LV_HAVE_AVX2
 
-      for (j = 0; j < E * BATCH_SIZE; j++) {
+      for (j = 0; j < E * batch_size; j++) {
         rm_llr[j] = rm_codeword[j] ? -1 : 1;
       }
 
       // add noise
       if (snr_db_vec[i_snr] != 101) {
-        srsran_ch_awgn_f(rm_llr, rm_llr, var[i_snr], BATCH_SIZE * E);
+        srsran_ch_awgn_f(rm_llr, rm_llr, var[i_snr], batch_size * E);
 
         // Convert symbols into LLRs
-        for (j = 0; j < BATCH_SIZE * code.N; j++) {
+        for (j = 0; j < batch_size * E; j++) {
           rm_llr[j] *= 2 / (var[i_snr] * var[i_snr]);
         }
       }
 
       // rate-Dematcher
 
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_rm_rx_f(&rm_rx_f, rm_llr + j * E, llr + j * code.N, E, code.n, K, bil);
       }
 
       // decoding float point
       gettimeofday(&t[1], NULL);
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_decoder_decode_f(
             &dec, llr + j * code.N, output_dec + j * code.N, code.n, code.F_set, code.F_set_size);
       }
@@ -495,7 +525,7 @@ int main(int argc, char** argv)
       elapsed_time_dec[i_snr] += t[0].tv_sec + 1e-6 * t[0].tv_usec;
 
       // extract message bits - float decoder
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_chanalloc_rx(output_dec + j * code.N, data_rx + j * K, code.K, code.nPC, code.K_set, code.PC_set);
       }
 
@@ -503,7 +533,7 @@ int main(int argc, char** argv)
 #ifdef debug
       int i_error = 0;
 #endif
-      for (int i = 0; i < BATCH_SIZE; i++) {
+      for (int i = 0; i < batch_size; i++) {
         errors_symb = srsran_bit_diff(data_tx + i * K, data_rx + i * K, K);
 
         if (errors_symb != 0) {
@@ -514,21 +544,21 @@ int main(int argc, char** argv)
       // decoding 16-bit
       // 16-quantization
       if (snr_db_vec[i_snr] == 101) {
-        srsran_vec_quant_fs(rm_llr, rm_llr_s, 8192, 0, 32767, BATCH_SIZE * E);
+        srsran_vec_quant_fs(rm_llr, rm_llr_s, 8192, 0, 32767, batch_size * E);
       } else {
         gain_s = inf16 * var[i_snr] / 20 / (1 / var[i_snr] + 2);
         // printf("gain_s: %f, inf16:%d\n", gain_s, inf16);
-        srsran_vec_quant_fs(rm_llr, rm_llr_s, gain_s, 0, inf16, BATCH_SIZE * E);
+        srsran_vec_quant_fs(rm_llr, rm_llr_s, gain_s, 0, inf16, batch_size * E);
       }
 
       // Rate dematcher
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_rm_rx_s(&rm_rx_s, rm_llr_s + j * E, llr_s + j * code.N, E, code.n, K, bil);
       }
 
       // decoding 16-bit
       gettimeofday(&t[1], NULL);
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_decoder_decode_s(
             &dec_s, llr_s + j * code.N, output_dec_s + j * code.N, code.n, code.F_set, code.F_set_size);
       }
@@ -538,13 +568,13 @@ int main(int argc, char** argv)
       elapsed_time_dec_s[i_snr] += t[0].tv_sec + 1e-6 * t[0].tv_usec;
 
       // extract message bits  16-bit decoder
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_chanalloc_rx(
             output_dec_s + j * code.N, data_rx_s + j * K, code.K, code.nPC, code.K_set, code.PC_set);
       }
 
       // check errors 16-bit decoder
-      for (int i = 0; i < BATCH_SIZE; i++) {
+      for (int i = 0; i < batch_size; i++) {
         errors_symb_s = srsran_bit_diff(data_tx + i * K, data_rx_s + i * K, K);
 
         if (errors_symb_s != 0) {
@@ -555,20 +585,20 @@ int main(int argc, char** argv)
       // 8-bit decoding
       // 8-bit quantization
       if (snr_db_vec[i_snr] == 101) {
-        srsran_vec_quant_fc(rm_llr, rm_llr_c, 32, 0, 127, BATCH_SIZE * E);
+        srsran_vec_quant_fc(rm_llr, rm_llr_c, 32, 0, 127, batch_size * E);
       } else {
         gain_c = inf8 * var[i_snr] / 20 / (1 / var[i_snr] + 2);
-        srsran_vec_quant_fc(rm_llr, rm_llr_c, gain_c, 0, inf8, BATCH_SIZE * E);
+        srsran_vec_quant_fc(rm_llr, rm_llr_c, gain_c, 0, inf8, batch_size * E);
       }
 
       // Rate dematcher
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_rm_rx_c(&rm_rx_c, rm_llr_c + j * E, llr_c + j * code.N, E, code.n, K, bil);
       }
 
       // Decoding
       gettimeofday(&t[1], NULL);
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_decoder_decode_c(
             &dec_c, llr_c + j * code.N, output_dec_c + j * code.N, code.n, code.F_set, code.F_set_size);
       }
@@ -577,13 +607,13 @@ int main(int argc, char** argv)
       elapsed_time_dec_c[i_snr] += t[0].tv_sec + 1e-6 * t[0].tv_usec;
 
       // extract message bits
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_chanalloc_rx(
             output_dec_c + j * code.N, data_rx_c + j * K, code.K, code.nPC, code.K_set, code.PC_set);
       }
 
       // check errors 8-bits decoder
-      for (int i = 0; i < BATCH_SIZE; i++) {
+      for (int i = 0; i < batch_size; i++) {
         errors_symb_c = srsran_bit_diff(data_tx + i * K, data_rx_c + i * K, K);
 
         if (errors_symb_c != 0) {
@@ -595,19 +625,19 @@ int main(int argc, char** argv)
       // 8-bit avx2 decoding
       // 8-bit quantization
       if (snr_db_vec[i_snr] == 101) {
-        srsran_vec_quant_fc(rm_llr, rm_llr_c_avx2, 32, 0, 127, BATCH_SIZE * E);
+        srsran_vec_quant_fc(rm_llr, rm_llr_c_avx2, 32, 0, 127, batch_size * E);
       } else {
         gain_c_avx2 = inf8 * var[i_snr] / 20 / (1 / var[i_snr] + 2);
-        srsran_vec_quant_fc(rm_llr, rm_llr_c_avx2, gain_c_avx2, 0, inf8, BATCH_SIZE * E);
+        srsran_vec_quant_fc(rm_llr, rm_llr_c_avx2, gain_c_avx2, 0, inf8, batch_size * E);
       }
 
       // Rate dematcher
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_rm_rx_c(&rm_rx_c, rm_llr_c_avx2 + j * E, llr_c_avx2 + j * code.N, E, code.n, K, bil);
       }
 
       gettimeofday(&t[1], NULL);
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_decoder_decode_c(
             &dec_c_avx2, llr_c_avx2 + j * code.N, output_dec_c_avx2 + j * code.N, code.n, code.F_set, code.F_set_size);
       }
@@ -616,13 +646,13 @@ int main(int argc, char** argv)
       elapsed_time_dec_c_avx2[i_snr] += t[0].tv_sec + 1e-6 * t[0].tv_usec;
 
       // extract message bits
-      for (j = 0; j < BATCH_SIZE; j++) {
+      for (j = 0; j < batch_size; j++) {
         srsran_polar_chanalloc_rx(
             output_dec_c_avx2 + j * code.N, data_rx_c_avx2 + j * K, code.K, code.nPC, code.K_set, code.PC_set);
       }
 
       // check errors 8-bits decoder
-      for (int i = 0; i < BATCH_SIZE; i++) {
+      for (int i = 0; i < batch_size; i++) {
         errors_symb_c_avx2 = srsran_bit_diff(data_tx + i * K, data_rx_c_avx2 + i * K, K);
 
         if (errors_symb_c_avx2 != 0) {
@@ -631,6 +661,40 @@ int main(int argc, char** argv)
       }
 #endif // LV_HAVE_AVX2
 
+      // 8-bit batch decoding, same input as the 8-bit decoder
+      for (j = 0; j < batch_size; j++) {
+        llr_c_batch_ptr[j]        = llr_c + j * code.N;
+        output_dec_c_batch_ptr[j] = output_dec_c_batch + j * code.N;
+      }
+
+      gettimeofday(&t[1], NULL);
+      srsran_polar_decoder_decode_c_batch(
+          &dec_c_batch, llr_c_batch_ptr, output_dec_c_batch_ptr, batch_size, code.n, code.F_set, code.F_set_size);
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      elapsed_time_dec_c_batch[i_snr] += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+      // the batch decoder shall be bit-exact with the 8-bit decoder
+      if (srsran_bit_diff(output_dec_c, output_dec_c_batch, code.N * batch_size) != 0) {
+        printf("ERROR: Wrong batch decoder output. SNR= %f, Batch: %d\n", snr_db_vec[i_snr], i_batch);
+        exit(-1);
+      }
+
+      // extract message bits
+      for (j = 0; j < batch_size; j++) {
+        srsran_polar_chanalloc_rx(
+            output_dec_c_batch + j * code.N, data_rx_c_batch + j * K, code.K, code.nPC, code.K_set, code.PC_set);
+      }
+
+      // check errors 8-bits batch decoder
+      for (int i = 0; i < batch_size; i++) {
+        errors_symb_c_batch = srsran_bit_diff(data_tx + i * K, data_rx_c_batch + i * K, K);
+
+        if (errors_symb_c_batch != 0) {
+          n_error_words_c_batch[i_snr]++;
+        }
+      }
+
       last_i_batch[i_snr] = i_batch;
     } // end while BATCH
 
@@ -647,64 +711,76 @@ int main(int argc, char** argv)
       printf("];\n");
       printf("WER=[");
       for (int i_snr = 0; i_snr < snr_points; i_snr++) {
-        printf("%e ", (float)n_error_words[i_snr] / last_i_batch[i_snr] / BATCH_SIZE);
+        printf("%e ", (float)n_error_words[i_snr] / last_i_batch[i_snr] / batch_size);
       }
       printf("];\n");
 
       printf("WER_16=[");
       for (int i_snr = 0; i_snr < snr_points; i_snr++) {
-        printf("%e ", (float)n_error_words_s[i_snr] / last_i_batch[i_snr] / BATCH_SIZE);
+        printf("%e ", (float)n_error_words_s[i_snr] / last_i_batch[i_snr] / batch_size);
       }
       printf("];\n");
 
       printf("WER_8=[");
       for (int i_snr = 0; i_snr < snr_points; i_snr++) {
-        printf("%e ", (float)n_error_words_c[i_snr] / last_i_batch[i_snr] / BATCH_SIZE);
+        printf("%e ", (float)n_error_words_c[i_snr] / last_i_batch[i_snr] / batch_size);
       }
       printf("];\n");
 
 #ifdef LV_HAVE_AVX2
       printf("WER_8_AVX2=[");
       for (int i_snr = 0; i_snr < snr_points; i_snr++) {
-        printf("%e ", (float)n_error_words_c_avx2[i_snr] / last_i_batch[i_snr] / BATCH_SIZE);
+        printf("%e ", (float)n_error_words_c_avx2[i_snr] / last_i_batch[i_snr] / batch_size);
       }
       printf("];\n");
 #endif // LV_HAVE_AVX2
+
+      printf("WER_8_BATCH=[");
+      for (int i_snr = 0; i_snr < snr_points; i_snr++) {
+        printf("%e ", (float)n_error_words_c_batch[i_snr] / last_i_batch[i_snr] / batch_size);
+      }
+      printf("];\n");
       break;
     case 1:
       for (int i_snr = 0; i_snr < snr_points; i_snr++) {
         printf("SNR: %3.1f\t enc_pipe_thrpt(Mbps):  %.2f\t  enc_avx2_thrpt(Mbps):  "
                "%.2f\n",
                snr_db_vec[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * code.N / (1000000 * elapsed_time_enc[i_snr]),
-               last_i_batch[i_snr] * BATCH_SIZE * code.N / (1000000 * elapsed_time_enc_avx2[i_snr]));
+               last_i_batch[i_snr] * batch_size * code.N / (1000000 * elapsed_time_enc[i_snr]),
+               last_i_batch[i_snr] * batch_size * code.N / (1000000 * elapsed_time_enc_avx2[i_snr]));
 
         printf("SNR: %3.1f\t FLOAT WER: %.8f %d/%d \t  dec_thrput(Mbps): %.2f\n",
                snr_db_vec[i_snr],
-               (double)n_error_words[i_snr] / last_i_batch[i_snr] / BATCH_SIZE,
+               (double)n_error_words[i_snr] / last_i_batch[i_snr] / batch_size,
                n_error_words[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * code.N,
-               last_i_batch[i_snr] * BATCH_SIZE * code.N / (1000000 * elapsed_time_dec[i_snr]));
+               last_i_batch[i_snr] * batch_size * code.N,
+               last_i_batch[i_snr] * batch_size * code.N / (1000000 * elapsed_time_dec[i_snr]));
         printf("SNR: %3.1f\t INT16 WER: %.8f %d/%d \t dec_thrput(Mbps): %.2f\n",
                snr_db_vec[i_snr],
-               (double)n_error_words_s[i_snr] / last_i_batch[i_snr] / BATCH_SIZE,
+               (double)n_error_words_s[i_snr] / last_i_batch[i_snr] / batch_size,
                n_error_words_s[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * code.N,
-               last_i_batch[i_snr] * BATCH_SIZE * code.N / (1000000 * elapsed_time_dec_s[i_snr]));
+               last_i_batch[i_snr] * batch_size * code.N,
+               last_i_batch[i_snr] * batch_size * code.N / (1000000 * elapsed_time_dec_s[i_snr]));
         printf("SNR: %3.1f\t INT8  WER: %.8f %d/%d \t dec_thrput(Mbps): %.2f\n",
                snr_db_vec[i_snr],
-               (double)n_error_words_c[i_snr] / last_i_batch[i_snr] / BATCH_SIZE,
+               (double)n_error_words_c[i_snr] / last_i_batch[i_snr] / batch_size,
                n_error_words_c[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * code.N,
-               last_i_batch[i_snr] * BATCH_SIZE * code.N / (1000000 * elapsed_time_dec_c[i_snr]));
+               last_i_batch[i_snr] * batch_size * code.N,
+               last_i_batch[i_snr] * batch_size * code.N / (1000000 * elapsed_time_dec_c[i_snr]));
 #ifdef LV_HAVE_AVX2
         printf("SNR: %3.1f\t INT8-AVX2  WER: %.8f %d/%d \t dec_thrput(Mbps): %.2f\n",
                snr_db_vec[i_snr],
-               (double)n_error_words_c_avx2[i_snr] / last_i_batch[i_snr] / BATCH_SIZE,
+               (double)n_error_words_c_avx2[i_snr] / last_i_batch[i_snr] / batch_size,
                n_error_words_c_avx2[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * code.N,
-               last_i_batch[i_snr] * BATCH_SIZE * code.N / (1000000 * elapsed_time_dec_c_avx2[i_snr]));
+               last_i_batch[i_snr] * batch_size * code.N,
+               last_i_batch[i_snr] * batch_size * code.N / (1000000 * elapsed_time_dec_c_avx2[i_snr]));
 #endif // LV_HAVE_AVX2
+        printf("SNR: %3.1f\t INT8-BATCH WER: %.8f %d/%d \t dec_thrput(Mbps): %.2f\n",
+               snr_db_vec[i_snr],
+               (double)n_error_words_c_batch[i_snr] / last_i_batch[i_snr] / batch_size,
+               n_error_words_c_batch[i_snr],
+               last_i_batch[i_snr] * batch_size * code.N,
+               last_i_batch[i_snr] * batch_size * code.N / (1000000 * elapsed_time_dec_c_batch[i_snr]));
         printf("\n");
       }
 
@@ -714,61 +790,71 @@ int main(int argc, char** argv)
       for (int i_snr = 0; i_snr < snr_points; i_snr++) {
         printf("**** PIPELINE  ENCODER ****\n");
         printf("Estimated throughput:\n  %e word/s\n  %e bit/s (information)\n  %e bit/s (encoded)\n",
-               last_i_batch[i_snr] * BATCH_SIZE / elapsed_time_enc[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * K / elapsed_time_enc[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * code.N / elapsed_time_enc[i_snr]);
+               last_i_batch[i_snr] * batch_size / elapsed_time_enc[i_snr],
+               last_i_batch[i_snr] * batch_size * K / elapsed_time_enc[i_snr],
+               last_i_batch[i_snr] * batch_size * code.N / elapsed_time_enc[i_snr]);
 
 #ifdef LV_HAVE_AVX2
         printf("\n**** AVX2 ENCODER ****\n");
         printf("Estimated throughput:\n  %e word/s\n  %e bit/s (information)\n  %e bit/s "
                "(encoded)\n",
-               last_i_batch[i_snr] * BATCH_SIZE / elapsed_time_enc_avx2[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * K / elapsed_time_enc_avx2[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * code.N / elapsed_time_enc_avx2[i_snr]);
+               last_i_batch[i_snr] * batch_size / elapsed_time_enc_avx2[i_snr],
+               last_i_batch[i_snr] * batch_size * K / elapsed_time_enc_avx2[i_snr],
+               last_i_batch[i_snr] * batch_size * code.N / elapsed_time_enc_avx2[i_snr]);
 #endif // LV_HAVE_AVX2
 
         printf("\n**** FLOATING POINT ****");
         printf("\nEstimated word error rate:\n  %e (%d errors)\n",
-               (double)n_error_words[i_snr] / last_i_batch[i_snr] / BATCH_SIZE,
+               (double)n_error_words[i_snr] / last_i_batch[i_snr] / batch_size,
                n_error_words[i_snr]);
 
         printf("Estimated throughput decoder:\n  %e word/s\n  %e bit/s (information)\n  %e bit/s (encoded)\n",
-               last_i_batch[i_snr] * BATCH_SIZE / elapsed_time_dec[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * K / elapsed_time_dec[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * code.N / elapsed_time_dec[i_snr]);
+               last_i_batch[i_snr] * batch_size / elapsed_time_dec[i_snr],
+               last_i_batch[i_snr] * batch_size * K / elapsed_time_dec[i_snr],
+               last_i_batch[i_snr] * batch_size * code.N / elapsed_time_dec[i_snr]);
 
         printf("\n**** FIXED POINT (16 bits) ****");
         printf("\nEstimated word error rate:\n  %e (%d errors)\n",
-               (double)n_error_words_s[i_snr] / last_i_batch[i_snr] / BATCH_SIZE,
+               (double)n_error_words_s[i_snr] / last_i_batch[i_snr] / batch_size,
                n_error_words_s[i_snr]);
 
         printf("Estimated throughput decoder:\n  %e word/s\n  %e bit/s (information)\n  %e bit/s (encoded)\n",
-               last_i_batch[i_snr] * BATCH_SIZE / elapsed_time_dec_s[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * K / elapsed_time_dec_s[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * code.N / elapsed_time_dec_s[i_snr]);
+               last_i_batch[i_snr] * batch_size / elapsed_time_dec_s[i_snr],
+               last_i_batch[i_snr] * batch_size * K / elapsed_time_dec_s[i_snr],
+               last_i_batch[i_snr] * batch_size * code.N / elapsed_time_dec_s[i_snr]);
 
         printf("\n**** FIXED POINT (8 bits) ****");
         printf("\nEstimated word error rate:\n  %e (%d errors)\n",
-               (double)n_error_words_c[i_snr] / last_i_batch[i_snr] / BATCH_SIZE,
+               (double)n_error_words_c[i_snr] / last_i_batch[i_snr] / batch_size,
                n_error_words_c[i_snr]);
 
         printf("Estimated throughput decoder:\n  %e word/s\n  %e bit/s (information)\n  %e bit/s (encoded)\n",
-               last_i_batch[i_snr] * BATCH_SIZE / elapsed_time_dec_c[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * K / elapsed_time_dec_c[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * code.N / elapsed_time_dec_c[i_snr]);
+               last_i_batch[i_snr] * batch_size / elapsed_time_dec_c[i_snr],
+               last_i_batch[i_snr] * batch_size * K / elapsed_time_dec_c[i_snr],
+               last_i_batch[i_snr] * batch_size * code.N / elapsed_time_dec_c[i_snr]);
 
 #ifdef LV_HAVE_AVX2
         printf("\n**** FIXED POINT (8 bits, AVX2) ****");
         printf("\nEstimated word error rate:\n  %e (%d errors)\n",
-               (double)n_error_words_c_avx2[i_snr] / last_i_batch[i_snr] / BATCH_SIZE,
+               (double)n_error_words_c_avx2[i_snr] / last_i_batch[i_snr] / batch_size,
                n_error_words_c_avx2[i_snr]);
 
         printf("Estimated throughput decoder:\n  %e word/s\n  %e bit/s (information)\n  %e bit/s (encoded)\n",
-               last_i_batch[i_snr] * BATCH_SIZE / elapsed_time_dec_c_avx2[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * K / elapsed_time_dec_c_avx2[i_snr],
-               last_i_batch[i_snr] * BATCH_SIZE * code.N / elapsed_time_dec_c_avx2[i_snr]);
+               last_i_batch[i_snr] * batch_size / elapsed_time_dec_c_avx2[i_snr],
+               last_i_batch[i_snr] * batch_size * K / elapsed_time_dec_c_avx2[i_snr],
+               last_i_batch[i_snr] * batch_size * code.N / elapsed_time_dec_c_avx2[i_snr]);
 #endif // LV_HAVE_AVX2
 
+        printf("\n**** FIXED POINT (8 bits, BATCH) ****");
+        printf("\nEstimated word error rate:\n  %e (%d errors)\n",
+               (double)n_error_words_c_batch[i_snr] / last_i_batch[i_snr] / batch_size,
+               n_error_words_c_batch[i_snr]);
+
+        printf("Estimated throughput decoder:\n  %e word/s\n  %e bit/s (information)\n  %e bit/s (encoded)\n",
+               last_i_batch[i_snr] * batch_size / elapsed_time_dec_c_batch[i_snr],
+               last_i_batch[i_snr] * batch_size * K / elapsed_time_dec_c_batch[i_snr],
+               last_i_batch[i_snr] * batch_size * code.N / elapsed_time_dec_c_batch[i_snr]);
+
         printf("\n");
       }
       break;
@@ -801,6 +887,10 @@ int main(int argc, char** argv)
   free(output_dec_c_avx2);
   free(output_enc_avx2);
   free(data_rx_c_avx2);
+  free(output_dec_c_batch);
+  free(data_rx_c_batch);
+  free(llr_c_batch_ptr);
+  free(output_dec_c_batch_ptr);
 
 #ifdef DATA_ALL_ONES
 #else
@@ -812,6 +902,7 @@ int main(int argc, char** argv)
   srsran_polar_decoder_free(&dec);
   srsran_polar_decoder_free(&dec_s);
   srsran_polar_decoder_free(&dec_c);
+  srsran_polar_decoder_free(&dec_c_batch);
   srsran_polar_rm_rx_free_f(&rm_rx_f);
   srsran_polar_rm_rx_free_s(&rm_rx_s);
   srsran_polar_rm_rx_free_c(&rm_rx_c);
@@ -854,8 +945,15 @@ int main(int argc, char** argv)
 #endif // LV_HAVE_AVX2
     printf("\r");
 
+    if (n_error_words_c_batch[0] > expected_errors) {
+      printf("\n(8 bit, batch) Test failed!\n\n");
+    } else {
+      printf("\n(8 bit, batch) Test completed successfully!\n\n");
+    }
+    printf("\r");
+
     exit((n_error_words[0] > expected_errors) || (n_error_words_s[0] > expected_errors) ||
-         (n_error_words_c[0] > expected_errors)
+         (n_error_words_c[0] > expected_errors) || (n_error_words_c_batch[0] > expected_errors)
 #ifdef LV_HAVE_AVX2
          || (n_error_words_c_avx2[0] > expected_errors)
 #endif // LV_HAVE_AVX2
@@ -871,6 +969,10 @@ int main(int argc, char** argv)
         perror("8-bit performance at SNR = %d too low!");
         exit(-1);
       }
+      if (n_error_words_c_batch[i_snr] > 10 * n_error_words[i_snr]) {
+        perror("8-bit batch performance at SNR = %d too low!");
+        exit(-1);
+      }
 #ifdef LV_HAVE_AVX2
       if (n_error_words_c_avx2[i_snr] > 10 * n_error_words[i_snr]) {
         perror("8-bit avx2 performance at SNR = %d too low!");
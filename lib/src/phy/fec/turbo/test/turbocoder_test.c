@@ -21,6 +21,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 #include <unistd.h>
 
@@ -59,6 +60,8 @@ uint8_t parity[3 * 6144 + 12];
 uint8_t parity_bits[3 * 6144 + 12];
 uint8_t output_bits[3 * 6144 + 12];
 uint8_t output_bits2[3 * 6144 + 12];
+uint8_t batch_input[SRSRAN_TCOD_MAX_BATCH][6144 / 8 + 3];
+uint8_t batch_parity[SRSRAN_TCOD_MAX_BATCH][3 * 6144 + 12];
 
 int main(int argc, char** argv)
 {
@@ -124,6 +127,28 @@ int main(int argc, char** argv)
         exit(-1);
       }
     }
+
+    /* Encode several code blocks at once and compare with the LUT encoder */
+    uint8_t* batch_input_ptr[SRSRAN_TCOD_MAX_BATCH];
+    uint8_t* batch_parity_ptr[SRSRAN_TCOD_MAX_BATCH];
+    for (uint32_t c = 0; c < SRSRAN_TCOD_MAX_BATCH; c++) {
+      for (int i = 0; i < long_cb / 8; i++) {
+        batch_input[c][i] = srsran_random_uniform_int_dist(random_gen, 0, 256);
+      }
+      batch_input_ptr[c]  = batch_input[c];
+      batch_parity_ptr[c] = batch_parity[c];
+    }
+    srsran_tcod_encode_lut_batch(&tcod, batch_input_ptr, batch_parity_ptr, len, SRSRAN_TCOD_MAX_BATCH);
+
+    for (uint32_t c = 0; c < SRSRAN_TCOD_MAX_BATCH; c++) {
+      memcpy(input_bytes, batch_input[c], long_cb / 8);
+      srsran_tcod_encode_lut(&tcod, &crc_tb, NULL, input_bytes, parity, len, false);
+      if (input_bytes[long_cb / 8] != batch_input[c][long_cb / 8] ||
+          memcmp(parity, batch_parity[c], 2 * long_cb / 8 + 1) != 0) {
+        printf("error in batch code block %d, len=%d\n", c, len);
+        exit(-1);
+      }
+    }
   }
 
   srsran_tcod_free(&tcod);
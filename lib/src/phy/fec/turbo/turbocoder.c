@@ -50,6 +50,7 @@ int srsran_tcod_init(srsran_tcod_t* h, uint32_t max_long_cb)
 {
   h->max_long_cb = max_long_cb;
   h->temp        = srsran_vec_malloc(max_long_cb / 8);
+  h->temp_batch  = srsran_vec_u8_malloc(SRSRAN_TCOD_MAX_BATCH * (max_long_cb / 8));
 
   if (!table_initiated) {
     table_initiated = true;
@@ -64,6 +65,9 @@ void srsran_tcod_free(srsran_tcod_t* h)
   if (h->temp) {
     free(h->temp);
   }
+  if (h->temp_batch) {
+    free(h->temp_batch);
+  }
 
   if (table_initiated) {
     for (int i = 0; i < 188; i++) {
@@ -184,6 +188,73 @@ int srsran_tcod_encode(srsran_tcod_t* h, uint8_t* input, uint8_t* output, uint32
   return 0;
 }
 
+/* Computes the tail bits of both constituent encoders from their final states and appends them after the systematic
+ * and parity bits */
+static void tcod_lut_tail(uint8_t state0, uint8_t state1, uint8_t* input, uint8_t* parity, uint32_t long_cb)
+{
+  uint8_t reg1_0, reg1_1, reg1_2, reg2_0, reg2_1, reg2_2;
+  uint8_t bit, in, out;
+  uint8_t k = 0;
+  uint8_t tail[12];
+
+  reg2_0 = (state1 & 4) >> 2;
+  reg2_1 = (state1 & 2) >> 1;
+  reg2_2 = state1 & 1;
+
+  reg1_0 = (state0 & 4) >> 2;
+  reg1_1 = (state0 & 2) >> 1;
+  reg1_2 = state0 & 1;
+
+  /* TAILING CODER #1 */
+  for (uint32_t j = 0; j < NOF_REGS; j++) {
+    bit = reg1_2 ^ reg1_1;
+
+    tail[k] = bit;
+    k++;
+
+    in  = bit ^ (reg1_2 ^ reg1_1);
+    out = reg1_2 ^ (reg1_0 ^ in);
+
+    reg1_2 = reg1_1;
+    reg1_1 = reg1_0;
+    reg1_0 = in;
+
+    tail[k] = out;
+    k++;
+  }
+
+  /* TAILING CODER #2 */
+  for (uint32_t j = 0; j < NOF_REGS; j++) {
+    bit = reg2_2 ^ reg2_1;
+
+    tail[k] = bit;
+    k++;
+
+    in  = bit ^ (reg2_2 ^ reg2_1);
+    out = reg2_2 ^ (reg2_0 ^ in);
+
+    reg2_2 = reg2_1;
+    reg2_1 = reg2_0;
+    reg2_0 = in;
+
+    tail[k] = out;
+    k++;
+  }
+
+  uint8_t tailv[3][4];
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) {
+      tailv[j][i] = tail[3 * i + j];
+    }
+  }
+  uint8_t* x         = tailv[0];
+  input[long_cb / 8] = (srsran_bit_pack(&x, 4) << 4);
+  x                  = tailv[1];
+  parity[long_cb / 8] |= (srsran_bit_pack(&x, 4) << 4);
+  x = tailv[2];
+  parity[2 * long_cb / 8] |= (srsran_bit_pack(&x, 4) & 0xf);
+}
+
 /* Expects bytes and produces bytes. The systematic and parity bits are interlaced in the output */
 int srsran_tcod_encode_lut(srsran_tcod_t* h,
                            srsran_crc_t*  crc_tb,
@@ -300,73 +371,74 @@ int srsran_tcod_encode_lut(srsran_tcod_t* h,
       state1                      = l.next_state;
     }
 
-    /* Tail bits */
-    uint8_t reg1_0, reg1_1, reg1_2, reg2_0, reg2_1, reg2_2;
-    uint8_t bit, in, out;
-    uint8_t k = 0;
-    uint8_t tail[12];
-
-    reg2_0 = (state1 & 4) >> 2;
-    reg2_1 = (state1 & 2) >> 1;
-    reg2_2 = state1 & 1;
+    tcod_lut_tail(state0, state1, input, parity, long_cb);
 
-    reg1_0 = (state0 & 4) >> 2;
-    reg1_1 = (state0 & 2) >> 1;
-    reg1_2 = state0 & 1;
-
-    /* TAILING CODER #1 */
-    for (uint32_t j = 0; j < NOF_REGS; j++) {
-      bit = reg1_2 ^ reg1_1;
+    return 3 * long_cb + TOTALTAIL;
+  } else {
+    return -1;
+  }
+}
 
-      tail[k] = bit;
-      k++;
+int srsran_tcod_encode_lut_batch(srsran_tcod_t* h,
+                                 uint8_t*       input[SRSRAN_TCOD_MAX_BATCH],
+                                 uint8_t*       parity[SRSRAN_TCOD_MAX_BATCH],
+                                 uint32_t       cblen_idx,
+                                 uint32_t       nof_cb)
+{
+  if (cblen_idx >= 188 || nof_cb == 0 || nof_cb > SRSRAN_TCOD_MAX_BATCH) {
+    return -1;
+  }
 
-      in  = bit ^ (reg1_2 ^ reg1_1);
-      out = reg1_2 ^ (reg1_0 ^ in);
+  uint32_t long_cb = (uint32_t)srsran_cbsegm_cbsize(cblen_idx);
+  if (long_cb > h->max_long_cb) {
+    ERROR("Turbo coder initialized for long_cb=%d, requested %d", h->max_long_cb, long_cb);
+    return -1;
+  }
 
-      reg1_2 = reg1_1;
-      reg1_1 = reg1_0;
-      reg1_0 = in;
+  // Local copies of the pointers, the stores of parity bytes could otherwise alias them
+  uint8_t* in[SRSRAN_TCOD_MAX_BATCH];
+  uint8_t* out[SRSRAN_TCOD_MAX_BATCH];
+  uint8_t* temp[SRSRAN_TCOD_MAX_BATCH];
+  uint8_t  state0[SRSRAN_TCOD_MAX_BATCH] = {};
+  uint8_t  state1[SRSRAN_TCOD_MAX_BATCH] = {};
+  for (uint32_t c = 0; c < nof_cb; c++) {
+    in[c]   = input[c];
+    out[c]  = parity[c];
+    temp[c] = &h->temp_batch[c * (h->max_long_cb / 8)];
+  }
 
-      tail[k] = out;
-      k++;
+  /* Parity bits for the 1st constituent encoders. The state of every code block only depends on its previous byte, so
+   * the table lookups of different code blocks overlap */
+  for (uint32_t i = 0; i < long_cb / 8; i++) {
+    for (uint32_t c = 0; c < nof_cb; c++) {
+      tcod_lut_t l = tcod_lut[state0[c]][in[c][i]];
+      out[c][i]    = l.output;
+      state0[c]    = l.next_state;
     }
+  }
 
-    /* TAILING CODER #2 */
-    for (uint32_t j = 0; j < NOF_REGS; j++) {
-      bit = reg2_2 ^ reg2_1;
-
-      tail[k] = bit;
-      k++;
-
-      in  = bit ^ (reg2_2 ^ reg2_1);
-      out = reg2_2 ^ (reg2_0 ^ in);
-
-      reg2_2 = reg2_1;
-      reg2_1 = reg2_0;
-      reg2_0 = in;
-
-      tail[k] = out;
-      k++;
-    }
+  /* Interleave input */
+  for (uint32_t c = 0; c < nof_cb; c++) {
+    out[c][long_cb / 8] = 0; // will put tail here later
+    srsran_bit_interleaver_run(&tcod_interleavers[cblen_idx], in[c], temp[c], 0);
+  }
 
-    uint8_t tailv[3][4];
-    for (int i = 0; i < 4; i++) {
-      for (int j = 0; j < 3; j++) {
-        tailv[j][i] = tail[3 * i + j];
-      }
+  /* Parity bits for the 2nd constituent encoders */
+  for (uint32_t i = 0; i < long_cb / 8; i++) {
+    for (uint32_t c = 0; c < nof_cb; c++) {
+      tcod_lut_t l = tcod_lut[state1[c]][temp[c][i]];
+      out[c][long_cb / 8 + i] |= (l.output & 0xf0) >> 4;
+      out[c][long_cb / 8 + i + 1] = (l.output & 0xf) << 4;
+      state1[c]                   = l.next_state;
     }
-    uint8_t* x         = tailv[0];
-    input[long_cb / 8] = (srsran_bit_pack(&x, 4) << 4);
-    x                  = tailv[1];
-    parity[long_cb / 8] |= (srsran_bit_pack(&x, 4) << 4);
-    x = tailv[2];
-    parity[2 * long_cb / 8] |= (srsran_bit_pack(&x, 4) & 0xf);
+  }
 
-    return 3 * long_cb + TOTALTAIL;
-  } else {
-    return -1;
+  /* Tail bits */
+  for (uint32_t c = 0; c < nof_cb; c++) {
+    tcod_lut_tail(state0[c], state1[c], in[c], out[c], long_cb);
   }
+
+  return 3 * long_cb + TOTALTAIL;
 }
 
 void srsran_tcod_gentable()
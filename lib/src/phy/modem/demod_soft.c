@@ -23,6 +23,7 @@
 #include <stdlib.h>
 #include <strings.h>
 
+#include "srsran/phy/mimo/precoding.h"
 #include "srsran/phy/modem/demod_soft.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
@@ -76,6 +77,10 @@
 void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols);
 #endif
 
+#if defined(LV_HAVE_AVX2) || defined(LV_HAVE_AVX512)
+#include <immintrin.h>
+#endif
+
 #define SCALE_SHORT_CONV_QPSK 100
 #define SCALE_SHORT_CONV_QAM16 400
 #define SCALE_SHORT_CONV_QAM64 700
@@ -777,9 +782,107 @@ void demod_64qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 #endif
 }
 
+#ifdef LV_HAVE_AVX2
+/* Computes the LLR of 4 256QAM symbols. Every output register holds the 8 LLR of one symbol, in the same order as the
+ * generic implementation. */
+static inline void demod_256qam_lte_avx2(const cf_t* symbols, __m256 llr[4])
+{
+  const __m256 sign       = _mm256_set1_ps(-0.0f);
+  const __m256 threshold1 = _mm256_set1_ps(8.0f / sqrtf(170.0f));
+  const __m256 threshold2 = _mm256_set1_ps(4.0f / sqrtf(170.0f));
+  const __m256 threshold3 = _mm256_set1_ps(2.0f / sqrtf(170.0f));
+
+  // Every register holds one pair (real and imaginary) of LLR for each of the 4 symbols
+  __m256 l0 = _mm256_xor_ps(_mm256_loadu_ps((const float*)symbols), sign);
+  __m256 l1 = _mm256_sub_ps(_mm256_andnot_ps(sign, l0), threshold1);
+  __m256 l2 = _mm256_sub_ps(_mm256_andnot_ps(sign, l1), threshold2);
+  __m256 l3 = _mm256_sub_ps(_mm256_andnot_ps(sign, l2), threshold3);
+
+  // Transpose the 4x4 matrix of LLR pairs
+  __m256d t0 = _mm256_unpacklo_pd(_mm256_castps_pd(l0), _mm256_castps_pd(l1));
+  __m256d t1 = _mm256_unpackhi_pd(_mm256_castps_pd(l0), _mm256_castps_pd(l1));
+  __m256d t2 = _mm256_unpacklo_pd(_mm256_castps_pd(l2), _mm256_castps_pd(l3));
+  __m256d t3 = _mm256_unpackhi_pd(_mm256_castps_pd(l2), _mm256_castps_pd(l3));
+
+  llr[0] = _mm256_castpd_ps(_mm256_permute2f128_pd(t0, t2, 0x20));
+  llr[1] = _mm256_castpd_ps(_mm256_permute2f128_pd(t1, t3, 0x20));
+  llr[2] = _mm256_castpd_ps(_mm256_permute2f128_pd(t0, t2, 0x31));
+  llr[3] = _mm256_castpd_ps(_mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+/* Scales and converts 4 symbols worth of LLR to 16 bit, truncating as the generic implementation does */
+static inline void demod_256qam_lte_avx2_s(const __m256 llr[4], __m256 scale, __m256i out[2])
+{
+  __m256i i0 = _mm256_cvttps_epi32(_mm256_mul_ps(llr[0], scale));
+  __m256i i1 = _mm256_cvttps_epi32(_mm256_mul_ps(llr[1], scale));
+  __m256i i2 = _mm256_cvttps_epi32(_mm256_mul_ps(llr[2], scale));
+  __m256i i3 = _mm256_cvttps_epi32(_mm256_mul_ps(llr[3], scale));
+
+  // Packing works on 128 bit lanes, swap the middle 64 bit words back into place
+  out[0] = _mm256_permute4x64_epi64(_mm256_packs_epi32(i0, i1), 0xD8);
+  out[1] = _mm256_permute4x64_epi64(_mm256_packs_epi32(i2, i3), 0xD8);
+}
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX512
+/* Computes the LLR of 8 256QAM symbols. Every output register holds the 16 LLR of two consecutive symbols. */
+static inline void demod_256qam_lte_avx512(const cf_t* symbols, __m512 llr[4])
+{
+  const __m512 sign       = _mm512_set1_ps(-0.0f);
+  const __m512 threshold1 = _mm512_set1_ps(8.0f / sqrtf(170.0f));
+  const __m512 threshold2 = _mm512_set1_ps(4.0f / sqrtf(170.0f));
+  const __m512 threshold3 = _mm512_set1_ps(2.0f / sqrtf(170.0f));
+
+  __m512 l0 = _mm512_castsi512_ps(
+      _mm512_xor_si512(_mm512_castps_si512(_mm512_loadu_ps((const float*)symbols)), _mm512_castps_si512(sign)));
+  __m512 l1 = _mm512_sub_ps(_mm512_abs_ps(l0), threshold1);
+  __m512 l2 = _mm512_sub_ps(_mm512_abs_ps(l1), threshold2);
+  __m512 l3 = _mm512_sub_ps(_mm512_abs_ps(l2), threshold3);
+
+  // Interleave the LLR pairs of registers 0/1 and 2/3, then gather the 4 pairs of every symbol
+  const __m512i idx_lo  = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11);
+  const __m512i idx_hi  = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15);
+  const __m512i idx_sym = _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11);
+  const __m512i idx_nxt = _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15);
+
+  __m512d t01_lo = _mm512_permutex2var_pd(_mm512_castps_pd(l0), idx_lo, _mm512_castps_pd(l1));
+  __m512d t01_hi = _mm512_permutex2var_pd(_mm512_castps_pd(l0), idx_hi, _mm512_castps_pd(l1));
+  __m512d t23_lo = _mm512_permutex2var_pd(_mm512_castps_pd(l2), idx_lo, _mm512_castps_pd(l3));
+  __m512d t23_hi = _mm512_permutex2var_pd(_mm512_castps_pd(l2), idx_hi, _mm512_castps_pd(l3));
+
+  llr[0] = _mm512_castpd_ps(_mm512_permutex2var_pd(t01_lo, idx_sym, t23_lo));
+  llr[1] = _mm512_castpd_ps(_mm512_permutex2var_pd(t01_lo, idx_nxt, t23_lo));
+  llr[2] = _mm512_castpd_ps(_mm512_permutex2var_pd(t01_hi, idx_sym, t23_hi));
+  llr[3] = _mm512_castpd_ps(_mm512_permutex2var_pd(t01_hi, idx_nxt, t23_hi));
+}
+#endif /* LV_HAVE_AVX512 */
+
 void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
 {
-  for (int i = 0; i < nsymbols; i++) {
+  int i = 0;
+
+#ifdef LV_HAVE_AVX512
+  for (; i < nsymbols - 7; i += 8) {
+    __m512 l[4];
+    demod_256qam_lte_avx512(&symbols[i], l);
+    for (int j = 0; j < 4; j++) {
+      _mm512_storeu_ps(&llr[8 * i + 16 * j], l[j]);
+    }
+  }
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+  for (; i < nsymbols - 3; i += 4) {
+    __m256 l[4];
+    demod_256qam_lte_avx2(&symbols[i], l);
+    for (int j = 0; j < 4; j++) {
+      _mm256_storeu_ps(&llr[8 * i + 8 * j], l[j]);
+    }
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  llr += 8 * i;
+  for (; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
     float imag = -__imag__ symbols[i];
     *(llr++)   = real;
@@ -801,7 +904,39 @@ void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
 
 void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
-  for (int i = 0; i < nsymbols; i++) {
+  int i = 0;
+
+#ifdef LV_HAVE_AVX512
+  const __m512 scale512 = _mm512_set1_ps(SCALE_BYTE_CONV_QAM256);
+  for (; i < nsymbols - 7; i += 8) {
+    __m512 l[4];
+    demod_256qam_lte_avx512(&symbols[i], l);
+    for (int j = 0; j < 4; j++) {
+      __m512i v = _mm512_cvttps_epi32(_mm512_mul_ps(l[j], scale512));
+      _mm_storeu_si128((__m128i*)&llr[8 * i + 16 * j], _mm512_cvtsepi32_epi8(v));
+    }
+  }
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+  const __m256  scale256 = _mm256_set1_ps(SCALE_BYTE_CONV_QAM256);
+  const __m256i perm     = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  for (; i < nsymbols - 3; i += 4) {
+    __m256 l[4];
+    demod_256qam_lte_avx2(&symbols[i], l);
+    __m256i i0 = _mm256_cvttps_epi32(_mm256_mul_ps(l[0], scale256));
+    __m256i i1 = _mm256_cvttps_epi32(_mm256_mul_ps(l[1], scale256));
+    __m256i i2 = _mm256_cvttps_epi32(_mm256_mul_ps(l[2], scale256));
+    __m256i i3 = _mm256_cvttps_epi32(_mm256_mul_ps(l[3], scale256));
+
+    // After packing, every 32 bit word holds half the LLR of a symbol, restore the symbol order
+    __m256i v = _mm256_packs_epi16(_mm256_packs_epi32(i0, i1), _mm256_packs_epi32(i2, i3));
+    _mm256_storeu_si256((__m256i*)&llr[8 * i], _mm256_permutevar8x32_epi32(v, perm));
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  llr += 8 * i;
+  for (; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
     float imag = -__imag__ symbols[i];
     *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
@@ -823,7 +958,34 @@ void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 
 void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 {
-  for (int i = 0; i < nsymbols; i++) {
+  int i = 0;
+
+#ifdef LV_HAVE_AVX512
+  const __m512 scale512 = _mm512_set1_ps(SCALE_SHORT_CONV_QAM256);
+  for (; i < nsymbols - 7; i += 8) {
+    __m512 l[4];
+    demod_256qam_lte_avx512(&symbols[i], l);
+    for (int j = 0; j < 4; j++) {
+      __m512i v = _mm512_cvttps_epi32(_mm512_mul_ps(l[j], scale512));
+      _mm256_storeu_si256((__m256i*)&llr[8 * i + 16 * j], _mm512_cvtsepi32_epi16(v));
+    }
+  }
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+  const __m256 scale256 = _mm256_set1_ps(SCALE_SHORT_CONV_QAM256);
+  for (; i < nsymbols - 3; i += 4) {
+    __m256  l[4];
+    __m256i v[2];
+    demod_256qam_lte_avx2(&symbols[i], l);
+    demod_256qam_lte_avx2_s(l, scale256, v);
+    _mm256_storeu_si256((__m256i*)&llr[8 * i], v[0]);
+    _mm256_storeu_si256((__m256i*)&llr[8 * i + 16], v[1]);
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  llr += 8 * i;
+  for (; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
     float imag = -__imag__ symbols[i];
     *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
@@ -917,3 +1079,59 @@ int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols,
   }
   return 0;
 }
+
+/* Number of symbols equalized at a time by the fused equalizer and demodulator. It is small enough for the equalized
+ * symbols to stay in L1 cache, and a multiple of the SIMD width so that every block keeps the input alignment. */
+#define DEMOD_SOFT_EQ_BLOCK_SIZE 256
+
+int srsran_demod_soft_equalize_demodulate_b(srsran_mod_t modulation,
+                                            cf_t*        y,
+                                            cf_t*        h,
+                                            float        scaling,
+                                            float        noise_estimate,
+                                            int8_t*      llr,
+                                            int          nsymbols)
+{
+  __attribute__((aligned(64))) cf_t x[DEMOD_SOFT_EQ_BLOCK_SIZE];
+
+  if (y == NULL || h == NULL || llr == NULL || modulation >= SRSRAN_MOD_NITEMS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t nbits = srsran_mod_bits_x_symbol(modulation);
+  for (int i = 0; i < nsymbols; i += DEMOD_SOFT_EQ_BLOCK_SIZE) {
+    int n = SRSRAN_MIN(DEMOD_SOFT_EQ_BLOCK_SIZE, nsymbols - i);
+    srsran_predecoding_single(&y[i], &h[i], x, NULL, n, scaling, noise_estimate);
+    if (srsran_demod_soft_demodulate_b(modulation, x, &llr[nbits * i], n)) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_demod_soft_equalize_demodulate_s(srsran_mod_t modulation,
+                                            cf_t*        y,
+                                            cf_t*        h,
+                                            float        scaling,
+                                            float        noise_estimate,
+                                            short*       llr,
+                                            int          nsymbols)
+{
+  __attribute__((aligned(64))) cf_t x[DEMOD_SOFT_EQ_BLOCK_SIZE];
+
+  if (y == NULL || h == NULL || llr == NULL || modulation >= SRSRAN_MOD_NITEMS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t nbits = srsran_mod_bits_x_symbol(modulation);
+  for (int i = 0; i < nsymbols; i += DEMOD_SOFT_EQ_BLOCK_SIZE) {
+    int n = SRSRAN_MIN(DEMOD_SOFT_EQ_BLOCK_SIZE, nsymbols - i);
+    srsran_predecoding_single(&y[i], &h[i], x, NULL, n, scaling, noise_estimate);
+    if (srsran_demod_soft_demodulate_s(modulation, x, &llr[nbits * i], n)) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -109,15 +109,29 @@ float mse_threshold()
   }
 }
 
+// Generic 256QAM demodulator, used to check the vectorized implementations
+static void demod_256qam_ref(const cf_t* symbols, float* llr, int nsymbols)
+{
+  for (int i = 0; i < nsymbols; i++) {
+    float x[2] = {-crealf(symbols[i]), -cimagf(symbols[i])};
+    for (int j = 0; j < 2; j++) {
+      llr[8 * i + j]     = x[j];
+      llr[8 * i + 2 + j] = fabsf(llr[8 * i + j]) - 8.0f / sqrtf(170.0f);
+      llr[8 * i + 4 + j] = fabsf(llr[8 * i + 2 + j]) - 4.0f / sqrtf(170.0f);
+      llr[8 * i + 6 + j] = fabsf(llr[8 * i + 4 + j]) - 2.0f / sqrtf(170.0f);
+    }
+  }
+}
+
 int main(int argc, char** argv)
 {
   int                  i;
   srsran_modem_table_t mod;
   uint8_t *            input, *output;
-  cf_t*                symbols;
-  float*               llr;
+  cf_t *               symbols, *h, *y;
+  float *              llr, *llr_ref;
   short*               llr_s;
-  int8_t*              llr_b;
+  int8_t *             llr_b, *llr_eq;
 
   parse_args(argc, argv);
 
@@ -147,8 +161,16 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
-  llr = srsran_vec_f_malloc(num_bits);
-  if (!llr) {
+  h = srsran_vec_cf_malloc(num_bits / mod.nbits_x_symbol);
+  y = srsran_vec_cf_malloc(num_bits / mod.nbits_x_symbol);
+  if (!h || !y) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  llr     = srsran_vec_f_malloc(num_bits);
+  llr_ref = srsran_vec_f_malloc(num_bits);
+  if (!llr || !llr_ref) {
     perror("malloc");
     exit(-1);
   }
@@ -159,8 +181,9 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
-  llr_b = srsran_vec_i8_malloc(num_bits);
-  if (!llr_b) {
+  llr_b  = srsran_vec_i8_malloc(num_bits);
+  llr_eq = srsran_vec_i8_malloc(num_bits);
+  if (!llr_b || !llr_eq) {
     perror("malloc");
     exit(-1);
   }
@@ -233,13 +256,40 @@ int main(int argc, char** argv)
         goto clean_exit;
       }
     }
+
+    // The vectorized 256QAM demodulator shall match the generic implementation exactly
+    if (modulation == SRSRAN_MOD_256QAM) {
+      demod_256qam_ref(symbols, llr_ref, num_bits / mod.nbits_x_symbol);
+      if (memcmp(llr, llr_ref, sizeof(float) * num_bits) != 0) {
+        printf("256QAM LLR mismatch\n");
+        goto clean_exit;
+      }
+    }
+
+    // Fused equalization and demodulation through a random channel shall match the demodulation of the transmitted
+    // symbols, up to rounding errors
+    for (i = 0; i < num_bits / mod.nbits_x_symbol; i++) {
+      h[i] = (0.5f + (float)rand() / RAND_MAX) * cexpf(_Complex_I * 2.0f * (float)M_PI * (float)rand() / RAND_MAX);
+      y[i] = symbols[i] * h[i];
+    }
+    srsran_demod_soft_equalize_demodulate_b(modulation, y, h, 1.0f, 0.0f, llr_eq, num_bits / mod.nbits_x_symbol);
+    for (i = 0; i < num_bits; i++) {
+      if (abs(llr_eq[i] - llr_b[i]) > 1) {
+        printf("Equalized LLR mismatch in bit %d (%d!=%d)\n", i, llr_eq[i], llr_b[i]);
+        goto clean_exit;
+      }
+    }
   }
   ret = 0;
 
 clean_exit:
+  free(llr_eq);
   free(llr_b);
   free(llr_s);
+  free(llr_ref);
   free(llr);
+  free(y);
+  free(h);
   free(symbols);
   free(output);
   free(input);
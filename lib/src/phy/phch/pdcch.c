@@ -87,6 +87,13 @@ static int pdcch_init(srsran_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_anten
       goto clean;
     }
 
+    if (q->is_ue) {
+      q->rm_f_batch = srsran_vec_f_malloc(SRSRAN_VITERBI_MAX_BATCH * 3 * (SRSRAN_DCI_MAX_BITS + 16));
+      if (!q->rm_f_batch) {
+        goto clean;
+      }
+    }
+
     srsran_vec_f_zero(q->llr, q->max_bits);
 
     q->d = srsran_vec_cf_malloc(q->max_bits / 2);
@@ -140,6 +147,9 @@ void srsran_pdcch_free(srsran_pdcch_t* q)
   if (q->llr) {
     free(q->llr);
   }
+  if (q->rm_f_batch) {
+    free(q->rm_f_batch);
+  }
   if (q->d) {
     free(q->d);
   }
@@ -328,6 +338,15 @@ uint32_t srsran_pdcch_common_locations_ncce(uint32_t nof_cce, srsran_dci_locatio
   return k;
 }
 
+// Returns XOR between the parity bits that follow the decoded message and its CRC
+static uint16_t pdcch_dci_crc_rem(srsran_pdcch_t* q, uint8_t* data, uint32_t nof_bits)
+{
+  uint8_t* x       = &data[nof_bits];
+  uint16_t p_bits  = (uint16_t)srsran_bit_pack(&x, 16);
+  uint16_t crc_res = ((uint16_t)srsran_crc_checksum(&q->crc, data, nof_bits) & 0xffff);
+  return p_bits ^ crc_res;
+}
+
 /** 36.212 5.3.3.2 to 5.3.3.4
  *
  * Returns XOR between parity and remainder bits
@@ -336,9 +355,6 @@ uint32_t srsran_pdcch_common_locations_ncce(uint32_t nof_cce, srsran_dci_locatio
  */
 int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t E, uint32_t nof_bits, uint16_t* crc)
 {
-  uint16_t p_bits, crc_res;
-  uint8_t* x;
-
   if (q != NULL) {
     if (data != NULL && E <= q->max_bits && nof_bits <= SRSRAN_DCI_MAX_BITS) {
       srsran_vec_f_zero(q->rm_f, 3 * (SRSRAN_DCI_MAX_BITS + 16));
@@ -351,12 +367,8 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
       /* viterbi decoder */
       srsran_viterbi_decode_f(&q->decoder, q->rm_f, data, nof_bits + 16);
 
-      x       = &data[nof_bits];
-      p_bits  = (uint16_t)srsran_bit_pack(&x, 16);
-      crc_res = ((uint16_t)srsran_crc_checksum(&q->crc, data, nof_bits) & 0xffff);
-
       if (crc) {
-        *crc = p_bits ^ crc_res;
+        *crc = pdcch_dci_crc_rem(q, data, nof_bits);
       }
 
       return SRSRAN_SUCCESS;
@@ -369,6 +381,46 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
   }
 }
 
+// Checks the location of the message, returns the mean absolute LLR in the location or a negative value if invalid
+static double pdcch_msg_llr_mean(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_msg_t* msg)
+{
+  if (!srsran_dci_location_isvalid(&msg->location)) {
+    ERROR("Invalid parameters, location=%d,%d", msg->location.ncce, msg->location.L);
+    return -1.0;
+  }
+  if (msg->location.ncce * 72 + PDCCH_FORMAT_NOF_BITS(msg->location.L) > NOF_CCE(sf->cfi) * 72) {
+    ERROR("Invalid location: nCCE: %d, L: %d, NofCCE: %d", msg->location.ncce, msg->location.L, NOF_CCE(sf->cfi));
+    return -1.0;
+  }
+
+  // Compute absolute mean of the LLRs
+  uint32_t e_bits = PDCCH_FORMAT_NOF_BITS(msg->location.L);
+  double   mean   = 0;
+  for (int i = 0; i < e_bits; i++) {
+    mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
+  }
+  mean /= e_bits;
+
+  return mean;
+}
+
+// Fills the message fields once its payload has been decoded
+static void pdcch_msg_decoded(srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg, uint32_t nof_bits, double mean)
+{
+  msg->nof_bits = nof_bits;
+  // Check format differentiation
+  if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
+    msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
+  }
+  INFO("Decoded DCI: nCCE=%d, L=%d, format=%s, msg_len=%d, mean=%f, crc_rem=0x%x",
+       msg->location.ncce,
+       msg->location.L,
+       srsran_dci_format_string(msg->format),
+       nof_bits,
+       mean,
+       msg->rnti);
+}
+
 /** Tries to decode a DCI message from the LLRs stored in the srsran_pdcch_t structure by the function
  * srsran_pdcch_extract_llr(). This function can be called multiple times.
  * The location to search for is obtained from msg.
@@ -377,49 +429,118 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
  */
 int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg)
 {
-  int ret = SRSRAN_ERROR_INVALID_INPUTS;
-  if (q != NULL && msg != NULL && srsran_dci_location_isvalid(&msg->location)) {
-    if (msg->location.ncce * 72 + PDCCH_FORMAT_NOF_BITS(msg->location.L) > NOF_CCE(sf->cfi) * 72) {
-      ERROR("Invalid location: nCCE: %d, L: %d, NofCCE: %d", msg->location.ncce, msg->location.L, NOF_CCE(sf->cfi));
+  if (q == NULL || msg == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  double mean = pdcch_msg_llr_mean(q, sf, msg);
+  if (mean < 0.0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t nof_bits = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, msg->format);
+  uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
+
+  if (mean > 0.3f) {
+    int ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
+    if (ret == SRSRAN_SUCCESS) {
+      pdcch_msg_decoded(dci_cfg, msg, nof_bits, mean);
     } else {
-      ret = SRSRAN_SUCCESS;
+      ERROR("Error calling pdcch_dci_decode");
+    }
+    return ret;
+  }
 
-      uint32_t nof_bits = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, msg->format);
-      uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
+  INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, mean=%f", msg->location.ncce, msg->location.L, nof_bits, mean);
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pdcch_decode_msg_batch(srsran_pdcch_t*     q,
+                                  srsran_dl_sf_cfg_t* sf,
+                                  srsran_dci_cfg_t*   dci_cfg,
+                                  srsran_dci_msg_t*   msg,
+                                  uint32_t            nof_msg)
+{
+  if (q == NULL || msg == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-      // Compute absolute mean of the LLRs
-      double mean = 0;
-      for (int i = 0; i < e_bits; i++) {
-        mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
+  // Without batch buffers (i.e. eNB), decode the messages one by one
+  if (q->rm_f_batch == NULL) {
+    for (uint32_t i = 0; i < nof_msg; i++) {
+      int ret = srsran_pdcch_decode_msg(q, sf, dci_cfg, &msg[i]);
+      if (ret < SRSRAN_SUCCESS) {
+        return ret;
       }
-      mean /= e_bits;
-
-      if (mean > 0.3f) {
-        ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
-        if (ret == SRSRAN_SUCCESS) {
-          msg->nof_bits = nof_bits;
-          // Check format differentiation
-          if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
-            msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
-          }
-        } else {
-          ERROR("Error calling pdcch_dci_decode");
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  // The messages are processed in chunks of up to one batch, which are grouped by size
+  for (uint32_t i = 0; i < nof_msg; i += SRSRAN_VITERBI_MAX_BATCH) {
+    uint32_t chunk_len = SRSRAN_MIN(SRSRAN_VITERBI_MAX_BATCH, nof_msg - i);
+    uint32_t nof_bits[SRSRAN_VITERBI_MAX_BATCH];
+    double   mean[SRSRAN_VITERBI_MAX_BATCH];
+    bool     pending[SRSRAN_VITERBI_MAX_BATCH];
+
+    for (uint32_t j = 0; j < chunk_len; j++) {
+      srsran_dci_msg_t* m = &msg[i + j];
+
+      mean[j] = pdcch_msg_llr_mean(q, sf, m);
+      if (mean[j] < 0.0) {
+        return SRSRAN_ERROR_INVALID_INPUTS;
+      }
+      nof_bits[j] = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, m->format);
+      pending[j]  = mean[j] > 0.3f;
+      if (!pending[j]) {
+        INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, mean=%f", m->location.ncce, m->location.L, nof_bits[j], mean[j]);
+      } else if (nof_bits[j] > SRSRAN_DCI_MAX_BITS) {
+        ERROR("Invalid parameters: nof_bits: %d", nof_bits[j]);
+        return SRSRAN_ERROR_INVALID_INPUTS;
+      }
+    }
+
+    for (uint32_t j = 0; j < chunk_len; j++) {
+      if (!pending[j]) {
+        continue;
+      }
+
+      // Rate dematch all the pending messages with the same size
+      float*   symbols[SRSRAN_VITERBI_MAX_BATCH];
+      uint8_t* data[SRSRAN_VITERBI_MAX_BATCH];
+      uint32_t idx[SRSRAN_VITERBI_MAX_BATCH];
+      uint32_t nof_batch = 0;
+      uint32_t coded_len = 3 * (nof_bits[j] + 16);
+      for (uint32_t k = j; k < chunk_len; k++) {
+        if (!pending[k] || nof_bits[k] != nof_bits[j]) {
+          continue;
         }
-        INFO("Decoded DCI: nCCE=%d, L=%d, format=%s, msg_len=%d, mean=%f, crc_rem=0x%x",
-             msg->location.ncce,
-             msg->location.L,
-             srsran_dci_format_string(msg->format),
-             nof_bits,
-             mean,
-             msg->rnti);
-      } else {
-        INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, mean=%f", msg->location.ncce, msg->location.L, nof_bits, mean);
+        srsran_dci_msg_t* m = &msg[i + k];
+
+        symbols[nof_batch] = &q->rm_f_batch[nof_batch * 3 * (SRSRAN_DCI_MAX_BITS + 16)];
+        data[nof_batch]    = m->payload;
+        idx[nof_batch]     = k;
+        srsran_vec_f_zero(symbols[nof_batch], 3 * (SRSRAN_DCI_MAX_BITS + 16));
+        srsran_rm_conv_rx(
+            &q->llr[m->location.ncce * 72], PDCCH_FORMAT_NOF_BITS(m->location.L), symbols[nof_batch], coded_len);
+        pending[k] = false;
+        nof_batch++;
+      }
+
+      if (srsran_viterbi_decode_f_batch(&q->decoder, symbols, data, nof_batch, nof_bits[j] + 16) < SRSRAN_SUCCESS) {
+        ERROR("Error calling pdcch_dci_decode");
+        return SRSRAN_ERROR;
+      }
+
+      for (uint32_t k = 0; k < nof_batch; k++) {
+        srsran_dci_msg_t* m = &msg[i + idx[k]];
+        m->rnti             = pdcch_dci_crc_rem(q, m->payload, nof_bits[j]);
+        pdcch_msg_decoded(dci_cfg, m, nof_bits[j], mean[idx[k]]);
       }
     }
-  } else if (msg != NULL) {
-    ERROR("Invalid parameters, location=%d,%d", msg->location.ncce, msg->location.L);
   }
-  return ret;
+
+  return SRSRAN_SUCCESS;
 }
 
 float srsran_pdcch_msg_corr(srsran_pdcch_t* q, srsran_dci_msg_t* msg)
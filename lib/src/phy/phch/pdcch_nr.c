@@ -173,6 +173,11 @@ static int pdcch_nr_init_common(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args
     return SRSRAN_ERROR;
   }
 
+  q->llr = srsran_vec_i8_malloc(SRSRAN_PDCCH_MAX_RE * 2);
+  if (q->llr == NULL) {
+    return SRSRAN_ERROR;
+  }
+
   q->allocated = srsran_vec_u8_malloc(NMAX);
   if (q->allocated == NULL) {
     return SRSRAN_ERROR;
@@ -226,11 +231,13 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
     return SRSRAN_ERROR;
   }
 
-  srsran_polar_decoder_type_t decoder_type = SRSRAN_POLAR_DECODER_SSC_C;
+  srsran_polar_decoder_type_t decoder_type       = SRSRAN_POLAR_DECODER_SSC_C;
+  srsran_polar_decoder_type_t decoder_batch_type = SRSRAN_POLAR_DECODER_SSC_C;
 
 #ifdef LV_HAVE_AVX2
   if (!args->disable_simd) {
-    decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+    decoder_type       = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+    decoder_batch_type = SRSRAN_POLAR_DECODER_SSC_C_BATCH;
   }
 #endif // LV_HAVE_AVX2
 
@@ -238,6 +245,22 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
     return SRSRAN_ERROR;
   }
 
+  if (srsran_polar_decoder_init(&q->decoder_batch, decoder_batch_type, NMAX_LOG) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR; i++) {
+    q->batch[i].d = srsran_vec_i8_malloc(NMAX);
+    if (q->batch[i].d == NULL) {
+      return SRSRAN_ERROR;
+    }
+
+    q->batch[i].allocated = srsran_vec_u8_malloc(NMAX);
+    if (q->batch[i].allocated == NULL) {
+      return SRSRAN_ERROR;
+    }
+  }
+
   if (srsran_polar_rm_rx_init_c(&q->rm) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
@@ -262,9 +285,19 @@ void srsran_pdcch_nr_free(srsran_pdcch_nr_t* q)
     srsran_polar_rm_tx_free(&q->rm);
   } else {
     srsran_polar_decoder_free(&q->decoder);
+    srsran_polar_decoder_free(&q->decoder_batch);
     srsran_polar_rm_rx_free_c(&q->rm);
   }
 
+  for (uint32_t i = 0; i < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR; i++) {
+    if (q->batch[i].d) {
+      free(q->batch[i].d);
+    }
+    if (q->batch[i].allocated) {
+      free(q->batch[i].allocated);
+    }
+  }
+
   if (q->c) {
     free(q->c);
   }
@@ -285,6 +318,10 @@ void srsran_pdcch_nr_free(srsran_pdcch_nr_t* q)
     free(q->symbols);
   }
 
+  if (q->llr) {
+    free(q->llr);
+  }
+
   srsran_modem_table_free(&q->modem_table);
 
   if (q->evm_buffer) {
@@ -469,6 +506,22 @@ static uint32_t pdcch_nr_c_init(const srsran_pdcch_nr_t* q, const srsran_dci_msg
   return ((n_rnti << 16U) + n_id) & 0x7fffffffU;
 }
 
+/// Gets the polar code for the current K and E, unless it was already computed for the previous transmission
+static int pdcch_nr_get_code(srsran_pdcch_nr_t* q)
+{
+  if (q->code_E == q->E && q->code.K == q->K) {
+    return SRSRAN_SUCCESS;
+  }
+
+  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
+    q->code_E = 0;
+    return SRSRAN_ERROR;
+  }
+  q->code_E = q->E;
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_msg, cf_t* slot_symbols)
 {
   if (q == NULL || dci_msg == NULL || slot_symbols == NULL) {
@@ -487,7 +540,7 @@ int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_
   uint32_t cinit = pdcch_nr_c_init(q, dci_msg);                              // Pseudo-random sequence initiation
 
   // Get polar code
-  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
+  if (pdcch_nr_get_code(q) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   PDCCH_INFO_TX("K=%d; E=%d; M=%d; n=%d; cinit=%08x;", q->K, q->E, q->M, q->code.n, cinit);
@@ -569,81 +622,98 @@ int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_
   return SRSRAN_SUCCESS;
 }
 
-int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
-                           cf_t*                   slot_symbols,
-                           srsran_dmrs_pdcch_ce_t* ce,
-                           srsran_dci_msg_nr_t*    dci_msg,
-                           srsran_pdcch_nr_res_t*  res)
+int srsran_pdcch_nr_demodulate(srsran_pdcch_nr_t*           q,
+                               cf_t*                        slot_symbols,
+                               srsran_dmrs_pdcch_ce_t*      ce,
+                               const srsran_dci_location_t* location)
 {
-  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL) {
+  if (q == NULL || ce == NULL || slot_symbols == NULL || location == NULL) {
     return SRSRAN_ERROR;
   }
 
-  struct timeval t[3];
-  if (q->meas_time_en) {
-    gettimeofday(&t[1], NULL);
-  }
-
-  // Calculate...
-  q->K = dci_msg->nof_bits + 24U;                                  // Payload size including CRC
-  q->M = (1U << dci_msg->ctx.location.L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
-  q->E = q->M * 2;                                                 // Number of Rate-Matched bits
+  // Calculate number of RE and soft bits of the location
+  uint32_t M = (1U << location->L) * (SRSRAN_NRE - 3U) * 6U;
 
   // Check number of estimates is correct
-  if (ce->nof_re != q->M) {
-    ERROR("Invalid number of channel estimates (%d != %d)", q->M, ce->nof_re);
-    return SRSRAN_ERROR;
-  }
-
-  // Get polar code
-  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
+  if (ce->nof_re != M) {
+    ERROR("Invalid number of channel estimates (%d != %d)", M, ce->nof_re);
     return SRSRAN_ERROR;
   }
-  PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
 
   // Get symbols from grid
-  uint32_t m = pdcch_nr_cp(q, &dci_msg->ctx.location, slot_symbols, q->symbols, false);
-  if (q->M != m) {
-    ERROR("Unmatch number of RE (%d != %d)", m, q->M);
+  uint32_t m = pdcch_nr_cp(q, location, slot_symbols, q->symbols, false);
+  if (M != m) {
+    ERROR("Unmatch number of RE (%d != %d)", m, M);
     return SRSRAN_ERROR;
   }
 
   // Print channel estimates if enabled
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     PDCCH_DEBUG_RX("ce=");
-    srsran_vec_fprint_c(stdout, ce->ce, q->M);
+    srsran_vec_fprint_c(stdout, ce->ce, M);
   }
 
   // Equalise
-  srsran_predecoding_single(q->symbols, ce->ce, q->symbols, NULL, q->M, 1.0f, ce->noise_var);
+  srsran_predecoding_single(q->symbols, ce->ce, q->symbols, NULL, M, 1.0f, ce->noise_var);
 
   // Print symbols if enabled
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     PDCCH_DEBUG_RX("symbols=");
-    srsran_vec_fprint_c(stdout, q->symbols, q->M);
+    srsran_vec_fprint_c(stdout, q->symbols, M);
   }
 
   // Demodulation
-  int8_t* llr = (int8_t*)q->f;
-  srsran_demod_soft_demodulate_b(SRSRAN_MOD_QPSK, q->symbols, llr, q->M);
+  srsran_demod_soft_demodulate_b(SRSRAN_MOD_QPSK, q->symbols, q->llr, M);
 
   // Measure EVM if configured
   if (q->evm_buffer != NULL) {
-    res->evm = srsran_evm_run_b(q->evm_buffer, &q->modem_table, q->symbols, llr, q->E);
+    q->llr_evm = srsran_evm_run_b(q->evm_buffer, &q->modem_table, q->symbols, q->llr, M * 2);
   } else {
-    res->evm = NAN;
+    q->llr_evm = NAN;
   }
 
   // Negate all LLR
-  for (uint32_t i = 0; i < q->E; i++) {
-    llr[i] *= -1;
+  for (uint32_t i = 0; i < M * 2; i++) {
+    q->llr[i] *= -1;
   }
 
-  // Descrambling
-  srsran_sequence_apply_c(llr, llr, q->E, pdcch_nr_c_init(q, dci_msg));
+  q->llr_location = *location;
+  q->llr_count    = M * 2;
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Descrambles and de-rate-matches the soft bits of the last demodulated location for a DCI message into d
+static int pdcch_nr_dematch(srsran_pdcch_nr_t*         q,
+                            const srsran_dci_msg_nr_t* dci_msg,
+                            srsran_pdcch_nr_res_t*     res,
+                            int8_t*                    d)
+{
+  // Calculate...
+  q->K = dci_msg->nof_bits + 24U;                                  // Payload size including CRC
+  q->M = (1U << dci_msg->ctx.location.L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
+  q->E = q->M * 2;                                                 // Number of Rate-Matched bits
+
+  // The soft bits shall belong to the DCI location
+  if (q->llr_count != q->E || q->llr_location.L != dci_msg->ctx.location.L ||
+      q->llr_location.ncce != dci_msg->ctx.location.ncce) {
+    ERROR("The DCI location L=%d;ncce=%d was not demodulated", dci_msg->ctx.location.L, dci_msg->ctx.location.ncce);
+    return SRSRAN_ERROR;
+  }
+
+  // Get polar code
+  if (pdcch_nr_get_code(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
+
+  res->evm = q->llr_evm;
+
+  // Descrambling, the demodulated soft bits are kept for decoding other DCI sizes in the same location
+  int8_t* llr = (int8_t*)q->f;
+  srsran_sequence_apply_c(q->llr, llr, q->E, pdcch_nr_c_init(q, dci_msg));
 
   // Un-rate matching
-  int8_t* d = (int8_t*)q->d;
   if (srsran_polar_rm_rx_c(&q->rm, llr, d, q->E, q->code.n, q->K, PDCCH_NR_POLAR_RM_IBIL) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
@@ -654,15 +724,18 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
     srsran_vec_fprint_bs(stdout, d, q->K);
   }
 
-  // Decode
-  if (srsran_polar_decoder_decode_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
-      SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
+  return SRSRAN_SUCCESS;
+}
 
+/// Extracts the DCI message from the polar decoder output and checks its CRC, the polar code shall be the DCI one
+static void pdcch_nr_check(srsran_pdcch_nr_t*     q,
+                           const uint8_t*         allocated,
+                           srsran_dci_msg_nr_t*   dci_msg,
+                           srsran_pdcch_nr_res_t* res)
+{
   // De-allocate channel
   uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
-  srsran_polar_chanalloc_rx(q->allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+  srsran_polar_chanalloc_rx(allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
 
   // Set first L bits to ones, c will have an offset of 24 bits
   uint8_t* c = q->c;
@@ -700,6 +773,132 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
 
   // Copy DCI message
   srsran_vec_u8_copy(dci_msg->payload, c, dci_msg->nof_bits);
+}
+
+int srsran_pdcch_nr_decode_demodulated(srsran_pdcch_nr_t* q, srsran_dci_msg_nr_t* dci_msg, srsran_pdcch_nr_res_t* res)
+{
+  if (q == NULL || dci_msg == NULL || res == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  int8_t* d = (int8_t*)q->d;
+  if (pdcch_nr_dematch(q, dci_msg, res, d) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Decode
+  if (srsran_polar_decoder_decode_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
+      SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  pdcch_nr_check(q, q->allocated, dci_msg, res);
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pdcch_nr_decode_batch_add(srsran_pdcch_nr_t* q, srsran_dci_msg_nr_t* dci_msg, srsran_pdcch_nr_res_t* res)
+{
+  if (q == NULL || dci_msg == NULL || res == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  // Make room in the queue
+  if (q->batch_count >= SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR) {
+    if (srsran_pdcch_nr_decode_batch_run(q) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  srsran_pdcch_nr_cand_t* cand = &q->batch[q->batch_count];
+  if (pdcch_nr_dematch(q, dci_msg, res, cand->d) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  cand->dci_msg = dci_msg;
+  cand->res     = res;
+  cand->K       = q->K;
+  cand->E       = q->E;
+  q->batch_count++;
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pdcch_nr_decode_batch_run(srsran_pdcch_nr_t* q)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  // The queue is emptied even if the decoding fails
+  uint32_t nof_cand = q->batch_count;
+  q->batch_count    = 0;
+
+  bool decoded[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR] = {};
+  for (uint32_t i = 0; i < nof_cand; i++) {
+    if (decoded[i]) {
+      continue;
+    }
+
+    // Gather the pending candidates that share the polar code with the first one
+    const int8_t* d[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
+    uint8_t*      allocated[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
+    uint32_t      idx[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
+    uint32_t      count = 0;
+    for (uint32_t j = i; j < nof_cand; j++) {
+      if (!decoded[j] && q->batch[j].K == q->batch[i].K && q->batch[j].E == q->batch[i].E) {
+        d[count]         = q->batch[j].d;
+        allocated[count] = q->batch[j].allocated;
+        idx[count]       = j;
+        decoded[j]       = true;
+        count++;
+      }
+    }
+
+    // Get polar code
+    q->K = q->batch[i].K;
+    q->E = q->batch[i].E;
+    q->M = q->E / 2;
+    if (pdcch_nr_get_code(q) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    // Decode
+    if (srsran_polar_decoder_decode_c_batch(
+            &q->decoder_batch, d, allocated, count, q->code.n, q->code.F_set, q->code.F_set_size) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t j = 0; j < count; j++) {
+      srsran_pdcch_nr_cand_t* cand = &q->batch[idx[j]];
+      pdcch_nr_check(q, cand->allocated, cand->dci_msg, cand->res);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
+                           cf_t*                   slot_symbols,
+                           srsran_dmrs_pdcch_ce_t* ce,
+                           srsran_dci_msg_nr_t*    dci_msg,
+                           srsran_pdcch_nr_res_t*  res)
+{
+  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
+
+  if (srsran_pdcch_nr_demodulate(q, slot_symbols, ce, &dci_msg->ctx.location) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_pdcch_nr_decode_demodulated(q, dci_msg, res) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
 
   if (q->meas_time_en) {
     gettimeofday(&t[2], NULL);
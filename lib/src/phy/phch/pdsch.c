@@ -40,6 +40,13 @@
 
 #define MAX_PDSCH_RE(cp) (2 * SRSRAN_CP_NSYMB(cp) * 12)
 
+/* Number of bits scrambled and modulated at a time, multiple of the scrambling sequence word (24 bits) and of the
+ * bytes taken by the modulator for every modulation order */
+#define PDSCH_SCRAMBLE_MOD_BLOCK 1536
+
+/* Alignment of the codewords of srsran_pdsch_encode_batch() in the coded bits and modulated symbols buffers */
+#define PDSCH_BATCH_ALIGN 32
+
 /* 3GPP 36.213 Table 5.2-1: The cell-specific ratio rho_B / rho_A for 1, 2, or 4 cell specific antenna ports */
 const static float pdsch_cfg_cell_specific_ratio_table[2][4] = {
     /* One antenna port         */ {1.0f / 1.0f, 4.0f / 5.0f, 3.0f / 5.0f, 2.0f / 5.0f},
@@ -957,6 +964,27 @@ int srsran_pdsch_decode(srsran_pdsch_t*        q,
   }
 }
 
+/* Scrambles and modulates a codeword in blocks, so that every block of bits is modulated while it is still in cache */
+static void pdsch_scramble_modulate(srsran_pdsch_t*     q,
+                                    srsran_dl_sf_cfg_t* sf,
+                                    srsran_pdsch_cfg_t* cfg,
+                                    uint32_t            tb_idx,
+                                    uint8_t*            e,
+                                    cf_t*               d)
+{
+  srsran_ra_tb_t*         tb = &cfg->grant.tb[tb_idx];
+  uint32_t                Qm = srsran_mod_bits_x_symbol(tb->mod);
+  srsran_sequence_state_t seq;
+
+  srsran_sequence_pdsch_state_init(&seq, cfg->rnti, tb->cw_idx, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id);
+
+  for (uint32_t i = 0; i < tb->nof_bits; i += PDSCH_SCRAMBLE_MOD_BLOCK) {
+    uint32_t len = SRSRAN_MIN(PDSCH_SCRAMBLE_MOD_BLOCK, tb->nof_bits - i);
+    srsran_sequence_state_apply_packed(&seq, &e[i / 8], &e[i / 8], len);
+    srsran_mod_modulate_bytes(&q->mod[tb->mod], &e[i / 8], &d[i / Qm], len);
+  }
+}
+
 static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
                                         srsran_dl_sf_cfg_t*     sf,
                                         srsran_pdsch_cfg_t*     cfg,
@@ -994,18 +1022,8 @@ static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
       return SRSRAN_ERROR;
     }
 
-    /* Bit scrambling */
-    srsran_sequence_pdsch_apply_pack((uint8_t*)q->e[codeword_idx],
-                                     (uint8_t*)q->e[codeword_idx],
-                                     cfg->rnti,
-                                     codeword_idx,
-                                     2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                     q->cell.id,
-                                     cfg->grant.tb[tb_idx].nof_bits);
-
-    /* Bit mapping */
-    srsran_mod_modulate_bytes(
-        &q->mod[mcs->mod], (uint8_t*)q->e[codeword_idx], q->d[codeword_idx], cfg->grant.tb[tb_idx].nof_bits);
+    /* Bit scrambling and mapping */
+    pdsch_scramble_modulate(q, sf, cfg, tb_idx, (uint8_t*)q->e[codeword_idx], q->d[codeword_idx]);
 
   } else {
     return SRSRAN_ERROR_INVALID_INPUTS;
@@ -1014,6 +1032,84 @@ static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
   return SRSRAN_SUCCESS;
 }
 
+/* Layer mapping, precoding and mapping to resource elements of the modulated codewords of a PDSCH */
+static void pdsch_layermap_precode_put(srsran_pdsch_t*     q,
+                                       srsran_dl_sf_cfg_t* sf,
+                                       srsran_pdsch_cfg_t* cfg,
+                                       cf_t*               d[SRSRAN_MAX_CODEWORDS],
+                                       float               rho_a,
+                                       cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
+{
+  int      i;
+  uint32_t nof_tb = cfg->grant.nof_tb;
+  cf_t*    x[SRSRAN_MAX_LAYERS];
+
+  /* Set scaling configured by Power Allocation */
+  float scaling = 1.0f;
+  if (rho_a != 0.0f) {
+    scaling = rho_a;
+  }
+
+  if (cfg->rnti != SRSRAN_SIRNTI) {
+    INFO("Encoding PDSCH SF: %d rho_a=%f, nof_ports=%d, nof_layers=%d, nof_tb=%d, pmi=%d, tx_scheme=%s",
+         sf->tti % 10,
+         rho_a,
+         q->cell.nof_ports,
+         cfg->grant.nof_layers,
+         nof_tb,
+         cfg->grant.pmi,
+         srsran_mimotype2str(cfg->grant.tx_scheme));
+  }
+
+  // Layer mapping & precode if necessary
+  if (q->cell.nof_ports > 1) {
+    int nof_symbols;
+    /* If number of layers is equal to transport blocks (codewords) skip layer mapping */
+    if (cfg->grant.nof_layers == nof_tb) {
+      for (i = 0; i < cfg->grant.nof_layers; i++) {
+        x[i] = d[i];
+      }
+      nof_symbols = cfg->grant.nof_re;
+    } else {
+      /* Initialise layer map pointers */
+      for (i = 0; i < cfg->grant.nof_layers; i++) {
+        x[i] = q->x[i];
+      }
+      memset(&x[cfg->grant.nof_layers], 0, sizeof(cf_t*) * (SRSRAN_MAX_LAYERS - cfg->grant.nof_layers));
+
+      nof_symbols = srsran_layermap_type(d,
+                                         x,
+                                         nof_tb,
+                                         cfg->grant.nof_layers,
+                                         (int[SRSRAN_MAX_CODEWORDS]){cfg->grant.nof_re, cfg->grant.nof_re},
+                                         cfg->grant.tx_scheme);
+    }
+
+    /* Precode */
+    uint32_t codebook_idx = nof_tb == 1 ? cfg->grant.pmi : (cfg->grant.pmi + 1);
+    srsran_precoding_type(x,
+                          q->symbols,
+                          cfg->grant.nof_layers,
+                          q->cell.nof_ports,
+                          codebook_idx,
+                          nof_symbols,
+                          scaling,
+                          cfg->grant.tx_scheme);
+  } else {
+    if (scaling == 1.0f) {
+      memcpy(q->symbols[0], d[0], cfg->grant.nof_re * sizeof(cf_t));
+    } else {
+      srsran_vec_sc_prod_cfc(d[0], scaling, q->symbols[0], cfg->grant.nof_re);
+    }
+  }
+
+  /* mapping to resource elements */
+  uint32_t lstart = SRSRAN_NOF_CTRL_SYMBOLS(q->cell, sf->cfi);
+  for (i = 0; i < q->cell.nof_ports; i++) {
+    srsran_pdsch_put(q, q->symbols[i], sf_symbols[i], &cfg->grant, lstart, sf->tti % 10);
+  }
+}
+
 int srsran_pdsch_encode(srsran_pdsch_t*     q,
                         srsran_dl_sf_cfg_t* sf,
                         srsran_pdsch_cfg_t* cfg,
@@ -1021,9 +1117,7 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
                         cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
 {
   int i;
-  /* Set pointers for layermapping & precoding */
-  cf_t* x[SRSRAN_MAX_LAYERS];
-  int   ret = SRSRAN_ERROR_INVALID_INPUTS;
+  int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
   if (q != NULL && cfg != NULL) {
     struct timeval t[3];
@@ -1064,80 +1158,164 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
       }
     }
 
-    /* Set scaling configured by Power Allocation */
-    float scaling = 1.0f;
-    if (rho_a != 0.0f) {
-      scaling = rho_a;
+    pdsch_layermap_precode_put(q, sf, cfg, q->d, rho_a, sf_symbols);
+
+    if (cfg->meas_time_en) {
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      cfg->meas_time_value = t[0].tv_usec;
     }
 
-    if (cfg->rnti != SRSRAN_SIRNTI) {
-      INFO("Encoding PDSCH SF: %d rho_a=%f, nof_ports=%d, nof_layers=%d, nof_tb=%d, pmi=%d, tx_scheme=%s",
-           sf->tti % 10,
-           rho_a,
-           q->cell.nof_ports,
-           cfg->grant.nof_layers,
-           nof_tb,
-           cfg->grant.pmi,
-           srsran_mimotype2str(cfg->grant.tx_scheme));
-    }
-
-    // Layer mapping & precode if necessary
-    if (q->cell.nof_ports > 1) {
-      int nof_symbols;
-      /* If number of layers is equal to transport blocks (codewords) skip layer mapping */
-      if (cfg->grant.nof_layers == nof_tb) {
-        for (i = 0; i < cfg->grant.nof_layers; i++) {
-          x[i] = q->d[i];
+    ret = SRSRAN_SUCCESS;
+  }
+  return ret;
+}
+
+static int pdsch_encode_batch_check(srsran_pdsch_t* q, srsran_pdsch_cfg_t* cfg)
+{
+  if (cfg == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!cfg->grant.nof_tb) {
+    ERROR("Error number of TB is zero");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (cfg->grant.nof_re > q->max_re) {
+    ERROR("Error too many RE per subframe (%d). PDSCH configured for %d RE (%d PRB)",
+          cfg->grant.nof_re,
+          q->max_re,
+          q->cell.nof_prb);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t tb_idx = 0; tb_idx < SRSRAN_MAX_TB; tb_idx++) {
+    if (cfg->grant.tb[tb_idx].enabled && cfg->softbuffers.tx[tb_idx] == NULL) {
+      ERROR("Error encoding (TB%d -> CW%d), softbuffer=NULL", tb_idx, cfg->grant.tb[tb_idx].cw_idx);
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pdsch_encode_batch(srsran_pdsch_t*          q,
+                              srsran_dl_sf_cfg_t*      sf,
+                              srsran_pdsch_cfg_t*      cfg[],
+                              uint8_t*                 data[][SRSRAN_MAX_CODEWORDS],
+                              uint32_t                 nof_pdsch,
+                              cf_t*                    sf_symbols[SRSRAN_MAX_PORTS],
+                              srsran_pdsch_enc_time_t* time)
+{
+  if (q == NULL || sf == NULL || (nof_pdsch > 0 && (cfg == NULL || data == NULL))) {
+    ERROR("Invalid inputs");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < q->cell.nof_ports; i++) {
+    if (sf_symbols[i] == NULL) {
+      ERROR("Error NULL pointer in sf_symbols[%d]", i);
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
+  // Check all the PDSCH first, so that the resource grid is left untouched if any of them fails these checks
+  for (uint32_t p = 0; p < nof_pdsch; p++) {
+    int ret = pdsch_encode_batch_check(q, cfg[p]);
+    if (ret) {
+      return ret;
+    }
+  }
+
+  if (time) {
+    SRSRAN_MEM_ZERO(time, srsran_pdsch_enc_time_t, 1);
+  }
+
+  uint32_t p = 0;
+  while (p < nof_pdsch) {
+    srsran_dlsch_batch_tb_t tb[SRSRAN_PDSCH_MAX_BATCH * SRSRAN_MAX_TB];
+    uint32_t                tb_pdsch[SRSRAN_PDSCH_MAX_BATCH * SRSRAN_MAX_TB];
+    cf_t*                   d[SRSRAN_PDSCH_MAX_BATCH][SRSRAN_MAX_CODEWORDS];
+    uint32_t                e_offset[SRSRAN_MAX_CODEWORDS] = {};
+    uint32_t                nof_tb                         = 0;
+    uint32_t                d_offset                       = 0;
+    uint32_t                first                          = p;
+    struct timeval          t[3];
+
+    // The codewords of every PDSCH are placed one after the other in the coded bits and modulated symbols buffers,
+    // each of them aligned to PDSCH_BATCH_ALIGN bytes and symbols respectively
+    while (p < nof_pdsch && p - first < SRSRAN_PDSCH_MAX_BATCH && d_offset + cfg[p]->grant.nof_re <= q->max_re) {
+      for (uint32_t tb_idx = 0; tb_idx < SRSRAN_MAX_TB; tb_idx++) {
+        srsran_ra_tb_t* mcs = &cfg[p]->grant.tb[tb_idx];
+        if (!mcs->enabled) {
+          continue;
         }
-        nof_symbols = cfg->grant.nof_re;
-      } else {
-        /* Initialise layer map pointers */
-        for (i = 0; i < cfg->grant.nof_layers; i++) {
-          x[i] = q->x[i];
+        if (cfg[p]->rnti != SRSRAN_SIRNTI) {
+          INFO("Encoding PDSCH SF: %d (TB%d -> CW%d), Mod %s, NofBits: %d, NofSymbols: %d, NofBitsE: %d, rv_idx: %d",
+               sf->tti % 10,
+               tb_idx,
+               mcs->cw_idx,
+               srsran_mod_string(mcs->mod),
+               mcs->tbs,
+               cfg[p]->grant.nof_re,
+               mcs->nof_bits,
+               mcs->rv);
         }
-        memset(&x[cfg->grant.nof_layers], 0, sizeof(cf_t*) * (SRSRAN_MAX_LAYERS - cfg->grant.nof_layers));
-
-        nof_symbols = srsran_layermap_type(q->d,
-                                           x,
-                                           nof_tb,
-                                           cfg->grant.nof_layers,
-                                           (int[SRSRAN_MAX_CODEWORDS]){cfg->grant.nof_re, cfg->grant.nof_re},
-                                           cfg->grant.tx_scheme);
+        tb[nof_tb].cfg    = cfg[p];
+        tb[nof_tb].tb_idx = tb_idx;
+        tb[nof_tb].data   = data[p][tb_idx];
+        tb[nof_tb].e_bits = (uint8_t*)q->e[mcs->cw_idx] + e_offset[mcs->cw_idx];
+        tb_pdsch[nof_tb]  = p - first;
+        nof_tb++;
+
+        e_offset[mcs->cw_idx] += SRSRAN_CEIL(mcs->nof_bits, 8 * PDSCH_BATCH_ALIGN) * PDSCH_BATCH_ALIGN;
       }
-
-      /* Precode */
-      uint32_t codebook_idx = nof_tb == 1 ? cfg->grant.pmi : (cfg->grant.pmi + 1);
-      srsran_precoding_type(x,
-                            q->symbols,
-                            cfg->grant.nof_layers,
-                            q->cell.nof_ports,
-                            codebook_idx,
-                            nof_symbols,
-                            scaling,
-                            cfg->grant.tx_scheme);
-    } else {
-      if (scaling == 1.0f) {
-        memcpy(q->symbols[0], q->d[0], cfg->grant.nof_re * sizeof(cf_t));
-      } else {
-        srsran_vec_sc_prod_cfc(q->d[0], scaling, q->symbols[0], cfg->grant.nof_re);
+      for (uint32_t cw = 0; cw < SRSRAN_MAX_CODEWORDS; cw++) {
+        d[p - first][cw] = &q->d[cw][d_offset];
       }
+      d_offset += SRSRAN_CEIL(cfg[p]->grant.nof_re, PDSCH_BATCH_ALIGN) * PDSCH_BATCH_ALIGN;
+      p++;
     }
 
-    /* mapping to resource elements */
-    uint32_t lstart = SRSRAN_NOF_CTRL_SYMBOLS(q->cell, sf->cfi);
-    for (i = 0; i < q->cell.nof_ports; i++) {
-      srsran_pdsch_put(q, q->symbols[i], sf_symbols[i], &cfg->grant, lstart, sf->tti % 10);
+    /* Channel coding of all the transport blocks */
+    gettimeofday(&t[1], NULL);
+    if (srsran_dlsch_encode_batch(&q->dl_sch, tb, nof_tb)) {
+      ERROR("Error encoding PDSCH batch");
+      return SRSRAN_ERROR;
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    if (time) {
+      time->coding_us += t[0].tv_usec;
     }
 
-    if (cfg->meas_time_en) {
-      gettimeofday(&t[2], NULL);
-      get_time_interval(t);
-      cfg->meas_time_value = t[0].tv_usec;
+    /* Bit scrambling and mapping */
+    gettimeofday(&t[1], NULL);
+    for (uint32_t i = 0; i < nof_tb; i++) {
+      uint32_t cw = tb[i].cfg->grant.tb[tb[i].tb_idx].cw_idx;
+      pdsch_scramble_modulate(q, sf, tb[i].cfg, tb[i].tb_idx, tb[i].e_bits, d[tb_pdsch[i]][cw]);
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    if (time) {
+      time->modulation_us += t[0].tv_usec;
     }
 
-    ret = SRSRAN_SUCCESS;
+    /* Power allocation, layer mapping, precoding and resource mapping, in the same order as sequential encoding */
+    gettimeofday(&t[1], NULL);
+    for (uint32_t i = first; i < p; i++) {
+      float rho_a = apply_power_allocation(q, cfg[i], sf_symbols);
+      pdsch_layermap_precode_put(q, sf, cfg[i], d[i - first], rho_a, sf_symbols);
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    if (time) {
+      time->mapping_us += t[0].tv_usec;
+    }
   }
-  return ret;
+
+  return SRSRAN_SUCCESS;
 }
 
 int srsran_pdsch_select_pmi(srsran_pdsch_t*        q,
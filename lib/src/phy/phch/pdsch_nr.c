@@ -116,6 +116,7 @@ int srsran_pdsch_nr_init_ue(srsran_pdsch_nr_t* q, const srsran_pdsch_nr_args_t*
   }
 
   q->meas_time_en = args->measure_time;
+  q->fused_eq_en  = args->fused_equalizer;
 
   return SRSRAN_SUCCESS;
 }
@@ -423,11 +424,12 @@ int srsran_pdsch_nr_encode(srsran_pdsch_nr_t*           q,
   return SRSRAN_SUCCESS;
 }
 
-static inline int pdsch_nr_decode_codeword(srsran_pdsch_nr_t*         q,
-                                           const srsran_sch_cfg_nr_t* cfg,
-                                           const srsran_sch_tb_t*     tb,
-                                           srsran_pdsch_res_nr_t*     res,
-                                           uint16_t                   rnti)
+static inline int pdsch_nr_decode_codeword(srsran_pdsch_nr_t*           q,
+                                           const srsran_sch_cfg_nr_t*   cfg,
+                                           const srsran_sch_tb_t*       tb,
+                                           const srsran_chest_dl_res_t* channel,
+                                           srsran_pdsch_res_nr_t*       res,
+                                           uint16_t                     rnti)
 {
   // Early return if TB is not enabled
   if (!tb->enabled) {
@@ -446,15 +448,23 @@ static inline int pdsch_nr_decode_codeword(srsran_pdsch_nr_t*         q,
     return SRSRAN_ERROR_OUT_OF_BOUNDS;
   }
 
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-    DEBUG("d=");
-    srsran_vec_fprint_c(stdout, q->d[tb->cw_idx], tb->nof_re);
-  }
-
-  // Demodulation
   int8_t* llr = (int8_t*)q->b[tb->cw_idx];
-  if (srsran_demod_soft_demodulate_b(tb->mod, q->d[tb->cw_idx], llr, tb->nof_re)) {
-    return SRSRAN_ERROR;
+  if (channel != NULL) {
+    // Equalization and demodulation in a single pass, the equalized symbols are not stored
+    if (srsran_demod_soft_equalize_demodulate_b(
+            tb->mod, q->x[0], channel->ce[0][0], 1.0f, channel->noise_estimate, llr, tb->nof_re)) {
+      return SRSRAN_ERROR;
+    }
+  } else {
+    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+      DEBUG("d=");
+      srsran_vec_fprint_c(stdout, q->d[tb->cw_idx], tb->nof_re);
+    }
+
+    // Demodulation
+    if (srsran_demod_soft_demodulate_b(tb->mod, q->d[tb->cw_idx], llr, tb->nof_re)) {
+      return SRSRAN_ERROR;
+    }
   }
 
   // EVM
@@ -537,7 +547,14 @@ int srsran_pdsch_nr_decode(srsran_pdsch_nr_t*           q,
 
   // Antenna port demapping
   // ... Not implemented
-  srsran_predecoding_single(q->x[0], channel->ce[0][0], q->d[0], NULL, nof_re, 1.0f, channel->noise_estimate);
+
+  // When enabled, the equalizer is fused with the demodulator for a single layer, unless the equalized symbols are
+  // needed for the EVM measurement or the debug trace
+  bool fused_eq = q->fused_eq_en && grant->nof_layers == 1 && q->evm_buffer == NULL &&
+                  !(SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG);
+  if (!fused_eq) {
+    srsran_predecoding_single(q->x[0], channel->ce[0][0], q->d[0], NULL, nof_re, 1.0f, channel->noise_estimate);
+  }
 
   // Layer demapping
   if (grant->nof_layers > 1) {
@@ -546,7 +563,8 @@ int srsran_pdsch_nr_decode(srsran_pdsch_nr_t*           q,
 
   // SCH decode
   for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
-    if (pdsch_nr_decode_codeword(q, cfg, &grant->tb[tb], data, grant->rnti) < SRSRAN_SUCCESS) {
+    if (pdsch_nr_decode_codeword(q, cfg, &grant->tb[tb], fused_eq ? channel : NULL, data, grant->rnti) <
+        SRSRAN_SUCCESS) {
       ERROR("Error encoding TB %d", tb);
       return SRSRAN_ERROR;
     }
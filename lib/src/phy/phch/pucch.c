@@ -23,6 +23,7 @@
 #include "srsran/srsran.h"
 #include <assert.h>
 #include <complex.h>
+#include <float.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -69,6 +70,12 @@ int srsran_pucch_init_(srsran_pucch_t* q, bool is_ue)
 
     if (!q->is_ue) {
       q->ce = srsran_vec_cf_malloc(SRSRAN_PUCCH_MAX_SYMBOLS);
+
+      for (uint32_t n = 0; n < SRSRAN_NRE; n++) {
+        for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+          q->cs_dft[n][k] = cexpf(-I * 2 * M_PI * (float)(n * k) / SRSRAN_NRE);
+        }
+      }
     }
 
     ret = SRSRAN_SUCCESS;
@@ -250,6 +257,10 @@ static const cf_t pucch3_w_n_oc_5[5][5] = {
 
 #endif // defined(__clang__)
 
+// Table 5.5.2.2.1-2 Orthogonal sequences for the format 1, 1a and 1b DMRS (complex argument)
+static const float w_dmrs_n_oc_cpnorm[3][3] = {{0, 0, 0}, {0, 2 * M_PI / 3, 4 * M_PI / 3}, {0, 4 * M_PI / 3, 2 * M_PI / 3}};
+static const float w_dmrs_n_oc_cpext[3][2]  = {{0, 0}, {0, M_PI}, {0, 0}};
+
 static const cf_t pucch3_w_n_oc_4[4][4] = {{+1, +1, +1, +1}, {+1, -1, +1, -1}, {+1, +1, -1, -1}, {+1, -1, -1, +1}};
 
 static uint32_t get_N_sf(srsran_pucch_format_t format, uint32_t slot_idx, bool shortened)
@@ -871,6 +882,358 @@ int srsran_pucch_decode(srsran_pucch_t*        q,
   return ret;
 }
 
+/* Cyclic shift domain representation of the PRBs shared by several format 1, 1a and 1b resources */
+typedef struct {
+  cf_t  bins[SRSRAN_NOF_SLOTS_PER_SF][SRSRAN_CP_NORM_NSYMB][SRSRAN_NRE];
+  float noise_bin; // Noise power in a single cyclic shift bin
+  float epre;
+} pucch_cs_bank_t;
+
+static bool pucch_format1_same_prb(srsran_pucch_t* q, const srsran_pucch_cfg_t* a, const srsran_pucch_cfg_t* b)
+{
+  return a->group_hopping_en == b->group_hopping_en && srsran_pucch_m(a, q->cell.cp) == srsran_pucch_m(b, q->cell.cp);
+}
+
+/* Returns the cyclic shift of a format 1 resource, the same way encode_signal_format12() and the DMRS generator do */
+static uint32_t pucch_format1_n_cs(srsran_pucch_t*           q,
+                                   const srsran_pucch_cfg_t* cfg,
+                                   uint32_t                  ns,
+                                   uint32_t                  l,
+                                   uint32_t*                 n_oc,
+                                   uint32_t*                 n_prime_ns)
+{
+  float alpha = srsran_pucch_alpha_format1(q->n_cs_cell, cfg, q->cell.cp, true, ns, l, n_oc, n_prime_ns);
+  return (uint32_t)roundf(alpha * SRSRAN_NRE / (2 * M_PI)) % SRSRAN_NRE;
+}
+
+static const float* pucch_format1_w(srsran_pucch_t* q, bool is_dmrs, uint32_t N_sf, uint32_t n_oc)
+{
+  if (is_dmrs) {
+    return SRSRAN_CP_ISNORM(q->cell.cp) ? w_dmrs_n_oc_cpnorm[n_oc % 3] : w_dmrs_n_oc_cpext[n_oc % 3];
+  }
+  return w_n_oc[N_sf == 3 ? 1 : 0][n_oc % 3];
+}
+
+/* Estimates the noise of a group of symbols (i.e. the DMRS or the data of a slot) from the dimensions of the cyclic
+ * shift and orthogonal cover space that no resource uses. The energy of the used dimensions is subtracted from the total
+ * energy of the symbols, which avoids computing a basis for the unused ones. Returns the number of noise dimensions */
+static uint32_t pucch_cs_bank_noise(srsran_pucch_t*        q,
+                                    srsran_pucch_cfg_t*    cfg,
+                                    uint32_t               nof_cfg,
+                                    uint32_t               idx,
+                                    const pucch_cs_bank_t* bank,
+                                    uint32_t               s,
+                                    uint32_t               ns,
+                                    bool                   is_dmrs,
+                                    uint32_t               nof_symb,
+                                    const uint32_t*        symb,
+                                    float*                 noise)
+{
+  uint32_t c      = SRSRAN_CP_ISNORM(q->cell.cp) ? 3 : 2;
+  bool     mixed  = cfg[idx].N_cs > 0 && cfg[idx].n_pucch < c * cfg[idx].N_cs / cfg[idx].delta_pucch_shift;
+  uint32_t nof_cs = mixed ? cfg[idx].N_cs : SRSRAN_NRE; // The rest of cyclic shifts of the mixed PRB are format 2
+  bool     used[SRSRAN_NRE][3]             = {}; // Indexed by relative cyclic shift and cover
+  float    total                           = 0.0f;
+  uint32_t nof_used                        = 0;
+  uint32_t n_cs_cell[SRSRAN_CP_NORM_NSYMB] = {};
+
+  for (uint32_t m = 0; m < nof_symb; m++) {
+    n_cs_cell[m] = q->n_cs_cell[ns][symb[m]] % SRSRAN_NRE;
+    for (uint32_t r = 0; r < nof_cs; r++) {
+      cf_t b = bank->bins[s][symb[m]][(n_cs_cell[m] + r) % SRSRAN_NRE];
+      total += __real__(b * conjf(b));
+    }
+  }
+
+  for (uint32_t i = idx; i < nof_cfg; i++) {
+    if (!pucch_format1_same_prb(q, &cfg[idx], &cfg[i])) {
+      continue;
+    }
+    uint32_t     n_oc = 0;
+    uint32_t     r    = (pucch_format1_n_cs(q, &cfg[i], ns, symb[0], &n_oc, NULL) + SRSRAN_NRE - n_cs_cell[0]) % SRSRAN_NRE;
+    const float* w    = pucch_format1_w(q, is_dmrs, nof_symb, n_oc);
+
+    // Resources with the same cover (e.g. n_oc 0 and 2 in extended CP DMRS) share the dimension
+    uint32_t oc = n_oc % 3;
+    for (uint32_t k = 0; k < oc; k++) {
+      if (memcmp(pucch_format1_w(q, is_dmrs, nof_symb, k), w, sizeof(float) * nof_symb) == 0) {
+        oc = k;
+        break;
+      }
+    }
+    if (r >= nof_cs || used[r][oc]) {
+      continue;
+    }
+    used[r][oc] = true;
+    nof_used++;
+
+    cf_t p = 0;
+    for (uint32_t m = 0; m < nof_symb; m++) {
+      p += bank->bins[s][symb[m]][(n_cs_cell[m] + r) % SRSRAN_NRE] * cexpf(-I * w[m]);
+    }
+    total -= __real__(p * conjf(p)) / nof_symb;
+  }
+
+  *noise += SRSRAN_MAX(total, 0.0f);
+  return nof_cs * nof_symb - nof_used;
+}
+
+/* Extracts the PRBs of the resource cfg[idx], transforms every symbol into the cyclic shift domain and estimates the
+ * noise taking into account all the resources that share the PRBs */
+static int pucch_cs_bank_compute(srsran_pucch_t*     q,
+                                 srsran_ul_sf_cfg_t* sf,
+                                 srsran_pucch_cfg_t* cfg,
+                                 uint32_t            nof_cfg,
+                                 uint32_t            idx,
+                                 cf_t*               sf_symbols,
+                                 pucch_cs_bank_t*    bank)
+{
+  cf_t     r_u[SRSRAN_NRE];
+  cf_t     z[SRSRAN_NRE];
+  uint32_t nsymbols  = SRSRAN_CP_NSYMB(q->cell.cp);
+  uint32_t n_rs      = srsran_refsignal_dmrs_N_rs(SRSRAN_PUCCH_FORMAT_1, q->cell.cp);
+  uint32_t sf_idx    = sf->tti % SRSRAN_NOF_SF_X_FRAME;
+  float    noise     = 0.0f;
+  uint32_t nof_noise = 0;
+
+  bzero(bank, sizeof(pucch_cs_bank_t));
+
+  for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+    uint32_t ns    = SRSRAN_NOF_SLOTS_PER_SF * sf_idx + s;
+    uint32_t n_prb = srsran_pucch_n_prb(&q->cell, &cfg[idx], s);
+    if (n_prb >= q->cell.nof_prb) {
+      ERROR("Invalid PUCCH n_prb=%d", n_prb);
+      return SRSRAN_ERROR;
+    }
+
+    // Base sequence, the cyclic shifts are resolved by the DFT
+    uint32_t f_gh = cfg[idx].group_hopping_en ? q->f_gh[ns] : 0;
+    uint32_t u    = (f_gh + (q->cell.id % 30)) % 30;
+    if (srsran_zc_sequence_generate_lte(u, 0, 0.0f, 1, r_u) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    uint32_t dmrs_symb[SRSRAN_CP_NORM_NSYMB];
+    uint32_t data_symb[SRSRAN_CP_NORM_NSYMB];
+    uint32_t N_sf = get_N_sf(SRSRAN_PUCCH_FORMAT_1, s, sf->shortened);
+    for (uint32_t m = 0; m < n_rs; m++) {
+      dmrs_symb[m] = srsran_refsignal_dmrs_pucch_symbol(m, SRSRAN_PUCCH_FORMAT_1, q->cell.cp);
+    }
+    for (uint32_t m = 0; m < N_sf; m++) {
+      data_symb[m] = get_pucch_symbol(m, SRSRAN_PUCCH_FORMAT_1, q->cell.cp);
+    }
+
+    for (uint32_t m = 0; m < n_rs + N_sf; m++) {
+      uint32_t l = m < n_rs ? dmrs_symb[m] : data_symb[m - n_rs];
+      cf_t*    y = &sf_symbols[SRSRAN_RE_IDX(q->cell.nof_prb, l + s * nsymbols, n_prb * SRSRAN_NRE)];
+      srsran_vec_prod_conj_ccc(y, r_u, z, SRSRAN_NRE);
+      for (uint32_t n = 0; n < SRSRAN_NRE; n++) {
+        bank->bins[s][l][n] = srsran_vec_dot_prod_ccc(z, q->cs_dft[n], SRSRAN_NRE);
+      }
+
+      // The EPRE is measured over the DMRS, as the channel estimator does
+      if (m < n_rs) {
+        bank->epre += srsran_vec_avg_power_cf(y, SRSRAN_NRE) / (SRSRAN_NOF_SLOTS_PER_SF * n_rs);
+      }
+    }
+
+    nof_noise += pucch_cs_bank_noise(q, cfg, nof_cfg, idx, bank, s, ns, true, n_rs, dmrs_symb, &noise);
+    nof_noise += pucch_cs_bank_noise(q, cfg, nof_cfg, idx, bank, s, ns, false, N_sf, data_symb, &noise);
+  }
+
+  // If every dimension is used (only possible with delta_pucch_shift=1) the noise can not be observed
+  bank->noise_bin = nof_noise ? noise / nof_noise : 0.0f;
+  if (fpclassify(bank->noise_bin) == FP_ZERO) {
+    bank->noise_bin = FLT_MIN;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Maximum likelihood detection of a single format 1, 1a or 1b resource from the correlation bank */
+static void pucch_format1_detect(srsran_pucch_t*        q,
+                                 srsran_ul_sf_cfg_t*    sf,
+                                 const pucch_cs_bank_t* bank,
+                                 srsran_pucch_cfg_t*    cfg,
+                                 srsran_pucch_res_t*    res)
+{
+  uint8_t  pucch_bits[SRSRAN_CQI_MAX_BITS] = {};
+  uint32_t n_rs                            = srsran_refsignal_dmrs_N_rs(cfg->format, q->cell.cp);
+  uint32_t sf_idx                          = sf->tti % SRSRAN_NOF_SF_X_FRAME;
+  cf_t     h[SRSRAN_NOF_SLOTS_PER_SF]      = {};
+  cf_t     dmrs_slot0                      = 0;
+  cf_t     acc                             = 0;
+  float    sig_pwr                         = 0.0f;
+  float    h_pwr                           = 0.0f;
+  float    ta_err                          = 0.0f;
+  uint32_t nof_data                        = 0;
+
+  bzero(res, sizeof(srsran_pucch_res_t));
+
+  for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+    uint32_t ns = SRSRAN_NOF_SLOTS_PER_SF * sf_idx + s;
+
+    // Despread the DMRS, the adjacent cyclic shifts are kept for measuring the time alignment
+    cf_t dmrs[3] = {};
+    for (uint32_t m = 0; m < n_rs; m++) {
+      uint32_t n_oc = 0;
+      uint32_t l    = srsran_refsignal_dmrs_pucch_symbol(m, cfg->format, q->cell.cp);
+      uint32_t n_cs = pucch_format1_n_cs(q, cfg, ns, l, &n_oc, NULL);
+      cf_t     w    = cexpf(-I * pucch_format1_w(q, true, n_rs, n_oc)[m]);
+      for (uint32_t d = 0; d < 3; d++) {
+        dmrs[d] += bank->bins[s][l][(n_cs + SRSRAN_NRE - 1 + d) % SRSRAN_NRE] * w;
+      }
+    }
+    h[s] = dmrs[1] / (float)(SRSRAN_NRE * n_rs);
+    if (s == 0) {
+      dmrs_slot0 = dmrs[1];
+    }
+
+    if (cfg->meas_ta_en) {
+      cf_t ce[SRSRAN_NRE];
+      for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+        ce[k] = dmrs[0] * q->cs_dft[1][k] + dmrs[1] + dmrs[2] * q->cs_dft[SRSRAN_NRE - 1][k];
+      }
+      ta_err += srsran_vec_estimate_frequency(ce, SRSRAN_NRE) / (float)SRSRAN_NOF_SLOTS_PER_SF;
+    }
+
+    // Despread the data symbols and combine them with the channel estimate
+    uint32_t N_sf = get_N_sf(cfg->format, s, sf->shortened);
+    cf_t     p    = 0;
+    for (uint32_t m = 0; m < N_sf; m++) {
+      uint32_t n_oc       = 0;
+      uint32_t n_prime_ns = 0;
+      uint32_t l          = get_pucch_symbol(m, cfg->format, q->cell.cp);
+      uint32_t n_cs       = pucch_format1_n_cs(q, cfg, ns, l, &n_oc, &n_prime_ns);
+      float    S_ns       = (n_prime_ns % 2) ? M_PI / 2 : 0;
+      p += bank->bins[s][l][n_cs] * cexpf(-I * (pucch_format1_w(q, false, N_sf, n_oc)[m] + S_ns));
+    }
+    acc += p * conjf(h[s]);
+    sig_pwr += __real__(p * conjf(p)) / N_sf;
+    h_pwr += __real__(h[s] * conjf(h[s])) * N_sf;
+    nof_data += N_sf;
+  }
+
+  // Measurements
+  float noise_re = bank->noise_bin / SRSRAN_NRE;
+  float h_avg    = __real__(h[0] * conjf(h[0]) + h[1] * conjf(h[1])) / SRSRAN_NOF_SLOTS_PER_SF;
+  res->snr_db    = srsran_convert_power_to_dB(h_avg / noise_re);
+  res->rssi_dbFs = srsran_convert_power_to_dB(bank->epre);
+  res->ni_dbFs   = srsran_convert_power_to_dBm(noise_re);
+  if (cfg->meas_ta_en) {
+    if (isnormal(ta_err)) {
+      ta_err /= 15e3f;                         // Convert from normalized frequency to seconds
+      ta_err *= 1e6f;                          // Convert to micro-seconds
+      ta_err = roundf(ta_err * 10.0f) / 10.0f; // Round to one tenth of micro-second
+    } else {
+      ta_err = 0.0f;
+    }
+    res->ta_valid = !(isnan(ta_err) || isinf(ta_err));
+    res->ta_us    = ta_err;
+  }
+
+  // Perform DMRS Detection, if enabled
+  if (isnormal(cfg->threshold_dmrs_detection)) {
+    float rms             = __real__(dmrs_slot0 * conjf(dmrs_slot0));
+    res->dmrs_correlation = rms / (rms + (SRSRAN_NRE - 1) * n_rs * bank->noise_bin);
+    if (!isnormal(res->dmrs_correlation) || res->dmrs_correlation < cfg->threshold_dmrs_detection) {
+      return;
+    }
+  }
+
+  // The correlation is normalised by the power of the resource cyclic shift and cover plus the noise that the rest of
+  // dimensions would have if they were not used by other resources, so that it matches the single resource receiver
+  float norm = sqrtf(h_pwr * (sig_pwr + (nof_data * SRSRAN_NRE - SRSRAN_NOF_SLOTS_PER_SF) * bank->noise_bin));
+  if (!isnormal(norm)) {
+    return;
+  }
+
+  // Perform ML-decoding over the same hypotheses decode_signal() considers
+  bool  detected = false;
+  float corr_max = -1e9;
+  switch (cfg->format) {
+    case SRSRAN_PUCCH_FORMAT_1:
+      corr_max = __real__(acc * conjf(uci_encode_format1())) / norm;
+      detected = corr_max >= cfg->threshold_format1;
+      break;
+    case SRSRAN_PUCCH_FORMAT_1A:
+      for (uint8_t b = 0; b < 2; b++) {
+        float corr = __real__(acc * conjf(uci_encode_format1a(b))) / norm;
+        if (corr > corr_max) {
+          corr_max      = corr;
+          pucch_bits[0] = b;
+        }
+      }
+      detected = corr_max > cfg->threshold_format1;
+      break;
+    case SRSRAN_PUCCH_FORMAT_1B:
+      for (uint8_t b = 0; b < 2; b++) {
+        for (uint8_t b2 = 0; b2 < 2; b2++) {
+          uint8_t tmp[2] = {b, b2};
+          float   corr   = __real__(acc * conjf(uci_encode_format1b(tmp))) / norm;
+          if (corr > corr_max) {
+            corr_max      = corr;
+            pucch_bits[0] = b;
+            pucch_bits[1] = b2;
+          }
+        }
+      }
+      detected = corr_max > cfg->threshold_format1;
+      break;
+    default:; // Not reachable, formats are checked by the caller
+  }
+
+  decode_bits(cfg, detected, pucch_bits, cfg->pucch2_drs_bits, &res->uci_data);
+  res->detected    = detected;
+  res->correlation = corr_max;
+  if (cfg->format != SRSRAN_PUCCH_FORMAT_1) {
+    res->uci_data.ack.valid = res->correlation > cfg->threshold_data_valid_format1a;
+  }
+}
+
+int srsran_pucch_decode_format1_joint(srsran_pucch_t*     q,
+                                      srsran_ul_sf_cfg_t* sf,
+                                      srsran_pucch_cfg_t* cfg,
+                                      uint32_t            nof_cfg,
+                                      cf_t*               sf_symbols,
+                                      srsran_pucch_res_t* res)
+{
+  if (q == NULL || q->is_ue || sf == NULL || (nof_cfg > 0 && (cfg == NULL || sf_symbols == NULL || res == NULL))) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < nof_cfg; i++) {
+    if (cfg[i].format > SRSRAN_PUCCH_FORMAT_1B) {
+      ERROR("PUCCH format %s can not be decoded jointly", srsran_pucch_format_text(cfg[i].format));
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
+  pucch_cs_bank_t bank;
+  for (uint32_t i = 0; i < nof_cfg; i++) {
+    // Skip resources whose PRBs have been already processed along with a previous resource
+    bool done = false;
+    for (uint32_t j = 0; j < i && !done; j++) {
+      done = pucch_format1_same_prb(q, &cfg[i], &cfg[j]);
+    }
+    if (done) {
+      continue;
+    }
+
+    if (pucch_cs_bank_compute(q, sf, cfg, nof_cfg, i, sf_symbols, &bank) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t j = i; j < nof_cfg; j++) {
+      if (pucch_format1_same_prb(q, &cfg[i], &cfg[j])) {
+        pucch_format1_detect(q, sf, &bank, &cfg[j], &res[j]);
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 char* srsran_pucch_format_text(srsran_pucch_format_t format)
 {
   char* ret = NULL;
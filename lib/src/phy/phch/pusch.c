@@ -104,6 +104,57 @@ static int pusch_get(srsran_pusch_t* q, srsran_pusch_grant_t* grant, cf_t* input
   return pusch_cp(q, grant, input, output, is_shortened, false);
 }
 
+/* Equalizes the PUSCH REs straight from the resource grid, when the channel estimates are only available in the DMRS
+ * symbols. The MMSE weights are computed once per slot and applied to all the symbols of the slot, so the estimates of
+ * every RE are neither written nor read back. Returns the number of REs and the sum of their power in epre.
+ */
+static int pusch_equalize_dmrs_ce(srsran_pusch_t*        q,
+                                  srsran_pusch_grant_t*  grant,
+                                  srsran_chest_ul_res_t* channel,
+                                  cf_t*                  input,
+                                  cf_t*                  output,
+                                  bool                   is_shortened,
+                                  float*                 epre)
+{
+  cf_t*    out_ptr = output;
+  cf_t*    w       = q->ce; // MMSE weights of one slot
+  uint32_t nof_re  = grant->L_prb * SRSRAN_NRE;
+  float    power   = 0.0f;
+
+  for (uint32_t slot = 0; slot < 2; slot++) {
+    uint32_t N_srs = 0;
+    if (is_shortened && slot == 1) {
+      N_srs = 1;
+    }
+
+    cf_t* h = &channel->ce[SRSRAN_RE_IDX(q->cell.nof_prb,
+                                         SRSRAN_REFSIGNAL_UL_L(slot, q->cell.cp),
+                                         grant->n_prb_tilde[slot] * SRSRAN_NRE)];
+    for (uint32_t k = 0; k < nof_re; k++) {
+      float hh = __real__ h[k] * __real__ h[k] + __imag__ h[k] * __imag__ h[k];
+      w[k]     = conjf(h[k]) / (hh + channel->noise_estimate);
+    }
+
+    for (uint32_t l = 0; l < SRSRAN_CP_NSYMB(q->cell.cp) - N_srs; l++) {
+      uint32_t symb = l + slot * SRSRAN_CP_NSYMB(q->cell.cp);
+      if (symb != SRSRAN_REFSIGNAL_UL_L(slot, q->cell.cp)) {
+        cf_t* in_ptr = &input[SRSRAN_RE_IDX(q->cell.nof_prb, symb, grant->n_prb_tilde[slot] * SRSRAN_NRE)];
+        if (epre != NULL) {
+          power += srsran_vec_avg_power_cf(in_ptr, nof_re) * nof_re;
+        }
+        srsran_vec_prod_ccc(in_ptr, w, out_ptr, nof_re);
+        out_ptr += nof_re;
+      }
+    }
+  }
+
+  if (epre != NULL) {
+    *epre = power;
+  }
+
+  return out_ptr - output;
+}
+
 /** Initializes the PDCCH transmitter and receiver */
 static int pusch_init(srsran_pusch_t* q, uint32_t max_prb, bool is_ue)
 {
@@ -388,29 +439,47 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
          cfg->grant.tb.nof_bits,
          cfg->grant.tb.rv);
 
-    /* extract symbols */
-    n = pusch_get(q, &cfg->grant, sf_symbols, q->d, sf->shortened);
-    if (n != cfg->grant.nof_re) {
-      ERROR("Error expecting %d symbols but got %d", cfg->grant.nof_re, n);
-      return SRSRAN_ERROR;
-    }
+    if (channel->ce_dmrs_only) {
+      /* equalize the symbols as they are extracted */
+      float power = 0.0f;
+      n           = pusch_equalize_dmrs_ce(
+          q, &cfg->grant, channel, sf_symbols, q->z, sf->shortened, cfg->meas_epre_en ? &power : NULL);
+      if (n != cfg->grant.nof_re) {
+        ERROR("Error expecting %d symbols but got %d", cfg->grant.nof_re, n);
+        return SRSRAN_ERROR;
+      }
 
-    // Measure Energy per Resource Element
-    if (cfg->meas_epre_en) {
-      out->epre_dbfs = srsran_convert_power_to_dB(srsran_vec_avg_power_cf(q->d, n));
+      // Measure Energy per Resource Element
+      if (cfg->meas_epre_en) {
+        out->epre_dbfs = srsran_convert_power_to_dB(power / n);
+      } else {
+        out->epre_dbfs = NAN;
+      }
     } else {
-      out->epre_dbfs = NAN;
-    }
+      /* extract symbols */
+      n = pusch_get(q, &cfg->grant, sf_symbols, q->d, sf->shortened);
+      if (n != cfg->grant.nof_re) {
+        ERROR("Error expecting %d symbols but got %d", cfg->grant.nof_re, n);
+        return SRSRAN_ERROR;
+      }
 
-    /* extract channel estimates */
-    n = pusch_get(q, &cfg->grant, channel->ce, q->ce, sf->shortened);
-    if (n != cfg->grant.nof_re) {
-      ERROR("Error expecting %d symbols but got %d", cfg->grant.nof_re, n);
-      return SRSRAN_ERROR;
-    }
+      // Measure Energy per Resource Element
+      if (cfg->meas_epre_en) {
+        out->epre_dbfs = srsran_convert_power_to_dB(srsran_vec_avg_power_cf(q->d, n));
+      } else {
+        out->epre_dbfs = NAN;
+      }
+
+      /* extract channel estimates */
+      n = pusch_get(q, &cfg->grant, channel->ce, q->ce, sf->shortened);
+      if (n != cfg->grant.nof_re) {
+        ERROR("Error expecting %d symbols but got %d", cfg->grant.nof_re, n);
+        return SRSRAN_ERROR;
+      }
 
-    // Equalization
-    srsran_predecoding_single(q->d, q->ce, q->z, NULL, cfg->grant.nof_re, 1.0f, channel->noise_estimate);
+      // Equalization
+      srsran_predecoding_single(q->d, q->ce, q->z, NULL, cfg->grant.nof_re, 1.0f, channel->noise_estimate);
+    }
 
     // DFT predecoding
     srsran_dft_precoding(&q->dft_precoding, q->z, q->d, cfg->grant.L_prb, cfg->grant.nof_symb);
@@ -137,6 +137,14 @@ uint32_t srsran_sch_find_Ioffset_cqi(float beta)
 
 #define SCH_MAX_G_BITS (SRSRAN_MAX_PRB * 12 * 12 * 12)
 
+/* Per code block buffers of the batch encoder, rounded up to a cache line */
+#define SCH_BATCH_CB_IN_STRIDE (SRSRAN_CEIL((SRSRAN_TCOD_MAX_LEN_CB + 8) / 8, 64) * 64)
+#define SCH_BATCH_PARITY_STRIDE (SRSRAN_CEIL((3 * SRSRAN_TCOD_MAX_LEN_CB + 16) / 8, 64) * 64)
+
+/* Maximum number of transport blocks and code blocks segmented at once by srsran_dlsch_encode_batch() */
+#define SCH_BATCH_MAX_TB 32
+#define SCH_BATCH_MAX_CB (4 * SRSRAN_MAX_CODEBLOCKS)
+
 int srsran_sch_init(srsran_sch_t* q)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -176,6 +184,14 @@ int srsran_sch_init(srsran_sch_t* q)
     if (!q->parity_bits) {
       goto clean;
     }
+    q->cb_in_batch = srsran_vec_u8_malloc(SRSRAN_TCOD_MAX_BATCH * SCH_BATCH_CB_IN_STRIDE);
+    if (!q->cb_in_batch) {
+      goto clean;
+    }
+    q->parity_bits_batch = srsran_vec_u8_malloc(SRSRAN_TCOD_MAX_BATCH * SCH_BATCH_PARITY_STRIDE);
+    if (!q->parity_bits_batch) {
+      goto clean;
+    }
     q->temp_g_bits = srsran_vec_u8_malloc(SCH_MAX_G_BITS);
     if (!q->temp_g_bits) {
       goto clean;
@@ -208,6 +224,12 @@ void srsran_sch_free(srsran_sch_t* q)
   if (q->parity_bits) {
     free(q->parity_bits);
   }
+  if (q->cb_in_batch) {
+    free(q->cb_in_batch);
+  }
+  if (q->parity_bits_batch) {
+    free(q->parity_bits_batch);
+  }
   if (q->temp_g_bits) {
     free(q->temp_g_bits);
   }
@@ -655,6 +677,260 @@ int srsran_dlsch_encode2(srsran_sch_t*       q,
                    e_bits);
 }
 
+/* Transport block of a srsran_dlsch_encode_batch() call, after segmentation */
+typedef struct {
+  srsran_dlsch_batch_tb_t* tb;
+  srsran_softbuffer_tx_t*  softbuffer;
+  srsran_cbsegm_t          cb_segm;
+  uint32_t                 rv;
+  uint32_t                 tb_crc;
+} dlsch_batch_seg_t;
+
+/* Code block of a srsran_dlsch_encode_batch() call */
+typedef struct {
+  dlsch_batch_seg_t* seg;
+  uint32_t           cb_idx;
+  uint32_t           cblen_idx;
+  uint32_t           rlen;
+  uint32_t           rp;
+  uint32_t           wp;
+  uint32_t           n_e;
+  bool               encode;
+  bool               done;
+} dlsch_batch_cb_t;
+
+static int dlsch_batch_segment(srsran_dlsch_batch_tb_t* tb, dlsch_batch_seg_t* seg)
+{
+  srsran_pdsch_cfg_t* cfg    = tb->cfg;
+  uint32_t            tb_idx = tb->tb_idx;
+
+  if (cfg == NULL || tb_idx >= SRSRAN_MAX_CODEWORDS || tb->e_bits == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  seg->tb         = tb;
+  seg->softbuffer = cfg->softbuffers.tx[tb_idx];
+  seg->rv         = cfg->grant.tb[tb_idx].rv;
+  if (seg->softbuffer == NULL) {
+    ERROR("Invalid parameters: softbuffer=%d", seg->softbuffer != 0);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (srsran_cbsegm(&seg->cb_segm, (uint32_t)cfg->grant.tb[tb_idx].tbs)) {
+    ERROR("Error computing Codeword (%d) segmentation for TBS=%d", tb_idx, cfg->grant.tb[tb_idx].tbs);
+    return SRSRAN_ERROR;
+  }
+
+  if (seg->cb_segm.F) {
+    ERROR("Error filler bits are not supported. Use standard TBS");
+    return SRSRAN_ERROR;
+  }
+
+  if (seg->cb_segm.C > SCH_BATCH_MAX_CB) {
+    ERROR("Error number of CB to encode (%d) exceeds the batch size (%d CBs)", seg->cb_segm.C, SCH_BATCH_MAX_CB);
+    return SRSRAN_ERROR;
+  }
+
+  if (seg->cb_segm.C > seg->softbuffer->max_cb) {
+    ERROR("Error number of CB to encode (%d) exceeds soft buffer size (%d CBs)",
+          seg->cb_segm.C,
+          seg->softbuffer->max_cb);
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Computes the code block read/write pointers and lengths exactly as encode_tb_off() */
+static int dlsch_batch_cb_jobs(srsran_sch_t* q, dlsch_batch_seg_t* seg, dlsch_batch_cb_t* jobs)
+{
+  srsran_pdsch_cfg_t* cfg      = seg->tb->cfg;
+  uint32_t            tb_idx   = seg->tb->tb_idx;
+  srsran_cbsegm_t*    cb_segm  = &seg->cb_segm;
+  uint32_t            Nl       = (cfg->grant.nof_layers != cfg->grant.nof_tb) ? 2 : 1;
+  uint32_t            Qm       = srsran_mod_bits_x_symbol(cfg->grant.tb[tb_idx].mod) * Nl;
+  uint32_t            nof_bits = cfg->grant.tb[tb_idx].nof_bits;
+
+  if (Qm == 0) {
+    ERROR("Invalid Qm");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t Gp    = nof_bits / Qm;
+  uint32_t gamma = Gp;
+  if (cb_segm->C > 0) {
+    gamma = Gp % cb_segm->C;
+  }
+
+  bool encode = seg->tb->data != NULL && seg->rv == 0;
+  if (encode) {
+    seg->tb_crc = srsran_crc_checksum_byte(&q->crc_tb, seg->tb->data, cb_segm->tbs);
+  }
+
+  uint32_t rp = 0, wp = 0;
+  for (uint32_t i = 0; i < cb_segm->C; i++) {
+    dlsch_batch_cb_t* job = &jobs[i];
+    uint32_t          cb_len;
+
+    if (i < cb_segm->C2) {
+      cb_len         = cb_segm->K2;
+      job->cblen_idx = cb_segm->K2_idx;
+    } else {
+      cb_len         = cb_segm->K1;
+      job->cblen_idx = cb_segm->K1_idx;
+    }
+    job->rlen = (cb_segm->C > 1) ? cb_len - 24 : cb_len;
+    if (i <= cb_segm->C - gamma - 1) {
+      job->n_e = Qm * (Gp / cb_segm->C);
+    } else {
+      job->n_e = Qm * ((uint32_t)ceilf((float)Gp / cb_segm->C));
+    }
+    job->seg    = seg;
+    job->cb_idx = i;
+    job->rp     = rp;
+    job->wp     = wp;
+    job->encode = encode;
+    job->done   = false;
+
+    rp += job->rlen;
+    wp += job->n_e;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Copies the data of a code block and appends the TB and CB CRCs, as srsran_tcod_encode_lut() does on the fly */
+static void dlsch_batch_cb_input(srsran_sch_t* q, const dlsch_batch_cb_t* job, uint8_t* cb_in)
+{
+  const dlsch_batch_seg_t* seg = job->seg;
+  uint32_t                 C   = seg->cb_segm.C;
+
+  if (job->cb_idx < C - 1) {
+    memcpy(cb_in, &seg->tb->data[job->rp / 8], job->rlen / 8);
+  } else {
+    uint32_t nof_bytes = (job->rlen - 24) / 8;
+    memcpy(cb_in, &seg->tb->data[job->rp / 8], nof_bytes);
+    for (uint32_t i = 0; i < 3; i++) {
+      cb_in[nof_bytes + i] = (uint8_t)(seg->tb_crc >> (8 * (2 - i)));
+    }
+  }
+
+  if (C > 1) {
+    uint32_t cb_crc = srsran_crc_checksum_byte(&q->crc_cb, cb_in, job->rlen);
+    for (uint32_t i = 0; i < 3; i++) {
+      cb_in[job->rlen / 8 + i] = (uint8_t)(cb_crc >> (8 * (2 - i)));
+    }
+  }
+}
+
+static int dlsch_batch_rm(dlsch_batch_cb_t* job, uint8_t* systematic, uint8_t* parity)
+{
+  dlsch_batch_seg_t* seg = job->seg;
+
+  DEBUG("RM cblen_idx=%d, n_e=%d, wp=%d", job->cblen_idx, job->n_e, job->wp);
+  if (srsran_rm_turbo_tx_lut(seg->softbuffer->buffer_b[job->cb_idx],
+                             systematic,
+                             parity,
+                             &seg->tb->e_bits[job->wp / 8],
+                             job->cblen_idx,
+                             job->n_e,
+                             job->wp % 8,
+                             seg->rv)) {
+    ERROR("Error in rate matching");
+    return SRSRAN_ERROR;
+  }
+  job->done = true;
+  return SRSRAN_SUCCESS;
+}
+
+/* Turbo encodes and rate matches the code blocks of a window of transport blocks. Code blocks of the same size are
+ * grouped in the order they appear, up to SRSRAN_TCOD_MAX_BATCH at a time */
+static int dlsch_batch_encode_cbs(srsran_sch_t* q, dlsch_batch_cb_t* jobs, uint32_t nof_jobs)
+{
+  uint8_t* cb_in[SRSRAN_TCOD_MAX_BATCH];
+  uint8_t* parity[SRSRAN_TCOD_MAX_BATCH];
+  for (uint32_t i = 0; i < SRSRAN_TCOD_MAX_BATCH; i++) {
+    cb_in[i]  = &q->cb_in_batch[i * SCH_BATCH_CB_IN_STRIDE];
+    parity[i] = &q->parity_bits_batch[i * SCH_BATCH_PARITY_STRIDE];
+  }
+
+  for (uint32_t i = 0; i < nof_jobs; i++) {
+    if (jobs[i].done) {
+      continue;
+    }
+
+    // Retransmissions and transport blocks without data only read the soft buffer, as encode_tb_off() does
+    if (!jobs[i].encode) {
+      if (dlsch_batch_rm(&jobs[i], q->cb_in, q->parity_bits)) {
+        return SRSRAN_ERROR;
+      }
+      continue;
+    }
+
+    dlsch_batch_cb_t* group[SRSRAN_TCOD_MAX_BATCH];
+    uint32_t          nof_cb = 0;
+    for (uint32_t j = i; j < nof_jobs && nof_cb < SRSRAN_TCOD_MAX_BATCH; j++) {
+      if (!jobs[j].done && jobs[j].encode && jobs[j].cblen_idx == jobs[i].cblen_idx) {
+        dlsch_batch_cb_input(q, &jobs[j], cb_in[nof_cb]);
+        group[nof_cb++] = &jobs[j];
+      }
+    }
+
+    if (srsran_tcod_encode_lut_batch(&q->encoder, cb_in, parity, jobs[i].cblen_idx, nof_cb) < 0) {
+      ERROR("Error in turbo encoder");
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t j = 0; j < nof_cb; j++) {
+      if (dlsch_batch_rm(group[j], cb_in[j], parity[j])) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_dlsch_encode_batch(srsran_sch_t* q, srsran_dlsch_batch_tb_t* tb, uint32_t nof_tb)
+{
+  dlsch_batch_seg_t seg[SCH_BATCH_MAX_TB];
+  dlsch_batch_cb_t  jobs[SCH_BATCH_MAX_CB];
+
+  if (q == NULL || (tb == NULL && nof_tb > 0)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Transport blocks are processed in windows, so that the code block list stays bounded
+  uint32_t i = 0;
+  while (i < nof_tb) {
+    uint32_t nof_seg  = 0;
+    uint32_t nof_jobs = 0;
+
+    while (i < nof_tb && nof_seg < SCH_BATCH_MAX_TB) {
+      dlsch_batch_seg_t* s   = &seg[nof_seg];
+      int                ret = dlsch_batch_segment(&tb[i], s);
+      if (ret) {
+        return ret;
+      }
+      if (nof_jobs + s->cb_segm.C > SCH_BATCH_MAX_CB) {
+        break;
+      }
+      if (dlsch_batch_cb_jobs(q, s, &jobs[nof_jobs])) {
+        return SRSRAN_ERROR;
+      }
+      nof_jobs += s->cb_segm.C;
+      nof_seg++;
+      i++;
+    }
+
+    if (dlsch_batch_encode_cbs(q, jobs, nof_jobs)) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 /* Compute the interleaving function on-the-fly, because it depends on number of RI bits
  * Profiling show that the computation of this matrix is neglegible.
  */
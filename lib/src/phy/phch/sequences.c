@@ -80,6 +80,15 @@ void srsran_sequence_pdsch_apply_pack(const uint8_t* in,
   srsran_sequence_apply_packed(in, out, len, sequence_pdsch_seed(rnti, q, nslot, cell_id));
 }
 
+void srsran_sequence_pdsch_state_init(srsran_sequence_state_t* s,
+                                      uint16_t                 rnti,
+                                      int                      q,
+                                      uint32_t                 nslot,
+                                      uint32_t                 cell_id)
+{
+  srsran_sequence_state_init(s, sequence_pdsch_seed(rnti, q, nslot, cell_id));
+}
+
 void srsran_sequence_pdsch_apply_f(const float* in,
                                    float*       out,
                                    uint16_t     rnti,
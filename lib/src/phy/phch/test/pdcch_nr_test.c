@@ -68,6 +68,63 @@ static int test(srsran_pdcch_nr_t*      tx,
   return SRSRAN_SUCCESS;
 }
 
+static int test_batch(srsran_pdcch_nr_t*         tx,
+                      srsran_pdcch_nr_t*         rx,
+                      cf_t*                      grid,
+                      srsran_dmrs_pdcch_ce_t*    ce,
+                      const srsran_dci_msg_nr_t* dci_msg_tx,
+                      uint32_t                   nof_dci_msg)
+{
+  srsran_dci_msg_nr_t   dci_msg_rx[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR]    = {};
+  srsran_dci_msg_nr_t   dci_msg_batch[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR] = {};
+  srsran_pdcch_nr_res_t res_rx[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR]        = {};
+  srsran_pdcch_nr_res_t res_batch[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR]     = {};
+  uint32_t              count                                            = 0;
+
+  // Encode all the candidates in the same grid
+  for (uint32_t i = 0; i < nof_dci_msg; i++) {
+    TESTASSERT(srsran_pdcch_nr_encode(tx, &dci_msg_tx[i], grid) == SRSRAN_SUCCESS);
+  }
+
+  for (uint32_t i = 0; i < nof_dci_msg; i++) {
+    TESTASSERT(srsran_pdcch_nr_demodulate(rx, grid, ce, &dci_msg_tx[i].ctx.location) == SRSRAN_SUCCESS);
+
+    // Decode the transmitted DCI, then another RNTI and another size, one candidate at a time and in a batch
+    for (uint32_t k = 0; k < 3; k++) {
+      srsran_dci_msg_nr_t dci_msg = dci_msg_tx[i];
+      srsran_vec_u8_zero(dci_msg.payload, dci_msg.nof_bits);
+      if (k == 1) {
+        dci_msg.ctx.rnti++;
+      }
+      if (k == 2) {
+        dci_msg.nof_bits--;
+      }
+
+      dci_msg_rx[count]    = dci_msg;
+      dci_msg_batch[count] = dci_msg;
+      TESTASSERT(srsran_pdcch_nr_decode_demodulated(rx, &dci_msg_rx[count], &res_rx[count]) == SRSRAN_SUCCESS);
+      TESTASSERT(srsran_pdcch_nr_decode_batch_add(rx, &dci_msg_batch[count], &res_batch[count]) == SRSRAN_SUCCESS);
+      count++;
+    }
+  }
+
+  TESTASSERT(srsran_pdcch_nr_decode_batch_run(rx) == SRSRAN_SUCCESS);
+
+  // Assert the batch results match the candidate ones
+  for (uint32_t i = 0; i < count; i++) {
+    TESTASSERT(res_batch[i].crc == res_rx[i].crc);
+    TESTASSERT(memcmp(dci_msg_batch[i].payload, dci_msg_rx[i].payload, dci_msg_rx[i].nof_bits) == 0);
+  }
+
+  // Assert the transmitted DCI were found
+  for (uint32_t i = 0; i < nof_dci_msg; i++) {
+    TESTASSERT(res_batch[3 * i].crc);
+    TESTASSERT(memcmp(dci_msg_batch[3 * i].payload, dci_msg_tx[i].payload, dci_msg_tx[i].nof_bits) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 static void usage(char* prog)
 {
   printf("Usage: %s [pFIv] \n", prog);
@@ -227,6 +284,7 @@ int main(int argc, char** argv)
             continue;
           }
 
+          srsran_dci_msg_nr_t dci_msg_list[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
           for (uint32_t ncce_idx = 0; ncce_idx < n; ncce_idx++) {
             // Init MSG
             srsran_dci_msg_nr_t dci_msg = {};
@@ -252,6 +310,13 @@ int main(int argc, char** argv)
               ERROR("test failed");
               goto clean_exit;
             }
+            dci_msg_list[ncce_idx] = dci_msg;
+          }
+
+          // Decode all the candidates of the aggregation level at once
+          if (test_batch(&pdcch_tx, &pdcch_rx, buffer, ce, dci_msg_list, n) < SRSRAN_SUCCESS) {
+            ERROR("batch test failed");
+            goto clean_exit;
           }
         }
       }
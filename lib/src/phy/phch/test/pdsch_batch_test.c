@@ -0,0 +1,329 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+/*
+ * Encodes the PDSCH of several UEs with disjoint allocations, one at a time with srsran_pdsch_encode() and all at once
+ * with srsran_pdsch_encode_batch(), and checks that both resource grids are identical. Every subframe draws new
+ * allocations, MCS, redundancy versions and modulation tables for every UE.
+ */
+
+#define MAX_UES 16
+
+/* One byte per resource element of a subframe, more than the largest transport block */
+#define MAX_TB_BYTES (SRSRAN_MAX_PRB * SRSRAN_NRE * 2 * SRSRAN_CP_NORM_NSYMB)
+
+static srsran_cell_t cell = {
+    50,                 // nof_prb
+    1,                  // nof_ports
+    1,                  // cell_id
+    SRSRAN_CP_NORM,     // cyclic prefix
+    SRSRAN_PHICH_NORM,  // PHICH length
+    SRSRAN_PHICH_R_1_6, // PHICH resources
+    SRSRAN_FDD,
+};
+
+static srsran_tm_t tm            = SRSRAN_TM1;
+static uint32_t    nof_ues       = 8;
+static uint32_t    nof_subframes = 20;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nxuNv]\n", prog);
+  printf("\t-n cell.nof_prb [Default %d]\n", cell.nof_prb);
+  printf("\t-x Transmission mode [1 to 4] [Default %d]\n", tm + 1);
+  printf("\t-u Number of UEs per subframe, up to %d [Default %d]\n", MAX_UES, nof_ues);
+  printf("\t-N Number of subframes [Default %d]\n", nof_subframes);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nxuNv")) != -1) {
+    switch (opt) {
+      case 'n':
+        cell.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'x':
+        tm = (srsran_tm_t)(strtol(argv[optind], NULL, 10) - 1);
+        break;
+      case 'u':
+        nof_ues = SRSRAN_MIN((uint32_t)strtol(argv[optind], NULL, 10), MAX_UES);
+        break;
+      case 'N':
+        nof_subframes = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+typedef struct {
+  srsran_pdsch_cfg_t     cfg[2]; // Sequential and batch configurations, identical but for the soft buffers
+  srsran_softbuffer_tx_t softbuffer[2][SRSRAN_MAX_CODEWORDS];
+  uint8_t*               data[SRSRAN_MAX_CODEWORDS];
+} test_ue_t;
+
+static srsran_dci_format_t tm_dci_format(srsran_tm_t mode)
+{
+  switch (mode) {
+    case SRSRAN_TM3:
+      return SRSRAN_DCI_FORMAT2A;
+    case SRSRAN_TM4:
+      return SRSRAN_DCI_FORMAT2;
+    default:
+      return SRSRAN_DCI_FORMAT1;
+  }
+}
+
+/* Draws the grant of every UE, each one gets a contiguous and disjoint set of RBGs */
+static uint32_t random_grants(srsran_random_t random_gen, srsran_dl_sf_cfg_t* dl_sf, test_ue_t* ues)
+{
+  uint32_t nof_rbg   = SRSRAN_CEIL(cell.nof_prb, srsran_ra_type0_P(cell.nof_prb));
+  uint32_t nof_pdsch = 0;
+  uint32_t rbg       = 0;
+
+  for (uint32_t i = 0; i < nof_ues && rbg < nof_rbg; i++) {
+    uint32_t len = (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, SRSRAN_MAX(nof_rbg / nof_ues, 1));
+
+    srsran_dci_dl_t dci = {};
+    dci.format          = tm_dci_format(tm);
+    dci.rnti            = (uint16_t)(0x46 + i);
+    dci.alloc_type      = SRSRAN_RA_ALLOC_TYPE0;
+    for (uint32_t j = rbg; j < SRSRAN_MIN(rbg + len, nof_rbg); j++) {
+      dci.type0_alloc.rbg_bitmask |= 1U << (nof_rbg - 1 - j);
+    }
+    rbg += len;
+
+    bool     use_256qam = srsran_random_uniform_int_dist(random_gen, 0, 1) == 1;
+    uint32_t nof_tb     = (tm > SRSRAN_TM2) ? (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, 2) : 1;
+    for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
+      if (tb < nof_tb) {
+        dci.tb[tb].mcs_idx = (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, use_256qam ? 27 : 28);
+        dci.tb[tb].rv      = (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, 3);
+        if (dci.tb[tb].mcs_idx == 0 && dci.tb[tb].rv == 1) {
+          dci.tb[tb].rv = 0;
+        }
+      } else {
+        // Disabled transport block
+        dci.tb[tb].mcs_idx = 0;
+        dci.tb[tb].rv      = 1;
+      }
+      dci.tb[tb].cw_idx = tb;
+    }
+
+    test_ue_t*         ue  = &ues[nof_pdsch];
+    srsran_pdsch_cfg_t cfg = {};
+    cfg.rnti               = dci.rnti;
+    cfg.p_a                = (float)srsran_random_uniform_int_dist(random_gen, -3, 3);
+    cfg.p_b                = (cell.nof_ports > 1) ? 1 : 0;
+    if (srsran_ra_dl_dci_to_grant(&cell, dl_sf, tm, use_256qam, &dci, &cfg.grant)) {
+      continue;
+    }
+
+    for (uint32_t k = 0; k < 2; k++) {
+      ue->cfg[k] = cfg;
+      for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
+        ue->cfg[k].softbuffers.tx[tb] = &ue->softbuffer[k][tb];
+      }
+    }
+
+    for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
+      if (cfg.grant.tb[tb].enabled) {
+        for (uint32_t j = 0; j < cfg.grant.tb[tb].tbs / 8; j++) {
+          ue->data[tb][j] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 255);
+        }
+      }
+    }
+    nof_pdsch++;
+  }
+
+  return nof_pdsch;
+}
+
+int main(int argc, char** argv)
+{
+  int                     ret                                       = SRSRAN_ERROR;
+  srsran_pdsch_t          pdsch[2]                                  = {};
+  cf_t*                   sf_symbols[2][SRSRAN_MAX_PORTS]           = {};
+  test_ue_t*              ues                                       = NULL;
+  srsran_pdsch_cfg_t*     batch_cfg[MAX_UES]                        = {};
+  uint8_t*                batch_data[MAX_UES][SRSRAN_MAX_CODEWORDS] = {};
+  srsran_random_t         random_gen                                = srsran_random_init(0x1234);
+  srsran_pdsch_enc_time_t enc_time                                  = {};
+  uint64_t                time_seq = 0, time_batch = 0;
+  struct timeval          t[3];
+
+  parse_args(argc, argv);
+
+  cell.nof_ports = (tm == SRSRAN_TM1) ? 1 : 2;
+  uint32_t nof_re = SRSRAN_NOF_RE(cell);
+
+  ues = calloc(MAX_UES, sizeof(test_ue_t));
+  if (!ues) {
+    perror("calloc");
+    goto quit;
+  }
+
+  for (uint32_t k = 0; k < 2; k++) {
+    if (srsran_pdsch_init_enb(&pdsch[k], cell.nof_prb)) {
+      ERROR("Error creating PDSCH object");
+      goto quit;
+    }
+    if (srsran_pdsch_set_cell(&pdsch[k], cell)) {
+      ERROR("Error setting PDSCH cell");
+      goto quit;
+    }
+    for (uint32_t p = 0; p < cell.nof_ports; p++) {
+      sf_symbols[k][p] = srsran_vec_cf_malloc(nof_re);
+      if (!sf_symbols[k][p]) {
+        perror("srsran_vec_cf_malloc");
+        goto quit;
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < MAX_UES; i++) {
+    for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
+      ues[i].data[tb] = srsran_vec_u8_malloc(MAX_TB_BYTES);
+      if (!ues[i].data[tb]) {
+        perror("srsran_vec_u8_malloc");
+        goto quit;
+      }
+      for (uint32_t k = 0; k < 2; k++) {
+        if (srsran_softbuffer_tx_init(&ues[i].softbuffer[k][tb], cell.nof_prb)) {
+          ERROR("Error initiating TX soft buffer");
+          goto quit;
+        }
+      }
+    }
+  }
+
+  for (uint32_t n = 0; n < nof_subframes; n++) {
+    srsran_dl_sf_cfg_t dl_sf = {};
+    dl_sf.tti                = n;
+    dl_sf.cfi                = 1 + n % 3;
+
+    uint32_t nof_pdsch = random_grants(random_gen, &dl_sf, ues);
+
+    for (uint32_t k = 0; k < 2; k++) {
+      for (uint32_t p = 0; p < cell.nof_ports; p++) {
+        srsran_vec_cf_zero(sf_symbols[k][p], nof_re);
+      }
+    }
+
+    // Sequential encoding, one UE after the other
+    gettimeofday(&t[1], NULL);
+    for (uint32_t i = 0; i < nof_pdsch; i++) {
+      if (srsran_pdsch_encode(&pdsch[0], &dl_sf, &ues[i].cfg[0], ues[i].data, sf_symbols[0])) {
+        ERROR("Error encoding PDSCH");
+        goto quit;
+      }
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    time_seq += t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+    // Batch encoding
+    for (uint32_t i = 0; i < nof_pdsch; i++) {
+      batch_cfg[i] = &ues[i].cfg[1];
+      for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
+        batch_data[i][tb] = ues[i].data[tb];
+      }
+    }
+    gettimeofday(&t[1], NULL);
+    if (srsran_pdsch_encode_batch(&pdsch[1], &dl_sf, batch_cfg, batch_data, nof_pdsch, sf_symbols[1], &enc_time)) {
+      ERROR("Error encoding PDSCH batch");
+      goto quit;
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    time_batch += t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+    for (uint32_t p = 0; p < cell.nof_ports; p++) {
+      if (memcmp(sf_symbols[0][p], sf_symbols[1][p], nof_re * sizeof(cf_t)) != 0) {
+        ERROR("Subframe %d: batch and sequential resource grids differ in port %d (%d PDSCH)", n, p, nof_pdsch);
+        goto quit;
+      }
+    }
+
+    INFO("Subframe %d: %d PDSCH, coding %d us, modulation %d us, mapping %d us",
+         n,
+         nof_pdsch,
+         enc_time.coding_us,
+         enc_time.modulation_us,
+         enc_time.mapping_us);
+  }
+
+  printf("%d subframes of %d UEs, sequential: %.1f us/sf, batch: %.1f us/sf\n",
+         nof_subframes,
+         nof_ues,
+         (double)time_seq / nof_subframes,
+         (double)time_batch / nof_subframes);
+
+  ret = SRSRAN_SUCCESS;
+
+quit:
+  for (uint32_t k = 0; k < 2; k++) {
+    srsran_pdsch_free(&pdsch[k]);
+    for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      if (sf_symbols[k][p]) {
+        free(sf_symbols[k][p]);
+      }
+    }
+  }
+  if (ues) {
+    for (uint32_t i = 0; i < MAX_UES; i++) {
+      for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
+        if (ues[i].data[tb]) {
+          free(ues[i].data[tb]);
+        }
+        for (uint32_t k = 0; k < 2; k++) {
+          srsran_softbuffer_tx_free(&ues[i].softbuffer[k][tb]);
+        }
+      }
+    }
+    free(ues);
+  }
+  srsran_random_free(random_gen);
+
+  if (ret == SRSRAN_SUCCESS) {
+    printf("Ok\n");
+  } else {
+    printf("Error\n");
+  }
+
+  return ret;
+}
@@ -35,22 +35,24 @@ static uint32_t            n_prb     = 0;  // Set to 0 for steering
 static uint32_t            mcs       = 30; // Set to 30 for steering
 static srsran_sch_cfg_nr_t pdsch_cfg = {};
 static uint16_t            rnti      = 0x1234;
+static bool                fused_eq  = false;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [pTL] \n", prog);
+  printf("Usage: %s [pmTLFv] \n", prog);
   printf("\t-p Number of grant PRB, set to 0 for steering [Default %d]\n", n_prb);
   printf("\t-m MCS PRB, set to >28 for steering [Default %d]\n", mcs);
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
          srsran_mcs_table_to_str(pdsch_cfg.sch_cfg.mcs_table));
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
+  printf("\t-F Fuse the equalizer and demodulator, disables the EVM measurement\n");
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "pmTLv")) != -1) {
+  while ((opt = getopt(argc, argv, "pmTLFv")) != -1) {
     switch (opt) {
       case 'p':
         n_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -64,6 +66,9 @@ int parse_args(int argc, char** argv)
       case 'L':
         carrier.max_mimo_layers = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'F':
+        fused_eq = true;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -98,7 +103,8 @@ int main(int argc, char** argv)
 
   srsran_pdsch_nr_args_t pdsch_args = {};
   pdsch_args.sch.disable_simd       = false;
-  pdsch_args.measure_evm            = true;
+  pdsch_args.measure_evm            = !fused_eq;
+  pdsch_args.fused_equalizer        = fused_eq;
 
   if (srsran_pdsch_nr_init_enb(&pdsch_tx, &pdsch_args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating PDSCH for Tx");
@@ -234,25 +240,28 @@ int main(int argc, char** argv)
         goto clean_exit;
       }
 
-      float    mse    = 0.0f;
-      uint32_t nof_re = srsran_ra_dl_nr_slot_nof_re(&pdsch_cfg, &pdsch_cfg.grant);
-      for (uint32_t i = 0; i < pdsch_cfg.grant.nof_layers; i++) {
-        for (uint32_t j = 0; j < nof_re; j++) {
-          mse += cabsf(pdsch_tx.d[i][j] - pdsch_rx.d[i][j]);
-        }
-      }
-      if (nof_re * pdsch_cfg.grant.nof_layers > 0) {
-        mse = mse / (nof_re * pdsch_cfg.grant.nof_layers);
-      }
-      if (mse > 0.001) {
-        ERROR("MSE error (%f) is too high", mse);
+      // The equalized symbols are not written when the equalizer is fused with the demodulator
+      if (!fused_eq) {
+        float    mse    = 0.0f;
+        uint32_t nof_re = srsran_ra_dl_nr_slot_nof_re(&pdsch_cfg, &pdsch_cfg.grant);
         for (uint32_t i = 0; i < pdsch_cfg.grant.nof_layers; i++) {
-          printf("d_tx[%d]=", i);
-          srsran_vec_fprint_c(stdout, pdsch_tx.d[i], nof_re);
-          printf("d_rx[%d]=", i);
-          srsran_vec_fprint_c(stdout, pdsch_rx.d[i], nof_re);
+          for (uint32_t j = 0; j < nof_re; j++) {
+            mse += cabsf(pdsch_tx.d[i][j] - pdsch_rx.d[i][j]);
+          }
+        }
+        if (nof_re * pdsch_cfg.grant.nof_layers > 0) {
+          mse = mse / (nof_re * pdsch_cfg.grant.nof_layers);
+        }
+        if (mse > 0.001) {
+          ERROR("MSE error (%f) is too high", mse);
+          for (uint32_t i = 0; i < pdsch_cfg.grant.nof_layers; i++) {
+            printf("d_tx[%d]=", i);
+            srsran_vec_fprint_c(stdout, pdsch_tx.d[i], nof_re);
+            printf("d_rx[%d]=", i);
+            srsran_vec_fprint_c(stdout, pdsch_rx.d[i], nof_re);
+          }
+          goto clean_exit;
         }
-        goto clean_exit;
       }
 
       if (!pdsch_res.tb[0].crc) {
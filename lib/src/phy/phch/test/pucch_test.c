@@ -27,6 +27,8 @@
 #include <unistd.h>
 
 #include "srsran/srsran.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/support/srsran_test.h"
 
 static srsran_cell_t cell = {
     25,                 // nof_prb
@@ -41,15 +43,17 @@ static srsran_cell_t cell = {
 
 static uint32_t subframe      = 0;
 static bool     test_cqi_only = false;
+static bool     test_joint    = false;
 static float    snr_db        = 20.0f;
 
 static void usage(char* prog)
 {
-  printf("Usage: %s [csNnv]\n", prog);
+  printf("Usage: %s [csNnqmSv]\n", prog);
   printf("\t-c cell id [Default %d]\n", cell.id);
   printf("\t-s subframe [Default %d]\n", subframe);
   printf("\t-n nof_prb [Default %d]\n", cell.nof_prb);
   printf("\t-q Test CQI encoding/decoding only [Default %s].\n", test_cqi_only ? "yes" : "no");
+  printf("\t-m Test joint multi-UE format 1/1a/1b decoding only [Default %s].\n", test_joint ? "yes" : "no");
   printf("\t-S Signal to Noise Ratio in dB [Default %.2f].\n", snr_db);
   printf("\t-v [set verbose to debug, default none]\n");
 }
@@ -57,7 +61,7 @@ static void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "csNnqSv")) != -1) {
+  while ((opt = getopt(argc, argv, "csNnqmSv")) != -1) {
     switch (opt) {
       case 's':
         subframe = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -71,6 +75,9 @@ void parse_args(int argc, char** argv)
       case 'q':
         test_cqi_only = true;
         break;
+      case 'm':
+        test_joint = true;
+        break;
       case 'S':
         snr_db = strtof(argv[optind], NULL);
         break;
@@ -138,6 +145,135 @@ int test_uci_cqi_pucch(void)
   return ret;
 }
 
+// Multiplexes every format 1/1a/1b resource of a PRB, leaving some of them silent, and decodes all of them jointly
+int test_pucch_joint(void)
+{
+  int                   ret        = SRSRAN_ERROR;
+  srsran_pucch_t        pucch_ue   = {};
+  srsran_pucch_t        pucch_enb  = {};
+  srsran_refsignal_ul_t dmrs       = {};
+  srsran_channel_awgn_t awgn       = {};
+  srsran_random_t       random     = srsran_random_init(0x4567);
+  cf_t*                 sf_symbols = srsran_vec_cf_malloc(SRSRAN_NOF_RE(cell));
+  cf_t*                 ue_symbols = srsran_vec_cf_malloc(SRSRAN_NOF_RE(cell));
+  cf_t                  pucch_dmrs[2 * SRSRAN_NRE * 3];
+
+  const uint32_t     delta_pucch_shift = 2;
+  const uint32_t     nof_res           = 3 * SRSRAN_NRE / delta_pucch_shift;
+  srsran_pucch_cfg_t cfg[3 * SRSRAN_NRE];
+  srsran_pucch_res_t res[3 * SRSRAN_NRE];
+  bool               tx[3 * SRSRAN_NRE];
+  uint8_t            ack[3 * SRSRAN_NRE][2];
+
+  if (sf_symbols == NULL || ue_symbols == NULL || srsran_pucch_init_ue(&pucch_ue) ||
+      srsran_pucch_set_cell(&pucch_ue, cell) || srsran_pucch_init_enb(&pucch_enb) ||
+      srsran_pucch_set_cell(&pucch_enb, cell) || srsran_refsignal_ul_set_cell(&dmrs, cell) ||
+      srsran_channel_awgn_init(&awgn, 0x1234) || srsran_channel_awgn_set_n0(&awgn, -snr_db)) {
+    ERROR("Error initialising joint PUCCH test");
+    goto clean_exit;
+  }
+
+  for (uint32_t tti = 0; tti < SRSRAN_NOF_SF_X_FRAME; tti++) {
+    srsran_ul_sf_cfg_t ul_sf = {};
+    ul_sf.tti                = tti;
+    ul_sf.shortened          = tti % 2;
+    srsran_vec_cf_zero(sf_symbols, SRSRAN_NOF_RE(cell));
+
+    for (uint32_t i = 0; i < nof_res; i++) {
+      srsran_uci_value_t uci = {};
+
+      ZERO_OBJECT(cfg[i]);
+      cfg[i].delta_pucch_shift             = delta_pucch_shift;
+      cfg[i].group_hopping_en              = tti % 3 == 0;
+      cfg[i].format                        = (srsran_pucch_format_t)(i % 3);
+      cfg[i].n_pucch                       = i;
+      cfg[i].threshold_format1             = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT1;
+      cfg[i].threshold_data_valid_format1a = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT1A;
+      cfg[i].threshold_dmrs_detection      = SRSRAN_PUCCH_DEFAULT_THRESHOLD_DMRS;
+      cfg[i].meas_ta_en                    = true;
+      if (cfg[i].format == SRSRAN_PUCCH_FORMAT_1) {
+        cfg[i].uci_cfg.is_scheduling_request_tti = true;
+      } else {
+        cfg[i].uci_cfg.ack[0].nof_acks = srsran_pucch_nof_ack_format(cfg[i].format);
+      }
+
+      // One out of four resources is not transmitted
+      tx[i]                = srsran_random_uniform_int_dist(random, 0, 3) > 0;
+      ack[i][0]            = (uint8_t)srsran_random_uniform_int_dist(random, 0, 1);
+      ack[i][1]            = (uint8_t)srsran_random_uniform_int_dist(random, 0, 1);
+      uci.ack.ack_value[0] = ack[i][0];
+      uci.ack.ack_value[1] = ack[i][1];
+      if (!tx[i]) {
+        continue;
+      }
+
+      srsran_vec_cf_zero(ue_symbols, SRSRAN_NOF_RE(cell));
+      if (srsran_pucch_encode(&pucch_ue, &ul_sf, &cfg[i], &uci, ue_symbols) ||
+          srsran_refsignal_dmrs_pucch_gen(&dmrs, &ul_sf, &cfg[i], pucch_dmrs) ||
+          srsran_refsignal_dmrs_pucch_put(&dmrs, &cfg[i], pucch_dmrs, ue_symbols)) {
+        ERROR("Error encoding PUCCH");
+        goto clean_exit;
+      }
+      srsran_vec_sum_ccc(sf_symbols, ue_symbols, sf_symbols, SRSRAN_NOF_RE(cell));
+    }
+
+    srsran_channel_awgn_run_c(&awgn, sf_symbols, sf_symbols, SRSRAN_NOF_RE(cell));
+
+    if (srsran_pucch_decode_format1_joint(&pucch_enb, &ul_sf, cfg, nof_res, sf_symbols, res) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding PUCCH jointly");
+      goto clean_exit;
+    }
+
+    for (uint32_t i = 0; i < nof_res; i++) {
+      char str[256];
+      srsran_pucch_rx_info(&cfg[i], &res[i], str, sizeof(str));
+      INFO("tti=%d; tx=%d; %s", tti, tx[i], str);
+
+      if (res[i].detected != tx[i]) {
+        ERROR("tti=%d; n_pucch=%d; %s detection mismatch (corr=%.2f)",
+              tti,
+              cfg[i].n_pucch,
+              srsran_pucch_format_text(cfg[i].format),
+              res[i].correlation);
+        goto clean_exit;
+      }
+
+      if (!tx[i]) {
+        continue;
+      }
+
+      if (cfg[i].format == SRSRAN_PUCCH_FORMAT_1) {
+        TESTASSERT(res[i].uci_data.scheduling_request);
+      } else {
+        TESTASSERT(res[i].uci_data.ack.valid);
+        for (uint32_t b = 0; b < srsran_pucch_nof_ack_format(cfg[i].format); b++) {
+          TESTASSERT(res[i].uci_data.ack.ack_value[b] == ack[i][b]);
+        }
+      }
+      TESTASSERT(fabsf(res[i].snr_db - snr_db) < 3.0f);
+      TESTASSERT(res[i].ta_valid && fabsf(res[i].ta_us) < 0.5f);
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_pucch_free(&pucch_ue);
+  srsran_pucch_free(&pucch_enb);
+  srsran_channel_awgn_free(&awgn);
+  srsran_random_free(random);
+  if (sf_symbols) {
+    free(sf_symbols);
+  }
+  if (ue_symbols) {
+    free(ue_symbols);
+  }
+
+  printf("%s\n", ret ? "Error" : "Ok");
+
+  return ret;
+}
+
 int main(int argc, char** argv)
 {
   srsran_pucch_t        pucch_ue   = {};
@@ -157,6 +293,10 @@ int main(int argc, char** argv)
     return test_uci_cqi_pucch();
   }
 
+  if (test_joint) {
+    return test_pucch_joint();
+  }
+
   if (srsran_pucch_init_ue(&pucch_ue)) {
     ERROR("Error creating PDSCH object");
     exit(-1);
@@ -56,6 +56,7 @@ int          freq_hop      = -1;
 int          riv           = -1;
 uint32_t     mcs_idx       = 0;
 bool         enable_64_qam = false;
+bool         dmrs_ce_only  = false;
 
 void usage(char* prog)
 {
@@ -84,6 +85,8 @@ void usage(char* prog)
   printf("\n\tOther parameters:\n");
   printf("\t\t-p enable_64qam [Default %s]\n", enable_64_qam ? "enabled" : "disabled");
   printf("\t\t-s number of subframes [Default %d]\n", subframe);
+  printf("\t\t-d equalize with a random channel estimated in the DMRS symbols only [Default %s]\n",
+         dmrs_ce_only ? "enabled" : "disabled");
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
@@ -139,7 +142,7 @@ void parse_extensive_param(char* param, char* arg)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "msLFrncpvf")) != -1) {
+  while ((opt = getopt(argc, argv, "msLFrncpvfd")) != -1) {
     switch (opt) {
       case 'm':
         mcs_idx = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -172,6 +175,9 @@ void parse_args(int argc, char** argv)
       case 'v':
         increase_srsran_verbose_level();
         break;
+      case 'd':
+        dmrs_ce_only = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -179,6 +185,29 @@ void parse_args(int argc, char** argv)
   }
 }
 
+/* Applies a random channel, constant within every slot, and writes its estimates only in the DMRS symbols */
+static void apply_dmrs_channel(srsran_random_t random_h, srsran_chest_ul_res_t* chest_res, cf_t* sf_symbols)
+{
+  uint32_t nof_sc = cell.nof_prb * SRSRAN_NRE;
+
+  srsran_vec_cf_zero(chest_res->ce, SRSRAN_SF_LEN_RE(cell.nof_prb, cell.cp));
+  for (uint32_t slot = 0; slot < SRSRAN_NOF_SLOTS_PER_SF; slot++) {
+    cf_t* h = &chest_res->ce[SRSRAN_REFSIGNAL_UL_L(slot, cell.cp) * nof_sc];
+    for (uint32_t k = 0; k < nof_sc; k++) {
+      h[k] = srsran_random_uniform_real_dist(random_h, 0.5f, 1.5f) *
+             cexpf(I * srsran_random_uniform_real_dist(random_h, -(float)M_PI, (float)M_PI));
+    }
+    for (uint32_t l = 0; l < SRSRAN_CP_NSYMB(cell.cp); l++) {
+      srsran_vec_prod_ccc(&sf_symbols[(l + slot * SRSRAN_CP_NSYMB(cell.cp)) * nof_sc],
+                          h,
+                          &sf_symbols[(l + slot * SRSRAN_CP_NSYMB(cell.cp)) * nof_sc],
+                          nof_sc);
+    }
+  }
+  chest_res->ce_dmrs_only   = true;
+  chest_res->noise_estimate = 0.0f;
+}
+
 int main(int argc, char** argv)
 {
   srsran_random_t        random_h = srsran_random_init(0);
@@ -328,6 +357,10 @@ int main(int argc, char** argv)
     cfg.softbuffers.rx           = &softbuffer_rx;
     memcpy(&cfg.uci_cfg, &uci_data_tx.cfg, sizeof(srsran_uci_cfg_t));
 
+    if (dmrs_ce_only) {
+      apply_dmrs_channel(random_h, &chest_res, sf_symbols);
+    }
+
     gettimeofday(&t[1], NULL);
     int r = srsran_pusch_decode(&pusch_rx, &ul_sf, &cfg, &chest_res, sf_symbols, &pusch_res);
     gettimeofday(&t[2], NULL);
@@ -62,6 +62,16 @@ static srsran_rf_plugin_t plugin_zmq   = {"", NULL, &srsran_rf_dev_zmq};
 #endif
 #endif
 
+/* Define implementation for shared-memory RF */
+#ifdef ENABLE_SHM
+#ifdef ENABLE_RF_PLUGINS
+static srsran_rf_plugin_t plugin_shm = {"libsrsran_rf_shm.so", NULL, NULL};
+#else
+#include "rf_shm_imp.h"
+static srsran_rf_plugin_t plugin_shm   = {"", NULL, &srsran_rf_dev_shm};
+#endif
+#endif
+
 /* Define implementation for file-based RF */
 #include "rf_file_imp.h"
 static srsran_rf_plugin_t plugin_file = {"", NULL, &srsran_rf_dev_file};
@@ -111,6 +121,9 @@ static srsran_rf_plugin_t* rf_plugins[] = {
 #ifdef ENABLE_ZEROMQ
     &plugin_zmq,
 #endif
+#ifdef ENABLE_SHM
+    &plugin_shm,
+#endif
 #ifdef ENABLE_SIDEKIQ
     &plugin_skiq,
 #endif
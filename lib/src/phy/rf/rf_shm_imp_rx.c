@@ -0,0 +1,363 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define SHM_ATTACH_POLL_US (1000)
+
+static void rf_shm_rx_detach(rf_shm_rx_t* q, uint32_t i)
+{
+  rf_shm_ring_t* r = q->ring[i];
+  if (r == NULL) {
+    return;
+  }
+
+  // Leave the read position to the next reader and release the slot
+  uint64_t read_idx = __atomic_load_n(&r->reader[q->slot[i]].read_idx, __ATOMIC_SEQ_CST);
+  uint64_t idle     = __atomic_load_n(&r->idle_tail, __ATOMIC_SEQ_CST);
+  while (idle < read_idx && !__atomic_compare_exchange_n(
+                                &r->idle_tail, &idle, read_idx, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+  }
+  __atomic_store_n(&r->reader[q->slot[i]].pid, 0, __ATOMIC_SEQ_CST);
+  __atomic_store_n(&r->reader[q->slot[i]].active, 0, __ATOMIC_SEQ_CST);
+
+  // The writer might be waiting for this reader
+  __atomic_add_fetch(&r->read_seq, 1, __ATOMIC_SEQ_CST);
+  rf_shm_futex_wake(&r->read_seq);
+
+  munmap(r, q->map_size[i]);
+  q->ring[i] = NULL;
+}
+
+static int rf_shm_rx_attach(rf_shm_rx_t* q, uint32_t i)
+{
+  int         ret = SRSRAN_ERROR;
+  struct stat st  = {};
+  void*       ptr = MAP_FAILED;
+
+  int fd = shm_open(q->name[i], O_RDWR, 0);
+  if (fd < 0) {
+    // The transmitter has not been created yet
+    return SRSRAN_ERROR;
+  }
+
+  if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(rf_shm_ring_t)) {
+    goto clean_exit;
+  }
+
+  ptr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (ptr == MAP_FAILED) {
+    fprintf(stderr, "[shm] Error: mapping receiver ring (%s): %s\n", q->name[i], strerror(errno));
+    goto clean_exit;
+  }
+
+  // Wait until the transmitter completed the header and check it is compatible
+  rf_shm_ring_t* r = (rf_shm_ring_t*)ptr;
+  if (__atomic_load_n(&r->magic, __ATOMIC_ACQUIRE) != SHM_RING_MAGIC || r->version != SHM_RING_VERSION ||
+      !__atomic_load_n(&r->writer_alive, __ATOMIC_SEQ_CST) ||
+      sizeof(rf_shm_ring_t) + (size_t)r->capacity * sizeof(cf_t) > (size_t)st.st_size) {
+    goto clean_exit;
+  }
+
+  // Claim a free reader slot
+  int32_t slot = -1;
+  for (uint32_t s = 0; s < SHM_MAX_READERS && slot < 0; s++) {
+    uint32_t expected = 0;
+    if (__atomic_compare_exchange_n(&r->reader[s].active, &expected, 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+      slot = (int32_t)s;
+    }
+  }
+  if (slot < 0) {
+    fprintf(stderr, "[shm] Error: no free reader slot in %s (max. %d readers)\n", q->name[i], SHM_MAX_READERS);
+    goto clean_exit;
+  }
+  __atomic_store_n(&r->reader[slot].pid, (int32_t)getpid(), __ATOMIC_SEQ_CST);
+
+  // Join the other readers at the write position, otherwise resume from where the last reader left
+  bool others = false;
+  for (uint32_t s = 0; s < SHM_MAX_READERS; s++) {
+    others |= (s != (uint32_t)slot && __atomic_load_n(&r->reader[s].active, __ATOMIC_SEQ_CST));
+  }
+  uint64_t read_idx = others ? __atomic_load_n(&r->write_idx, __ATOMIC_SEQ_CST)
+                             : __atomic_load_n(&r->idle_tail, __ATOMIC_SEQ_CST);
+  __atomic_store_n(&r->reader[slot].read_idx, read_idx, __ATOMIC_SEQ_CST);
+
+  rf_shm_info(q->id, "Attached receiver to %s (slot %d) at sample %" PRIu64 "\n", q->name[i], slot, read_idx);
+
+  q->ring[i]     = r;
+  q->map_size[i] = (size_t)st.st_size;
+  q->slot[i]     = slot;
+  ptr            = MAP_FAILED;
+  ret            = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (ptr != MAP_FAILED) {
+    munmap(ptr, (size_t)st.st_size);
+  }
+  close(fd);
+  return ret;
+}
+
+int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, char* names)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (q) {
+    // Zero object
+    bzero(q, sizeof(rf_shm_rx_t));
+
+    // Copy id
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+
+    q->frequency_mhz      = opts.frequency_mhz;
+    q->fail_on_disconnect = opts.fail_on_disconnect;
+    q->sample_offset      = opts.sample_offset;
+    q->trx_timeout_ms     = opts.trx_timeout_ms;
+    q->log_trx_timeout    = opts.log_trx_timeout;
+
+    // Source rings are separated by colons, their samples are added up
+    char  tmp[RF_PARAM_LEN] = {};
+    char* saveptr           = NULL;
+    strncpy(tmp, names, RF_PARAM_LEN - 1);
+    for (char* tok = strtok_r(tmp, ":", &saveptr); tok != NULL; tok = strtok_r(NULL, ":", &saveptr)) {
+      if (q->nof_sources == SHM_MAX_SOURCES) {
+        fprintf(stderr, "[shm] Error: too many receiver sources (max. %d)\n", SHM_MAX_SOURCES);
+        goto clean_exit;
+      }
+      if (tok[0] == '/') {
+        snprintf(q->name[q->nof_sources], RF_PARAM_LEN, "%s", tok);
+      } else {
+        snprintf(q->name[q->nof_sources], RF_PARAM_LEN, "/%s", tok);
+      }
+      rf_shm_info(q->id, "Connecting receiver: %s\n", q->name[q->nof_sources]);
+      q->nof_sources++;
+    }
+
+    if (q->nof_sources == 0) {
+      fprintf(stderr, "[shm] Error: no receiver source in '%s'\n", names);
+      goto clean_exit;
+    }
+
+    // Attach to the sources that already exist, the others are attached once their transmitter starts
+    for (uint32_t i = 0; i < q->nof_sources; i++) {
+      rf_shm_rx_attach(q, i);
+    }
+
+    if (pthread_mutex_init(&q->mutex, NULL)) {
+      fprintf(stderr, "Error: creating mutex\n");
+      goto clean_exit;
+    }
+
+    q->running = true;
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  return ret;
+}
+
+/**
+ * Waits until samples are available in every live source. Returns the number of available samples, 0 if there is no
+ * source or SRSRAN_ERROR_TIMEOUT if no sample arrived within the transmit/receive timeout.
+ */
+static int rf_shm_rx_wait(rf_shm_rx_t* q, uint32_t nsamples)
+{
+  uint64_t deadline = rf_shm_time_ms() + q->trx_timeout_ms;
+
+  while (q->running) {
+    uint64_t       avail = UINT64_MAX;
+    rf_shm_ring_t* slow  = NULL;
+    uint32_t       seq   = 0;
+
+    for (uint32_t i = 0; i < q->nof_sources; i++) {
+      if (q->ring[i] == NULL && rf_shm_rx_attach(q, i) != SRSRAN_SUCCESS) {
+        continue;
+      }
+
+      rf_shm_ring_t* r        = q->ring[i];
+      uint32_t       r_seq    = __atomic_load_n(&r->write_seq, __ATOMIC_SEQ_CST);
+      bool           alive    = __atomic_load_n(&r->writer_alive, __ATOMIC_SEQ_CST);
+      uint64_t       read_idx = __atomic_load_n(&r->reader[q->slot[i]].read_idx, __ATOMIC_RELAXED);
+      uint64_t       n        = __atomic_load_n(&r->write_idx, __ATOMIC_ACQUIRE) - read_idx;
+
+      // Drop sources whose transmitter is gone once all its samples are consumed
+      if (!alive && n == 0) {
+        rf_shm_info(q->id, "Transmitter %s closed\n", q->name[i]);
+        rf_shm_rx_detach(q, i);
+        continue;
+      }
+
+      if (n < avail) {
+        avail = n;
+        slow  = r;
+        seq   = r_seq;
+      }
+    }
+
+    if (avail != UINT64_MAX && avail > 0) {
+      return (int)SRSRAN_MIN(avail, (uint64_t)nsamples);
+    }
+
+    uint64_t now = rf_shm_time_ms();
+    if (now >= deadline) {
+      return SRSRAN_ERROR_TIMEOUT;
+    }
+
+    if (slow == NULL) {
+      // No transmitter yet, poll until one shows up
+      usleep(SHM_ATTACH_POLL_US);
+    } else {
+      // Sleep until the slowest source writes
+      __atomic_add_fetch(&slow->readers_waiting, 1, __ATOMIC_SEQ_CST);
+      rf_shm_futex_wait(&slow->write_seq, seq, (uint32_t)(deadline - now));
+      __atomic_sub_fetch(&slow->readers_waiting, 1, __ATOMIC_SEQ_CST);
+    }
+  }
+
+  return SRSRAN_ERROR;
+}
+
+/**
+ * Reads (or discards if buffer is NULL) nsamples from every attached source, adding them up in buffer.
+ */
+static void rf_shm_rx_consume(rf_shm_rx_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  bool first = true;
+
+  for (uint32_t i = 0; i < q->nof_sources; i++) {
+    rf_shm_ring_t* r = q->ring[i];
+    if (r == NULL) {
+      continue;
+    }
+
+    uint64_t read_idx = __atomic_load_n(&r->reader[q->slot[i]].read_idx, __ATOMIC_RELAXED);
+    uint32_t offset   = (uint32_t)(read_idx & r->mask);
+    uint32_t n1       = SRSRAN_MIN(nsamples, r->capacity - offset);
+
+    if (buffer != NULL) {
+      if (first) {
+        srsran_vec_cf_copy(buffer, &r->samples[offset], n1);
+        srsran_vec_cf_copy(&buffer[n1], &r->samples[0], nsamples - n1);
+      } else {
+        srsran_vec_sum_ccc(buffer, &r->samples[offset], buffer, n1);
+        srsran_vec_sum_ccc(&buffer[n1], &r->samples[0], &buffer[n1], nsamples - n1);
+      }
+    }
+    first = false;
+
+    // Release the samples and wake up the writer if it is waiting for room
+    __atomic_store_n(&r->reader[q->slot[i]].read_idx, read_idx + nsamples, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&r->read_seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&r->writer_waiting, __ATOMIC_SEQ_CST)) {
+      rf_shm_futex_wake(&r->read_seq);
+    }
+  }
+
+  // Sources that vanished in between contribute silence
+  if (first && buffer != NULL) {
+    srsran_vec_cf_zero(buffer, nsamples);
+  }
+}
+
+int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  pthread_mutex_lock(&q->mutex);
+
+  // If the read needs to be delayed
+  if (q->sample_offset > 0) {
+    uint32_t n = SRSRAN_MIN((uint32_t)q->sample_offset, nsamples);
+    srsran_vec_cf_zero(buffer, n);
+    q->sample_offset -= n;
+    pthread_mutex_unlock(&q->mutex);
+    return (int)n;
+  }
+
+  // If the read needs to be advanced
+  while (q->sample_offset < 0) {
+    int n = rf_shm_rx_wait(q, (uint32_t)-q->sample_offset);
+    if (n <= 0) {
+      pthread_mutex_unlock(&q->mutex);
+      return (n == 0) ? SRSRAN_ERROR_TIMEOUT : n;
+    }
+    rf_shm_rx_consume(q, NULL, (uint32_t)n);
+    q->sample_offset += n;
+  }
+
+  int n = rf_shm_rx_wait(q, nsamples);
+  if (n > 0) {
+    rf_shm_rx_consume(q, buffer, (uint32_t)n);
+  } else if (n == 0) {
+    n = SRSRAN_ERROR_TIMEOUT;
+  }
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return n;
+}
+
+bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+void rf_shm_rx_close(rf_shm_rx_t* q)
+{
+  if (!q->running) {
+    return;
+  }
+
+  rf_shm_info(q->id, "Closing ...\n");
+
+  pthread_mutex_lock(&q->mutex);
+  q->running = false;
+  for (uint32_t i = 0; i < q->nof_sources; i++) {
+    rf_shm_rx_detach(q, i);
+  }
+  pthread_mutex_unlock(&q->mutex);
+
+  pthread_mutex_destroy(&q->mutex);
+}
+
+bool rf_shm_rx_is_running(rf_shm_rx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  return q->running;
+}
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_SHM_IMP_TRX_H
+#define SRSRAN_RF_SHM_IMP_TRX_H
+
+#include "srsran/config.h"
+#include "srsran/phy/rf/rf.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Definitions */
+#define SHM_VERBOSE (0)
+#define SHM_RING_MAGIC (0x73726e73) // "srns"
+#define SHM_RING_VERSION (2)
+#define SHM_RING_DEFAULT_SIZE (1U << 20U) // Samples, must be a power of two (~45 ms at 23.04 MHz)
+#define SHM_MAX_READERS (8)
+#define SHM_MAX_SOURCES (8)
+#define SHM_MAX_BUFFER_SIZE (3072000) // Samples, 10 subframes at 20 MHz
+#define SHM_TIMEOUT_MS (2000)
+#define SHM_BASERATE_DEFAULT_HZ (23040000)
+#define SHM_ID_STRLEN 16
+#define SHM_MAX_GAIN_DB (30.0f)
+#define SHM_MIN_GAIN_DB (0.0f)
+#define SHM_CACHE_LINE (64)
+
+/**
+ * @brief Shared-memory ring header, followed by the sample storage.
+ *
+ * The ring is created by the transmitter (single producer) and attached by up to SHM_MAX_READERS receivers. Sample
+ * indexes are absolute, i.e. they are the timestamp of the sample in the base sample rate. The writer never overwrites
+ * samples that have not been consumed by every attached reader. The write and read sequence counters are used as futex
+ * words to block on an empty or full ring.
+ */
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t capacity; ///< Number of samples in the ring, power of two
+  uint32_t mask;     ///< capacity - 1
+  uint64_t idle_tail;
+  uint32_t writer_alive;
+  uint8_t  pad0[SHM_CACHE_LINE - 28];
+
+  // Producer cache line
+  uint64_t write_idx; ///< Absolute index of the next sample to write
+  uint32_t write_seq; ///< Futex word, incremented on every write
+  uint32_t writer_waiting;
+  uint8_t  pad1[SHM_CACHE_LINE - 16];
+
+  // Consumer cache lines
+  struct {
+    uint64_t read_idx; ///< Absolute index of the next sample to read
+    uint32_t active;
+    int32_t  pid; ///< Reader process, so that the writer can release the slot if the reader dies without detaching
+    uint32_t pad[SHM_CACHE_LINE / sizeof(uint32_t) - 4];
+  } reader[SHM_MAX_READERS];
+  uint32_t read_seq; ///< Futex word, incremented on every read
+  uint32_t readers_waiting;
+  uint8_t  pad2[SHM_CACHE_LINE - 8];
+
+  cf_t samples[];
+} rf_shm_ring_t;
+
+typedef struct {
+  char            id[SHM_ID_STRLEN];
+  char            name[RF_PARAM_LEN];
+  rf_shm_ring_t*  ring;
+  size_t          map_size;
+  bool            running; ///< Accessed atomically, close clears it without the mutex to unblock the writer
+  pthread_mutex_t mutex;
+  uint32_t        frequency_mhz;
+  uint32_t        trx_timeout_ms;
+  int32_t         sample_offset;
+} rf_shm_tx_t;
+
+typedef struct {
+  char            id[SHM_ID_STRLEN];
+  uint32_t        nof_sources;
+  char            name[SHM_MAX_SOURCES][RF_PARAM_LEN];
+  rf_shm_ring_t*  ring[SHM_MAX_SOURCES]; ///< Rings of the transmitters whose samples are added up (fan-in)
+  size_t          map_size[SHM_MAX_SOURCES];
+  int32_t         slot[SHM_MAX_SOURCES]; ///< Reader slot taken in each ring
+  bool            running;
+  pthread_mutex_t mutex;
+  uint32_t        frequency_mhz;
+  bool            fail_on_disconnect;
+  uint32_t        trx_timeout_ms;
+  bool            log_trx_timeout;
+  int32_t         sample_offset;
+} rf_shm_rx_t;
+
+typedef struct {
+  const char* id;
+  uint32_t    ring_size;
+  uint32_t    frequency_mhz;
+  bool        fail_on_disconnect;
+  uint32_t    trx_timeout_ms;
+  bool        log_trx_timeout;
+  int32_t     sample_offset; ///< offset in samples
+} rf_shm_opts_t;
+
+/*
+ * Common functions
+ */
+SRSRAN_API void rf_shm_info(char* id, const char* format, ...);
+
+SRSRAN_API void rf_shm_error(char* id, const char* format, ...);
+
+SRSRAN_API int rf_shm_futex_wait(uint32_t* word, uint32_t value, uint32_t timeout_ms);
+
+SRSRAN_API void rf_shm_futex_wake(uint32_t* word);
+
+SRSRAN_API uint64_t rf_shm_time_ms(void);
+
+/*
+ * Transmitter functions
+ */
+SRSRAN_API int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, const char* name);
+
+SRSRAN_API int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts);
+
+SRSRAN_API int rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, float scale, uint32_t nsamples);
+
+SRSRAN_API uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q);
+
+SRSRAN_API int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples);
+
+SRSRAN_API bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_tx_close(rf_shm_tx_t* q);
+
+SRSRAN_API bool rf_shm_tx_is_running(rf_shm_tx_t* q);
+
+/*
+ * Receiver functions
+ */
+SRSRAN_API int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, char* names);
+
+SRSRAN_API int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, uint32_t nsamples);
+
+SRSRAN_API bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_rx_close(rf_shm_rx_t* q);
+
+SRSRAN_API bool rf_shm_rx_is_running(rf_shm_rx_t* q);
+
+#endif // SRSRAN_RF_SHM_IMP_TRX_H
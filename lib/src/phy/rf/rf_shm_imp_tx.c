@@ -0,0 +1,326 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static uint64_t rf_shm_ring_tail(rf_shm_ring_t* r)
+{
+  uint64_t tail = UINT64_MAX;
+
+  // The tail is the oldest sample that has not been read by every attached reader
+  for (uint32_t i = 0; i < SHM_MAX_READERS; i++) {
+    if (__atomic_load_n(&r->reader[i].active, __ATOMIC_SEQ_CST)) {
+      uint64_t read_idx = __atomic_load_n(&r->reader[i].read_idx, __ATOMIC_SEQ_CST);
+      tail              = SRSRAN_MIN(tail, read_idx);
+    }
+  }
+
+  // Without readers, keep the samples from the last position a reader left
+  if (tail == UINT64_MAX) {
+    tail = __atomic_load_n(&r->idle_tail, __ATOMIC_SEQ_CST);
+  }
+
+  return tail;
+}
+
+/**
+ * Releases the slots of the readers whose process died without detaching, which would otherwise hold the tail of the
+ * ring forever. Their read position is left to the next reader, as if they had detached.
+ */
+static void rf_shm_ring_reclaim_readers(rf_shm_tx_t* q)
+{
+  rf_shm_ring_t* r = q->ring;
+
+  for (uint32_t i = 0; i < SHM_MAX_READERS; i++) {
+    int32_t pid = __atomic_load_n(&r->reader[i].pid, __ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&r->reader[i].active, __ATOMIC_SEQ_CST) || pid <= 0 || kill(pid, 0) == 0 ||
+        errno != ESRCH) {
+      continue;
+    }
+
+    // Clearing the PID first makes sure that the slot is not taken by a new reader in the meantime
+    if (!__atomic_compare_exchange_n(&r->reader[i].pid, &pid, 0, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+      continue;
+    }
+    uint64_t read_idx = __atomic_load_n(&r->reader[i].read_idx, __ATOMIC_SEQ_CST);
+    uint64_t idle     = __atomic_load_n(&r->idle_tail, __ATOMIC_SEQ_CST);
+    while (idle < read_idx && !__atomic_compare_exchange_n(
+                                  &r->idle_tail, &idle, read_idx, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+    }
+    __atomic_store_n(&r->reader[i].active, 0, __ATOMIC_SEQ_CST);
+
+    rf_shm_error(q->id, "Released reader slot %d of %s, its process %d is gone\n", i, q->name, pid);
+  }
+}
+
+int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, const char* name)
+{
+  int ret = SRSRAN_ERROR;
+  int fd  = -1;
+
+  if (q) {
+    // Zero object
+    bzero(q, sizeof(rf_shm_tx_t));
+
+    // Copy id
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+
+    // Shared memory object names must start with a slash
+    if (name[0] == '/') {
+      snprintf(q->name, RF_PARAM_LEN, "%s", name);
+    } else {
+      snprintf(q->name, RF_PARAM_LEN, "/%s", name);
+    }
+
+    // Capacity must be a power of two for masking the indexes
+    uint32_t capacity = (opts.ring_size != 0) ? opts.ring_size : SHM_RING_DEFAULT_SIZE;
+    if ((capacity & (capacity - 1)) != 0) {
+      fprintf(stderr, "[shm] Error: ring size %d is not a power of two\n", capacity);
+      goto clean_exit;
+    }
+
+    q->frequency_mhz  = opts.frequency_mhz;
+    q->sample_offset  = opts.sample_offset;
+    q->trx_timeout_ms = opts.trx_timeout_ms;
+    q->map_size       = sizeof(rf_shm_ring_t) + (size_t)capacity * sizeof(cf_t);
+
+    rf_shm_info(q->id, "Creating transmitter ring: %s\n", q->name);
+
+    // Remove any stale ring so that attached readers detect a new transmitter
+    shm_unlink(q->name);
+
+    fd = shm_open(q->name, O_CREAT | O_EXCL | O_RDWR, 0666);
+    if (fd < 0) {
+      fprintf(stderr, "[shm] Error: creating transmitter ring (%s): %s\n", q->name, strerror(errno));
+      goto clean_exit;
+    }
+
+    if (ftruncate(fd, (off_t)q->map_size) < 0) {
+      fprintf(stderr, "[shm] Error: allocating transmitter ring (%s): %s\n", q->name, strerror(errno));
+      goto clean_exit;
+    }
+
+    void* ptr = mmap(NULL, q->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED) {
+      fprintf(stderr, "[shm] Error: mapping transmitter ring (%s): %s\n", q->name, strerror(errno));
+      goto clean_exit;
+    }
+    q->ring = (rf_shm_ring_t*)ptr;
+
+    // Initialise header, the magic word is written last so readers only attach to complete rings
+    q->ring->version      = SHM_RING_VERSION;
+    q->ring->capacity     = capacity;
+    q->ring->mask         = capacity - 1;
+    q->ring->writer_alive = 1;
+    __atomic_store_n(&q->ring->magic, SHM_RING_MAGIC, __ATOMIC_RELEASE);
+
+    if (pthread_mutex_init(&q->mutex, NULL)) {
+      fprintf(stderr, "Error: creating mutex\n");
+      goto clean_exit;
+    }
+
+    __atomic_store_n(&q->running, true, __ATOMIC_SEQ_CST);
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  if (fd >= 0) {
+    close(fd);
+  }
+  return ret;
+}
+
+static int _rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, float scale, uint32_t nsamples)
+{
+  rf_shm_ring_t* r        = q->ring;
+  uint32_t       count    = 0;
+  uint64_t       deadline = 0;
+
+  while (count < nsamples) {
+    uint64_t write_idx = __atomic_load_n(&r->write_idx, __ATOMIC_RELAXED);
+    uint64_t tail      = rf_shm_ring_tail(r);
+    uint32_t space     = r->capacity - (uint32_t)(write_idx - tail);
+
+    // Block while the ring is full, like the ZMQ transmitter blocks until the receiver requests samples, but no longer
+    // than the transmit/receive timeout
+    if (space == 0) {
+      // Sample the sequence before checking the state, a read or a close in between then makes the wait return at once
+      uint32_t seq = __atomic_load_n(&r->read_seq, __ATOMIC_SEQ_CST);
+      if (!__atomic_load_n(&q->running, __ATOMIC_SEQ_CST)) {
+        return SRSRAN_ERROR;
+      }
+      uint64_t now = rf_shm_time_ms();
+      if (deadline == 0) {
+        deadline = now + q->trx_timeout_ms;
+      } else if (now >= deadline) {
+        rf_shm_error(q->id, "Transmitter ring %s full for %u ms, dropping %u samples\n", q->name, q->trx_timeout_ms,
+                     nsamples - count);
+        return SRSRAN_ERROR;
+      }
+      rf_shm_ring_reclaim_readers(q);
+
+      __atomic_store_n(&r->writer_waiting, 1, __ATOMIC_SEQ_CST);
+      if (rf_shm_ring_tail(r) == tail) {
+        rf_shm_futex_wait(&r->read_seq, seq, (uint32_t)SRSRAN_MAX(deadline - now, 1));
+      }
+      __atomic_store_n(&r->writer_waiting, 0, __ATOMIC_SEQ_CST);
+      continue;
+    }
+
+    uint32_t n      = SRSRAN_MIN(space, nsamples - count);
+    uint32_t offset = (uint32_t)(write_idx & r->mask);
+    uint32_t n1     = SRSRAN_MIN(n, r->capacity - offset);
+
+    // Write straight into the ring, applying the gain on the way
+    if (buffer != NULL) {
+      srsran_vec_sc_prod_cfc(&buffer[count], scale, &r->samples[offset], n1);
+      srsran_vec_sc_prod_cfc(&buffer[count + n1], scale, &r->samples[0], n - n1);
+    } else {
+      srsran_vec_cf_zero(&r->samples[offset], n1);
+      srsran_vec_cf_zero(&r->samples[0], n - n1);
+    }
+
+    // Publish samples and wake up blocked readers
+    __atomic_store_n(&r->write_idx, write_idx + n, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&r->write_seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&r->readers_waiting, __ATOMIC_SEQ_CST)) {
+      rf_shm_futex_wake(&r->write_seq);
+    }
+
+    count += n;
+  }
+
+  return (int)nsamples;
+}
+
+int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts)
+{
+  pthread_mutex_lock(&q->mutex);
+
+  int64_t nsamples = (int64_t)ts - (int64_t)__atomic_load_n(&q->ring->write_idx, __ATOMIC_RELAXED);
+
+  if (nsamples > 0) {
+    rf_shm_info(q->id, " - Detected Tx gap of %d samples.\n", nsamples);
+    _rf_shm_tx_baseband(q, NULL, 1.0f, (uint32_t)nsamples);
+  }
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)nsamples;
+}
+
+int rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, float scale, uint32_t nsamples)
+{
+  int n;
+
+  pthread_mutex_lock(&q->mutex);
+
+  if (q->sample_offset > 0) {
+    _rf_shm_tx_baseband(q, NULL, 1.0f, (uint32_t)q->sample_offset);
+    q->sample_offset = 0;
+  } else if (q->sample_offset < 0) {
+    n = SRSRAN_MIN(-q->sample_offset, nsamples);
+    buffer += n;
+    nsamples -= n;
+    q->sample_offset += n;
+    if (nsamples == 0) {
+      pthread_mutex_unlock(&q->mutex);
+      return n;
+    }
+  }
+
+  n = _rf_shm_tx_baseband(q, buffer, scale, nsamples);
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return n;
+}
+
+uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q)
+{
+  return __atomic_load_n(&q->ring->write_idx, __ATOMIC_RELAXED);
+}
+
+int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples)
+{
+  pthread_mutex_lock(&q->mutex);
+
+  rf_shm_info(q->id, " - Tx %d Zeros.\n", nsamples);
+  _rf_shm_tx_baseband(q, NULL, 1.0f, nsamples);
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)nsamples;
+}
+
+bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+void rf_shm_tx_close(rf_shm_tx_t* q)
+{
+  if (!__atomic_exchange_n(&q->running, false, __ATOMIC_SEQ_CST)) {
+    return;
+  }
+
+  // A writer blocked on a full ring holds the mutex, wake it up so that it sees it has to stop
+  __atomic_add_fetch(&q->ring->read_seq, 1, __ATOMIC_SEQ_CST);
+  rf_shm_futex_wake(&q->ring->read_seq);
+
+  pthread_mutex_lock(&q->mutex);
+
+  // Let readers know that no more samples will come
+  __atomic_store_n(&q->ring->writer_alive, 0, __ATOMIC_SEQ_CST);
+  __atomic_add_fetch(&q->ring->write_seq, 1, __ATOMIC_SEQ_CST);
+  rf_shm_futex_wake(&q->ring->write_seq);
+  pthread_mutex_unlock(&q->mutex);
+
+  pthread_mutex_destroy(&q->mutex);
+
+  munmap(q->ring, q->map_size);
+  q->ring = NULL;
+  shm_unlink(q->name);
+}
+
+bool rf_shm_tx_is_running(rf_shm_tx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  return __atomic_load_n(&q->running, __ATOMIC_SEQ_CST);
+}
@@ -0,0 +1,392 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp.h"
+#include "rf_shm_imp_trx.h"
+#include "srsran/common/tsan_options.h"
+#include "srsran/phy/common/timestamp.h"
+#include "srsran/phy/utils/debug.h"
+#include <complex.h>
+#include <pthread.h>
+#include <srsran/phy/common/phy_common.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define COMPARE_EPSILON (1e-6f)
+#define NOF_RX_ANT 4
+#define NUM_SF (500)
+#define SF_LEN (1920)
+#define RF_BUFFER_SIZE (SF_LEN * NUM_SF)
+#define TX_OFFSET_MS (4)
+#define NOF_FANIN_SRC 2
+#define RING_TEST_SIZE (8192)
+#define RING_TEST_TIMEOUT_MS (100)
+
+static cf_t ue_rx_buffer[NOF_RX_ANT][RF_BUFFER_SIZE];
+static cf_t enb_tx_buffer[NOF_RX_ANT][RF_BUFFER_SIZE];
+static cf_t enb_rx_buffer[NOF_RX_ANT][RF_BUFFER_SIZE];
+
+static srsran_rf_t ue_radio, enb_radio;
+pthread_t          rx_thread;
+
+void* ue_rx_thread_function(void* args)
+{
+  char rf_args[RF_PARAM_LEN];
+  strncpy(rf_args, (char*)args, RF_PARAM_LEN - 1);
+  rf_args[RF_PARAM_LEN - 1] = 0;
+
+  printf("opening rx device with args=%s\n", rf_args);
+  if (srsran_rf_open_devname(&ue_radio, "shm", rf_args, NOF_RX_ANT)) {
+    fprintf(stderr, "Error opening rf\n");
+    exit(-1);
+  }
+
+  // receive 5 subframes at once (i.e. mimic initial rx that receives one slot)
+  uint32_t num_slots          = NUM_SF / 5;
+  uint32_t num_samps_per_slot = SF_LEN * 5;
+  uint32_t num_rxed_samps     = 0;
+  for (uint32_t i = 0; i < num_slots; ++i) {
+    void* data_ptr[SRSRAN_MAX_PORTS] = {NULL};
+    for (uint32_t c = 0; c < NOF_RX_ANT; c++) {
+      data_ptr[c] = &ue_rx_buffer[c][i * num_samps_per_slot];
+    }
+    num_rxed_samps += srsran_rf_recv_with_time_multi(&ue_radio, data_ptr, num_samps_per_slot, true, NULL, NULL);
+  }
+
+  printf("received %d samples.\n", num_rxed_samps);
+
+  printf("closing ue shm device\n");
+  srsran_rf_close(&ue_radio);
+
+  return NULL;
+}
+
+void enb_tx_function(const char* tx_args, bool timed_tx)
+{
+  char rf_args[RF_PARAM_LEN];
+  strncpy(rf_args, tx_args, RF_PARAM_LEN - 1);
+  rf_args[RF_PARAM_LEN - 1] = 0;
+
+  printf("opening tx device with args=%s\n", rf_args);
+  if (srsran_rf_open_devname(&enb_radio, "shm", rf_args, NOF_RX_ANT)) {
+    fprintf(stderr, "Error opening rf\n");
+    exit(-1);
+  }
+
+  // generate random tx data
+  for (int c = 0; c < NOF_RX_ANT; c++) {
+    for (int i = 0; i < RF_BUFFER_SIZE; i++) {
+      enb_tx_buffer[c][i] = ((float)rand() / (float)RAND_MAX) + _Complex_I * ((float)rand() / (float)RAND_MAX);
+    }
+  }
+
+  // send data subframe per subframe
+  uint32_t num_txed_samples = 0;
+
+  // initial transmission without ts
+  void* data_ptr[SRSRAN_MAX_PORTS] = {NULL};
+  cf_t  tx_buffer[NOF_RX_ANT][SF_LEN];
+  for (int c = 0; c < NOF_RX_ANT; c++) {
+    memcpy(&tx_buffer[c], &enb_tx_buffer[c][num_txed_samples], SF_LEN * sizeof(cf_t));
+    data_ptr[c] = &tx_buffer[c][0];
+  }
+  int ret = srsran_rf_send_multi(&enb_radio, (void**)data_ptr, SF_LEN, true, true, false);
+  num_txed_samples += SF_LEN;
+
+  // from here on, all transmissions are timed relative to the last rx time
+  srsran_timestamp_t rx_time, tx_time;
+
+  for (uint32_t i = 0; i < NUM_SF - ((timed_tx) ? TX_OFFSET_MS : 1); ++i) {
+    // first recv samples
+    for (int c = 0; c < NOF_RX_ANT; c++) {
+      data_ptr[c] = enb_rx_buffer[c];
+    }
+    srsran_rf_recv_with_time_multi(&enb_radio, data_ptr, SF_LEN, true, &rx_time.full_secs, &rx_time.frac_secs);
+
+    // prepare data buffer
+    for (int c = 0; c < NOF_RX_ANT; c++) {
+      memcpy(&tx_buffer[c], &enb_tx_buffer[c][num_txed_samples], SF_LEN * sizeof(cf_t));
+      data_ptr[c] = &tx_buffer[c][0];
+    }
+
+    if (timed_tx) {
+      // timed tx relative to receive time (this will cause a cap in the rx'ed samples at the UE resulting in 3 zero
+      // subframes)
+      srsran_timestamp_copy(&tx_time, &rx_time);
+      srsran_timestamp_add(&tx_time, 0, TX_OFFSET_MS * 1e-3);
+      ret = srsran_rf_send_timed_multi(
+          &enb_radio, (void**)data_ptr, SF_LEN, tx_time.full_secs, tx_time.frac_secs, true, true, false);
+    } else {
+      // normal tx
+      ret = srsran_rf_send_multi(&enb_radio, (void**)data_ptr, SF_LEN, true, true, false);
+    }
+    if (ret != SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error sending data\n");
+      exit(-1);
+    }
+
+    num_txed_samples += SF_LEN;
+  }
+
+  printf("transmitted %d samples in %d subframes\n", num_txed_samples, NUM_SF);
+
+  printf("closing tx device\n");
+  srsran_rf_close(&enb_radio);
+}
+
+int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
+{
+  int ret = SRSRAN_ERROR;
+
+  // make sure we can receive in slots
+  if (NUM_SF % 5 != 0) {
+    fprintf(stderr, "number of subframes must be multiple of 5\n");
+    goto exit;
+  }
+
+  // start Rx thread
+  if (pthread_create(&rx_thread, NULL, ue_rx_thread_function, (void*)rx_args)) {
+    perror("pthread_create");
+    exit(-1);
+  }
+
+  enb_tx_function(tx_args, timed_tx);
+
+  // wait for rx thread
+  pthread_join(rx_thread, NULL);
+
+  // channel-wise comparison
+  for (int c = 0; c < NOF_RX_ANT; c++) {
+    // subframe-wise compare tx'ed and rx'ed data (stop 3 subframes earlier for timed tx)
+    for (uint32_t i = 0; i < NUM_SF - (timed_tx ? 3 : 0); ++i) {
+      uint32_t sf_offet = 0;
+      if (timed_tx && i >= 1) {
+        // for timed transmission, the enb inserts 3 zero subframes after the first untimed tx
+        sf_offet = (TX_OFFSET_MS - 1) * SF_LEN;
+      }
+
+      srsran_vec_sub_ccc(&ue_rx_buffer[c][sf_offet + i * SF_LEN],
+                         &enb_tx_buffer[c][i * SF_LEN],
+                         &ue_rx_buffer[c][sf_offet + i * SF_LEN],
+                         SF_LEN);
+      uint32_t max_ix = srsran_vec_max_abs_ci(&ue_rx_buffer[c][sf_offet + i * SF_LEN], SF_LEN);
+      if (cabsf(ue_rx_buffer[c][sf_offet + i * SF_LEN + max_ix]) > COMPARE_EPSILON) {
+        fprintf(stderr, "data mismatch in channel %d subframe %d\n", c, i);
+        goto exit;
+      }
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+exit:
+  return ret;
+}
+
+// Several transmitters feeding one receiver, the receiver gets the sum of all of them
+int fanin_test()
+{
+  int         ret = SRSRAN_ERROR;
+  srsran_rf_t tx_radio[NOF_FANIN_SRC] = {};
+  char        rf_args[RF_PARAM_LEN] = {};
+
+  for (uint32_t s = 0; s < NOF_FANIN_SRC; s++) {
+    snprintf(rf_args, RF_PARAM_LEN, "tx_port=shm_test_ue%d,id=ue%d,base_srate=1.92e6", s, s);
+    if (srsran_rf_open_devname(&tx_radio[s], "shm", rf_args, 1)) {
+      fprintf(stderr, "Error opening rf\n");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // every transmitter sends its own random signal
+  for (uint32_t s = 0; s < NOF_FANIN_SRC; s++) {
+    for (int i = 0; i < RF_BUFFER_SIZE; i++) {
+      enb_tx_buffer[s][i] = ((float)rand() / (float)RAND_MAX) + _Complex_I * ((float)rand() / (float)RAND_MAX);
+    }
+    for (uint32_t i = 0; i < NUM_SF; i++) {
+      if (srsran_rf_send(&tx_radio[s], &enb_tx_buffer[s][i * SF_LEN], SF_LEN, true) != SRSRAN_SUCCESS) {
+        fprintf(stderr, "Error sending data\n");
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  // receive the superposition
+  snprintf(rf_args, RF_PARAM_LEN, "rx_port=shm_test_ue0:shm_test_ue1,id=enb,base_srate=1.92e6");
+  if (srsran_rf_open_devname(&enb_radio, "shm", rf_args, 1)) {
+    fprintf(stderr, "Error opening rf\n");
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t i = 0; i < NUM_SF; i++) {
+    srsran_rf_recv_with_time(&enb_radio, &enb_rx_buffer[0][i * SF_LEN], SF_LEN, true, NULL, NULL);
+  }
+
+  srsran_vec_sum_ccc(enb_tx_buffer[0], enb_tx_buffer[1], enb_tx_buffer[2], RF_BUFFER_SIZE);
+  srsran_vec_sub_ccc(enb_rx_buffer[0], enb_tx_buffer[2], enb_rx_buffer[0], RF_BUFFER_SIZE);
+  uint32_t max_ix = srsran_vec_max_abs_ci(enb_rx_buffer[0], RF_BUFFER_SIZE);
+  if (cabsf(enb_rx_buffer[0][max_ix]) > COMPARE_EPSILON) {
+    fprintf(stderr, "data mismatch in sample %d\n", max_ix);
+    goto exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+exit:
+  srsran_rf_close(&enb_radio);
+  for (uint32_t s = 0; s < NOF_FANIN_SRC; s++) {
+    srsran_rf_close(&tx_radio[s]);
+  }
+  return ret;
+}
+
+static void* ring_tx_thread_function(void* args)
+{
+  rf_shm_tx_t* tx = (rf_shm_tx_t*)args;
+  return (void*)(intptr_t)rf_shm_tx_baseband(tx, enb_tx_buffer[0], 1.0f, SF_LEN);
+}
+
+// A transmitter facing a full ring must give up after the timeout, release the readers that died and stop on close
+int ring_test()
+{
+  int           ret                   = SRSRAN_ERROR;
+  char          rx_port[RF_PARAM_LEN] = "shm_test_ring";
+  rf_shm_tx_t   tx                    = {};
+  rf_shm_rx_t   rx                    = {};
+  rf_shm_opts_t opts                  = {};
+  pthread_t     tx_thread;
+  void*         tx_ret = NULL;
+  int           status = 0;
+
+  opts.id             = "ring";
+  opts.ring_size      = RING_TEST_SIZE;
+  opts.trx_timeout_ms = RING_TEST_TIMEOUT_MS;
+  if (rf_shm_tx_open(&tx, opts, rx_port) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error opening transmitter\n");
+    return SRSRAN_ERROR;
+  }
+
+  // A reader process that exits without detaching
+  pid_t pid = fork();
+  if (pid == 0) {
+    rf_shm_rx_t dead_rx = {};
+    _exit(rf_shm_rx_open(&dead_rx, opts, rx_port) == SRSRAN_SUCCESS ? 0 : 1);
+  }
+  if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    fprintf(stderr, "Error running the dead reader\n");
+    goto exit;
+  }
+
+  // The live reader keeps up with the transmitter, which must get past the slot of the dead one
+  if (rf_shm_rx_open(&rx, opts, rx_port) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error opening receiver\n");
+    goto exit;
+  }
+  for (uint32_t i = 0; i < 4 * RING_TEST_SIZE / SF_LEN; i++) {
+    if (rf_shm_tx_baseband(&tx, enb_tx_buffer[0], 1.0f, SF_LEN) != SF_LEN ||
+        rf_shm_rx_baseband(&rx, enb_rx_buffer[0], SF_LEN) != SF_LEN) {
+      fprintf(stderr, "Transmitter blocked by a dead reader in subframe %d\n", i);
+      goto exit;
+    }
+  }
+
+  // Once the reader stalls, the transmitter fills the ring and then times out
+  uint32_t nof_sf = 0;
+  while (rf_shm_tx_baseband(&tx, enb_tx_buffer[0], 1.0f, SF_LEN) == SF_LEN) {
+    if (++nof_sf > RING_TEST_SIZE / SF_LEN) {
+      fprintf(stderr, "Transmitter overwrote samples of a stalled reader\n");
+      goto exit;
+    }
+  }
+
+  // Closing the transmitter releases a writer blocked on the full ring, regardless of the timeout
+  tx.trx_timeout_ms = 60 * 1000;
+  if (pthread_create(&tx_thread, NULL, ring_tx_thread_function, &tx)) {
+    perror("pthread_create");
+    goto exit;
+  }
+  while (!__atomic_load_n(&tx.ring->writer_waiting, __ATOMIC_SEQ_CST)) {
+    usleep(1000);
+  }
+  uint64_t t0 = rf_shm_time_ms();
+  rf_shm_tx_close(&tx);
+  pthread_join(tx_thread, &tx_ret);
+  if ((intptr_t)tx_ret != SRSRAN_ERROR || rf_shm_time_ms() - t0 > RING_TEST_TIMEOUT_MS) {
+    fprintf(stderr, "Closing the transmitter did not release the blocked writer\n");
+    goto exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+exit:
+  rf_shm_rx_close(&rx);
+  rf_shm_tx_close(&tx);
+  return ret;
+}
+
+int main()
+{
+  // up to 4 trx radios with continous tx (no decimation, no timed tx)
+  if (run_test("tx_port=shm_test_ul0,tx_port=shm_test_ul1,tx_port=shm_test_ul2,tx_port=shm_test_ul3,rx_port="
+               "shm_test_dl0,rx_port=shm_test_dl1,rx_port=shm_test_dl2,rx_port=shm_test_dl3,id=ue,base_srate=1.92e6,"
+               "log_trx_timeout=true,trx_timeout_ms=1000",
+               "rx_port=shm_test_ul0,rx_port=shm_test_ul1,rx_port=shm_test_ul2,rx_port=shm_test_ul3,tx_port="
+               "shm_test_dl0,tx_port=shm_test_dl1,tx_port=shm_test_dl2,tx_port=shm_test_dl3,id=enb,base_srate=1.92e6",
+               false) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed!\n");
+    return -1;
+  }
+
+  // up to 4 trx radios with continous tx (timed tx)
+  if (run_test("tx_port=shm_test_ul0,tx_port=shm_test_ul1,tx_port=shm_test_ul2,tx_port=shm_test_ul3,rx_port="
+               "shm_test_dl0,rx_port=shm_test_dl1,rx_port=shm_test_dl2,rx_port=shm_test_dl3,id=ue,base_srate=1.92e6",
+               "rx_port=shm_test_ul0,rx_port=shm_test_ul1,rx_port=shm_test_ul2,rx_port=shm_test_ul3,tx_port="
+               "shm_test_dl0,tx_port=shm_test_dl1,tx_port=shm_test_dl2,tx_port=shm_test_dl3,id=enb,base_srate=1.92e6",
+               true) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test with timed tx failed!\n");
+    return -1;
+  }
+
+  // up to 4 trx radios with continous tx (timed tx) with decimation 23.04e6 <-> 1.92e6
+  if (run_test("tx_port=shm_test_ul0,tx_port=shm_test_ul1,tx_port=shm_test_ul2,tx_port=shm_test_ul3,rx_port="
+               "shm_test_dl0,rx_port=shm_test_dl1,rx_port=shm_test_dl2,rx_port=shm_test_dl3,id=ue,base_srate=23.04e6",
+               "rx_port=shm_test_ul0,rx_port=shm_test_ul1,rx_port=shm_test_ul2,rx_port=shm_test_ul3,tx_port="
+               "shm_test_dl0,tx_port=shm_test_dl1,tx_port=shm_test_dl2,tx_port=shm_test_dl3,id=enb,base_srate=23.04e6",
+               true) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test with timed tx and decimation failed!\n");
+    return -1;
+  }
+
+  // two transmitters into one receiver
+  if (fanin_test() != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Fan-in test failed!\n");
+    return -1;
+  }
+
+  // full ring, dead reader and close while blocked
+  if (ring_test() != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Ring test failed!\n");
+    return -1;
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -423,6 +423,29 @@ static int dci_blind_search(srsran_ue_dl_t*     q,
 {
   uint32_t nof_dci = 0;
   if (rnti) {
+    // Decode all the candidates of the search space at once, except the ones in already allocated locations. Locations
+    // allocated during the search below are decoded anyway, their result is just ignored.
+    int32_t  cand_idx[SRSRAN_MAX_CANDIDATES] = {};
+    uint32_t nof_cand                        = 0;
+    for (uint32_t l = 0; l < search_space->nof_locations; l++) {
+      cand_idx[l] = -1;
+      if (dci_location_is_allocated(q, search_space->loc[l])) {
+        continue;
+      }
+      cand_idx[l] = (int32_t)nof_cand;
+      for (uint32_t f = 0; f < search_space->nof_formats; f++) {
+        srsran_dci_msg_t* cand = &q->dci_cand[nof_cand++];
+        cand->location         = search_space->loc[l];
+        cand->format           = search_space->formats[f];
+        cand->rnti             = 0;
+        cand->nof_bits         = 0;
+      }
+    }
+    if (srsran_pdcch_decode_msg_batch(&q->pdcch, sf, dci_cfg, q->dci_cand, nof_cand)) {
+      ERROR("Error decoding DCI msg");
+      return SRSRAN_ERROR;
+    }
+
     for (int l = 0; l < search_space->nof_locations; l++) {
       if (nof_dci >= SRSRAN_MAX_DCI_MSG) {
         ERROR("Can't store more DCIs in buffer");
@@ -440,14 +463,8 @@ static int dci_blind_search(srsran_ue_dl_t*     q,
              l,
              search_space->nof_locations);
 
-        // Try to decode a valid DCI msg
-        dci_msg[nof_dci].location = search_space->loc[l];
-        dci_msg[nof_dci].format   = search_space->formats[f];
-        dci_msg[nof_dci].rnti     = 0;
-        if (srsran_pdcch_decode_msg(&q->pdcch, sf, dci_cfg, &dci_msg[nof_dci])) {
-          ERROR("Error decoding DCI msg");
-          return SRSRAN_ERROR;
-        }
+        // Take the decoded DCI msg
+        dci_msg[nof_dci] = q->dci_cand[cand_idx[l] + f];
 
         // Check if RNTI is matched
         if ((dci_msg[nof_dci].rnti == rnti) && (dci_msg[nof_dci].nof_bits > 0)) {
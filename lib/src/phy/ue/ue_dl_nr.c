@@ -236,109 +236,45 @@ void srsran_ue_dl_nr_estimate_fft(srsran_ue_dl_nr_t* q, const srsran_slot_cfg_t*
   }
 }
 
-static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
-                                  srsran_dci_msg_nr_t*   dci_msg,
-                                  srsran_pdcch_nr_res_t* pdcch_res,
-                                  uint32_t               coreset_id)
+/// Appends a blind search candidate, sharing the location with previous candidates in the same CORESET and CCEs
+static int ue_dl_nr_add_candidate(srsran_ue_dl_nr_t* q, const srsran_dci_msg_nr_t* dci_msg)
 {
-  // Select debug information
-  srsran_ue_dl_nr_pdcch_info_t* pdcch_info = NULL;
-  if (q->pdcch_info_count < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR) {
-    pdcch_info = &q->pdcch_info[q->pdcch_info_count];
-    q->pdcch_info_count++;
-  } else {
+  if (q->pdcch_cand_count >= SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR) {
     ERROR("The UE does not expect more than %d candidates in this serving cell", SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR);
     return SRSRAN_ERROR;
   }
-  SRSRAN_MEM_ZERO(pdcch_info, srsran_ue_dl_nr_pdcch_info_t, 1);
-  pdcch_info->dci_ctx            = dci_msg->ctx;
-  pdcch_info->nof_bits           = dci_msg->nof_bits;
-  srsran_dmrs_pdcch_measure_t* m = &pdcch_info->measure;
-
-  // Measures the PDCCH transmission DMRS
-  srsran_dci_location_t location = dci_msg->ctx.location;
-  if (srsran_dmrs_pdcch_get_measure(&q->dmrs_pdcch[coreset_id], &location, m) < SRSRAN_SUCCESS) {
-    ERROR("Error getting measure location L=%d, ncce=%d", location.L, location.ncce);
-    return SRSRAN_ERROR;
-  }
-
-  // If measured correlation is invalid, early return
-  if (!isnormal(m->norm_corr)) {
-    INFO("Discarded PDCCH candidate L=%d;ncce=%d; Invalid measurement;", location.L, location.ncce);
-    return SRSRAN_SUCCESS;
-  }
 
-  // Compare EPRE with threshold
-  if (m->epre_dBfs < q->pdcch_dmrs_epre_thr) {
-    INFO("Discarded PDCCH candidate L=%d;ncce=%d; EPRE is too weak (%.1f<%.1f);",
-         location.L,
-         location.ncce,
-         m->epre_dBfs,
-         q->pdcch_dmrs_epre_thr);
-    return SRSRAN_SUCCESS;
-  }
-
-  // Compare DMRS correlation with threshold
-  if (m->norm_corr < q->pdcch_dmrs_corr_thr) {
-    INFO("Discarded PDCCH candidate L=%d;ncce=%d; Correlation is too low (%.1f<%.1f); EPRE=%+.2f; RSRP=%+.2f;",
-         location.L,
-         location.ncce,
-         m->norm_corr,
-         q->pdcch_dmrs_corr_thr,
-         m->epre_dBfs,
-         m->rsrp_dBfs);
-    return SRSRAN_SUCCESS;
-  }
-
-  // Extract PDCCH channel estimates
-  if (srsran_dmrs_pdcch_get_ce(&q->dmrs_pdcch[coreset_id], &location, q->pdcch_ce) < SRSRAN_SUCCESS) {
-    ERROR("Error extracting PDCCH DMRS");
-    return SRSRAN_ERROR;
+  // Find the candidate location
+  uint32_t loc_idx = 0;
+  for (; loc_idx < q->pdcch_loc_count; loc_idx++) {
+    const srsran_ue_dl_nr_pdcch_location_t* loc = &q->pdcch_loc[loc_idx];
+    if (loc->coreset_id == dci_msg->ctx.coreset_id && loc->location.L == dci_msg->ctx.location.L &&
+        loc->location.ncce == dci_msg->ctx.location.ncce) {
+      break;
+    }
   }
 
-  // Decode PDCCH
-  if (srsran_pdcch_nr_decode(&q->pdcch, q->sf_symbols[0], q->pdcch_ce, dci_msg, pdcch_res) < SRSRAN_SUCCESS) {
-    ERROR("Error decoding PDCCH");
-    return SRSRAN_ERROR;
+  // Append new location
+  if (loc_idx == q->pdcch_loc_count) {
+    srsran_ue_dl_nr_pdcch_location_t* loc = &q->pdcch_loc[loc_idx];
+    SRSRAN_MEM_ZERO(loc, srsran_ue_dl_nr_pdcch_location_t, 1);
+    loc->coreset_id = dci_msg->ctx.coreset_id;
+    loc->location   = dci_msg->ctx.location;
+    q->pdcch_loc_count++;
   }
 
-#if 0
-  static uint32_t num_pdcch = 0;
-  char            tmpstr[64];
-  snprintf(tmpstr, 64, "pdcch_symbols%d.dat", num_pdcch);
-  printf("save %d syms to %s\n", q->pdcch.M / 4, tmpstr);
-  srsran_vec_save_file(tmpstr, q->pdcch.symbols, q->pdcch.M / 4 * sizeof(cf_t));
-  // srsran_vec_fprint_c(stdout, q->pdcch.symbols, q->pdcch.M/4);
-  num_pdcch++;
-#endif
-
-  // Save information
-  pdcch_info->result = *pdcch_res;
+  q->pdcch_cand[q->pdcch_cand_count]     = *dci_msg;
+  q->pdcch_cand_loc[q->pdcch_cand_count] = loc_idx;
+  q->pdcch_cand_count++;
 
   return SRSRAN_SUCCESS;
 }
 
-static bool find_dci_msg(srsran_dci_msg_nr_t* dci_msg, uint32_t nof_dci_msg, srsran_dci_msg_nr_t* match)
-{
-  bool     found    = false;
-  uint32_t nof_bits = match->nof_bits;
-
-  for (int k = 0; k < nof_dci_msg && !found; k++) {
-    if (dci_msg[k].nof_bits == nof_bits) {
-      if (memcmp(dci_msg[k].payload, match->payload, nof_bits) == 0) {
-        found = true;
-      }
-    }
-  }
-
-  return found;
-}
-
-static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
-                                const srsran_slot_cfg_t*     slot_cfg,
-                                const srsran_search_space_t* search_space,
-                                uint16_t                     rnti,
-                                srsran_rnti_type_t           rnti_type)
+static int ue_dl_nr_add_candidates_ss(srsran_ue_dl_nr_t*           q,
+                                      const srsran_slot_cfg_t*     slot_cfg,
+                                      const srsran_search_space_t* search_space,
+                                      uint16_t                     rnti,
+                                      srsran_rnti_type_t           rnti_type)
 {
   uint32_t dci_sizes[SRSRAN_DCI_NR_MAX_NOF_SIZES] = {};
   uint32_t dci_sizes_count                        = 0;
@@ -351,12 +287,6 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
   }
   srsran_coreset_t* coreset = &q->cfg.coreset[search_space->coreset_id];
 
-  // Set CORESET in PDCCH decoder
-  if (srsran_pdcch_nr_set_carrier(&q->pdcch, &q->carrier, coreset) < SRSRAN_SUCCESS) {
-    ERROR("Setting carrier and CORESETºn");
-    return SRSRAN_ERROR;
-  }
-
   // Iterate all possible formats
   for (uint32_t format_idx = 0; format_idx < SRSRAN_MIN(search_space->nof_formats, SRSRAN_DCI_FORMAT_NR_COUNT);
        format_idx++) {
@@ -388,9 +318,7 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
     dci_sizes[dci_sizes_count++] = dci_nof_bits;
 
     // Iterate all possible aggregation levels
-    for (uint32_t L = 0;
-         L < SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR;
-         L++) {
+    for (uint32_t L = 0; L < SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR; L++) {
       // Calculate possible PDCCH DCI candidates
       uint32_t candidates[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
       int      nof_candidates                                        = srsran_pdcch_nr_locations_coreset(
@@ -401,7 +329,7 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
       }
 
       // Iterate over the candidates
-      for (int ncce_idx = 0; ncce_idx < nof_candidates && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR; ncce_idx++) {
+      for (int ncce_idx = 0; ncce_idx < nof_candidates; ncce_idx++) {
         // Build DCI context
         srsran_dci_ctx_t ctx = {};
         ctx.location.L       = L;
@@ -418,70 +346,238 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
         dci_msg.ctx                 = ctx;
         dci_msg.nof_bits            = (uint32_t)dci_nof_bits;
 
-        // Find and decode PDCCH transmission in the given ncce
-        srsran_pdcch_nr_res_t res = {};
-        if (ue_dl_nr_find_dci_ncce(q, &dci_msg, &res, coreset_id) < SRSRAN_SUCCESS) {
+        if (ue_dl_nr_add_candidate(q, &dci_msg) < SRSRAN_SUCCESS) {
           return SRSRAN_ERROR;
         }
+      }
+    }
+  }
 
-        // If the CRC was not match, move to next candidate
-        if (!res.crc) {
-          continue;
-        }
+  return SRSRAN_SUCCESS;
+}
 
-        // Detect if the DCI is the right direction
-        if (!srsran_dci_nr_valid_direction(&dci_msg)) {
-          // Change grant format direction
-          switch (dci_msg.ctx.format) {
-            case srsran_dci_format_nr_0_0:
-              dci_msg.ctx.format = srsran_dci_format_nr_1_0;
-              break;
-            case srsran_dci_format_nr_0_1:
-              dci_msg.ctx.format = srsran_dci_format_nr_1_1;
-              break;
-            case srsran_dci_format_nr_1_0:
-              dci_msg.ctx.format = srsran_dci_format_nr_0_0;
-              break;
-            case srsran_dci_format_nr_1_1:
-              dci_msg.ctx.format = srsran_dci_format_nr_0_1;
-              break;
-            default:
-              continue;
-          }
-        }
+/// Measures the DMRS of a candidate location and decides whether its candidates are worth decoding
+static int ue_dl_nr_measure_location(srsran_ue_dl_nr_t* q, srsran_ue_dl_nr_pdcch_location_t* loc)
+{
+  srsran_dmrs_pdcch_measure_t* m = &loc->measure;
 
-        // If UL grant, enqueue in UL list
-        if (dci_msg.ctx.format == srsran_dci_format_nr_0_0 || dci_msg.ctx.format == srsran_dci_format_nr_0_1) {
-          // If the pending UL grant list is full or has the dci message, keep moving
-          if (q->ul_dci_count >= SRSRAN_MAX_DCI_MSG_NR || find_dci_msg(q->ul_dci_msg, q->ul_dci_count, &dci_msg)) {
-            continue;
-          }
+  // Measures the PDCCH transmission DMRS
+  if (srsran_dmrs_pdcch_get_measure(&q->dmrs_pdcch[loc->coreset_id], &loc->location, m) < SRSRAN_SUCCESS) {
+    ERROR("Error getting measure location L=%d, ncce=%d", loc->location.L, loc->location.ncce);
+    return SRSRAN_ERROR;
+  }
 
-          // Save the grant in the pending UL grant list
-          q->ul_dci_msg[q->ul_dci_count] = dci_msg;
-          q->ul_dci_count++;
+  // If measured correlation is invalid, early return
+  if (!isnormal(m->norm_corr)) {
+    INFO("Discarded PDCCH candidate L=%d;ncce=%d; Invalid measurement;", loc->location.L, loc->location.ncce);
+    loc->pruned = true;
+    return SRSRAN_SUCCESS;
+  }
 
-          // Move to next candidate
-          continue;
-        }
+  // Compare EPRE with threshold
+  if (m->epre_dBfs < q->pdcch_dmrs_epre_thr) {
+    INFO("Discarded PDCCH candidate L=%d;ncce=%d; EPRE is too weak (%.1f<%.1f);",
+         loc->location.L,
+         loc->location.ncce,
+         m->epre_dBfs,
+         q->pdcch_dmrs_epre_thr);
+    loc->pruned = true;
+    return SRSRAN_SUCCESS;
+  }
 
-        // Check if the grant exists already in the DL list
-        if (find_dci_msg(q->dl_dci_msg, q->dl_dci_msg_count, &dci_msg)) {
-          // The same DCI is in the list, keep moving
-          continue;
-        }
+  // Compare DMRS correlation with threshold
+  if (m->norm_corr < q->pdcch_dmrs_corr_thr) {
+    INFO("Discarded PDCCH candidate L=%d;ncce=%d; Correlation is too low (%.1f<%.1f); EPRE=%+.2f; RSRP=%+.2f;",
+         loc->location.L,
+         loc->location.ncce,
+         m->norm_corr,
+         q->pdcch_dmrs_corr_thr,
+         m->epre_dBfs,
+         m->rsrp_dBfs);
+    loc->pruned = true;
+    return SRSRAN_SUCCESS;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Gets the first candidate in the same location as the given one with the same DCI size and scrambling. Candidates
+/// that only differ in the search space they belong to are decoded once
+static uint32_t ue_dl_nr_first_equal_candidate(const srsran_ue_dl_nr_t* q, uint32_t idx)
+{
+  const srsran_dci_msg_nr_t* dci_msg = &q->pdcch_cand[idx];
+  for (uint32_t j = 0; j < idx; j++) {
+    const srsran_dci_msg_nr_t* prev = &q->pdcch_cand[j];
+    if (q->pdcch_cand_loc[j] == q->pdcch_cand_loc[idx] && prev->nof_bits == dci_msg->nof_bits &&
+        prev->ctx.ss_type == dci_msg->ctx.ss_type) {
+      return j;
+    }
+  }
+  return idx;
+}
+
+/// Demodulates a location that passed the DMRS measurements once and queues its candidates for decoding
+static int ue_dl_nr_queue_location(srsran_ue_dl_nr_t* q, uint32_t loc_idx)
+{
+  srsran_ue_dl_nr_pdcch_location_t* loc = &q->pdcch_loc[loc_idx];
+
+  // Extract PDCCH channel estimates
+  if (srsran_dmrs_pdcch_get_ce(&q->dmrs_pdcch[loc->coreset_id], &loc->location, q->pdcch_ce) < SRSRAN_SUCCESS) {
+    ERROR("Error extracting PDCCH DMRS");
+    return SRSRAN_ERROR;
+  }
+
+  // Set CORESET in PDCCH decoder
+  if (srsran_pdcch_nr_set_carrier(&q->pdcch, &q->carrier, &q->cfg.coreset[loc->coreset_id]) < SRSRAN_SUCCESS) {
+    ERROR("Setting carrier and CORESET");
+    return SRSRAN_ERROR;
+  }
+
+  // Demodulate the location once for all its candidates
+  if (srsran_pdcch_nr_demodulate(&q->pdcch, q->sf_symbols[0], q->pdcch_ce, &loc->location) < SRSRAN_SUCCESS) {
+    ERROR("Error demodulating PDCCH");
+    return SRSRAN_ERROR;
+  }
 
-        INFO("Found DCI in L=%d,ncce=%d", dci_msg.ctx.location.L, dci_msg.ctx.location.ncce);
-        // Append DCI message into the list
-        q->dl_dci_msg[q->dl_dci_msg_count] = dci_msg;
-        q->dl_dci_msg_count++;
+  for (uint32_t i = 0; i < q->pdcch_cand_count; i++) {
+    if (q->pdcch_cand_loc[i] != loc_idx || ue_dl_nr_first_equal_candidate(q, i) != i) {
+      continue;
+    }
+
+    if (srsran_pdcch_nr_decode_batch_add(&q->pdcch, &q->pdcch_cand[i], &q->pdcch_info[i].result) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding PDCCH");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Measures all the candidate locations, then decodes the candidates in the locations that were not pruned
+static int ue_dl_nr_blind_search(srsran_ue_dl_nr_t* q)
+{
+  // Measure every location once
+  for (uint32_t loc_idx = 0; loc_idx < q->pdcch_loc_count; loc_idx++) {
+    if (ue_dl_nr_measure_location(q, &q->pdcch_loc[loc_idx]) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // Save blind search information, candidates in pruned locations are not decoded
+  for (uint32_t i = 0; i < q->pdcch_cand_count; i++) {
+    srsran_ue_dl_nr_pdcch_info_t* pdcch_info = &q->pdcch_info[i];
+    SRSRAN_MEM_ZERO(pdcch_info, srsran_ue_dl_nr_pdcch_info_t, 1);
+    pdcch_info->dci_ctx  = q->pdcch_cand[i].ctx;
+    pdcch_info->nof_bits = q->pdcch_cand[i].nof_bits;
+    pdcch_info->measure  = q->pdcch_loc[q->pdcch_cand_loc[i]].measure;
+  }
+  q->pdcch_info_count = q->pdcch_cand_count;
+
+  // Decode surviving locations, the candidates of an aggregation level are polar decoded in batches
+  for (uint32_t L = 0; L < SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR; L++) {
+    for (uint32_t loc_idx = 0; loc_idx < q->pdcch_loc_count; loc_idx++) {
+      if (q->pdcch_loc[loc_idx].pruned || q->pdcch_loc[loc_idx].location.L != L) {
+        continue;
+      }
+      if (ue_dl_nr_queue_location(q, loc_idx) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
       }
     }
+
+    if (srsran_pdcch_nr_decode_batch_run(&q->pdcch) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding PDCCH");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // Reuse the result of the first candidate with the same location, size and scrambling
+  for (uint32_t i = 0; i < q->pdcch_cand_count; i++) {
+    uint32_t j = ue_dl_nr_first_equal_candidate(q, i);
+    if (j == i || q->pdcch_loc[q->pdcch_cand_loc[i]].pruned) {
+      continue;
+    }
+    q->pdcch_info[i].result = q->pdcch_info[j].result;
+    srsran_vec_u8_copy(q->pdcch_cand[i].payload, q->pdcch_cand[j].payload, q->pdcch_cand[i].nof_bits);
   }
 
   return SRSRAN_SUCCESS;
 }
 
+static bool find_dci_msg(srsran_dci_msg_nr_t* dci_msg, uint32_t nof_dci_msg, srsran_dci_msg_nr_t* match)
+{
+  bool     found    = false;
+  uint32_t nof_bits = match->nof_bits;
+
+  for (int k = 0; k < nof_dci_msg && !found; k++) {
+    if (dci_msg[k].nof_bits == nof_bits) {
+      if (memcmp(dci_msg[k].payload, match->payload, nof_bits) == 0) {
+        found = true;
+      }
+    }
+  }
+
+  return found;
+}
+
+/// Stores the DCI messages of the candidates that passed the CRC, in search order, in the DL or UL lists
+static void ue_dl_nr_save_found_dci(srsran_ue_dl_nr_t* q, uint32_t nof_dl_dci_msg)
+{
+  for (uint32_t i = 0; i < q->pdcch_cand_count && q->dl_dci_msg_count < nof_dl_dci_msg; i++) {
+    // If the CRC was not match, move to next candidate
+    if (!q->pdcch_info[i].result.crc) {
+      continue;
+    }
+    srsran_dci_msg_nr_t dci_msg = q->pdcch_cand[i];
+
+    // Detect if the DCI is the right direction
+    if (!srsran_dci_nr_valid_direction(&dci_msg)) {
+      // Change grant format direction
+      switch (dci_msg.ctx.format) {
+        case srsran_dci_format_nr_0_0:
+          dci_msg.ctx.format = srsran_dci_format_nr_1_0;
+          break;
+        case srsran_dci_format_nr_0_1:
+          dci_msg.ctx.format = srsran_dci_format_nr_1_1;
+          break;
+        case srsran_dci_format_nr_1_0:
+          dci_msg.ctx.format = srsran_dci_format_nr_0_0;
+          break;
+        case srsran_dci_format_nr_1_1:
+          dci_msg.ctx.format = srsran_dci_format_nr_0_1;
+          break;
+        default:
+          continue;
+      }
+    }
+
+    // If UL grant, enqueue in UL list
+    if (dci_msg.ctx.format == srsran_dci_format_nr_0_0 || dci_msg.ctx.format == srsran_dci_format_nr_0_1) {
+      // If the pending UL grant list is full or has the dci message, keep moving
+      if (q->ul_dci_count >= SRSRAN_MAX_DCI_MSG_NR || find_dci_msg(q->ul_dci_msg, q->ul_dci_count, &dci_msg)) {
+        continue;
+      }
+
+      // Save the grant in the pending UL grant list
+      q->ul_dci_msg[q->ul_dci_count] = dci_msg;
+      q->ul_dci_count++;
+
+      // Move to next candidate
+      continue;
+    }
+
+    // Check if the grant exists already in the DL list
+    if (find_dci_msg(q->dl_dci_msg, q->dl_dci_msg_count, &dci_msg)) {
+      // The same DCI is in the list, keep moving
+      continue;
+    }
+
+    INFO("Found DCI in L=%d,ncce=%d", dci_msg.ctx.location.L, dci_msg.ctx.location.ncce);
+    // Append DCI message into the list
+    q->dl_dci_msg[q->dl_dci_msg_count] = dci_msg;
+    q->dl_dci_msg_count++;
+  }
+}
+
 int srsran_ue_dl_nr_find_dl_dci(srsran_ue_dl_nr_t*       q,
                                 const srsran_slot_cfg_t* slot_cfg,
                                 uint16_t                 rnti,
@@ -500,25 +596,27 @@ int srsran_ue_dl_nr_find_dl_dci(srsran_ue_dl_nr_t*       q,
   // Reset grant and blind search information counters
   q->dl_dci_msg_count = 0;
   q->pdcch_info_count = 0;
+  q->pdcch_cand_count = 0;
+  q->pdcch_loc_count  = 0;
 
   // If the UE looks for a RAR and RA search space is provided, search for it
   if (q->cfg.ra_search_space_present && rnti_type == srsran_rnti_type_ra) {
     // Find DCIs in the RA search space
-    int ret = ue_dl_nr_find_dci_ss(q, slot_cfg, &q->cfg.ra_search_space, rnti, rnti_type);
+    int ret = ue_dl_nr_add_candidates_ss(q, slot_cfg, &q->cfg.ra_search_space, rnti, rnti_type);
     if (ret < SRSRAN_SUCCESS) {
       ERROR("Error searching RAR DCI");
       return SRSRAN_ERROR;
     }
   } else {
     // Iterate all possible common and UE search spaces
-    for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_SEARCH_SPACE && q->dl_dci_msg_count < nof_dci_msg; i++) {
+    for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_SEARCH_SPACE; i++) {
       // Skip search space if not present
       if (!q->cfg.search_space_present[i]) {
         continue;
       }
 
       // Find DCIs in the selected search space
-      int ret = ue_dl_nr_find_dci_ss(q, slot_cfg, &q->cfg.search_space[i], rnti, rnti_type);
+      int ret = ue_dl_nr_add_candidates_ss(q, slot_cfg, &q->cfg.search_space[i], rnti, rnti_type);
       if (ret < SRSRAN_SUCCESS) {
         ERROR("Error searching DCI");
         return SRSRAN_ERROR;
@@ -526,6 +624,12 @@ int srsran_ue_dl_nr_find_dl_dci(srsran_ue_dl_nr_t*       q,
     }
   }
 
+  // Measure and decode all the candidates of all the search spaces at once
+  if (ue_dl_nr_blind_search(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  ue_dl_nr_save_found_dci(q, nof_dci_msg);
+
   // Convert found DCI messages into DL grants
   uint32_t dci_msg_count = SRSRAN_MIN(nof_dci_msg, q->dl_dci_msg_count);
   for (uint32_t i = 0; i < dci_msg_count; i++) {
@@ -974,7 +974,7 @@ double radio::get_dev_cal_tx_adv_sec(const std::string& device_name)
             cur_tx_srate);
         nsamples = blade_default_tx_adv_samples + (int)(blade_default_tx_adv_offset_sec * cur_tx_srate);
       }
-    } else if (device_name == "zmq") {
+    } else if (device_name == "zmq" || device_name == "shm") {
       nsamples = 0;
     }
   } else {
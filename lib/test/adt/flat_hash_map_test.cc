@@ -0,0 +1,149 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/flat_hash_map.h"
+#include "srsran/common/test_common.h"
+#include <map>
+#include <random>
+#include <set>
+
+namespace srsran {
+
+void test_flat_hash_map_basic()
+{
+  flat_hash_map<uint64_t, std::string> myobj;
+  TESTASSERT(myobj.size() == 0 and myobj.empty());
+  TESTASSERT(myobj.begin() == myobj.end());
+
+  TESTASSERT(not myobj.contains(0));
+  TESTASSERT(myobj.emplace(0, "obj0").second);
+  TESTASSERT(myobj.contains(0) and myobj[0] == "obj0");
+  TESTASSERT(myobj.size() == 1 and not myobj.empty());
+  TESTASSERT(myobj.begin() != myobj.end());
+
+  TESTASSERT(not myobj.emplace(0, "obj1").second);
+  TESTASSERT(myobj[0] == "obj0");
+  TESTASSERT(myobj.insert(std::make_pair(1, std::string("obj1"))).second);
+  TESTASSERT(myobj.count(1) == 1 and myobj.find(1)->second == "obj1");
+  TESTASSERT(myobj.find(2) == myobj.end());
+
+  // TEST: operator[] default-constructs missing elements
+  TESTASSERT(myobj[2].empty());
+  myobj[2] = "obj2";
+  TESTASSERT(myobj.size() == 3);
+
+  // TEST: iteration and const iteration
+  std::set<uint64_t> keys;
+  for (std::pair<uint64_t, std::string>& obj : myobj) {
+    TESTASSERT(obj.second == "obj" + std::to_string(obj.first));
+    keys.insert(obj.first);
+  }
+  TESTASSERT(keys.size() == 3);
+  const flat_hash_map<uint64_t, std::string>& cobj  = myobj;
+  size_t                                      count = 0;
+  for (flat_hash_map<uint64_t, std::string>::const_iterator it = cobj.begin(); it != myobj.end(); ++it) {
+    count++;
+  }
+  TESTASSERT(count == 3);
+
+  // TEST: erase
+  TESTASSERT(myobj.erase(1) == 1);
+  TESTASSERT(myobj.erase(1) == 0);
+  myobj.erase(myobj.find(0));
+  TESTASSERT(myobj.size() == 1 and myobj.contains(2) and not myobj.contains(0));
+
+  myobj.clear();
+  TESTASSERT(myobj.empty() and myobj.begin() == myobj.end());
+}
+
+void test_flat_hash_map_growth()
+{
+  flat_hash_map<uint32_t, uint32_t> myobj(4);
+  myobj.reserve(1000);
+  size_t cap = myobj.capacity();
+  TESTASSERT(cap >= 2000);
+  for (uint32_t i = 0; i < 1000; ++i) {
+    TESTASSERT(myobj.emplace(i, i * 2).second);
+  }
+  TESTASSERT(myobj.capacity() == cap);
+  TESTASSERT(myobj.size() == 1000);
+
+  // Grows past the reserved capacity, keeping all elements
+  for (uint32_t i = 1000; i < 5000; ++i) {
+    myobj[i] = i * 2;
+  }
+  TESTASSERT(myobj.capacity() > cap);
+  for (uint32_t i = 0; i < 5000; ++i) {
+    TESTASSERT(myobj.contains(i) and myobj.find(i)->second == i * 2);
+  }
+}
+
+/// Random insertions/erasures are checked against std::map. A small key space leads to long probe sequences, which
+/// exercise the backward shift on erasure
+void test_flat_hash_map_random(uint64_t key_space)
+{
+  std::mt19937                            rgen(key_space);
+  flat_hash_map<uint64_t, uint64_t>       myobj;
+  std::map<uint64_t, uint64_t>            ref;
+  std::uniform_int_distribution<uint64_t> key_dist(0, key_space - 1);
+
+  for (uint32_t n = 0; n < 100000; ++n) {
+    uint64_t key = key_dist(rgen) * 4096; // keys sharing the low bits, like IMSIs with a common prefix
+    switch (rgen() % 4) {
+      case 0:
+      case 1:
+        TESTASSERT(myobj.emplace(key, n).second == ref.emplace(key, n).second);
+        break;
+      case 2:
+        TESTASSERT(myobj.erase(key) == ref.erase(key));
+        break;
+      default:
+        auto it = myobj.find(key);
+        TESTASSERT((it == myobj.end()) == (ref.count(key) == 0));
+        if (it != myobj.end()) {
+          TESTASSERT(it->second == ref[key]);
+        }
+        break;
+    }
+    TESTASSERT(myobj.size() == ref.size());
+  }
+
+  std::map<uint64_t, uint64_t> content(myobj.begin(), myobj.end());
+  TESTASSERT(content == ref);
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_flat_hash_map_basic();
+  srsran::test_flat_hash_map_growth();
+  srsran::test_flat_hash_map_random(64);
+  srsran::test_flat_hash_map_random(10000);
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
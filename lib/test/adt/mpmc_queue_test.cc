@@ -0,0 +1,127 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/mpmc_queue.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+struct C {
+  C() : val_ptr(new int(5)) { count++; }
+  C(int v) : val_ptr(new int(v)) { count++; }
+  ~C() { count--; }
+  C(C&& other) : val_ptr(std::move(other.val_ptr)) { count++; }
+  C& operator=(C&&) = default;
+
+  std::unique_ptr<int> val_ptr;
+
+  static size_t count;
+};
+size_t C::count = 0;
+
+void test_mpmc_queue_single_thread()
+{
+  {
+    static_mpmc_queue<C, 8> queue;
+    TESTASSERT(queue.max_size() == 8);
+    TESTASSERT(queue.empty());
+
+    // push until full
+    for (int i = 0; i < 8; ++i) {
+      TESTASSERT(queue.try_push(C(i)));
+      TESTASSERT(queue.size() == (size_t)i + 1);
+    }
+    TESTASSERT(not queue.try_push(C(8)));
+    TESTASSERT(C::count == 8);
+
+    // pop in FIFO order, wrapping around the ring
+    for (int i = 0; i < 20; ++i) {
+      C obj;
+      TESTASSERT(queue.try_pop(obj));
+      TESTASSERT(*obj.val_ptr == i);
+      TESTASSERT(queue.try_push(C(i + 8)));
+    }
+    TESTASSERT(queue.size() == 8);
+  }
+  // elements left in the queue are destroyed
+  TESTASSERT(C::count == 0);
+
+  static_mpmc_queue<int, 4> queue;
+  int                       val = 0;
+  TESTASSERT(not queue.try_pop(val));
+}
+
+void test_mpmc_queue_multi_thread()
+{
+  const int                        nof_producers = 4;
+  const int                        nof_items     = 100000;
+  static_mpmc_queue<uint64_t, 256> queue;
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&queue, p]() {
+      for (uint64_t i = 0; i < nof_items; ++i) {
+        uint64_t val = ((uint64_t)p << 32U) | i;
+        while (not queue.try_push(val)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // every producer's items shall arrive exactly once and in order
+  std::vector<uint64_t> next(nof_producers, 0);
+  int                   received = 0;
+  while (received < nof_producers * nof_items) {
+    uint64_t val;
+    if (not queue.try_pop(val)) {
+      std::this_thread::yield();
+      continue;
+    }
+    uint32_t p = val >> 32U;
+    TESTASSERT(p < nof_producers);
+    TESTASSERT((val & 0xffffffffUL) == next[p]);
+    next[p]++;
+    received++;
+  }
+
+  for (auto& t : producers) {
+    t.join();
+  }
+  TESTASSERT(queue.empty());
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_mpmc_queue_single_thread();
+  srsran::test_mpmc_queue_multi_thread();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
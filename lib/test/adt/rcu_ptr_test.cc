@@ -0,0 +1,127 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/rcu_ptr.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+struct versioned_obj {
+  explicit versioned_obj(uint32_t v) : version(v), check(~v) { count++; }
+  ~versioned_obj()
+  {
+    // Overwrite the contents, so that readers of a destroyed object detect it
+    version = 0;
+    check   = 0;
+    count--;
+  }
+
+  uint32_t version;
+  uint32_t check;
+
+  static std::atomic<int> count;
+};
+std::atomic<int> versioned_obj::count{0};
+
+void test_rcu_ptr_single_thread()
+{
+  {
+    rcu_ptr<versioned_obj> ptr;
+    TESTASSERT(not ptr.read());
+    TESTASSERT(ptr.get_unsafe() == nullptr);
+
+    ptr.publish(std::unique_ptr<versioned_obj>(new versioned_obj(1)));
+    {
+      auto guard = ptr.read();
+      TESTASSERT(guard);
+      TESTASSERT(guard->version == 1);
+    }
+
+    // The previous version is destroyed once published, when there are no readers
+    ptr.publish(std::unique_ptr<versioned_obj>(new versioned_obj(2)));
+    TESTASSERT(versioned_obj::count == 1);
+    TESTASSERT(ptr.read()->version == 2);
+    TESTASSERT(ptr.get_unsafe()->version == 2);
+  }
+  TESTASSERT(versioned_obj::count == 0);
+}
+
+void test_rcu_ptr_multi_thread()
+{
+  const int              nof_readers  = 4;
+  const uint32_t         nof_versions = 2000;
+  rcu_ptr<versioned_obj> ptr(std::unique_ptr<versioned_obj>(new versioned_obj(1)));
+  std::atomic<bool>      running{true};
+  std::atomic<uint32_t>  nof_errors{0};
+  std::atomic<int>       nof_started{0};
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < nof_readers; ++r) {
+    readers.emplace_back([&]() {
+      uint32_t last_version = 0;
+      nof_started++;
+      while (running.load(std::memory_order_relaxed)) {
+        auto guard = ptr.read();
+        // The object shall stay valid for as long as the guard is held and versions shall never go backwards
+        uint32_t version = guard->version;
+        std::this_thread::yield();
+        if (guard->version != version or guard->check != ~version or version < last_version) {
+          nof_errors++;
+        }
+        last_version = version;
+      }
+    });
+  }
+
+  while (nof_started < nof_readers) {
+    std::this_thread::yield();
+  }
+
+  for (uint32_t v = 2; v <= nof_versions; ++v) {
+    ptr.publish(std::unique_ptr<versioned_obj>(new versioned_obj(v)));
+    // The previous version has been destroyed by the time publish returns
+    TESTASSERT(versioned_obj::count == 1);
+  }
+
+  running = false;
+  for (auto& t : readers) {
+    t.join();
+  }
+  TESTASSERT(nof_errors == 0);
+  TESTASSERT(ptr.read()->version == nof_versions);
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_rcu_ptr_single_thread();
+  srsran::test_rcu_ptr_multi_thread();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/asn1/ngap.h"
+#include "srsran/asn1/rrc.h"
+#include "srsran/asn1/s1ap.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <cstdlib>
+
+using namespace asn1;
+
+// Representative messages of the RRC, S1AP and NGAP procedures that run on every UE attach/session setup
+
+// RRCConnectionReconfiguration with measConfig, radioResourceConfigDedicated and dedicatedInfoNAS
+const uint8_t rrc_conn_recfg_msg[] = {
+    0x20, 0x16, 0x15, 0xC8, 0x40, 0x00, 0x03, 0xC2, 0x84, 0x18, 0x10, 0xA8, 0x04, 0xD7, 0x95, 0x14, 0xA2, 0x01, 0x02,
+    0x18, 0x9A, 0x01, 0x80, 0x14, 0x81, 0x0A, 0xCB, 0x84, 0x08, 0x00, 0xAD, 0x6D, 0xC4, 0x06, 0x08, 0xAF, 0x6D, 0xC7,
+    0xA0, 0xC0, 0x82, 0x00, 0x00, 0x0C, 0x38, 0x60, 0x20, 0x30, 0xC3, 0x00, 0x00, 0x10, 0x04, 0x40, 0x10, 0xC2, 0x3C,
+    0x2A, 0x06, 0x20, 0x30, 0x11, 0x10, 0x28, 0x13, 0xDA, 0x4E, 0x96, 0xDA, 0x80, 0x83, 0xA1, 0x00, 0xA4, 0x83, 0x00,
+    0x32, 0x7B, 0x08, 0x95, 0xAE, 0x00, 0x16, 0xA9, 0x00, 0xE0, 0x80, 0x84, 0x8C, 0x82, 0xBB, 0xB1, 0xB4, 0xBA, 0x18,
+    0x83, 0x36, 0xB7, 0x31, 0x98, 0x18, 0x98, 0x83, 0x36, 0xB1, 0xB1, 0x9A, 0x1B, 0x1B, 0x02, 0x33, 0xB8, 0x39, 0x39,
+    0x82, 0x80, 0x85, 0x7F, 0x80, 0x80, 0xAF, 0x03, 0x7F, 0x7F, 0x7D, 0x7D, 0x7F, 0x7F, 0x28, 0x05, 0xFB, 0x32, 0x7B,
+    0x08, 0xC0, 0x00, 0x01, 0xF8, 0x3E, 0x3C, 0xB1, 0xB2, 0x00, 0xC0, 0x30, 0x38, 0x1F, 0xFA, 0x9C, 0x08, 0x3E, 0xA2,
+    0x5F, 0x1C, 0xE1, 0xD0, 0x84};
+
+// S1AP InitialContextSetupRequest with one E-RAB and the Attach Accept NAS PDU
+const uint8_t s1ap_init_ctxt_setup_msg[] = {
+    0x00, 0x09, 0x00, 0x80, 0xc6, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x02, 0x00, 0x64, 0x00, 0x08, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x42, 0x00, 0x0a, 0x18, 0x3b, 0x9a, 0xca, 0x00, 0x60, 0x3b, 0x9a, 0xca, 0x00, 0x00, 0x18, 0x00, 0x78,
+    0x00, 0x00, 0x34, 0x00, 0x73, 0x45, 0x00, 0x09, 0x3c, 0x0f, 0x80, 0x0a, 0x00, 0x21, 0xf0, 0xb7, 0x36, 0x1c, 0x56,
+    0x64, 0x27, 0x3e, 0x5b, 0x04, 0xb7, 0x02, 0x07, 0x42, 0x02, 0x3e, 0x06, 0x00, 0x09, 0xf1, 0x07, 0x00, 0x07, 0x00,
+    0x37, 0x52, 0x66, 0xc1, 0x01, 0x09, 0x1b, 0x07, 0x74, 0x65, 0x73, 0x74, 0x31, 0x32, 0x33, 0x06, 0x6d, 0x6e, 0x63,
+    0x30, 0x37, 0x30, 0x06, 0x6d, 0x63, 0x63, 0x39, 0x30, 0x31, 0x04, 0x67, 0x70, 0x72, 0x73, 0x05, 0x01, 0xc0, 0xa8,
+    0x03, 0x02, 0x27, 0x0e, 0x80, 0x80, 0x21, 0x0a, 0x03, 0x00, 0x00, 0x0a, 0x81, 0x06, 0x08, 0x08, 0x08, 0x08, 0x50,
+    0x0b, 0xf6, 0x09, 0xf1, 0x07, 0x80, 0x01, 0x01, 0xf6, 0x7e, 0x72, 0x69, 0x13, 0x09, 0xf1, 0x07, 0x00, 0x01, 0x23,
+    0x05, 0xf4, 0xf6, 0x7e, 0x72, 0x69, 0x00, 0x6b, 0x00, 0x05, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x49, 0x00, 0x20,
+    0x45, 0x25, 0xe4, 0x9a, 0x77, 0xc8, 0xd5, 0xcf, 0x26, 0x33, 0x63, 0xeb, 0x5b, 0xb9, 0xc3, 0x43, 0x9b, 0x9e, 0xb3,
+    0x86, 0x1f, 0xa8, 0xa7, 0xcf, 0x43, 0x54, 0x07, 0xae, 0x42, 0x2b, 0x63, 0xb9};
+
+// NGAP PDUSessionResourceSetupRequest with one PDU session and its PDUSessionResourceSetupRequestTransfer
+const uint8_t ngap_pdu_session_res_setup_msg[] = {
+    0x00, 0x1d, 0x00, 0x6c, 0x00, 0x00, 0x04, 0x00, 0x0a, 0x00, 0x02, 0x00, 0x01, 0x00, 0x55, 0x00, 0x02, 0x00, 0x01,
+    0x00, 0x26, 0x00, 0x2e, 0x2d, 0x7e, 0x00, 0x68, 0x01, 0x00, 0x25, 0x2e, 0x01, 0x00, 0xc2, 0x11, 0x00, 0x06, 0x01,
+    0x00, 0x03, 0x30, 0x01, 0x01, 0x06, 0x06, 0x03, 0xe8, 0x06, 0x03, 0xe8, 0x29, 0x05, 0x01, 0xc0, 0xa8, 0x0c, 0x7b,
+    0x25, 0x08, 0x07, 0x64, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x12, 0x01, 0x00, 0x4a, 0x00, 0x27, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x21, 0x00, 0x00, 0x03, 0x00, 0x8b, 0x00, 0x0a, 0x01, 0xf0, 0xc0, 0xa8, 0x11, 0xd2, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x86, 0x00, 0x01, 0x10, 0x00, 0x88, 0x00, 0x07, 0x00, 0x01, 0x00, 0x00, 0x09, 0x00, 0x00};
+
+/// Unpacks and packs the message nof_runs times, and checks that the packed message matches the original one. If an
+/// arena is given, the message is unpacked into it
+template <typename Msg>
+int run_benchmark(const char* name, const uint8_t* msg, uint32_t msg_len, uint32_t nof_runs, arena* a)
+{
+  uint8_t                   buf[1024];
+  std::chrono::nanoseconds  unpack_time{0}, pack_time{0};
+  std::chrono::steady_clock clock;
+  alloc_stats_t             stats0 = get_alloc_stats();
+
+  for (uint32_t i = 0; i < nof_runs; ++i) {
+    Msg         pdu;
+    cbit_ref    bref(msg, msg_len);
+    auto        tp  = clock.now();
+    SRSASN_CODE ret = (a != nullptr) ? unpack_in_arena(pdu, bref, *a) : pdu.unpack(bref);
+    unpack_time += clock.now() - tp;
+    TESTASSERT(ret == SRSASN_SUCCESS);
+
+    bit_ref bref2(buf, sizeof(buf));
+    tp  = clock.now();
+    ret = pdu.pack(bref2);
+    pack_time += clock.now() - tp;
+    TESTASSERT(ret == SRSASN_SUCCESS);
+
+    TESTASSERT(bref2.distance_bytes() == (int)msg_len);
+    TESTASSERT(memcmp(buf, msg, msg_len) == 0);
+  }
+
+  const alloc_stats_t& stats     = get_alloc_stats();
+  double               unpack_ns = (double)unpack_time.count() / nof_runs;
+  double               pack_ns   = (double)pack_time.count() / nof_runs;
+  fmt::print("{:<36}{:>6}{:>6d}{:>14.1f}{:>14.1f}{:>12.1f}{:>12.1f}{:>12.1f}{:>12.1f}\n",
+             name,
+             (a != nullptr) ? "arena" : "heap",
+             msg_len,
+             unpack_ns,
+             pack_ns,
+             msg_len * 8 / unpack_ns * 1000,
+             msg_len * 8 / pack_ns * 1000,
+             (double)(stats.nof_heap_allocs - stats0.nof_heap_allocs) / nof_runs,
+             (double)(stats.nof_arena_allocs - stats0.nof_arena_allocs) / nof_runs);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  uint32_t nof_runs = (argc > 1) ? (uint32_t)strtoul(argv[1], nullptr, 10) : 100000;
+  if (nof_runs == 0) {
+    fmt::print("Usage: {} [nof_runs]\n", argv[0]);
+    return SRSRAN_ERROR;
+  }
+
+  auto& asn1_logger = srslog::fetch_basic_logger("ASN1", false);
+  asn1_logger.set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  fmt::print("Running {} iterations per message\n\n", nof_runs);
+  fmt::print("{:<36}{:>6}{:>6}{:>14}{:>14}{:>12}{:>12}{:>12}{:>12}\n",
+             "message",
+             "alloc",
+             "bytes",
+             "unpack [ns]",
+             "pack [ns]",
+             "unpack Mbps",
+             "pack Mbps",
+             "heap/msg",
+             "arena/msg");
+
+  int   ret = SRSRAN_SUCCESS;
+  arena rx_arena;
+  for (arena* a : {(arena*)nullptr, &rx_arena}) {
+    ret |= run_benchmark<rrc::dl_dcch_msg_s>(
+        "RRCConnectionReconfiguration", rrc_conn_recfg_msg, sizeof(rrc_conn_recfg_msg), nof_runs, a);
+    ret |= run_benchmark<s1ap::s1ap_pdu_c>(
+        "S1AP InitialContextSetupRequest", s1ap_init_ctxt_setup_msg, sizeof(s1ap_init_ctxt_setup_msg), nof_runs, a);
+    ret |= run_benchmark<ngap::ngap_pdu_c>("NGAP PDUSessionResourceSetupRequest",
+                                           ngap_pdu_session_res_setup_msg,
+                                           sizeof(ngap_pdu_session_res_setup_msg),
+                                           nof_runs,
+                                           a);
+  }
+  fmt::print("\nArena chunks allocated: {}\n", rx_arena.nof_chunk_allocs());
+
+  srslog::flush();
+  return ret;
+}
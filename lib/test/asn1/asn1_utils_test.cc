@@ -527,6 +527,65 @@ int test_copy_ptr()
   return 0;
 }
 
+int test_arena()
+{
+  alloc_stats_t stats0 = get_alloc_stats();
+
+  arena                 a(1024);
+  dyn_array<uint32_t>   heap_array(4);
+  dyn_octstring         octs;
+  dyn_seq_of<int, 0, 8> seq;
+  TESTASSERT(get_alloc_stats().nof_heap_allocs == stats0.nof_heap_allocs + 1);
+  {
+    arena_scope scope(a);
+    octs.resize(100);
+    seq.resize(8);
+    TESTASSERT(get_alloc_stats().nof_arena_allocs == stats0.nof_arena_allocs + 2);
+    TESTASSERT(a.nof_chunk_allocs() == 1);
+
+    // Blocks larger than a chunk get their own chunk
+    dyn_array<uint8_t> large(2048);
+    TESTASSERT(a.nof_chunk_allocs() == 2);
+  }
+  // Outside the scope, containers go back to the heap
+  dyn_array<uint8_t> heap_array2(16);
+  TESTASSERT(get_alloc_stats().nof_heap_allocs == stats0.nof_heap_allocs + 2);
+  TESTASSERT(get_alloc_stats().nof_arena_allocs == stats0.nof_arena_allocs + 3);
+
+  // Arena blocks can be resized, copied and freed after the scope ended
+  for (uint32_t i = 0; i < seq.size(); ++i) {
+    seq[i] = i;
+  }
+  dyn_seq_of<int, 0, 8> seq2 = seq;
+  TESTASSERT(seq2 == seq);
+  octs.resize(200);
+  octs.resize(0);
+
+  // The chunk is reused once all its blocks are freed
+  {
+    arena_scope scope(a);
+    dyn_array<uint8_t> tmp(512);
+  }
+  uint32_t nof_chunks = a.nof_chunk_allocs();
+  for (uint32_t i = 0; i < 10; ++i) {
+    arena_scope        scope(a);
+    dyn_array<uint8_t> tmp(512);
+  }
+  TESTASSERT(a.nof_chunk_allocs() == nof_chunks);
+
+  // Blocks may outlive the arena
+  dyn_array<uint64_t>* orphan;
+  {
+    arena       a2;
+    arena_scope scope(a2);
+    orphan = new dyn_array<uint64_t>(10);
+  }
+  (*orphan)[9] = 9;
+  delete orphan;
+
+  return 0;
+}
+
 class EnumTest
 {
 public:
@@ -694,6 +753,7 @@ int main()
   TESTASSERT(test_bitstring() == 0);
   TESTASSERT(test_seq_of() == 0);
   TESTASSERT(test_copy_ptr() == 0);
+  TESTASSERT(test_arena() == 0);
   TESTASSERT(test_enum() == 0);
   TESTASSERT(test_big_integers() == 0);
   test_varlength_field_pack();
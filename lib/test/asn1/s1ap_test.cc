@@ -93,6 +93,33 @@ int test_init_ctxt_setup_req()
 
   TESTASSERT(test_pack_unpack_consistency(pdu) == SRSASN_SUCCESS);
 
+  // Index the IEs and decode them one by one
+  ap_pdu_index index;
+  TESTASSERT(index.unpack(s1ap_msg, sizeof(s1ap_msg)) == SRSASN_SUCCESS);
+  TESTASSERT(index.pdu_type() == ap_pdu_index::pdu_type_t::init_msg);
+  TESTASSERT(index.proc_code() == ASN1_S1AP_ID_INIT_CONTEXT_SETUP);
+  TESTASSERT(index.proc_crit().value == crit_opts::reject);
+  TESTASSERT(index.ies().size() == 6);
+  TESTASSERT(index.find_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID) != nullptr);
+  TESTASSERT(index.find_ie(ASN1_S1AP_ID_HO_RESTRICT_LIST) == nullptr);
+
+  mme_ue_s1ap_id_t mme_ue_id;
+  TESTASSERT(index.unpack_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID, mme_ue_id) == SRSASN_SUCCESS);
+  TESTASSERT(mme_ue_id.value == ctxt_setup->mme_ue_s1ap_id.value.value);
+  ue_security_cap_s sec_cap;
+  TESTASSERT(index.unpack_ie(ASN1_S1AP_ID_UE_SECURITY_CAP, sec_cap) == SRSASN_SUCCESS);
+  TESTASSERT(sec_cap.encryption_algorithms == ctxt_setup->ue_security_cap.value.encryption_algorithms);
+  TESTASSERT(sec_cap.integrity_protection_algorithms ==
+             ctxt_setup->ue_security_cap.value.integrity_protection_algorithms);
+
+  s1ap_pdu_c pdu2;
+  TESTASSERT(index.unpack_pdu(pdu2) == SRSASN_SUCCESS);
+  TESTASSERT(pdu2.init_msg().value.init_context_setup_request()->security_key.value ==
+             ctxt_setup->security_key.value);
+
+  // A truncated PDU can't be indexed
+  TESTASSERT(index.unpack(s1ap_msg, sizeof(s1ap_msg) - 1) != SRSASN_SUCCESS);
+
   return SRSRAN_SUCCESS;
 }
 
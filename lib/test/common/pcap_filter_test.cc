@@ -0,0 +1,168 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/mac_pcap_base.h"
+#include "srsran/common/pcap_filter.h"
+#include "srsran/common/test_common.h"
+
+using srsran::pcap_filter;
+using srsran::pcap_filter_cfg_t;
+
+int test_parse()
+{
+  pcap_filter_cfg_t cfg;
+  TESTASSERT(srsran::parse_pcap_filter({"rnti=0x46,71", "lcid=3,4", "sample=10", "snaplen=64"}, cfg));
+  TESTASSERT(cfg.rntis.size() == 2 and cfg.rntis[0] == 0x46 and cfg.rntis[1] == 71);
+  TESTASSERT(cfg.lcids.size() == 2 and cfg.lcids[0] == 3 and cfg.lcids[1] == 4);
+  TESTASSERT(cfg.sample_ratio == 10);
+  TESTASSERT(cfg.max_len == 64);
+  TESTASSERT(srsran::to_string(cfg) == "rnti=0x46,0x47 lcid=3,4 sample=1/10 snaplen=64");
+
+  TESTASSERT(srsran::parse_pcap_filter({"off"}, cfg));
+  TESTASSERT(cfg.rntis.empty() and cfg.lcids.empty() and cfg.sample_ratio == 1 and cfg.max_len == 0);
+
+  // Malformed filters
+  TESTASSERT(not srsran::parse_pcap_filter({"rnti=70000"}, cfg));
+  TESTASSERT(not srsran::parse_pcap_filter({"lcid=64"}, cfg));
+  TESTASSERT(not srsran::parse_pcap_filter({"sample=0"}, cfg));
+  TESTASSERT(not srsran::parse_pcap_filter({"rnti="}, cfg));
+  TESTASSERT(not srsran::parse_pcap_filter({"rnti=0x46x"}, cfg));
+  TESTASSERT(not srsran::parse_pcap_filter({"foo=1"}, cfg));
+  TESTASSERT(not srsran::parse_pcap_filter({"snaplen"}, cfg));
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_match()
+{
+  pcap_filter filter;
+
+  // Empty filter captures everything
+  TESTASSERT(filter.match_rnti(0x46) and filter.match_lcid(3) and filter.match());
+  TESTASSERT(filter.snap_len(1500) == 1500);
+
+  pcap_filter_cfg_t cfg;
+  cfg.rntis = {0x46, 0xffff};
+  cfg.lcids = {0, 63};
+  filter.set(cfg);
+  TESTASSERT(filter.match_rnti(0x46) and filter.match_rnti(0xffff));
+  TESTASSERT(not filter.match_rnti(0x47) and not filter.match_rnti(0));
+  TESTASSERT(filter.match_lcid(0) and filter.match_lcid(63));
+  TESTASSERT(not filter.match_lcid(1) and not filter.match_lcid(64));
+  TESTASSERT(filter.match());
+
+  // 1-in-N sampling is applied after the RNTI filter
+  cfg.sample_ratio = 4;
+  cfg.max_len      = 32;
+  filter.set(cfg);
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < 100; i++) {
+    count += filter.match_rnti(0x46) ? 1 : 0;
+    TESTASSERT(not filter.match_rnti(0x47));
+  }
+  TESTASSERT(count == 25);
+  TESTASSERT(filter.snap_len(1500) == 32 and filter.snap_len(10) == 10);
+
+  filter.clear();
+  TESTASSERT(filter.match_rnti(0x47) and filter.match_rnti(0x47));
+  TESTASSERT(filter.snap_len(1500) == 1500);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Queues the captured PDUs without writing them anywhere
+class mac_pcap_spy : public srsran::mac_pcap_base
+{
+public:
+  mac_pcap_spy() { enable(true); }
+  uint32_t close() override { return SRSRAN_SUCCESS; }
+
+  uint32_t nof_captured()
+  {
+    uint32_t   count = 0;
+    pcap_pdu_t pdu   = {};
+    while (queue.try_pop(pdu)) {
+      count++;
+    }
+    return count;
+  }
+
+private:
+  void write_pdu(pcap_pdu_t& pdu) override {}
+};
+
+int test_mac_lcid()
+{
+  std::unique_ptr<mac_pcap_spy> pcap(new mac_pcap_spy);
+
+  // TA command, LCID 3 (7-bit L) and LCID 1 (last, no L)
+  uint8_t eutra_dl[] = {0x3d, 0x23, 0x02, 0x01, 0x00, 0xaa, 0xbb, 0xcc, 0xdd};
+  // Short BSR, LCID 4 (8-bit L) and padding
+  uint8_t nr_ul[] = {0x3d, 0x00, 0x04, 0x02, 0xaa, 0xbb, 0x3f, 0x00};
+  // TA command and LCID 5 (16-bit L)
+  uint8_t nr_dl[] = {0x3d, 0x00, 0x45, 0x00, 0x03, 0xaa, 0xbb, 0xcc};
+  // Extended PHR (7-bit L of 34 B) and LCID 3 (last, no L)
+  uint8_t eutra_ul[40] = {0x39, 0x22, 0x03};
+
+  pcap_filter_cfg_t cfg;
+  cfg.lcids = {1, 4};
+  pcap->set_filter(cfg);
+  pcap->write_dl_crnti(eutra_dl, sizeof(eutra_dl), 0x46, true, 0, 0);
+  pcap->write_ul_crnti_nr(nr_ul, sizeof(nr_ul), 0x46, 0, 0);
+  TESTASSERT(pcap->nof_captured() == 2);
+
+  // PDUs without any of the logical channels are not captured, nor are the ones without logical channels at all
+  cfg.lcids = {5};
+  pcap->set_filter(cfg);
+  pcap->write_dl_crnti(eutra_dl, sizeof(eutra_dl), 0x46, true, 0, 0);
+  pcap->write_ul_crnti_nr(nr_ul, sizeof(nr_ul), 0x46, 0, 0);
+  pcap->write_dl_ranti(eutra_dl, sizeof(eutra_dl), 0x2, true, 0, 0);
+  TESTASSERT(pcap->nof_captured() == 0);
+  pcap->write_dl_crnti_nr(nr_dl, sizeof(nr_dl), 0x46, 0, 0);
+  TESTASSERT(pcap->nof_captured() == 1);
+
+  // The L field of the Extended PHR is not mistaken for a subheader of LCID 2
+  cfg.lcids = {2};
+  pcap->set_filter(cfg);
+  pcap->write_ul_crnti(eutra_ul, sizeof(eutra_ul), 0x46, 0, 0, 0, 0);
+  TESTASSERT(pcap->nof_captured() == 0);
+  cfg.lcids = {3};
+  pcap->set_filter(cfg);
+  pcap->write_ul_crnti(eutra_ul, sizeof(eutra_ul), 0x46, 0, 0, 0, 0);
+  TESTASSERT(pcap->nof_captured() == 1);
+
+  // Without LCID filter every PDU is captured
+  pcap->set_filter(pcap_filter_cfg_t{});
+  pcap->write_dl_ranti(eutra_dl, sizeof(eutra_dl), 0x2, true, 0, 0);
+  pcap->write_ul_crnti_nr(nr_ul, sizeof(nr_ul), 0x46, 0, 0);
+  TESTASSERT(pcap->nof_captured() == 2);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_parse() == SRSRAN_SUCCESS);
+  TESTASSERT(test_match() == SRSRAN_SUCCESS);
+  TESTASSERT(test_mac_lcid() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,210 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pcap.h"
+#include "srsran/common/pcap_writer.h"
+#include "srsran/common/test_common.h"
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using srsran::pcap_writer;
+
+static const uint32_t nof_records = 1000;
+
+static std::vector<uint8_t> read_file(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static uint32_t read_u32(const std::vector<uint8_t>& data, size_t offset)
+{
+  uint32_t val;
+  memcpy(&val, &data[offset], sizeof(val));
+  return val;
+}
+
+// Untruncated record length, every other record is written as if it was truncated from a 1000 B payload
+static uint32_t orig_record_len(uint32_t i)
+{
+  return 4 + (i % 2 ? 1000 : i % 256);
+}
+
+// Writes records whose payload length and content are derived from the record index
+static int write_records(pcap_writer& writer, uint32_t nof_if)
+{
+  uint8_t hdr[4] = {0xde, 0xad, 0xbe, 0xef};
+  uint8_t payload[256];
+  for (uint32_t i = 0; i < nof_records; i++) {
+    uint32_t len = i % sizeof(payload);
+    memset(payload, (int)i, len);
+    struct timeval ts       = {(time_t)i, (suseconds_t)(i * 7 % 1000000)};
+    uint32_t       orig_len = (i % 2) ? 1000 : 0;
+    TESTASSERT(writer.write(i % nof_if, ts, hdr, sizeof(hdr), payload, len, orig_len) == SRSRAN_SUCCESS);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_pcap_format()
+{
+  srslog::basic_logger& logger   = srslog::fetch_basic_logger("PCAP");
+  std::string           filename = "/tmp/pcap_writer_test.pcap";
+
+  pcap_writer writer(logger);
+  TESTASSERT(writer.open(filename, UDP_DLT) == SRSRAN_SUCCESS);
+  TESTASSERT(write_records(writer, 1) == SRSRAN_SUCCESS);
+  writer.close();
+
+  std::vector<uint8_t> data = read_file(filename);
+  TESTASSERT(data.size() > sizeof(pcap_hdr_t));
+  TESTASSERT(read_u32(data, 0) == 0xa1b2c3d4);
+  TESTASSERT(read_u32(data, 20) == UDP_DLT);
+
+  size_t   offset = sizeof(pcap_hdr_t);
+  uint32_t count  = 0;
+  while (offset < data.size()) {
+    uint32_t incl_len = read_u32(data, offset + 8);
+    TESTASSERT(read_u32(data, offset) == count);
+    TESTASSERT(incl_len == 4 + count % 256);
+    TESTASSERT(read_u32(data, offset + 12) == orig_record_len(count));
+    TESTASSERT(data[offset + sizeof(pcaprec_hdr_t)] == 0xde);
+    if (incl_len > 4) {
+      TESTASSERT(data[offset + sizeof(pcaprec_hdr_t) + incl_len - 1] == (uint8_t)count);
+    }
+    offset += sizeof(pcaprec_hdr_t) + incl_len;
+    count++;
+  }
+  TESTASSERT(offset == data.size());
+  TESTASSERT(count == nof_records);
+
+  remove(filename.c_str());
+  return SRSRAN_SUCCESS;
+}
+
+int test_pcapng_format()
+{
+  srslog::basic_logger& logger   = srslog::fetch_basic_logger("PCAP");
+  std::string           filename = "/tmp/pcap_writer_test.pcapng";
+  const uint32_t        nof_if   = 3;
+
+  pcap_writer::args_t args = {};
+  args.format              = pcap_writer::format_t::pcapng;
+  pcap_writer writer(logger);
+  TESTASSERT(writer.open(filename, UDP_DLT, args) == SRSRAN_SUCCESS);
+  TESTASSERT(write_records(writer, nof_if) == SRSRAN_SUCCESS);
+  writer.close();
+
+  std::vector<uint8_t> data = read_file(filename);
+  size_t               offset = 0;
+  uint32_t             count  = 0;
+  uint32_t             nof_shb = 0, nof_idb = 0;
+  while (offset < data.size()) {
+    uint32_t type      = read_u32(data, offset);
+    uint32_t block_len = read_u32(data, offset + 4);
+    TESTASSERT(block_len % 4 == 0 && block_len >= 12);
+    TESTASSERT(offset + block_len <= data.size());
+    TESTASSERT(read_u32(data, offset + block_len - 4) == block_len);
+    switch (type) {
+      case 0x0A0D0D0A:
+        TESTASSERT(read_u32(data, offset + 8) == 0x1A2B3C4D);
+        nof_shb++;
+        break;
+      case 0x00000001:
+        TESTASSERT((read_u32(data, offset + 8) & 0xffff) == UDP_DLT);
+        nof_idb++;
+        break;
+      case 0x00000006: {
+        // Interfaces are described in order of first use
+        TESTASSERT(read_u32(data, offset + 8) == count % nof_if);
+        TESTASSERT(read_u32(data, offset + 8) < nof_idb);
+        uint64_t ts_us = ((uint64_t)read_u32(data, offset + 12) << 32U) | read_u32(data, offset + 16);
+        TESTASSERT(ts_us == (uint64_t)count * 1000000 + count * 7 % 1000000);
+        TESTASSERT(read_u32(data, offset + 20) == 4 + count % 256);
+        TESTASSERT(read_u32(data, offset + 24) == orig_record_len(count));
+        count++;
+        break;
+      }
+      default:
+        TESTASSERT(false);
+    }
+    offset += block_len;
+  }
+  TESTASSERT(offset == data.size());
+  TESTASSERT(nof_shb == 1);
+  TESTASSERT(nof_idb == nof_if);
+  TESTASSERT(count == nof_records);
+
+  remove(filename.c_str());
+  return SRSRAN_SUCCESS;
+}
+
+int test_rotation()
+{
+  srslog::basic_logger& logger   = srslog::fetch_basic_logger("PCAP");
+  std::string           filename = "/tmp/pcap_writer_test_rotate.pcap";
+  const uint32_t        max_size = 16 * 1024;
+
+  pcap_writer::args_t args = {};
+  args.max_file_size       = max_size;
+  args.max_files           = 3;
+  pcap_writer writer(logger);
+  TESTASSERT(writer.open(filename, UDP_DLT, args) == SRSRAN_SUCCESS);
+  TESTASSERT(write_records(writer, 1) == SRSRAN_SUCCESS);
+  writer.close();
+
+  // Only the last three files are kept, every one of them starts with a file header
+  uint32_t last_ts = 0;
+  for (uint32_t i = args.max_files; i > 0; i--) {
+    std::string          name = (i == 1) ? filename : filename + "." + std::to_string(i - 1);
+    std::vector<uint8_t> data = read_file(name);
+    TESTASSERT(data.size() > sizeof(pcap_hdr_t) && data.size() <= max_size);
+    TESTASSERT(read_u32(data, 0) == 0xa1b2c3d4);
+
+    // The files are contiguous in time
+    uint32_t first_ts = read_u32(data, sizeof(pcap_hdr_t));
+    TESTASSERT(i == args.max_files || first_ts == last_ts + 1);
+    size_t offset = sizeof(pcap_hdr_t);
+    while (offset < data.size()) {
+      last_ts = read_u32(data, offset);
+      offset += sizeof(pcaprec_hdr_t) + read_u32(data, offset + 8);
+    }
+    TESTASSERT(offset == data.size());
+    remove(name.c_str());
+  }
+  TESTASSERT(last_ts == nof_records - 1);
+  TESTASSERT(read_file(filename + "." + std::to_string(args.max_files)).empty());
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  TESTASSERT(test_pcap_format() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pcapng_format() == SRSRAN_SUCCESS);
+  TESTASSERT(test_rotation() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
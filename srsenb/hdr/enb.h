@@ -77,6 +77,7 @@ struct enb_files_t {
   std::string sib_config;
   std::string rr_config;
   std::string rb_config;
+  std::string cfg_snapshot; ///< Snapshot of the parsed cell and SIB configuration, empty disables it
 };
 
 struct log_args_t {
@@ -160,6 +161,8 @@ public:
 
   void toggle_padding() override;
 
+  void cmd_pcap_filter(const srsran::pcap_filter_cfg_t& cfg) override;
+
   void tti_clock() override;
 
 private:
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSENB_ENB_CFG_SNAPSHOT_H
+#define SRSENB_ENB_CFG_SNAPSHOT_H
+
+#include "srsenb/hdr/stack/rrc/rrc_config.h"
+#include "srsran/phy/common/phy_common.h"
+#include <stdint.h>
+#include <string>
+
+namespace srsenb {
+
+struct all_args_t;
+
+/**
+ * @brief Binary snapshot of the cell and SIB configuration parsed from rr.conf and sib.conf.
+ *
+ * The snapshot is keyed by a hash of everything these parsers read (the configuration files and the few arguments
+ * they depend on), so it is only reused while that input is unchanged. SIBs are stored PER-packed, i.e. exactly as
+ * they are broadcast. The file carries a format version and a hash of its content, and it is only meant to be read
+ * back by the same build on the same host.
+ */
+namespace cfg_snapshot {
+
+/// Returns the key of the snapshot of the given configuration, 0 if any of the configuration files can't be read
+uint64_t get_key(const all_args_t& args);
+
+/// Loads the cell and SIB configuration, fails if the snapshot is missing, corrupt, or of another version or key
+int load(const std::string& filename, uint64_t key, srsran_cell_t* cell, rrc_cfg_t* rrc_cfg);
+
+/// Saves the cell and SIB configuration, through a temporary file so that a partially written snapshot is never loaded
+int save(const std::string& filename, uint64_t key, const srsran_cell_t& cell, const rrc_cfg_t& rrc_cfg);
+
+} // namespace cfg_snapshot
+
+} // namespace srsenb
+
+#endif // SRSENB_ENB_CFG_SNAPSHOT_H
@@ -28,6 +28,8 @@
 #include <iostream>
 #include <libconfig.h++>
 #include <list>
+#include <map>
+#include <memory>
 #include <sstream>
 #include <stdarg.h>
 #include <stdint.h>
@@ -241,6 +243,17 @@ public:
     std::list<field_itf*> fields;
   };
 
+  /// While an instance is alive, each configuration file is read and parsed by libconfig only once, and all the
+  /// parsers of that file walk the same tree. Not thread-safe, configuration files are parsed at startup.
+  class file_cache_scope
+  {
+  public:
+    file_cache_scope();
+    ~file_cache_scope();
+    file_cache_scope(const file_cache_scope&) = delete;
+    file_cache_scope& operator=(const file_cache_scope&) = delete;
+  };
+
   parser(std::string filename);
   int  parse();
   void add_section(section* s);
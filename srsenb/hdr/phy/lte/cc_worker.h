@@ -95,6 +95,18 @@ private:
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
 
+  // PUCCH of all the UEs in the subframe, kept between TTIs to avoid reallocations
+  std::vector<uint16_t>           pucch_rnti;
+  std::vector<srsran_pucch_cfg_t> pucch_cfg;
+  std::vector<srsran_pucch_res_t> pucch_res;
+  std::vector<int>                pucch_ret;
+
+  // PDSCH of all the UEs in the subframe, encoded together
+  srsran_dl_cfg_t     pdsch_dl_cfg[stack_interface_phy_lte::MAX_GRANTS]                    = {};
+  srsran_pdsch_cfg_t* pdsch_cfg[stack_interface_phy_lte::MAX_GRANTS]                       = {};
+  uint8_t*            pdsch_data[stack_interface_phy_lte::MAX_GRANTS][SRSRAN_MAX_CODEWORDS] = {};
+  uint32_t            pdsch_grant_idx[stack_interface_phy_lte::MAX_GRANTS]                 = {};
+
   // Class to store user information
   class ue
   {
@@ -107,7 +119,7 @@ private:
     srsran_phich_grant_t phich_grant = {};
 
     void     metrics_read(phy_metrics_t* metrics);
-    void     metrics_dl(uint32_t mcs);
+    void     metrics_dl(uint32_t mcs, const srsran_pdsch_enc_time_t& enc_time);
     void     metrics_ul(uint32_t mcs, float rssi, float sinr, float turbo_iters);
     void     metrics_ul_pucch(float rssi, float ni, float sinr);
     uint32_t get_rnti() const { return rnti; }
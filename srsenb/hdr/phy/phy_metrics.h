@@ -43,7 +43,10 @@ struct ul_metrics_t {
 };
 
 struct dl_metrics_t {
-  float mcs;
+  float   mcs;
+  float   coding_us;     ///< Time spent in channel coding, the subframe time is shared by the UEs by coded bits
+  float   modulation_us; ///< Time spent in scrambling and modulation
+  float   mapping_us;    ///< Time spent in layer mapping, precoding and resource mapping
   int64_t pucch_tpc;
   int     n_samples;
 };
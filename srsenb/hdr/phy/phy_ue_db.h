@@ -25,7 +25,9 @@
 #include "phy_interfaces.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
+#include "srsran/adt/rcu_ptr.h"
 #include <map>
+#include <memory>
 #include <mutex>
 #include <srsran/adt/circular_array.h>
 
@@ -81,37 +83,55 @@ private:
   } cell_state_t;
 
   /**
-   * Cell information for the UE database
+   * UE state written by the PHY workers while processing a TTI. The pending ACKs of a DL TTI are set by the worker
+   * processing it and consumed by the worker processing the UL TTI that carries the UCI, the same applies to the UL
+   * grants and TBs. This hand-off is protected by a per-UE mutex, so only the workers serving the same UE contend. The
+   * state is shared by all the configuration versions of a UE.
    */
-  struct cell_info_t {
-    cell_state_t state      = cell_state_none; ///< Configuration state
-    uint32_t     enb_cc_idx = 0;               ///< Corresponding eNb cell/carrier index
-    uint8_t      last_ri    = 0;               ///< Last reported rank indicator
+  struct cell_tti_state_t {
+    std::atomic<uint8_t> last_ri{0}; ///< Last reported rank indicator
     srsran::circular_array<srsran_ra_tb_t, SRSRAN_MAX_HARQ_PROC> last_tb =
         {}; ///< Stores last PUSCH Resource allocation
-    bool                                    stash_use_tbs_index_alt = false;
-    srsran::phy_cfg_t                       phy_cfg;            ///< Configuration, it has a default constructor
-    srsran::circular_array<bool, TTIMOD_SZ> is_grant_available; ///< Indicates whether there is an available grant
+    srsran::circular_array<bool, TTIMOD_SZ> is_grant_available = {}; ///< Indicates whether there is an available grant
+  };
+
+  struct ue_tti_state_t {
+    std::mutex                                            mutex;          ///< Protects everything but the last RI
+    srsran::circular_array<srsran_pdsch_ack_t, TTIMOD_SZ> pdsch_ack = {}; ///< Pending acknowledgements for this UE
+    std::array<cell_tti_state_t, SRSRAN_MAX_CARRIERS>     cell      = {}; ///< Cell state, indexed by ue_cell_idx
   };
 
   /**
-   * UE object stored in the PHY common database
+   * Cell information for the UE database
+   */
+  struct cell_info_t {
+    cell_state_t      state                   = cell_state_none; ///< Configuration state
+    uint32_t          enb_cc_idx              = 0;               ///< Corresponding eNb cell/carrier index
+    bool              stash_use_tbs_index_alt = false;
+    srsran::phy_cfg_t phy_cfg; ///< Configuration, it has a default constructor
+  };
+
+  /**
+   * UE object stored in the PHY common database. It is never modified once published, the stack replaces it with a
+   * modified copy instead.
    */
   struct common_ue {
-    bool                                                  stashed_multiple_csi_request_enabled = false;
-    srsran::circular_array<srsran_pdsch_ack_t, TTIMOD_SZ> pdsch_ack = {}; ///< Pending acknowledgements for this Cell
-    std::array<cell_info_t, SRSRAN_MAX_CARRIERS>          cell_info = {}; ///< Cell information, indexed by ue_cell_idx
+    bool                                         stashed_multiple_csi_request_enabled = false;
+    std::array<cell_info_t, SRSRAN_MAX_CARRIERS> cell_info = {}; ///< Cell information, indexed by ue_cell_idx
+    std::shared_ptr<ue_tti_state_t>              tti_state;      ///< Per-TTI state, shared by all the versions
   };
 
   /**
-   * UE database indexed by RNTI
+   * UE database indexed by RNTI. The PHY workers read it without locks, the stack publishes a new version every time a
+   * UE is added, removed or reconfigured (see srsran::rcu_ptr).
    */
-  std::map<uint16_t, common_ue> ue_db;
+  using ue_db_t = std::map<uint16_t, std::shared_ptr<const common_ue>>;
+  srsran::rcu_ptr<ue_db_t> ue_db{std::unique_ptr<ue_db_t>(new ue_db_t)};
 
   /**
-   * Concurrency protection mutex, allowed modifications from const methods.
+   * Serializes the stack calls that modify the UE database
    */
-  mutable std::mutex mutex;
+  std::mutex cfg_mutex;
 
   /**
    * Stack interface
@@ -129,20 +149,25 @@ private:
   const phy_cell_cfg_list_t* cell_cfg_list = nullptr;
 
   /**
-   * Internal RNTI addition, it is not thread safe protected
+   * Configuration used for non-user RNTIs
+   */
+  srsran::phy_cfg_t default_cfg;
+
+  /**
+   * Creates a new UE with the default configuration, it is not thread safe protected
    *
    * @param rnti identifier of the UE
-   * @return SRSRAN_SUCCESS if the RNTI is not duplicated and is added successfully, SRSRAN_ERROR code if it exists
+   * @return the new UE
    */
-  inline int _add_rnti(uint16_t rnti);
+  inline std::shared_ptr<common_ue> _create_ue(uint16_t rnti) const;
 
   /**
-   * Internal pending ACK clear for a given RNTI and TTI, it is not thread safe protected
+   * Internal pending ACK clear for a given TTI and UE, it takes the UE state mutex
    *
    * @param tti is the given TTI (requires assertion prior to call)
-   * @param rnti identifier of the UE (requires assertion prior to call)
+   * @param ue the UE to clear
    */
-  inline void _clear_tti_pending_rnti(uint32_t tti, uint16_t rnti);
+  static inline void _clear_tti_pending_rnti(uint32_t tti, const common_ue& ue);
 
   /**
    * Helper method to set the constant attributes of a given RNTI after the configuration is set, it does not modify
@@ -154,14 +179,14 @@ private:
   inline void _set_common_config_rnti(uint16_t rnti, srsran::phy_cfg_t& phy_cfg) const;
 
   /**
-   * Gets the SCell index for a given RNTI and a eNb cell/carrier. It returns the SCell index (0 if PCell) if the cc_idx
+   * Gets the SCell index for a given UE and a eNb cell/carrier. It returns the SCell index (0 if PCell) if the cc_idx
    * is found among the configured cells/carriers. Otherwise, it returns SRSRAN_MAX_CARRIERS.
    *
-   * @param rnti identifier of the UE (requires assertion prior to call)
-   * @param enb_cc_idx the eNb cell/carrier index to look for in the RNTI.
+   * @param ue the UE
+   * @param enb_cc_idx the eNb cell/carrier index to look for in the UE.
    * @return the SCell index as described above.
    */
-  inline uint32_t _get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline uint32_t _get_ue_cc_idx(const common_ue& ue, uint32_t enb_cc_idx);
 
   /**
    * Gets the eNb Cell/Carrier index in which the UCI shall be carried. This corresponds to the serving cell with lowest
@@ -170,49 +195,50 @@ private:
    * If no grant is available in the indicated TTI, it returns the number of the eNb Cells/Carriers.
    *
    * @param tti The UL processing TTI
-   * @param rnti Temporal UE ID
+   * @param ue the UE
    * @return the eNb Cell/Carrier with lowest serving cell index that has an UL grant
    */
-  uint32_t _get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti) const;
+  uint32_t _get_uci_enb_cc_idx(uint32_t tti, const common_ue& ue) const;
 
   /**
-   * Checks if a given RNTI exists in the database
+   * Looks up a given RNTI in a version of the database
+   * @param db the database version
    * @param rnti provides UE identifier
-   * @return SRSRAN_SUCCESS if the indicated RNTI exists, otherwise it returns SRSRAN_ERROR
+   * @return the UE if the indicated RNTI exists, otherwise nullptr
    */
-  inline int _assert_rnti(uint16_t rnti) const;
+  static inline const common_ue* _find_ue(const ue_db_t& db, uint16_t rnti);
 
   /**
-   * Checks if an RNTI is configured to use an specified eNb cell/carrier as PCell or SCell
-   * @param rnti provides UE identifier
+   * Checks if an UE is configured to use an specified eNb cell/carrier as PCell or SCell
+   * @param ue the UE, it can be nullptr
    * @param enb_cc_idx provides eNb cell/carrier
-   * @return SRSRAN_SUCCESS if the indicated RNTI exists, otherwise it returns SRSRAN_ERROR
+   * @return SRSRAN_SUCCESS if the UE exists and uses the cell, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_enb_cc(const common_ue* ue, uint32_t enb_cc_idx);
 
   /**
-   * Checks if an RNTI uses a given eNb cell/carrier as PCell
-   * @param rnti provides UE identifier
+   * Checks if an UE uses a given eNb cell/carrier as PCell
+   * @param ue the UE, it can be nullptr
    * @param enb_cc_idx provides eNb cell/carrier index
-   * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier of the RNTI is a PCell, otherwise it returns SRSRAN_ERROR
+   * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier of the UE is a PCell, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_enb_pcell(const common_ue* ue, uint32_t enb_cc_idx);
 
   /**
-   * Checks if an RNTI is configured to use an specified UE cell/carrier as PCell or SCell
-   * @param rnti provides UE identifier
+   * Checks if an UE is configured to use an specified UE cell/carrier as PCell or SCell
+   * @param ue the UE, it can be nullptr
    * @param ue_cc_idx UE cell/carrier index that is asserted
    * @return SRSRAN_SUCCESS if the indicated cell/carrier index is valid, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const;
+  static inline int _assert_ue_cc(const common_ue* ue, uint32_t ue_cc_idx);
 
   /**
-   * Checks if an RNTI is configured to use an specified eNb cell/carrier as PCell or SCell and it is active
-   * @param rnti provides UE identifier
+   * Checks if an UE is configured to use an specified eNb cell/carrier as PCell or SCell and it is active
+   * @param ue the UE, it can be nullptr
    * @param enb_cc_idx UE cell/carrier index that is asserted
    * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier is active, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_active_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_active_enb_cc(const common_ue* ue, uint32_t enb_cc_idx);
 
   /**
    * Internal eNb stack assertion
@@ -227,22 +253,41 @@ private:
   inline int _assert_cell_list_cfg() const;
 
   /**
-   * Internal eNb general configuration getter, returns default configuration if the UE does not exist in the given cell
+   * Internal eNb general configuration getter, returns the default configuration for non-user RNTIs. The RNTI fields of
+   * the default configuration are not set.
    *
+   * @param db the database version
    * @param rnti provides UE identifier
    * @param enb_cc_idx eNb cell index
-   * @param[out] phy_cfg The PHY configuration of the indicated UE for the indicated eNb carrier/call index.
-   * @return SRSRAN_SUCCESS if provided context is correct, SRSRAN_ERROR code otherwise
+   * @return the PHY configuration of the indicated UE for the indicated eNb carrier/call index, nullptr if the UE does
+   * not exist or it does not use the cell
    */
-  inline int _get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg) const;
+  inline const srsran::phy_cfg_t* _get_rnti_config(const ue_db_t& db, uint16_t rnti, uint32_t enb_cc_idx) const;
 
   /**
    * Count number of configured secondary serving cells
    *
-   * @param rnti provides UE identifier
+   * @param ue the UE
    * @return The number of configured secondary cells
    */
-  inline uint32_t _count_nof_configured_scell(uint16_t rnti);
+  static inline uint32_t _count_nof_configured_scell(const common_ue& ue);
+
+  /**
+   * Copies the current version of a UE for modifying it, it must be called with cfg_mutex locked
+   *
+   * @param rnti provides UE identifier
+   * @return a copy of the UE, nullptr if it does not exist
+   */
+  std::shared_ptr<common_ue> _copy_ue(uint16_t rnti) const;
+
+  /**
+   * Publishes a new version of the database in which the given RNTI is replaced, added (if it does not exist) or removed
+   * (if ue is nullptr). It must be called with cfg_mutex locked and it returns once no worker uses the previous version.
+   *
+   * @param rnti provides UE identifier
+   * @param ue the new version of the UE
+   */
+  void _publish_ue(uint16_t rnti, std::shared_ptr<const common_ue> ue);
 
 public:
   /**
@@ -22,6 +22,8 @@
 #ifndef SRSRAN_ENB_STACK_BASE_H
 #define SRSRAN_ENB_STACK_BASE_H
 
+#include "srsran/common/pcap_filter.h"
+#include "srsran/common/pcap_writer.h"
 #include "srsran/interfaces/enb_interfaces.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_s1ap_interfaces.h"
@@ -33,8 +35,22 @@ namespace srsenb {
 typedef struct {
   bool        enable;
   std::string filename;
+  std::string format;               ///< "pcap" or "pcapng", only used by the MAC captures
+  uint32_t    max_file_size_mb = 0; ///< Size after which the capture file is rotated, 0 disables rotation
+  uint32_t    max_files        = 4; ///< Number of rotated files kept
 } pcap_args_t;
 
+/// Converts the capture options to the arguments of the batched PCAP writer
+inline srsran::pcap_writer::args_t make_pcap_writer_args(const pcap_args_t& args)
+{
+  srsran::pcap_writer::args_t writer_args = {};
+  writer_args.format        = args.format == "pcapng" ? srsran::pcap_writer::format_t::pcapng
+                                                      : srsran::pcap_writer::format_t::pcap;
+  writer_args.max_file_size = (uint64_t)args.max_file_size_mb * 1024 * 1024;
+  writer_args.max_files     = args.max_files;
+  return writer_args;
+}
+
 typedef struct {
   bool        enable;
   std::string client_ip;
@@ -92,6 +108,7 @@ public:
   virtual void stop() = 0;
 
   virtual void toggle_padding() = 0;
+  virtual void cmd_pcap_filter(const srsran::pcap_filter_cfg_t& cfg) = 0;
   // eNB metrics interface
   virtual bool get_metrics(stack_metrics_t* metrics) = 0;
 
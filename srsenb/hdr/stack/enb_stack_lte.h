@@ -115,6 +115,7 @@ public:
     mac.set_sched_dl_tti_mask(tti_mask, nof_sfs);
   }
   void toggle_padding() override { mac.toggle_padding(); }
+  void cmd_pcap_filter(const srsran::pcap_filter_cfg_t& cfg) override;
   void tti_clock() override;
 
   // rrc_eutra_interface_rrc_nr
@@ -189,6 +189,7 @@ private:
   std::unique_ptr<freq_res_common_list>    cell_res_list;
   std::map<uint16_t, unique_rnti_ptr<ue> > users; // NOTE: has to have fixed addr
   std::unique_ptr<paging_manager>          pending_paging;
+  asn1::arena                              rx_arena; // storage of the containers of received messages
 
   void     process_release_complete(uint16_t rnti);
   void     rem_user(uint16_t rnti);
@@ -23,6 +23,7 @@
 #define SRSRAN_RRC_CELL_CFG_H
 
 #include "rrc_config.h"
+#include "ue_rr_cfg.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/srslog/srslog.h"
 
@@ -37,6 +38,7 @@ struct enb_cell_common {
   const cell_cfg_t&                         cell_cfg;
   std::vector<srsran::unique_byte_buffer_t> sib_buffer; ///< Packed SIBs for given CC
   std::vector<const enb_cell_common*>       scells;
+  rrc_conn_setup_template                   conn_setup_tmpl; ///< Packed RRCConnectionSetup, built by the first UE
 
   enb_cell_common(uint32_t idx_, const cell_cfg_t& cfg) : enb_cc_idx(idx_), cell_cfg(cfg) {}
 };
@@ -32,7 +32,9 @@ namespace srsenb {
 /**
  * Class that handles the buffering of paging records and encoding of PCCH messages.
  * It's thread-safe, and, assuming that threads contend for pending PCCH messages using different subframe indexes,
- * should rarely blocking on mutexes
+ * should rarely blocking on mutexes.
+ * The PCCH messages are encoded incrementally: each new paging record is packed at the end of the already encoded PCCH
+ * of its paging occasion, and only the number of records in the PCCH header is rewritten.
  */
 class paging_manager
 {
@@ -50,6 +52,7 @@ public:
         pcch.pcch_msg.msg.set_c1().paging().paging_record_list_present = true;
       }
     }
+    init_pcch_hdr();
   }
 
   /// add new IMSI paging record
@@ -78,6 +81,7 @@ private:
     tti_point                    tti_tx_dl;
     asn1::rrc::pcch_msg_s        pcch_msg;
     srsran::unique_byte_buffer_t pdu;
+    uint32_t                     nof_bits = 0; ///< Encoded length of the PCCH in pdu, before the octet padding
 
     bool is_tx() const { return tti_tx_dl.is_valid(); }
     bool empty() const { return pdu == nullptr; }
@@ -86,10 +90,15 @@ private:
       tti_tx_dl = tti_point();
       pcch_msg.msg.c1().paging().paging_record_list.clear();
       pdu.reset();
+      nof_bits = 0;
     }
   };
   const static size_t nof_paging_subframes = 4;
+  /// The number of paging records is encoded as a SIZE(1..maxPageRec) length, at the end of the PCCH header
+  const static uint32_t nof_record_count_bits = 4;
+  static_assert(ASN1_RRC_MAX_PAGE_REC == 1U << nof_record_count_bits, "Invalid number of paging record count bits");
 
+  void init_pcch_hdr();
   bool add_paging_record(uint32_t ueid, const asn1::rrc::paging_record_s& paging_record);
 
   static int get_sf_idx_key(uint32_t sf_idx)
@@ -116,6 +125,10 @@ private:
   uint32_t              Ns;
   srslog::basic_logger& logger;
 
+  // Encoded PCCH message up to its first paging record
+  std::array<uint8_t, 8> pcch_hdr      = {};
+  uint32_t               pcch_hdr_bits = 0;
+
   struct subframe_info {
     mutable std::mutex        mutex;
     srsran::deque<pcch_info*> transmitted_pcch;
@@ -125,6 +138,28 @@ private:
   std::array<subframe_info, nof_paging_subframes> sf_pending_pcch;
 };
 
+void paging_manager::init_pcch_hdr()
+{
+  // The header is what precedes the paging record in the encoding of a PCCH message with a single paging record
+  asn1::rrc::pcch_msg_s      pcch;
+  asn1::rrc::paging_record_s paging_record;
+  paging_record.ue_id.set_s_tmsi();
+  paging_record.cn_domain = asn1::rrc::paging_record_s::cn_domain_e_::ps;
+  pcch.msg.set_c1().paging().paging_record_list_present = true;
+  pcch.msg.c1().paging().paging_record_list.push_back(paging_record);
+
+  std::array<uint8_t, 16> pcch_buf   = {};
+  std::array<uint8_t, 16> record_buf = {};
+  asn1::bit_ref           pcch_bref(pcch_buf.data(), pcch_buf.size());
+  asn1::bit_ref           record_bref(record_buf.data(), record_buf.size());
+  if (pcch.msg.pack(pcch_bref) != asn1::SRSASN_SUCCESS or paging_record.pack(record_bref) != asn1::SRSASN_SUCCESS) {
+    logger.error("Failed to pack PCCH message header");
+    return;
+  }
+  pcch_hdr_bits = pcch_bref.distance() - record_bref.distance();
+  std::copy(pcch_buf.begin(), pcch_buf.begin() + (pcch_hdr_bits + 7) / 8, pcch_hdr.begin());
+}
+
 bool paging_manager::add_imsi_paging(uint32_t ueid, srsran::const_byte_span imsi)
 {
   asn1::rrc::paging_record_s paging_elem;
@@ -184,17 +219,33 @@ bool paging_manager::add_paging_record(uint32_t ueid, const asn1::rrc::paging_re
       logger.warning("Failed to add new paging record for ueid=%d. Cause: No buffers available", ueid);
       return false;
     }
+    std::copy(pcch_hdr.begin(), pcch_hdr.begin() + (pcch_hdr_bits + 7) / 8, pending_pcch.pdu->msg);
+    pending_pcch.nof_bits = pcch_hdr_bits;
   }
 
-  record_list.push_back(paging_record);
-
+  // Append the paging record to the encoded PCCH. The bits that follow it, up to the octet boundary, are zeroed
   asn1::bit_ref bref(pending_pcch.pdu->msg, pending_pcch.pdu->get_tailroom());
-  if (pending_pcch.pcch_msg.pack(bref) == asn1::SRSASN_ERROR_ENCODE_FAIL) {
+  if (pcch_hdr_bits == 0 or bref.advance_bits(pending_pcch.nof_bits) != asn1::SRSASN_SUCCESS or
+      paging_record.pack(bref) != asn1::SRSASN_SUCCESS) {
     logger.error("Failed to pack PCCH message");
     pending_pcch.clear();
     return false;
   }
-  pending_pcch.pdu->N_bytes = (uint32_t)bref.distance_bytes();
+  record_list.push_back(paging_record);
+  pending_pcch.nof_bits = (uint32_t)bref.distance();
+
+  // Update the number of paging records in the header
+  uint32_t count_bits = record_list.size() - 1;
+  for (uint32_t i = 0; i < nof_record_count_bits; ++i) {
+    uint32_t bit  = pcch_hdr_bits - nof_record_count_bits + i;
+    uint8_t  mask = 0x80U >> (bit % 8);
+    if ((count_bits >> (nof_record_count_bits - 1 - i)) & 1U) {
+      pending_pcch.pdu->msg[bit / 8] |= mask;
+    } else {
+      pending_pcch.pdu->msg[bit / 8] &= ~mask;
+    }
+  }
+  pending_pcch.pdu->N_bytes = (pending_pcch.nof_bits + 7) / 8;
 
   return true;
 }
@@ -152,7 +152,9 @@ public:
    * Sends the CCCH message to the underlying layer and optionally encodes it as an octet string if a valid string
    * pointer is passed.
    */
-  void send_dl_ccch(asn1::rrc::dl_ccch_msg_s* dl_ccch_msg, std::string* octet_str = nullptr);
+  void send_dl_ccch(asn1::rrc::dl_ccch_msg_s*      dl_ccch_msg,
+                    std::string*                   octet_str = nullptr,
+                    const rrc_conn_setup_template* tmpl      = nullptr);
 
   /**
    * Sends the DCCH message to the underlying layer and optionally encodes it as an octet string if a valid string
@@ -44,7 +44,9 @@
 #define SRSENB_UE_RR_CFG_H
 
 #include "srsran/asn1/rrc.h"
+#include "srsran/common/byte_buffer.h"
 #include "srsran/interfaces/rrc_interface_types.h"
+#include <array>
 
 namespace srsenb {
 
@@ -75,6 +77,41 @@ void apply_rr_cfg_ded_diff(asn1::rrc::rr_cfg_ded_s&       current_rr_cfg_ded,
 void apply_scells_to_add_diff(asn1::rrc::scell_to_add_mod_list_r10_l&   current_scells,
                               const asn1::rrc::rrc_conn_recfg_r8_ies_s& recfg_r8);
 
+/**
+ * Pre-packed DL-CCCH RRCConnectionSetup, shared by the UEs of a cell.
+ *
+ * The radioResourceConfigDedicated of the RRCConnectionSetup only depends on the eNB config, except for the SR and
+ * periodic CQI PUCCH resources of the UE. These fields and the transaction ID are constrained integers, whose UPER
+ * encoding has a fixed width, so the packed RRCConnectionSetup of every UE of the cell is the same bit string with
+ * these fields overwritten. The position of each field is found once, by packing the message with the field set to
+ * its lower and upper bounds and comparing both results.
+ */
+class rrc_conn_setup_template
+{
+public:
+  /// Builds the template from the RRCConnectionSetup of any UE of the cell
+  int  init(const asn1::rrc::dl_ccch_msg_s& msg);
+  bool is_init() const { return len > 0; }
+
+  /// Packs a RRCConnectionSetup that only differs from the template in the UE specific fields
+  int pack(const asn1::rrc::dl_ccch_msg_s& msg, srsran::byte_buffer_t& pdu) const;
+
+  enum field_id { transaction_id, sr_cfg_idx, sr_pucch_res_idx, cqi_pmi_cfg_idx, cqi_pucch_res_idx, nof_fields };
+
+private:
+  static const uint32_t max_len = 256;
+
+  struct field_t {
+    bool     present    = false;
+    uint32_t bit_offset = 0;
+    uint32_t nof_bits   = 0;
+  };
+
+  uint32_t                        len = 0;
+  std::array<uint8_t, max_len>    buffer;
+  std::array<field_t, nof_fields> fields;
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_UE_RR_CFG_H
@@ -152,6 +152,9 @@ private:
   // PCAP
   srsran::s1ap_pcap* pcap = nullptr;
 
+  // Storage of the containers of received PDUs
+  asn1::arena rx_arena;
+
   asn1::s1ap::s1_setup_resp_s s1setupresponse;
 
   void build_tai_cgi();
@@ -160,6 +163,7 @@ private:
   bool sctp_send_s1ap_pdu(const asn1::s1ap::s1ap_pdu_c& tx_pdu, uint32_t rnti, const char* procedure_name);
 
   bool handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu);
+  bool discard_unknown_ue_pdu(const asn1::ap_pdu_index& index, srsran::const_span<uint8_t> sdu);
   bool handle_initiatingmessage(const asn1::s1ap::init_msg_s& msg);
   bool handle_successfuloutcome(const asn1::s1ap::successful_outcome_s& msg);
   bool handle_unsuccessfuloutcome(const asn1::s1ap::unsuccessful_outcome_s& msg);
@@ -27,10 +27,51 @@
 #include "srsran/build_info.h"
 #include "srsran/common/enb_events.h"
 #include "srsran/radio/radio_null.h"
+#include <chrono>
 #include <iostream>
 
 namespace srsenb {
 
+namespace {
+
+/// Measures the duration of the consecutive eNB startup phases, to report where the startup time goes
+class startup_timer
+{
+  using clock_type = std::chrono::steady_clock;
+
+public:
+  startup_timer() : tstart(clock_type::now()), tphase(tstart) {}
+
+  /// Ends the current phase, which started when the previous one ended
+  void end_phase(const char* name)
+  {
+    clock_type::time_point now = clock_type::now();
+    phases.emplace_back(name, to_ms(now - tphase));
+    tphase = now;
+  }
+
+  std::string to_string() const
+  {
+    std::string str;
+    char        tmp[64];
+    for (const auto& phase : phases) {
+      snprintf(tmp, sizeof(tmp), "%s %.1f ms, ", phase.first, phase.second);
+      str += tmp;
+    }
+    snprintf(tmp, sizeof(tmp), "total %.1f ms", to_ms(tphase - tstart));
+    return str + tmp;
+  }
+
+private:
+  static double to_ms(clock_type::duration d) { return std::chrono::duration<double, std::milli>(d).count(); }
+
+  clock_type::time_point                          tstart;
+  clock_type::time_point                          tphase;
+  std::vector<std::pair<const char*, double> > phases;
+};
+
+} // namespace
+
 enb::enb(srslog::sink& log_sink) :
   started(false), log_sink(log_sink), enb_log(srslog::fetch_basic_logger("ENB", log_sink, false)), sys_proc(enb_log)
 {
@@ -46,7 +87,8 @@ enb::~enb()
 
 int enb::init(const all_args_t& args_)
 {
-  int ret = SRSRAN_SUCCESS;
+  int           ret = SRSRAN_SUCCESS;
+  startup_timer startup_time;
 
   // Init eNB log
   enb_log.set_level(srslog::basic_levels::info);
@@ -57,6 +99,7 @@ int enb::init(const all_args_t& args_)
     srsran::console("Error processing arguments.\n");
     return SRSRAN_ERROR;
   }
+  startup_time.end_phase("configuration");
 
   srsran::byte_buffer_pool::get_instance()->enable_logger(true);
 
@@ -105,6 +148,7 @@ int enb::init(const all_args_t& args_)
       srsran::console("Error initializing EUTRA stack.\n");
       ret = SRSRAN_ERROR;
     }
+    startup_time.end_phase("EUTRA stack");
   }
 
   if (tmp_nr_stack) {
@@ -112,6 +156,7 @@ int enb::init(const all_args_t& args_)
       srsran::console("Error initializing NR stack.\n");
       ret = SRSRAN_ERROR;
     }
+    startup_time.end_phase("NR stack");
   }
 
   // Init Radio
@@ -119,6 +164,7 @@ int enb::init(const all_args_t& args_)
     srsran::console("Error initializing radio.\n");
     return SRSRAN_ERROR;
   }
+  startup_time.end_phase("radio");
 
   // Only Init PHY if radio could be initialized
   if (ret == SRSRAN_SUCCESS) {
@@ -126,6 +172,7 @@ int enb::init(const all_args_t& args_)
       srsran::console("Error initializing PHY.\n");
       ret = SRSRAN_ERROR;
     }
+    startup_time.end_phase("PHY");
   }
 
   if (tmp_eutra_stack) {
@@ -146,6 +193,9 @@ int enb::init(const all_args_t& args_)
   }
 
   if (ret == SRSRAN_SUCCESS) {
+    std::string startup_time_str = startup_time.to_string();
+    enb_log.info("Startup times: %s", startup_time_str.c_str());
+    srsran::console("\nStartup times: %s\n", startup_time_str.c_str());
     srsran::console("\n==== eNodeB started ===\n");
     srsran::console("Type <t> to view trace\n");
   } else {
@@ -282,6 +332,19 @@ void enb::toggle_padding()
   }
 }
 
+void enb::cmd_pcap_filter(const srsran::pcap_filter_cfg_t& cfg)
+{
+  if (!started) {
+    return;
+  }
+  if (eutra_stack) {
+    eutra_stack->cmd_pcap_filter(cfg);
+  }
+  if (nr_stack) {
+    nr_stack->cmd_pcap_filter(cfg);
+  }
+}
+
 void enb::tti_clock()
 {
   if (!started) {
@@ -21,6 +21,7 @@
 
 #include "enb_cfg_parser.h"
 #include "srsenb/hdr/enb.h"
+#include "srsenb/hdr/enb_cfg_snapshot.h"
 #include "srsgnb/hdr/stack/rrc/rrc_nr_config_utils.h"
 #include "srsran/asn1/rrc_utils.h"
 #include "srsran/common/band_helper.h"
@@ -1738,33 +1739,55 @@ int parse_cfr_args(all_args_t* args, srsran_cfr_cfg_t* cfr_config)
 
 int parse_cfg_files(all_args_t* args_, rrc_cfg_t* rrc_cfg_, rrc_nr_cfg_t* rrc_nr_cfg_, phy_cfg_t* phy_cfg_)
 {
-  // Parse config files
-  srsran_cell_t cell_common_cfg = {};
-
-  try {
-    if (enb_conf_sections::parse_cell_cfg(args_, &cell_common_cfg) != SRSRAN_SUCCESS) {
+  // Parse config files. Each of them is read only once, even though the SIBs and cells are parsed separately
+  parser::file_cache_scope file_cache;
+  srsran_cell_t            cell_common_cfg = {};
+
+  // The cell and SIB configuration of the last start is reused as long as its inputs are unchanged
+  uint64_t snapshot_key  = 0;
+  bool     from_snapshot = false;
+  if (not args_->enb_files.cfg_snapshot.empty()) {
+    snapshot_key  = cfg_snapshot::get_key(*args_);
+    from_snapshot = snapshot_key != 0 and cfg_snapshot::load(args_->enb_files.cfg_snapshot,
+                                                             snapshot_key,
+                                                             &cell_common_cfg,
+                                                             rrc_cfg_) == SRSRAN_SUCCESS;
+  }
+
+  if (from_snapshot) {
+    sib_sections::copy_phy_cfg_common(*rrc_cfg_, phy_cfg_);
+    fprintf(stdout, "Loaded cell and SIB configuration from %s\n", args_->enb_files.cfg_snapshot.c_str());
+  } else {
+    try {
+      if (enb_conf_sections::parse_cell_cfg(args_, &cell_common_cfg) != SRSRAN_SUCCESS) {
+        fprintf(stderr, "Error parsing Cell configuration\n");
+        return SRSRAN_ERROR;
+      }
+    } catch (const SettingTypeException& stex) {
+      fprintf(stderr, "Error parsing Cell configuration: %s\n", stex.getPath());
+      return SRSRAN_ERROR;
+    } catch (const ConfigException& cex) {
       fprintf(stderr, "Error parsing Cell configuration\n");
       return SRSRAN_ERROR;
     }
-  } catch (const SettingTypeException& stex) {
-    fprintf(stderr, "Error parsing Cell configuration: %s\n", stex.getPath());
-    return SRSRAN_ERROR;
-  } catch (const ConfigException& cex) {
-    fprintf(stderr, "Error parsing Cell configuration\n");
-    return SRSRAN_ERROR;
-  }
 
-  try {
-    if (sib_sections::parse_sibs(args_, rrc_cfg_, phy_cfg_) != SRSRAN_SUCCESS) {
-      fprintf(stderr, "Error parsing SIB configuration\n");
+    try {
+      if (sib_sections::parse_sibs(args_, rrc_cfg_, phy_cfg_) != SRSRAN_SUCCESS) {
+        fprintf(stderr, "Error parsing SIB configuration\n");
+        return SRSRAN_ERROR;
+      }
+    } catch (const SettingTypeException& stex) {
+      fprintf(stderr, "Error parsing SIB configuration: %s\n", stex.getPath());
+      return SRSRAN_ERROR;
+    } catch (const ConfigException& cex) {
+      fprintf(stderr, "Error parsing SIB configurationn\n");
       return SRSRAN_ERROR;
     }
-  } catch (const SettingTypeException& stex) {
-    fprintf(stderr, "Error parsing SIB configuration: %s\n", stex.getPath());
-    return SRSRAN_ERROR;
-  } catch (const ConfigException& cex) {
-    fprintf(stderr, "Error parsing SIB configurationn\n");
-    return SRSRAN_ERROR;
+
+    if (snapshot_key != 0 and
+        cfg_snapshot::save(args_->enb_files.cfg_snapshot, snapshot_key, cell_common_cfg, *rrc_cfg_) != SRSRAN_SUCCESS) {
+      fprintf(stderr, "Warning: could not save configuration snapshot to %s\n", args_->enb_files.cfg_snapshot.c_str());
+    }
   }
 
   try {
@@ -2100,9 +2123,10 @@ int set_derived_args(all_args_t* args_, rrc_cfg_t* rrc_cfg_, phy_cfg_t* phy_cfg_
   rrc_cfg_->max_mac_ul_kos       = args_->general.max_mac_ul_kos;
   rrc_cfg_->rlf_release_timer_ms = args_->general.rlf_release_timer_ms;
 
-  // Set sync queue capacity to 1 for ZMQ
-  if (args_->rf.device_name == "zmq") {
-    srslog::fetch_basic_logger("ENB").info("Using sync queue size of one for ZMQ based radio.");
+  // Set sync queue capacity to 1 for ZMQ and shared-memory radios
+  if (args_->rf.device_name == "zmq" || args_->rf.device_name == "shm") {
+    srslog::fetch_basic_logger("ENB").info("Using sync queue size of one for %s based radio.",
+                                           args_->rf.device_name.c_str());
     args_->stack.sync_queue_size = 1;
   } else {
     // use default size
@@ -2178,8 +2202,11 @@ int set_derived_args_nr(all_args_t* args_, rrc_nr_cfg_t* rrc_nr_cfg_, phy_cfg_t*
   }
 
   // MAC-NR PCAP options
-  args_->nr_stack.mac.pcap.enable = args_->stack.mac_pcap.enable;
-  args_->nr_stack.log             = args_->stack.log;
+  args_->nr_stack.mac.pcap.enable           = args_->stack.mac_pcap.enable;
+  args_->nr_stack.mac.pcap.format           = args_->stack.mac_pcap.format;
+  args_->nr_stack.mac.pcap.max_file_size_mb = args_->stack.mac_pcap.max_file_size_mb;
+  args_->nr_stack.mac.pcap.max_files        = args_->stack.mac_pcap.max_files;
+  args_->nr_stack.log                       = args_->stack.log;
 
   // Sanity check for unsupported/untested configuration
   for (auto& cfg : rrc_nr_cfg_->cell_list) {
@@ -2732,16 +2759,22 @@ int parse_sibs(all_args_t* args_, rrc_cfg_t* rrc_cfg_, srsenb::phy_cfg_t* phy_co
     }
   }
 
-  // Copy PHY common configuration
-  phy_config_common->prach_cnfg  = sib2->rr_cfg_common.prach_cfg;
-  phy_config_common->pdsch_cnfg  = sib2->rr_cfg_common.pdsch_cfg_common;
-  phy_config_common->pusch_cnfg  = sib2->rr_cfg_common.pusch_cfg_common;
-  phy_config_common->pucch_cnfg  = sib2->rr_cfg_common.pucch_cfg_common;
-  phy_config_common->srs_ul_cnfg = sib2->rr_cfg_common.srs_ul_cfg_common;
+  copy_phy_cfg_common(*rrc_cfg_, phy_config_common);
 
   return 0;
 }
 
+void copy_phy_cfg_common(const rrc_cfg_t& rrc_cfg, srsenb::phy_cfg_t* phy_config_common)
+{
+  const sib_type2_s& sib2 = rrc_cfg.sibs[1].sib2();
+
+  phy_config_common->prach_cnfg  = sib2.rr_cfg_common.prach_cfg;
+  phy_config_common->pdsch_cnfg  = sib2.rr_cfg_common.pdsch_cfg_common;
+  phy_config_common->pusch_cnfg  = sib2.rr_cfg_common.pusch_cfg_common;
+  phy_config_common->pucch_cnfg  = sib2.rr_cfg_common.pucch_cfg_common;
+  phy_config_common->srs_ul_cnfg = sib2.rr_cfg_common.srs_ul_cfg_common;
+}
+
 } // namespace sib_sections
 
 namespace rb_sections {
@@ -69,6 +69,8 @@ int parse_sib7(std::string filename, asn1::rrc::sib_type7_s* data);
 int parse_sib9(std::string filename, asn1::rrc::sib_type9_s* data);
 int parse_sib13(std::string filename, asn1::rrc::sib_type13_r9_s* data);
 int parse_sibs(all_args_t* args_, rrc_cfg_t* rrc_cfg_, srsenb::phy_cfg_t* phy_config_common);
+/// Copies the common PHY configuration broadcast in SIB2
+void copy_phy_cfg_common(const rrc_cfg_t& rrc_cfg, srsenb::phy_cfg_t* phy_config_common);
 
 } // namespace sib_sections
 
@@ -0,0 +1,278 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/enb_cfg_snapshot.h"
+#include "srsenb/hdr/enb.h"
+#include "srsran/version.h"
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+namespace srsenb {
+namespace cfg_snapshot {
+
+namespace {
+
+/// Must be increased whenever the content or the layout of the snapshot changes
+const uint32_t snapshot_version = 1;
+const char     snapshot_magic[8] = {'S', 'R', 'S', 'E', 'N', 'B', 'C', 'F'};
+/// Enough for any SIB, they are broadcast in transport blocks of at most 2216 bytes
+const uint32_t max_sib_len = 4096;
+
+struct snapshot_header_t {
+  char     magic[8];
+  uint32_t version;
+  uint32_t payload_len;
+  uint64_t key;
+  uint64_t payload_hash;
+};
+
+/// 64-bit FNV-1a, enough to tell apart configurations and to detect corrupted snapshots
+class hasher
+{
+public:
+  void add(const void* data, size_t len)
+  {
+    const uint8_t* ptr = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < len; i++) {
+      hash = (hash ^ ptr[i]) * 1099511628211ULL;
+    }
+  }
+  template <typename T>
+  void add_value(const T& value)
+  {
+    add(&value, sizeof(value));
+  }
+  uint64_t get() const { return hash; }
+
+private:
+  uint64_t hash = 14695981039346656037ULL;
+};
+
+bool read_file(const std::string& filename, std::string& content)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (not file.is_open()) {
+    return false;
+  }
+  std::ostringstream ss;
+  ss << file.rdbuf();
+  content = ss.str();
+  return true;
+}
+
+class payload_writer
+{
+public:
+  void put(const void* data, size_t len)
+  {
+    const uint8_t* ptr = static_cast<const uint8_t*>(data);
+    buffer.insert(buffer.end(), ptr, ptr + len);
+  }
+  void put_u32(uint32_t value) { put(&value, sizeof(value)); }
+
+  /// Writes the PER-packed message preceded by its length, nothing if it can't be packed
+  template <typename Msg>
+  bool put_asn1(const Msg& msg)
+  {
+    uint8_t       tmp[max_sib_len];
+    asn1::bit_ref bref(tmp, sizeof(tmp));
+    if (msg.pack(bref) != asn1::SRSASN_SUCCESS) {
+      return false;
+    }
+    put_u32((uint32_t)bref.distance_bytes());
+    put(tmp, bref.distance_bytes());
+    return true;
+  }
+
+  std::vector<uint8_t> buffer;
+};
+
+class payload_reader
+{
+public:
+  payload_reader(const uint8_t* data_, size_t len_) : data(data_), len(len_) {}
+
+  bool get(void* dst, size_t n)
+  {
+    if (n > len - pos) {
+      return false;
+    }
+    memcpy(dst, data + pos, n);
+    pos += n;
+    return true;
+  }
+  bool get_u32(uint32_t& value) { return get(&value, sizeof(value)); }
+
+  /// Unpacks a message written by payload_writer::put_asn1(), a zero length leaves the message untouched
+  template <typename Msg>
+  bool get_asn1(Msg& msg)
+  {
+    uint32_t msg_len = 0;
+    if (not get_u32(msg_len) or msg_len > len - pos) {
+      return false;
+    }
+    if (msg_len > 0) {
+      asn1::cbit_ref bref(data + pos, msg_len);
+      if (msg.unpack(bref) != asn1::SRSASN_SUCCESS) {
+        return false;
+      }
+    }
+    pos += msg_len;
+    return true;
+  }
+
+  bool at_end() const { return pos == len; }
+
+private:
+  const uint8_t* data;
+  size_t         len;
+  size_t         pos = 0;
+};
+
+} // namespace
+
+uint64_t get_key(const all_args_t& args)
+{
+  hasher h;
+  h.add(SRSRAN_VERSION_STRING, strlen(SRSRAN_VERSION_STRING));
+  h.add_value(snapshot_version);
+  h.add_value((uint32_t)sizeof(srsran_cell_t));
+
+  // Arguments read by parse_cell_cfg() and parse_sibs(), to be kept in sync with them
+  h.add_value(args.enb.n_prb);
+  h.add_value(args.enb.nof_ports);
+  h.add_value((uint8_t)args.phy.extended_cp);
+  h.add_value(args.stack.s1ap.mcc);
+  h.add_value(args.stack.s1ap.mnc);
+  h.add_value((uint8_t)args.stack.embms.enable);
+
+  for (const std::string* filename : {&args.enb_files.rr_config, &args.enb_files.sib_config}) {
+    std::string content;
+    if (not read_file(*filename, content)) {
+      return 0;
+    }
+    h.add_value((uint64_t)content.size());
+    h.add(content.data(), content.size());
+  }
+
+  // 0 is reserved for unreadable configurations
+  return h.get() != 0 ? h.get() : 1;
+}
+
+int load(const std::string& filename, uint64_t key, srsran_cell_t* cell, rrc_cfg_t* rrc_cfg)
+{
+  std::string content;
+  if (not read_file(filename, content) or content.size() < sizeof(snapshot_header_t)) {
+    return SRSRAN_ERROR;
+  }
+
+  snapshot_header_t hdr = {};
+  memcpy(&hdr, content.data(), sizeof(hdr));
+  if (memcmp(hdr.magic, snapshot_magic, sizeof(snapshot_magic)) != 0 or hdr.version != snapshot_version or
+      hdr.key != key or hdr.payload_len != content.size() - sizeof(hdr)) {
+    return SRSRAN_ERROR;
+  }
+  const uint8_t* payload = reinterpret_cast<const uint8_t*>(content.data()) + sizeof(hdr);
+  hasher         h;
+  h.add(payload, hdr.payload_len);
+  if (h.get() != hdr.payload_hash) {
+    return SRSRAN_ERROR;
+  }
+
+  // Decode into temporaries, so that the configuration is left untouched if the snapshot is unusable
+  payload_reader                                           reader(payload, hdr.payload_len);
+  srsran_cell_t                                            tmp_cell = {};
+  asn1::rrc::sib_type1_s                                   sib1;
+  std::array<asn1::rrc::sib_info_item_c, ASN1_RRC_MAX_SIB> sibs;
+  uint32_t                                                 cell_len = 0;
+  uint32_t                                                 nof_sibs = 0;
+  if (not reader.get_u32(cell_len) or cell_len != sizeof(tmp_cell) or not reader.get(&tmp_cell, sizeof(tmp_cell)) or
+      not reader.get_asn1(sib1) or not reader.get_u32(nof_sibs) or nof_sibs != sibs.size()) {
+    return SRSRAN_ERROR;
+  }
+  for (asn1::rrc::sib_info_item_c& sib : sibs) {
+    uint32_t type = 0;
+    if (not reader.get_u32(type) or type > asn1::rrc::sib_info_item_c::types::nulltype) {
+      return SRSRAN_ERROR;
+    }
+    sib.set((asn1::rrc::sib_info_item_c::types::options)type);
+    if (not reader.get_asn1(sib)) {
+      return SRSRAN_ERROR;
+    }
+  }
+  if (not reader.at_end()) {
+    return SRSRAN_ERROR;
+  }
+
+  *cell         = tmp_cell;
+  rrc_cfg->sib1 = sib1;
+  std::copy(sibs.begin(), sibs.end(), rrc_cfg->sibs);
+  return SRSRAN_SUCCESS;
+}
+
+int save(const std::string& filename, uint64_t key, const srsran_cell_t& cell, const rrc_cfg_t& rrc_cfg)
+{
+  payload_writer writer;
+  writer.put_u32(sizeof(cell));
+  writer.put(&cell, sizeof(cell));
+  if (not writer.put_asn1(rrc_cfg.sib1)) {
+    return SRSRAN_ERROR;
+  }
+
+  // SIBs that are not scheduled keep their default content, which can't always be packed. Only their type is stored
+  writer.put_u32(ASN1_RRC_MAX_SIB);
+  for (const asn1::rrc::sib_info_item_c& sib : rrc_cfg.sibs) {
+    writer.put_u32(sib.type().value);
+    if (sib.type().value == asn1::rrc::sib_info_item_c::types::nulltype or not writer.put_asn1(sib)) {
+      writer.put_u32(0);
+    }
+  }
+
+  snapshot_header_t hdr = {};
+  memcpy(hdr.magic, snapshot_magic, sizeof(snapshot_magic));
+  hdr.version     = snapshot_version;
+  hdr.payload_len = (uint32_t)writer.buffer.size();
+  hdr.key         = key;
+  hasher h;
+  h.add(writer.buffer.data(), writer.buffer.size());
+  hdr.payload_hash = h.get();
+
+  std::string tmp_filename = filename + ".tmp";
+  FILE*       f            = fopen(tmp_filename.c_str(), "wb");
+  if (f == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 and
+            fwrite(writer.buffer.data(), writer.buffer.size(), 1, f) == 1;
+  ok      = (fclose(f) == 0) and ok;
+  if (not ok or rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+    remove(tmp_filename.c_str());
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace cfg_snapshot
+} // namespace srsenb
@@ -97,6 +97,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("enb_files.sib_config", bpo::value<string>(&args->enb_files.sib_config)->default_value("sib.conf"), "SIB configuration files")
     ("enb_files.rr_config",  bpo::value<string>(&args->enb_files.rr_config)->default_value("rr.conf"),   "RR configuration files")
     ("enb_files.rb_config", bpo::value<string>(&args->enb_files.rb_config)->default_value("rb.conf"), "SRB/DRB configuration files")
+    ("enb_files.cfg_snapshot", bpo::value<string>(&args->enb_files.cfg_snapshot)->default_value(""), "Binary snapshot of the parsed cell and SIB configuration, reused at startup while rr.conf, sib.conf and their arguments are unchanged (empty disables it)")
 
     ("rf.dl_earfcn",      bpo::value<uint32_t>(&args->enb.dl_earfcn)->default_value(0),   "Force Downlink EARFCN for single cell")
     ("rf.srate",          bpo::value<double>(&args->rf.srate_hz)->default_value(0.0),     "Force Tx and Rx sampling rate in Hz")
@@ -146,6 +147,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("pcap.enable",    bpo::value<bool>(&args->stack.mac_pcap.enable)->default_value(false),         "Enable MAC packet captures for wireshark")
     ("pcap.filename",  bpo::value<string>(&args->stack.mac_pcap.filename)->default_value("/tmp/enb_mac.pcap"), "MAC layer capture filename")
     ("pcap.nr_filename",  bpo::value<string>(&args->nr_stack.mac.pcap.filename)->default_value("/tmp/enb_mac_nr.pcap"), "NR MAC layer capture filename")
+    ("pcap.format",       bpo::value<string>(&args->stack.mac_pcap.format)->default_value("pcap"), "MAC layer capture file format (pcap or pcapng)")
+    ("pcap.max_file_size", bpo::value<uint32_t>(&args->stack.mac_pcap.max_file_size_mb)->default_value(0), "Size in MB after which MAC capture files are rotated, 0 disables rotation")
+    ("pcap.max_files",    bpo::value<uint32_t>(&args->stack.mac_pcap.max_files)->default_value(4), "Number of MAC capture files kept when rotating")
     ("pcap.s1ap_enable",   bpo::value<bool>(&args->stack.s1ap_pcap.enable)->default_value(false),         "Enable S1AP packet captures for wireshark")
     ("pcap.s1ap_filename", bpo::value<string>(&args->stack.s1ap_pcap.filename)->default_value("/tmp/enb_s1ap.pcap"), "S1AP layer capture filename")
     ("pcap.ngap_enable",   bpo::value<bool>(&args->nr_stack.ngap_pcap.enable)->default_value(false),         "Enable NGAP packet captures for wireshark")
@@ -192,6 +196,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),               "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.nof_threads",       bpo::value<uint32_t>(&args->phy.dl_channel_args.nof_threads)->default_value(1),          "Number of threads applying the channel to the antennas in parallel")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),          "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),         "Target SNR in dB")
     ("channel.dl.fading.enable",     bpo::value<bool>(&args->phy.dl_channel_args.fading_enable)->default_value(false),        "Enable/Disable Fading model")
@@ -211,6 +216,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.nof_threads",       bpo::value<uint32_t>(&args->phy.ul_channel_args.nof_threads)->default_value(1),             "Number of threads applying the channel to the antennas in parallel")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Received signal power in decibels full scale (dBfs)")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
@@ -303,6 +309,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
+    ("scheduler.nr_parallel_cc", bpo::value<bool>(&args->nr_stack.mac.sched_cfg.parallel_cc)->default_value(false), "Schedule each NR carrier in a dedicated thread.")
+    ("scheduler.nr_lookahead", bpo::value<uint32_t>(&args->nr_stack.mac.sched_cfg.lookahead_slots)->default_value(0), "Number of slots the NR DL scheduling runs ahead of the PHY.")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
   ;
 
@@ -550,6 +558,16 @@ static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface*
 
     // Set cell gain
     control->cmd_cell_gain(cell_id, gain_db);
+  } else if (cmd[0] == "pcap_filter") {
+    srsran::pcap_filter_cfg_t cfg;
+    if (cmd.size() < 2 or not srsran::parse_pcap_filter(vector<string>(cmd.begin() + 1, cmd.end()), cfg)) {
+      cout << "Usage: " << cmd[0] << " [off | rnti=<rnti,...> lcid=<lcid,...> sample=<N> snaplen=<bytes>]" << endl;
+      return;
+    }
+
+    // Set capture filter of all PCAPs
+    control->cmd_pcap_filter(cfg);
+    cout << "PCAP filter: " << srsran::to_string(cfg) << endl;
   } else if (cmd[0] == "flush") {
     if (cmd.size() != 1) {
       cout << "Usage: " << cmd[0] << endl;
@@ -566,6 +584,7 @@ static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface*
     cout << "      sleep: pauses the commmand line operation for a given time in seconds" << endl;
     cout << "          p: starts MAC padding" << endl;
     cout << "      flush: flushes the buffers for the log file" << endl;
+    cout << "pcap_filter: sets the PCAP capture filter (RNTIs, LCIDs, 1-in-N sampling, truncation)" << endl;
     cout << endl;
   }
 }
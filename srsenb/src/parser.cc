@@ -26,6 +26,40 @@ namespace srsenb {
 
 using namespace libconfig;
 
+namespace {
+
+// Configuration files parsed while a file_cache_scope is alive
+std::map<std::string, std::unique_ptr<Config> > file_cache;
+uint32_t                                        nof_file_cache_scopes = 0;
+
+int read_file(const std::string& filename, Config& cfg)
+{
+  try {
+    cfg.readFile(filename.c_str());
+  } catch (const FileIOException& fioex) {
+    std::cerr << "I/O error while reading file: " << filename << std::endl;
+    return (-1);
+  } catch (const ParseException& pex) {
+    std::cerr << "Parse error at " << pex.getFile() << ":" << pex.getLine() << " - " << pex.getError() << std::endl;
+    return (-1);
+  }
+  return 0;
+}
+
+} // namespace
+
+parser::file_cache_scope::file_cache_scope()
+{
+  nof_file_cache_scopes++;
+}
+
+parser::file_cache_scope::~file_cache_scope()
+{
+  if (--nof_file_cache_scopes == 0) {
+    file_cache.clear();
+  }
+}
+
 int parser::parse_section(std::string filename, parser::section* s)
 {
   parser p(filename);
@@ -45,21 +79,25 @@ void parser::add_section(parser::section* s)
 
 int parser::parse()
 {
-  // open file
-  Config cfg;
-
-  try {
-    cfg.readFile(filename.c_str());
-  } catch (const FileIOException& fioex) {
-    std::cerr << "I/O error while reading file: " << filename << std::endl;
-    return (-1);
-  } catch (const ParseException& pex) {
-    std::cerr << "Parse error at " << pex.getFile() << ":" << pex.getLine() << " - " << pex.getError() << std::endl;
+  // open file, or reuse it if it was already parsed
+  Config  local_cfg;
+  Config* cfg = &local_cfg;
+  if (nof_file_cache_scopes > 0) {
+    auto it = file_cache.find(filename);
+    if (it == file_cache.end()) {
+      std::unique_ptr<Config> new_cfg(new Config);
+      if (read_file(filename, *new_cfg) != 0) {
+        return (-1);
+      }
+      it = file_cache.emplace(filename, std::move(new_cfg)).first;
+    }
+    cfg = it->second.get();
+  } else if (read_file(filename, local_cfg) != 0) {
     return (-1);
   }
 
   for (auto s : sections) {
-    if (s->parse(cfg.getRoot())) {
+    if (s->parse(cfg->getRoot())) {
       return -1;
     }
   }
@@ -415,7 +415,8 @@ void cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants,
 
 int cc_worker::decode_pucch()
 {
-  srsran_pucch_res_t pucch_res = {};
+  pucch_rnti.clear();
+  pucch_cfg.clear();
 
   for (auto& iter : ue_db) {
     uint16_t rnti = iter.first;
@@ -438,37 +439,53 @@ int cc_worker::decode_pucch()
 
       // If ret is more than success, UCI is present
       if (ret > SRSRAN_SUCCESS) {
-        // Decode PUCCH
-        if (srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &ul_cfg.pucch, &pucch_res)) {
-          Error("Error getting PUCCH");
-          continue;
-        }
+        pucch_rnti.push_back(rnti);
+        pucch_cfg.push_back(ul_cfg.pucch);
+      }
+    }
+  }
 
-        // Send UCI data to MAC
-        if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pucch.uci_cfg, pucch_res.uci_data) < SRSRAN_SUCCESS) {
-          Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
-          continue;
-        }
+  // Decode the PUCCH of all the users at once, so that the ones sharing PRBs are received jointly
+  pucch_res.assign(pucch_cfg.size(), srsran_pucch_res_t{});
+  pucch_ret.assign(pucch_cfg.size(), SRSRAN_SUCCESS);
+  if (srsran_enb_ul_get_pucch_multi(
+          &enb_ul, &ul_sf, pucch_cfg.data(), pucch_res.data(), pucch_ret.data(), (uint32_t)pucch_cfg.size())) {
+    Error("Error getting PUCCH");
+    return SRSRAN_ERROR;
+  }
 
-        if (pucch_res.detected and pucch_res.ta_valid) {
-          phy->stack->ta_info(tti_rx, rnti, pucch_res.ta_us);
-          phy->stack->snr_info(tti_rx, rnti, cc_idx, pucch_res.snr_db, mac_interface_phy_lte::PUCCH);
-        }
+  for (uint32_t i = 0; i < pucch_cfg.size(); i++) {
+    uint16_t            rnti = pucch_rnti[i];
+    srsran_pucch_cfg_t& cfg  = pucch_cfg[i];
+    srsran_pucch_res_t& res  = pucch_res[i];
 
-        // Logging
-        if (logger.info.enabled()) {
-          char str[512];
-          srsran_pucch_rx_info(&ul_cfg.pucch, &pucch_res, str, sizeof(str));
-          logger.info("PUCCH: cc=%d; %s", cc_idx, str);
-        }
+    if (pucch_ret[i] < SRSRAN_SUCCESS) {
+      Error("Error getting PUCCH");
+      continue;
+    }
 
-        // Save metrics
-        if (pucch_res.detected) {
-          ue_db[rnti]->metrics_ul_pucch(pucch_res.rssi_dbFs - phy->params.rx_gain_offset,
-                                        pucch_res.ni_dbFs - -phy->params.rx_gain_offset,
-                                        pucch_res.snr_db);
-        }
-      }
+    // Send UCI data to MAC
+    if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, cfg.uci_cfg, res.uci_data) < SRSRAN_SUCCESS) {
+      Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
+      continue;
+    }
+
+    if (res.detected and res.ta_valid) {
+      phy->stack->ta_info(tti_rx, rnti, res.ta_us);
+      phy->stack->snr_info(tti_rx, rnti, cc_idx, res.snr_db, mac_interface_phy_lte::PUCCH);
+    }
+
+    // Logging
+    if (logger.info.enabled()) {
+      char str[512];
+      srsran_pucch_rx_info(&cfg, &res, str, sizeof(str));
+      logger.info("PUCCH: cc=%d; %s", cc_idx, str);
+    }
+
+    // Save metrics
+    if (res.detected) {
+      ue_db[rnti]->metrics_ul_pucch(
+          res.rssi_dbFs - phy->params.rx_gain_offset, res.ni_dbFs - -phy->params.rx_gain_offset, res.snr_db);
     }
   }
   return 0;
@@ -588,7 +605,7 @@ int cc_worker::encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srs
 
   // Save metrics stats
   if (ue_db.count(SRSRAN_MRNTI)) {
-    ue_db[SRSRAN_MRNTI]->metrics_dl(mbsfn_cfg->mbsfn_mcs);
+    ue_db[SRSRAN_MRNTI]->metrics_dl(mbsfn_cfg->mbsfn_mcs, {});
   }
   return SRSRAN_SUCCESS;
 }
@@ -597,11 +614,13 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
 {
   /* Scales the Resources Elements affected by the power allocation (p_b) */
   // srsran_enb_dl_prepare_power_allocation(&enb_dl);
-  for (uint32_t i = 0; i < nof_grants; i++) {
+  uint32_t nof_pdsch = 0;
+  for (uint32_t i = 0; i < nof_grants && i < stack_interface_phy_lte::MAX_GRANTS; i++) {
     uint16_t rnti = grants[i].dci.rnti;
 
     if (rnti && ue_db.count(rnti)) {
-      srsran_dl_cfg_t dl_cfg = {};
+      srsran_dl_cfg_t& dl_cfg = pdsch_dl_cfg[nof_pdsch];
+      dl_cfg                  = {};
 
       if (phy->ue_db.get_dl_config(rnti, cc_idx, dl_cfg) < SRSRAN_SUCCESS) {
         Error("Error retrieving DCI DL configuration for RNTI %x, CC %d", grants[i].dci.rnti, cc_idx);
@@ -615,35 +634,67 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
         continue;
       }
 
-      // Set soft buffer
+      // Set soft buffer and data
       for (uint32_t j = 0; j < SRSRAN_MAX_CODEWORDS; j++) {
         dl_cfg.pdsch.softbuffers.tx[j] = grants[i].softbuffer_tx[j];
+        pdsch_data[nof_pdsch][j]       = grants[i].data[j];
       }
+      pdsch_cfg[nof_pdsch]       = &dl_cfg.pdsch;
+      pdsch_grant_idx[nof_pdsch] = i;
+      nof_pdsch++;
+    } else {
+      Error("User rnti=0x%x not found in cc_worker=%d", rnti, cc_idx);
+    }
+  }
 
-      // Encode PDSCH
-      if (srsran_enb_dl_put_pdsch(&enb_dl, &dl_cfg.pdsch, grants[i].data)) {
-        Error("Error putting PDSCH %d", i);
-        return SRSRAN_ERROR;
-      }
+  if (nof_pdsch == 0) {
+    return SRSRAN_SUCCESS;
+  }
 
-      // Save pending ACK
-      if (SRSRAN_RNTI_ISUSER(rnti)) {
-        // Push whole DCI
-        phy->ue_db.set_ack_pending(tti_tx_ul, cc_idx, grants[i].dci);
-      }
+  // Encode the PDSCH of all the UEs at once
+  srsran_pdsch_enc_time_t enc_time = {};
+  if (srsran_enb_dl_put_pdsch_batch(&enb_dl, pdsch_cfg, pdsch_data, nof_pdsch, &enc_time)) {
+    Error("Error putting PDSCH of %d grants", nof_pdsch);
+    return SRSRAN_ERROR;
+  }
 
-      if (LOG_THIS(rnti) and logger.info.enabled()) {
-        // Logging
-        char str[512];
-        srsran_pdsch_tx_info(&dl_cfg.pdsch, str, 512);
-        logger.info("PDSCH: cc=%d, %s, tti_tx_dl=%d", cc_idx, str, tti_tx_dl);
-      }
+  // The encoding time of the subframe is shared by the UEs proportionally to their number of coded bits
+  auto nof_coded_bits = [](const srsran_pdsch_cfg_t* cfg) {
+    uint32_t nof_bits = 0;
+    for (uint32_t j = 0; j < SRSRAN_MAX_CODEWORDS; j++) {
+      nof_bits += cfg->grant.tb[j].enabled ? cfg->grant.tb[j].nof_bits : 0;
+    }
+    return nof_bits;
+  };
+  uint32_t total_bits = 0;
+  for (uint32_t k = 0; k < nof_pdsch; k++) {
+    total_bits += nof_coded_bits(pdsch_cfg[k]);
+  }
 
-      // Save metrics stats
-      ue_db[rnti]->metrics_dl(grants[i].dci.tb[0].mcs_idx);
-    } else {
-      Error("User rnti=0x%x not found in cc_worker=%d", rnti, cc_idx);
+  for (uint32_t k = 0; k < nof_pdsch; k++) {
+    stack_interface_phy_lte::dl_sched_grant_t& grant = grants[pdsch_grant_idx[k]];
+    uint16_t                                   rnti  = grant.dci.rnti;
+
+    // Save pending ACK
+    if (SRSRAN_RNTI_ISUSER(rnti)) {
+      // Push whole DCI
+      phy->ue_db.set_ack_pending(tti_tx_ul, cc_idx, grant.dci);
+    }
+
+    if (LOG_THIS(rnti) and logger.info.enabled()) {
+      // Logging
+      char str[512];
+      srsran_pdsch_tx_info(pdsch_cfg[k], str, 512);
+      logger.info("PDSCH: cc=%d, %s, tti_tx_dl=%d", cc_idx, str, tti_tx_dl);
     }
+
+    // Save metrics stats
+    float                   share   = total_bits ? (float)nof_coded_bits(pdsch_cfg[k]) / (float)total_bits : 0.0f;
+    srsran_pdsch_enc_time_t ue_time = {};
+    ue_time.coding_us               = (uint32_t)(share * enc_time.coding_us);
+    ue_time.modulation_us           = (uint32_t)(share * enc_time.modulation_us);
+    ue_time.mapping_us              = (uint32_t)(share * enc_time.mapping_us);
+    ue_db[rnti]->metrics_dl(grant.dci.tb[0].mcs_idx, ue_time);
   }
 
   // srsran_enb_dl_apply_power_allocation(&enb_dl);
@@ -674,9 +725,12 @@ void cc_worker::ue::metrics_read(phy_metrics_t* metrics_)
   metrics = {};
 }
 
-void cc_worker::ue::metrics_dl(uint32_t mcs)
+void cc_worker::ue::metrics_dl(uint32_t mcs, const srsran_pdsch_enc_time_t& enc_time)
 {
-  metrics.dl.mcs = SRSRAN_VEC_CMA(mcs, metrics.dl.mcs, metrics.dl.n_samples);
+  metrics.dl.mcs           = SRSRAN_VEC_CMA(mcs, metrics.dl.mcs, metrics.dl.n_samples);
+  metrics.dl.coding_us     = SRSRAN_VEC_CMA(enc_time.coding_us, metrics.dl.coding_us, metrics.dl.n_samples);
+  metrics.dl.modulation_us = SRSRAN_VEC_CMA(enc_time.modulation_us, metrics.dl.modulation_us, metrics.dl.n_samples);
+  metrics.dl.mapping_us    = SRSRAN_VEC_CMA(enc_time.mapping_us, metrics.dl.mapping_us, metrics.dl.n_samples);
   metrics.dl.n_samples++;
 }
 
@@ -703,6 +757,12 @@ void cc_worker::ue::metrics_ul_pucch(float rssi, float ni, float sinr)
   metrics.ul.n_samples_pucch++;
 }
 
+void cc_worker::start_plot()
+{
+  // The plots read the PUSCH channel estimates of the first symbol
+  srsran_chest_ul_set_pusch_ce_dmrs_only(&enb_ul.chest, false);
+}
+
 int cc_worker::read_ce_abs(float* ce_abs)
 {
   int sz = srsran_symbol_sz(phy->get_nof_prb(cc_idx));
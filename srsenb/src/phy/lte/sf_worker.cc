@@ -278,6 +278,10 @@ uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
       phy_metrics_t* m  = &metrics[r];
       phy_metrics_t* m_ = &metrics_[r];
       m->dl.mcs         = SRSRAN_VEC_SAFE_PMA(m->dl.mcs, m->dl.n_samples, m_->dl.mcs, m_->dl.n_samples);
+      m->dl.coding_us   = SRSRAN_VEC_SAFE_PMA(m->dl.coding_us, m->dl.n_samples, m_->dl.coding_us, m_->dl.n_samples);
+      m->dl.modulation_us =
+          SRSRAN_VEC_SAFE_PMA(m->dl.modulation_us, m->dl.n_samples, m_->dl.modulation_us, m_->dl.n_samples);
+      m->dl.mapping_us = SRSRAN_VEC_SAFE_PMA(m->dl.mapping_us, m->dl.n_samples, m_->dl.mapping_us, m_->dl.n_samples);
       m->dl.n_samples += m_->dl.n_samples;
       m->ul.n          = SRSRAN_VEC_SAFE_PMA(m->ul.n, m->ul.n_samples, m_->ul.n, m_->ul.n_samples);
       m->ul.pusch_sinr = SRSRAN_VEC_SAFE_PMA(m->ul.pusch_sinr, m->ul.n_samples, m_->ul.pusch_sinr, m_->ul.n_samples);
@@ -303,6 +307,9 @@ void sf_worker::start_plot()
   if (plot_worker_id == -1) {
     plot_worker_id = get_id();
     srsran::console("Starting plot for worker_id=%d\n", plot_worker_id);
+    for (auto& w : cc_workers) {
+      w->start_plot();
+    }
     init_plots(this);
   } else {
     srsran::console("Trying to start a plot but already started by worker_id=%d\n", plot_worker_id);
@@ -256,6 +256,9 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
     for (uint32_t j = 0; j < metrics_tmp.size(); j++) {
       metrics[j].dl.n_samples += metrics_tmp[j].dl.n_samples;
       metrics[j].dl.mcs += metrics_tmp[j].dl.n_samples * metrics_tmp[j].dl.mcs;
+      metrics[j].dl.coding_us += metrics_tmp[j].dl.n_samples * metrics_tmp[j].dl.coding_us;
+      metrics[j].dl.modulation_us += metrics_tmp[j].dl.n_samples * metrics_tmp[j].dl.modulation_us;
+      metrics[j].dl.mapping_us += metrics_tmp[j].dl.n_samples * metrics_tmp[j].dl.mapping_us;
 
       metrics[j].ul.n_samples += metrics_tmp[j].ul.n_samples;
       metrics[j].ul.n_samples_pucch += metrics_tmp[j].ul.n_samples_pucch;
@@ -272,6 +275,9 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
   for (uint32_t j = 0; j < metrics.size(); j++) {
     if (metrics[j].dl.n_samples > 0) {
       metrics[j].dl.mcs /= metrics[j].dl.n_samples;
+      metrics[j].dl.coding_us /= metrics[j].dl.n_samples;
+      metrics[j].dl.modulation_us /= metrics[j].dl.n_samples;
+      metrics[j].dl.mapping_us /= metrics[j].dl.n_samples;
     }
     if (metrics[j].ul.n_samples > 0) {
       metrics[j].ul.mcs /= metrics[j].ul.n_samples;
@@ -30,48 +30,37 @@ void phy_ue_db::init(stack_interface_phy_lte*   stack_ptr,
   stack         = stack_ptr;
   phy_args      = &phy_args_;
   cell_cfg_list = &cell_cfg_list_;
+  default_cfg.set_defaults();
 }
 
-inline int phy_ue_db::_add_rnti(uint16_t rnti)
+inline std::shared_ptr<phy_ue_db::common_ue> phy_ue_db::_create_ue(uint16_t rnti) const
 {
   // Private function not mutexed
-
-  // Assert RNTI does NOT exist
-  if (ue_db.count(rnti)) {
-    return SRSRAN_ERROR;
-  }
-
-  // Create new UE by accesing it
-  ue_db[rnti].cell_info[0] = {};
-
-  // Get UE
-  common_ue& ue = ue_db[rnti];
+  std::shared_ptr<common_ue> ue = std::make_shared<common_ue>();
+  ue->tti_state                 = std::make_shared<ue_tti_state_t>();
 
   // Load default values to PCell
-  ue.cell_info[0].phy_cfg.set_defaults();
+  ue->cell_info[0].phy_cfg.set_defaults();
 
   // Set constant configuration fields
-  _set_common_config_rnti(rnti, ue.cell_info[0].phy_cfg);
+  _set_common_config_rnti(rnti, ue->cell_info[0].phy_cfg);
 
   // Configure as PCell
-  ue.cell_info[0].state = cell_state_primary;
+  ue->cell_info[0].state = cell_state_primary;
 
   // Iterate all pending ACK
   for (uint32_t tti = 0; tti < TTIMOD_SZ; tti++) {
-    _clear_tti_pending_rnti(tti, rnti);
+    _clear_tti_pending_rnti(tti, *ue);
   }
 
-  return SRSRAN_SUCCESS;
+  return ue;
 }
 
-inline void phy_ue_db::_clear_tti_pending_rnti(uint32_t tti, uint16_t rnti)
+inline void phy_ue_db::_clear_tti_pending_rnti(uint32_t tti, const common_ue& ue)
 {
-  // Private function not mutexed, no need to assert RNTI or TTI
-
-  // Get UE
-  common_ue& ue = ue_db[rnti];
-
-  srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
+  // Private function, no need to assert TTI
+  std::lock_guard<std::mutex> lock(ue.tti_state->mutex);
+  srsran_pdsch_ack_t&         pdsch_ack = ue.tti_state->pdsch_ack[tti];
 
   // Reset ACK information
   pdsch_ack = {};
@@ -111,10 +100,9 @@ inline void phy_ue_db::_set_common_config_rnti(uint16_t rnti, srsran::phy_cfg_t&
   phy_cfg.ul_cfg.pucch.use_cedron_alg                = phy_args->use_cedron_alg;
 }
 
-inline uint32_t phy_ue_db::_get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) const
+inline uint32_t phy_ue_db::_get_ue_cc_idx(const common_ue& ue, uint32_t enb_cc_idx)
 {
-  uint32_t         ue_cc_idx = 0;
-  const common_ue& ue        = ue_db.at(rnti);
+  uint32_t ue_cc_idx = 0;
 
   for (; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
     const cell_info_t& scell_info = ue.cell_info[ue_cc_idx];
@@ -127,36 +115,38 @@ inline uint32_t phy_ue_db::_get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) co
   return ue_cc_idx;
 }
 
-uint32_t phy_ue_db::_get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti) const
+uint32_t phy_ue_db::_get_uci_enb_cc_idx(uint32_t tti, const common_ue& ue) const
 {
   // Find the lowest index available PUSCH grant
-  for (const cell_info_t& cell_info : ue_db.at(rnti).cell_info) {
-    if (cell_info.is_grant_available[tti]) {
-      return cell_info.enb_cc_idx;
+  std::lock_guard<std::mutex> lock(ue.tti_state->mutex);
+  for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
+    if (ue.tti_state->cell[ue_cc_idx].is_grant_available[tti]) {
+      return ue.cell_info[ue_cc_idx].enb_cc_idx;
     }
   }
 
   return (uint32_t)cell_cfg_list->size();
 }
 
-inline int phy_ue_db::_assert_rnti(uint16_t rnti) const
+inline const phy_ue_db::common_ue* phy_ue_db::_find_ue(const ue_db_t& db, uint16_t rnti)
 {
-  if (not ue_db.count(rnti)) {
-    return SRSRAN_ERROR;
+  auto it = db.find(rnti);
+  if (it == db.end()) {
+    return nullptr;
   }
 
-  return SRSRAN_SUCCESS;
+  return it->second.get();
 }
 
-inline int phy_ue_db::_assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const
+inline int phy_ue_db::_assert_enb_cc(const common_ue* ue, uint32_t enb_cc_idx)
 {
   // Assert RNTI exist
-  if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
+  if (ue == nullptr) {
     return SRSRAN_ERROR;
   }
 
   // Check Component Carrier is part of UE SCell map
-  if (_get_ue_cc_idx(rnti, enb_cc_idx) == SRSRAN_MAX_CARRIERS) {
+  if (_get_ue_cc_idx(*ue, enb_cc_idx) == SRSRAN_MAX_CARRIERS) {
     return SRSRAN_ERROR;
   }
 
@@ -165,17 +155,18 @@ inline int phy_ue_db::_assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const
 
 bool phy_ue_db::ue_has_cell(uint16_t rnti, uint32_t enb_cc_idx) const
 {
-  return _assert_enb_cc(rnti, enb_cc_idx) == SRSRAN_SUCCESS;
+  auto db = ue_db.read();
+  return _assert_enb_cc(_find_ue(*db, rnti), enb_cc_idx) == SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) const
+inline int phy_ue_db::_assert_enb_pcell(const common_ue* ue, uint32_t enb_cc_idx)
 {
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  if (_assert_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Check cell is PCell
-  const cell_info_t& cell_info = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)];
+  const cell_info_t& cell_info = ue->cell_info[_get_ue_cc_idx(*ue, enb_cc_idx)];
   if (cell_info.state != cell_state_primary) {
     return SRSRAN_ERROR;
   }
@@ -183,9 +174,9 @@ inline int phy_ue_db::_assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) cons
   return SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const
+inline int phy_ue_db::_assert_ue_cc(const common_ue* ue, uint32_t ue_cc_idx)
 {
-  if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
+  if (ue == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -194,7 +185,7 @@ inline int phy_ue_db::_assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const
     return SRSRAN_ERROR;
   }
 
-  const cell_info_t& cell_info = ue_db.at(rnti).cell_info.at(ue_cc_idx);
+  const cell_info_t& cell_info = ue->cell_info.at(ue_cc_idx);
   if (cell_info.state == cell_state_none) {
     return SRSRAN_ERROR;
   }
@@ -202,14 +193,14 @@ inline int phy_ue_db::_assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const
   return SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_assert_active_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const
+inline int phy_ue_db::_assert_active_enb_cc(const common_ue* ue, uint32_t enb_cc_idx)
 {
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  if (_assert_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Check SCell is active, ignore PCell state
-  const cell_info_t& cell_info = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)];
+  const cell_info_t& cell_info = ue->cell_info[_get_ue_cc_idx(*ue, enb_cc_idx)];
   if (cell_info.state != cell_state_primary and cell_info.state != cell_state_secondary_active) {
     return SRSRAN_ERROR;
   }
@@ -235,52 +226,81 @@ inline int phy_ue_db::_assert_cell_list_cfg() const
   return SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg) const
+inline const srsran::phy_cfg_t*
+phy_ue_db::_get_rnti_config(const ue_db_t& db, uint16_t rnti, uint32_t enb_cc_idx) const
 {
-  srsran::phy_cfg_t default_cfg = {};
-  default_cfg.set_defaults();
-  default_cfg.dl_cfg.pdsch.rnti = rnti;
-  default_cfg.ul_cfg.pucch.rnti = rnti;
-  default_cfg.ul_cfg.pusch.rnti = rnti;
-
   // Use default configuration for non-user C-RNTI
   if (not SRSRAN_RNTI_ISUSER(rnti)) {
-    phy_cfg = default_cfg;
-    return SRSRAN_SUCCESS;
+    return &default_cfg;
   }
 
   // Make sure the C-RNTI exists and the cell/carrier is configured
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
+  const common_ue* ue = _find_ue(db, rnti);
+  if (_assert_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
+    return nullptr;
   }
 
-  // Write the current configuration
-  uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
-  phy_cfg            = ue_db.at(rnti).cell_info.at(ue_cc_idx).phy_cfg;
-  return SRSRAN_SUCCESS;
+  // Return the current configuration
+  return &ue->cell_info.at(_get_ue_cc_idx(*ue, enb_cc_idx)).phy_cfg;
+}
+
+uint32_t phy_ue_db::_count_nof_configured_scell(const common_ue& ue)
+{
+  uint32_t nof_configured_scell = 0;
+  for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
+    if (ue.cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_inactive ||
+        ue.cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_active) {
+      nof_configured_scell++;
+    }
+  }
+  return nof_configured_scell;
+}
+
+std::shared_ptr<phy_ue_db::common_ue> phy_ue_db::_copy_ue(uint16_t rnti) const
+{
+  const common_ue* ue = _find_ue(*ue_db.get_unsafe(), rnti);
+  if (ue == nullptr) {
+    return nullptr;
+  }
+
+  // The copy shares the per-TTI state with the current version
+  return std::make_shared<common_ue>(*ue);
+}
+
+void phy_ue_db::_publish_ue(uint16_t rnti, std::shared_ptr<const common_ue> ue)
+{
+  // Only the modified UE is copied, the rest of the versions share the UE objects
+  std::unique_ptr<ue_db_t> db(new ue_db_t(*ue_db.get_unsafe()));
+  if (ue == nullptr) {
+    db->erase(rnti);
+  } else {
+    (*db)[rnti] = std::move(ue);
+  }
+  ue_db.publish(std::move(db));
 }
 
 void phy_ue_db::clear_tti_pending_ack(uint32_t tti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  auto db = ue_db.read();
 
   // Iterate all UEs
-  for (auto& iter : ue_db) {
-    _clear_tti_pending_rnti(TTIMOD(tti), iter.first);
+  for (auto& iter : *db) {
+    _clear_tti_pending_rnti(TTIMOD(tti), *iter.second);
   }
 }
 
 void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_cfg_list_t& phy_cfg_list)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(cfg_mutex);
 
-  // Create new user if did not exist
-  if (ue_db.count(rnti) == 0) {
-    _add_rnti(rnti);
+  // Create new user if did not exist, otherwise modify a copy of the current version
+  std::shared_ptr<common_ue> ue_ptr = _copy_ue(rnti);
+  if (ue_ptr == nullptr) {
+    ue_ptr = _create_ue(rnti);
   }
 
   // Get UE by reference
-  common_ue& ue = ue_db[rnti];
+  common_ue& ue = *ue_ptr;
 
   // During a reconfiguration, all parameters in phy_cfg_t shall be applied immediately except:
   // - Multiple CSI request field in DCI (phy_cfg_t.dl_cfg.dci.multiple_csi_request_enabled)
@@ -291,7 +311,7 @@ void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_
   // and the reception of the reconfigurationComplete, the values before the reconfiguration shall be used
 
   // Store the current values for CSI and extended TBS in temporary variables
-  ue.stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
+  ue.stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(ue) > 0);
   for (uint32_t i = 0; i < SRSRAN_MAX_CARRIERS; i++) {
     ue.cell_info[i].stash_use_tbs_index_alt = ue.cell_info[i].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
   }
@@ -342,67 +362,60 @@ void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_
 
   // Enable/Disable extended CSI field in DCI according to 3GPP 36.212 R10 5.3.3.1.1 Format 0
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < nof_cc; ue_cc_idx++) {
-    ue.cell_info[ue_cc_idx].phy_cfg.dl_cfg.dci.multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
+    ue.cell_info[ue_cc_idx].phy_cfg.dl_cfg.dci.multiple_csi_request_enabled = (_count_nof_configured_scell(ue) > 0);
   }
+
+  _publish_ue(rnti, std::move(ue_ptr));
 }
 
 int phy_ue_db::rem_rnti(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(cfg_mutex);
 
-  if (ue_db.count(rnti) == 0) {
+  if (_find_ue(*ue_db.get_unsafe(), rnti) == nullptr) {
     return SRSRAN_ERROR;
   }
 
-  ue_db.erase(rnti);
+  _publish_ue(rnti, nullptr);
 
   return SRSRAN_SUCCESS;
 }
 
-uint32_t phy_ue_db::_count_nof_configured_scell(uint16_t rnti)
-{
-  uint32_t nof_configured_scell = 0;
-  for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
-    if (ue_db[rnti].cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_inactive ||
-        ue_db[rnti].cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_active) {
-      nof_configured_scell++;
-    }
-  }
-  return nof_configured_scell;
-}
-
 int phy_ue_db::complete_config(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(cfg_mutex);
 
   // Makes sure the RNTI exists
-  if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
+  std::shared_ptr<common_ue> ue = _copy_ue(rnti);
+  if (ue == nullptr) {
     return SRSRAN_ERROR;
   }
 
   // Once the reconfiguration is complete, the temporary parameters become the new ones
 
   // Update temporary multiple CSI DCI field with the new value
-  ue_db[rnti].stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
+  ue->stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(*ue) > 0);
   // Update temporary alternate TBS value with the new one
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
-    ue_db[rnti].cell_info[ue_cc_idx].stash_use_tbs_index_alt =
-        ue_db[rnti].cell_info[ue_cc_idx].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
+    ue->cell_info[ue_cc_idx].stash_use_tbs_index_alt = ue->cell_info[ue_cc_idx].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
   }
 
+  _publish_ue(rnti, std::move(ue));
+
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::activate_deactivate_scell(uint16_t rnti, uint32_t ue_cc_idx, bool activate)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(cfg_mutex);
 
   // Assert RNTI and SCell are valid
-  if (_assert_ue_cc(rnti, ue_cc_idx) != SRSRAN_SUCCESS) {
+  std::shared_ptr<common_ue> ue = _copy_ue(rnti);
+  if (_assert_ue_cc(ue.get(), ue_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_SUCCESS;
   }
 
-  cell_info_t& cell_info = ue_db[rnti].cell_info[ue_cc_idx];
+  cell_info_t& cell_info = ue->cell_info[ue_cc_idx];
 
   // If scell is default only complain
   if (activate and cell_info.state == cell_state_none) {
@@ -410,33 +423,41 @@ int phy_ue_db::activate_deactivate_scell(uint16_t rnti, uint32_t ue_cc_idx, bool
   }
 
   // Set scell state
-  cell_info.state = (activate) ? cell_state_secondary_active : cell_state_secondary_inactive;
+  cell_state_t state = (activate) ? cell_state_secondary_active : cell_state_secondary_inactive;
+  if (cell_info.state == state) {
+    return SRSRAN_SUCCESS;
+  }
+  cell_info.state = state;
+
+  _publish_ue(rnti, std::move(ue));
 
   return SRSRAN_SUCCESS;
 }
 
 bool phy_ue_db::is_pcell(uint16_t rnti, uint32_t enb_cc_idx) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  return _assert_enb_pcell(rnti, enb_cc_idx) == SRSRAN_SUCCESS;
+  auto db = ue_db.read();
+  return _assert_enb_pcell(_find_ue(*db, rnti), enb_cc_idx) == SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t& dl_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  auto                     db      = ue_db.read();
+  const srsran::phy_cfg_t* phy_cfg = _get_rnti_config(*db, rnti, enb_cc_idx);
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  if (phy_cfg == nullptr) {
     return SRSRAN_ERROR;
   }
-  dl_cfg = phy_cfg.dl_cfg;
+  dl_cfg            = phy_cfg->dl_cfg;
+  dl_cfg.pdsch.rnti = rnti;
 
   // The DL configuration must overwrite the use_tbs_index_alt value (for 256QAM) with the temporary value
   // in case we are in the middle of a reconfiguration
-  if (ue_db.count(rnti) && SRSRAN_RNTI_ISUSER(rnti)) {
-    uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
+  const common_ue* ue = _find_ue(*db, rnti);
+  if (ue != nullptr && SRSRAN_RNTI_ISUSER(rnti)) {
+    uint32_t ue_cc_idx = _get_ue_cc_idx(*ue, enb_cc_idx);
     if (ue_cc_idx == 0) {
-      dl_cfg.pdsch.use_tbs_index_alt = ue_db.at(rnti).cell_info[ue_cc_idx].stash_use_tbs_index_alt;
+      dl_cfg.pdsch.use_tbs_index_alt = ue->cell_info[ue_cc_idx].stash_use_tbs_index_alt;
     }
   }
   return SRSRAN_SUCCESS;
@@ -444,20 +465,21 @@ int phy_ue_db::get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t
 
 int phy_ue_db::get_dci_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_cfg_t& dci_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  auto                     db      = ue_db.read();
+  const srsran::phy_cfg_t* phy_cfg = _get_rnti_config(*db, rnti, enb_cc_idx);
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  if (phy_cfg == nullptr) {
     return SRSRAN_ERROR;
   }
-  dci_cfg = phy_cfg.dl_cfg.dci;
+  dci_cfg = phy_cfg->dl_cfg.dci;
 
   // The DCI configuration used for DL grants must overwrite the multiple_csi_request_enabled value with the
   // temporary value in case we are in the middle of a reconfiguration
-  if (ue_db.count(rnti) && SRSRAN_RNTI_ISUSER(rnti)) {
-    uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
+  const common_ue* ue = _find_ue(*db, rnti);
+  if (ue != nullptr && SRSRAN_RNTI_ISUSER(rnti)) {
+    uint32_t ue_cc_idx = _get_ue_cc_idx(*ue, enb_cc_idx);
     if (ue_cc_idx == 0) {
-      dci_cfg.multiple_csi_request_enabled = ue_db.at(rnti).stashed_multiple_csi_request_enabled;
+      dci_cfg.multiple_csi_request_enabled = ue->stashed_multiple_csi_request_enabled;
     }
   }
   return SRSRAN_SUCCESS;
@@ -465,44 +487,47 @@ int phy_ue_db::get_dci_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_
 
 int phy_ue_db::get_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_ul_cfg_t& ul_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  auto                     db      = ue_db.read();
+  const srsran::phy_cfg_t* phy_cfg = _get_rnti_config(*db, rnti, enb_cc_idx);
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  if (phy_cfg == nullptr) {
     return SRSRAN_ERROR;
   }
-  ul_cfg = phy_cfg.ul_cfg;
+  ul_cfg            = phy_cfg->ul_cfg;
+  ul_cfg.pucch.rnti = rnti;
+  ul_cfg.pusch.rnti = rnti;
 
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_dci_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_cfg_t& dci_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  auto                     db      = ue_db.read();
+  const srsran::phy_cfg_t* phy_cfg = _get_rnti_config(*db, rnti, enb_cc_idx);
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  if (phy_cfg == nullptr) {
     return SRSRAN_ERROR;
   }
-  dci_cfg = phy_cfg.dl_cfg.dci;
+  dci_cfg = phy_cfg->dl_cfg.dci;
 
   return SRSRAN_SUCCESS;
 }
 
 bool phy_ue_db::set_ack_pending(uint32_t tti, uint32_t enb_cc_idx, const srsran_dci_dl_t& dci)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  auto             db = ue_db.read();
+  const common_ue* ue = _find_ue(*db, dci.rnti);
 
   // Assert rnti and cell exits and it is active
-  if (_assert_active_enb_cc(dci.rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  if (_assert_active_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
     return false;
   }
 
-  common_ue& ue        = ue_db.at(dci.rnti);
-  uint32_t   ue_cc_idx = _get_ue_cc_idx(dci.rnti, enb_cc_idx);
+  uint32_t ue_cc_idx = _get_ue_cc_idx(*ue, enb_cc_idx);
 
-  srsran_pdsch_ack_cc_t& pdsch_ack_cc = ue.pdsch_ack[tti].cc[ue_cc_idx];
-  pdsch_ack_cc.M                      = 1; ///< Hardcoded for FDD
+  std::lock_guard<std::mutex> lock(ue->tti_state->mutex);
+  srsran_pdsch_ack_cc_t&      pdsch_ack_cc = ue->tti_state->pdsch_ack[tti].cc[ue_cc_idx];
+  pdsch_ack_cc.M                           = 1; ///< Hardcoded for FDD
 
   // Fill PDSCH ACK information
   srsran_pdsch_ack_m_t& pdsch_ack_m  = pdsch_ack_cc.m[0]; ///< Assume FDD only
@@ -532,7 +557,7 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
                             bool              is_pusch_available,
                             srsran_uci_cfg_t& uci_cfg)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  auto db = ue_db.read();
 
   // Reset UCI CFG, avoid returning carrying cached information
   uci_cfg = {};
@@ -543,12 +568,14 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
   }
 
   // Assert eNb Cell/Carrier for the given RNTI
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue_ptr = _find_ue(*db, rnti);
+  if (_assert_active_enb_cc(ue_ptr, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
+  const common_ue& ue = *ue_ptr;
 
   // Get the eNb cell/carrier index with lowest serving cell index (ue_cc_idx) that has an available grant.
-  uint32_t uci_enb_cc_id         = _get_uci_enb_cc_idx(tti, rnti);
+  uint32_t uci_enb_cc_id         = _get_uci_enb_cc_idx(tti, ue);
   bool     pusch_grant_available = (uci_enb_cc_id < (uint32_t)cell_cfg_list->size());
 
   // There is a PUSCH grant available for the provided RNTI in at least one serving cell and this call is for PUCCH
@@ -562,11 +589,10 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
   }
 
   // No PUSCH grant for this TTI and cell and no enb_cc_idx is not the PCell
-  if (not pusch_grant_available and _get_ue_cc_idx(rnti, enb_cc_idx) != 0) {
+  if (not pusch_grant_available and _get_ue_cc_idx(ue, enb_cc_idx) != 0) {
     return SRSRAN_SUCCESS;
   }
 
-  common_ue&               ue           = ue_db.at(rnti);
   const srsran::phy_cfg_t& pcell_cfg    = ue.cell_info[0].phy_cfg;
   bool                     uci_required = false;
 
@@ -586,10 +612,11 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
     // According 3GPP 36.213 R10 section 7.2 UE procedure for reporting Channel State Information (CSI)
     // If the UE is configured with more than one serving cell, it transmits CSI for activated serving cell(s) only.
     if (cell_info.state == cell_state_primary or cell_info.state == cell_state_secondary_active) {
-      const srsran_cell_t& cell = cell_cfg_list->at(cell_info.enb_cc_idx).cell;
+      const srsran_cell_t& cell    = cell_cfg_list->at(cell_info.enb_cc_idx).cell;
+      uint8_t              last_ri = ue.tti_state->cell[cell_idx].last_ri.load(std::memory_order_relaxed);
 
       // Check if CQI report is required
-      periodic_cqi_required = srsran_enb_dl_gen_cqi_periodic(&cell, &dl_cfg, tti, cell_info.last_ri, &uci_cfg.cqi);
+      periodic_cqi_required = srsran_enb_dl_gen_cqi_periodic(&cell, &dl_cfg, tti, last_ri, &uci_cfg.cqi);
 
       // Save SCell index for using it after
       uci_cfg.cqi.scell_index = cell_idx;
@@ -600,17 +627,21 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
   // If no periodic CQI report required, check aperiodic reporting
   if ((not periodic_cqi_required) and aperiodic_cqi_request) {
     // Aperiodic only supported for PCell
-    const srsran_dl_cfg_t& dl_cfg = pcell_info.phy_cfg.dl_cfg;
+    const srsran_dl_cfg_t& dl_cfg  = pcell_info.phy_cfg.dl_cfg;
+    uint8_t                last_ri = ue.tti_state->cell[0].last_ri.load(std::memory_order_relaxed);
 
-    uci_required = srsran_enb_dl_gen_cqi_aperiodic(&pcell, &dl_cfg, pcell_info.last_ri, &uci_cfg.cqi);
+    uci_required = srsran_enb_dl_gen_cqi_aperiodic(&pcell, &dl_cfg, last_ri, &uci_cfg.cqi);
   }
 
   // Get pending ACKs from PDSCH
-  srsran_dl_sf_cfg_t dl_sf_cfg  = {};
-  dl_sf_cfg.tti                 = tti;
-  srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
-  pdsch_ack.is_pusch_available  = is_pusch_available;
-  srsran_enb_dl_gen_ack(&pcell, &dl_sf_cfg, &pdsch_ack, &uci_cfg);
+  srsran_dl_sf_cfg_t dl_sf_cfg = {};
+  dl_sf_cfg.tti                = tti;
+  {
+    std::lock_guard<std::mutex> lock(ue.tti_state->mutex);
+    srsran_pdsch_ack_t&         pdsch_ack = ue.tti_state->pdsch_ack[tti];
+    pdsch_ack.is_pusch_available          = is_pusch_available;
+    srsran_enb_dl_gen_ack(&pcell, &dl_sf_cfg, &pdsch_ack, &uci_cfg);
+  }
   uci_required |= (srsran_uci_cfg_total_ack(&uci_cfg) > 0);
 
   // Return whether UCI needs to be decoded
@@ -662,10 +693,11 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
                              const srsran_uci_cfg_t&   uci_cfg,
                              const srsran_uci_value_t& uci_value)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  auto db = ue_db.read();
 
   // Assert UE RNTI database entry and eNb cell/carrier must be active
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue_ptr = _find_ue(*db, rnti);
+  if (_assert_active_enb_cc(ue_ptr, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
@@ -680,12 +712,16 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
   }
 
   // Get UE
-  common_ue& ue = ue_db.at(rnti);
+  const common_ue& ue = *ue_ptr;
 
-  // Get ACK info
-  srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
-  const srsran_cell_t& cell      = cell_cfg_list->at(ue.cell_info[0].enb_cc_idx).cell;
-  srsran_enb_dl_get_ack(&cell, &uci_cfg, &uci_value, &pdsch_ack);
+  // Get ACK info, copied out so the stack is not called with the UE state locked
+  srsran_pdsch_ack_t   pdsch_ack;
+  const srsran_cell_t& cell = cell_cfg_list->at(ue.cell_info[0].enb_cc_idx).cell;
+  {
+    std::lock_guard<std::mutex> lock(ue.tti_state->mutex);
+    srsran_enb_dl_get_ack(&cell, &uci_cfg, &uci_value, &ue.tti_state->pdsch_ack[tti]);
+    pdsch_ack = ue.tti_state->pdsch_ack[tti];
+  }
 
   // Iterate over the ACK information
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
@@ -702,13 +738,13 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
   }
 
   // Assert the SCell exists and it is active
-  if (_assert_ue_cc(rnti, uci_cfg.cqi.scell_index) != SRSRAN_SUCCESS) {
+  if (_assert_ue_cc(ue_ptr, uci_cfg.cqi.scell_index) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Get CQI carrier index
-  cell_info_t& cqi_scell_info = ue_db.at(rnti).cell_info[uci_cfg.cqi.scell_index];
-  uint32_t     cqi_cc_idx     = cqi_scell_info.enb_cc_idx;
+  const cell_info_t& cqi_scell_info = ue.cell_info[uci_cfg.cqi.scell_index];
+  uint32_t           cqi_cc_idx     = cqi_scell_info.enb_cc_idx;
 
   // Notify CQI only if CRC is valid
   if (uci_value.cqi.data_crc) {
@@ -716,7 +752,6 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
     if (uci_cfg.cqi.data_enable) {
       send_cqi_data(tti, rnti, cqi_cc_idx, uci_cfg.cqi, uci_value.cqi, ue.cell_info[0].phy_cfg.dl_cfg.cqi_report, cell, stack);
     }
-
     // Precoding Matrix indicator (TM4)
     if (uci_cfg.cqi.pmi_present) {
       uint8_t pmi_value = 0;
@@ -738,7 +773,7 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
   // Rank indicator (TM3 and TM4)
   if (uci_cfg.cqi.ri_len) {
     stack->ri_info(tti, rnti, cqi_cc_idx, uci_value.ri);
-    cqi_scell_info.last_ri = uci_value.ri;
+    ue.tti_state->cell[uci_cfg.cqi.scell_index].last_ri.store(uci_value.ri, std::memory_order_relaxed);
   }
 
   return SRSRAN_SUCCESS;
@@ -746,43 +781,48 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
 
 int phy_ue_db::set_last_ul_tb(uint16_t rnti, uint32_t enb_cc_idx, uint32_t pid, srsran_ra_tb_t tb)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  auto             db = ue_db.read();
+  const common_ue* ue = _find_ue(*db, rnti);
 
   // Assert UE DB entry
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  if (_assert_active_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Save resource allocation
-  ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].last_tb[pid] = tb;
+  std::lock_guard<std::mutex> lock(ue->tti_state->mutex);
+  ue->tti_state->cell[_get_ue_cc_idx(*ue, enb_cc_idx)].last_tb[pid] = tb;
 
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_last_ul_tb(uint16_t rnti, uint32_t enb_cc_idx, uint32_t pid, srsran_ra_tb_t& ra_tb) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  auto             db = ue_db.read();
+  const common_ue* ue = _find_ue(*db, rnti);
 
   // Assert UE DB entry
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  if (_assert_active_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // writes the latest stored UL transmission grant
-  ra_tb = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].last_tb[pid];
+  std::lock_guard<std::mutex> lock(ue->tti_state->mutex);
+  ra_tb = ue->tti_state->cell[_get_ue_cc_idx(*ue, enb_cc_idx)].last_tb[pid];
 
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::set_ul_grant_available(uint32_t tti, const stack_interface_phy_lte::ul_sched_list_t& ul_sched_list)
 {
-  int                         ret = SRSRAN_SUCCESS;
-  std::lock_guard<std::mutex> lock(mutex);
+  int  ret = SRSRAN_SUCCESS;
+  auto db  = ue_db.read();
 
   // Reset all available grants flags for the given TTI
-  for (auto& ue : ue_db) {
-    for (cell_info_t& cell_info : ue.second.cell_info) {
-      cell_info.is_grant_available[tti] = false;
+  for (auto& ue : *db) {
+    std::lock_guard<std::mutex> lock(ue.second->tti_state->mutex);
+    for (cell_tti_state_t& cell_state : ue.second->tti_state->cell) {
+      cell_state.is_grant_available[tti] = false;
     }
   }
 
@@ -792,14 +832,16 @@ int phy_ue_db::set_ul_grant_available(uint32_t tti, const stack_interface_phy_lt
     for (uint32_t i = 0; i < ul_sched.nof_grants; i++) {
       const stack_interface_phy_lte::ul_sched_grant_t& ul_sched_grant = ul_sched.pusch[i];
       uint16_t                                         rnti           = ul_sched_grant.dci.rnti;
+      const common_ue*                                 ue             = _find_ue(*db, rnti);
       // Check that eNb Cell/Carrier is active for the given RNTI
-      if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+      if (_assert_active_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
         ret = SRSRAN_ERROR;
         srslog::fetch_basic_logger("PHY").info("Error setting grant for rnti=0x%x, cc=%d", rnti, enb_cc_idx);
         continue;
       }
       // Rise Grant available flag
-      ue_db[rnti].cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].is_grant_available[tti] = true;
+      std::lock_guard<std::mutex> lock(ue->tti_state->mutex);
+      ue->tti_state->cell[_get_ue_cc_idx(*ue, enb_cc_idx)].is_grant_available[tti] = true;
     }
   }
 
@@ -100,7 +100,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
 
   // Set up pcap and trace
   if (args.mac_pcap.enable) {
-    mac_pcap.open(args.mac_pcap.filename);
+    mac_pcap.open(args.mac_pcap.filename, 0, make_pcap_writer_args(args.mac_pcap));
     mac.start_pcap(&mac_pcap);
   }
 
@@ -212,6 +212,14 @@ void enb_stack_lte::stop_impl()
   started = false;
 }
 
+// Called from the console thread, the filters are thread-safe so no need to defer it to the stack thread
+void enb_stack_lte::cmd_pcap_filter(const srsran::pcap_filter_cfg_t& cfg)
+{
+  mac_pcap.set_filter(cfg);
+  mac_pcap_net.set_filter(cfg);
+  s1ap_pcap.set_filter(cfg);
+}
+
 bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
 {
   // use stack thread to query metrics
@@ -648,7 +648,7 @@ void rrc::parse_ul_ccch(ue& ue, srsran::unique_byte_buffer_t pdu)
 
   ul_ccch_msg_s  ul_ccch_msg;
   asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-  if (ul_ccch_msg.unpack(bref) != asn1::SRSASN_SUCCESS or
+  if (asn1::unpack_in_arena(ul_ccch_msg, bref, rx_arena) != asn1::SRSASN_SUCCESS or
       ul_ccch_msg.msg.type().value != ul_ccch_msg_type_c::types_opts::c1) {
     log_rx_pdu_fail(ue.rnti, srb_to_lcid(lte_srb::srb0), *pdu, "Failed to unpack UL-CCCH message");
     return;
@@ -333,7 +333,7 @@ void rrc::ue::parse_ul_dcch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
   ul_dcch_msg_s  ul_dcch_msg;
   asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-  if (ul_dcch_msg.unpack(bref) != asn1::SRSASN_SUCCESS or
+  if (asn1::unpack_in_arena(ul_dcch_msg, bref, parent->rx_arena) != asn1::SRSASN_SUCCESS or
       ul_dcch_msg.msg.type().value != ul_dcch_msg_type_c::types_opts::c1) {
     parent->log_rx_pdu_fail(rnti, lcid, *pdu, "Failed to unpack UL-DCCH message");
     return;
@@ -520,13 +520,20 @@ void rrc::ue::send_connection_setup()
   // Configure PHY layer
   apply_setup_phy_config_dedicated(rr_cfg.phys_cfg_ded); // It assumes SCell has not been set before
 
+  // Pack the message from the template of the PCell, which is built by the first UE of the cell
+  uint32_t         pcell_enb_cc_idx = ue_cell_list.get_ue_cc_idx(UE_PCELL_CC_IDX)->cell_common->enb_cc_idx;
+  enb_cell_common* pcell            = parent->cell_common_list->get_cc_idx(pcell_enb_cc_idx);
+  if (not pcell->conn_setup_tmpl.is_init()) {
+    pcell->conn_setup_tmpl.init(dl_ccch_msg);
+  }
+
   std::string octet_str;
-  send_dl_ccch(&dl_ccch_msg, &octet_str);
+  send_dl_ccch(&dl_ccch_msg, &octet_str, &pcell->conn_setup_tmpl);
 
   // Log event.
   asn1::json_writer json_writer;
   dl_ccch_msg.to_json(json_writer);
-  event_logger::get().log_rrc_event(ue_cell_list.get_ue_cc_idx(UE_PCELL_CC_IDX)->cell_common->enb_cc_idx,
+  event_logger::get().log_rrc_event(pcell_enb_cc_idx,
                                     octet_str,
                                     json_writer.to_string(),
                                     static_cast<unsigned>(rrc_event_type::con_setup),
@@ -1326,17 +1333,20 @@ void rrc::ue::update_scells()
 
 /********************** HELPERS ***************************/
 
-void rrc::ue::send_dl_ccch(dl_ccch_msg_s* dl_ccch_msg, std::string* octet_str)
+void rrc::ue::send_dl_ccch(dl_ccch_msg_s* dl_ccch_msg, std::string* octet_str, const rrc_conn_setup_template* tmpl)
 {
   // Allocate a new PDU buffer, pack the message and send to PDCP
   srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
   if (pdu) {
-    asn1::bit_ref bref(pdu->msg, pdu->get_tailroom());
-    if (dl_ccch_msg->pack(bref) != asn1::SRSASN_SUCCESS) {
-      parent->logger.error(pdu->msg, pdu->N_bytes, "Failed to pack DL-CCCH-Msg:");
-      return;
+    // Messages that don't match the template are fully packed
+    if (tmpl == nullptr or tmpl->pack(*dl_ccch_msg, *pdu) != SRSRAN_SUCCESS) {
+      asn1::bit_ref bref(pdu->msg, pdu->get_tailroom());
+      if (dl_ccch_msg->pack(bref) != asn1::SRSASN_SUCCESS) {
+        parent->logger.error(pdu->msg, pdu->N_bytes, "Failed to pack DL-CCCH-Msg:");
+        return;
+      }
+      pdu->N_bytes = (uint32_t)bref.distance_bytes();
     }
-    pdu->N_bytes = (uint32_t)bref.distance_bytes();
 
     // Log Tx message
     parent->log_rrc_message(
@@ -626,4 +626,202 @@ int apply_reconf_updates(asn1::rrc::rrc_conn_recfg_r8_ies_s&  recfg_r8,
   return SRSRAN_SUCCESS;
 }
 
+/***********************************
+ *   RRCConnectionSetup template
+ **********************************/
+
+namespace {
+
+/// Bounds of the ASN.1 constraints of the UE specific fields of the RRCConnectionSetup
+const uint32_t conn_setup_field_bounds[rrc_conn_setup_template::nof_fields][2] = {{0, 3},
+                                                                                  {0, 157},
+                                                                                  {0, 2047},
+                                                                                  {0, 1023},
+                                                                                  {0, 1185}};
+
+const rrc_conn_setup_s* get_conn_setup(const dl_ccch_msg_s& msg)
+{
+  if (msg.msg.type().value != dl_ccch_msg_type_c::types_opts::c1 or
+      msg.msg.c1().type().value != dl_ccch_msg_type_c::c1_c_::types_opts::rrc_conn_setup) {
+    return nullptr;
+  }
+  const rrc_conn_setup_s& setup = msg.msg.c1().rrc_conn_setup();
+  if (setup.crit_exts.type().value != c1_or_crit_ext_e::c1 or
+      setup.crit_exts.c1().type().value != rrc_conn_setup_s::crit_exts_c_::c1_c_::types_opts::rrc_conn_setup_r8) {
+    return nullptr;
+  }
+  return &setup;
+}
+
+/// Reads a UE specific field of the RRCConnectionSetup, returns false if the field is not present
+bool get_conn_setup_field(const rrc_conn_setup_s& setup, uint32_t field, uint32_t& value)
+{
+  const rr_cfg_ded_s&   rr_cfg  = setup.crit_exts.c1().rrc_conn_setup_r8().rr_cfg_ded;
+  const phys_cfg_ded_s& phy_cfg = rr_cfg.phys_cfg_ded;
+
+  bool sr_present = rr_cfg.phys_cfg_ded_present and phy_cfg.sched_request_cfg_present and
+                    phy_cfg.sched_request_cfg.type().value == setup_e::setup;
+  bool cqi_present = rr_cfg.phys_cfg_ded_present and phy_cfg.cqi_report_cfg_present and
+                     phy_cfg.cqi_report_cfg.cqi_report_periodic_present and
+                     phy_cfg.cqi_report_cfg.cqi_report_periodic.type().value == setup_e::setup;
+
+  switch (field) {
+    case rrc_conn_setup_template::transaction_id:
+      value = setup.rrc_transaction_id;
+      return true;
+    case rrc_conn_setup_template::sr_cfg_idx:
+      value = sr_present ? phy_cfg.sched_request_cfg.setup().sr_cfg_idx : 0;
+      return sr_present;
+    case rrc_conn_setup_template::sr_pucch_res_idx:
+      value = sr_present ? phy_cfg.sched_request_cfg.setup().sr_pucch_res_idx : 0;
+      return sr_present;
+    case rrc_conn_setup_template::cqi_pmi_cfg_idx:
+      value = cqi_present ? phy_cfg.cqi_report_cfg.cqi_report_periodic.setup().cqi_pmi_cfg_idx : 0;
+      return cqi_present;
+    case rrc_conn_setup_template::cqi_pucch_res_idx:
+      value = cqi_present ? phy_cfg.cqi_report_cfg.cqi_report_periodic.setup().cqi_pucch_res_idx : 0;
+      return cqi_present;
+    default:
+      return false;
+  }
+}
+
+/// Writes a UE specific field of the RRCConnectionSetup, which must be present
+void set_conn_setup_field(rrc_conn_setup_s& setup, uint32_t field, uint32_t value)
+{
+  phys_cfg_ded_s& phy_cfg = setup.crit_exts.c1().rrc_conn_setup_r8().rr_cfg_ded.phys_cfg_ded;
+  switch (field) {
+    case rrc_conn_setup_template::transaction_id:
+      setup.rrc_transaction_id = value;
+      break;
+    case rrc_conn_setup_template::sr_cfg_idx:
+      phy_cfg.sched_request_cfg.setup().sr_cfg_idx = value;
+      break;
+    case rrc_conn_setup_template::sr_pucch_res_idx:
+      phy_cfg.sched_request_cfg.setup().sr_pucch_res_idx = value;
+      break;
+    case rrc_conn_setup_template::cqi_pmi_cfg_idx:
+      phy_cfg.cqi_report_cfg.cqi_report_periodic.setup().cqi_pmi_cfg_idx = value;
+      break;
+    case rrc_conn_setup_template::cqi_pucch_res_idx:
+      phy_cfg.cqi_report_cfg.cqi_report_periodic.setup().cqi_pucch_res_idx = value;
+      break;
+    default:
+      break;
+  }
+}
+
+int pack_dl_ccch(const dl_ccch_msg_s& msg, uint8_t* buf, uint32_t max_len, uint32_t& len)
+{
+  asn1::bit_ref bref(buf, max_len);
+  if (msg.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  len = (uint32_t)bref.distance_bytes();
+  return SRSRAN_SUCCESS;
+}
+
+bool get_bit(const uint8_t* buf, uint32_t bit)
+{
+  return (buf[bit / 8] >> (7U - bit % 8)) & 1U;
+}
+
+void write_bits(uint8_t* buf, uint32_t bit_offset, uint32_t nof_bits, uint32_t value)
+{
+  for (uint32_t i = 0; i < nof_bits; ++i) {
+    uint32_t bit  = bit_offset + i;
+    uint8_t  mask = 0x80U >> (bit % 8);
+    if ((value >> (nof_bits - 1 - i)) & 1U) {
+      buf[bit / 8] |= mask;
+    } else {
+      buf[bit / 8] &= ~mask;
+    }
+  }
+}
+
+} // namespace
+
+int rrc_conn_setup_template::init(const dl_ccch_msg_s& msg)
+{
+  len = 0;
+
+  const rrc_conn_setup_s* setup = get_conn_setup(msg);
+  if (setup == nullptr) {
+    srslog::fetch_basic_logger("RRC").error("The RRCConnectionSetup template requires a RRCConnectionSetup message");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t tmpl_len;
+  if (pack_dl_ccch(msg, buffer.data(), max_len, tmpl_len) != SRSRAN_SUCCESS) {
+    srslog::fetch_basic_logger("RRC").error("Failed to pack RRCConnectionSetup template");
+    return SRSRAN_ERROR;
+  }
+
+  dl_ccch_msg_s                tmp       = msg;
+  rrc_conn_setup_s&            tmp_setup = tmp.msg.c1().rrc_conn_setup();
+  std::array<uint8_t, max_len> lb_buffer, ub_buffer;
+  for (uint32_t i = 0; i < nof_fields; ++i) {
+    uint32_t value;
+    fields[i].present = get_conn_setup_field(*setup, i, value);
+    if (not fields[i].present) {
+      continue;
+    }
+
+    uint32_t lb     = conn_setup_field_bounds[i][0];
+    uint32_t ub     = conn_setup_field_bounds[i][1];
+    uint32_t lb_len = 0, ub_len = 0;
+    set_conn_setup_field(tmp_setup, i, lb);
+    pack_dl_ccch(tmp, lb_buffer.data(), max_len, lb_len);
+    set_conn_setup_field(tmp_setup, i, ub);
+    pack_dl_ccch(tmp, ub_buffer.data(), max_len, ub_len);
+    set_conn_setup_field(tmp_setup, i, value);
+    if (lb_len != tmpl_len or ub_len != tmpl_len) {
+      srslog::fetch_basic_logger("RRC").error("RRCConnectionSetup template field %d doesn't have a fixed size", i);
+      return SRSRAN_ERROR;
+    }
+
+    // The most significant bit of (ub - lb) is set, so the first bit that differs is the first bit of the field
+    fields[i].nof_bits = 0;
+    while ((ub - lb) >> fields[i].nof_bits) {
+      fields[i].nof_bits++;
+    }
+    uint32_t bit = 0;
+    while (bit < tmpl_len * 8 and get_bit(lb_buffer.data(), bit) == get_bit(ub_buffer.data(), bit)) {
+      bit++;
+    }
+    fields[i].bit_offset = bit;
+    for (; bit < tmpl_len * 8; ++bit) {
+      if (get_bit(lb_buffer.data(), bit) != get_bit(ub_buffer.data(), bit) and
+          bit >= fields[i].bit_offset + fields[i].nof_bits) {
+        srslog::fetch_basic_logger("RRC").error("Couldn't find RRCConnectionSetup template field %d", i);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  len = tmpl_len;
+  return SRSRAN_SUCCESS;
+}
+
+int rrc_conn_setup_template::pack(const dl_ccch_msg_s& msg, srsran::byte_buffer_t& pdu) const
+{
+  const rrc_conn_setup_s* setup = get_conn_setup(msg);
+  if (not is_init() or setup == nullptr or len > pdu.get_tailroom()) {
+    return SRSRAN_ERROR;
+  }
+
+  memcpy(pdu.msg, buffer.data(), len);
+  for (uint32_t i = 0; i < nof_fields; ++i) {
+    uint32_t value;
+    if (get_conn_setup_field(*setup, i, value) != fields[i].present) {
+      return SRSRAN_ERROR;
+    }
+    if (fields[i].present) {
+      write_bits(pdu.msg, fields[i].bit_offset, fields[i].nof_bits, value - conn_setup_field_bounds[i][0]);
+    }
+  }
+  pdu.N_bytes = len;
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
@@ -686,10 +686,23 @@ bool s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu)
     pcap->write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
-  s1ap_pdu_c     rx_pdu;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
+  // Index the IEs first, so that messages of unknown UEs are discarded without decoding them
+  asn1::ap_pdu_index index;
+  s1ap_pdu_c         rx_pdu;
+  asn1::cbit_ref     bref(pdu->msg, pdu->N_bytes);
 
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  if (index.unpack(pdu->msg, pdu->N_bytes) != asn1::SRSASN_SUCCESS) {
+    logger.error(pdu->msg, pdu->N_bytes, "Failed to unpack received PDU");
+    cause_c cause;
+    cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
+    send_error_indication(cause);
+    return false;
+  }
+  if (discard_unknown_ue_pdu(index, srsran::make_span(*pdu))) {
+    return false;
+  }
+
+  if (asn1::unpack_in_arena(rx_pdu, bref, rx_arena) != asn1::SRSASN_SUCCESS) {
     logger.error(pdu->msg, pdu->N_bytes, "Failed to unpack received PDU");
     cause_c cause;
     cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
@@ -713,6 +726,36 @@ bool s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu)
   return true;
 }
 
+/**
+ * Checks the UE S1AP IDs of DL NAS Transport messages, the most frequent ones, before decoding the whole message.
+ * @return true if the eNB UE S1AP ID is unknown, in which case the error indication has already been sent
+ */
+bool s1ap::discard_unknown_ue_pdu(const asn1::ap_pdu_index& index, srsran::const_span<uint8_t> sdu)
+{
+  if (index.pdu_type() != asn1::ap_pdu_index::pdu_type_t::init_msg or
+      index.proc_code() != ASN1_S1AP_ID_DL_NAS_TRANSPORT) {
+    return false;
+  }
+
+  // Malformed IEs are reported by the full decoding
+  enb_ue_s1ap_id_t enb_ue_s1ap_id;
+  mme_ue_s1ap_id_t mme_ue_s1ap_id;
+  if (index.unpack_ie(ASN1_S1AP_ID_ENB_UE_S1AP_ID, enb_ue_s1ap_id) != asn1::SRSASN_SUCCESS or
+      index.unpack_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID, mme_ue_s1ap_id) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  if (users.find_ue_enbid(enb_ue_s1ap_id.value) != nullptr) {
+    return false;
+  }
+
+  logger.info(sdu.data(),
+              sdu.size(),
+              "Rx S1AP SDU - %s",
+              s1ap_elem_procs_o::get_init_msg(index.proc_code()).type().to_string());
+  handle_s1apmsg_ue_id(enb_ue_s1ap_id.value, mme_ue_s1ap_id.value);
+  return true;
+}
+
 bool s1ap::handle_initiatingmessage(const init_msg_s& msg)
 {
   switch (msg.value.type().value) {
@@ -0,0 +1,164 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/phy_ue_db.h"
+#include "srsran/common/test_common.h"
+#include <atomic>
+#include <thread>
+
+using namespace srsenb;
+
+static const uint16_t rnti        = 0x46;
+static const uint32_t nof_ttis    = 20000;
+static const uint32_t ack_delay   = FDD_HARQ_DELAY_DL_MS;
+static const uint32_t max_pending = TTIMOD_SZ - ack_delay - 1; ///< DL TTIs in flight, so no ACK slot is overwritten
+
+/// Counts the ACKs reported by the PHY
+class dummy_stack final : public stack_interface_phy_lte
+{
+public:
+  std::atomic<uint32_t> nof_acks = {0};
+
+  int  sr_detected(uint32_t tti, uint16_t rnti) override { return SRSRAN_SUCCESS; }
+  void rach_detected(uint32_t tti, uint32_t primary_cc_idx, uint32_t preamble_idx, uint32_t time_adv) override {}
+  int  ri_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t ri_value) override { return SRSRAN_SUCCESS; }
+  int  pmi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t pmi_value) override { return SRSRAN_SUCCESS; }
+  int  cqi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t cqi_value) override { return SRSRAN_SUCCESS; }
+  int  sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t sb_idx, uint32_t cqi_value) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int snr_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, float snr_db, ul_channel_t ch) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override { return SRSRAN_SUCCESS; }
+  int ack_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t tb_idx, bool ack) override
+  {
+    if (ack) {
+      nof_acks++;
+    }
+    return SRSRAN_SUCCESS;
+  }
+  int crc_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_bytes, bool crc_res) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int push_pdu(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_bytes, bool crc_res, uint32_t nof_prb)
+      override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int  get_dl_sched(uint32_t tti, dl_sched_list_t& dl_sched_res) override { return SRSRAN_SUCCESS; }
+  int  get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res) override { return SRSRAN_SUCCESS; }
+  int  get_ul_sched(uint32_t tti, ul_sched_list_t& ul_sched_res) override { return SRSRAN_SUCCESS; }
+  void set_sched_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs) override {}
+};
+
+/**
+ * The pending ACKs of DL TTI n are set by one worker and consumed by the worker processing the UL TTI n + 4, as the
+ * PHY worker pool does. The TTI progress counters are relaxed, so the UE database alone must order the ACK hand-off
+ * (run it with ENABLE_TSAN to check there is no data race).
+ */
+int test_ack_handoff()
+{
+  dummy_stack         stack;
+  phy_args_t          phy_args = {};
+  phy_cell_cfg_list_t cell_list(1);
+  cell_list[0].cell            = {};
+  cell_list[0].cell.nof_prb    = 6;
+  cell_list[0].cell.nof_ports  = 1;
+  cell_list[0].cell.frame_type = SRSRAN_FDD;
+
+  phy_ue_db ue_db;
+  ue_db.init(&stack, phy_args, cell_list);
+
+  phy_interface_rrc_lte::phy_rrc_cfg_list_t cfg_list(1);
+  cfg_list[0].configured = true;
+  cfg_list[0].phy_cfg.set_defaults();
+  ue_db.addmod_rnti(rnti, cfg_list);
+
+  std::atomic<uint32_t> dl_count   = {0};
+  std::atomic<uint32_t> ul_count   = {0};
+  std::atomic<uint32_t> nof_errors = {0};
+
+  std::thread dl_worker([&]() {
+    for (uint32_t tti = 0; tti < nof_ttis; tti++) {
+      while (tti >= ul_count.load(std::memory_order_relaxed) + max_pending) {
+        std::this_thread::yield();
+      }
+      uint32_t tti_tx_ul = TTI_ADD(tti, ack_delay);
+      ue_db.clear_tti_pending_ack(tti_tx_ul);
+
+      srsran_dci_dl_t dci = {};
+      dci.rnti            = rnti;
+      dci.format          = SRSRAN_DCI_FORMAT1;
+      dci.tb[0].mcs_idx   = 10;
+      dci.tb[1].mcs_idx   = 0;
+      dci.tb[1].rv        = 1;
+      if (not ue_db.set_ack_pending(tti_tx_ul, 0, dci)) {
+        nof_errors++;
+      }
+      dl_count.store(tti + 1, std::memory_order_relaxed);
+    }
+  });
+
+  std::thread ul_worker([&]() {
+    for (uint32_t tti = 0; tti < nof_ttis; tti++) {
+      while (tti >= dl_count.load(std::memory_order_relaxed)) {
+        std::this_thread::yield();
+      }
+      uint32_t         tti_rx  = TTI_ADD(tti, ack_delay);
+      srsran_uci_cfg_t uci_cfg = {};
+      if (ue_db.fill_uci_cfg(tti_rx, 0, rnti, false, false, uci_cfg) < SRSRAN_SUCCESS or
+          srsran_uci_cfg_total_ack(&uci_cfg) != 1) {
+        nof_errors++;
+      }
+
+      srsran_uci_value_t uci_value = {};
+      uci_value.ack.valid          = true;
+      uci_value.ack.ack_value[0]   = 1;
+      if (ue_db.send_uci_data(tti_rx, rnti, 0, uci_cfg, uci_value) < SRSRAN_SUCCESS) {
+        nof_errors++;
+      }
+      ul_count.store(tti + 1, std::memory_order_relaxed);
+    }
+  });
+
+  dl_worker.join();
+  ul_worker.join();
+
+  TESTASSERT(nof_errors == 0);
+  TESTASSERT(stack.nof_acks == nof_ttis);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_ack_handoff() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/enb.h"
+#include "srsenb/hdr/enb_cfg_snapshot.h"
+#include "srsran/common/test_common.h"
+#include "test_helpers.h"
+#include <stdio.h>
+
+using namespace srsenb;
+
+namespace {
+
+const std::string snapshot_file = "enb_cfg_snapshot_test.snapshot";
+
+template <typename Msg>
+std::vector<uint8_t> pack(const Msg& msg)
+{
+  std::vector<uint8_t> buffer(4096);
+  asn1::bit_ref        bref(buffer.data(), buffer.size());
+  if (msg.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return {};
+  }
+  buffer.resize(bref.distance_bytes());
+  return buffer;
+}
+
+/// Compares what the snapshot restores, i.e. the cell, the SIBs and the PHY configuration derived from SIB2
+bool is_cfg_equal(const rrc_cfg_t& cfg1, const phy_cfg_t& phy1, const rrc_cfg_t& cfg2, const phy_cfg_t& phy2)
+{
+  if (memcmp(&cfg1.cell, &cfg2.cell, sizeof(cfg1.cell)) != 0 or pack(cfg1.sib1) != pack(cfg2.sib1)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < ASN1_RRC_MAX_SIB; i++) {
+    if (cfg1.sibs[i].type() != cfg2.sibs[i].type()) {
+      return false;
+    }
+  }
+  for (uint32_t i : {1, 2}) {
+    if (pack(cfg1.sibs[i]) != pack(cfg2.sibs[i])) {
+      return false;
+    }
+  }
+  return pack(phy1.prach_cnfg) == pack(phy2.prach_cnfg) and pack(phy1.pdsch_cnfg) == pack(phy2.pdsch_cnfg) and
+         pack(phy1.pusch_cnfg) == pack(phy2.pusch_cnfg) and pack(phy1.pucch_cnfg) == pack(phy2.pucch_cnfg) and
+         pack(phy1.srs_ul_cnfg) == pack(phy2.srs_ul_cnfg);
+}
+
+int test_cfg_snapshot()
+{
+  remove(snapshot_file.c_str());
+
+  all_args_t   args;
+  rrc_cfg_t    ref_cfg;
+  phy_cfg_t    ref_phy_cfg;
+  rrc_nr_cfg_t rrc_nr_cfg;
+  TESTASSERT(test_helpers::parse_default_cfg(&args, &ref_cfg, &ref_phy_cfg, &rrc_nr_cfg) == SRSRAN_SUCCESS);
+
+  // The first start writes the snapshot, the following ones load it and must end up with the same configuration
+  for (uint32_t i = 0; i < 2; i++) {
+    rrc_cfg_t rrc_cfg;
+    phy_cfg_t phy_cfg;
+    TESTASSERT(test_helpers::parse_default_cfg(&args, &rrc_cfg, &phy_cfg, &rrc_nr_cfg, snapshot_file) ==
+               SRSRAN_SUCCESS);
+    TESTASSERT(is_cfg_equal(ref_cfg, ref_phy_cfg, rrc_cfg, phy_cfg));
+  }
+
+  uint64_t      key  = cfg_snapshot::get_key(args);
+  srsran_cell_t cell = {};
+  rrc_cfg_t     rrc_cfg;
+  TESTASSERT(key != 0);
+  TESTASSERT(cfg_snapshot::load(snapshot_file, key, &cell, &rrc_cfg) == SRSRAN_SUCCESS);
+
+  // Arguments the SIBs depend on are part of the key, those they don't depend on are not
+  all_args_t other_args = args;
+  other_args.enb.n_prb  = 25;
+  TESTASSERT(cfg_snapshot::get_key(other_args) != key);
+  TESTASSERT(cfg_snapshot::load(snapshot_file, cfg_snapshot::get_key(other_args), &cell, &rrc_cfg) != SRSRAN_SUCCESS);
+  other_args               = args;
+  other_args.enb.dl_earfcn = 3350;
+  TESTASSERT(cfg_snapshot::get_key(other_args) == key);
+
+  // A corrupted snapshot is not loaded, the configuration is parsed again and the snapshot rewritten
+  FILE* f = fopen(snapshot_file.c_str(), "r+b");
+  TESTASSERT(f != nullptr);
+  TESTASSERT(fseek(f, -1, SEEK_END) == 0);
+  int last = fgetc(f);
+  TESTASSERT(fseek(f, -1, SEEK_END) == 0);
+  fputc(last ^ 0xff, f);
+  fclose(f);
+  TESTASSERT(cfg_snapshot::load(snapshot_file, key, &cell, &rrc_cfg) != SRSRAN_SUCCESS);
+  phy_cfg_t phy_cfg;
+  TESTASSERT(test_helpers::parse_default_cfg(&args, &rrc_cfg, &phy_cfg, &rrc_nr_cfg, snapshot_file) == SRSRAN_SUCCESS);
+  TESTASSERT(is_cfg_equal(ref_cfg, ref_phy_cfg, rrc_cfg, phy_cfg));
+  TESTASSERT(cfg_snapshot::load(snapshot_file, key, &cell, &rrc_cfg) == SRSRAN_SUCCESS);
+
+  remove(snapshot_file.c_str());
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  if (argc < 3) {
+    argparse::usage(argv[0]);
+    return -1;
+  }
+  argparse::parse_args(argc, argv);
+
+  TESTASSERT(test_cfg_snapshot() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  srsran::console("Success\n");
+
+  return SRSRAN_SUCCESS;
+}
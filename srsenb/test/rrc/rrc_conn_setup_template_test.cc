@@ -0,0 +1,116 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/enb.h"
+#include "srsenb/hdr/stack/rrc/rrc_cell_cfg.h"
+#include "srsenb/hdr/stack/rrc/ue_rr_cfg.h"
+#include "srsran/common/test_common.h"
+#include "test_helpers.h"
+
+using namespace asn1::rrc;
+
+namespace srsenb {
+
+int fill_conn_setup(dl_ccch_msg_s& msg, const rrc_cfg_t& cfg, const ue_cell_ded_list& ue_cell_list, uint8_t tid)
+{
+  rrc_conn_setup_s& rrc_setup  = msg.msg.set_c1().set_rrc_conn_setup();
+  rrc_setup.rrc_transaction_id = tid;
+  rr_cfg_ded_s& rr_cfg         = rrc_setup.crit_exts.set_c1().set_rrc_conn_setup_r8().rr_cfg_ded;
+  return fill_rr_cfg_ded_setup(rr_cfg, cfg, ue_cell_list);
+}
+
+/**
+ * Checks that the RRCConnectionSetup packed from the template of the cell is identical to the fully packed message,
+ * for UEs with different SR/CQI resources and transaction IDs
+ */
+int test_conn_setup_template(rrc_cfg_cqi_mode_t cqi_mode)
+{
+  rrc_cfg_t          cfg;
+  srsenb::all_args_t all_args;
+  TESTASSERT(test_helpers::parse_default_cfg(&cfg, all_args) == SRSRAN_SUCCESS);
+  cfg.cqi_cfg.mode = cqi_mode;
+
+  enb_cell_common_list cell_list{cfg};
+  freq_res_common_list freq_res{cfg};
+  TESTASSERT(cell_list.nof_cells() > 0);
+
+  rrc_conn_setup_template                         tmpl;
+  std::vector<std::unique_ptr<ue_cell_ded_list> > ues;
+  for (uint32_t i = 0; i < 16; ++i) {
+    ues.emplace_back(new ue_cell_ded_list{cfg, freq_res, cell_list});
+    if (not ues.back()->set_cells({0})) {
+      // Out of PUCCH resources
+      ues.pop_back();
+      break;
+    }
+
+    dl_ccch_msg_s msg;
+    TESTASSERT(fill_conn_setup(msg, cfg, *ues.back(), i % 4) == SRSRAN_SUCCESS);
+    if (not tmpl.is_init()) {
+      TESTASSERT(tmpl.init(msg) == SRSRAN_SUCCESS);
+    }
+
+    srsran::unique_byte_buffer_t full_pdu = srsran::make_byte_buffer();
+    srsran::unique_byte_buffer_t tmpl_pdu = srsran::make_byte_buffer();
+    TESTASSERT(full_pdu != nullptr and tmpl_pdu != nullptr);
+    asn1::bit_ref bref(full_pdu->msg, full_pdu->get_tailroom());
+    TESTASSERT(msg.pack(bref) == asn1::SRSASN_SUCCESS);
+    full_pdu->N_bytes = bref.distance_bytes();
+    TESTASSERT(tmpl.pack(msg, *tmpl_pdu) == SRSRAN_SUCCESS);
+    TESTASSERT(tmpl_pdu->N_bytes == full_pdu->N_bytes);
+    TESTASSERT(memcmp(tmpl_pdu->msg, full_pdu->msg, full_pdu->N_bytes) == 0);
+  }
+  TESTASSERT(ues.size() > 1);
+
+  // A message with different optional fields than the template is not packed
+  dl_ccch_msg_s msg;
+  TESTASSERT(fill_conn_setup(msg, cfg, *ues.front(), 0) == SRSRAN_SUCCESS);
+  msg.msg.c1().rrc_conn_setup().crit_exts.c1().rrc_conn_setup_r8().rr_cfg_ded.phys_cfg_ded.sched_request_cfg_present =
+      false;
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  TESTASSERT(tmpl.pack(msg, *pdu) == SRSRAN_ERROR);
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  auto& logger = srslog::fetch_basic_logger("RRC", false);
+  logger.set_level(srslog::basic_levels::info);
+  srslog::init();
+
+  if (argc < 3) {
+    argparse::usage(argv[0]);
+    return -1;
+  }
+  argparse::parse_args(argc, argv);
+
+  TESTASSERT(srsenb::test_conn_setup_template(srsenb::RRC_CFG_CQI_MODE_PERIODIC) == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_conn_setup_template(srsenb::RRC_CFG_CQI_MODE_APERIODIC) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  srsran::console("Success\n");
+
+  return 0;
+}
@@ -51,7 +51,52 @@ void test_paging()
   }
 }
 
+/// Checks that the incrementally encoded PCCH matches the encoding of the whole PCCH message
+void test_paging_incremental_pack()
+{
+  paging_manager pcch_manager{32, 1};
+
+  // All the records go to the same paging occasion
+  unsigned ue_id    = 4780;
+  uint8_t  imsi[]   = {0, 0, 1, 0, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0};
+  uint8_t  m_tmsi[] = {0x64, 0x04, 0x00, 0x02};
+  for (unsigned i = 0; i < ASN1_RRC_MAX_PAGE_REC; ++i) {
+    if (i % 3 == 0) {
+      TESTASSERT(pcch_manager.add_imsi_paging(ue_id, srsran::const_byte_span{imsi, 6 + i % 10}));
+    } else {
+      m_tmsi[3] = i;
+      TESTASSERT(pcch_manager.add_tmsi_paging(ue_id, i, m_tmsi));
+    }
+
+    tti_point t{0};
+    while (pcch_manager.pending_pcch_bytes(t) == 0) {
+      ++t;
+      TESTASSERT(t.to_uint() < 10240);
+    }
+    size_t nof_bytes = pcch_manager.pending_pcch_bytes(t);
+
+    // The PCCH is not marked as transmitted, so that more records can be added to it
+    bool checked = false;
+    pcch_manager.read_pdu_pcch(t, [&](srsran::const_byte_span pdu, const asn1::rrc::pcch_msg_s& msg, bool) {
+      TESTASSERT_EQ(i + 1, msg.msg.c1().paging().paging_record_list.size());
+      uint8_t       buf[256] = {};
+      asn1::bit_ref bref(buf, sizeof(buf));
+      TESTASSERT(msg.pack(bref) == asn1::SRSASN_SUCCESS);
+      TESTASSERT_EQ((size_t)bref.distance_bytes(), pdu.size());
+      TESTASSERT_EQ(pdu.size(), nof_bytes);
+      TESTASSERT(std::equal(pdu.begin(), pdu.end(), buf));
+      checked = true;
+      return false;
+    });
+    TESTASSERT(checked);
+  }
+
+  // No space left for more records
+  TESTASSERT(not pcch_manager.add_tmsi_paging(ue_id, 1, m_tmsi));
+}
+
 int main()
 {
   test_paging();
+  test_paging_incremental_pack();
 }
\ No newline at end of file
@@ -70,15 +70,20 @@ int parse_default_cfg(rrc_nr_cfg_t* rrc_nr_cfg)
   return parse_default_cfg(&args, &rrc_cfg, &phy_cfg, rrc_nr_cfg);
 }
 
-int parse_default_cfg(srsenb::all_args_t* args, rrc_cfg_t* rrc_cfg, phy_cfg_t* phy_cfg, rrc_nr_cfg_t* rrc_nr_cfg)
+int parse_default_cfg(srsenb::all_args_t* args,
+                      rrc_cfg_t*          rrc_cfg,
+                      phy_cfg_t*          phy_cfg,
+                      rrc_nr_cfg_t*       rrc_nr_cfg,
+                      const std::string&  cfg_snapshot)
 {
   *args    = {};
   *rrc_cfg = {};
   *phy_cfg = {};
 
-  args->enb_files.sib_config = argparse::repository_dir + "/sib.conf.example";
-  args->enb_files.rr_config  = argparse::repository_dir + "/rr.conf.example";
-  args->enb_files.rb_config  = argparse::repository_dir + "/rb.conf.example";
+  args->enb_files.sib_config   = argparse::repository_dir + "/sib.conf.example";
+  args->enb_files.rr_config    = argparse::repository_dir + "/rr.conf.example";
+  args->enb_files.rb_config    = argparse::repository_dir + "/rb.conf.example";
+  args->enb_files.cfg_snapshot = cfg_snapshot;
   srslog::fetch_basic_logger("TEST").debug("sib file path=%s", args->enb_files.sib_config.c_str());
 
   args->enb.enb_id    = 0x19B;
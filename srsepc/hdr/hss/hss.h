@@ -28,11 +28,18 @@
 #ifndef SRSEPC_HSS_H
 #define SRSEPC_HSS_H
 
+#include "srsepc/hdr/hss/hss_db.h"
+#include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/flat_hash_map.h"
+#include "srsran/common/block_queue.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/threads.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
+#include <atomic>
 #include <cstddef>
+#include <mutex>
 
 #include <map>
 
@@ -41,6 +48,9 @@
 #define LTE_FDD_ENB_IND_HE_MAX_VALUE 31
 #define LTE_FDD_ENB_SEQ_HE_MAX_VALUE 0x07FFFFFFFFFFUL
 
+// Number of Milenage authentication vectors precomputed per UE
+#define HSS_AV_BATCH_SIZE 4
+
 namespace srsepc {
 
 struct hss_args_t {
@@ -51,6 +61,15 @@ struct hss_args_t {
 
 enum hss_auth_algo { HSS_ALGO_XOR, HSS_ALGO_MILENAGE };
 
+// EPS authentication vector, generated for a given SQN
+struct hss_auth_vector_t {
+  uint8_t sqn[6];
+  uint8_t rand[16];
+  uint8_t xres[8];
+  uint8_t autn[16];
+  uint8_t k_asme[32];
+};
+
 struct hss_ue_ctx_t {
   // Members
   std::string        name;
@@ -65,6 +84,11 @@ struct hss_ue_ctx_t {
   uint16_t           qci;
   uint8_t            last_rand[16];
   std::string        static_ip_addr;
+  uint32_t           db_idx;
+
+  // Milenage vectors precomputed for the next SQNs of the UE
+  srsran::static_circular_buffer<hss_auth_vector_t, HSS_AV_BATCH_SIZE> av_batch;
+  bool                                                                 av_batch_pending = false;
 
   // Helper getters/setters
   void set_sqn(const uint8_t* sqn_);
@@ -72,7 +96,7 @@ struct hss_ue_ctx_t {
   void get_last_rand(uint8_t* rand_);
 };
 
-class hss : public hss_interface_nas
+class hss : public hss_interface_nas, public srsran::thread
 {
 public:
   static hss* get_instance(void);
@@ -92,12 +116,22 @@ private:
   virtual ~hss();
   static hss* m_instance;
 
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> > m_imsi_to_ue_ctx;
+  srsran::flat_hash_map<uint64_t, std::unique_ptr<hss_ue_ctx_t> > m_imsi_to_ue_ctx;
+  hss_db                                                          m_db;
+
+  // Protects the SQNs and the precomputed vectors of the UEs, shared with the AV generation thread
+  std::mutex                    m_mutex;
+  std::atomic<bool>             m_running = {false};
+  srsran::block_queue<uint64_t> m_av_batch_queue;
+
+  void run_thread() override;
+  void fill_av_batch(hss_ue_ctx_t* ue_ctx);
 
   void gen_rand(uint8_t rand_[16]);
 
   void
        gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres);
+  void gen_auth_vector_milenage(hss_ue_ctx_t* ue_ctx, const uint8_t* sqn, hss_auth_vector_t* av);
   void gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres);
 
   void resync_sqn_milenage(hss_ue_ctx_t* ue_ctx, uint8_t* auts);
@@ -112,6 +146,8 @@ private:
   bool          set_auth_algo(std::string auth_algo);
   bool          read_db_file(std::string db_file);
   bool          write_db_file(std::string db_file);
+  bool          load_db_records();
+  bool          create_db(std::string db_bin_file, std::string db_file);
   hss_ue_ctx_t* get_ue_ctx(uint64_t imsi);
 
   std::string hex_string(uint8_t* hex, int size);
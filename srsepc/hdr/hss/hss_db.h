@@ -0,0 +1,113 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        hss_db.h
+ * Description: Binary subscriber database of the HSS. The records are
+ *              memory-mapped, so that loading them does not require any
+ *              parsing and SQN updates are written in place.
+ *****************************************************************************/
+
+#ifndef SRSEPC_HSS_DB_H
+#define SRSEPC_HSS_DB_H
+
+#include "srsran/srslog/srslog.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace srsepc {
+
+/// Subscriber record, as stored in the binary database file
+struct hss_db_record_t {
+  uint64_t imsi;
+  uint64_t sqn; ///< 48 bit SQN, stored in an aligned word so that it is updated with a single store
+  uint8_t  key[16];
+  uint8_t  op[16];
+  uint8_t  opc[16];
+  uint8_t  last_rand[16];
+  uint8_t  amf[2];
+  uint8_t  algo;
+  uint8_t  op_configured;
+  uint16_t qci;
+  uint16_t reserved;
+  uint32_t static_ip; ///< Static IPv4 address in network byte order, or 0 for dynamic allocation
+  char     name[64];
+};
+
+/**
+ * Memory-mapped array of subscriber records, generated from the CSV user database. The file header records the size
+ * and modification time of the CSV it was generated from, so that the CSV is only parsed again when it is edited.
+ * SQN updates are single aligned stores to the shared mapping, so an SQN in the file is never torn and survives a
+ * crash of the EPC. The file is only flushed to disk when it is closed.
+ */
+class hss_db
+{
+public:
+  hss_db() = default;
+  hss_db(const hss_db&) = delete;
+  hss_db& operator=(const hss_db&) = delete;
+  ~hss_db() { close(); }
+
+  /// Maps an existing database file. Fails if the file is invalid or was not generated from the current CSV file
+  bool open(const std::string& filename, const std::string& csv_filename);
+  /// Writes a new database file with the records imported from the CSV file, and maps it
+  bool create(const std::string& filename, const std::string& csv_filename, const std::vector<hss_db_record_t>& recs);
+  void close();
+
+  /// Marks the database as generated from the current version of the CSV file, e.g. after the HSS rewrote the CSV
+  bool set_source(const std::string& csv_filename);
+
+  bool                   is_open() const { return header != nullptr; }
+  size_t                 size() const { return is_open() ? header->nof_records : 0; }
+  const hss_db_record_t& operator[](size_t idx) const { return records[idx]; }
+
+  void store_sqn(uint32_t idx, const uint8_t* sqn);
+  void store_last_rand(uint32_t idx, const uint8_t* rand);
+
+  static uint64_t pack_sqn(const uint8_t* sqn);
+  static void     unpack_sqn(uint64_t sqn64, uint8_t* sqn);
+
+private:
+  struct file_header_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t reserved;
+    uint64_t nof_records;
+    uint64_t csv_size;
+    int64_t  csv_mtime_ns;
+  };
+  static const uint32_t file_magic   = 0x53484442; // "SHDB"
+  static const uint32_t file_version = 1;
+
+  static bool get_csv_stamp(const std::string& csv_filename, uint64_t* size, int64_t* mtime_ns);
+
+  srslog::basic_logger& logger   = srslog::fetch_basic_logger("HSS");
+  void*                 map_addr = nullptr;
+  size_t                map_len  = 0;
+  file_header_t*        header   = nullptr;
+  hss_db_record_t*      records  = nullptr;
+};
+
+} // namespace srsepc
+
+#endif // SRSEPC_HSS_DB_H
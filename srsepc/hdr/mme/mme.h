@@ -32,7 +32,10 @@
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/threads.h"
+#include "srsran/common/timers.h"
 #include <cstddef>
+#include <mutex>
+#include <unordered_map>
 
 namespace srsepc {
 
@@ -42,12 +45,6 @@ typedef struct {
   // gtpc_args_t gtpc_args;
 } mme_args_t;
 
-typedef struct {
-  int                 fd;
-  uint64_t            imsi;
-  enum nas_timer_type type;
-} mme_timer_t;
-
 class mme : public srsran::thread, public mme_interface_nas
 {
 public:
@@ -60,7 +57,7 @@ public:
   void run_thread();
 
   // Timer Methods
-  virtual bool add_nas_timer(int timer_fd, enum nas_timer_type type, uint64_t imsi);
+  virtual bool add_nas_timer(uint32_t timeout_ms, enum nas_timer_type type, uint64_t imsi);
   virtual bool is_nas_timer_running(enum nas_timer_type type, uint64_t imsi);
   virtual bool remove_nas_timer(enum nas_timer_type type, uint64_t imsi);
 
@@ -71,14 +68,22 @@ private:
   s1ap*       m_s1ap;
   mme_gtpc*   m_mme_gtpc;
 
-  bool   m_running;
-  fd_set m_set;
+  bool m_running;
+  int  m_epoll_fd = -1;
+  int  m_tick_fd  = -1;
+
+  // NAS timers. They run in a single timer wheel, stepped by a periodic timerfd that is only armed while there are
+  // running timers, and are looked up by IMSI and type. The NAS workers start and stop them under m_timers_mutex.
+  static const uint32_t                              nas_timer_tick_ms = 10;
+  std::mutex                                         m_timers_mutex;
+  srsran::timer_handler                              m_timers;
+  std::unordered_map<uint64_t, srsran::unique_timer> m_nas_timers;
 
-  // Timer map
-  std::vector<mme_timer_t> timers;
+  static uint64_t nas_timer_key(enum nas_timer_type type, uint64_t imsi) { return (imsi << 8U) | type; }
 
   // Timer Methods
-  void handle_timer_expire(int timer_fd);
+  bool arm_tick_timer(bool enable);
+  void handle_tick_timer();
 
   // Logs
   srslog::basic_logger& m_s1ap_logger = srslog::fetch_basic_logger("S1AP");
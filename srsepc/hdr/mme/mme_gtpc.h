@@ -22,8 +22,10 @@
 #define SRSEPC_MME_GTPC_H
 
 #include "nas.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
+#include <mutex>
 #include <sys/socket.h>
 #include <sys/un.h>
 
@@ -46,7 +48,8 @@ public:
 
   bool init();
   bool send_s11_pdu(const srsran::gtpc_pdu& pdu);
-  void handle_s11_pdu(srsran::byte_buffer_t* msg);
+  void handle_s11_pdu(srsran::unique_byte_buffer_t msg);
+  void process_s11_pdu(srsran::byte_buffer_t* msg);
 
   virtual bool send_create_session_request(uint64_t imsi);
   bool         handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu);
@@ -66,9 +69,11 @@ private:
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("MME GTPC");
   s1ap*                 m_s1ap;
 
-  uint32_t                            m_next_ctrl_teid;
-  std::map<uint32_t, uint64_t>        m_mme_ctr_teid_to_imsi;
-  std::map<uint64_t, struct gtpc_ctx> m_imsi_to_gtpc_ctx;
+  // Protects the GTP-C contexts, which are accessed by all NAS workers
+  std::mutex                                       m_mutex;
+  uint32_t                                         m_next_ctrl_teid;
+  srsran::flat_hash_map<uint32_t, uint64_t>        m_mme_ctr_teid_to_imsi;
+  srsran::flat_hash_map<uint64_t, struct gtpc_ctx> m_imsi_to_gtpc_ctx;
 
   int                m_s11;
   struct sockaddr_un m_mme_addr, m_spgw_addr;
@@ -158,6 +158,12 @@ public:
   nas(const nas_init_t& args, const nas_if_t& itf);
   void reset();
 
+  // NAS contexts are allocated from a slab pool, so that UE churn does not fragment the heap
+  void* operator new(size_t sz);
+  void* operator new[](size_t sz) = delete;
+  void  operator delete(void* ptr);
+  void  operator delete[](void* ptr) = delete;
+
   /***********************
    * Initial UE messages *
    ***********************/
@@ -264,6 +270,9 @@ public:
   esm_ctx_t m_esm_ctx[MAX_ERABS_PER_UE] = {};
   sec_ctx_t m_sec_ctx                   = {};
 
+  // NAS worker that processes the messages of the UE. It is fixed for the lifetime of the context
+  uint32_t m_worker_idx = 0;
+
 private:
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("NAS");
   gtpc_interface_nas*   m_gtpc   = nullptr;
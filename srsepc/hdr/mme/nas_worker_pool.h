@@ -0,0 +1,70 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#ifndef SRSEPC_NAS_WORKER_POOL_H
+#define SRSEPC_NAS_WORKER_POOL_H
+
+#include "srsran/adt/move_callback.h"
+#include "srsran/common/thread_pool.h"
+#include <memory>
+#include <vector>
+
+namespace srsepc {
+
+/**
+ * Pool of workers that run the S1AP/NAS procedures of the UEs. The UEs are partitioned among the workers, so that the
+ * messages of a UE are always processed in order by the same worker, while different UEs are processed in parallel.
+ * The UE contexts remember the worker they were created in, and the tasks of a UE are always pushed to that worker.
+ * When the pool has no workers, the tasks run inline in the caller (i.e. the MME thread), as before.
+ */
+class nas_worker_pool
+{
+public:
+  using task_t = srsran::move_callback<void(), srsran::default_move_callback_buffer_size, true>;
+
+  static const uint32_t default_queue_size = 4096;
+
+  nas_worker_pool() = default;
+  ~nas_worker_pool() { stop(); }
+  nas_worker_pool(const nas_worker_pool&) = delete;
+  nas_worker_pool& operator=(const nas_worker_pool&) = delete;
+
+  void start(uint32_t nof_workers, uint32_t queue_size = default_queue_size);
+  void stop();
+
+  bool     enabled() const { return not workers.empty(); }
+  uint32_t nof_workers() const { return workers.size(); }
+
+  /// Worker of a UE that doesn't have a context yet, given a key that identifies it (e.g. the IMSI)
+  uint32_t select_worker(uint64_t ue_key) const;
+
+  /// Runs the task in the given worker, or inline if the pool has no workers
+  void push_task(uint32_t worker_idx, task_t task);
+
+  /// Index of the worker the caller runs in. Returns 0 when called from outside the pool
+  static uint32_t current_worker();
+
+private:
+  std::vector<std::unique_ptr<srsran::task_worker> > workers;
+};
+
+} // namespace srsepc
+
+#endif // SRSEPC_NAS_WORKER_POOL_H
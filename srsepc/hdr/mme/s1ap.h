@@ -23,12 +23,14 @@
 
 #include "mme_gtpc.h"
 #include "nas.h"
+#include "nas_worker_pool.h"
 #include "s1ap_ctx_mngmt_proc.h"
 #include "s1ap_erab_mngmt_proc.h"
 #include "s1ap_mngmt_proc.h"
 #include "s1ap_nas_transport.h"
 #include "s1ap_paging.h"
 #include "srsepc/hdr/hss/hss.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/asn1/s1ap.h"
@@ -38,7 +40,9 @@
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <arpa/inet.h>
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <netinet/sctp.h>
 #include <set>
 #include <strings.h>
@@ -67,7 +71,12 @@ public:
   void delete_enb_ctx(int32_t assoc_id);
 
   bool s1ap_tx_pdu(const s1ap_pdu_t& pdu, struct sctp_sndrcvinfo* enb_sri);
-  void handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri);
+  void handle_s1ap_rx_pdu(srsran::unique_byte_buffer_t pdu, const struct sctp_sndrcvinfo& enb_sri);
+  void process_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri);
+  bool filter_s1ap_rx_pdu(const asn1::ap_pdu_index& index);
+  bool get_s1ap_rx_pdu_worker(const asn1::ap_pdu_index&     index,
+                              const struct sctp_sndrcvinfo& enb_sri,
+                              uint32_t&                     worker_idx);
   void handle_initiating_message(const asn1::s1ap::init_msg_s& msg, struct sctp_sndrcvinfo* enb_sri);
   void handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg);
 
@@ -91,8 +100,15 @@ public:
 
   bool         release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id);
   void         release_ues_ecm_ctx_in_enb(int32_t enb_assoc);
+  void         release_enb_ue_ecm_ctx(uint32_t mme_ue_s1ap_id);
   virtual bool delete_ue_ctx(uint64_t imsi);
 
+  // NAS workers
+  uint32_t get_ue_worker_from_imsi(uint64_t imsi);
+  uint32_t get_ue_worker_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id);
+  void     push_ue_task(uint64_t imsi, nas_worker_pool::task_t task);
+  bool     is_ue_in_current_worker(uint64_t imsi);
+
   uint32_t         allocate_m_tmsi(uint64_t imsi);
   virtual uint64_t find_imsi_from_m_tmsi(uint32_t m_tmsi);
 
@@ -105,8 +121,12 @@ public:
   s1ap_erab_mngmt_proc* m_s1ap_erab_mngmt_proc;
   s1ap_paging*          m_s1ap_paging;
 
-  std::map<uint32_t, uint64_t>   m_tmsi_to_imsi;
-  std::map<uint16_t, enb_ctx_t*> m_active_enbs;
+  srsran::flat_hash_map<uint32_t, uint64_t> m_tmsi_to_imsi;
+  std::map<uint16_t, enb_ctx_t*>            m_active_enbs;
+
+  // The eNB contexts are protected by m_enb_mutex, and the UE maps by m_ue_mutex. When both are needed, m_ue_mutex
+  // is locked first.
+  std::mutex m_enb_mutex;
 
   // Interfaces
   virtual bool send_initial_context_setup_request(uint64_t imsi, uint16_t erab_to_setup);
@@ -141,17 +161,23 @@ private:
   std::map<int32_t, uint16_t>            m_sctp_to_enb_id;
   std::map<int32_t, std::set<uint32_t> > m_enb_assoc_to_ue_ids;
 
-  std::map<uint64_t, nas*> m_imsi_to_nas_ctx;
-  std::map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
+  // UE contexts, indexed by IMSI and MME UE S1AP Id
+  std::mutex                            m_ue_mutex;
+  srsran::flat_hash_map<uint64_t, nas*> m_imsi_to_nas_ctx;
+  srsran::flat_hash_map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
+
+  std::atomic<uint32_t> m_next_mme_ue_s1ap_id;
+  uint32_t              m_next_m_tmsi;
 
-  uint32_t m_next_mme_ue_s1ap_id;
-  uint32_t m_next_m_tmsi;
+  // Workers that run the procedures of the UEs. The contexts of a UE are only accessed by its worker.
+  nas_worker_pool m_nas_workers;
 
   // GTP-C Interface
   mme_gtpc* m_mme_gtpc;
 
   // PCAP
   bool              m_pcap_enable;
+  std::mutex        m_pcap_mutex;
   srsran::s1ap_pcap m_pcap;
 };
 
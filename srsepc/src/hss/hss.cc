@@ -34,7 +34,7 @@ namespace srsepc {
 hss*            hss::m_instance    = NULL;
 pthread_mutex_t hss_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-hss::hss()
+hss::hss() : thread("HSS")
 {
   return;
 }
@@ -68,17 +68,39 @@ int hss::init(hss_args_t* hss_args)
 {
   srand(time(NULL));
 
-  /*Read user information from DB*/
-  if (read_db_file(hss_args->db_file) == false) {
-    srsran::console("Error reading user database file %s\n", hss_args->db_file.c_str());
-    return -1;
-  }
-
   mcc = hss_args->mcc;
   mnc = hss_args->mnc;
 
   db_file = hss_args->db_file;
 
+  /*Read user information from DB. The CSV is only parsed if it changed since the binary DB was generated*/
+  std::string db_bin_file = hss_args->db_file + ".bin";
+  if (m_db.open(db_bin_file, hss_args->db_file)) {
+    if (load_db_records() == false) {
+      srsran::console("Error reading user database file %s\n", db_bin_file.c_str());
+      return -1;
+    }
+  } else {
+    if (read_db_file(hss_args->db_file) == false) {
+      srsran::console("Error reading user database file %s\n", hss_args->db_file.c_str());
+      return -1;
+    }
+    if (create_db(db_bin_file, hss_args->db_file) == false) {
+      srsran::console("Could not create binary user database file %s. SQNs will only be saved on exit.\n",
+                      db_bin_file.c_str());
+    }
+  }
+
+  // Precompute the authentication vectors of the Milenage UEs in the background
+  m_running = true;
+  start();
+  for (const auto& ue_ctx_it : m_imsi_to_ue_ctx) {
+    if (ue_ctx_it.second->algo == HSS_ALGO_MILENAGE) {
+      ue_ctx_it.second->av_batch_pending = true;
+      m_av_batch_queue.push(ue_ctx_it.first);
+    }
+  }
+
   m_logger.info("HSS Initialized. DB file %s, MCC: %d, MNC: %d", hss_args->db_file.c_str(), mcc, mnc);
   srsran::console("HSS Initialized.\n");
   return 0;
@@ -86,10 +108,32 @@ int hss::init(hss_args_t* hss_args)
 
 void hss::stop()
 {
-  write_db_file(db_file);
+  if (m_running) {
+    m_running = false;
+    m_av_batch_queue.push(0);
+    wait_thread_finish();
+  }
+  if (write_db_file(db_file)) {
+    m_db.set_source(db_file);
+  }
+  m_db.close();
   return;
 }
 
+void hss::run_thread()
+{
+  while (m_running) {
+    uint64_t imsi = m_av_batch_queue.wait_pop();
+    if (not m_running) {
+      break;
+    }
+    hss_ue_ctx_t* ue_ctx = get_ue_ctx(imsi);
+    if (ue_ctx != nullptr) {
+      fill_av_batch(ue_ctx);
+    }
+  }
+}
+
 bool hss::read_db_file(std::string db_filename)
 {
   std::ifstream m_db_file;
@@ -168,6 +212,7 @@ bool hss::read_db_file(std::string db_filename)
           return false;
         }
       }
+      ue_ctx->db_idx = m_imsi_to_ue_ctx.size();
       m_imsi_to_ue_ctx.insert(std::make_pair(ue_ctx->imsi, std::move(ue_ctx)));
     }
   }
@@ -216,37 +261,40 @@ bool hss::write_db_file(std::string db_filename)
             << "#                                                                                           \n"
             << "# Note: Lines starting by '#' are ignored and will be overwritten                           \n";
 
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator it = m_imsi_to_ue_ctx.begin();
-  while (it != m_imsi_to_ue_ctx.end()) {
-    m_db_file << it->second->name;
+  // Keep the order of the users in the DB
+  std::vector<hss_ue_ctx_t*> ue_ctxs(m_imsi_to_ue_ctx.size());
+  for (const auto& ue_ctx_it : m_imsi_to_ue_ctx) {
+    ue_ctxs[ue_ctx_it.second->db_idx] = ue_ctx_it.second.get();
+  }
+  for (hss_ue_ctx_t* ue_ctx : ue_ctxs) {
+    m_db_file << ue_ctx->name;
     m_db_file << ",";
-    m_db_file << (it->second->algo == HSS_ALGO_XOR ? "xor" : "mil");
+    m_db_file << (ue_ctx->algo == HSS_ALGO_XOR ? "xor" : "mil");
     m_db_file << ",";
-    m_db_file << std::setfill('0') << std::setw(15) << it->second->imsi;
+    m_db_file << std::setfill('0') << std::setw(15) << ue_ctx->imsi;
     m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->key, 16);
+    m_db_file << srsran::hex_string(ue_ctx->key, 16);
     m_db_file << ",";
-    if (it->second->op_configured) {
+    if (ue_ctx->op_configured) {
       m_db_file << "op,";
-      m_db_file << srsran::hex_string(it->second->op, 16);
+      m_db_file << srsran::hex_string(ue_ctx->op, 16);
     } else {
       m_db_file << "opc,";
-      m_db_file << srsran::hex_string(it->second->opc, 16);
+      m_db_file << srsran::hex_string(ue_ctx->opc, 16);
     }
     m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->amf, 2);
+    m_db_file << srsran::hex_string(ue_ctx->amf, 2);
     m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->sqn, 6);
+    m_db_file << srsran::hex_string(ue_ctx->sqn, 6);
     m_db_file << ",";
-    m_db_file << it->second->qci;
-    if (it->second->static_ip_addr != "0.0.0.0") {
+    m_db_file << ue_ctx->qci;
+    if (ue_ctx->static_ip_addr != "0.0.0.0") {
       m_db_file << ",";
-      m_db_file << it->second->static_ip_addr;
+      m_db_file << ue_ctx->static_ip_addr;
     } else {
       m_db_file << ",dynamic";
     }
     m_db_file << std::endl;
-    it++;
   }
   if (m_db_file.is_open()) {
     m_db_file.close();
@@ -254,6 +302,72 @@ bool hss::write_db_file(std::string db_filename)
   return true;
 }
 
+bool hss::load_db_records()
+{
+  m_imsi_to_ue_ctx.reserve(m_db.size());
+  for (uint32_t i = 0; i < m_db.size(); i++) {
+    const hss_db_record_t&        rec    = m_db[i];
+    std::unique_ptr<hss_ue_ctx_t> ue_ctx = std::unique_ptr<hss_ue_ctx_t>(new hss_ue_ctx_t);
+    ue_ctx->name                         = std::string(rec.name, strnlen(rec.name, sizeof(rec.name)));
+    ue_ctx->imsi                         = rec.imsi;
+    ue_ctx->algo                         = rec.algo == HSS_ALGO_XOR ? HSS_ALGO_XOR : HSS_ALGO_MILENAGE;
+    ue_ctx->op_configured                = rec.op_configured;
+    ue_ctx->qci                          = rec.qci;
+    ue_ctx->db_idx                       = i;
+    memcpy(ue_ctx->key, rec.key, 16);
+    memcpy(ue_ctx->op, rec.op, 16);
+    memcpy(ue_ctx->opc, rec.opc, 16);
+    memcpy(ue_ctx->amf, rec.amf, 2);
+    memcpy(ue_ctx->last_rand, rec.last_rand, 16);
+    hss_db::unpack_sqn(rec.sqn, ue_ctx->sqn);
+
+    if (rec.static_ip == 0) {
+      ue_ctx->static_ip_addr = "0.0.0.0";
+    } else {
+      char ip_str[INET_ADDRSTRLEN] = {};
+      inet_ntop(AF_INET, &rec.static_ip, ip_str, sizeof(ip_str));
+      if (not m_ip_to_imsi.insert(std::make_pair(std::string(ip_str), ue_ctx->imsi)).second) {
+        m_logger.info("duplicate static ip addr %s", ip_str);
+        return false;
+      }
+      ue_ctx->static_ip_addr = ip_str;
+    }
+    if (not m_imsi_to_ue_ctx.insert(std::make_pair(ue_ctx->imsi, std::move(ue_ctx))).second) {
+      m_logger.error("Duplicate IMSI %015" PRIu64 " in binary user DB", rec.imsi);
+      return false;
+    }
+  }
+  m_logger.info("Loaded %zd users from binary user DB", m_imsi_to_ue_ctx.size());
+  return true;
+}
+
+bool hss::create_db(std::string db_bin_file, std::string db_file)
+{
+  std::vector<hss_db_record_t> records(m_imsi_to_ue_ctx.size());
+  for (const auto& ue_ctx_it : m_imsi_to_ue_ctx) {
+    const hss_ue_ctx_t* ue_ctx = ue_ctx_it.second.get();
+    hss_db_record_t&    rec    = records[ue_ctx->db_idx];
+    rec                        = {};
+    rec.imsi                   = ue_ctx->imsi;
+    rec.sqn                    = hss_db::pack_sqn(ue_ctx->sqn);
+    rec.algo                   = ue_ctx->algo;
+    rec.op_configured          = ue_ctx->op_configured;
+    rec.qci                    = ue_ctx->qci;
+    memcpy(rec.key, ue_ctx->key, 16);
+    memcpy(rec.op, ue_ctx->op, 16);
+    memcpy(rec.opc, ue_ctx->opc, 16);
+    memcpy(rec.amf, ue_ctx->amf, 2);
+    if (ue_ctx->static_ip_addr != "0.0.0.0") {
+      inet_pton(AF_INET, ue_ctx->static_ip_addr.c_str(), &rec.static_ip);
+    }
+    if (ue_ctx->name.size() >= sizeof(rec.name)) {
+      m_logger.warning("Name of IMSI %015" PRIu64 " truncated in binary user DB", ue_ctx->imsi);
+    }
+    strncpy(rec.name, ue_ctx->name.c_str(), sizeof(rec.name) - 1);
+  }
+  return m_db.create(db_bin_file, db_file, records);
+}
+
 bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
 {
 
@@ -265,6 +379,7 @@ bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, ui
     return false;
   }
 
+  std::lock_guard<std::mutex> lock(m_mutex);
   switch (ue_ctx->algo) {
     case HSS_ALGO_XOR:
       gen_auth_info_answer_xor(ue_ctx, k_asme, autn, rand, xres);
@@ -274,6 +389,8 @@ bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, ui
       break;
   }
   increment_ue_sqn(ue_ctx);
+  m_db.store_sqn(ue_ctx->db_idx, ue_ctx->sqn);
+  m_db.store_last_rand(ue_ctx->db_idx, ue_ctx->last_rand);
   return true;
 }
 
@@ -282,12 +399,84 @@ void hss::gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx,
                                         uint8_t*      autn,
                                         uint8_t*      rand,
                                         uint8_t*      xres)
+{
+  // Use the precomputed vector of the current SQN, if there is one
+  hss_auth_vector_t av;
+  if (not ue_ctx->av_batch.empty() and memcmp(ue_ctx->av_batch.top().sqn, ue_ctx->sqn, 6) == 0) {
+    av = ue_ctx->av_batch.top();
+    ue_ctx->av_batch.pop();
+    m_logger.debug("Using precomputed authentication vector -- IMSI: %015" PRIu64 "", ue_ctx->imsi);
+  } else {
+    ue_ctx->av_batch.clear();
+    gen_auth_vector_milenage(ue_ctx, ue_ctx->sqn, &av);
+  }
+  memcpy(k_asme, av.k_asme, 32);
+  memcpy(autn, av.autn, 16);
+  memcpy(rand, av.rand, 16);
+  memcpy(xres, av.xres, 8);
+
+  // Refill the batch in the background once it runs low
+  if (ue_ctx->av_batch.size() <= HSS_AV_BATCH_SIZE / 2 and not ue_ctx->av_batch_pending and m_running) {
+    ue_ctx->av_batch_pending = true;
+    m_av_batch_queue.push(ue_ctx->imsi);
+  }
+
+  // Set last RAND
+  ue_ctx->set_last_rand(rand);
+}
+
+void hss::fill_av_batch(hss_ue_ctx_t* ue_ctx)
+{
+  uint8_t sqn[6];
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ue_ctx->av_batch_pending = false;
+  }
+  while (m_running) {
+    // The next vector of the batch is the one of the SQN that follows the last precomputed vector
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (ue_ctx->av_batch.full()) {
+        return;
+      }
+      if (ue_ctx->av_batch.empty()) {
+        memcpy(sqn, ue_ctx->sqn, 6);
+      } else {
+        increment_sqn(ue_ctx->av_batch[ue_ctx->av_batch.size() - 1].sqn, sqn);
+      }
+    }
+
+    hss_auth_vector_t av;
+    gen_auth_vector_milenage(ue_ctx, sqn, &av);
+
+    // Discard the vector if the SQN of the UE changed meanwhile, e.g. after a resynchronization
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint8_t                     next_sqn[6];
+    if (ue_ctx->av_batch.empty()) {
+      memcpy(next_sqn, ue_ctx->sqn, 6);
+    } else {
+      increment_sqn(ue_ctx->av_batch[ue_ctx->av_batch.size() - 1].sqn, next_sqn);
+    }
+    if (memcmp(next_sqn, sqn, 6) == 0) {
+      ue_ctx->av_batch.push(av);
+    }
+  }
+}
+
+void hss::gen_auth_vector_milenage(hss_ue_ctx_t* ue_ctx, const uint8_t* sqn_, hss_auth_vector_t* av)
 {
   // Get K, AMF, OPC and SQN
   uint8_t* k   = ue_ctx->key;
   uint8_t* amf = ue_ctx->amf;
   uint8_t* opc = ue_ctx->opc;
-  uint8_t* sqn = ue_ctx->sqn;
+  uint8_t* sqn = av->sqn;
+  memcpy(sqn, sqn_, 6);
+
+  // Outputs
+  uint8_t* rand   = av->rand;
+  uint8_t* xres   = av->xres;
+  uint8_t* autn   = av->autn;
+  uint8_t* k_asme = av->k_asme;
 
   // Temp variables
   uint8_t ck[16];
@@ -333,9 +522,6 @@ void hss::gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx,
     autn[8 + i] = mac[i];
   }
   m_logger.debug(autn, 16, "User AUTN: ");
-
-  // Set last RAND
-  ue_ctx->set_last_rand(rand);
   return;
 }
 
@@ -440,7 +626,7 @@ void hss::gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_
 
 bool hss::gen_update_loc_answer(uint64_t imsi, uint8_t* qci)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
+  srsran::flat_hash_map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
   if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
     srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", imsi);
@@ -462,6 +648,7 @@ bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
     return false;
   }
 
+  std::lock_guard<std::mutex> lock(m_mutex);
   switch (ue_ctx->algo) {
     case HSS_ALGO_XOR:
       resync_sqn_xor(ue_ctx, auts);
@@ -472,6 +659,7 @@ bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
   }
 
   increment_seq_after_resync(ue_ctx);
+  m_db.store_sqn(ue_ctx->db_idx, ue_ctx->sqn);
   return true;
 }
 
@@ -612,7 +800,7 @@ void hss::gen_rand(uint8_t rand_[16])
 
 hss_ue_ctx_t* hss::get_ue_ctx(uint64_t imsi)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
+  srsran::flat_hash_map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
   if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
     return nullptr;
@@ -0,0 +1,179 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsepc/hdr/hss/hss_db.h"
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace srsepc {
+
+bool hss_db::open(const std::string& filename, const std::string& csv_filename)
+{
+  close();
+
+  int fd = ::open(filename.c_str(), O_RDWR);
+  if (fd < 0) {
+    logger.info("Could not open binary user DB file %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+  struct stat st = {};
+  if (fstat(fd, &st) < 0 or (size_t)st.st_size < sizeof(file_header_t)) {
+    logger.warning("Invalid binary user DB file %s", filename.c_str());
+    ::close(fd);
+    return false;
+  }
+  void* addr = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    logger.error("Could not map binary user DB file %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+  map_addr = addr;
+  map_len  = st.st_size;
+
+  file_header_t* hdr = static_cast<file_header_t*>(map_addr);
+  if (hdr->magic != file_magic or hdr->version != file_version or hdr->record_size != sizeof(hss_db_record_t) or
+      map_len != sizeof(file_header_t) + hdr->nof_records * sizeof(hss_db_record_t)) {
+    logger.warning("Invalid binary user DB file %s", filename.c_str());
+    close();
+    return false;
+  }
+
+  uint64_t csv_size     = 0;
+  int64_t  csv_mtime_ns = 0;
+  if (not get_csv_stamp(csv_filename, &csv_size, &csv_mtime_ns) or csv_size != hdr->csv_size or
+      csv_mtime_ns != hdr->csv_mtime_ns) {
+    logger.info("Binary user DB file %s is out of date with %s", filename.c_str(), csv_filename.c_str());
+    close();
+    return false;
+  }
+
+  header  = hdr;
+  records = reinterpret_cast<hss_db_record_t*>(static_cast<uint8_t*>(map_addr) + sizeof(file_header_t));
+  logger.info("Mapped binary user DB file %s with %" PRIu64 " users", filename.c_str(), header->nof_records);
+  return true;
+}
+
+bool hss_db::create(const std::string&                  filename,
+                    const std::string&                  csv_filename,
+                    const std::vector<hss_db_record_t>& recs)
+{
+  close();
+
+  file_header_t hdr = {};
+  hdr.magic         = file_magic;
+  hdr.version       = file_version;
+  hdr.record_size   = sizeof(hss_db_record_t);
+  hdr.nof_records   = recs.size();
+  if (not get_csv_stamp(csv_filename, &hdr.csv_size, &hdr.csv_mtime_ns)) {
+    return false;
+  }
+
+  // Write the new file aside and rename it, so that a crash never leaves a partially written database behind
+  std::string tmp_filename = filename + ".tmp";
+  FILE*       f            = fopen(tmp_filename.c_str(), "wb");
+  if (f == nullptr) {
+    logger.error("Could not create binary user DB file %s: %s", tmp_filename.c_str(), strerror(errno));
+    return false;
+  }
+  bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+  if (ok and not recs.empty()) {
+    ok = fwrite(recs.data(), sizeof(hss_db_record_t), recs.size(), f) == recs.size();
+  }
+  ok = fflush(f) == 0 and ok;
+  ok = fsync(fileno(f)) == 0 and ok;
+  ok = fclose(f) == 0 and ok;
+  if (not ok or rename(tmp_filename.c_str(), filename.c_str()) < 0) {
+    logger.error("Could not write binary user DB file %s: %s", filename.c_str(), strerror(errno));
+    unlink(tmp_filename.c_str());
+    return false;
+  }
+
+  return open(filename, csv_filename);
+}
+
+void hss_db::close()
+{
+  if (map_addr != nullptr) {
+    msync(map_addr, map_len, MS_SYNC);
+    munmap(map_addr, map_len);
+  }
+  map_addr = nullptr;
+  map_len  = 0;
+  header   = nullptr;
+  records  = nullptr;
+}
+
+bool hss_db::set_source(const std::string& csv_filename)
+{
+  if (not is_open() or not get_csv_stamp(csv_filename, &header->csv_size, &header->csv_mtime_ns)) {
+    return false;
+  }
+  return msync(map_addr, sizeof(file_header_t), MS_SYNC) == 0;
+}
+
+void hss_db::store_sqn(uint32_t idx, const uint8_t* sqn)
+{
+  if (is_open()) {
+    __atomic_store_n(&records[idx].sqn, pack_sqn(sqn), __ATOMIC_RELAXED);
+  }
+}
+
+void hss_db::store_last_rand(uint32_t idx, const uint8_t* rand)
+{
+  if (is_open()) {
+    memcpy(records[idx].last_rand, rand, sizeof(records[idx].last_rand));
+  }
+}
+
+uint64_t hss_db::pack_sqn(const uint8_t* sqn)
+{
+  uint64_t sqn64 = 0;
+  for (int i = 0; i < 6; i++) {
+    sqn64 |= (uint64_t)sqn[i] << (5 - i) * 8;
+  }
+  return sqn64;
+}
+
+void hss_db::unpack_sqn(uint64_t sqn64, uint8_t* sqn)
+{
+  for (int i = 0; i < 6; i++) {
+    sqn[i] = (sqn64 >> (5 - i) * 8) & 0xFF;
+  }
+}
+
+bool hss_db::get_csv_stamp(const std::string& csv_filename, uint64_t* size, int64_t* mtime_ns)
+{
+  struct stat st = {};
+  if (stat(csv_filename.c_str(), &st) < 0) {
+    return false;
+  }
+  *size     = st.st_size;
+  *mtime_ns = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+  return true;
+}
+
+} // namespace srsepc
@@ -87,6 +87,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string   integrity_algo;
   uint16_t paging_timer     = 0;
   uint32_t max_paging_queue = 0;
+  uint32_t nas_workers      = 0;
   string   spgw_bind_addr;
   string   sgi_if_addr;
   string   sgi_if_name;
@@ -126,6 +127,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("mme.paging_timer",    bpo::value<uint16_t>(&paging_timer)->default_value(2),           "Set paging timer value in seconds (T3413)")
     ("mme.request_imeisv",  bpo::value<bool>(&request_imeisv)->default_value(false),         "Enable IMEISV request in Security mode command")
     ("mme.lac",             bpo::value<string>(&lac)->default_value("0x01"),                 "Location Area Code")
+    ("mme.nas_workers",     bpo::value<uint32_t>(&nas_workers)->default_value(0),            "Number of NAS worker threads (0 to run the NAS procedures in the MME thread)")
     ("hss.db_file",         bpo::value<string>(&hss_db_file)->default_value("ue_db.csv"),    ".csv file that stores UE's keys")
     ("spgw.gtpu_bind_addr", bpo::value<string>(&spgw_bind_addr)->default_value("127.0.0.1"), "IP address of SP-GW for the S1-U connection")
     ("spgw.sgi_if_addr",    bpo::value<string>(&sgi_if_addr)->default_value("176.16.0.1"),   "IP address of TUN interface for the SGi connection")
@@ -283,6 +285,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   args->mme_args.s1ap_args.mme_apn        = mme_apn;
   args->mme_args.s1ap_args.paging_timer   = paging_timer;
   args->mme_args.s1ap_args.request_imeisv = request_imeisv;
+  args->mme_args.s1ap_args.nof_nas_workers = nas_workers;
   args->spgw_args.gtpu_bind_addr          = spgw_bind_addr;
   args->spgw_args.sgi_if_addr             = sgi_if_addr;
   args->spgw_args.sgi_if_name             = sgi_if_name;
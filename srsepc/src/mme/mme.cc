@@ -20,6 +20,7 @@
  */
 
 #include "srsepc/hdr/mme/mme.h"
+#include "srsran/common/epoll_helper.h"
 #include <arpa/inet.h>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
@@ -86,23 +87,20 @@ int mme::init(mme_args_t* args)
 void mme::stop()
 {
   if (m_running) {
-    m_s1ap->stop();
-    m_s1ap->cleanup();
+    // Stop receiving first, so that no more tasks are pushed to the NAS workers while S1AP is stopped
     m_running = false;
     thread_cancel();
     wait_thread_finish();
+    m_s1ap->stop();
+    m_s1ap->cleanup();
   }
   return;
 }
 
 void mme::run_thread()
 {
-  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer("mme::run_thread");
-  if (pdu == nullptr) {
-    m_s1ap_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-    return;
-  }
-  uint32_t                     sz  = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  srsran::unique_byte_buffer_t pdu;
+  uint32_t                     sz = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
 
   struct sockaddr_in     enb_addr;
   struct sctp_sndrcvinfo sri;
@@ -118,28 +116,39 @@ void mme::run_thread()
   int s1mme = m_s1ap->get_s1_mme();
   int s11   = m_mme_gtpc->get_s11();
 
-  while (m_running) {
-    pdu->clear();
-    int max_fd = std::max(s1mme, s11);
-
-    FD_ZERO(&m_set);
-    FD_SET(s1mme, &m_set);
-    FD_SET(s11, &m_set);
-
-    // Add timers to select
-    for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end(); ++it) {
-      FD_SET(it->fd, &m_set);
-      max_fd = std::max(max_fd, it->fd);
-      m_s1ap_logger.debug("Adding Timer fd %d to fd_set", it->fd);
-    }
+  // The sockets and the tick of the NAS timers are the only fds, regardless of the number of UEs or timers
+  m_epoll_fd = epoll_create1(0);
+  m_tick_fd  = timerfd_create(CLOCK_MONOTONIC, 0);
+  if (m_epoll_fd == -1 or m_tick_fd == -1 or add_epoll(s1mme, m_epoll_fd) != SRSRAN_SUCCESS or
+      add_epoll(s11, m_epoll_fd) != SRSRAN_SUCCESS or add_epoll(m_tick_fd, m_epoll_fd) != SRSRAN_SUCCESS) {
+    m_s1ap_logger.error("Error creating MME epoll: %s", strerror(errno));
+    m_running = false;
+    return;
+  }
 
+  std::array<epoll_event, 16> events;
+  while (m_running) {
     m_s1ap_logger.debug("Waiting for S1-MME or S11 Message");
-    int n = select(max_fd + 1, &m_set, NULL, NULL, NULL);
+    int n = epoll_wait(m_epoll_fd, events.data(), events.size(), -1);
     if (n == -1) {
-      m_s1ap_logger.error("Error from select");
-    } else if (n) {
+      if (errno != EINTR) {
+        m_s1ap_logger.error("Error from epoll_wait: %s", strerror(errno));
+      }
+      continue;
+    }
+    for (int i = 0; i < n; ++i) {
+      int fd = events[i].data.fd;
+      // Received PDUs are handed over to the NAS workers, so a new buffer is needed for each of them
+      if (pdu == nullptr) {
+        pdu = srsran::make_byte_buffer("mme::run_thread");
+        if (pdu == nullptr) {
+          m_s1ap_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+          continue;
+        }
+      }
+      pdu->clear();
       // Handle S1-MME
-      if (FD_ISSET(s1mme, &m_set)) {
+      if (fd == s1mme) {
         rd_sz = sctp_recvmsg(s1mme, pdu->msg, sz, (struct sockaddr*)&enb_addr, &fromlen, &sri, &msg_flags);
         if (rd_sz == -1 && errno != EAGAIN) {
           m_s1ap_logger.error("Error reading from SCTP socket: %s", strerror(errno));
@@ -159,80 +168,116 @@ void mme::run_thread()
             // Received data
             pdu->N_bytes = rd_sz;
             m_s1ap_logger.info("Received S1AP msg. Size: %d", pdu->N_bytes);
-            m_s1ap->handle_s1ap_rx_pdu(pdu.get(), &sri);
+            m_s1ap->handle_s1ap_rx_pdu(std::move(pdu), sri);
           }
         }
       }
       // Handle S11
-      if (FD_ISSET(s11, &m_set)) {
-        pdu->N_bytes = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
-        m_mme_gtpc->handle_s11_pdu(pdu.get());
+      else if (fd == s11) {
+        rd_sz = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
+        if (rd_sz > 0) {
+          pdu->N_bytes = rd_sz;
+          m_mme_gtpc->handle_s11_pdu(std::move(pdu));
+        }
       }
       // Handle NAS Timers
-      for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end();) {
-        if (FD_ISSET(it->fd, &m_set)) {
-          m_s1ap_logger.info("Timer expired");
-          uint64_t exp;
-          rd_sz = read(it->fd, &exp, sizeof(uint64_t));
-          m_s1ap->expire_nas_timer(it->type, it->imsi);
-          close(it->fd);
-          timers.erase(it);
-        } else {
-          ++it;
-        }
+      else if (fd == m_tick_fd) {
+        handle_tick_timer();
       }
-    } else {
-      m_s1ap_logger.debug("No data from select.");
     }
   }
+
+  close(m_tick_fd);
+  close(m_epoll_fd);
+  m_tick_fd  = -1;
+  m_epoll_fd = -1;
   return;
 }
 
 /*
  * Timer Handling
  */
-bool mme::add_nas_timer(int timer_fd, nas_timer_type type, uint64_t imsi)
+bool mme::arm_tick_timer(bool enable)
+{
+  struct itimerspec t_value = {};
+  if (enable) {
+    t_value.it_value.tv_nsec    = nas_timer_tick_ms * 1000000;
+    t_value.it_interval.tv_nsec = nas_timer_tick_ms * 1000000;
+  }
+  if (timerfd_settime(m_tick_fd, 0, &t_value, NULL) == -1) {
+    m_s1ap_logger.error("Could not set NAS timer tick. %s", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+void mme::handle_tick_timer()
 {
-  m_s1ap_logger.debug("Adding NAS timer to MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, timer_fd);
+  uint64_t nof_ticks = 0;
+  if (read(m_tick_fd, &nof_ticks, sizeof(nof_ticks)) != sizeof(nof_ticks)) {
+    return;
+  }
+  // Ticks missed while the MME was busy are caught up in one go
+  for (uint64_t i = 0; i < nof_ticks; ++i) {
+    m_timers.step_all();
+  }
+  std::lock_guard<std::mutex> lock(m_timers_mutex);
+  if (m_timers.nof_running_timers() == 0) {
+    arm_tick_timer(false);
+  }
+}
 
-  mme_timer_t timer;
-  timer.fd   = timer_fd;
-  timer.type = type;
-  timer.imsi = imsi;
+bool mme::add_nas_timer(uint32_t timeout_ms, nas_timer_type type, uint64_t imsi)
+{
+  m_s1ap_logger.debug("Adding NAS timer to MME. IMSI %" PRIu64 ", Type %d, Timeout: %d ms", imsi, type, timeout_ms);
 
-  timers.push_back(timer);
+  std::lock_guard<std::mutex> lock(m_timers_mutex);
+  if (m_timers.nof_running_timers() == 0 and not arm_tick_timer(true)) {
+    return false;
+  }
+
+  // Restarting a timer that is still running just replaces it
+  srsran::unique_timer& timer = m_nas_timers[nas_timer_key(type, imsi)];
+  if (not timer.is_valid()) {
+    timer = m_timers.get_unique_timer();
+  }
+  uint32_t nof_ticks = (timeout_ms + nas_timer_tick_ms - 1) / nas_timer_tick_ms;
+  timer.set(nof_ticks, [this, type, imsi](uint32_t tid) {
+    std::unique_lock<std::mutex> lock(m_timers_mutex);
+    auto                         it = m_nas_timers.find(nas_timer_key(type, imsi));
+    if (it == m_nas_timers.end() or it->second.id() != tid) {
+      return;
+    }
+    // The timer is released once the callback returns, so that the expiry handler is free to start it again
+    srsran::unique_timer expired = std::move(it->second);
+    m_nas_timers.erase(it);
+    lock.unlock();
+    m_s1ap_logger.info("Timer expired. IMSI %" PRIu64 ", Type %d", imsi, type);
+    m_s1ap->expire_nas_timer(type, imsi);
+  });
+  timer.run();
   return true;
 }
 
 bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
 {
-  std::vector<mme_timer_t>::iterator it;
-  for (it = timers.begin(); it != timers.end(); ++it) {
-    if (it->type == type && it->imsi == imsi) {
-      return true; // found timer
-    }
-  }
-  return false;
+  std::lock_guard<std::mutex> lock(m_timers_mutex);
+  auto                        it = m_nas_timers.find(nas_timer_key(type, imsi));
+  return it != m_nas_timers.end() and it->second.is_running();
 }
 
 bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
 {
-  std::vector<mme_timer_t>::iterator it;
-  for (it = timers.begin(); it != timers.end(); ++it) {
-    if (it->type == type && it->imsi == imsi) {
-      break; // found timer to remove
-    }
-  }
-  if (it == timers.end()) {
+  std::lock_guard<std::mutex> lock(m_timers_mutex);
+  auto                        it = m_nas_timers.find(nas_timer_key(type, imsi));
+  if (it == m_nas_timers.end()) {
     m_s1ap_logger.warning("Could not find timer to remove. IMSI %" PRIu64 ", Type %d", imsi, type);
     return false;
   }
 
   // removing timer
-  m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, it->fd);
-  FD_CLR(it->fd, &m_set);
-  close(it->fd);
-  timers.erase(it);
+  m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d", imsi, type);
+  m_nas_timers.erase(it);
   return true;
 }
 
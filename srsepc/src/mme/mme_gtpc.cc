@@ -107,10 +107,32 @@ bool mme_gtpc::send_s11_pdu(const srsran::gtpc_pdu& pdu)
   return true;
 }
 
-void mme_gtpc::handle_s11_pdu(srsran::byte_buffer_t* msg)
+void mme_gtpc::handle_s11_pdu(srsran::unique_byte_buffer_t msg)
 {
   m_logger.debug("Received S11 message");
 
+  // The messages are handled by the NAS worker of the UE, found from the MME control TEID
+  uint64_t imsi = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    srsran::gtpc_pdu*           pdu = (srsran::gtpc_pdu*)msg->msg;
+    auto                        it  = m_mme_ctr_teid_to_imsi.find(pdu->header.teid);
+    if (it != m_mme_ctr_teid_to_imsi.end()) {
+      imsi = it->second;
+    }
+  }
+  m_s1ap->push_ue_task(imsi, [this, imsi, msg = std::move(msg)]() {
+    if (not m_s1ap->is_ue_in_current_worker(imsi)) {
+      m_logger.warning("Discarding S11 message of a replaced UE context. IMSI %015" PRIu64 "", imsi);
+      return;
+    }
+    process_s11_pdu(msg.get());
+  });
+}
+
+void mme_gtpc::process_s11_pdu(srsran::byte_buffer_t* msg)
+{
+
   srsran::gtpc_pdu* pdu;
   pdu = (srsran::gtpc_pdu*)msg->msg;
   m_logger.debug("MME Received GTP-C PDU. Message type %s", srsran::gtpc_msg_type_to_str(pdu->header.type));
@@ -149,6 +171,7 @@ bool mme_gtpc::send_create_session_request(uint64_t imsi)
   // Setup GTP-C Create Session Request IEs
   cs_req->imsi = imsi;
   // Control TEID allocated
+  std::lock_guard<std::mutex> lock(m_mutex);
   cs_req->sender_f_teid.teid = get_new_ctrl_teid();
 
   m_logger.info("Next MME control TEID: %d", m_next_ctrl_teid);
@@ -167,11 +190,11 @@ bool mme_gtpc::send_create_session_request(uint64_t imsi)
   cs_req->eps_bearer_context_created.ebi = 5;
 
   // Check whether this UE is already registed
-  std::map<uint64_t, struct gtpc_ctx>::iterator it = m_imsi_to_gtpc_ctx.find(imsi);
+  srsran::flat_hash_map<uint64_t, struct gtpc_ctx>::iterator it = m_imsi_to_gtpc_ctx.find(imsi);
   if (it != m_imsi_to_gtpc_ctx.end()) {
     m_logger.warning("Create Session Request being called for an UE with an active GTP-C connection.");
     m_logger.warning("Deleting previous GTP-C connection.");
-    std::map<uint32_t, uint64_t>::iterator jt = m_mme_ctr_teid_to_imsi.find(it->second.mme_ctr_fteid.teid);
+    srsran::flat_hash_map<uint32_t, uint64_t>::iterator jt = m_mme_ctr_teid_to_imsi.find(it->second.mme_ctr_fteid.teid);
     if (jt == m_mme_ctr_teid_to_imsi.end()) {
       m_logger.error("Could not find IMSI from MME Ctrl TEID. MME Ctr TEID: %d", it->second.mme_ctr_fteid.teid);
     } else {
@@ -213,12 +236,14 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
   }
 
   // Get IMSI from the control TEID
-  std::map<uint32_t, uint64_t>::iterator id_it = m_mme_ctr_teid_to_imsi.find(cs_resp_pdu->header.teid);
+  std::unique_lock<std::mutex>                        lock(m_mutex);
+  srsran::flat_hash_map<uint32_t, uint64_t>::iterator id_it = m_mme_ctr_teid_to_imsi.find(cs_resp_pdu->header.teid);
   if (id_it == m_mme_ctr_teid_to_imsi.end()) {
     m_logger.warning("Could not find IMSI from Ctrl TEID.");
     return false;
   }
   uint64_t imsi = id_it->second;
+  lock.unlock();
 
   m_logger.info("MME GTPC Ctrl TEID %" PRIu64 ", IMSI %" PRIu64 "", cs_resp_pdu->header.teid, imsi);
 
@@ -263,7 +288,8 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
   srsran::console("SPGW Allocated IP %s to IMSI %015" PRIu64 "\n", inet_ntoa(emm_ctx->ue_ip), emm_ctx->imsi);
 
   // Save SGW ctrl F-TEID in GTP-C context
-  std::map<uint64_t, struct gtpc_ctx>::iterator it_g = m_imsi_to_gtpc_ctx.find(imsi);
+  lock.lock();
+  srsran::flat_hash_map<uint64_t, struct gtpc_ctx>::iterator it_g = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_g == m_imsi_to_gtpc_ctx.end()) {
     // Could not find GTP-C Context
     m_logger.error("Could not find GTP-C context");
@@ -271,6 +297,7 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
   }
   gtpc_ctx_t* gtpc_ctx    = &it_g->second;
   gtpc_ctx->sgw_ctr_fteid = sgw_ctr_fteid;
+  lock.unlock();
 
   // Set EPS bearer context
   // TODO default EPS bearer is hard-coded
@@ -288,7 +315,8 @@ bool mme_gtpc::send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify
   srsran::gtpc_pdu mb_req_pdu;
   std::memset(&mb_req_pdu, 0, sizeof(mb_req_pdu));
 
-  std::map<uint64_t, gtpc_ctx_t>::iterator it = m_imsi_to_gtpc_ctx.find(imsi);
+  std::lock_guard<std::mutex>                           lock(m_mutex);
+  srsran::flat_hash_map<uint64_t, gtpc_ctx_t>::iterator it = m_imsi_to_gtpc_ctx.find(imsi);
   if (it == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Modify bearer request for UE without GTP-C connection");
     return false;
@@ -317,16 +345,19 @@ bool mme_gtpc::send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify
 
 void mme_gtpc::handle_modify_bearer_response(srsran::gtpc_pdu* mb_resp_pdu)
 {
-  uint32_t                               mme_ctrl_teid = mb_resp_pdu->header.teid;
-  std::map<uint32_t, uint64_t>::iterator imsi_it       = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
+  uint32_t                                            mme_ctrl_teid = mb_resp_pdu->header.teid;
+  std::unique_lock<std::mutex>                        lock(m_mutex);
+  srsran::flat_hash_map<uint32_t, uint64_t>::iterator imsi_it = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
   if (imsi_it == m_mme_ctr_teid_to_imsi.end()) {
     m_logger.error("Could not find IMSI from control TEID");
     return;
   }
+  uint64_t imsi = imsi_it->second;
+  lock.unlock();
 
   uint8_t ebi = mb_resp_pdu->choice.modify_bearer_response.eps_bearer_context_modified.ebi;
   m_logger.debug("Activating EPS bearer with id %d", ebi);
-  m_s1ap->activate_eps_bearer(imsi_it->second, ebi);
+  m_s1ap->activate_eps_bearer(imsi, ebi);
 
   return;
 }
@@ -340,7 +371,8 @@ bool mme_gtpc::send_delete_session_request(uint64_t imsi)
   srsran::gtp_fteid_t mme_ctr_fteid;
 
   // Get S-GW Ctr TEID
-  std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
+  std::lock_guard<std::mutex>                           lock(m_mutex);
+  srsran::flat_hash_map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Could not find GTP-C context to remove");
     return false;
@@ -361,7 +393,7 @@ bool mme_gtpc::send_delete_session_request(uint64_t imsi)
   send_s11_pdu(del_req_pdu);
 
   // Delete GTP-C context
-  std::map<uint32_t, uint64_t>::iterator it_imsi = m_mme_ctr_teid_to_imsi.find(mme_ctr_fteid.teid);
+  srsran::flat_hash_map<uint32_t, uint64_t>::iterator it_imsi = m_mme_ctr_teid_to_imsi.find(mme_ctr_fteid.teid);
   if (it_imsi == m_mme_ctr_teid_to_imsi.end()) {
     m_logger.error("Could not find IMSI from MME ctr TEID");
   } else {
@@ -380,12 +412,14 @@ void mme_gtpc::send_release_access_bearers_request(uint64_t imsi)
   srsran::gtp_fteid_t sgw_ctr_fteid;
 
   // Get S-GW Ctr TEID
-  std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
+  std::unique_lock<std::mutex>                          lock(m_mutex);
+  srsran::flat_hash_map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Could not find GTP-C context to remove");
     return;
   }
   sgw_ctr_fteid = it_ctx->second.sgw_ctr_fteid;
+  lock.unlock();
 
   // Set GTP-C header
   srsran::gtpc_header* header = &rel_req_pdu.header;
@@ -404,22 +438,25 @@ void mme_gtpc::send_release_access_bearers_request(uint64_t imsi)
 
 bool mme_gtpc::handle_downlink_data_notification(srsran::gtpc_pdu* dl_not_pdu)
 {
-  uint32_t                                 mme_ctrl_teid = dl_not_pdu->header.teid;
-  srsran::gtpc_downlink_data_notification* dl_not        = &dl_not_pdu->choice.downlink_data_notification;
-  std::map<uint32_t, uint64_t>::iterator   imsi_it       = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
+  uint32_t                                            mme_ctrl_teid = dl_not_pdu->header.teid;
+  srsran::gtpc_downlink_data_notification*            dl_not        = &dl_not_pdu->choice.downlink_data_notification;
+  std::unique_lock<std::mutex>                        lock(m_mutex);
+  srsran::flat_hash_map<uint32_t, uint64_t>::iterator imsi_it = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
   if (imsi_it == m_mme_ctr_teid_to_imsi.end()) {
     m_logger.error("Could not find IMSI from control TEID");
     return false;
   }
+  uint64_t imsi = imsi_it->second;
+  lock.unlock();
 
   if (!dl_not->eps_bearer_id_present) {
     m_logger.error("No EPS bearer Id in downlink data notification");
     return false;
   }
   uint8_t ebi = dl_not->eps_bearer_id;
-  m_logger.debug("Downlink Data Notification -- IMSI: %015" PRIu64 ", EBI %d", imsi_it->second, ebi);
+  m_logger.debug("Downlink Data Notification -- IMSI: %015" PRIu64 ", EBI %d", imsi, ebi);
 
-  m_s1ap->send_paging(imsi_it->second, ebi);
+  m_s1ap->send_paging(imsi, ebi);
   return true;
 }
 
@@ -431,7 +468,8 @@ void mme_gtpc::send_downlink_data_notification_acknowledge(uint64_t imsi, enum s
   std::memset(&not_ack_pdu, 0, sizeof(not_ack_pdu));
 
   // get s-gw ctr teid
-  std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
+  std::lock_guard<std::mutex>                           lock(m_mutex);
+  srsran::flat_hash_map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("could not find gtp-c context to remove");
     return;
@@ -461,7 +499,8 @@ bool mme_gtpc::send_downlink_data_notification_failure_indication(uint64_t imsi,
   std::memset(&not_fail_pdu, 0, sizeof(not_fail_pdu));
 
   // get s-gw ctr teid
-  std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
+  std::lock_guard<std::mutex>                           lock(m_mutex);
+  srsran::flat_hash_map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("could not find gtp-c context to send paging failure");
     return false;
@@ -19,18 +19,35 @@
  *
  */
 
+#include "srsepc/hdr/mme/nas_worker_pool.h"
 #include "srsepc/hdr/mme/s1ap.h"
 #include "srsepc/hdr/mme/s1ap_nas_transport.h"
+#include "srsran/adt/pool/batch_mem_pool.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/security.h"
 #include <cmath>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
-#include <sys/timerfd.h>
 #include <time.h>
 
 namespace srsepc {
 
+static srsran::background_mem_pool* get_nas_ctx_pool()
+{
+  static srsran::background_mem_pool pool(64, sizeof(nas), 16);
+  return &pool;
+}
+
+void* nas::operator new(size_t sz)
+{
+  return get_nas_ctx_pool()->allocate_node(sz);
+}
+
+void nas::operator delete(void* ptr)
+{
+  get_nas_ctx_pool()->deallocate_node(ptr);
+}
+
 nas::nas(const nas_init_t& args, const nas_if_t& itf) :
   m_gtpc(itf.gtpc),
   m_s1ap(itf.s1ap),
@@ -51,6 +68,7 @@ nas::nas(const nas_init_t& args, const nas_if_t& itf) :
 {
   m_sec_ctx.integ_algo  = args.integ_algo;
   m_sec_ctx.cipher_algo = args.cipher_algo;
+  m_worker_idx          = nas_worker_pool::current_worker();
   m_logger.debug("NAS Context Initialized. MCC: 0x%x, MNC 0x%x", m_mcc, m_mnc);
 }
 
@@ -2049,26 +2067,7 @@ bool nas::start_t3413()
     m_logger.error("EMM invalid status to start T3413");
     return false;
   }
-
-  int fdt = timerfd_create(CLOCK_MONOTONIC, 0);
-  if (fdt < 0) {
-    m_logger.error("Error creating timer. %s", strerror(errno));
-    return false;
-  }
-  struct itimerspec t_value;
-  t_value.it_value.tv_sec     = m_t3413;
-  t_value.it_value.tv_nsec    = 0;
-  t_value.it_interval.tv_sec  = 0;
-  t_value.it_interval.tv_nsec = 0;
-
-  if (timerfd_settime(fdt, 0, &t_value, NULL) == -1) {
-    m_logger.error("Could not set timer");
-    close(fdt);
-    return false;
-  }
-
-  m_mme->add_nas_timer(fdt, T_3413, m_emm_ctx.imsi); // TODO timers without IMSI?
-  return true;
+  return m_mme->add_nas_timer(m_t3413 * 1000, T_3413, m_emm_ctx.imsi); // TODO timers without IMSI?
 }
 
 bool nas::expire_t3413()
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/mme/nas_worker_pool.h"
+#include "srsran/support/srsran_assert.h"
+
+namespace srsepc {
+
+/// Set by each worker of the pool on start-up
+static thread_local uint32_t current_worker_idx = 0;
+
+void nas_worker_pool::start(uint32_t nof_workers, uint32_t queue_size)
+{
+  srsran_assert(workers.empty(), "NAS workers already started");
+  for (uint32_t i = 0; i < nof_workers; ++i) {
+    workers.emplace_back(new srsran::task_worker("NAS" + std::to_string(i), queue_size));
+    workers.back()->push_task([i]() { current_worker_idx = i; });
+  }
+}
+
+void nas_worker_pool::stop()
+{
+  // Pending tasks are discarded
+  for (auto& w : workers) {
+    w->stop();
+  }
+  workers.clear();
+}
+
+uint32_t nas_worker_pool::select_worker(uint64_t ue_key) const
+{
+  if (workers.empty()) {
+    return 0;
+  }
+  // Consecutive IMSIs and IDs are spread with a multiplicative hash
+  return static_cast<uint32_t>(((ue_key * 0x9e3779b97f4a7c15ULL) >> 32U) % workers.size());
+}
+
+void nas_worker_pool::push_task(uint32_t worker_idx, task_t task)
+{
+  if (workers.empty()) {
+    task();
+    return;
+  }
+  workers[worker_idx % workers.size()]->push_task(std::move(task));
+}
+
+uint32_t nas_worker_pool::current_worker()
+{
+  return current_worker_idx;
+}
+
+} // namespace srsepc
@@ -22,6 +22,7 @@
 #include "srsepc/hdr/mme/s1ap.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/bcd_helpers.h"
+#include "srsran/common/int_helpers.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/network_utils.h"
 #include <cmath>
@@ -99,12 +100,21 @@ int s1ap::init(const s1ap_args_t& s1ap_args)
   if (m_pcap_enable) {
     m_pcap.open(s1ap_args.pcap_filename.c_str());
   }
+
+  // Start NAS workers
+  if (s1ap_args.nof_nas_workers > 0) {
+    m_nas_workers.start(s1ap_args.nof_nas_workers);
+    m_logger.info("Started %d NAS workers", s1ap_args.nof_nas_workers);
+  }
   m_logger.info("S1AP Initialized");
   return SRSRAN_SUCCESS;
 }
 
 void s1ap::stop()
 {
+  // Stop the workers first, so that no UE procedure is running while the contexts are deleted
+  m_nas_workers.stop();
+
   if (m_s1mme != -1) {
     close(m_s1mme);
   }
@@ -116,13 +126,13 @@ void s1ap::stop()
     m_active_enbs.erase(enb_it++);
   }
 
-  std::map<uint64_t, nas*>::iterator ue_it = m_imsi_to_nas_ctx.begin();
-  while (ue_it != m_imsi_to_nas_ctx.end()) {
-    m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", ue_it->first);
-    srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", ue_it->first);
-    delete ue_it->second;
-    m_imsi_to_nas_ctx.erase(ue_it++);
+  for (auto& ue_it : m_imsi_to_nas_ctx) {
+    m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", ue_it.first);
+    srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", ue_it.first);
+    delete ue_it.second;
   }
+  m_imsi_to_nas_ctx.clear();
+  m_mme_ue_s1ap_id_to_nas_ctx.clear();
 
   // Cleanup message handlers
   s1ap_mngmt_proc::cleanup();
@@ -223,23 +233,75 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
   }
 
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(buf->msg, buf->N_bytes);
   }
 
   return true;
 }
 
-void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri)
+namespace {
+
+/// Received S1AP PDU, queued for a NAS worker
+struct s1ap_rx_pdu_t {
+  srsran::unique_byte_buffer_t pdu;
+  struct sctp_sndrcvinfo       sri;
+};
+
+/// Extracts the EPS mobile identity of an Attach Request, without unpacking the whole message
+bool get_attach_request_mobile_id(const uint8_t* nas_pdu, uint32_t len, LIBLTE_MME_EPS_MOBILE_ID_STRUCT* mobile_id)
+{
+  // Security header, message type, attach type and NAS KSI go before the mobile identity
+  uint32_t offset = (nas_pdu[0] >> 4U) == LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS ? 0 : 6;
+  if (len < offset + 4 or (nas_pdu[offset] & 0x0fU) != LIBLTE_MME_PD_EPS_MOBILITY_MANAGEMENT or
+      nas_pdu[offset + 1] != LIBLTE_MME_MSG_TYPE_ATTACH_REQUEST or len < offset + 4 + nas_pdu[offset + 3]) {
+    return false;
+  }
+  uint8* ie_ptr = const_cast<uint8*>(&nas_pdu[offset + 3]);
+  return liblte_mme_unpack_eps_mobile_id_ie(&ie_ptr, mobile_id) == LIBLTE_SUCCESS;
+}
+
+} // namespace
+
+void s1ap::handle_s1ap_rx_pdu(srsran::unique_byte_buffer_t pdu, const struct sctp_sndrcvinfo& enb_sri)
 {
   // Save PCAP
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
+  // Index the IEs first, so that PDUs that won't be processed are dropped without decoding them
+  asn1::ap_pdu_index index;
+  if (index.unpack(pdu->msg, pdu->N_bytes) != asn1::SRSASN_SUCCESS) {
+    m_logger.error("Failed to unpack received PDU");
+    return;
+  }
+  if (not filter_s1ap_rx_pdu(index)) {
+    return;
+  }
+
+  // UE-associated PDUs are decoded and handled by the worker of the UE. The rest are handled here
+  uint32_t worker_idx = 0;
+  if (not m_nas_workers.enabled() or not get_s1ap_rx_pdu_worker(index, enb_sri, worker_idx)) {
+    struct sctp_sndrcvinfo sri = enb_sri;
+    process_s1ap_rx_pdu(pdu.get(), &sri);
+    return;
+  }
+  std::unique_ptr<s1ap_rx_pdu_t> rx_pdu(new s1ap_rx_pdu_t{std::move(pdu), enb_sri});
+  m_nas_workers.push_task(
+      worker_idx, [this, rx_pdu = std::move(rx_pdu)]() { process_s1ap_rx_pdu(rx_pdu->pdu.get(), &rx_pdu->sri); });
+}
+
+void s1ap::process_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri)
+{
+  // Storage of the containers of received PDUs, one per worker
+  static thread_local asn1::arena rx_arena;
+
   // Get PDU type
   s1ap_pdu_t     rx_pdu;
   asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  if (asn1::unpack_in_arena(rx_pdu, bref, rx_arena) != asn1::SRSASN_SUCCESS) {
     m_logger.error("Failed to unpack received PDU");
     return;
   }
@@ -262,6 +324,94 @@ void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo
   }
 }
 
+bool s1ap::filter_s1ap_rx_pdu(const asn1::ap_pdu_index& index)
+{
+  if (index.pdu_type() != asn1::ap_pdu_index::pdu_type_t::init_msg) {
+    return true;
+  }
+
+  switch (index.proc_code()) {
+    case ASN1_S1AP_ID_UL_NAS_TRANSPORT: {
+      // Only the MME-UE S1AP id is needed to find out whether the UE is known
+      asn1::s1ap::mme_ue_s1ap_id_t mme_ue_s1ap_id;
+      if (index.unpack_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID, mme_ue_s1ap_id) != asn1::SRSASN_SUCCESS) {
+        m_logger.error("Failed to unpack MME-UE S1AP id of Uplink NAS Transport Message");
+        return false;
+      }
+      if (find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id.value) == nullptr) {
+        m_logger.warning("Received uplink NAS, but could not find UE NAS context. MME-UE S1AP id: %d",
+                         (uint32_t)mme_ue_s1ap_id.value);
+        return false;
+      }
+      return true;
+    }
+    case ASN1_S1AP_ID_UE_CAP_INFO_IND:
+      m_logger.info("Ignoring UE capability Info Indication.");
+      return false;
+    default:
+      return true;
+  }
+}
+
+bool s1ap::get_s1ap_rx_pdu_worker(const asn1::ap_pdu_index&     index,
+                                  const struct sctp_sndrcvinfo& enb_sri,
+                                  uint32_t&                     worker_idx)
+{
+  using pdu_type_t = asn1::ap_pdu_index::pdu_type_t;
+
+  switch (index.proc_code()) {
+    case ASN1_S1AP_ID_INIT_UE_MSG: {
+      if (index.pdu_type() != pdu_type_t::init_msg) {
+        return false;
+      }
+      // Find the IMSI of the UE from the mobile identity of the Attach Request, or from its S-TMSI otherwise
+      uint64_t                        imsi      = 0;
+      LIBLTE_MME_EPS_MOBILE_ID_STRUCT mobile_id = {};
+      asn1::unbounded_octstring<true> nas_pdu;
+      asn1::s1ap::s_tmsi_s            s_tmsi;
+      if (index.unpack_ie(ASN1_S1AP_ID_NAS_PDU, nas_pdu) == asn1::SRSASN_SUCCESS and nas_pdu.size() > 0 and
+          get_attach_request_mobile_id(nas_pdu.data(), nas_pdu.size(), &mobile_id)) {
+        if (mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI) {
+          for (int i = 0; i <= 14; i++) {
+            imsi = imsi * 10 + mobile_id.imsi[i];
+          }
+        } else if (mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI) {
+          imsi = find_imsi_from_m_tmsi(mobile_id.guti.m_tmsi);
+        }
+      } else if (index.unpack_ie(ASN1_S1AP_ID_S_TMSI, s_tmsi) == asn1::SRSASN_SUCCESS) {
+        uint32_t m_tmsi = 0;
+        srsran::uint8_to_uint32(s_tmsi.m_tmsi.data(), &m_tmsi);
+        imsi = find_imsi_from_m_tmsi(m_tmsi);
+      }
+      if (imsi != 0) {
+        worker_idx = get_ue_worker_from_imsi(imsi);
+        return true;
+      }
+      // Unknown identity. The UE is assigned a worker from its eNB UE S1AP Id
+      asn1::s1ap::enb_ue_s1ap_id_t enb_ue_s1ap_id;
+      if (index.unpack_ie(ASN1_S1AP_ID_ENB_UE_S1AP_ID, enb_ue_s1ap_id) != asn1::SRSASN_SUCCESS) {
+        return false;
+      }
+      worker_idx = m_nas_workers.select_worker(((uint64_t)enb_sri.sinfo_assoc_id << 32U) | enb_ue_s1ap_id.value);
+      return true;
+    }
+    case ASN1_S1AP_ID_UL_NAS_TRANSPORT:
+    case ASN1_S1AP_ID_UE_CONTEXT_RELEASE_REQUEST:
+    case ASN1_S1AP_ID_INIT_CONTEXT_SETUP:
+    case ASN1_S1AP_ID_UE_CONTEXT_RELEASE: {
+      asn1::s1ap::mme_ue_s1ap_id_t mme_ue_s1ap_id;
+      if (index.unpack_ie(ASN1_S1AP_ID_MME_UE_S1AP_ID, mme_ue_s1ap_id) != asn1::SRSASN_SUCCESS) {
+        return false;
+      }
+      worker_idx = get_ue_worker_from_mme_ue_s1ap_id(mme_ue_s1ap_id.value);
+      return true;
+    }
+    default:
+      // Non UE-associated signalling
+      return false;
+  }
+}
+
 void s1ap::handle_initiating_message(const asn1::s1ap::init_msg_s& msg, struct sctp_sndrcvinfo* enb_sri)
 {
   using init_msg_type_opts_t = asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts;
@@ -283,9 +433,6 @@ void s1ap::handle_initiating_message(const asn1::s1ap::init_msg_s& msg, struct s
       m_logger.info("Received UE Context Release Request Message.");
       m_s1ap_ctx_mngmt_proc->handle_ue_context_release_request(msg.value.ue_context_release_request(), enb_sri);
       break;
-    case init_msg_type_opts_t::ue_cap_info_ind:
-      m_logger.info("Ignoring UE capability Info Indication.");
-      break;
     default:
       m_logger.error("Unhandled S1AP initiating message: %s", msg.value.type().to_string());
       srsran::console("Unhandled S1APinitiating message: %s\n", msg.value.type().to_string());
@@ -317,6 +464,8 @@ void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinf
   std::set<uint32_t> ue_set;
   enb_ctx_t*         enb_ptr = new enb_ctx_t;
   *enb_ptr                   = enb_ctx;
+
+  std::lock_guard<std::mutex> lock(m_enb_mutex);
   m_active_enbs.emplace(enb_ptr->enb_id, enb_ptr);
   m_sctp_to_enb_id.emplace(enb_sri->sinfo_assoc_id, enb_ptr->enb_id);
   m_enb_assoc_to_ue_ids.emplace(enb_sri->sinfo_assoc_id, ue_set);
@@ -324,6 +473,7 @@ void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinf
 
 enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
 {
+  std::lock_guard<std::mutex>              lock(m_enb_mutex);
   std::map<uint16_t, enb_ctx_t*>::iterator it = m_active_enbs.find(enb_id);
   if (it == m_active_enbs.end()) {
     return nullptr;
@@ -334,11 +484,16 @@ enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
 
 void s1ap::delete_enb_ctx(int32_t assoc_id)
 {
+  std::unique_lock<std::mutex>          lock(m_enb_mutex);
   std::map<int32_t, uint16_t>::iterator it_assoc = m_sctp_to_enb_id.find(assoc_id);
-  uint16_t                              enb_id   = it_assoc->second;
+  if (it_assoc == m_sctp_to_enb_id.end()) {
+    m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
+    return;
+  }
+  uint16_t enb_id = it_assoc->second;
 
   std::map<uint16_t, enb_ctx_t*>::iterator it_ctx = m_active_enbs.find(enb_id);
-  if (it_ctx == m_active_enbs.end() || it_assoc == m_sctp_to_enb_id.end()) {
+  if (it_ctx == m_active_enbs.end()) {
     m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
     return;
   }
@@ -346,26 +501,29 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
   m_logger.info("Deleting eNB context. eNB Id: 0x%x", enb_id);
   srsran::console("Deleting eNB context. eNB Id: 0x%x\n", enb_id);
 
-  // Delete connected UEs ctx
-  release_ues_ecm_ctx_in_enb(assoc_id);
-
   // Delete eNB
   delete it_ctx->second;
   m_active_enbs.erase(it_ctx);
   m_sctp_to_enb_id.erase(it_assoc);
+  lock.unlock();
+
+  // Delete connected UEs ctx
+  release_ues_ecm_ctx_in_enb(assoc_id);
   return;
 }
 
 // UE Context Management
 bool s1ap::add_nas_ctx_to_imsi_map(nas* nas_ctx)
 {
-  std::map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
+  std::lock_guard<std::mutex>                     lock(m_ue_mutex);
+  srsran::flat_hash_map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
   if (ctx_it != m_imsi_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    srsran::flat_hash_map<uint32_t, nas*>::iterator ctx_it2 =
+        m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with IMSI does not match context identified by MME UE S1AP Id.");
       return false;
@@ -382,13 +540,16 @@ bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
     m_logger.error("Could not add UE context to MME UE S1AP map. MME UE S1AP ID 0 is not valid.");
     return false;
   }
-  std::map<uint32_t, nas*>::iterator ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+  std::lock_guard<std::mutex>                     lock(m_ue_mutex);
+  srsran::flat_hash_map<uint32_t, nas*>::iterator ctx_it =
+      m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
   if (ctx_it != m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. MME UE S1AP Id %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_emm_ctx.imsi != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    srsran::flat_hash_map<uint32_t, nas*>::iterator ctx_it2 =
+        m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with MME UE S1AP Id does not match context identified by IMSI.");
       return false;
@@ -401,6 +562,7 @@ bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
 
 bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 {
+  std::lock_guard<std::mutex>                      lock(m_enb_mutex);
   std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
   if (ues_in_enb == m_enb_assoc_to_ue_ids.end()) {
     m_logger.error("Could not find eNB from eNB SCTP association %d", enb_assoc);
@@ -418,7 +580,8 @@ bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 {
-  std::map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  std::lock_guard<std::mutex>                     lock(m_ue_mutex);
+  srsran::flat_hash_map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
   if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     return NULL;
   } else {
@@ -428,7 +591,8 @@ nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 {
-  std::map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
+  std::lock_guard<std::mutex>                     lock(m_ue_mutex);
+  srsran::flat_hash_map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
   if (it == m_imsi_to_nas_ctx.end()) {
     return NULL;
   } else {
@@ -439,29 +603,50 @@ nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
 {
   srsran::console("Releasing UEs context\n");
-  std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
-  std::set<uint32_t>::iterator                     ue_id      = ues_in_enb->second.begin();
-  if (ue_id == ues_in_enb->second.end()) {
-    srsran::console("No UEs to be released\n");
-  } else {
-    while (ue_id != ues_in_enb->second.end()) {
-      std::map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
-      emm_ctx_t*                         emm_ctx = &nas_ctx->second->m_emm_ctx;
-      ecm_ctx_t*                         ecm_ctx = &nas_ctx->second->m_ecm_ctx;
-
-      m_logger.info(
-          "Releasing UE context. IMSI: %015" PRIu64 ", UE-MME S1AP Id: %d", emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
-      if (emm_ctx->state == EMM_STATE_REGISTERED) {
-        m_mme_gtpc->send_delete_session_request(emm_ctx->imsi);
-        emm_ctx->state = EMM_STATE_DEREGISTERED;
-      }
-      srsran::console("Releasing UE ECM context. UE-MME S1AP Id: %d\n", ecm_ctx->mme_ue_s1ap_id);
-      ecm_ctx->state          = ECM_STATE_IDLE;
-      ecm_ctx->mme_ue_s1ap_id = 0;
-      ecm_ctx->enb_ue_s1ap_id = 0;
-      ues_in_enb->second.erase(ue_id++);
+  std::set<uint32_t> ue_ids;
+  {
+    std::lock_guard<std::mutex>                      lock(m_enb_mutex);
+    std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
+    if (ues_in_enb != m_enb_assoc_to_ue_ids.end()) {
+      ue_ids.swap(ues_in_enb->second);
     }
   }
+  if (ue_ids.empty()) {
+    srsran::console("No UEs to be released\n");
+    return;
+  }
+
+  // Each UE is released by its worker
+  for (uint32_t mme_ue_s1ap_id : ue_ids) {
+    m_nas_workers.push_task(get_ue_worker_from_mme_ue_s1ap_id(mme_ue_s1ap_id),
+                            [this, mme_ue_s1ap_id]() { release_enb_ue_ecm_ctx(mme_ue_s1ap_id); });
+  }
+}
+
+void s1ap::release_enb_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
+{
+  nas* nas_ctx = find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
+  if (nas_ctx == nullptr) {
+    m_logger.warning("Could not find UE context to release. MME-UE S1AP Id: %d", mme_ue_s1ap_id);
+    return;
+  }
+  emm_ctx_t* emm_ctx = &nas_ctx->m_emm_ctx;
+  ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
+
+  m_logger.info(
+      "Releasing UE context. IMSI: %015" PRIu64 ", UE-MME S1AP Id: %d", emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
+  if (emm_ctx->state == EMM_STATE_REGISTERED) {
+    m_mme_gtpc->send_delete_session_request(emm_ctx->imsi);
+    emm_ctx->state = EMM_STATE_DEREGISTERED;
+  }
+  srsran::console("Releasing UE ECM context. UE-MME S1AP Id: %d\n", ecm_ctx->mme_ue_s1ap_id);
+  {
+    std::lock_guard<std::mutex> lock(m_ue_mutex);
+    m_mme_ue_s1ap_id_to_nas_ctx.erase(mme_ue_s1ap_id);
+  }
+  ecm_ctx->state          = ECM_STATE_IDLE;
+  ecm_ctx->mme_ue_s1ap_id = 0;
+  ecm_ctx->enb_ue_s1ap_id = 0;
 }
 
 bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
@@ -474,21 +659,27 @@ bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
   ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
 
   // Delete UE within eNB UE set
-  std::map<int32_t, uint16_t>::iterator it = m_sctp_to_enb_id.find(ecm_ctx->enb_sri.sinfo_assoc_id);
-  if (it == m_sctp_to_enb_id.end()) {
-    m_logger.error("Could not find eNB for UE release request.");
-    return false;
-  }
-  uint16_t                                         enb_id = it->second;
-  std::map<int32_t, std::set<uint32_t> >::iterator ue_set = m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
-  if (ue_set == m_enb_assoc_to_ue_ids.end()) {
-    m_logger.error("Could not find the eNB's UEs.");
-    return false;
+  {
+    std::lock_guard<std::mutex>           lock(m_enb_mutex);
+    std::map<int32_t, uint16_t>::iterator it = m_sctp_to_enb_id.find(ecm_ctx->enb_sri.sinfo_assoc_id);
+    if (it == m_sctp_to_enb_id.end()) {
+      m_logger.error("Could not find eNB for UE release request.");
+      return false;
+    }
+    std::map<int32_t, std::set<uint32_t> >::iterator ue_set =
+        m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
+    if (ue_set == m_enb_assoc_to_ue_ids.end()) {
+      m_logger.error("Could not find the eNB's UEs.");
+      return false;
+    }
+    ue_set->second.erase(mme_ue_s1ap_id);
   }
-  ue_set->second.erase(mme_ue_s1ap_id);
 
   // Release UE ECM context
-  m_mme_ue_s1ap_id_to_nas_ctx.erase(mme_ue_s1ap_id);
+  {
+    std::lock_guard<std::mutex> lock(m_ue_mutex);
+    m_mme_ue_s1ap_id_to_nas_ctx.erase(mme_ue_s1ap_id);
+  }
   ecm_ctx->state          = ECM_STATE_IDLE;
   ecm_ctx->mme_ue_s1ap_id = 0;
   ecm_ctx->enb_ue_s1ap_id = 0;
@@ -499,42 +690,95 @@ bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
 
 bool s1ap::delete_ue_ctx(uint64_t imsi)
 {
-  nas* nas_ctx = find_nas_ctx_from_imsi(imsi);
+  // Look up and remove the context in one go, so only the thread that removed it from the IMSI map releases it
+  nas* nas_ctx = NULL;
+  {
+    std::lock_guard<std::mutex>                     lock(m_ue_mutex);
+    srsran::flat_hash_map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
+    if (it != m_imsi_to_nas_ctx.end()) {
+      nas_ctx = it->second;
+      m_imsi_to_nas_ctx.erase(it);
+    }
+  }
   if (nas_ctx == NULL) {
     m_logger.info("Cannot delete UE context, UE not found. IMSI: %" PRIu64 "", imsi);
     return false;
   }
 
+  // A context that belongs to another worker (e.g. found after the Identity Response of a GUTI attach) is removed from
+  // the IMSI map right away, but it is released by its own worker
+  if (nas_ctx->m_worker_idx != nas_worker_pool::current_worker()) {
+    m_nas_workers.push_task(nas_ctx->m_worker_idx, [this, nas_ctx]() {
+      if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
+        release_ue_ecm_ctx(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+      }
+      delete nas_ctx;
+      m_logger.info("Deleted UE Context.");
+    });
+    return true;
+  }
+
   // Make sure to release ECM ctx
   if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
     release_ue_ecm_ctx(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
   }
 
   // Delete UE context
-  m_imsi_to_nas_ctx.erase(imsi);
   delete nas_ctx;
   m_logger.info("Deleted UE Context.");
   return true;
 }
 
+// NAS workers
+uint32_t s1ap::get_ue_worker_from_imsi(uint64_t imsi)
+{
+  std::lock_guard<std::mutex>                     lock(m_ue_mutex);
+  srsran::flat_hash_map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
+  return it != m_imsi_to_nas_ctx.end() ? it->second->m_worker_idx : m_nas_workers.select_worker(imsi);
+}
+
+uint32_t s1ap::get_ue_worker_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
+{
+  std::lock_guard<std::mutex>                     lock(m_ue_mutex);
+  srsran::flat_hash_map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  return it != m_mme_ue_s1ap_id_to_nas_ctx.end() ? it->second->m_worker_idx
+                                                 : m_nas_workers.select_worker(mme_ue_s1ap_id);
+}
+
+void s1ap::push_ue_task(uint64_t imsi, nas_worker_pool::task_t task)
+{
+  m_nas_workers.push_task(get_ue_worker_from_imsi(imsi), std::move(task));
+}
+
+bool s1ap::is_ue_in_current_worker(uint64_t imsi)
+{
+  // Tasks queued for a UE context that was meanwhile replaced by a context in another worker are stale
+  std::lock_guard<std::mutex>                     lock(m_ue_mutex);
+  srsran::flat_hash_map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
+  return it == m_imsi_to_nas_ctx.end() or it->second->m_worker_idx == nas_worker_pool::current_worker();
+}
+
 // UE Bearer Managment
 void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 {
-  std::map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
+  std::unique_lock<std::mutex>                    lock(m_ue_mutex);
+  srsran::flat_hash_map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
   if (ue_ctx_it == m_imsi_to_nas_ctx.end()) {
     m_logger.error("Could not activate EPS bearer: Could not find UE context");
     return;
   }
   // Make sure NAS is active
-  uint32_t                           mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
-  std::map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  uint32_t                                        mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
+  srsran::flat_hash_map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
   if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("Could not activate EPS bearer: ECM context seems to be missing");
     return;
   }
+  nas* nas_ctx = ue_ctx_it->second;
+  lock.unlock();
 
-  ecm_ctx_t* ecm_ctx = &ue_ctx_it->second->m_ecm_ctx;
-  esm_ctx_t* esm_ctx = &ue_ctx_it->second->m_esm_ctx[ebi];
+  ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
+  esm_ctx_t* esm_ctx = &nas_ctx->m_esm_ctx[ebi];
   if (esm_ctx->state != ERAB_CTX_SETUP) {
     m_logger.error(
         "Could not be activate EPS Bearer, bearer in wrong state: MME S1AP Id %d, EPS Bearer id %d, state %d",
@@ -557,7 +801,8 @@ void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 
 uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 {
-  uint32_t m_tmsi = m_next_m_tmsi;
+  std::lock_guard<std::mutex> lock(m_ue_mutex);
+  uint32_t                    m_tmsi = m_next_m_tmsi;
   m_next_m_tmsi   = (m_next_m_tmsi + 1) % UINT32_MAX;
 
   m_tmsi_to_imsi.emplace(m_tmsi, imsi);
@@ -567,7 +812,8 @@ uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 
 uint64_t s1ap::find_imsi_from_m_tmsi(uint32_t m_tmsi)
 {
-  std::map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
+  std::lock_guard<std::mutex>                         lock(m_ue_mutex);
+  srsran::flat_hash_map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
   if (it != m_tmsi_to_imsi.end()) {
     m_logger.debug("Found IMSI %015" PRIu64 " from M-TMSI 0x%x", it->second, m_tmsi);
     return it->second;
@@ -666,13 +912,20 @@ bool s1ap::send_downlink_nas_transport(uint32_t               enb_ue_s1ap_id,
 
 bool s1ap::expire_nas_timer(enum nas_timer_type type, uint64_t imsi)
 {
-  nas* nas_ctx = find_nas_ctx_from_imsi(imsi);
-  if (nas_ctx == NULL) {
-    m_logger.error("Error finding NAS context to handle timer");
-    return false;
-  }
-  bool err = nas_ctx->expire_timer(type);
-  return err;
+  // The timers run in the MME thread, but the expiry is handled by the worker of the UE
+  push_ue_task(imsi, [this, type, imsi]() {
+    if (not is_ue_in_current_worker(imsi)) {
+      m_logger.info("Discarding timer of a replaced UE context. IMSI %015" PRIu64 "", imsi);
+      return;
+    }
+    nas* nas_ctx = find_nas_ctx_from_imsi(imsi);
+    if (nas_ctx == NULL) {
+      m_logger.error("Error finding NAS context to handle timer");
+      return;
+    }
+    nas_ctx->expire_timer(type);
+  });
+  return true;
 }
 
 } // namespace srsepc
@@ -85,6 +85,7 @@ bool s1ap_paging::send_paging(uint64_t imsi, uint16_t erab_to_setup)
     return false;
   }
 
+  std::lock_guard<std::mutex> lock(m_s1ap->m_enb_mutex);
   for (std::map<uint16_t, enb_ctx_t*>::iterator it = m_s1ap->m_active_enbs.begin(); it != m_s1ap->m_active_enbs.end();
        it++) {
     enb_ctx_t* enb_ctx = it->second;
@@ -86,13 +86,13 @@ int spgw::gtpc::init(spgw_args_t*                           args,
 
 void spgw::gtpc::stop()
 {
-  std::map<uint32_t, spgw_tunnel_ctx*>::iterator it = m_teid_to_tunnel_ctx.begin();
-  while (it != m_teid_to_tunnel_ctx.end()) {
-    m_logger.info("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "", it->second->imsi);
-    srsran::console("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "\n", it->second->imsi);
-    delete it->second;
-    m_teid_to_tunnel_ctx.erase(it++);
+  for (auto& it : m_teid_to_tunnel_ctx) {
+    m_logger.info("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "", it.second->imsi);
+    srsran::console("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "\n", it.second->imsi);
+    delete it.second;
   }
+  m_teid_to_tunnel_ctx.clear();
+  m_imsi_to_ctr_teid.clear();
   return;
 }
 
@@ -240,8 +240,8 @@ void spgw::gtpc::handle_modify_bearer_request(const struct srsran::gtpc_header&
   m_logger.info("Received Modified Bearer Request");
 
   // Get control tunnel info from mb_req PDU
-  uint32_t                                         ctrl_teid = mb_req_hdr.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t                                                      ctrl_teid = mb_req_hdr.teid;
+  srsran::flat_hash_map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID %d to modify", ctrl_teid);
     return;
@@ -303,8 +303,8 @@ void spgw::gtpc::handle_modify_bearer_request(const struct srsran::gtpc_header&
 void spgw::gtpc::handle_delete_session_request(const srsran::gtpc_header&                 header,
                                                const srsran::gtpc_delete_session_request& del_req_pdu)
 {
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t                                                      ctrl_teid = header.teid;
+  srsran::flat_hash_map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to delete session", ctrl_teid);
     return;
@@ -320,8 +320,8 @@ void spgw::gtpc::handle_release_access_bearers_request(const srsran::gtpc_header
                                                        const srsran::gtpc_release_access_bearers_request& rel_req)
 {
   // Find tunel ctxt
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t                                                      ctrl_teid = header.teid;
+  srsran::flat_hash_map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to release bearers", ctrl_teid);
     return;
@@ -344,7 +344,7 @@ bool spgw::gtpc::send_downlink_data_notification(uint32_t spgw_ctr_teid)
   struct srsran::gtpc_downlink_data_notification* dl_not = &dl_not_pdu.choice.downlink_data_notification;
 
   // Find MME Ctrl TEID
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(spgw_ctr_teid);
+  srsran::flat_hash_map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(spgw_ctr_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to send downlink notification.", spgw_ctr_teid);
     return false;
@@ -382,8 +382,8 @@ void spgw::gtpc::handle_downlink_data_notification_acknowledge(
   m_logger.debug("Handling downlink data notification acknowledge");
 
   // Find tunel ctxt
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t                                                      ctrl_teid = header.teid;
+  srsran::flat_hash_map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to handle notification acknowldge", ctrl_teid);
     return;
@@ -410,8 +410,8 @@ void spgw::gtpc::handle_downlink_data_notification_failure_indication(
 {
   m_logger.debug("Handling downlink data notification failure indication");
   // Find tunel ctxt
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t                                                      ctrl_teid = header.teid;
+  srsran::flat_hash_map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to handle notification failure indication", ctrl_teid);
     return;
@@ -590,7 +590,7 @@ in_addr_t spgw::gtpc::get_new_ue_ipv4(uint64_t imsi)
 {
   struct in_addr ue_addr;
 
-  std::map<uint64_t, struct in_addr>::const_iterator iter = m_imsi_to_ip.find(imsi);
+  srsran::flat_hash_map<uint64_t, struct in_addr>::const_iterator iter = m_imsi_to_ip.find(imsi);
   if (iter != m_imsi_to_ip.end()) {
     ue_addr = iter->second;
     m_logger.info("SPGW: get_new_ue_ipv4 static ip addr %s", inet_ntoa(ue_addr));
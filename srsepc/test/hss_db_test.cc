@@ -0,0 +1,189 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsran/common/bcd_helpers.h"
+#include "srsran/common/security.h"
+#include "srsran/common/string_helpers.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+namespace srsepc {
+
+const char*    db_file     = "hss_db_test_user_db.csv";
+const uint64_t mil_imsi    = 1010123456789ULL;
+const char*    mil_key_str = "00112233445566778899aabbccddeeff";
+const char*    mil_opc_str = "63bfa50ee6523365ff14c1f45f88737d";
+const uint64_t xor_imsi    = 1010123456790ULL;
+
+static uint16_t mcc = 0;
+static uint16_t mnc = 0;
+
+static int write_user_db(const char* mil_sqn, bool extra_user)
+{
+  std::ofstream file(db_file);
+  TESTASSERT(file.is_open());
+  file << "# Test user DB\n";
+  file << "ue1,mil,001010123456789," << mil_key_str << ",opc," << mil_opc_str << ",8000," << mil_sqn << ",9,dynamic\n";
+  file << "ue2,xor,001010123456790,00112233445566778899aabbccddeeff,opc,63bfa50ee6523365ff14c1f45f88737d,9001,"
+          "000000001234,7,172.16.0.2\n";
+  if (extra_user) {
+    file << "ue3,mil,001010123456791,00112233445566778899aabbccddeeff,op,63bfa50ee6523365ff14c1f45f88737d,8000,"
+            "000000000000,9,dynamic\n";
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/// Checks the authentication vector of the Milenage UE against the UE side computation, and returns its SQN
+static int check_milenage_av(hss* hss, uint64_t* sqn64)
+{
+  uint8_t k_asme[32], autn[16], rand[16], xres[16];
+  TESTASSERT(hss->gen_auth_info_answer(mil_imsi, k_asme, autn, rand, xres));
+
+  uint8_t k[16], opc[16], amf[2] = {0x80, 0x00};
+  srsran::get_uint_vec_from_hex_str(mil_key_str, k, 16);
+  srsran::get_uint_vec_from_hex_str(mil_opc_str, opc, 16);
+
+  uint8_t res[8], ck[16], ik[16], ak[6], sqn[6], mac[8], ue_k_asme[32];
+  srsran::security_milenage_f2345(k, opc, rand, res, ck, ik, ak);
+  for (int i = 0; i < 6; i++) {
+    sqn[i] = autn[i] ^ ak[i];
+  }
+  srsran::security_milenage_f1(k, opc, rand, sqn, amf, mac);
+  srsran::security_generate_k_asme(ck, ik, autn, mcc, mnc, ue_k_asme);
+  TESTASSERT(memcmp(res, xres, 8) == 0);
+  TESTASSERT(memcmp(mac, autn + 8, 8) == 0);
+  TESTASSERT(memcmp(ue_k_asme, k_asme, 32) == 0);
+
+  *sqn64 = hss_db::pack_sqn(sqn);
+  return SRSRAN_SUCCESS;
+}
+
+/// Generates a number of vectors for the Milenage UE, and checks that the SEQ part of the SQN increases by one
+static int check_milenage_avs(hss* hss, uint32_t nof_avs, uint64_t* last_seq)
+{
+  for (uint32_t i = 0; i < nof_avs; ++i) {
+    uint64_t sqn64 = 0;
+    TESTASSERT(check_milenage_av(hss, &sqn64) == SRSRAN_SUCCESS);
+    uint64_t seq = sqn64 >> LTE_FDD_ENB_IND_HE_N_BITS;
+    TESTASSERT(*last_seq == UINT64_MAX or seq == *last_seq + 1);
+    *last_seq = seq;
+    if (i % 2 == 0) {
+      // Let the HSS refill the precomputed vectors
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/// Reads the SQN of the Milenage UE from the binary DB file
+static int read_db_sqn(uint64_t* seq)
+{
+  hss_db db;
+  TESTASSERT(db.open(std::string(db_file) + ".bin", db_file));
+  for (uint32_t i = 0; i < db.size(); ++i) {
+    if (db[i].imsi == mil_imsi) {
+      *seq = db[i].sqn >> LTE_FDD_ENB_IND_HE_N_BITS;
+      return SRSRAN_SUCCESS;
+    }
+  }
+  return SRSRAN_ERROR;
+}
+
+int test_hss_db()
+{
+  std::string db_bin_file = std::string(db_file) + ".bin";
+  unlink(db_bin_file.c_str());
+  TESTASSERT(write_user_db("000000000040", false) == SRSRAN_SUCCESS);
+
+  hss_args_t args = {};
+  args.db_file    = db_file;
+  args.mcc        = mcc;
+  args.mnc        = mnc;
+
+  // The binary DB is generated from the CSV on the first start
+  hss* hss = hss::get_instance();
+  TESTASSERT(hss->init(&args) == SRSRAN_SUCCESS);
+  TESTASSERT(access(db_bin_file.c_str(), F_OK) == 0);
+  uint8_t qci = 0;
+  TESTASSERT(hss->gen_update_loc_answer(xor_imsi, &qci) and qci == 7);
+  TESTASSERT(hss->get_ip_to_imsi().at("172.16.0.2") == xor_imsi);
+
+  uint64_t seq = UINT64_MAX;
+  TESTASSERT(check_milenage_avs(hss, 10, &seq) == SRSRAN_SUCCESS);
+  TESTASSERT(seq == 2 + 9);
+
+  // SQN updates are visible in the file right away
+  uint64_t db_seq = 0;
+  TESTASSERT(read_db_sqn(&db_seq) == SRSRAN_SUCCESS);
+  TESTASSERT(db_seq == seq + 1);
+
+  hss->stop();
+  hss::cleanup();
+
+  // On restart, the users are loaded from the binary DB, which is in sync with the CSV rewritten on exit
+  hss_db db;
+  TESTASSERT(db.open(db_bin_file, db_file));
+  db.close();
+  hss = hss::get_instance();
+  TESTASSERT(hss->init(&args) == SRSRAN_SUCCESS);
+  TESTASSERT(hss->gen_update_loc_answer(xor_imsi, &qci) and qci == 7);
+  TESTASSERT(hss->get_ip_to_imsi().at("172.16.0.2") == xor_imsi);
+  TESTASSERT(check_milenage_avs(hss, 5, &seq) == SRSRAN_SUCCESS);
+  TESTASSERT(seq == 2 + 14);
+  hss->stop();
+  hss::cleanup();
+
+  // Editing the CSV invalidates the binary DB
+  TESTASSERT(write_user_db("000000000040", true) == SRSRAN_SUCCESS);
+  TESTASSERT(not db.open(db_bin_file, db_file));
+  hss = hss::get_instance();
+  TESTASSERT(hss->init(&args) == SRSRAN_SUCCESS);
+  TESTASSERT(hss->gen_update_loc_answer(mil_imsi + 2, &qci) and qci == 9);
+  seq = UINT64_MAX;
+  TESTASSERT(check_milenage_avs(hss, 3, &seq) == SRSRAN_SUCCESS);
+  TESTASSERT(seq == 2 + 2);
+  hss->stop();
+  hss::cleanup();
+
+  unlink(db_bin_file.c_str());
+  unlink(db_file);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsepc
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("HSS", false).set_level(srslog::basic_levels::info);
+  srslog::init();
+  srsran::string_to_mcc("001", &srsepc::mcc);
+  srsran::string_to_mnc("01", &srsepc::mnc);
+
+  TESTASSERT(srsepc::test_hss_db() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,400 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Load generator for the MME. It runs the MME and the HSS in-process and simulates a number of eNBs, each with its
+ * own SCTP association to the MME over the loopback interface, that attach a number of UEs concurrently. A UE is
+ * counted as attached once the MME sends the NAS Security Mode Command, i.e. after the attach request and the
+ * authentication round trip, which are the procedures handled by the MME and the HSS alone.
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsepc/hdr/mme/mme.h"
+#include "srsran/asn1/liblte_mme.h"
+#include "srsran/common/bcd_helpers.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/security.h"
+#include "srsran/common/string_helpers.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <fstream>
+#include <getopt.h>
+#include <iomanip>
+#include <poll.h>
+
+using namespace asn1::s1ap;
+
+namespace srsepc {
+
+const char*    mme_addr       = "127.0.100.2";
+const int      mme_port       = 36412;
+const uint16_t tac            = 7;
+const uint64_t imsi_base      = 1010000000000ULL;
+const char*    ue_key_str     = "00112233445566778899aabbccddeeff";
+const char*    db_file        = "mme_attach_load_test_user_db.csv";
+const uint16_t nonue_stream   = 0;
+const uint16_t ue_stream      = 1;
+const uint32_t test_timeout_s = 30;
+
+uint32_t nof_enbs        = 4;
+uint32_t nof_ues_per_enb = 64;
+uint32_t nof_nas_workers = 0;
+
+struct ue_sim_t {
+  uint64_t imsi           = 0;
+  uint32_t mme_ue_s1ap_id = 0;
+  bool     attached       = false;
+};
+
+struct enb_sim_t {
+  uint32_t              enb_id = 0;
+  srsran::unique_socket sock;
+  std::vector<ue_sim_t> ues;
+};
+
+static uint32_t get_plmn()
+{
+  uint16_t mcc = 0, mnc = 0;
+  uint32_t plmn = 0;
+  srsran::string_to_mcc("001", &mcc);
+  srsran::string_to_mnc("01", &mnc);
+  srsran::s1ap_mccmnc_to_plmn(mcc, mnc, &plmn);
+  return plmn;
+}
+
+static int write_user_db()
+{
+  std::ofstream file(db_file);
+  TESTASSERT(file.is_open());
+  for (uint32_t i = 0; i < nof_enbs * nof_ues_per_enb; ++i) {
+    file << "ue" << i << ",xor," << std::setw(15) << std::setfill('0') << imsi_base + i << "," << ue_key_str
+         << ",opc,63bfa50ee6523365ff14c1f45f88737d,9001,000000001234,7,dynamic\n";
+  }
+  return SRSRAN_SUCCESS;
+}
+
+static int send_s1ap_pdu(enb_sim_t& enb, const s1ap_pdu_c& pdu, uint16_t stream_id)
+{
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  TESTASSERT(buf != nullptr);
+  asn1::bit_ref bref(buf->msg, buf->get_tailroom());
+  TESTASSERT(pdu.pack(bref) == asn1::SRSASN_SUCCESS);
+  buf->N_bytes = bref.distance_bytes();
+
+  sockaddr_in addr = {};
+  TESTASSERT(srsran::net_utils::set_sockaddr(&addr, mme_addr, mme_port));
+  ssize_t n_sent = sctp_sendmsg(enb.sock.fd(),
+                                buf->msg,
+                                buf->N_bytes,
+                                (struct sockaddr*)&addr,
+                                sizeof(addr),
+                                htonl((uint32_t)srsran::net_utils::ppid_values::S1AP),
+                                0,
+                                stream_id,
+                                0,
+                                0);
+  TESTASSERT(n_sent == (ssize_t)buf->N_bytes);
+  return SRSRAN_SUCCESS;
+}
+
+static int recv_s1ap_pdu(enb_sim_t& enb, s1ap_pdu_c& pdu)
+{
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  TESTASSERT(buf != nullptr);
+  sctp_sndrcvinfo sri       = {};
+  int             msg_flags = 0;
+  int rd_sz = sctp_recvmsg(enb.sock.fd(), buf->msg, buf->get_tailroom(), nullptr, nullptr, &sri, &msg_flags);
+  TESTASSERT(rd_sz > 0);
+  if (msg_flags & MSG_NOTIFICATION) {
+    return SRSRAN_ERROR;
+  }
+  asn1::cbit_ref bref(buf->msg, rd_sz);
+  TESTASSERT(pdu.unpack(bref) == asn1::SRSASN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
+
+static int s1_setup(enb_sim_t& enb)
+{
+  uint32_t plmn = htonl(get_plmn());
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_S1_SETUP);
+  s1_setup_request_s& container             = pdu.init_msg().value.s1_setup_request();
+  container->global_enb_id.value.plm_nid[0] = ((uint8_t*)&plmn)[1];
+  container->global_enb_id.value.plm_nid[1] = ((uint8_t*)&plmn)[2];
+  container->global_enb_id.value.plm_nid[2] = ((uint8_t*)&plmn)[3];
+  container->global_enb_id.value.enb_id.set_macro_enb_id().from_number(enb.enb_id);
+
+  container->supported_tas.value.resize(1);
+  container->supported_tas.value[0].tac.from_number(tac);
+  container->supported_tas.value[0].broadcast_plmns.resize(1);
+  container->supported_tas.value[0].broadcast_plmns[0][0] = ((uint8_t*)&plmn)[1];
+  container->supported_tas.value[0].broadcast_plmns[0][1] = ((uint8_t*)&plmn)[2];
+  container->supported_tas.value[0].broadcast_plmns[0][2] = ((uint8_t*)&plmn)[3];
+  container->default_paging_drx.value.value = paging_drx_opts::v128;
+  TESTASSERT(send_s1ap_pdu(enb, pdu, nonue_stream) == SRSRAN_SUCCESS);
+
+  s1ap_pdu_c rx_pdu;
+  TESTASSERT(recv_s1ap_pdu(enb, rx_pdu) == SRSRAN_SUCCESS);
+  TESTASSERT(rx_pdu.type().value == s1ap_pdu_c::types_opts::successful_outcome);
+  TESTASSERT(rx_pdu.successful_outcome().proc_code == ASN1_S1AP_ID_S1_SETUP);
+  return SRSRAN_SUCCESS;
+}
+
+static void fill_tai_cgi(const enb_sim_t& enb, tai_s& tai, eutran_cgi_s& cgi)
+{
+  tai.plm_nid.from_number(get_plmn());
+  tai.tac.from_number(tac);
+  cgi.plm_nid.from_number(get_plmn());
+  cgi.cell_id.from_number(enb.enb_id << 8U);
+}
+
+static int send_attach_request(enb_sim_t& enb, uint32_t ue_idx)
+{
+  srsran::unique_byte_buffer_t nas_pdu = srsran::make_byte_buffer();
+  TESTASSERT(nas_pdu != nullptr);
+
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT attach_req = {};
+  attach_req.eps_attach_type                      = LIBLTE_MME_EPS_ATTACH_TYPE_EPS_ATTACH;
+  for (uint32_t i = 0; i < 3; i++) {
+    attach_req.ue_network_cap.eea[i]     = true;
+    attach_req.ue_network_cap.eia[i + 1] = true;
+  }
+  attach_req.eps_mobile_id.type_of_id = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
+  uint64_t imsi                       = enb.ues[ue_idx].imsi;
+  for (int i = 14; i >= 0; --i) {
+    attach_req.eps_mobile_id.imsi[i] = imsi % 10;
+    imsi /= 10;
+  }
+  attach_req.nas_ksi.tsc_flag = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
+  attach_req.nas_ksi.nas_ksi  = LIBLTE_MME_NAS_KEY_SET_IDENTIFIER_NO_KEY_AVAILABLE;
+
+  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req = {};
+  pdn_con_req.proc_transaction_id                            = 0x01;
+  pdn_con_req.request_type                                   = LIBLTE_MME_REQUEST_TYPE_INITIAL_REQUEST;
+  pdn_con_req.pdn_type                                       = LIBLTE_MME_PDN_TYPE_IPV4;
+  TESTASSERT(liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req, &attach_req.esm_msg) == LIBLTE_SUCCESS);
+  TESTASSERT(liblte_mme_pack_attach_request_msg(&attach_req, (LIBLTE_BYTE_MSG_STRUCT*)nas_pdu.get()) ==
+             LIBLTE_SUCCESS);
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_INIT_UE_MSG);
+  init_ue_msg_s& container        = pdu.init_msg().value.init_ue_msg();
+  container->enb_ue_s1ap_id.value = ue_idx;
+  container->nas_pdu.value.resize(nas_pdu->N_bytes);
+  memcpy(container->nas_pdu.value.data(), nas_pdu->msg, nas_pdu->N_bytes);
+  fill_tai_cgi(enb, container->tai.value, container->eutran_cgi.value);
+  container->rrc_establishment_cause.value = rrc_establishment_cause_opts::mo_sig;
+  return send_s1ap_pdu(enb, pdu, ue_stream);
+}
+
+static int send_authentication_response(enb_sim_t& enb, uint32_t ue_idx, srsran::byte_buffer_t& nas_rx)
+{
+  LIBLTE_MME_AUTHENTICATION_REQUEST_MSG_STRUCT auth_req = {};
+  TESTASSERT(liblte_mme_unpack_authentication_request_msg((LIBLTE_BYTE_MSG_STRUCT*)&nas_rx, &auth_req) ==
+             LIBLTE_SUCCESS);
+
+  uint8_t k[16], ck[16], ik[16], ak[6];
+  srsran::get_uint_vec_from_hex_str(ue_key_str, k, 16);
+  LIBLTE_MME_AUTHENTICATION_RESPONSE_MSG_STRUCT auth_resp = {};
+  srsran::security_xor_f2345(k, auth_req.rand, auth_resp.res, ck, ik, ak);
+  auth_resp.res_len = 8;
+
+  srsran::unique_byte_buffer_t nas_pdu = srsran::make_byte_buffer();
+  TESTASSERT(nas_pdu != nullptr);
+  TESTASSERT(liblte_mme_pack_authentication_response_msg(
+                 &auth_resp, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, (LIBLTE_BYTE_MSG_STRUCT*)nas_pdu.get()) ==
+             LIBLTE_SUCCESS);
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_UL_NAS_TRANSPORT);
+  ul_nas_transport_s& container   = pdu.init_msg().value.ul_nas_transport();
+  container->mme_ue_s1ap_id.value = enb.ues[ue_idx].mme_ue_s1ap_id;
+  container->enb_ue_s1ap_id.value = ue_idx;
+  container->nas_pdu.value.resize(nas_pdu->N_bytes);
+  memcpy(container->nas_pdu.value.data(), nas_pdu->msg, nas_pdu->N_bytes);
+  fill_tai_cgi(enb, container->tai.value, container->eutran_cgi.value);
+  return send_s1ap_pdu(enb, pdu, ue_stream);
+}
+
+/// Handles a PDU received by an eNB, returns the number of UEs that completed the attach with it
+static int handle_enb_rx_pdu(enb_sim_t& enb)
+{
+  s1ap_pdu_c pdu;
+  if (recv_s1ap_pdu(enb, pdu) != SRSRAN_SUCCESS) {
+    return 0;
+  }
+  TESTASSERT(pdu.type().value == s1ap_pdu_c::types_opts::init_msg);
+  TESTASSERT(pdu.init_msg().value.type().value == s1ap_elem_procs_o::init_msg_c::types_opts::dl_nas_transport);
+  const dl_nas_transport_s& dl_nas = pdu.init_msg().value.dl_nas_transport();
+  uint32_t                  ue_idx = dl_nas->enb_ue_s1ap_id.value.value;
+  TESTASSERT(ue_idx < enb.ues.size());
+  enb.ues[ue_idx].mme_ue_s1ap_id = dl_nas->mme_ue_s1ap_id.value.value;
+
+  srsran::unique_byte_buffer_t nas_rx = srsran::make_byte_buffer();
+  TESTASSERT(nas_rx != nullptr);
+  memcpy(nas_rx->msg, dl_nas->nas_pdu.value.data(), dl_nas->nas_pdu.value.size());
+  nas_rx->N_bytes = dl_nas->nas_pdu.value.size();
+
+  uint8_t pd = 0, msg_type = 0;
+  TESTASSERT(liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)nas_rx.get(), &pd, &msg_type) == LIBLTE_SUCCESS);
+  switch (msg_type) {
+    case LIBLTE_MME_MSG_TYPE_AUTHENTICATION_REQUEST:
+      TESTASSERT(send_authentication_response(enb, ue_idx, *nas_rx) == SRSRAN_SUCCESS);
+      return 0;
+    case LIBLTE_MME_MSG_TYPE_SECURITY_MODE_COMMAND:
+      TESTASSERT(not enb.ues[ue_idx].attached);
+      enb.ues[ue_idx].attached = true;
+      return 1;
+    default:
+      srsran::console("Unexpected NAS message type 0x%x for IMSI %015" PRIu64 "\n", msg_type, enb.ues[ue_idx].imsi);
+      return SRSRAN_ERROR;
+  }
+}
+
+int test_attach_load()
+{
+  std::vector<enb_sim_t> enbs(nof_enbs);
+  for (uint32_t i = 0; i < nof_enbs; ++i) {
+    enb_sim_t& enb = enbs[i];
+    enb.enb_id     = i + 1;
+    enb.ues.resize(nof_ues_per_enb);
+    for (uint32_t j = 0; j < nof_ues_per_enb; ++j) {
+      enb.ues[j].imsi = imsi_base + i * nof_ues_per_enb + j;
+    }
+    std::string enb_addr = "127.0.1." + std::to_string(i + 1);
+    TESTASSERT(srsran::net_utils::sctp_init_socket(
+        &enb.sock, srsran::net_utils::socket_type::seqpacket, enb_addr.c_str(), 0));
+    TESTASSERT(enb.sock.connect_to(mme_addr, mme_port));
+    TESTASSERT(s1_setup(enb) == SRSRAN_SUCCESS);
+  }
+
+  // All the UEs start attaching at once
+  auto tstart = std::chrono::steady_clock::now();
+  for (enb_sim_t& enb : enbs) {
+    for (uint32_t j = 0; j < nof_ues_per_enb; ++j) {
+      TESTASSERT(send_attach_request(enb, j) == SRSRAN_SUCCESS);
+    }
+  }
+
+  std::vector<pollfd> fds(nof_enbs);
+  for (uint32_t i = 0; i < nof_enbs; ++i) {
+    fds[i].fd     = enbs[i].sock.fd();
+    fds[i].events = POLLIN;
+  }
+  uint32_t nof_attached = 0;
+  while (nof_attached < nof_enbs * nof_ues_per_enb) {
+    int n = poll(fds.data(), fds.size(), test_timeout_s * 1000);
+    TESTASSERT(n > 0);
+    for (uint32_t i = 0; i < nof_enbs; ++i) {
+      if (fds[i].revents & POLLIN) {
+        int ret = handle_enb_rx_pdu(enbs[i]);
+        TESTASSERT(ret >= 0);
+        nof_attached += ret;
+      }
+    }
+  }
+  auto     tend = std::chrono::steady_clock::now();
+  uint64_t t_us = std::chrono::duration_cast<std::chrono::microseconds>(tend - tstart).count();
+  double   rate = nof_attached * 1e6 / std::max(t_us, (uint64_t)1);
+  srsran::console("%d eNBs, %d UEs attached in %.1f ms (%.0f attaches/s)\n", nof_enbs, nof_attached, t_us / 1e3, rate);
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsepc
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [euw]\n", prog);
+  printf("\t-e Number of eNBs [Default %d]\n", srsepc::nof_enbs);
+  printf("\t-u Number of UEs per eNB [Default %d]\n", srsepc::nof_ues_per_enb);
+  printf("\t-w Number of NAS workers [Default %d]\n", srsepc::nof_nas_workers);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "euw")) != -1) {
+    switch (opt) {
+      case 'e':
+        srsepc::nof_enbs = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'u':
+        srsepc::nof_ues_per_enb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'w':
+        srsepc::nof_nas_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::init();
+
+  TESTASSERT(srsepc::write_user_db() == SRSRAN_SUCCESS);
+
+  srsepc::hss_args_t hss_args = {};
+  hss_args.db_file            = srsepc::db_file;
+  srsran::string_to_mcc("001", &hss_args.mcc);
+  srsran::string_to_mnc("01", &hss_args.mnc);
+  srsepc::hss* hss = srsepc::hss::get_instance();
+  TESTASSERT(hss->init(&hss_args) == SRSRAN_SUCCESS);
+
+  srsepc::mme_args_t   mme_args  = {};
+  srsepc::s1ap_args_t& s1ap_args = mme_args.s1ap_args;
+  s1ap_args.mme_code             = 0x1a;
+  s1ap_args.mme_group            = 0x0001;
+  s1ap_args.tac                  = srsepc::tac;
+  s1ap_args.mcc                  = hss_args.mcc;
+  s1ap_args.mnc                  = hss_args.mnc;
+  s1ap_args.paging_timer         = 2;
+  s1ap_args.mme_bind_addr        = srsepc::mme_addr;
+  s1ap_args.mme_name             = "srsmme01";
+  s1ap_args.dns_addr             = "8.8.8.8";
+  s1ap_args.full_net_name        = "Software Radio Systems RAN";
+  s1ap_args.short_net_name       = "srsRAN";
+  s1ap_args.mme_apn              = "srsapn";
+  s1ap_args.encryption_algo      = srsran::CIPHERING_ALGORITHM_ID_EEA0;
+  s1ap_args.integrity_algo       = srsran::INTEGRITY_ALGORITHM_ID_128_EIA1;
+  s1ap_args.nof_nas_workers      = srsepc::nof_nas_workers;
+  srsepc::mme* mme               = srsepc::mme::get_instance();
+  TESTASSERT(mme->init(&mme_args) == SRSRAN_SUCCESS);
+  mme->start();
+
+  int ret = srsepc::test_attach_load();
+
+  mme->stop();
+  mme->cleanup();
+  hss->stop();
+  hss->cleanup();
+  srslog::flush();
+
+  TESTASSERT(ret == SRSRAN_SUCCESS);
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
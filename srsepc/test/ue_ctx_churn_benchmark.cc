@@ -0,0 +1,184 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Benchmark of the UE context store of the MME. It drives the S1AP context indexes directly, without the network
+ * interfaces, through the context operations of the attach, service request/release and detach procedures for a
+ * large population of UEs.
+ */
+
+#include "srsepc/hdr/mme/s1ap.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+
+namespace srsepc {
+
+static uint32_t nof_ues    = 10000;
+static uint32_t nof_rounds = 4;
+static uint32_t nof_enbs   = 16;
+
+static const uint64_t imsi_base = 1010123456789ULL;
+
+struct ue_ref_t {
+  uint64_t imsi;
+  uint32_t m_tmsi;
+  int32_t  enb_assoc;
+};
+
+class churn_timer
+{
+public:
+  explicit churn_timer(const char* name_) : name(name_), tstart(std::chrono::steady_clock::now()) {}
+  ~churn_timer()
+  {
+    auto t_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tstart).count();
+    srsran::console("  %-16s %8.1f ns/UE\n", name, (double)t_ns / nof_ues);
+  }
+
+private:
+  const char*                           name;
+  std::chrono::steady_clock::time_point tstart;
+};
+
+/// Gives the UE a new S1 connection, as done in the attach and service request procedures
+int connect_ue(s1ap* s1ap, nas* nas_ctx, int32_t enb_assoc)
+{
+  nas_ctx->m_ecm_ctx.state                  = ECM_STATE_CONNECTED;
+  nas_ctx->m_ecm_ctx.mme_ue_s1ap_id         = s1ap->get_next_mme_ue_s1ap_id();
+  nas_ctx->m_ecm_ctx.enb_sri.sinfo_assoc_id = enb_assoc;
+  TESTASSERT(s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx));
+  TESTASSERT(s1ap->add_ue_to_enb_set(enb_assoc, nas_ctx->m_ecm_ctx.mme_ue_s1ap_id));
+  return SRSRAN_SUCCESS;
+}
+
+int test_ue_ctx_churn()
+{
+  s1ap* s1ap = s1ap::get_instance();
+
+  for (uint32_t i = 0; i < nof_enbs; ++i) {
+    enb_ctx_t              enb_ctx = {};
+    struct sctp_sndrcvinfo enb_sri = {};
+    enb_ctx.enb_id                 = i + 1;
+    enb_sri.sinfo_assoc_id         = i + 1;
+    s1ap->add_new_enb_ctx(enb_ctx, &enb_sri);
+  }
+
+  nas_init_t nas_init = {};
+  nas_if_t   nas_itf  = {};
+  nas_itf.s1ap        = s1ap;
+
+  std::vector<ue_ref_t> ues(nof_ues);
+  for (uint32_t round = 0; round < nof_rounds; ++round) {
+    srsran::console("Round %d, %d UEs:\n", round, nof_ues);
+
+    {
+      churn_timer t("attach");
+      for (uint32_t i = 0; i < nof_ues; ++i) {
+        ues[i].imsi      = imsi_base + round * nof_ues + i;
+        ues[i].enb_assoc = i % nof_enbs + 1;
+
+        nas* nas_ctx             = new nas(nas_init, nas_itf);
+        nas_ctx->m_emm_ctx.imsi  = ues[i].imsi;
+        nas_ctx->m_emm_ctx.state = EMM_STATE_REGISTERED;
+        TESTASSERT(connect_ue(s1ap, nas_ctx, ues[i].enb_assoc) == SRSRAN_SUCCESS);
+        TESTASSERT(s1ap->add_nas_ctx_to_imsi_map(nas_ctx));
+        ues[i].m_tmsi                  = s1ap->allocate_m_tmsi(ues[i].imsi);
+        nas_ctx->m_sec_ctx.guti.m_tmsi = ues[i].m_tmsi;
+      }
+    }
+
+    {
+      churn_timer t("release");
+      for (uint32_t i = 0; i < nof_ues; ++i) {
+        nas* nas_ctx = s1ap->find_nas_ctx_from_imsi(ues[i].imsi);
+        TESTASSERT(nas_ctx != nullptr);
+        TESTASSERT(s1ap->release_ue_ecm_ctx(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id));
+      }
+    }
+
+    {
+      churn_timer t("service request");
+      for (uint32_t i = 0; i < nof_ues; ++i) {
+        uint64_t imsi = s1ap->find_imsi_from_m_tmsi(ues[i].m_tmsi);
+        TESTASSERT(imsi == ues[i].imsi);
+        nas* nas_ctx = s1ap->find_nas_ctx_from_imsi(imsi);
+        TESTASSERT(nas_ctx != nullptr and nas_ctx->m_ecm_ctx.state == ECM_STATE_IDLE);
+        TESTASSERT(connect_ue(s1ap, nas_ctx, ues[(i + 1) % nof_ues].enb_assoc) == SRSRAN_SUCCESS);
+      }
+    }
+
+    {
+      churn_timer t("detach");
+      for (uint32_t i = 0; i < nof_ues; ++i) {
+        TESTASSERT(s1ap->delete_ue_ctx(ues[i].imsi));
+      }
+    }
+    TESTASSERT(s1ap->find_nas_ctx_from_imsi(ues[0].imsi) == nullptr);
+  }
+
+  s1ap::cleanup();
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsepc
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [uer]\n", prog);
+  printf("\t-u Number of UEs [Default %d]\n", srsepc::nof_ues);
+  printf("\t-e Number of eNBs [Default %d]\n", srsepc::nof_enbs);
+  printf("\t-r Number of attach/detach rounds [Default %d]\n", srsepc::nof_rounds);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "uer")) != -1) {
+    switch (opt) {
+      case 'u':
+        srsepc::nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        srsepc::nof_enbs = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        srsepc::nof_rounds = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::init();
+
+  TESTASSERT(srsepc::test_ue_ctx_churn() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -88,6 +88,7 @@ public:
   void process_pdus() final;
 
   void toggle_padding() override {}
+  void cmd_pcap_filter(const srsran::pcap_filter_cfg_t& cfg) override;
 
   int         slot_indication(const srsran_slot_cfg_t& slot_cfg) override;
   dl_sched_t* get_dl_sched(const srsran_slot_cfg_t& slot_cfg) override;
@@ -29,6 +29,7 @@
 #include "srsenb/hdr/stack/enb_stack_base.h"
 #include "srsgnb/hdr/stack/mac/ue_nr.h"
 #include "srsran/common/task_scheduler.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/gnb_mac_interfaces.h"
@@ -65,6 +66,9 @@ public:
   /// Called from metrics thread.
   void get_metrics(srsenb::mac_metrics_t& metrics);
 
+  /// Called from the console thread.
+  void set_pcap_filter(const srsran::pcap_filter_cfg_t& cfg);
+
   // MAC interface for RRC
   int      cell_cfg(const std::vector<srsenb::sched_nr_cell_cfg_t>& nr_cells) override;
   uint16_t reserve_rnti(uint32_t enb_cc_idx, const sched_nr_interface::ue_cfg_t& uecfg) override;
@@ -87,7 +91,8 @@ public:
   void store_msg3(uint16_t rnti, srsran::unique_byte_buffer_t pdu) override;
 
   // Test interface
-  void ul_bsr(uint16_t rnti, uint32_t lcid, uint32_t bsr);
+  void     ul_bsr(uint16_t rnti, uint32_t lcid, uint32_t bsr);
+  uint32_t get_nof_late_dl_slots();
 
 private:
   uint16_t add_ue_(uint32_t enb_cc_idx);
@@ -103,8 +108,13 @@ private:
   // Metrics processing
   void get_metrics_nolock(srsenb::mac_metrics_t& metrics);
 
-  // Encoding
-  srsran::byte_buffer_t* assemble_rar(srsran::const_span<sched_nr_interface::msg3_grant_t> grants);
+  // DL scheduling and encoding
+  dl_sched_t*            sched_dl_slot(slot_point pdsch_slot, srsran::byte_buffer_t& rar_buffer);
+  dl_sched_t*            get_prepared_dl_sched(slot_point pdsch_slot);
+  void                   sched_dl_slots_until_nolock(slot_point last_slot);
+  void                   discard_removed_ues(dl_sched_t& dl_res);
+  srsran::byte_buffer_t* assemble_rar(srsran::const_span<sched_nr_interface::msg3_grant_t> grants,
+                                      srsran::byte_buffer_t&                                 rar_buffer);
 
   srsran::unique_byte_buffer_t rar_pdu_buffer;
 
@@ -152,6 +162,20 @@ private:
 
   // Decoding of UL PDUs
   std::unique_ptr<mac_nr_rx> rx;
+
+  // Slots scheduled by the stack thread ahead of the PHY requests, indexed by PDSCH slot. Their results must outlive
+  // the PHY processing, which ends TX_ENB_DELAY slots after the request
+  struct prepared_slot_t {
+    slot_point                   slot;
+    dl_sched_t*                  dl_res = nullptr;
+    srsran::unique_byte_buffer_t rar_buffer;
+  };
+  const static uint32_t                           PREPARED_RING_SZ = 10;
+  std::mutex                                      sched_mutex; ///< Serializes the DL scheduling of PHY and stack threads
+  slot_point                                      next_sched_slot;
+  std::array<prepared_slot_t, PREPARED_RING_SZ>   prepared_slots;
+  uint32_t                                        nof_late_dl_slots = 0; ///< Slots requested after being overwritten
+  srsran::tprof<srsran::deadline_histogram_stats> dl_sched_tprof; ///< Time the PHY waits for the DL scheduling
 };
 
 } // namespace srsenb
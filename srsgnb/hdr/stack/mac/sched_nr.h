@@ -62,7 +62,8 @@ public:
   void dl_mac_ce(uint16_t rnti, uint32_t ce_lcid) override;
   void dl_cqi_info(uint16_t rnti, uint32_t cc, uint32_t cqi_value);
 
-  /// Called once per slot in a non-concurrent fashion
+  /// Called once per slot in a non-concurrent fashion. If the carriers are scheduled in parallel, it waits for the
+  /// previous slot to complete, and starts the scheduling of all carriers for the new slot
   void      slot_indication(slot_point slot_tx) override;
   dl_res_t* get_dl_sched(slot_point pdsch_tti, uint32_t cc) override;
   ul_res_t* get_ul_sched(slot_point pusch_tti, uint32_t cc) override;
@@ -70,8 +71,9 @@ public:
   void get_metrics(mac_metrics_t& metrics);
 
 private:
-  int ue_cfg_impl(uint16_t rnti, const ue_cfg_t& cfg);
-  int add_ue_impl(uint16_t rnti, sched_nr_impl::unique_ue_ptr u);
+  int       ue_cfg_impl(uint16_t rnti, const ue_cfg_t& cfg);
+  int       add_ue_impl(uint16_t rnti, sched_nr_impl::unique_ue_ptr u);
+  dl_res_t* run_cc_slot(slot_point pdsch_tti, uint32_t cc);
 
   // args
   sched_nr_impl::sched_params_t cfg;
@@ -96,6 +98,10 @@ private:
   // metrics extraction
   class ue_metrics_manager;
   std::unique_ptr<ue_metrics_manager> metrics_handler;
+
+  // carrier threads, only used when the carriers are scheduled in parallel
+  class cc_pipeline;
+  std::unique_ptr<cc_pipeline> pipeline;
 };
 
 } // namespace srsenb
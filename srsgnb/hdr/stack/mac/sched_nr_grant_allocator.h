@@ -111,7 +111,7 @@ public:
   alloc_result alloc_pusch(slot_ue& ue, const prb_grant& grant);
 
   slot_point           get_pdcch_tti() const { return pdcch_slot; }
-  slot_point           get_tti_rx() const { return pdcch_slot - TX_ENB_DELAY; }
+  slot_point           get_tti_rx() const { return pdcch_slot - TX_ENB_DELAY - cfg.sched_cfg.lookahead_slots; }
   const bwp_res_grid&  res_grid() const { return bwp_grid; }
   const bwp_slot_grid& tx_slot_grid() const { return bwp_grid[pdcch_slot]; }
   bwp_slot_grid&       tx_slot_grid() { return bwp_grid[pdcch_slot]; }
@@ -43,6 +43,7 @@ const static size_t   SCHED_NR_MAX_HARQ         = SRSRAN_DEFAULT_HARQ_PROC_DL_NR
 const static size_t   SCHED_NR_MAX_BWP_PER_CELL = 2;
 const static size_t   SCHED_NR_MAX_LCID         = srsran::MAX_NR_NOF_BEARERS;
 const static size_t   SCHED_NR_MAX_LC_GROUP     = 7;
+const static uint32_t SCHED_NR_MAX_LOOKAHEAD    = 4;
 
 struct sched_nr_ue_cc_cfg_t {
   bool     active = false;
@@ -120,6 +121,8 @@ public:
     bool        pdsch_enabled      = true;
     bool        pusch_enabled      = true;
     bool        auto_refill_buffer = false;
+    bool        parallel_cc        = false; ///< Schedule each carrier in a dedicated thread, started by slot_indication()
+    uint32_t    lookahead_slots    = 0; ///< Slots scheduled ahead of the PHY, up to SCHED_NR_MAX_LOOKAHEAD
     int         fixed_dl_mcs       = 28;
     int         fixed_ul_mcs       = 28;
     std::string logger_name        = "MAC-NR";
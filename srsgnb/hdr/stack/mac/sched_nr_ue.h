@@ -66,6 +66,10 @@ public:
   };
   srsran::deque<ce_t> pending_ces;
 
+  /// Moves the pending CEs to the queue of the carrier they are addressed to. Called at slot boundaries, so that the
+  /// carriers of a UE can build their PDUs concurrently
+  void shard_ces();
+
   /// Protected, thread-safe interface of "ue_buffer_manager" for "slot_ue"
   struct pdu_builder {
     pdu_builder() = default;
@@ -77,9 +81,14 @@ public:
     uint32_t           cc     = SRSRAN_MAX_CARRIERS;
     ue_buffer_manager* parent = nullptr;
   };
+
+private:
+  /// CEs owned by each carrier during the slot, only accessed by the carrier's pdu_builder
+  std::array<srsran::deque<ce_t>, SCHED_NR_MAX_CARRIERS> cc_pending_ces;
 };
 
-/// Class containing context of UE that is common to all carriers
+/// Class containing context of UE that is common to all carriers. Each carrier is assigned a share of it at every slot
+/// boundary, so that carriers can be scheduled in parallel without over-allocating the UE buffers
 struct ue_context_common {
   uint32_t pending_dl_bytes = 0;
   uint32_t pending_ul_bytes = 0;
@@ -93,7 +102,6 @@ public:
   ue_carrier(uint16_t                              rnti,
              const ue_cfg_manager&                 cfg,
              const cell_config_manager&            cell_params_,
-             const ue_context_common&              ctxt,
              const ue_buffer_manager::pdu_builder& pdu_builder_);
 
   void                       set_cfg(const ue_cfg_manager& ue_cfg);
@@ -117,8 +125,8 @@ public:
   // metrics
   mac_ue_metrics_t metrics = {};
 
-  // common context
-  const ue_context_common& common_ctxt;
+  // share of the common context assigned to this carrier for the current slot
+  ue_context_common ctxt;
 
 private:
   friend class slot_ue;
@@ -146,7 +154,7 @@ public:
 
   /// UE state feedback
   void ul_bsr(uint32_t lcg, uint32_t bsr_val) { buffers.ul_bsr(lcg, bsr_val); }
-  void ul_sr_info() { last_sr_slot = last_tx_slot - TX_ENB_DELAY; }
+  void ul_sr_info() { last_sr_slot = last_tx_slot - TX_ENB_DELAY - sched_cfg.sched_cfg.lookahead_slots; }
 
   bool has_ca() const
   {
@@ -161,6 +169,8 @@ public:
   const uint16_t rnti;
 
 private:
+  void distribute_common_ctxt();
+
   const sched_params_t& sched_cfg;
 
   ue_cfg_manager ue_cfg;
@@ -73,6 +73,7 @@ public:
   void       metrics_ul_mcs(uint32_t mcs);
   void       metrics_pucch_sinr(float sinr);
   void       metrics_pusch_sinr(float sinr);
+  void       metrics_ul_fec_iters(float iters);
   void       metrics_cnt();
 
   uint32_t read_pdu(uint32_t lcid, uint8_t* payload, uint32_t requested_bytes) final;
@@ -99,6 +100,7 @@ private:
   uint32_t         dl_pmi_counter       = 0;
   uint32_t         pucch_sinr_counter   = 0;
   uint32_t         pusch_sinr_counter   = 0;
+  uint32_t         fec_iters_counter    = 0;
   mac_ue_metrics_t ue_metrics           = {};
 
   // UE-specific buffer for MAC PDU packing, unpacking and handling
@@ -124,6 +124,9 @@ private:
   asn1::ngap::tai_s    tai;
   asn1::ngap::nr_cgi_s nr_cgi;
 
+  // Storage of the containers of received PDUs
+  asn1::arena rx_arena;
+
   asn1::ngap::ng_setup_resp_s ngsetupresponse;
 
   int  build_tai_cgi();
@@ -132,6 +135,7 @@ private:
   bool sctp_send_ngap_pdu(const asn1::ngap::ngap_pdu_c& tx_pdu, uint32_t rnti, const char* procedure_name);
 
   bool handle_ngap_rx_pdu(srsran::byte_buffer_t* pdu);
+  bool discard_unknown_ue_pdu(const asn1::ap_pdu_index& index, srsran::const_byte_span pdu);
   bool handle_successful_outcome(const asn1::ngap::successful_outcome_s& msg);
   bool handle_unsuccessful_outcome(const asn1::ngap::unsuccessful_outcome_s& msg);
   bool handle_initiating_message(const asn1::ngap::init_msg_s& msg);
@@ -151,6 +151,9 @@ private:
   uint32_t              slot_dur_ms = 0;
   srslog::basic_logger& logger;
 
+  // storage of the containers of received messages
+  asn1::arena rx_arena;
+
   // vars
   std::unique_ptr<du_config_manager> du_cfg;
   struct cell_ctxt_t {
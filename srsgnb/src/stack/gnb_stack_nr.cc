@@ -158,6 +158,13 @@ void gnb_stack_nr::stop_impl()
   running = false;
 }
 
+// Called from the console thread, the filters are thread-safe so no need to defer it to the stack thread
+void gnb_stack_nr::cmd_pcap_filter(const srsran::pcap_filter_cfg_t& cfg)
+{
+  mac.set_pcap_filter(cfg);
+  ngap_pcap.set_filter(cfg);
+}
+
 bool gnb_stack_nr::switch_on()
 {
   // Nothing to be done here
@@ -217,7 +217,8 @@ mac_nr::mac_nr(srsran::task_sched_handle task_sched_) :
   task_sched(task_sched_),
   bcch_bch_payload(srsran::make_byte_buffer()),
   rar_pdu_buffer(srsran::make_byte_buffer()),
-  sched(new sched_nr{})
+  sched(new sched_nr{}),
+  dl_sched_tprof("dl_sched_tprof", "MAC-NR", std::chrono::microseconds{1000U >> NUMEROLOGY_IDX})
 {
   stack_task_queue = task_sched.make_task_queue();
 }
@@ -242,7 +243,7 @@ int mac_nr::init(const mac_nr_args_t&    args_,
 
   if (args.pcap.enable) {
     pcap = std::unique_ptr<srsran::mac_pcap>(new srsran::mac_pcap());
-    pcap->open(args.pcap.filename);
+    pcap->open(args.pcap.filename, 0, make_pcap_writer_args(args.pcap));
   }
 
   logger.info("Started");
@@ -256,13 +257,23 @@ void mac_nr::stop()
 {
   bool started_prev = started.exchange(false);
   if (started_prev) {
-    sched->stop();
+    {
+      std::lock_guard<std::mutex> lock(sched_mutex);
+      sched->stop();
+    }
     if (pcap != nullptr) {
       pcap->close();
     }
   }
 }
 
+void mac_nr::set_pcap_filter(const srsran::pcap_filter_cfg_t& cfg)
+{
+  if (pcap != nullptr) {
+    pcap->set_filter(cfg);
+  }
+}
+
 /// Called from metrics thread.
 /// Note: This can contend for the same mutexes as the ones used by L1/L2 workers.
 ///       However, get_metrics is called infrequently enough to cause major halts in the L1/L2
@@ -292,9 +303,23 @@ void mac_nr::get_metrics_nolock(srsenb::mac_metrics_t& metrics)
 int mac_nr::cell_cfg(const std::vector<srsenb::sched_nr_cell_cfg_t>& nr_cells)
 {
   cell_config = nr_cells;
-  sched->config(args.sched_cfg, nr_cells);
+  if (sched->config(args.sched_cfg, nr_cells) != SRSRAN_SUCCESS) {
+    logger.error("Couldn't configure the scheduler");
+    return SRSRAN_ERROR;
+  }
   detected_rachs.resize(nr_cells.size());
 
+  // Every slot scheduled ahead of the PHY needs its own RAR buffer, as the PHY may still be encoding older slots
+  if (args.sched_cfg.lookahead_slots > 0) {
+    for (prepared_slot_t& prep : prepared_slots) {
+      prep.rar_buffer = srsran::make_byte_buffer();
+      if (prep.rar_buffer == nullptr) {
+        logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
   // read SIBs from RRC (SIB1 for now only)
   for (uint32_t i = 0; i < nr_cells[0].sibs.size(); i++) {
     sib_info_t sib  = {};
@@ -469,6 +494,12 @@ void mac_nr::ul_bsr(uint16_t rnti, uint32_t lcid, uint32_t bsr)
   sched->ul_bsr(rnti, lcid, bsr);
 }
 
+uint32_t mac_nr::get_nof_late_dl_slots()
+{
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  return nof_late_dl_slots;
+}
+
 int mac_nr::slot_indication(const srsran_slot_cfg_t& slot_cfg)
 {
   return 0;
@@ -488,6 +519,102 @@ mac_nr::dl_sched_t* mac_nr::get_dl_sched(const srsran_slot_cfg_t& slot_cfg)
 {
   slot_point pdsch_slot = srsran::slot_point{NUMEROLOGY_IDX, slot_cfg.idx};
 
+  dl_sched_tprof.start();
+  dl_sched_t* dl_res = nullptr;
+  if (args.sched_cfg.lookahead_slots == 0) {
+    dl_res = sched_dl_slot(pdsch_slot, *rar_pdu_buffer);
+  } else {
+    dl_res = get_prepared_dl_sched(pdsch_slot);
+  }
+  dl_sched_tprof.stop();
+
+  return dl_res;
+}
+
+/// Fetches the DL scheduling result prepared by the stack thread, and triggers the scheduling of the next slots. Slots
+/// are scheduled in order, so if the stack thread falls behind, the PHY thread catches up inline
+mac_nr::dl_sched_t* mac_nr::get_prepared_dl_sched(slot_point pdsch_slot)
+{
+  static_assert(PREPARED_RING_SZ > SCHED_NR_MAX_LOOKAHEAD + TX_ENB_DELAY, "Prepared slots are overwritten too early");
+  static_assert(10240 % PREPARED_RING_SZ == 0, "Ring indexes must be continuous across the SFN wrap-around");
+
+  dl_sched_t* dl_res = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(sched_mutex);
+    // Slots skipped by the PHY are not scheduled, as in the synchronous mode
+    if (not next_sched_slot.valid() or next_sched_slot < pdsch_slot) {
+      next_sched_slot = pdsch_slot;
+    }
+    sched_dl_slots_until_nolock(pdsch_slot);
+
+    prepared_slot_t& prep = prepared_slots[pdsch_slot.to_uint() % PREPARED_RING_SZ];
+    if (prep.slot == pdsch_slot) {
+      dl_res = prep.dl_res;
+    } else {
+      // The PHY requested a slot older than the prepared ones, its result is no longer (or was never) available
+      nof_late_dl_slots++;
+      logger.warning("DL scheduling of slot=%d is not available, discarding it. Late slots: %d",
+                     pdsch_slot.to_uint(),
+                     nof_late_dl_slots);
+    }
+  }
+
+  if (dl_res != nullptr) {
+    discard_removed_ues(*dl_res);
+  }
+
+  // Schedule the next slots in the stack thread, while the PHY is busy with this one
+  slot_point last_slot = pdsch_slot + args.sched_cfg.lookahead_slots;
+  stack_task_queue.push([this, last_slot]() {
+    std::lock_guard<std::mutex> lock(sched_mutex);
+    if (started) {
+      sched_dl_slots_until_nolock(last_slot);
+    }
+  });
+
+  return dl_res;
+}
+
+void mac_nr::sched_dl_slots_until_nolock(slot_point last_slot)
+{
+  while (next_sched_slot <= last_slot) {
+    prepared_slot_t& prep = prepared_slots[next_sched_slot.to_uint() % PREPARED_RING_SZ];
+    prep.slot             = next_sched_slot;
+    prep.dl_res           = sched_dl_slot(next_sched_slot, *prep.rar_buffer);
+    next_sched_slot++;
+  }
+}
+
+/// The scheduling decisions of a prepared slot may target UEs that were removed before the slot was transmitted. Their
+/// grants are dropped, so that their resources are not used to address a released (or reassigned) RNTI
+void mac_nr::discard_removed_ues(dl_sched_t& dl_res)
+{
+  srsran::rwlock_read_guard rw_lock(rwmutex);
+  auto is_removed = [this](srsran_rnti_type_t rnti_type, uint16_t rnti) {
+    return rnti_type == srsran_rnti_type_c and not ue_db.contains(rnti);
+  };
+
+  auto pdcch_dl_end = std::remove_if(dl_res.pdcch_dl.begin(), dl_res.pdcch_dl.end(), [&](const pdcch_dl_t& pdcch) {
+    return is_removed(pdcch.dci.ctx.rnti_type, pdcch.dci.ctx.rnti);
+  });
+  auto pdcch_ul_end = std::remove_if(dl_res.pdcch_ul.begin(), dl_res.pdcch_ul.end(), [&](const pdcch_ul_t& pdcch) {
+    return is_removed(pdcch.dci.ctx.rnti_type, pdcch.dci.ctx.rnti);
+  });
+  auto pdsch_end = std::remove_if(dl_res.pdsch.begin(), dl_res.pdsch.end(), [&](const pdsch_t& pdsch) {
+    return is_removed(pdsch.sch.grant.rnti_type, pdsch.sch.grant.rnti);
+  });
+  size_t nof_discarded = dl_res.pdsch.end() - pdsch_end;
+  dl_res.pdcch_dl.resize(pdcch_dl_end - dl_res.pdcch_dl.begin());
+  dl_res.pdcch_ul.resize(pdcch_ul_end - dl_res.pdcch_ul.begin());
+  dl_res.pdsch.resize(pdsch_end - dl_res.pdsch.begin());
+  if (nof_discarded > 0) {
+    logger.info("Discarded %zd PDSCHs of removed UEs", nof_discarded);
+  }
+}
+
+/// Runs the scheduler for the given slot and assembles the MAC PDUs of its PDSCHs
+mac_nr::dl_sched_t* mac_nr::sched_dl_slot(slot_point pdsch_slot, srsran::byte_buffer_t& rar_buffer)
+{
   logger.set_context((pdsch_slot - TX_ENB_DELAY).to_uint());
 
   // Initiate new slot and sync UE internal states
@@ -516,7 +643,7 @@ mac_nr::dl_sched_t* mac_nr::get_dl_sched(const srsran_slot_cfg_t& slot_cfg)
 
           if (pcap != nullptr) {
             uint32_t pid = 0; // TODO: get PID from PDCCH struct?
-            pcap->write_dl_crnti_nr(tb_data->msg, tb_data->N_bytes, rnti, pid, slot_cfg.idx);
+            pcap->write_dl_crnti_nr(tb_data->msg, tb_data->N_bytes, rnti, pid, pdsch_slot.to_uint());
           }
           ue_db[rnti]->metrics_dl_mcs(pdsch.sch.grant.tb->mcs);
         }
@@ -524,7 +651,7 @@ mac_nr::dl_sched_t* mac_nr::get_dl_sched(const srsran_slot_cfg_t& slot_cfg)
     } else if (pdsch.sch.grant.rnti_type == srsran_rnti_type_ra) {
       sched_nr_interface::rar_t& rar = dl_res->rar[rar_count++];
       // for RARs we could actually move the byte_buffer to the PHY, as there are no retx
-      pdsch.data[0] = assemble_rar(rar.grants);
+      pdsch.data[0] = assemble_rar(rar.grants, rar_buffer);
     } else if (pdsch.sch.grant.rnti_type == srsran_rnti_type_si) {
       uint32_t sib_idx = dl_res->sib_idxs[si_count++];
       pdsch.data[0]    = bcch_dlsch_payload[sib_idx].payload.get();
@@ -534,7 +661,7 @@ mac_nr::dl_sched_t* mac_nr::get_dl_sched(const srsran_slot_cfg_t& slot_cfg)
                                   bcch_dlsch_payload[sib_idx].payload->N_bytes,
                                   SI_RNTI,
                                   0,
-                                  slot_cfg.idx);
+                                  pdsch_slot.to_uint());
       }
 #endif
     }
@@ -643,16 +770,18 @@ int mac_nr::pusch_info(const srsran_slot_cfg_t& slot_cfg, mac_interface_phy_nr::
   if (ue_db.contains(rnti)) {
     ue_db[rnti]->metrics_rx(pusch_info.pusch_data.tb[0].crc, nof_bytes);
     ue_db[rnti]->metrics_pusch_sinr(pusch_info.csi.snr_dB);
+    ue_db[rnti]->metrics_ul_fec_iters(pusch_info.pusch_data.tb[0].avg_iter);
   }
   return SRSRAN_SUCCESS;
 }
 
-srsran::byte_buffer_t* mac_nr::assemble_rar(srsran::const_span<sched_nr_interface::msg3_grant_t> grants)
+srsran::byte_buffer_t* mac_nr::assemble_rar(srsran::const_span<sched_nr_interface::msg3_grant_t> grants,
+                                            srsran::byte_buffer_t&                                 rar_buffer)
 {
   srsran::mac_rar_pdu_nr rar_pdu;
 
   uint32_t pdsch_tbs = 10; // TODO: how big is the PDSCH?
-  rar_pdu.init_tx(rar_pdu_buffer.get(), pdsch_tbs);
+  rar_pdu.init_tx(&rar_buffer, pdsch_tbs);
 
   for (auto& rar_grant : grants) {
     srsran::mac_rar_subpdu_nr& rar_subpdu = rar_pdu.add_subpdu();
@@ -692,7 +821,7 @@ srsran::byte_buffer_t* mac_nr::assemble_rar(srsran::const_span<sched_nr_interfac
   rar_pdu.to_string(buff);
   logger.info("%s", srsran::to_c_str(buff));
 
-  return rar_pdu_buffer.get();
+  return &rar_buffer;
 }
 
 } // namespace srsenb
@@ -113,7 +113,8 @@ public:
   }
 
   /// Process all events that are not specific to a carrier or that are directed at CA-enabled UEs
-  /// Note: non-CA UEs are updated later in get_dl_sched, to leverage parallelism
+  /// Note: events of non-CA UEs are handed to the UE PCell, and processed later in get_dl_sched, to leverage
+  /// parallelism
   void process_common(ue_map_t& ues)
   {
     // Extract pending feedback events
@@ -136,11 +137,12 @@ public:
       auto ue_it = ues.find(ev.rnti);
       if (ue_it == ues.end()) {
         sched_logger.warning("SCHED: \"%s\" called for unknown rnti=0x%x.", ev.event_name, ev.rnti);
-        ev.rnti = SRSRAN_INVALID_RNTI;
       } else if (ue_it->second->has_ca()) {
         // events specific to existing UEs with CA
         ev.callback(*ue_it->second, evlogger);
-        ev.rnti = SRSRAN_INVALID_RNTI;
+      } else {
+        // Each carrier only accesses the events of its own UEs, so that carriers can be processed in parallel
+        carriers[ue_it->second->pcell_cc()].current_slot_common_ue_events.push_back(std::move(ev));
       }
     }
   }
@@ -156,20 +158,15 @@ public:
       carriers[cc].current_slot_ue_events.swap(carriers[cc].next_slot_ue_events);
     }
 
-    for (ue_event_t& ev : current_slot_ue_events) {
-      if (ev.rnti == SRSRAN_INVALID_RNTI) {
-        // events already processed
-        continue;
-      }
+    for (ue_event_t& ev : carriers[cc].current_slot_common_ue_events) {
       auto ue_it = ues.find(ev.rnti);
       if (ue_it == ues.end()) {
         sched_logger.warning("SCHED: \"%s\" called for unknown rnti=0x%x.", ev.event_name, ev.rnti);
-        ev.rnti = SRSRAN_INVALID_RNTI;
-      } else if (not ue_it->second->has_ca() and ue_it->second->carriers[cc] != nullptr) {
+      } else {
         ev.callback(*ue_it->second, evlogger);
-        ev.rnti = SRSRAN_INVALID_RNTI;
       }
     }
+    carriers[cc].current_slot_common_ue_events.clear();
 
     for (ue_cc_event_t& ev : carriers[cc].current_slot_ue_events) {
       auto ue_it = ues.find(ev.rnti);
@@ -221,6 +218,7 @@ private:
   struct cc_events {
     std::mutex                   event_cc_mutex;
     srsran::deque<ue_cc_event_t> next_slot_ue_events, current_slot_ue_events;
+    std::deque<ue_event_t>       current_slot_common_ue_events; ///< events of non-CA UEs with PCell in this carrier
   };
   std::vector<cc_events> carriers;
 };
@@ -292,6 +290,82 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Runs the scheduling of every carrier in a dedicated thread. All carriers of a slot are started by slot_indication(),
+/// and their results are collected by get_dl_sched(). Carriers only access the state of their own UEs while the slot
+/// is being scheduled, whereas the state of CA-enabled UEs is updated in slot_indication() once all carriers of the
+/// previous slot have completed
+class sched_nr::cc_pipeline
+{
+public:
+  cc_pipeline(sched_nr& parent_, uint32_t nof_cc) : parent(parent_), carriers(nof_cc)
+  {
+    for (uint32_t cc = 0; cc < nof_cc; ++cc) {
+      carriers[cc].worker.reset(new srsran::task_worker{"SCHED_CC" + std::to_string(cc), 4});
+    }
+  }
+
+  void stop()
+  {
+    wait_all();
+    for (cc_ctxt& c : carriers) {
+      c.worker->stop();
+    }
+  }
+
+  void start_slot(slot_point slot_tx)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (cc_ctxt& c : carriers) {
+        c.res  = nullptr;
+        c.done = false;
+      }
+    }
+    for (uint32_t cc = 0; cc < carriers.size(); ++cc) {
+      carriers[cc].worker->push_task([this, slot_tx, cc]() {
+        dl_res_t* res = parent.run_cc_slot(slot_tx, cc);
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          carriers[cc].res  = res;
+          carriers[cc].done = true;
+        }
+        cvar.notify_all();
+      });
+    }
+  }
+
+  /// Blocking call that waits for the carrier to complete the current slot
+  dl_res_t* wait_cc(uint32_t cc)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cvar.wait(lock, [this, cc]() { return carriers[cc].done; });
+    return carriers[cc].res;
+  }
+
+  /// Blocking call that waits for all carriers to complete the current slot
+  void wait_all()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cvar.wait(lock, [this]() {
+      return std::all_of(carriers.begin(), carriers.end(), [](const cc_ctxt& c) { return c.done; });
+    });
+  }
+
+private:
+  struct cc_ctxt {
+    std::unique_ptr<srsran::task_worker> worker;
+    dl_res_t*                            res  = nullptr;
+    bool                                 done = true;
+  };
+
+  sched_nr&               parent;
+  std::vector<cc_ctxt>    carriers;
+  std::mutex              mutex;
+  std::condition_variable cvar;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 sched_nr::sched_nr() : logger(&srslog::fetch_basic_logger("MAC-NR")), metrics_handler(new ue_metrics_manager{ue_db}) {}
 
 sched_nr::~sched_nr()
@@ -301,6 +375,9 @@ sched_nr::~sched_nr()
 
 void sched_nr::stop()
 {
+  if (pipeline != nullptr) {
+    pipeline->stop();
+  }
   metrics_handler->stop();
 }
 
@@ -309,6 +386,13 @@ int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_
   cfg    = sched_params_t{sched_cfg};
   logger = &srslog::fetch_basic_logger(sched_cfg.logger_name);
 
+  if (sched_cfg.lookahead_slots > SCHED_NR_MAX_LOOKAHEAD) {
+    logger->error("Invalid scheduler lookahead of %d slots, the maximum is %d",
+                  sched_cfg.lookahead_slots,
+                  SCHED_NR_MAX_LOOKAHEAD);
+    return SRSRAN_ERROR;
+  }
+
   // Initiate UE memory pool
   ue_pool.reset(new srsran::circular_stack_pool<SRSENB_MAX_UES>(8, sizeof(ue), 4));
 
@@ -326,6 +410,10 @@ int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_
     cc_workers[cc].reset(new slot_cc_worker{cfg.cells[cc]});
   }
 
+  if (cfg.sched_cfg.parallel_cc) {
+    pipeline.reset(new cc_pipeline{*this, (uint32_t)cfg.cells.size()});
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -370,6 +458,10 @@ int sched_nr::ue_cfg_impl(uint16_t rnti, const ue_cfg_t& uecfg)
 // NOTE: there is no parallelism in these operations
 void sched_nr::slot_indication(slot_point slot_tx)
 {
+  if (pipeline != nullptr) {
+    // All carriers must have completed the previous slot before the state shared across carriers is updated
+    pipeline->wait_all();
+  }
   srsran_assert(worker_count.load(std::memory_order_relaxed) == 0,
                 "Call of sched slot_indication when previous TTI has not been completed");
   // mark the start of slot.
@@ -390,6 +482,10 @@ void sched_nr::slot_indication(slot_point slot_tx)
 
   // If UE metrics were externally requested, store the current UE state
   metrics_handler->save_metrics();
+
+  if (pipeline != nullptr) {
+    pipeline->start_slot(slot_tx);
+  }
 }
 
 /// Generate {pdcch_slot,cc} scheduling decision
@@ -397,6 +493,14 @@ sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
 {
   srsran_assert(pdsch_tti == current_slot_tx, "Unexpected pdsch_tti slot received");
 
+  if (pipeline != nullptr) {
+    return pipeline->wait_cc(cc);
+  }
+  return run_cc_slot(pdsch_tti, cc);
+}
+
+sched_nr::dl_res_t* sched_nr::run_cc_slot(slot_point pdsch_tti, uint32_t cc)
+{
   // process non-cc specific feedback if pending (e.g. SRs, buffer state updates, UE config) for non-CA UEs
   pending_events->process_cc_events(ue_db, cc);
 
@@ -424,6 +528,9 @@ sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
 /// Fetch {ul_slot,cc} UL scheduling decision
 sched_nr::ul_res_t* sched_nr::get_ul_sched(slot_point slot_ul, uint32_t cc)
 {
+  if (pipeline != nullptr) {
+    pipeline->wait_cc(cc);
+  }
   return cc_workers[cc]->get_ul_sched(slot_ul);
 }
 
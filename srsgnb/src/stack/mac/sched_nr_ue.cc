@@ -33,9 +33,23 @@ int ue_buffer_manager::get_dl_tx_total() const
   for (ue_buffer_manager::ce_t ce : pending_ces) {
     total_bytes += srsran::mac_sch_subpdu_nr::sizeof_ce(ce.lcid, false);
   }
+  for (const srsran::deque<ce_t>& cc_ces : cc_pending_ces) {
+    for (ue_buffer_manager::ce_t ce : cc_ces) {
+      total_bytes += srsran::mac_sch_subpdu_nr::sizeof_ce(ce.lcid, false);
+    }
+  }
   return total_bytes;
 }
 
+void ue_buffer_manager::shard_ces()
+{
+  while (not pending_ces.empty()) {
+    ce_t ce = pending_ces.front();
+    pending_ces.pop_front();
+    cc_pending_ces[ce.cc].push_back(ce);
+  }
+}
+
 /**
  * @brief Allocates LCIDs and update US buffer states depending on available resources and checks if there is SRB0/CCCH
  MAC PDU segmentation
@@ -48,18 +62,16 @@ int ue_buffer_manager::get_dl_tx_total() const
 bool ue_buffer_manager::pdu_builder::alloc_subpdus(uint32_t rem_bytes, sched_nr_interface::dl_pdu_t& pdu)
 {
   // First step: allocate MAC CEs until resources allow
-  srsran::deque<ce_t> restore_ces;
-  for (ce_t ce : parent->pending_ces) {
-    if (ce.cc == cc) {
-      // Note: This check also avoids thread collisions across UE carriers
-      uint32_t size_ce = srsran::mac_sch_subpdu_nr::sizeof_ce(ce.lcid, false);
-      if (size_ce > rem_bytes) {
-        break;
-      }
-      rem_bytes -= size_ce;
-      pdu.subpdus.push_back(ce.lcid);
-      parent->pending_ces.pop_front();
+  // Note: Only the CEs of this carrier are accessed, which avoids thread collisions across UE carriers
+  srsran::deque<ce_t>& cc_ces = parent->cc_pending_ces[cc];
+  while (not cc_ces.empty()) {
+    uint32_t size_ce = srsran::mac_sch_subpdu_nr::sizeof_ce(cc_ces.front().lcid, false);
+    if (size_ce > rem_bytes) {
+      break;
     }
+    rem_bytes -= size_ce;
+    pdu.subpdus.push_back(cc_ces.front().lcid);
+    cc_ces.pop_front();
   }
 
   // Second step: allocate the remaining LCIDs (LCIDs for MAC CEs are addressed above)
@@ -92,7 +104,7 @@ slot_ue::slot_ue(ue_carrier& ue_, slot_point slot_tx_) : ue(&ue_), pdcch_slot(sl
 
   dl_active = ue->cell_params.bwps[0].slots[pdsch_slot.slot_idx()].is_dl;
   if (dl_active) {
-    dl_bytes = ue->common_ctxt.pending_dl_bytes;
+    dl_bytes = ue->ctxt.pending_dl_bytes;
     h_dl     = ue->harq_ent.find_pending_dl_retx();
     if (h_dl == nullptr) {
       h_dl = ue->harq_ent.find_empty_dl_harq();
@@ -100,7 +112,7 @@ slot_ue::slot_ue(ue_carrier& ue_, slot_point slot_tx_) : ue(&ue_), pdcch_slot(sl
   }
   ul_active = ue->cell_params.bwps[0].slots[pusch_slot.slot_idx()].is_ul;
   if (ul_active) {
-    ul_bytes = ue->common_ctxt.pending_ul_bytes;
+    ul_bytes = ue->ctxt.pending_ul_bytes;
     h_ul     = ue->harq_ent.find_pending_ul_retx();
     if (h_ul == nullptr) {
       h_ul = ue->harq_ent.find_empty_ul_harq();
@@ -113,7 +125,6 @@ slot_ue::slot_ue(ue_carrier& ue_, slot_point slot_tx_) : ue(&ue_), pdcch_slot(sl
 ue_carrier::ue_carrier(uint16_t                              rnti_,
                        const ue_cfg_manager&                 uecfg_,
                        const cell_config_manager&            cell_params_,
-                       const ue_context_common&              ctxt,
                        const ue_buffer_manager::pdu_builder& pdu_builder_) :
   rnti(rnti_),
   cc(cell_params_.cc),
@@ -121,7 +132,6 @@ ue_carrier::ue_carrier(uint16_t                              rnti_,
   bwp_cfg(rnti_, cell_params_.bwps[0], uecfg_),
   cell_params(cell_params_),
   pdu_builder(pdu_builder_),
-  common_ctxt(ctxt),
   harq_ent(rnti_, cell_params_.nof_prb(), SCHED_NR_MAX_HARQ, cell_params_.bwps[0].logger)
 {}
 
@@ -190,7 +200,6 @@ void ue::set_cfg(const sched_nr_ue_cfg_t& cfg)
         carriers[ue_cc_cfg.cc] = std::make_unique<ue_carrier>(rnti,
                                                               ue_cfg,
                                                               sched_cfg.cells[ue_cc_cfg.cc],
-                                                              common_ctxt,
                                                               ue_buffer_manager::pdu_builder{ue_cc_cfg.cc, buffers});
       } else {
         carriers[ue_cc_cfg.cc]->set_cfg(ue_cfg);
@@ -220,7 +229,8 @@ void ue::new_slot(slot_point pdcch_slot)
 
   for (std::unique_ptr<ue_carrier>& cc : carriers) {
     if (cc != nullptr) {
-      cc->harq_ent.new_slot(pdcch_slot - TX_ENB_DELAY);
+      // When scheduling ahead of the PHY, the HARQ feedback of the last lookahead slots is still to be received
+      cc->harq_ent.new_slot(pdcch_slot - TX_ENB_DELAY - sched_cfg.sched_cfg.lookahead_slots);
     }
   }
 
@@ -250,6 +260,42 @@ void ue::new_slot(slot_point pdcch_slot)
       common_ctxt.pending_ul_bytes = 512;
     }
   }
+
+  // Hand each carrier its share of the UE state
+  buffers.shard_ces();
+  distribute_common_ctxt();
+}
+
+/// Splits the pending bytes evenly across the active carriers, with the remainder assigned to the PCell
+void ue::distribute_common_ctxt()
+{
+  for (std::unique_ptr<ue_carrier>& cc : carriers) {
+    if (cc != nullptr) {
+      cc->ctxt = {};
+    }
+  }
+
+  uint32_t nof_cc = 0;
+  for (const ue_cc_cfg_t& ue_cc_cfg : ue_cfg.carriers) {
+    if (ue_cc_cfg.active and carriers[ue_cc_cfg.cc] != nullptr) {
+      nof_cc++;
+    }
+  }
+  if (nof_cc == 0) {
+    return;
+  }
+
+  for (const ue_cc_cfg_t& ue_cc_cfg : ue_cfg.carriers) {
+    if (ue_cc_cfg.active and carriers[ue_cc_cfg.cc] != nullptr) {
+      ue_context_common& cc_ctxt = carriers[ue_cc_cfg.cc]->ctxt;
+      cc_ctxt.pending_dl_bytes   = common_ctxt.pending_dl_bytes / nof_cc;
+      cc_ctxt.pending_ul_bytes   = common_ctxt.pending_ul_bytes / nof_cc;
+      if (ue_cc_cfg.cc == pcell_cc()) {
+        cc_ctxt.pending_dl_bytes += common_ctxt.pending_dl_bytes % nof_cc;
+        cc_ctxt.pending_ul_bytes += common_ctxt.pending_ul_bytes % nof_cc;
+      }
+    }
+  }
 }
 
 slot_ue ue::make_slot_ue(slot_point pdcch_slot, uint32_t cc)
@@ -53,7 +53,8 @@ dl_sched_res_t* cc_worker::run_slot(slot_point tx_sl, ue_map_t& ue_db)
   }
   while (last_tx_sl != tx_sl) {
     last_tx_sl++;
-    slot_point old_slot = last_tx_sl - TX_ENB_DELAY - 1;
+    // Slots scheduled ahead of the PHY keep the grid of older slots in use for longer
+    slot_point old_slot = last_tx_sl - TX_ENB_DELAY - cfg.sched_args.lookahead_slots - 1;
     for (bwp_manager& bwp : bwps) {
       bwp.grid[old_slot].reset();
     }
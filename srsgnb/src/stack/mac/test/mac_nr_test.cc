@@ -0,0 +1,85 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "sched_nr_cfg_generators.h"
+#include "srsenb/test/common/rlc_test_dummy.h"
+#include "srsgnb/hdr/stack/common/test/dummy_nr_classes.h"
+#include "srsgnb/hdr/stack/mac/mac_nr.h"
+#include "srsran/common/test_common.h"
+
+namespace srsenb {
+
+void test_late_prepared_dl_slot()
+{
+  const uint32_t         lookahead_slots = 2;
+  const uint32_t         nof_slots       = 20;
+  srsran::task_scheduler task_sched;
+  rlc_dummy              rlc;
+  rrc_nr_dummy           rrc;
+
+  mac_nr        mac(&task_sched);
+  mac_nr_args_t args{};
+  args.sched_cfg.lookahead_slots = lookahead_slots;
+  TESTASSERT_SUCCESS(mac.init(args, nullptr, nullptr, &rlc, &rrc));
+  TESTASSERT_SUCCESS(mac.cell_cfg(get_default_cells_cfg(1)));
+
+  // The PHY requests the slots in order, the stack thread prepares the next ones in between
+  srsran_slot_cfg_t slot_cfg = {};
+  for (slot_cfg.idx = 0; slot_cfg.idx < nof_slots; ++slot_cfg.idx) {
+    TESTASSERT(mac.get_dl_sched(slot_cfg) != nullptr);
+    task_sched.run_pending_tasks();
+  }
+  TESTASSERT_EQ(0, mac.get_nof_late_dl_slots());
+
+  // A slot requested after its result was overwritten by the slots prepared ahead is discarded and counted
+  slot_cfg.idx = nof_slots / 2 - 1;
+  TESTASSERT(mac.get_dl_sched(slot_cfg) == nullptr);
+  task_sched.run_pending_tasks();
+  TESTASSERT_EQ(1, mac.get_nof_late_dl_slots());
+
+  // The slots prepared ahead of the late one are still available
+  for (slot_cfg.idx = nof_slots; slot_cfg.idx < nof_slots + lookahead_slots; ++slot_cfg.idx) {
+    TESTASSERT(mac.get_dl_sched(slot_cfg) != nullptr);
+    task_sched.run_pending_tasks();
+  }
+  TESTASSERT_EQ(1, mac.get_nof_late_dl_slots());
+
+  mac.stop();
+}
+
+} // namespace srsenb
+
+int main()
+{
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  mac_nr_logger.set_level(srslog::basic_levels::info);
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::info);
+
+  // Start the log backend.
+  srslog::init();
+
+  srsenb::test_late_prepared_dl_slot();
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_nr_cfg_generators.h"
+#include "sched_nr_sim_ue.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+
+namespace srsenb {
+
+/// Tester that measures the time taken to schedule all carriers of a slot
+class sched_nr_bench_tester : public sched_nr_base_test_bench
+{
+public:
+  using sched_nr_base_test_bench::sched_nr_base_test_bench;
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& slot_ctxt, srsran::const_span<cc_result_t> cc_list) override
+  {
+    tot_latency_ns +=
+        std::max_element(cc_list.begin(), cc_list.end(), [](const cc_result_t& lhs, const cc_result_t& rhs) {
+          return lhs.cc_latency_ns < rhs.cc_latency_ns;
+        })->cc_latency_ns.count();
+    nof_slots++;
+
+    for (auto& cc_out : cc_list) {
+      pdsch_count += cc_out.res.dl->phy.pdcch_dl.size();
+    }
+  }
+
+  uint64_t tot_latency_ns = 0;
+  uint32_t nof_slots      = 0;
+  uint32_t pdsch_count    = 0;
+};
+
+enum class bench_mode { serial, caller_threads, cc_pipeline };
+
+const char* to_string(bench_mode mode)
+{
+  switch (mode) {
+    case bench_mode::serial:
+      return "serial";
+    case bench_mode::caller_threads:
+      return "caller threads";
+    case bench_mode::cc_pipeline:
+      return "cc pipeline";
+  }
+  return "";
+}
+
+/// Runs the scheduler for the given number of slots, and returns the average time taken per slot in usec
+double run_sched_nr_bench(bench_mode mode, uint32_t nof_cells, uint32_t nof_ues, uint32_t nof_slots)
+{
+  sched_nr_interface::sched_args_t cfg;
+  cfg.auto_refill_buffer = true;
+  cfg.parallel_cc        = mode == bench_mode::cc_pipeline;
+
+  std::vector<sched_nr_cell_cfg_t> cells_cfg   = get_default_cells_cfg(nof_cells);
+  uint32_t                         nof_workers = mode == bench_mode::caller_threads ? nof_cells : 1;
+
+  sched_nr_bench_tester tester(
+      cfg, cells_cfg, fmt::format("Bench {}, {} cells, {} UEs", to_string(mode), nof_cells, nof_ues), nof_workers);
+
+  const uint32_t ue_cfg_slot = 9;
+  for (uint32_t i = 0; i < nof_slots + ue_cfg_slot + 1; ++i) {
+    slot_point slot_rx(0, i % 10240);
+    slot_point slot_tx = slot_rx + TX_ENB_DELAY;
+    if (i == ue_cfg_slot) {
+      // Every UE is configured in all cells
+      for (uint32_t ue_idx = 0; ue_idx < nof_ues; ++ue_idx) {
+        sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(nof_cells);
+        uecfg.lc_ch_to_add.emplace_back();
+        uecfg.lc_ch_to_add.back().lcid          = 1;
+        uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+        tester.user_cfg(0x4601 + ue_idx, uecfg);
+      }
+    }
+    if (i == ue_cfg_slot + 1) {
+      // Only measure slots with all UEs configured
+      tester.get_slot_results();
+      tester.tot_latency_ns = 0;
+      tester.nof_slots      = 0;
+      tester.pdsch_count    = 0;
+    }
+    tester.run_slot(slot_tx);
+  }
+  tester.stop();
+
+  TESTASSERT(tester.nof_slots == nof_slots);
+  TESTASSERT(tester.pdsch_count > 0);
+  return tester.tot_latency_ns / 1000.0 / tester.nof_slots;
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::warning);
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  mac_nr_logger.set_level(srslog::basic_levels::error);
+
+  // Start the log backend.
+  srslog::init();
+
+  uint32_t nof_slots = 1000;
+  if (argc > 1) {
+    nof_slots = (uint32_t)strtol(argv[1], nullptr, 10);
+  }
+
+  printf("-- NR scheduler benchmark, %d slots\n", nof_slots);
+  printf("%6s %6s %12s %16s %14s\n", "cells", "UEs", "serial", "caller threads", "cc pipeline");
+  for (uint32_t nof_cells : {1U, 2U, 4U}) {
+    for (uint32_t nof_ues : {1U, 8U, 32U}) {
+      double serial_us = srsenb::run_sched_nr_bench(srsenb::bench_mode::serial, nof_cells, nof_ues, nof_slots);
+      double caller_us = srsenb::run_sched_nr_bench(srsenb::bench_mode::caller_threads, nof_cells, nof_ues, nof_slots);
+      double pipeline_us = srsenb::run_sched_nr_bench(srsenb::bench_mode::cc_pipeline, nof_cells, nof_ues, nof_slots);
+      printf("%6d %6d %9.1f us %13.1f us %11.1f us\n", nof_cells, nof_ues, serial_us, caller_us, pipeline_us);
+    }
+  }
+
+  srslog::flush();
+
+  return SRSRAN_SUCCESS;
+}
@@ -73,7 +73,7 @@ public:
   uint32_t pdsch_count          = 0;
 };
 
-void run_sched_nr_test(uint32_t nof_workers)
+void run_sched_nr_test(uint32_t nof_workers, bool parallel_cc = false)
 {
   srsran_assert(nof_workers > 0, "There must be at least one worker");
   uint32_t max_nof_ttis = 1000, nof_sectors = 4;
@@ -81,6 +81,7 @@ void run_sched_nr_test(uint32_t nof_workers)
 
   sched_nr_interface::sched_args_t cfg;
   cfg.auto_refill_buffer = true;
+  cfg.parallel_cc        = parallel_cc;
 
   std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_sectors);
 
@@ -88,6 +89,9 @@ void run_sched_nr_test(uint32_t nof_workers)
   if (nof_workers > 1) {
     test_name = fmt::format("Parallel Test with {} workers", nof_workers);
   }
+  if (parallel_cc) {
+    test_name += " and one thread per carrier";
+  }
   sched_nr_tester tester(cfg, cells_cfg, test_name, nof_workers);
 
   for (uint32_t nof_slots = 0; nof_slots < max_nof_ttis; ++nof_slots) {
@@ -130,4 +134,6 @@ int main()
   srsenb::run_sched_nr_test(1);
   srsenb::run_sched_nr_test(2);
   srsenb::run_sched_nr_test(4);
+  srsenb::run_sched_nr_test(1, true);
+  srsenb::run_sched_nr_test(4, true);
 }
@@ -172,18 +172,25 @@ void test_sched_nr_no_data(sim_args_t args)
   TESTASSERT_EQ(1, tester.ue_metrics[rnti].nof_ul_txs);
 }
 
-void test_sched_nr_data(sim_args_t args)
+uint32_t get_random_dl_bytes()
+{
+  return std::uniform_int_distribution<int>{1, 9}(rand_gen)*pow(10, std::uniform_int_distribution<int>{1, 7}(rand_gen));
+}
+
+void test_sched_nr_data(sim_args_t args, uint32_t nof_dl_bytes_to_tx, uint32_t lookahead_slots = 0)
 {
   uint32_t nof_sectors = 1;
   uint16_t rnti        = 0x4601;
-  uint32_t nof_dl_bytes_to_tx =
-      std::uniform_int_distribution<int>{1, 9}(rand_gen)*pow(10, std::uniform_int_distribution<int>{1, 7}(rand_gen));
 
   sched_nr_interface::sched_args_t cfg;
   cfg.auto_refill_buffer                     = false;
+  cfg.lookahead_slots                        = lookahead_slots;
   std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_sectors);
 
-  std::string  test_name = "Test with data";
+  std::string test_name = "Test with data";
+  if (lookahead_slots > 0) {
+    test_name += fmt::format(" and lookahead of {} slots", lookahead_slots);
+  }
   sched_tester tester(args, cfg, cells_cfg, test_name);
 
   /* Set events */
@@ -328,7 +335,9 @@ int main(int argc, char** argv)
       (void*)&args);
 
   srsenb::test_sched_nr_no_data(args);
-  srsenb::test_sched_nr_data(args);
+  srsenb::test_sched_nr_data(args, srsenb::get_random_dl_bytes());
+  srsenb::test_sched_nr_data(args, 1000000, 2);
+  srsenb::test_sched_nr_data(args, 1000000, srsenb::SCHED_NR_MAX_LOOKAHEAD);
 
   fmt::print("TEST: Random Seed was {}", args.rand_seed);
 }
@@ -402,11 +402,24 @@ bool ngap::handle_ngap_rx_pdu(srsran::byte_buffer_t* pdu)
     pcap->write_ngap(pdu->msg, pdu->N_bytes);
   }
 
-  // Unpack
-  ngap_pdu_c     rx_pdu;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
+  // Index the IEs first, so that messages of unknown UEs are discarded without decoding them
+  asn1::ap_pdu_index index;
+  ngap_pdu_c         rx_pdu;
+  asn1::cbit_ref     bref(pdu->msg, pdu->N_bytes);
 
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  if (index.unpack(pdu->msg, pdu->N_bytes) != asn1::SRSASN_SUCCESS) {
+    logger.error(pdu->msg, pdu->N_bytes, "Failed to unpack received PDU");
+    cause_c cause;
+    cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
+    send_error_indication(cause);
+    return false;
+  }
+  if (discard_unknown_ue_pdu(index, srsran::make_span(*pdu))) {
+    return false;
+  }
+
+  // Unpack
+  if (asn1::unpack_in_arena(rx_pdu, bref, rx_arena) != asn1::SRSASN_SUCCESS) {
     logger.error(pdu->msg, pdu->N_bytes, "Failed to unpack received PDU");
     cause_c cause;
     cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
@@ -433,6 +446,37 @@ bool ngap::handle_ngap_rx_pdu(srsran::byte_buffer_t* pdu)
   return true;
 }
 
+/**
+ * Checks the UE NGAP IDs of DL NAS Transport messages, the most frequent ones, before decoding the whole message.
+ * @return true if the RAN UE NGAP ID is unknown, in which case the error indication has already been sent
+ */
+bool ngap::discard_unknown_ue_pdu(const asn1::ap_pdu_index& index, srsran::const_byte_span pdu)
+{
+  if (index.pdu_type() != asn1::ap_pdu_index::pdu_type_t::init_msg or
+      index.proc_code() != ASN1_NGAP_ID_DL_NAS_TRANSPORT) {
+    return false;
+  }
+
+  // Malformed IEs are reported by the full decoding
+  ran_ue_ngap_id_t ran_ue_ngap_id;
+  amf_ue_ngap_id_t amf_ue_ngap_id;
+  if (index.unpack_ie(ASN1_NGAP_ID_RAN_UE_NGAP_ID, ran_ue_ngap_id) != asn1::SRSASN_SUCCESS or
+      index.unpack_ie(ASN1_NGAP_ID_AMF_UE_NGAP_ID, amf_ue_ngap_id) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  if (users.find_ue_gnbid(ran_ue_ngap_id.value) != nullptr) {
+    return false;
+  }
+
+  logger.info(pdu.data(),
+              pdu.size(),
+              "Rx - %s (%d B)",
+              ngap_elem_procs_o::get_init_msg(index.proc_code()).type().to_string(),
+              pdu.size());
+  handle_ngapmsg_ue_id(ran_ue_ngap_id.value, amf_ue_ngap_id.value);
+  return true;
+}
+
 bool ngap::handle_initiating_message(const asn1::ngap::init_msg_s& msg)
 {
   switch (msg.value.type().value) {
@@ -494,7 +494,7 @@ void rrc_nr::handle_ul_ccch(uint16_t rnti, srsran::const_byte_span pdu)
   ul_ccch_msg_s ul_ccch_msg;
   {
     asn1::cbit_ref bref(pdu.data(), pdu.size());
-    if (ul_ccch_msg.unpack(bref) != asn1::SRSASN_SUCCESS or
+    if (asn1::unpack_in_arena(ul_ccch_msg, bref, rx_arena) != asn1::SRSASN_SUCCESS or
         ul_ccch_msg.msg.type().value != ul_ccch_msg_type_c::types_opts::c1) {
       log_rx_pdu_fail(rnti, srb_to_lcid(lte_srb::srb0), pdu, "Failed to unpack UL-CCCH message", true);
       return;
@@ -527,7 +527,7 @@ void rrc_nr::handle_ul_dcch(uint16_t rnti, uint32_t lcid, srsran::const_byte_spa
   ul_dcch_msg_s ul_dcch_msg;
   {
     asn1::cbit_ref bref(pdu.data(), pdu.size());
-    if (ul_dcch_msg.unpack(bref) != asn1::SRSASN_SUCCESS or
+    if (asn1::unpack_in_arena(ul_dcch_msg, bref, rx_arena) != asn1::SRSASN_SUCCESS or
         ul_dcch_msg.msg.type().value != ul_dcch_msg_type_c::types_opts::c1) {
       log_rx_pdu_fail(rnti, lcid, pdu, "Failed to unpack UL-DCCH message");
       return;
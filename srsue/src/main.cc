@@ -215,6 +215,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),                 "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.nof_threads",       bpo::value<uint32_t>(&args->phy.dl_channel_args.nof_threads)->default_value(1),            "Number of threads applying the channel to the antennas in parallel")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),            "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),           "SNR in dB")
     ("channel.dl.awgn.signal_power", bpo::value<float>(&args->phy.dl_channel_args.awgn_signal_power_dBfs)->default_value(0.0f), "Received signal power in decibels full scale (dBfs)")
@@ -235,6 +236,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.nof_threads",       bpo::value<uint32_t>(&args->phy.ul_channel_args.nof_threads)->default_value(1),             "Number of threads applying the channel to the antennas in parallel")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Transmitted signal power in decibels full scale (dBfs)")
@@ -645,8 +647,8 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     }
   }
 
-  // Set sync queue capacity to 1 for ZMQ
-  if (args->rf.device_name == "zmq") {
+  // Set sync queue capacity to 1 for ZMQ and shared-memory radios
+  if (args->rf.device_name == "zmq" || args->rf.device_name == "shm") {
     args->stack.sync_queue_size = 1;
   } else {
     // use default size